@@ -0,0 +1,163 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the evaluation of atmospheric density at a list of points (AtmosphereModel::getDensities), compared to
+ *    point-by-point evaluation (AtmosphereModel::getDensity), for exponential and tabulated (one and three independent
+ *    variables) atmospheres, and the NRLMSISE00 atmosphere (if available). The points are sampled every 10 s along a
+ *    slowly decaying low Earth orbit (from 600 to 200 km altitude, 51.6 deg inclination). Usage:
+ *
+ *      benchmark_AtmosphereDensities [numberOfPoints] [numberOfThreads]
+ *
+ *    By default, 1000000 points are evaluated (100000 for NRLMSISE00), and the multi-threaded evaluation uses 4 threads.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tudat/astro/aerodynamics/exponentialAtmosphere.h"
+#include "tudat/astro/aerodynamics/tabulatedAtmosphere.h"
+#if TUDAT_BUILD_WITH_NRLMSISE
+#include "tudat/astro/aerodynamics/nrlmsise00Atmosphere.h"
+#include "tudat/io/solarActivityData.h"
+#endif
+#include "tudat/astro/basic_astro/timeConversions.h"
+#include "tudat/io/basicInputOutput.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+//! Function to time point-by-point and list evaluation of density, and print the results.
+void benchmarkAtmosphereModel( const std::string& modelName,
+                               const std::shared_ptr< aerodynamics::AtmosphereModel > atmosphereModel,
+                               const std::vector< double >& altitudes, const std::vector< double >& longitudes,
+                               const std::vector< double >& latitudes, const std::vector< double >& times,
+                               const int numberOfPoints, const int numberOfThreads )
+{
+    // Time point-by-point evaluation
+    std::vector< double > pointDensities( numberOfPoints );
+    const double pointTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            pointDensities[ i ] = atmosphereModel->getDensity( altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+        }
+    } );
+
+    // Time list evaluation, single- and multi-threaded
+    std::vector< double > listTimes;
+    double maximumDifference = 0.0;
+    for( int threads : { 1, numberOfThreads } )
+    {
+        atmosphereModel->setNumberOfThreads( threads );
+        std::vector< double > listDensities( numberOfPoints );
+        listTimes.push_back( benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            atmosphereModel->getDensities( altitudes.data( ), longitudes.data( ), latitudes.data( ), times.data( ),
+                                           listDensities.data( ), numberOfPoints );
+        } ) );
+
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            maximumDifference = std::max(
+                        maximumDifference, std::fabs( listDensities[ i ] / pointDensities[ i ] - 1.0 ) );
+        }
+    }
+    atmosphereModel->setNumberOfThreads( 1 );
+
+    std::cout << std::setw( 16 ) << modelName
+              << std::setw( 16 ) << pointTime / numberOfPoints * 1.0E9
+              << std::setw( 16 ) << listTimes.at( 0 ) / numberOfPoints * 1.0E9
+              << std::setw( 16 ) << listTimes.at( 1 ) / numberOfPoints * 1.0E9
+              << std::setw( 12 ) << pointTime / listTimes.at( 0 )
+              << std::setw( 16 ) << pointTime / listTimes.at( 1 )
+              << std::setw( 18 ) << maximumDifference << std::endl;
+}
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfPoints = benchmarks::getIntegerArgument( argc, argv, 1, 1000000 );
+    const int numberOfThreads = benchmarks::getIntegerArgument( argc, argv, 2, 4 );
+
+    // Create points every 10 s along decaying orbit
+    const double orbitalPeriod = 5550.0;
+    const double inclination = 51.6 * mathematical_constants::PI / 180.0;
+    const double earthRotationRate = 7.292115E-5;
+    const double initialTime = basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                basic_astrodynamics::convertCalendarDateToJulianDay< double >( 2010, 1, 1, 0, 0, 0.0 ) );
+    std::vector< double > altitudes( numberOfPoints ), longitudes( numberOfPoints ), latitudes( numberOfPoints ),
+            times( numberOfPoints );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        const double time = 10.0 * static_cast< double >( i );
+        const double argumentOfLatitude = 2.0 * mathematical_constants::PI * time / orbitalPeriod;
+        altitudes[ i ] = 600.0E3 - 400.0E3 * static_cast< double >( i ) / numberOfPoints +
+                5.0E3 * std::sin( argumentOfLatitude );
+        longitudes[ i ] = std::remainder( std::atan2( std::cos( inclination ) * std::sin( argumentOfLatitude ),
+                                                      std::cos( argumentOfLatitude ) ) - earthRotationRate * time,
+                                          2.0 * mathematical_constants::PI );
+        latitudes[ i ] = std::asin( std::sin( inclination ) * std::sin( argumentOfLatitude ) );
+        times[ i ] = initialTime + time;
+    }
+
+    std::cout << "Atmosphere density benchmark: " << numberOfPoints << " points, " << numberOfThreads
+              << " threads" << std::endl;
+    std::cout << std::setw( 16 ) << "model" << std::setw( 16 ) << "point [ns]" << std::setw( 16 ) << "list [ns]"
+              << std::setw( 16 ) << "threaded [ns]" << std::setw( 12 ) << "speedup" << std::setw( 16 )
+              << "speedup thr." << std::setw( 18 ) << "max. rel. diff." << std::endl;
+
+    benchmarkAtmosphereModel( "exponential", std::make_shared< aerodynamics::ExponentialAtmosphere >(
+                                  aerodynamics::earth ),
+                              altitudes, longitudes, latitudes, times, numberOfPoints, numberOfThreads );
+
+    benchmarkAtmosphereModel( "tabulated 1D", std::make_shared< aerodynamics::TabulatedAtmosphere >(
+                                  paths::getAtmosphereTablesPath( ) +
+                                  "/USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" ),
+                              altitudes, longitudes, latitudes, times, numberOfPoints, numberOfThreads );
+
+    // Use Mars table (with altitudes scaled to table range) for three independent variables
+    std::map< int, std::string > tabulatedAtmosphereFiles;
+    tabulatedAtmosphereFiles[ 0 ] = paths::getAtmosphereTablesPath( ) + "/MCDMeanAtmosphereTimeAverage/density.dat";
+    tabulatedAtmosphereFiles[ 1 ] = paths::getAtmosphereTablesPath( ) + "/MCDMeanAtmosphereTimeAverage/pressure.dat";
+    tabulatedAtmosphereFiles[ 2 ] = paths::getAtmosphereTablesPath( ) + "/MCDMeanAtmosphereTimeAverage/temperature.dat";
+    std::shared_ptr< aerodynamics::TabulatedAtmosphere > multiDimensionalAtmosphere =
+            std::make_shared< aerodynamics::TabulatedAtmosphere >(
+                tabulatedAtmosphereFiles,
+                std::vector< aerodynamics::AtmosphereIndependentVariables >{
+                    aerodynamics::longitude_dependent_atmosphere, aerodynamics::latitude_dependent_atmosphere,
+                    aerodynamics::altitude_dependent_atmosphere },
+                std::vector< aerodynamics::AtmosphereDependentVariables >{
+                    aerodynamics::density_dependent_atmosphere, aerodynamics::pressure_dependent_atmosphere,
+                    aerodynamics::temperature_dependent_atmosphere } );
+    std::vector< double > scaledAltitudes( numberOfPoints );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        scaledAltitudes[ i ] = 0.4 * altitudes[ i ];
+    }
+    benchmarkAtmosphereModel( "tabulated 3D", multiDimensionalAtmosphere,
+                              scaledAltitudes, longitudes, latitudes, times, numberOfPoints, numberOfThreads );
+
+#if TUDAT_BUILD_WITH_NRLMSISE
+    benchmarkAtmosphereModel( "NRLMSISE00", std::make_shared< aerodynamics::NRLMSISE00Atmosphere >(
+                                  input_output::solar_activity::readSolarActivityData(
+                                      paths::getSpaceWeatherDataPath( ) + "/sw19571001.txt" ) ),
+                              altitudes, longitudes, latitudes, times, std::min( numberOfPoints, 100000 ),
+                              numberOfThreads );
+#endif
+
+    return EXIT_SUCCESS;
+}
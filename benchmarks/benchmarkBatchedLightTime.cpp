@@ -0,0 +1,145 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the simulation of one-way range and Doppler observables on a densely sampled interplanetary link,
+ *    comparing epoch-by-epoch simulation (simulateObservationWithCheck) to the batched simulation
+ *    (simulateObservationsWithCheck), in which the light-time solution at preceding epochs is used as initial guess.
+ *    Both use Keplerian ephemerides for the link ends and a first-order relativistic light-time correction. Usage:
+ *
+ *      benchmark_BatchedLightTime [numberOfObservations] [observationIntervalInSeconds]
+ *
+ *    By default, 100000 observations at 1 s intervals are simulated.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/physicalConstants.h"
+#include "tudat/astro/basic_astro/unitConversions.h"
+#include "tudat/astro/ephemerides/keplerEphemeris.h"
+#include "tudat/astro/observation_models/corrections/firstOrderRelativisticCorrection.h"
+#include "tudat/astro/observation_models/oneWayDopplerObservationModel.h"
+#include "tudat/astro/observation_models/oneWayRangeObservationModel.h"
+#include "tudat/simulation/estimation_setup/simulateObservations.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+using namespace tudat::observation_models;
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfObservations = benchmarks::getIntegerArgument( argc, argv, 1, 100000 );
+    const int observationInterval = benchmarks::getIntegerArgument( argc, argv, 2, 1 );
+
+    // Create Keplerian ephemerides of transmitter (Mars-like orbit) and receiver (Earth-like orbit)
+    const double sunGravitationalParameter = 1.32712440018E20;
+    Eigen::Vector6d transmitterKeplerElements, receiverKeplerElements;
+    transmitterKeplerElements << 2.279E11, 0.0934, unit_conversions::convertDegreesToRadians( 1.85 ),
+            unit_conversions::convertDegreesToRadians( 286.5 ), unit_conversions::convertDegreesToRadians( 49.6 ), 0.3;
+    receiverKeplerElements << 1.496E11, 0.0167, 0.0, unit_conversions::convertDegreesToRadians( 102.9 ), 0.0, 2.1;
+    std::shared_ptr< ephemerides::KeplerEphemeris > transmitterEphemeris = std::make_shared< ephemerides::KeplerEphemeris >(
+                transmitterKeplerElements, 0.0, sunGravitationalParameter );
+    std::shared_ptr< ephemerides::KeplerEphemeris > receiverEphemeris = std::make_shared< ephemerides::KeplerEphemeris >(
+                receiverKeplerElements, 0.0, sunGravitationalParameter );
+
+    std::function< Eigen::Vector6d( const double ) > transmitterStateFunction =
+            [ = ]( const double time ){ return transmitterEphemeris->getCartesianState( time ); };
+    std::function< Eigen::Vector6d( const double ) > receiverStateFunction =
+            [ = ]( const double time ){ return receiverEphemeris->getCartesianState( time ); };
+
+    // Create light-time calculator, with first-order relativistic correction due to the Sun
+    std::vector< std::shared_ptr< LightTimeCorrection > > lightTimeCorrections;
+    lightTimeCorrections.push_back(
+                std::make_shared< FirstOrderLightTimeCorrectionCalculator >(
+                    std::vector< std::function< Eigen::Vector6d( const double ) > >(
+                        { [ ]( const double ){ return Eigen::Vector6d::Zero( ).eval( ); } } ),
+                    std::vector< std::function< double( ) > >( { [ = ]( ){ return sunGravitationalParameter; } } ),
+                    std::vector< std::string >( { "Sun" } ), "Mars", "Earth" ) );
+
+    LinkEnds linkEnds;
+    linkEnds[ transmitter ] = LinkEndId( "Mars" );
+    linkEnds[ receiver ] = LinkEndId( "Earth" );
+
+    std::vector< std::shared_ptr< ObservationModel< 1, double, double > > > observationModels;
+    std::vector< std::string > observationModelNames;
+    observationModels.push_back(
+                std::make_shared< OneWayRangeObservationModel< double, double > >(
+                    linkEnds, std::make_shared< LightTimeCalculator< double, double > >(
+                        transmitterStateFunction, receiverStateFunction, lightTimeCorrections ) ) );
+    observationModelNames.push_back( "one-way range" );
+    observationModels.push_back(
+                std::make_shared< OneWayDopplerObservationModel< double, double > >(
+                    linkEnds, std::make_shared< LightTimeCalculator< double, double > >(
+                        transmitterStateFunction, receiverStateFunction, lightTimeCorrections ),
+                    std::shared_ptr< DopplerProperTimeRateInterface >( ),
+                    std::shared_ptr< DopplerProperTimeRateInterface >( ) ) );
+    observationModelNames.push_back( "one-way Doppler" );
+
+    // Define observation times
+    std::vector< double > observationTimes;
+    for( int i = 0; i < numberOfObservations; i++ )
+    {
+        observationTimes.push_back( 1.0E7 + static_cast< double >( i * observationInterval ) );
+    }
+
+    std::cout << "Batched light-time benchmark: " << numberOfObservations << " observations at "
+              << observationInterval << " s intervals" << std::endl;
+    std::cout << std::setw( 18 ) << "observable" << std::setw( 12 ) << "method" << std::setw( 14 ) << "time [s]"
+              << std::setw( 16 ) << "obs./s" << std::setw( 12 ) << "speedup" << std::setw( 18 ) << "max. rel. diff."
+              << std::endl;
+
+    for( unsigned int i = 0; i < observationModels.size( ); i++ )
+    {
+        // Epoch-by-epoch simulation, as reference
+        std::vector< Eigen::VectorXd > referenceObservations( numberOfObservations );
+        double referenceTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            for( int j = 0; j < numberOfObservations; j++ )
+            {
+                referenceObservations[ j ] = std::get< 0 >(
+                            simulation_setup::simulateObservationWithCheck< 1, double, double >(
+                                observationTimes[ j ], observationModels.at( i ), receiver ) );
+            }
+        }, 1 );
+
+        // Batched simulation
+        std::vector< Eigen::VectorXd > batchedObservations;
+        double batchedTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            batchedObservations = std::get< 0 >(
+                        simulation_setup::simulateObservationsWithCheck< 1, double, double >(
+                            observationTimes, observationModels.at( i ), receiver ) );
+        }, 1 );
+
+        double maximumRelativeDifference = 0.0;
+        for( int j = 0; j < numberOfObservations; j++ )
+        {
+            maximumRelativeDifference = std::max(
+                        maximumRelativeDifference, std::fabs( batchedObservations.at( j )( 0 ) - referenceObservations.at( j )( 0 ) ) /
+                        std::fabs( referenceObservations.at( j )( 0 ) ) );
+        }
+
+        std::cout << std::setw( 18 ) << observationModelNames.at( i ) << std::setw( 12 ) << "epoch-wise"
+                  << std::setw( 14 ) << referenceTime
+                  << std::setw( 16 ) << static_cast< double >( numberOfObservations ) / referenceTime
+                  << std::setw( 12 ) << 1.0 << std::setw( 18 ) << 0.0 << std::endl;
+        std::cout << std::setw( 18 ) << observationModelNames.at( i ) << std::setw( 12 ) << "batched"
+                  << std::setw( 14 ) << batchedTime
+                  << std::setw( 16 ) << static_cast< double >( numberOfObservations ) / batchedTime
+                  << std::setw( 12 ) << referenceTime / batchedTime << std::setw( 18 ) << maximumRelativeDifference
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
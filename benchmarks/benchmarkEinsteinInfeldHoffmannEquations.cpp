@@ -0,0 +1,101 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the time per update of the Einstein-Infeld-Hoffmann (EIH) equations, for N mutually attracting bodies
+ *    (all bodies undergoing and exerting acceleration), for 10, 30 and 100 bodies. If a number of threads larger than one
+ *    is provided, the update is also timed with the pair computations distributed over a thread pool. Usage:
+ *
+ *      benchmark_EinsteinInfeldHoffmannEquations [numberOfUpdates] [numberOfThreads]
+ *
+ *    By default, 200 updates and 1 thread are used.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/relativity/einsteinInfeldHoffmannEquations.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+//! Function to time the update of the EIH equations for a given number of bodies, and print the time per update.
+void printEinsteinInfeldHoffmannUpdateTime( const int numberOfBodies, const int numberOfUpdates,
+                                            const unsigned int numberOfThreads )
+{
+    // Define bodies on near-circular orbits around a central body
+    std::vector< std::string > bodyNames;
+    std::vector< std::function< double( ) > > gravitationalParameterFunctions;
+    std::vector< std::function< Eigen::Matrix< double, 6, 1 >( ) > > stateFunctions;
+    std::vector< Eigen::Matrix< double, 6, 1 > > bodyStates( numberOfBodies, Eigen::Matrix< double, 6, 1 >::Zero( ) );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        bodyNames.push_back( "Body" + std::to_string( i ) );
+        const double gravitationalParameter = ( i == 0 ) ? 1.32712440018E20 : 1.0E14 * static_cast< double >( i );
+        gravitationalParameterFunctions.push_back( [ = ]( ){ return gravitationalParameter; } );
+        if( i > 0 )
+        {
+            double radius = 5.0E10 * static_cast< double >( i );
+            double angle = 0.7 * static_cast< double >( i );
+            double velocity = std::sqrt( 1.32712440018E20 / radius );
+            bodyStates[ i ] << radius * std::cos( angle ), radius * std::sin( angle ), 1.0E-2 * radius * std::sin( angle ),
+                    -velocity * std::sin( angle ), velocity * std::cos( angle ), 0.0;
+        }
+        stateFunctions.push_back( [ &bodyStates, i ]( ){ return bodyStates[ i ]; } );
+    }
+
+    relativity::EinsteinInfeldHoffmannEquations eihEquations(
+                bodyNames, bodyNames, gravitationalParameterFunctions, stateFunctions,
+                [ ]( ){ return 1.0; }, [ ]( ){ return 1.0; } );
+    eihEquations.setNumberOfThreads( numberOfThreads );
+
+    // Time updates, with small change in state to prevent caching of results
+    double accelerationCheckSum = 0.0;
+    const double updateTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int k = 0; k < numberOfUpdates; k++ )
+        {
+            bodyStates[ 1 ]( 0 ) += 1.0;
+            eihEquations.update( static_cast< double >( k ) );
+            accelerationCheckSum += eihEquations.getAccelerationOfBody( numberOfBodies - 1 )( 0 );
+        }
+        eihEquations.resetCurrentTime( );
+    } ) / static_cast< double >( numberOfUpdates );
+
+    std::cout << std::setw( 10 ) << numberOfBodies << std::setw( 10 ) << numberOfThreads
+              << std::setw( 18 ) << 1.0E6 * updateTime
+              << std::setw( 18 ) << 1.0E9 * updateTime / static_cast< double >( numberOfBodies * ( numberOfBodies - 1 ) )
+              << std::setw( 18 ) << accelerationCheckSum << std::endl;
+}
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfUpdates = benchmarks::getIntegerArgument( argc, argv, 1, 200 );
+    const unsigned int numberOfThreads = static_cast< unsigned int >( benchmarks::getIntegerArgument( argc, argv, 2, 1 ) );
+
+    std::cout << "EIH equations update benchmark: " << numberOfUpdates << " updates" << std::endl;
+    std::cout << std::setw( 10 ) << "bodies" << std::setw( 10 ) << "threads" << std::setw( 18 ) << "time/update [us]"
+              << std::setw( 18 ) << "time/pair [ns]" << std::setw( 18 ) << "check sum" << std::endl;
+
+    const std::vector< int > numbersOfBodies = { 10, 30, 100 };
+    for( unsigned int i = 0; i < numbersOfBodies.size( ); i++ )
+    {
+        printEinsteinInfeldHoffmannUpdateTime( numbersOfBodies.at( i ), numberOfUpdates, 1 );
+        if( numberOfThreads > 1 )
+        {
+            printEinsteinInfeldHoffmannUpdateTime( numbersOfBodies.at( i ), numberOfUpdates, numberOfThreads );
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the scaling of ensemble (Monte Carlo) propagation with the number of threads. Usage:
+ *
+ *      benchmark_EnsemblePropagation [numberOfRuns] [maximumNumberOfThreads]
+ *
+ *    By default, 64 runs are propagated, using 1 up to all available hardware threads.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "tudat/simulation/simulation.h"
+#include "tudat/simulation/propagation_setup/ensemblePropagation.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+//! Function to create the bodies of a single ensemble member (Earth with degree 8 gravity field, and a vehicle)
+SystemOfBodies createBenchmarkBodies( )
+{
+    SystemOfBodies bodies( "Earth", "ECLIPJ2000" );
+    bodies.createEmptyBody( "Earth" );
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Earth" )->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                            [ ]( ){ return Eigen::Vector6d::Zero( ); }, "Earth" ) );
+    bodies.at( "Earth" )->setRotationalEphemeris( std::make_shared< ephemerides::SimpleRotationalEphemeris >(
+                                                      0.0, mathematical_constants::PI / 2.0, 0.0, 7.292115E-5, 0.0,
+                                                      "ECLIPJ2000", "IAU_Earth" ) );
+
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 9, 9 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 9, 9 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for( int degree = 2; degree <= 8; degree++ )
+    {
+        for( int order = 0; order <= degree; order++ )
+        {
+            cosineCoefficients( degree, order ) = 1.0E-6 / static_cast< double >( degree * degree );
+            if( order > 0 )
+            {
+                sineCoefficients( degree, order ) = -0.5E-6 / static_cast< double >( degree * degree );
+            }
+        }
+    }
+    bodies.at( "Earth" )->setGravityFieldModel( std::make_shared< gravitation::SphericalHarmonicsGravityField >(
+                                                    3.986004418E14, 6378137.0, cosineCoefficients, sineCoefficients,
+                                                    "IAU_Earth" ) );
+    return bodies;
+}
+
+//! Function to create the propagation settings of a single ensemble member, with dispersed initial state
+std::shared_ptr< SingleArcPropagatorSettings< double, double > > createBenchmarkPropagatorSettings(
+        const int runIndex, const SystemOfBodies& bodies )
+{
+    SelectedAccelerationMap accelerationSettings;
+    accelerationSettings[ "Vehicle" ][ "Earth" ].push_back( sphericalHarmonicAcceleration( 8, 8 ) );
+    basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodies, accelerationSettings, { "Vehicle" }, { "Earth" } );
+
+    Eigen::Vector6d initialKeplerElements;
+    initialKeplerElements << 7.0E6 + 100.0 * static_cast< double >( runIndex ), 0.01, 1.2, 0.3, 0.4,
+            0.001 * static_cast< double >( runIndex );
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements( initialKeplerElements, 3.986004418E14 );
+
+    return std::make_shared< TranslationalStatePropagatorSettings< double, double > >(
+                std::vector< std::string >{ "Earth" }, accelerationModelMap, std::vector< std::string >{ "Vehicle" },
+                initialState, 0.0, rungeKutta4Settings( 10.0 ),
+                std::make_shared< PropagationTimeTerminationSettings >( 86400.0 ) );
+}
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfRuns = benchmarks::getIntegerArgument( argc, argv, 1, 64 );
+    const int maximumNumberOfThreads = benchmarks::getIntegerArgument(
+                argc, argv, 2, static_cast< int >( utilities::getNumberOfAvailableThreads( ) ) );
+
+    // Thread counts to benchmark: powers of two, and maximum number of threads
+    std::vector< int > numberOfThreadsList;
+    for( int numberOfThreads = 1; numberOfThreads < maximumNumberOfThreads; numberOfThreads *= 2 )
+    {
+        numberOfThreadsList.push_back( numberOfThreads );
+    }
+    numberOfThreadsList.push_back( maximumNumberOfThreads );
+
+    std::cout << "Ensemble propagation benchmark: " << numberOfRuns << " runs, 1 day, degree 8 gravity, RK4 (10 s)"
+              << std::endl;
+    std::cout << std::setw( 10 ) << "threads" << std::setw( 14 ) << "time [s]" << std::setw( 14 ) << "runs/s"
+              << std::setw( 12 ) << "speedup" << std::setw( 14 ) << "efficiency" << std::endl;
+
+    double singleThreadTime = TUDAT_NAN;
+    for( unsigned int i = 0; i < numberOfThreadsList.size( ); i++ )
+    {
+        const int numberOfThreads = numberOfThreadsList.at( i );
+        std::shared_ptr< utilities::ThreadPool > threadPool =
+                ( numberOfThreads > 1 ) ? std::make_shared< utilities::ThreadPool >( numberOfThreads ) : nullptr;
+
+        double wallClockTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            propagateSingleArcEnsemble< double, double >(
+                        &createBenchmarkBodies, &createBenchmarkPropagatorSettings, numberOfRuns, threadPool );
+        }, 1 );
+
+        if( numberOfThreads == 1 )
+        {
+            singleThreadTime = wallClockTime;
+        }
+        std::cout << std::setw( 10 ) << numberOfThreads << std::setw( 14 ) << wallClockTime
+                  << std::setw( 14 ) << static_cast< double >( numberOfRuns ) / wallClockTime
+                  << std::setw( 12 ) << singleThreadTime / wallClockTime
+                  << std::setw( 14 ) << singleThreadTime / wallClockTime / static_cast< double >( numberOfThreads )
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
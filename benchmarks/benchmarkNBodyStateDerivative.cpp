@@ -0,0 +1,144 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the time per state derivative evaluation for a solar-system-like N-body propagation (all bodies
+ *    propagated, mutual point-mass attraction between all bodies), evaluated through the DynamicsStateDerivativeModel.
+ *    The evaluation time is split into the acceleration computations (updateMembers of all acceleration models, timed
+ *    separately) and the remaining dispatch overhead. Usage:
+ *
+ *      benchmark_NBodyStateDerivative [numberOfBodies] [numberOfEvaluations]
+ *
+ *    By default, 20 bodies and 20000 evaluations are used.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/gravitation/centralGravityModel.h"
+#include "tudat/astro/propagators/dynamicsStateDerivativeModel.h"
+#include "tudat/astro/propagators/nBodyCowellStateDerivative.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+using namespace tudat::propagators;
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfBodies = benchmarks::getIntegerArgument( argc, argv, 1, 20 );
+    const int numberOfEvaluations = benchmarks::getIntegerArgument( argc, argv, 2, 20000 );
+
+    // Define bodies on circular orbits, with positions that are set by the environment update
+    std::vector< std::string > bodyNames;
+    std::vector< double > gravitationalParameters;
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 * numberOfBodies );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        bodyNames.push_back( "Body" + std::to_string( i ) );
+        gravitationalParameters.push_back( ( i == 0 ) ? 1.32712440018E20 : 1.0E14 * static_cast< double >( i ) );
+        if( i > 0 )
+        {
+            double radius = 5.0E10 * static_cast< double >( i );
+            double angle = 0.7 * static_cast< double >( i );
+            double velocity = std::sqrt( gravitationalParameters.at( 0 ) / radius );
+            initialState.segment( 6 * i, 6 ) << radius * std::cos( angle ), radius * std::sin( angle ), 0.0,
+                    -velocity * std::sin( angle ), velocity * std::cos( angle ), 0.0;
+        }
+    }
+    std::vector< Eigen::Vector3d > currentPositions( numberOfBodies, Eigen::Vector3d::Zero( ) );
+
+    // Create mutual point-mass accelerations between all bodies
+    basic_astrodynamics::AccelerationMap accelerationMap;
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        for( int j = 0; j < numberOfBodies; j++ )
+        {
+            if( i != j )
+            {
+                accelerationMap[ bodyNames.at( i ) ][ bodyNames.at( j ) ].push_back(
+                            std::make_shared< gravitation::CentralGravitationalAccelerationModel3d >(
+                                [ &currentPositions, i ]( Eigen::Vector3d& position ){ position = currentPositions[ i ]; },
+                                gravitationalParameters.at( j ),
+                                [ &currentPositions, j ]( Eigen::Vector3d& position ){ position = currentPositions[ j ]; } ) );
+            }
+        }
+    }
+
+    // Create state derivative model, with environment update that sets the current positions
+    std::map< std::string, std::function< Eigen::Vector6d( const double ) > > bodyStateFunctions;
+    std::shared_ptr< CentralBodyData< double, double > > centralBodyData =
+            std::make_shared< CentralBodyData< double, double > >(
+                std::vector< std::string >( numberOfBodies, "SSB" ), bodyNames, bodyStateFunctions,
+                [ ]( const double ){ return Eigen::Vector6d::Zero( ).eval( ); }, "SSB" );
+    std::shared_ptr< NBodyCowellStateDerivative< double, double > > nBodyStateDerivative =
+            std::make_shared< NBodyCowellStateDerivative< double, double > >( accelerationMap, centralBodyData, bodyNames );
+
+    DynamicsStateDerivativeModel< double, double > stateDerivativeModel(
+    { nBodyStateDerivative },
+                [ & ]( const double, const std::unordered_map< IntegratedStateType, Eigen::VectorXd >& currentStates,
+                const std::vector< IntegratedStateType >& )
+    {
+        const Eigen::VectorXd& currentTranslationalState = currentStates.at( translational_state );
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            currentPositions[ i ] = currentTranslationalState.segment( 6 * i, 3 );
+        }
+    } );
+    stateDerivativeModel.setPropagationSettings( std::vector< IntegratedStateType >( ), true, false );
+
+    std::cout << "N-body state derivative benchmark: " << numberOfBodies << " bodies, "
+              << numberOfBodies * ( numberOfBodies - 1 ) << " accelerations" << std::endl;
+
+    // Time full state derivative evaluations
+    Eigen::MatrixXd state = initialState;
+    Eigen::MatrixXd stateDerivative;
+    double totalTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            stateDerivative = stateDerivativeModel.computeStateDerivative( static_cast< double >( i ), state );
+        }
+    } );
+
+    // Time computation of accelerations only
+    std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel3d > > accelerationModels;
+    for( auto bodyIterator : accelerationMap )
+    {
+        for( auto exertingBodyIterator : bodyIterator.second )
+        {
+            for( unsigned int i = 0; i < exertingBodyIterator.second.size( ); i++ )
+            {
+                accelerationModels.push_back( exertingBodyIterator.second.at( i ) );
+            }
+        }
+    }
+    double accelerationTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            for( unsigned int j = 0; j < accelerationModels.size( ); j++ )
+            {
+                accelerationModels[ j ]->updateMembers( static_cast< double >( i ) );
+            }
+        }
+    } );
+
+    double timePerEvaluation = totalTime / static_cast< double >( numberOfEvaluations );
+    double accelerationTimePerEvaluation = accelerationTime / static_cast< double >( numberOfEvaluations );
+    std::cout << std::setw( 36 ) << "time per evaluation [us]: " << 1.0E6 * timePerEvaluation << std::endl;
+    std::cout << std::setw( 36 ) << "of which accelerations [us]: " << 1.0E6 * accelerationTimePerEvaluation << std::endl;
+    std::cout << std::setw( 36 ) << "of which overhead [us]: "
+              << 1.0E6 * ( timePerEvaluation - accelerationTimePerEvaluation ) << std::endl;
+    std::cout << std::setw( 36 ) << "check sum of state derivative: " << stateDerivative.norm( ) << std::endl;
+
+    return EXIT_SUCCESS;
+}
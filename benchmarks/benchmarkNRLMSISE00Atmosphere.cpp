@@ -0,0 +1,179 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the NRLMSISE00 atmosphere density evaluation along a low Earth orbit (400 +/- 20 km altitude,
+ *    51.6 deg inclination), sampled as the stages of an RK4 integrator with a 10 s time step. Compares the retrieval of
+ *    the model input from the solar activity data map to that from the preprocessed solar activity table, and the full
+ *    model evaluation to the interpolated density for different relative tolerances. Usage:
+ *
+ *      benchmark_NRLMSISE00Atmosphere [numberOfOrbits] [spaceWeatherFile]
+ *
+ *    By default, 16 orbits (about one day) are evaluated, using the default space weather file.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "tudat/astro/aerodynamics/nrlmsise00Atmosphere.h"
+#include "tudat/astro/aerodynamics/nrlmsise00InputFunctions.h"
+#include "tudat/astro/basic_astro/timeConversions.h"
+#include "tudat/io/basicInputOutput.h"
+#include "tudat/io/solarActivityData.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfOrbits = benchmarks::getIntegerArgument( argc, argv, 1, 16 );
+    const std::string spaceWeatherFile = ( argc > 2 ) ?
+                std::string( argv[ 2 ] ) : paths::getSpaceWeatherDataPath( ) + "/sw19571001.txt";
+
+    const input_output::solar_activity::SolarActivityDataMap solarActivityData =
+            input_output::solar_activity::readSolarActivityData( spaceWeatherFile );
+
+    // Define orbit, starting halfway through the solar activity data
+    const double orbitalPeriod = 5550.0;
+    const double inclination = 51.6 * mathematical_constants::PI / 180.0;
+    const double earthRotationRate = 7.292115E-5;
+    const double initialTime = basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                std::floor( 0.5 * ( solarActivityData.begin( )->first + solarActivityData.rbegin( )->first ) ) + 0.5 );
+
+    // Create positions (altitude, longitude, latitude, time) at stages of RK4 integrator
+    std::vector< std::array< double, 4 > > positions;
+    const double timeStep = 10.0;
+    const std::array< double, 4 > stageTimes = { { 0.0, 0.5 * timeStep, 0.5 * timeStep, timeStep } };
+    for( double stepTime = 0.0; stepTime < numberOfOrbits * orbitalPeriod; stepTime += timeStep )
+    {
+        for( int stage = 0; stage < 4; stage++ )
+        {
+            const double time = stepTime + stageTimes[ stage ];
+            const double argumentOfLatitude = 2.0 * mathematical_constants::PI * time / orbitalPeriod;
+            positions.push_back(
+            { { 400.0E3 + 20.0E3 * std::sin( argumentOfLatitude + 0.3 ) + ( stage == 2 ? 1.0 : 0.0 ),
+                std::remainder( std::atan2( std::cos( inclination ) * std::sin( argumentOfLatitude ),
+                                            std::cos( argumentOfLatitude ) ) - earthRotationRate * time,
+                                2.0 * mathematical_constants::PI ),
+                std::asin( std::sin( inclination ) * std::sin( argumentOfLatitude ) ),
+                initialTime + time } } );
+        }
+    }
+    const int numberOfEvaluations = positions.size( );
+
+    std::cout << "NRLMSISE00 atmosphere benchmark: " << numberOfEvaluations << " evaluations along "
+              << numberOfOrbits << " orbits" << std::endl << std::endl;
+
+    // Time retrieval of model input
+    const std::shared_ptr< aerodynamics::NRLMSISE00SolarActivityTable > solarActivityTable =
+            std::make_shared< aerodynamics::NRLMSISE00SolarActivityTable >( solarActivityData );
+    double checkSum = 0.0;
+    const double mapInputTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            checkSum += aerodynamics::nrlmsiseInputFunction(
+                        positions[ i ][ 0 ], positions[ i ][ 1 ], positions[ i ][ 2 ], positions[ i ][ 3 ],
+                    solarActivityData ).localSolarTime;
+        }
+    } );
+    aerodynamics::NRLMSISE00Input input;
+    const double tableInputTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            solarActivityTable->updateInput( input, positions[ i ][ 3 ], positions[ i ][ 1 ] );
+            checkSum += input.localSolarTime;
+        }
+    } );
+
+    std::cout << std::setw( 24 ) << "input retrieval" << std::setw( 16 ) << "time [us]" << std::endl;
+    std::cout << std::setw( 24 ) << "data map" << std::setw( 16 ) << mapInputTime / numberOfEvaluations * 1.0E6
+              << std::endl;
+    std::cout << std::setw( 24 ) << "table" << std::setw( 16 ) << tableInputTime / numberOfEvaluations * 1.0E6
+              << std::endl << std::endl;
+
+    // Time full model evaluation, with input from data map and from table
+    aerodynamics::NRLMSISE00Atmosphere mapAtmosphere(
+                std::bind( &aerodynamics::nrlmsiseInputFunction, std::placeholders::_1, std::placeholders::_2,
+                           std::placeholders::_3, std::placeholders::_4, solarActivityData, false, 0.0 ) );
+    aerodynamics::NRLMSISE00Atmosphere tableAtmosphere( solarActivityData );
+
+    std::vector< double > fullDensities( numberOfEvaluations );
+    const double mapDensityTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            fullDensities[ i ] = mapAtmosphere.getDensity(
+                        positions[ i ][ 0 ], positions[ i ][ 1 ], positions[ i ][ 2 ], positions[ i ][ 3 ] );
+        }
+    } );
+    std::vector< double > tableDensities( numberOfEvaluations );
+    const double tableDensityTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            tableDensities[ i ] = tableAtmosphere.getDensity(
+                        positions[ i ][ 0 ], positions[ i ][ 1 ], positions[ i ][ 2 ], positions[ i ][ 3 ] );
+        }
+    } );
+
+    std::cout << std::setw( 24 ) << "density, tolerance" << std::setw( 16 ) << "time [us]" << std::setw( 12 )
+              << "speedup" << std::setw( 18 ) << "evals/call" << std::setw( 18 ) << "max. rel. diff." << std::endl;
+    std::cout << std::setw( 24 ) << "full, data map" << std::setw( 16 ) << mapDensityTime / numberOfEvaluations * 1.0E6
+              << std::setw( 12 ) << 1.0 << std::setw( 18 ) << 1.0 << std::setw( 18 ) << 0.0 << std::endl;
+
+    double maximumTableDifference = 0.0;
+    for( int i = 0; i < numberOfEvaluations; i++ )
+    {
+        maximumTableDifference = std::max(
+                    maximumTableDifference, std::fabs( tableDensities[ i ] / fullDensities[ i ] - 1.0 ) );
+    }
+    std::cout << std::setw( 24 ) << "full, table" << std::setw( 16 ) << tableDensityTime / numberOfEvaluations * 1.0E6
+              << std::setw( 12 ) << mapDensityTime / tableDensityTime << std::setw( 18 ) << 1.0
+              << std::setw( 18 ) << maximumTableDifference << std::endl;
+
+    // Time interpolated density evaluation (including building the grid, which is rebuilt for each repetition)
+    for( double relativeTolerance : { 1.0E-2, 1.0E-3, 1.0E-4 } )
+    {
+        std::vector< double > interpolatedDensities( numberOfEvaluations );
+        const double interpolatedDensityTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            tableAtmosphere.setDensityInterpolation( relativeTolerance );
+            for( int i = 0; i < numberOfEvaluations; i++ )
+            {
+                interpolatedDensities[ i ] = tableAtmosphere.getDensity(
+                            positions[ i ][ 0 ], positions[ i ][ 1 ], positions[ i ][ 2 ], positions[ i ][ 3 ] );
+            }
+        } );
+
+        double maximumDifference = 0.0;
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            maximumDifference = std::max(
+                        maximumDifference, std::fabs( interpolatedDensities[ i ] / fullDensities[ i ] - 1.0 ) );
+        }
+        std::cout << std::setw( 24 ) << relativeTolerance << std::setw( 16 )
+                  << interpolatedDensityTime / numberOfEvaluations * 1.0E6 << std::setw( 12 )
+                  << mapDensityTime / interpolatedDensityTime << std::setw( 18 )
+                  << static_cast< double >( tableAtmosphere.getNumberOfDensityInterpolationModelEvaluations( ) ) /
+                     numberOfEvaluations << std::setw( 18 ) << maximumDifference << std::endl;
+    }
+
+    // Print check sum, to prevent input retrieval from being optimized away
+    std::cout << std::endl << "Check sum: " << checkSum << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*    Copyright (c) 2010-2022, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the radiation pressure force on a paneled target due to a paneled source (e.g. Earth albedo), comparing
+ *    evaluation per source panel (PaneledRadiationPressureTargetModel::updateRadiationPressureForcing) to evaluation for
+ *    all source panels at once (updateRadiationPressureForcingFromSourcePanels), both for panels with specular-diffuse
+ *    reflection laws (using the per-panel optical coefficients) and for panels with a generic reflection law (evaluated
+ *    through the reflection law of each panel). Usage:
+ *
+ *      benchmark_PaneledRadiationPressure [numberOfTargetPanels] [numberOfSourcePanels]
+ *
+ *    By default, a target with 150 panels and a source with 2000 visible panels are used.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/electromagnetism/radiationPressureTargetModel.h"
+#include "tudat/astro/electromagnetism/reflectionLaw.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+using namespace tudat::electromagnetism;
+
+//! Reflection law delegating to a specular-diffuse law, to time the evaluation of panels with generic reflection laws
+class DelegatingReflectionLaw : public ReflectionLaw
+{
+public:
+    DelegatingReflectionLaw( const std::shared_ptr< ReflectionLaw > reflectionLaw ): reflectionLaw_( reflectionLaw ){ }
+
+    double evaluateReflectedFraction(
+        const Eigen::Vector3d& surfaceNormal,
+        const Eigen::Vector3d& incomingDirection,
+        const Eigen::Vector3d& observerDirection) const override
+    {
+        return reflectionLaw_->evaluateReflectedFraction( surfaceNormal, incomingDirection, observerDirection );
+    }
+
+    Eigen::Vector3d evaluateReactionVector(
+        const Eigen::Vector3d& surfaceNormal,
+        const Eigen::Vector3d& incomingDirection) const override
+    {
+        return reflectionLaw_->evaluateReactionVector( surfaceNormal, incomingDirection );
+    }
+
+    Eigen::Matrix3d evaluateReactionVectorDerivativeWrtTargetPosition(
+        const Eigen::Vector3d& surfaceNormal,
+        const Eigen::Vector3d& incomingDirection,
+        const double cosineOfAngleBetweenVectors,
+        const Eigen::Vector3d& currentReactionVector,
+        const Eigen::Matrix3d& sourceUnitVectorPartial,
+        const Eigen::Matrix< double, 1, 3 >& cosineAnglePartial ) override
+    {
+        return reflectionLaw_->evaluateReactionVectorDerivativeWrtTargetPosition(
+            surfaceNormal, incomingDirection, cosineOfAngleBetweenVectors, currentReactionVector,
+            sourceUnitVectorPartial, cosineAnglePartial );
+    }
+
+private:
+    std::shared_ptr< ReflectionLaw > reflectionLaw_;
+};
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfTargetPanels = benchmarks::getIntegerArgument( argc, argv, 1, 150 );
+    const int numberOfSourcePanels = benchmarks::getIntegerArgument( argc, argv, 2, 2000 );
+
+    // Create target panels with random orientation and optical properties
+    std::srand( 0 );
+    std::vector< std::shared_ptr< system_models::VehicleExteriorPanel > > panels, genericPanels;
+    for( int i = 0; i < numberOfTargetPanels; i++ )
+    {
+        const Eigen::Vector3d surfaceNormal = Eigen::Vector3d::Random( ).normalized( );
+        const double panelArea = 1.0 + Eigen::Vector2d::Random( )( 0 );
+        const Eigen::Vector2d reflectivities = 0.25 * ( Eigen::Vector2d::Random( ) + Eigen::Vector2d::Ones( ) );
+        const std::shared_ptr< SpecularDiffuseMixReflectionLaw > reflectionLaw =
+                reflectionLawFromSpecularAndDiffuseReflectivity( reflectivities( 0 ), reflectivities( 1 ), ( i % 2 == 0 ) );
+
+        panels.push_back( std::make_shared< system_models::VehicleExteriorPanel >(
+                              surfaceNormal, panelArea, "", reflectionLaw ) );
+        genericPanels.push_back( std::make_shared< system_models::VehicleExteriorPanel >(
+                                     surfaceNormal, panelArea, "", std::make_shared< DelegatingReflectionLaw >( reflectionLaw ) ) );
+    }
+
+    // Create source panels (directions within a cone of 60 deg half-angle, as for Earth albedo in low orbit)
+    std::vector< double > sourceIrradiances;
+    std::vector< Eigen::Vector3d > sourceToTargetDirections;
+    for( int i = 0; i < numberOfSourcePanels; i++ )
+    {
+        sourceIrradiances.push_back( 100.0 * ( 1.0 + Eigen::Vector2d::Random( )( 0 ) ) );
+        sourceToTargetDirections.push_back( ( Eigen::Vector3d::UnitZ( ) + 0.6 * Eigen::Vector3d::Random( ) ).normalized( ) );
+    }
+
+    std::cout << "Paneled radiation pressure benchmark: " << numberOfTargetPanels << " target panels, "
+              << numberOfSourcePanels << " source panels" << std::endl;
+    std::cout << std::setw( 20 ) << "reflection law" << std::setw( 16 ) << "per panel [us]" << std::setw( 16 )
+              << "list [us]" << std::setw( 12 ) << "speedup" << std::setw( 18 ) << "max. rel. diff." << std::endl;
+
+    for( bool useGenericReflectionLaw : { false, true } )
+    {
+        PaneledRadiationPressureTargetModel targetModel( useGenericReflectionLaw ? genericPanels : panels );
+        targetModel.updateMembers( 0.0 );
+        const int sourceIndex = targetModel.getSourceIndex( "Source" );
+
+        // Time evaluation per source panel
+        Eigen::Vector3d perPanelForce;
+        const double perPanelTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            targetModel.resetComputations( sourceIndex );
+            for( int i = 0; i < numberOfSourcePanels; i++ )
+            {
+                targetModel.updateRadiationPressureForcing(
+                            sourceIrradiances[ i ], sourceToTargetDirections[ i ], false, sourceIndex );
+            }
+            perPanelForce = targetModel.getCurrentRadiationPressureForce( sourceIndex );
+        } );
+
+        // Time evaluation for all source panels at once
+        Eigen::Vector3d listForce;
+        const double listTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            targetModel.resetComputations( sourceIndex );
+            targetModel.updateRadiationPressureForcingFromSourcePanels(
+                        sourceIrradiances, sourceToTargetDirections, sourceIndex );
+            listForce = targetModel.getCurrentRadiationPressureForce( sourceIndex );
+        } );
+
+        std::cout << std::setw( 20 ) << ( useGenericReflectionLaw ? "generic" : "specular-diffuse" )
+                  << std::setw( 16 ) << perPanelTime * 1.0E6
+                  << std::setw( 16 ) << listTime * 1.0E6
+                  << std::setw( 12 ) << perPanelTime / listTime
+                  << std::setw( 18 ) << ( listForce - perPanelForce ).norm( ) / perPanelForce.norm( ) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
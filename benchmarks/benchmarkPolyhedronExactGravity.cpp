@@ -0,0 +1,125 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the exact (facet-by-facet and edge-by-edge) polyhedron gravity evaluation, comparing the per-facet
+ *    and per-edge free functions operating on the dyad matrices to the blocked PolyhedronGravityCache evaluation, using
+ *    one and multiple threads. Polyhedra with 8k, 131k and 2.1M facets (subdivided octahedra projected on a perturbed
+ *    ellipsoid) are used. Usage:
+ *
+ *      benchmark_PolyhedronExactGravity [numberOfEvaluations] [numberOfThreads]
+ *
+ *    By default, 10 evaluations (at different positions) are timed per polyhedron, and the multi-threaded evaluation
+ *    uses 4 threads.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/gravitation/polyhedronGravityField.h"
+#include "tudat/math/basic/polyhedron.h"
+
+#include "benchmarkPolyhedronUtilities.h"
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfEvaluations = benchmarks::getIntegerArgument( argc, argv, 1, 10 );
+    const int numberOfThreads = benchmarks::getIntegerArgument( argc, argv, 2, 4 );
+    const double gravitationalParameter = 1.0;
+
+    std::cout << "Exact polyhedron gravity benchmark: " << numberOfEvaluations << " evaluations per polyhedron, "
+              << numberOfThreads << " threads" << std::endl;
+    std::cout << std::setw( 12 ) << "facets" << std::setw( 16 ) << "facet/edge [ms]" << std::setw( 16 )
+              << "cache [ms]" << std::setw( 16 ) << "threaded [ms]" << std::setw( 12 ) << "speedup"
+              << std::setw( 18 ) << "max. rel. diff." << std::endl;
+
+    std::srand( 0 );
+    std::vector< int > numbersOfSubdivisions = { 5, 7, 9 };
+    for( unsigned int i = 0; i < numbersOfSubdivisions.size( ); i++ )
+    {
+        Eigen::MatrixXd verticesCoordinates;
+        Eigen::MatrixXi verticesDefiningEachFacet;
+        benchmarks::createPolyhedron( numbersOfSubdivisions.at( i ), verticesCoordinates, verticesDefiningEachFacet );
+
+        // Create test positions between 0.05 and 2 radii above the ellipsoid
+        std::vector< Eigen::Vector3d > positions;
+        for( int j = 0; j < numberOfEvaluations; j++ )
+        {
+            const Eigen::Vector3d direction = Eigen::Vector3d::Random( ).normalized( );
+            const double heightFactor = 1.05 + 0.95 * ( 1.0 + Eigen::Vector2d::Random( )( 0 ) );
+            positions.push_back( heightFactor * ( Eigen::Vector3d( ) <<
+                    1000.0 * direction( 0 ), 700.0 * direction( 1 ), 500.0 * direction( 2 ) ).finished( ) );
+        }
+
+        gravitation::PolyhedronGravityField gravityField(
+                    gravitationalParameter, verticesCoordinates, verticesDefiningEachFacet );
+        const double gravitationalConstantTimesDensity = gravitationalParameter / gravityField.getVolume( );
+
+        // Time evaluation using the per-facet and per-edge free functions
+        std::vector< Eigen::Vector3d > referenceGradients( numberOfEvaluations );
+        const double referenceTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            Eigen::MatrixXd verticesCoordinatesRelativeToFieldPoint;
+            Eigen::VectorXd perFacetFactor, perEdgeFactor;
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                basic_mathematics::calculatePolyhedronVerticesCoordinatesRelativeToFieldPoint(
+                            verticesCoordinatesRelativeToFieldPoint, positions[ j ], verticesCoordinates );
+                basic_mathematics::calculatePolyhedronPerFacetFactor(
+                            perFacetFactor, verticesCoordinatesRelativeToFieldPoint, verticesDefiningEachFacet );
+                basic_mathematics::calculatePolyhedronPerEdgeFactor(
+                            perEdgeFactor, verticesCoordinatesRelativeToFieldPoint,
+                            gravityField.getVerticesDefiningEachEdge( ) );
+                referenceGradients[ j ] = basic_mathematics::calculatePolyhedronGradientOfGravitationalPotential(
+                            gravitationalConstantTimesDensity, verticesCoordinatesRelativeToFieldPoint,
+                            verticesDefiningEachFacet, gravityField.getVerticesDefiningEachEdge( ),
+                            gravityField.getFacetDyads( ), gravityField.getEdgeDyads( ), perFacetFactor, perEdgeFactor );
+            }
+        } );
+
+        // Time evaluation using the cache, single- and multi-threaded
+        std::vector< double > cacheTimes;
+        double maximumDifference = 0.0;
+        for( int threads : { 1, numberOfThreads } )
+        {
+            gravityField.setNumberOfThreads( threads );
+            std::vector< Eigen::Vector3d > cacheGradients( numberOfEvaluations );
+            cacheTimes.push_back( benchmarks::getMinimumWallClockTime( [ & ]( )
+            {
+                for( int j = 0; j < numberOfEvaluations; j++ )
+                {
+                    cacheGradients[ j ] = gravityField.getGradientOfPotential( positions[ j ] );
+                }
+            } ) );
+
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                maximumDifference = std::max(
+                            maximumDifference,
+                            ( cacheGradients[ j ] - referenceGradients[ j ] ).norm( ) / referenceGradients[ j ].norm( ) );
+            }
+        }
+
+        std::cout << std::setw( 12 ) << verticesDefiningEachFacet.rows( )
+                  << std::setw( 16 ) << referenceTime / numberOfEvaluations * 1.0E3
+                  << std::setw( 16 ) << cacheTimes.at( 0 ) / numberOfEvaluations * 1.0E3
+                  << std::setw( 16 ) << cacheTimes.at( 1 ) / numberOfEvaluations * 1.0E3
+                  << std::setw( 12 ) << referenceTime / cacheTimes.at( 1 )
+                  << std::setw( 18 ) << maximumDifference << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
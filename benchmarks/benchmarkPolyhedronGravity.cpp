@@ -0,0 +1,144 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the polyhedron gravity and altitude evaluation, comparing the exact (brute-force) computation to the
+ *    computation using the PolyhedronFacetTree, for polyhedra with 2k, 33k and 131k facets (subdivided octahedra
+ *    projected on a perturbed ellipsoid). The gravity is evaluated at field points between 0.05 and 2 radii above the
+ *    surface, for different maximum relative truncation errors. Usage:
+ *
+ *      benchmark_PolyhedronGravity [numberOfEvaluations]
+ *
+ *    By default, 100 evaluations (at different positions) are timed per polyhedron.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/polyhedronBodyShapeModel.h"
+#include "tudat/astro/gravitation/polyhedronGravityField.h"
+
+#include "benchmarkPolyhedronUtilities.h"
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfEvaluations = benchmarks::getIntegerArgument( argc, argv, 1, 100 );
+    const double gravitationalParameter = 1.0;
+
+    std::cout << "Polyhedron gravity benchmark: " << numberOfEvaluations << " evaluations per polyhedron" << std::endl;
+
+    std::srand( 0 );
+    std::vector< int > numbersOfSubdivisions = { 4, 6, 7 };
+    for( unsigned int i = 0; i < numbersOfSubdivisions.size( ); i++ )
+    {
+        Eigen::MatrixXd verticesCoordinates;
+        Eigen::MatrixXi verticesDefiningEachFacet;
+        benchmarks::createPolyhedron( numbersOfSubdivisions.at( i ), verticesCoordinates, verticesDefiningEachFacet );
+
+        // Create test positions between 0.05 and 2 radii above the ellipsoid
+        std::vector< Eigen::Vector3d > positions;
+        for( int j = 0; j < numberOfEvaluations; j++ )
+        {
+            const Eigen::Vector3d direction = Eigen::Vector3d::Random( ).normalized( );
+            const double heightFactor = 1.05 + 0.95 * ( 1.0 + Eigen::Vector2d::Random( )( 0 ) );
+            positions.push_back( heightFactor * ( Eigen::Vector3d( ) <<
+                    1000.0 * direction( 0 ), 700.0 * direction( 1 ), 500.0 * direction( 2 ) ).finished( ) );
+        }
+
+        gravitation::PolyhedronGravityField gravityField(
+                    gravitationalParameter, verticesCoordinates, verticesDefiningEachFacet );
+
+        std::cout << std::endl << "Number of facets: " << verticesDefiningEachFacet.rows( ) << std::endl;
+
+        // Time exact gravity evaluation
+        std::vector< Eigen::Vector3d > exactGradients( numberOfEvaluations );
+        const double exactTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                exactGradients[ j ] = gravityField.getGradientOfPotential( positions[ j ] );
+            }
+        } );
+
+        std::cout << std::setw( 24 ) << "gravity, error bound" << std::setw( 16 ) << "time [us]" << std::setw( 12 )
+                  << "speedup" << std::setw( 18 ) << "max. rel. diff." << std::endl;
+        std::cout << std::setw( 24 ) << "exact" << std::setw( 16 ) << exactTime / numberOfEvaluations * 1.0E6
+                  << std::setw( 12 ) << 1.0 << std::setw( 18 ) << 0.0 << std::endl;
+
+        // Time gravity evaluation using facet tree
+        for( double maximumRelativeTruncationError : { 0.0, 1.0E-8, 1.0E-6, 1.0E-4 } )
+        {
+            gravityField.setFacetTreeEvaluation( maximumRelativeTruncationError );
+
+            std::vector< Eigen::Vector3d > treeGradients( numberOfEvaluations );
+            const double treeTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+            {
+                for( int j = 0; j < numberOfEvaluations; j++ )
+                {
+                    treeGradients[ j ] = gravityField.getGradientOfPotential( positions[ j ] );
+                }
+            } );
+
+            double maximumDifference = 0.0;
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                maximumDifference = std::max(
+                            maximumDifference, ( treeGradients[ j ] - exactGradients[ j ] ).norm( ) / exactGradients[ j ].norm( ) );
+            }
+
+            std::cout << std::setw( 24 ) << maximumRelativeTruncationError << std::setw( 16 )
+                      << treeTime / numberOfEvaluations * 1.0E6 << std::setw( 12 ) << exactTime / treeTime
+                      << std::setw( 18 ) << maximumDifference << std::endl;
+        }
+
+        // Time altitude evaluation, with and without facet tree
+        basic_astrodynamics::PolyhedronBodyShapeModel shapeModel(
+                    verticesCoordinates, verticesDefiningEachFacet, true, false );
+        std::vector< double > exactAltitudes( numberOfEvaluations );
+        const double exactAltitudeTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                exactAltitudes[ j ] = shapeModel.getAltitude( positions[ j ] );
+            }
+        }, 1 );
+
+        shapeModel.setFacetTree( gravityField.getFacetTree( ) );
+        std::vector< double > treeAltitudes( numberOfEvaluations );
+        const double treeAltitudeTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                treeAltitudes[ j ] = shapeModel.getAltitude( positions[ j ] );
+            }
+        } );
+
+        double maximumAltitudeDifference = 0.0;
+        for( int j = 0; j < numberOfEvaluations; j++ )
+        {
+            maximumAltitudeDifference = std::max(
+                        maximumAltitudeDifference, std::fabs( treeAltitudes[ j ] - exactAltitudes[ j ] ) );
+        }
+
+        std::cout << std::setw( 24 ) << "altitude" << std::setw( 16 ) << "exact [us]" << std::setw( 12 )
+                  << "tree [us]" << std::setw( 18 ) << "max. abs. diff." << std::endl;
+        std::cout << std::setw( 24 ) << "" << std::setw( 16 ) << exactAltitudeTime / numberOfEvaluations * 1.0E6
+                  << std::setw( 12 ) << treeAltitudeTime / numberOfEvaluations * 1.0E6 << std::setw( 18 )
+                  << maximumAltitudeDifference << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_BENCHMARKPOLYHEDRONUTILITIES_H
+#define TUDAT_BENCHMARKPOLYHEDRONUTILITIES_H
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace benchmarks
+{
+
+//! Function to create a polyhedron by subdividing the facets of an octahedron and projecting the new vertices on a
+//! (randomly perturbed) ellipsoid.
+inline void createPolyhedron( const int numberOfSubdivisions,
+                              Eigen::MatrixXd& verticesCoordinates,
+                              Eigen::MatrixXi& verticesDefiningEachFacet )
+{
+    std::vector< Eigen::Vector3d > vertices = {
+        Eigen::Vector3d::UnitX( ), -Eigen::Vector3d::UnitX( ), Eigen::Vector3d::UnitY( ),
+        -Eigen::Vector3d::UnitY( ), Eigen::Vector3d::UnitZ( ), -Eigen::Vector3d::UnitZ( ) };
+    std::vector< std::array< int, 3 > > facets = {
+        { 0, 2, 4 }, { 2, 1, 4 }, { 1, 3, 4 }, { 3, 0, 4 }, { 2, 0, 5 }, { 1, 2, 5 }, { 3, 1, 5 }, { 0, 3, 5 } };
+
+    for( int subdivision = 0; subdivision < numberOfSubdivisions; subdivision++ )
+    {
+        std::map< std::pair< int, int >, int > edgeMidpoints;
+        auto getMidpoint = [ & ]( const int vertex1, const int vertex2 )
+        {
+            const std::pair< int, int > edge = std::make_pair( std::min( vertex1, vertex2 ), std::max( vertex1, vertex2 ) );
+            if( edgeMidpoints.count( edge ) == 0 )
+            {
+                edgeMidpoints[ edge ] = vertices.size( );
+                vertices.push_back( ( vertices.at( vertex1 ) + vertices.at( vertex2 ) ).normalized( ) );
+            }
+            return edgeMidpoints.at( edge );
+        };
+
+        std::vector< std::array< int, 3 > > newFacets;
+        for( const std::array< int, 3 >& facet : facets )
+        {
+            const int midpoint01 = getMidpoint( facet[ 0 ], facet[ 1 ] );
+            const int midpoint12 = getMidpoint( facet[ 1 ], facet[ 2 ] );
+            const int midpoint20 = getMidpoint( facet[ 2 ], facet[ 0 ] );
+            newFacets.push_back( { facet[ 0 ], midpoint01, midpoint20 } );
+            newFacets.push_back( { facet[ 1 ], midpoint12, midpoint01 } );
+            newFacets.push_back( { facet[ 2 ], midpoint20, midpoint12 } );
+            newFacets.push_back( { midpoint01, midpoint12, midpoint20 } );
+        }
+        facets = newFacets;
+    }
+
+    verticesCoordinates.resize( vertices.size( ), 3 );
+    for( unsigned int vertex = 0; vertex < vertices.size( ); vertex++ )
+    {
+        const double radiusScaling = 1.0 + 0.02 * static_cast< double >( std::rand( ) ) / RAND_MAX;
+        verticesCoordinates.row( vertex ) = radiusScaling * ( Eigen::Vector3d( ) <<
+                    1000.0 * vertices.at( vertex )( 0 ), 700.0 * vertices.at( vertex )( 1 ),
+                    500.0 * vertices.at( vertex )( 2 ) ).finished( ).transpose( );
+    }
+    verticesDefiningEachFacet.resize( facets.size( ), 3 );
+    for( unsigned int facet = 0; facet < facets.size( ); facet++ )
+    {
+        for( int i = 0; i < 3; i++ )
+        {
+            verticesDefiningEachFacet( facet, i ) = facets.at( facet )[ i ];
+        }
+    }
+}
+
+} // namespace benchmarks
+
+} // namespace tudat
+
+#endif // TUDAT_BENCHMARKPOLYHEDRONUTILITIES_H
@@ -0,0 +1,121 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the number of variable step-size Runge-Kutta integration steps per second, for a Keplerian orbit
+ *    (gravitational parameter of 1), using a 6-element state (fixed and dynamic size) and a 6 x ( 1 + 6 + p ) state
+ *    with variational equations (state transition matrix and p parameter sensitivity columns, as used in propagation
+ *    of variational equations). The state derivative function is cheap, so that the timing is dominated by the
+ *    integrator itself. Usage:
+ *
+ *      benchmark_RungeKuttaIntegrationStep [numberOfSteps] [numberOfParameters]
+ *
+ *    By default, 100000 steps and 3 parameters are used.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+using namespace tudat::numerical_integrators;
+
+//! Function to compute the state derivative of a Keplerian orbit, with variational equations in columns 1 onwards.
+template< typename StateType >
+StateType computeKeplerVariationalStateDerivative( const double time, const StateType& state )
+{
+    StateType stateDerivative( state.rows( ), state.cols( ) );
+
+    const Eigen::Vector3d position = state.template block< 3, 1 >( 0, 0 );
+    const double distance = position.norm( );
+    stateDerivative.template block< 3, 1 >( 0, 0 ) = state.template block< 3, 1 >( 3, 0 );
+    stateDerivative.template block< 3, 1 >( 3, 0 ) = -position / ( distance * distance * distance );
+
+    const int numberOfVariationalColumns = state.cols( ) - 1;
+    if( numberOfVariationalColumns > 0 )
+    {
+        const Eigen::Matrix3d gravityGradient =
+                ( 3.0 * position * position.transpose( ) / ( distance * distance ) - Eigen::Matrix3d::Identity( ) ) /
+                ( distance * distance * distance );
+        stateDerivative.block( 0, 1, 3, numberOfVariationalColumns ) = state.block( 3, 1, 3, numberOfVariationalColumns );
+        stateDerivative.block( 3, 1, 3, numberOfVariationalColumns ).noalias( ) =
+                gravityGradient * state.block( 0, 1, 3, numberOfVariationalColumns );
+    }
+    return stateDerivative;
+}
+
+//! Function to time a given number of integration steps, and print the number of steps per second.
+template< typename StateType >
+void printIntegrationStepsPerSecond( const std::string& stateName, const std::string& coefficientSetName,
+                                     const RungeKuttaCoefficients& coefficients, const int numberOfSteps,
+                                     const int numberOfColumns )
+{
+    StateType initialState = StateType::Zero( 6, numberOfColumns );
+    initialState( 0, 0 ) = 1.0;
+    initialState( 4, 0 ) = std::sqrt( 1.5 );
+    if( numberOfColumns > 1 )
+    {
+        initialState.block( 0, 1, 6, 6 ).setIdentity( );
+    }
+
+    StateType finalState;
+    double totalTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        RungeKuttaVariableStepSizeIntegrator< double, StateType, StateType > integrator(
+                    coefficients, &computeKeplerVariationalStateDerivative< StateType >, 0.0, initialState,
+                    std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ),
+                    1.0E-2, 1.0E-12, 1.0E-12 );
+        for( int i = 0; i < numberOfSteps; i++ )
+        {
+            integrator.performIntegrationStep( integrator.getNextStepSize( ) );
+        }
+        finalState = integrator.getCurrentState( );
+    } );
+
+    std::cout << std::setw( 12 ) << coefficientSetName << std::setw( 28 ) << stateName
+              << std::setw( 16 ) << static_cast< double >( numberOfSteps ) / totalTime
+              << std::setw( 16 ) << 1.0E9 * totalTime / static_cast< double >( numberOfSteps )
+              << std::setw( 16 ) << finalState( 0, 0 ) << std::endl;
+}
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfSteps = benchmarks::getIntegerArgument( argc, argv, 1, 100000 );
+    const int numberOfParameters = benchmarks::getIntegerArgument( argc, argv, 2, 3 );
+
+    std::vector< std::pair< std::string, CoefficientSets > > coefficientSets =
+    { { "RKF4(5)", rungeKuttaFehlberg45 }, { "RKF7(8)", rungeKuttaFehlberg78 }, { "RKDP8(7)", rungeKutta87DormandPrince } };
+
+    std::cout << "Runge-Kutta integration step benchmark: " << numberOfSteps << " steps, "
+              << numberOfParameters << " parameters in variational equations" << std::endl;
+    std::cout << std::setw( 12 ) << "integrator" << std::setw( 28 ) << "state"
+              << std::setw( 16 ) << "steps/s" << std::setw( 16 ) << "time/step [ns]"
+              << std::setw( 16 ) << "final x" << std::endl;
+
+    const std::string variationalStateName = "MatrixXd 6x" + std::to_string( 7 + numberOfParameters );
+    for( unsigned int i = 0; i < coefficientSets.size( ); i++ )
+    {
+        const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get( coefficientSets.at( i ).second );
+        printIntegrationStepsPerSecond< Eigen::Vector6d >(
+                    "Vector6d", coefficientSets.at( i ).first, coefficients, numberOfSteps, 1 );
+        printIntegrationStepsPerSecond< Eigen::VectorXd >(
+                    "VectorXd 6", coefficientSets.at( i ).first, coefficients, numberOfSteps, 1 );
+        printIntegrationStepsPerSecond< Eigen::MatrixXd >(
+                    variationalStateName, coefficientSets.at( i ).first, coefficients, numberOfSteps,
+                    7 + numberOfParameters );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the spherical harmonic gravity evaluation, comparing the term-by-term summation
+ *    (computeGeodesyNormalizedGravitationalAccelerationSum) to the vectorized SphericalHarmonicsGradientCalculator, at
+ *    degree and order 20, 100 and 360. Usage:
+ *
+ *      benchmark_SphericalHarmonicsGravity [numberOfEvaluations]
+ *
+ *    By default, 1000 evaluations (at different positions) are timed per degree.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/gravitation/sphericalHarmonicsGradientCalculator.h"
+#include "tudat/astro/gravitation/sphericalHarmonicsGravityField.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfEvaluations = benchmarks::getIntegerArgument( argc, argv, 1, 1000 );
+    const double gravitationalParameter = 3.986004418E14;
+    const double referenceRadius = 6378137.0;
+
+    // Create test positions in low Earth orbit
+    std::srand( 0 );
+    std::vector< Eigen::Vector3d > positions;
+    for( int i = 0; i < numberOfEvaluations; i++ )
+    {
+        Eigen::Vector3d direction = Eigen::Vector3d::Random( ).normalized( );
+        positions.push_back( ( referenceRadius + 500.0E3 ) * direction );
+    }
+
+    std::cout << "Spherical harmonic gravity benchmark: " << numberOfEvaluations << " evaluations per degree"
+              << std::endl;
+    std::cout << std::setw( 8 ) << "degree" << std::setw( 18 ) << "term-wise [us]" << std::setw( 18 )
+              << "vectorized [us]" << std::setw( 12 ) << "speedup" << std::setw( 18 ) << "max. rel. diff." << std::endl;
+
+    std::vector< int > degrees = { 20, 100, 360 };
+    for( unsigned int i = 0; i < degrees.size( ); i++ )
+    {
+        const int degree = degrees.at( i );
+
+        // Create coefficients with Kaula-like decay
+        Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Random( degree + 1, degree + 1 );
+        Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Random( degree + 1, degree + 1 );
+        for( int n = 0; n <= degree; n++ )
+        {
+            cosineCoefficients.row( n ) *= 1.0E-5 / static_cast< double >( ( n + 1 ) * ( n + 1 ) );
+            sineCoefficients.row( n ) *= 1.0E-5 / static_cast< double >( ( n + 1 ) * ( n + 1 ) );
+            sineCoefficients( n, 0 ) = 0.0;
+        }
+        cosineCoefficients( 0, 0 ) = 1.0;
+
+        std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache =
+                std::make_shared< basic_mathematics::SphericalHarmonicsCache >( degree + 2, degree + 2 );
+        std::map< std::pair< int, int >, Eigen::Vector3d > dummyAccelerationPerTerm;
+        gravitation::SphericalHarmonicsGradientCalculator gradientCalculator( cosineCoefficients, sineCoefficients );
+
+        std::vector< Eigen::Vector3d > termWiseAccelerations( numberOfEvaluations );
+        std::vector< Eigen::Vector3d > vectorizedAccelerations( numberOfEvaluations );
+
+        double termWiseTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                termWiseAccelerations[ j ] = gravitation::computeGeodesyNormalizedGravitationalAccelerationSum(
+                            positions[ j ], gravitationalParameter, referenceRadius, cosineCoefficients,
+                            sineCoefficients, sphericalHarmonicsCache, dummyAccelerationPerTerm );
+            }
+        } );
+
+        double vectorizedTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            for( int j = 0; j < numberOfEvaluations; j++ )
+            {
+                gradientCalculator.setCoefficients( cosineCoefficients, sineCoefficients );
+                vectorizedAccelerations[ j ] = gradientCalculator.computeGradient(
+                            positions[ j ], gravitationalParameter, referenceRadius );
+            }
+        } );
+
+        double maximumRelativeDifference = 0.0;
+        for( int j = 0; j < numberOfEvaluations; j++ )
+        {
+            maximumRelativeDifference = std::max(
+                        maximumRelativeDifference, ( vectorizedAccelerations[ j ] - termWiseAccelerations[ j ] ).norm( ) /
+                        termWiseAccelerations[ j ].norm( ) );
+        }
+
+        std::cout << std::setw( 8 ) << degree
+                  << std::setw( 18 ) << 1.0E6 * termWiseTime / static_cast< double >( numberOfEvaluations )
+                  << std::setw( 18 ) << 1.0E6 * vectorizedTime / static_cast< double >( numberOfEvaluations )
+                  << std::setw( 12 ) << termWiseTime / vectorizedTime
+                  << std::setw( 18 ) << maximumRelativeDifference << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the evaluation of a spherical harmonic gravity field on a latitude-longitude grid, comparing
+ *    position-by-position evaluation (SphericalHarmonicsGravityField::getGradientOfPotential) to the batched evaluation
+ *    (SphericalHarmonicsGravityField::getGradientsOfPotential), serial and multi-threaded. Usage:
+ *
+ *      benchmark_SphericalHarmonicsGrid [maximumDegree] [gridSpacingInDegrees] [maximumNumberOfThreads]
+ *
+ *    By default, a degree 100 field is evaluated on a 2 degree grid, using 1 up to all available hardware threads.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/gravitation/sphericalHarmonicsGravityField.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+
+int main( int argc, char* argv[ ] )
+{
+    const int maximumDegree = benchmarks::getIntegerArgument( argc, argv, 1, 100 );
+    const int gridSpacing = benchmarks::getIntegerArgument( argc, argv, 2, 2 );
+    const int maximumNumberOfThreads = benchmarks::getIntegerArgument(
+                argc, argv, 3, static_cast< int >( utilities::getNumberOfAvailableThreads( ) ) );
+
+    const double gravitationalParameter = 3.986004418E14;
+    const double referenceRadius = 6378137.0;
+
+    // Create coefficients with Kaula-like decay
+    std::srand( 0 );
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumDegree + 1 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumDegree + 1 );
+    for( int n = 0; n <= maximumDegree; n++ )
+    {
+        cosineCoefficients.row( n ) *= 1.0E-5 / static_cast< double >( ( n + 1 ) * ( n + 1 ) );
+        sineCoefficients.row( n ) *= 1.0E-5 / static_cast< double >( ( n + 1 ) * ( n + 1 ) );
+        sineCoefficients( n, 0 ) = 0.0;
+    }
+    cosineCoefficients( 0, 0 ) = 1.0;
+    gravitation::SphericalHarmonicsGravityField gravityField(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients );
+
+    // Create grid (cell centers) at 10 km altitude
+    const int numberOfLatitudes = 180 / gridSpacing;
+    const int numberOfLongitudes = 360 / gridSpacing;
+    const double degreeToRadian = mathematical_constants::PI / 180.0;
+    Eigen::MatrixXd gridPositions( numberOfLatitudes * numberOfLongitudes, 3 );
+    for( int i = 0; i < numberOfLatitudes; i++ )
+    {
+        double latitude = ( -90.0 + ( static_cast< double >( i ) + 0.5 ) * gridSpacing ) * degreeToRadian;
+        for( int j = 0; j < numberOfLongitudes; j++ )
+        {
+            double longitude = ( static_cast< double >( j ) + 0.5 ) * gridSpacing * degreeToRadian;
+            gridPositions.row( i * numberOfLongitudes + j ) =
+                    ( referenceRadius + 10.0E3 ) * Eigen::RowVector3d(
+                        std::cos( latitude ) * std::cos( longitude ), std::cos( latitude ) * std::sin( longitude ),
+                        std::sin( latitude ) );
+        }
+    }
+    const int numberOfPositions = gridPositions.rows( );
+
+    std::cout << "Spherical harmonic grid benchmark: degree " << maximumDegree << ", " << numberOfPositions
+              << " grid points" << std::endl;
+    std::cout << std::setw( 24 ) << "method" << std::setw( 14 ) << "time [s]" << std::setw( 16 ) << "points/s"
+              << std::setw( 12 ) << "speedup" << std::setw( 18 ) << "max. rel. diff." << std::endl;
+
+    // Position-by-position evaluation, as reference
+    Eigen::MatrixXd referenceGradients( numberOfPositions, 3 );
+    double referenceTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfPositions; i++ )
+        {
+            referenceGradients.row( i ) = gravityField.getGradientOfPotential(
+                        gridPositions.row( i ).transpose( ) ).transpose( );
+        }
+    }, 1 );
+    std::cout << std::setw( 24 ) << "single-point" << std::setw( 14 ) << referenceTime
+              << std::setw( 16 ) << static_cast< double >( numberOfPositions ) / referenceTime
+              << std::setw( 12 ) << 1.0 << std::setw( 18 ) << 0.0 << std::endl;
+
+    // Batched evaluation, for increasing number of threads
+    std::vector< int > numberOfThreadsList;
+    for( int numberOfThreads = 1; numberOfThreads < maximumNumberOfThreads; numberOfThreads *= 2 )
+    {
+        numberOfThreadsList.push_back( numberOfThreads );
+    }
+    numberOfThreadsList.push_back( maximumNumberOfThreads );
+
+    for( unsigned int i = 0; i < numberOfThreadsList.size( ); i++ )
+    {
+        const int numberOfThreads = numberOfThreadsList.at( i );
+        std::shared_ptr< utilities::ThreadPool > threadPool =
+                ( numberOfThreads > 1 ) ? std::make_shared< utilities::ThreadPool >( numberOfThreads ) : nullptr;
+
+        Eigen::MatrixXd batchedGradients;
+        double batchedTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+        {
+            batchedGradients = gravityField.getGradientsOfPotential( gridPositions, threadPool );
+        } );
+
+        double maximumRelativeDifference = 0.0;
+        for( int j = 0; j < numberOfPositions; j++ )
+        {
+            maximumRelativeDifference = std::max(
+                        maximumRelativeDifference, ( batchedGradients.row( j ) - referenceGradients.row( j ) ).norm( ) /
+                        referenceGradients.row( j ).norm( ) );
+        }
+
+        std::cout << std::setw( 16 ) << "batched, " << std::setw( 2 ) << numberOfThreads
+                  << ( numberOfThreads == 1 ? " thread " : " threads" )
+                  << std::setw( 14 ) << batchedTime
+                  << std::setw( 16 ) << static_cast< double >( numberOfPositions ) / batchedTime
+                  << std::setw( 12 ) << referenceTime / batchedTime
+                  << std::setw( 18 ) << maximumRelativeDifference << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the Taylor series integrator against the RKF7(8) integrator, for a solar-system-like N-body problem
+ *    (all bodies propagated w.r.t. the barycenter, mutual point-mass or EIH attraction), at a tolerance of 1E-15, over one
+ *    orbit of the innermost body. For each integrator, the number of steps, the wall clock time, and the cost in
+ *    equivalent state derivative evaluations (wall clock time divided by that of a single evaluation) are given, as well as
+ *    the difference in final position between the integrators. Usage:
+ *
+ *      benchmark_TaylorSeriesIntegrator [numberOfBodies]
+ *
+ *    By default, 6 bodies are used.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/propagators/nBodyTaylorSeriesExpressions.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+#include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "tudat/math/integrators/taylorSeriesIntegrator.h"
+
+#include "benchmarkUtilities.h"
+
+using namespace tudat;
+using namespace tudat::numerical_integrators;
+using namespace tudat::propagators;
+
+//! Function to run the benchmark for a given state derivative function and recorded expression.
+void printIntegratorComparison(
+        const std::string& dynamicsName,
+        const std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) >& stateDerivativeFunction,
+        const std::shared_ptr< TaylorSeriesExpression > expression,
+        const Eigen::VectorXd& initialState, const double finalTime )
+{
+    const double tolerance = 1.0E-15;
+    const int numberOfEvaluations = 1000;
+
+    // Time single state derivative evaluation
+    Eigen::VectorXd stateDerivative;
+    const double evaluationTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            stateDerivative = stateDerivativeFunction( static_cast< double >( i ), initialState );
+        }
+    } ) / static_cast< double >( numberOfEvaluations );
+
+    // Integrate with Taylor series integrator
+    int taylorSeriesSteps = 0;
+    Eigen::VectorXd taylorSeriesFinalState;
+    const double taylorSeriesTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        TaylorSeriesIntegratorXd integrator(
+                    stateDerivativeFunction, expression, 0.0, initialState, finalTime, 1.0, finalTime,
+                    tolerance, tolerance );
+        taylorSeriesSteps = 0;
+        while( integrator.getCurrentIndependentVariable( ) < finalTime )
+        {
+            integrator.performIntegrationStep( std::min( integrator.getNextStepSize( ),
+                                                         finalTime - integrator.getCurrentIndependentVariable( ) ) );
+            taylorSeriesSteps++;
+        }
+        taylorSeriesFinalState = integrator.getCurrentState( );
+    } );
+
+    // Integrate with RKF7(8) integrator
+    int rungeKuttaSteps = 0;
+    Eigen::VectorXd rungeKuttaFinalState;
+    const double rungeKuttaTime = benchmarks::getMinimumWallClockTime( [ & ]( )
+    {
+        RungeKuttaVariableStepSizeIntegratorXd integrator(
+                    RungeKuttaCoefficients::get( rungeKuttaFehlberg78 ), stateDerivativeFunction, 0.0, initialState,
+                    1.0, finalTime, finalTime / 1000.0, tolerance, tolerance );
+        rungeKuttaSteps = 0;
+        while( integrator.getCurrentIndependentVariable( ) < finalTime )
+        {
+            integrator.performIntegrationStep( std::min( integrator.getNextStepSize( ),
+                                                         finalTime - integrator.getCurrentIndependentVariable( ) ) );
+            rungeKuttaSteps++;
+        }
+        rungeKuttaFinalState = integrator.getCurrentState( );
+    } );
+
+    double maximumPositionDifference = 0.0;
+    for( int i = 0; i < initialState.rows( ) / 6; i++ )
+    {
+        maximumPositionDifference = std::max(
+                    maximumPositionDifference,
+                    ( taylorSeriesFinalState.segment( 6 * i, 3 ) - rungeKuttaFinalState.segment( 6 * i, 3 ) ).norm( ) );
+    }
+
+    std::cout << std::setw( 12 ) << dynamicsName << std::setw( 14 ) << "Taylor"
+              << std::setw( 10 ) << taylorSeriesSteps << std::setw( 16 ) << taylorSeriesTime
+              << std::setw( 16 ) << taylorSeriesTime / evaluationTime << std::setw( 16 ) << maximumPositionDifference
+              << std::endl;
+    std::cout << std::setw( 12 ) << dynamicsName << std::setw( 14 ) << "RKF7(8)"
+              << std::setw( 10 ) << rungeKuttaSteps << std::setw( 16 ) << rungeKuttaTime
+              << std::setw( 16 ) << rungeKuttaTime / evaluationTime << std::setw( 16 ) << "" << std::endl;
+}
+
+int main( int argc, char* argv[ ] )
+{
+    const int numberOfBodies = benchmarks::getIntegerArgument( argc, argv, 1, 6 );
+
+    // Define central body, and bodies on near-circular orbits around it, with barycentric initial states
+    std::vector< double > gravitationalParameters;
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 * numberOfBodies );
+    double totalGravitationalParameter = 0.0;
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        gravitationalParameters.push_back( ( i == 0 ) ? 1.32712440018E20 : 1.0E16 * static_cast< double >( i ) );
+        totalGravitationalParameter += gravitationalParameters.at( i );
+        if( i > 0 )
+        {
+            double radius = 5.0E10 * static_cast< double >( i );
+            double angle = 0.7 * static_cast< double >( i );
+            double velocity = std::sqrt( gravitationalParameters.at( 0 ) / radius );
+            initialState.segment( 6 * i, 6 ) << radius * std::cos( angle ), radius * std::sin( angle ),
+                    1.0E-2 * radius * std::sin( angle ), -velocity * std::sin( angle ), velocity * std::cos( angle ), 0.0;
+        }
+    }
+    Eigen::VectorXd barycentricState = Eigen::VectorXd::Zero( 6 );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        barycentricState += gravitationalParameters.at( i ) * initialState.segment( 6 * i, 6 ) / totalGravitationalParameter;
+    }
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        initialState.segment( 6 * i, 6 ) -= barycentricState;
+    }
+
+    // Propagate over one orbit of innermost body
+    const double finalTime = 2.0 * mathematical_constants::PI * std::sqrt(
+                std::pow( 5.0E10, 3.0 ) / gravitationalParameters.at( 0 ) );
+
+    std::cout << "Taylor series integrator benchmark: " << numberOfBodies << " bodies, tolerance 1E-15, "
+              << finalTime / 86400.0 << " days" << std::endl;
+    std::cout << std::setw( 12 ) << "dynamics" << std::setw( 14 ) << "integrator" << std::setw( 10 ) << "steps"
+              << std::setw( 16 ) << "time [s]" << std::setw( 16 ) << "equiv. evals"
+              << std::setw( 16 ) << "max dr [m]" << std::endl;
+
+    printIntegratorComparison(
+                "point-mass", [ & ]( const double, const Eigen::VectorXd& state )
+    {
+        std::vector< double > stateDerivative = computeNBodyPointMassStateDerivative(
+                    std::vector< double >( state.data( ), state.data( ) + state.rows( ) ), gravitationalParameters );
+        return Eigen::VectorXd( Eigen::Map< Eigen::VectorXd >( stateDerivative.data( ), stateDerivative.size( ) ) );
+    }, createNBodyPointMassTaylorSeriesExpression( gravitationalParameters ), initialState, finalTime );
+
+    printIntegratorComparison(
+                "EIH", [ & ]( const double, const Eigen::VectorXd& state )
+    {
+        std::vector< double > stateDerivative = computeNBodyEinsteinInfeldHoffmannStateDerivative(
+                    std::vector< double >( state.data( ), state.data( ) + state.rows( ) ), gravitationalParameters );
+        return Eigen::VectorXd( Eigen::Map< Eigen::VectorXd >( stateDerivative.data( ), stateDerivative.size( ) ) );
+    }, createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression( gravitationalParameters ), initialState, finalTime );
+
+    return EXIT_SUCCESS;
+}
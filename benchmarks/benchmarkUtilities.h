@@ -0,0 +1,58 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_BENCHMARKUTILITIES_H
+#define TUDAT_BENCHMARKUTILITIES_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <string>
+
+namespace tudat
+{
+
+namespace benchmarks
+{
+
+//! Function to determine the wall clock time of a piece of code, as the minimum over a number of repetitions.
+/*!
+ *  Function to determine the wall clock time of a piece of code, as the minimum over a number of repetitions (the minimum
+ *  being least sensitive to interference from other processes).
+ *  \param functionToTime Function that is to be timed.
+ *  \param numberOfRepetitions Number of times the function is to be executed.
+ *  \return Minimum wall clock time [s] of a single execution of the function.
+ */
+inline double getMinimumWallClockTime( const std::function< void( ) >& functionToTime,
+                                       const int numberOfRepetitions = 3 )
+{
+    double minimumTime = std::numeric_limits< double >::infinity( );
+    for( int i = 0; i < numberOfRepetitions; i++ )
+    {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+        functionToTime( );
+        std::chrono::duration< double > elapsedTime = std::chrono::steady_clock::now( ) - startTime;
+        minimumTime = std::min( minimumTime, elapsedTime.count( ) );
+    }
+    return minimumTime;
+}
+
+//! Function to retrieve an integer command line argument, or a default value if it is not provided.
+inline int getIntegerArgument( const int argc, char* argv[], const int argumentIndex, const int defaultValue )
+{
+    return ( argc > argumentIndex ) ? std::stoi( argv[ argumentIndex ] ) : defaultValue;
+}
+
+} // namespace benchmarks
+
+} // namespace tudat
+
+#endif // TUDAT_BENCHMARKUTILITIES_H
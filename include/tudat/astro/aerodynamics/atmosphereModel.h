@@ -12,8 +12,11 @@
 #ifndef TUDAT_ATMOSPHERE_MODEL_H
 #define TUDAT_ATMOSPHERE_MODEL_H
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 
+#include "tudat/basics/threadPool.h"
 #include "tudat/math/basic/mathematicalConstants.h"
 #include "tudat/astro/aerodynamics/windModel.h"
 
@@ -93,6 +96,30 @@ public:
     virtual double getDensity( const double altitude, const double longitude,
                                const double latitude, const double time ) = 0;
 
+    //! Get density at a list of points.
+    /*!
+    * Computes the density of the atmosphere in kg per meter^3 at a list of points, provided as contiguous arrays. The
+    * default implementation calls getDensity for each point in turn. Derived classes may override this function with a
+    * more efficient implementation, which may distribute the points over the threads of the thread pool (if any, see
+    * setNumberOfThreads). Note that this function need not modify the local atmospheric properties retrieved by the
+    * other get functions of the derived class.
+    * \param altitudes Altitudes of the points (array of size numberOfPoints).
+    * \param longitudes Longitudes of the points (array of size numberOfPoints).
+    * \param latitudes Latitudes of the points (array of size numberOfPoints).
+    * \param times Times of the points (array of size numberOfPoints).
+    * \param densities Atmospheric densities at the points (array of size numberOfPoints, returned by reference).
+    * \param numberOfPoints Number of points at which the density is to be computed.
+    */
+    virtual void getDensities( const double* altitudes, const double* longitudes,
+                               const double* latitudes, const double* times,
+                               double* densities, const int numberOfPoints )
+    {
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            densities[ i ] = getDensity( altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+        }
+    }
+
     //! Get local pressure.
     /*!
     * Returns the local pressure of the atmosphere parameter in Newton per meter^2.
@@ -175,11 +202,49 @@ public:
         windModel_ = windModel;
     }
 
+    // Set number of threads over which getDensities distributes the points, if supported by the model (sequential if 1)
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        threadPool_ = ( numberOfThreads > 1 ) ? std::make_shared< utilities::ThreadPool >( numberOfThreads ) : nullptr;
+    }
+
+    void setThreadPool( const std::shared_ptr< utilities::ThreadPool > threadPool )
+    {
+        threadPool_ = threadPool;
+    }
+
+    std::shared_ptr< utilities::ThreadPool > getThreadPool( )
+    {
+        return threadPool_;
+    }
+
 protected:
 
+    //! Function to process a list of points in blocks, distributed over the threads of the thread pool (if any).
+    /*!
+     * Function to process a list of points in blocks of contiguous points, distributed over the threads of the thread
+     * pool (if any), to be used by thread-safe implementations of getDensities.
+     * \param numberOfPoints Number of points that are to be processed.
+     * \param blockFunction Function processing a single block, with as input the index of the first point of the block,
+     * and the index one past its last point.
+     */
+    void processPointsInBlocks( const int numberOfPoints,
+                                const std::function< void( const int, const int ) >& blockFunction )
+    {
+        const int blockSize = 1024;
+        utilities::runTasks( threadPool_, ( numberOfPoints + blockSize - 1 ) / blockSize,
+                             [ & ]( const int blockIndex, const unsigned int )
+        {
+            blockFunction( blockIndex * blockSize, std::min( ( blockIndex + 1 ) * blockSize, numberOfPoints ) );
+        } );
+    }
+
     //! Model describing the wind velocity vector of the atmosphere
     std::shared_ptr< WindModel > windModel_;
 
+    //! Thread pool over which getDensities distributes the points (nullptr if sequential).
+    std::shared_ptr< utilities::ThreadPool > threadPool_;
+
 private:
 
 };
@@ -213,6 +278,24 @@ public:
     }
 
 
+    void getDensities( const double* altitudes, const double* longitudes,
+                       const double* latitudes, const double* times,
+                       double* densities, const int numberOfPoints )
+    {
+        baseAtmosphere_->getDensities( altitudes, longitudes, latitudes, times, densities, numberOfPoints );
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            if( isScalingAbsolute_ )
+            {
+                densities[ i ] += densityScalingFunction_( times[ i ] );
+            }
+            else
+            {
+                densities[ i ] *= densityScalingFunction_( times[ i ] );
+            }
+        }
+    }
+
     double getPressure( const double altitude, const double longitude,
                         const double latitude, const double time )
     {
@@ -148,6 +148,21 @@ public:
         return densityAtZeroAltitude_ * std::exp( -altitude / scaleHeight_ );
     }
 
+    //! Get density at a list of points.
+    /*!
+     * Computes the density of the atmosphere in kg per meter^3 at a list of points, distributed over the threads of the
+     * thread pool (if any).
+     * \param altitudes Altitudes of the points (array of size numberOfPoints).
+     * \param longitudes Longitudes of the points (not used but included for consistency with base class interface).
+     * \param latitudes Latitudes of the points (not used but included for consistency with base class interface).
+     * \param times Times of the points (not used but included for consistency with base class interface).
+     * \param densities Atmospheric densities at the points (array of size numberOfPoints, returned by reference).
+     * \param numberOfPoints Number of points at which the density is to be computed.
+     */
+    void getDensities( const double* altitudes, const double* longitudes,
+                       const double* latitudes, const double* times,
+                       double* densities, const int numberOfPoints );
+
     //! Get local pressure.
     /*!
      * Returns the local pressure of the atmosphere in Newton per meter^2.
@@ -11,10 +11,13 @@
 #ifndef TUDAT_NRLMSISE00_ATMOSPHERE_H
 #define TUDAT_NRLMSISE00_ATMOSPHERE_H
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <utility>
 #include <cmath>
 #include <algorithm>
+#include <unordered_map>
 
 #include <functional>
 #include <boost/functional/hash.hpp>
@@ -138,6 +141,10 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
         :nrlmsise00InputFunction_(nrlmsise00InputFunction)
     {
         resetHashKey( );
+        useDensityInterpolation_ = false;
+        isDensityGridCellSet_ = false;
+        numberOfDensityGridModelEvaluations_ = 0;
+        densityGridStepSizes_.fill( TUDAT_NAN );
         molarGasConstant_ = tudat::physical_constants::MOLAR_GAS_CONSTANT;
         specificHeatRatio_ = 1.4;
         GasComponentProperties gasProperties;
@@ -148,13 +155,18 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
     NRLMSISE00Atmosphere( const tudat::input_output::solar_activity::SolarActivityDataMap solarActivityData,
                           const bool useIdealGasLaw = true )
     {
-        nrlmsise00InputFunction_ = std::bind( &tudat::aerodynamics::nrlmsiseInputFunction,
+        solarActivityTable_ = std::make_shared< NRLMSISE00SolarActivityTable >( solarActivityData );
+        nrlmsise00InputFunction_ = std::bind( &tudat::aerodynamics::nrlmsiseInputFunctionFromTable,
                    std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4,
-                   solarActivityData, false, TUDAT_NAN );
+                   solarActivityTable_, false, TUDAT_NAN );
         solarActivityContainer_ = std::make_shared< input_output::solar_activity::SolarActivityContainer >(
                     solarActivityData );
 
         resetHashKey( );
+        useDensityInterpolation_ = false;
+        isDensityGridCellSet_ = false;
+        numberOfDensityGridModelEvaluations_ = 0;
+        densityGridStepSizes_.fill( TUDAT_NAN );
         molarGasConstant_ = tudat::physical_constants::MOLAR_GAS_CONSTANT;
         specificHeatRatio_ = 1.4;
         GasComponentProperties gasProperties;
@@ -176,13 +188,18 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
                          const GasComponentProperties gasProperties,
                          const bool useIdealGasLaw = true)
     {
-        nrlmsise00InputFunction_ = std::bind( &tudat::aerodynamics::nrlmsiseInputFunction,
+        solarActivityTable_ = std::make_shared< NRLMSISE00SolarActivityTable >( solarActivityData );
+        nrlmsise00InputFunction_ = std::bind( &tudat::aerodynamics::nrlmsiseInputFunctionFromTable,
                    std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4,
-                   solarActivityData, false, TUDAT_NAN );
+                   solarActivityTable_, false, TUDAT_NAN );
         solarActivityContainer_ = std::make_shared< input_output::solar_activity::SolarActivityContainer >(
                     solarActivityData );
 
         resetHashKey( );
+        useDensityInterpolation_ = false;
+        isDensityGridCellSet_ = false;
+        numberOfDensityGridModelEvaluations_ = 0;
+        densityGridStepSizes_.fill( TUDAT_NAN );
         molarGasConstant_ = tudat::physical_constants::MOLAR_GAS_CONSTANT;
         specificHeatRatio_ = specificHeatRatio;
         gasComponentProperties_ = gasProperties;
@@ -212,10 +229,32 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
     double getDensity( const double altitude, const double longitude,
                        const double latitude, const double time )
     {
+        if( useDensityInterpolation_ )
+        {
+            return computeInterpolatedDensity( altitude, longitude, latitude, time );
+        }
         computeProperties( altitude, longitude, latitude, time );
         return density_;
     }
 
+    //! Get density at a list of points.
+    /*!
+     * Computes the density of the atmosphere in kg per meter^3 at a list of points, without modifying the current
+     * atmospheric properties (retrieved by the other get functions). Only the density is computed for each point, and
+     * the model input is retrieved directly from the preprocessed solar activity data (if available). The points are
+     * evaluated sequentially, also if a thread pool is set, since the NRLMSISE00 library stores intermediate results in
+     * global variables.
+     * \param altitudes Altitudes of the points [m] (array of size numberOfPoints).
+     * \param longitudes Longitudes of the points [rad] (array of size numberOfPoints).
+     * \param latitudes Latitudes of the points [rad] (array of size numberOfPoints).
+     * \param times Times of the points (seconds since J2000) (array of size numberOfPoints).
+     * \param densities Atmospheric densities at the points [kg/m^3] (array of size numberOfPoints, returned by reference).
+     * \param numberOfPoints Number of points at which the density is to be computed.
+     */
+    void getDensities( const double* altitudes, const double* longitudes,
+                       const double* latitudes, const double* times,
+                       double* densities, const int numberOfPoints );
+
     //! Get local pressure.
     /*!
      * Returns the local pressure of the atmosphere in Newton per meter^2.
@@ -407,6 +446,54 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
         return solarActivityContainer_;
     }
 
+    //! Function to retrieve the preprocessed solar activity data (nullptr if model uses a custom input function).
+    std::shared_ptr< NRLMSISE00SolarActivityTable > getSolarActivityTable( )
+    {
+        return solarActivityTable_;
+    }
+
+    //! Function to set the density to be computed by interpolation on an adaptive local grid.
+    /*!
+     * Function to set the density (but no other atmospheric property) to be computed by interpolation on an adaptive
+     * local grid, instead of by evaluating the full model. The logarithm of the density is interpolated multi-linearly
+     * in altitude, local solar time (as an angle), latitude and time of the day, with the nodes of the grid computed
+     * (and stored) only for the grid cells in which the density is requested. When a grid cell is first used, its
+     * interpolation error is estimated from full model evaluations at its center, and at the midpoint of an edge along
+     * each dimension. If the error exceeds the relative tolerance, that cell (only) is bisected along the dimension with
+     * the largest error (repeatedly, if the error predicted from its quadratic scaling with step size still exceeds the
+     * tolerance), and the check is repeated for the resulting cell containing the requested point. The
+     * refinement of each cell is stored, so that each region of the grid retains its own resolution, and nodes are
+     * shared between cells at different refinement levels. The time step is always 86400 s divided by a power of 2, so
+     * that no grid cell straddles two days (between which the solar activity data are discontinuous). Requires the
+     * model to be created from solar activity data.
+     * \param relativeTolerance Relative tolerance of the interpolated density (NaN to use full model for density).
+     * \param initialAltitudeStep Initial altitude step size of the grid [m].
+     * \param initialAngularStep Initial longitude and latitude step size of the grid [rad].
+     * \param initialTimeStep Initial time step size of the grid [s] (rounded down to 86400 s divided by a power of 2).
+     */
+    void setDensityInterpolation( const double relativeTolerance,
+                                  const double initialAltitudeStep = 20.0E3,
+                                  const double initialAngularStep = 10.0 * mathematical_constants::PI / 180.0,
+                                  const double initialTimeStep = 5400.0 );
+
+    //! Function to retrieve the relative tolerance of the interpolated density (NaN if full model is used for density).
+    double getDensityInterpolationTolerance( )
+    {
+        return useDensityInterpolation_ ? densityInterpolationTolerance_ : TUDAT_NAN;
+    }
+
+    //! Function to retrieve the step sizes (altitude, longitude, latitude, time) of the unrefined density grid.
+    std::array< double, 4 > getDensityInterpolationStepSizes( )
+    {
+        return densityGridStepSizes_;
+    }
+
+    //! Function to retrieve the number of full model evaluations used to build and check the density grid.
+    int getNumberOfDensityInterpolationModelEvaluations( )
+    {
+        return numberOfDensityGridModelEvaluations_;
+    }
+
     //! Function to get  Input data to NRLMSISE00 atmosphere model
     /*!
      *  Function to get input data to NRLMSISE00 atmosphere model
@@ -576,11 +663,121 @@ class NRLMSISE00Atmosphere : public AtmosphereModel
     void computeProperties( const double altitude, const double longitude,
                             const double latitude, const double time );
 
+    //! Function to compute the density using the full model, without modifying the current atmospheric properties.
+    /*!
+     * Function to compute the density using the full model, without modifying the current atmospheric properties.
+     * \param inputData Input data to NRLMSISE00 atmosphere model (time- and longitude-dependent members must be set).
+     * \param altitude Altitude at which density is to be computed [m].
+     * \param longitude Longitude at which density is to be computed [rad].
+     * \param latitude Latitude at which density is to be computed [rad].
+     * \return Atmospheric density [kg/m^3].
+     */
+    double computeFullModelDensity( const NRLMSISE00Input& inputData, const double altitude,
+                                    const double longitude, const double latitude );
+
+    //! Function to compute the density by interpolation on the density grid (building the grid cell if required).
+    /*!
+     * Function to compute the density by interpolation on the density grid (building the grid cell if required).
+     * \param altitude Altitude at which density is to be computed [m].
+     * \param longitude Longitude at which density is to be computed [rad].
+     * \param latitude Latitude at which density is to be computed [rad].
+     * \param time Time at which density is to be computed (seconds since J2000).
+     * \return Atmospheric density [kg/m^3].
+     */
+    double computeInterpolatedDensity( const double altitude, const double longitude,
+                                       const double latitude, const double time );
+
+    //! Function to set the current grid cell, and the logarithm of the density at its nodes.
+    /*!
+     * Function to set the current grid cell, and the logarithm of the density at its nodes. The cell is found by
+     * descending from the cell of the unrefined grid through the stored refinements. A cell that is used for the first
+     * time is bisected (recursively) if it does not meet the interpolation tolerance.
+     * \param gridCoordinates Coordinates (altitude, longitude, latitude, second of the day) in the grid.
+     * \param dayNumber Number of the day (since the first day of the solar activity data).
+     */
+    void updateDensityGridCell( const std::array< double, 4 >& gridCoordinates, const int dayNumber );
+
+    //! Function to estimate the interpolation error in the current grid cell, from full model evaluations.
+    /*!
+     * Function to estimate the interpolation error in the current grid cell, from full model evaluations at the center
+     * of the cell, and at the midpoint of an edge along each dimension (with the edges not all meeting at one node).
+     * \param interpolationErrors Estimated interpolation error along each dimension (returned by reference).
+     * \return Estimated total interpolation error in the cell.
+     */
+    double estimateDensityGridCellError( std::array< double, 4 >& interpolationErrors );
+
+    //! Function to retrieve the logarithm of the density at a node of the grid, computing it if not yet available.
+    /*!
+     * Function to retrieve the logarithm of the density at a node of the grid, computing it if not yet available.
+     * \param nodeIndices Indices (altitude, longitude, latitude, time of the day) of the node, refinement levels in each
+     * of these dimensions, and day number.
+     * \return Logarithm of the density at the node.
+     */
+    double getDensityGridNodeValue( const std::array< int64_t, 9 >& nodeIndices );
+
+    //! Function to compute the logarithm of the density at given grid coordinates using the full model.
+    double computeDensityGridValue( const std::array< double, 4 >& gridCoordinates, const int dayNumber );
+
+    //! Hash function for indices of density grid nodes and cells.
+    struct DensityGridIndicesHash
+    {
+        size_t operator( )( const std::array< int64_t, 9 >& indices ) const
+        {
+            return boost::hash_range( indices.begin( ), indices.end( ) );
+        }
+    };
+
     //! Input data to NRLMSISE00 atmosphere model
     NRLMSISE00Input inputData_;
 
     std::shared_ptr< input_output::solar_activity::SolarActivityContainer > solarActivityContainer_;
 
+    //! Solar activity data, preprocessed to the daily input of the model (nullptr if custom input function is used).
+    std::shared_ptr< NRLMSISE00SolarActivityTable > solarActivityTable_;
+
+    //! Boolean denoting whether the density is computed by interpolation on the density grid.
+    bool useDensityInterpolation_;
+
+    //! Relative tolerance of the interpolated density.
+    double densityInterpolationTolerance_;
+
+    //! Step sizes (altitude, longitude, latitude, time) of the unrefined density grid.
+    std::array< double, 4 > densityGridStepSizes_;
+
+    //! Logarithm of the density at the nodes of the density grid that have been computed (see getDensityGridNodeValue).
+    std::unordered_map< std::array< int64_t, 9 >, double, DensityGridIndicesHash > densityGridNodeValues_;
+
+    //! Refinement of the density grid cells that have been checked.
+    /*!
+     *  Refinement of the density grid cells that have been checked (with key as for currentDensityGridCell_): the dimension
+     *  in which the cell is bisected, or -1 if the cell meets the interpolation tolerance.
+     */
+    std::unordered_map< std::array< int64_t, 9 >, int, DensityGridIndicesHash > densityGridCellRefinements_;
+
+    //! Indices of the current density grid cell.
+    /*!
+     *  Indices of the current density grid cell: index of lower node in each dimension, refinement level in each
+     *  dimension (with step size equal to that of the unrefined grid divided by 2 to the power of the level), and day
+     *  number. 64-bit integers are used, since the node indices at the deepest refinement levels exceed the range of a
+     *  32-bit integer (e.g. for the altitude above about 1300 km).
+     */
+    std::array< int64_t, 9 > currentDensityGridCell_;
+
+    //! Step sizes (altitude, longitude, latitude, time) of the current density grid cell.
+    std::array< double, 4 > currentDensityGridCellStepSizes_;
+
+    //! Logarithm of the density at the 16 nodes of the current density grid cell.
+    std::array< double, 16 > currentDensityGridCellValues_;
+
+    //! Boolean denoting whether currentDensityGridCell_ is set.
+    bool isDensityGridCellSet_;
+
+    //! Input data to NRLMSISE00 atmosphere model, used for computation of the density grid nodes.
+    NRLMSISE00Input densityGridInputData_;
+
+    //! Number of full model evaluations used to build and check the density grid.
+    int numberOfDensityGridModelEvaluations_;
+
     std::map< AtmosphericCompositionSpecies, int > speciesIndices =
         { { he_species, 0 },  { o_species, 1 }, { n2_species, 2 }, { o2_species, 3 }, { ar_species, 4 }, { h_species, 5 }, { n_species, 6 }, { anomalous_o_species, 7 } };
 
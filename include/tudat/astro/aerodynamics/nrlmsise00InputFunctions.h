@@ -11,6 +11,7 @@
 #ifndef TUDAT_NRLMSISE00_INPUT_FUNCTIONS_H
 #define TUDAT_NRLMSISE00_INPUT_FUNCTIONS_H
 
+#include <array>
 #include <vector>
 #include <cmath>
 
@@ -109,6 +110,132 @@ NRLMSISE00Input nrlmsiseInputFunction( const double altitude, const double longi
                                        const tudat::input_output::solar_activity::SolarActivityDataMap& solarActivityMap,
                                        const bool adjustSolarTime = false, const double localSolarTime = 0.0 );
 
+//! Solar activity data, preprocessed to the daily input of the NRLMSISE00 model.
+/*!
+ * Solar activity data, preprocessed to the daily input of the NRLMSISE00 model (F10.7 fluxes, daily and 3-hourly
+ * magnetic indices), and stored contiguously for each day between the first and last day of a SolarActivityDataMap.
+ * The input at a given time is retrieved in constant time, without map look-up or memory allocation, and is identical
+ * to that provided by nrlmsiseInputFunction (i.e. days missing from the data map use the data of the next available
+ * day, and days before the first day use the data of the first day).
+ */
+class NRLMSISE00SolarActivityTable
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, preprocesses the solar activity data.
+     * \param solarActivityMap SolarActivityData structure
+     */
+    NRLMSISE00SolarActivityTable(
+            const tudat::input_output::solar_activity::SolarActivityDataMap& solarActivityMap );
+
+    //! Function to retrieve the number of the day (since the first day of the data) in which a given time falls.
+    /*!
+     * Function to retrieve the number of the day (since the first day of the data) in which a given time falls. An
+     * exception is thrown if the time is beyond the last day of the data.
+     * \param time Time (seconds since J2000).
+     * \return Number of the day since the first day of the data (negative if before the first day).
+     */
+    int getDayNumber( const double time ) const;
+
+    //! Function to retrieve the number of seconds into the day for a given time.
+    /*!
+     * Function to retrieve the number of seconds into the day for a given time.
+     * \param time Time (seconds since J2000).
+     * \param dayNumber Number of the day in which time falls, as returned by getDayNumber.
+     * \return Number of seconds into the day.
+     */
+    double getSecondOfTheDay( const double time, const int dayNumber ) const;
+
+    //! Function to update the NRLMSISE00 input to a given day, second of the day and longitude.
+    /*!
+     * Function to update the NRLMSISE00 input to a given day, second of the day and longitude. Only the time- and
+     * longitude-dependent members of the input are modified.
+     * \param nrlmsiseInputData Input data that is to be updated.
+     * \param dayNumber Number of the day (since the first day of the data).
+     * \param secondOfTheDay Number of seconds into the day.
+     * \param longitude Longitude at which output is to be computed [rad].
+     * \param adjustSolarTime Boolean denoting whether the computed local solar time should be overidden with
+     * localSolarTime input.
+     * \param localSolarTime Local solar time that is used when adjustSolarTime is set to true.
+     */
+    void updateInput( NRLMSISE00Input& nrlmsiseInputData,
+                      const int dayNumber, const double secondOfTheDay, const double longitude,
+                      const bool adjustSolarTime = false, const double localSolarTime = 0.0 ) const;
+
+    //! Function to update the NRLMSISE00 input to a given time and longitude.
+    /*!
+     * Function to update the NRLMSISE00 input to a given time and longitude, with results identical to those of
+     * nrlmsiseInputFunction.
+     * \param nrlmsiseInputData Input data that is to be updated.
+     * \param time Time at which output is to be computed (seconds since J2000).
+     * \param longitude Longitude at which output is to be computed [rad].
+     * \param adjustSolarTime Boolean denoting whether the computed local solar time should be overidden with
+     * localSolarTime input.
+     * \param localSolarTime Local solar time that is used when adjustSolarTime is set to true.
+     */
+    void updateInput( NRLMSISE00Input& nrlmsiseInputData, const double time, const double longitude,
+                      const bool adjustSolarTime = false, const double localSolarTime = 0.0 ) const
+    {
+        const int dayNumber = getDayNumber( time );
+        updateInput( nrlmsiseInputData, dayNumber, getSecondOfTheDay( time, dayNumber ), longitude,
+                     adjustSolarTime, localSolarTime );
+    }
+
+private:
+
+    //! Daily NRLMSISE00 input.
+    struct DailyInput
+    {
+        //! Year of the solar activity data.
+        int year;
+
+        //! Julian day on the first of January of the year of the solar activity data.
+        double julianDayOnFirstOfJanuary;
+
+        //! Daily F10.7 flux
+        double f107;
+
+        //! 81 day average of F10.7 flux
+        double f107a;
+
+        //! Daily magnetic index
+        double apDaily;
+
+        //! Number of entries in the magnetic index data vector
+        int numberOfApEntries;
+
+        //! Magnetic index data vector
+        std::array< double, 8 > apVector;
+    };
+
+    //! Julian day of the first day of the data.
+    double firstJulianDay_;
+
+    //! Daily input for each day from the first to the last day of the data.
+    std::vector< DailyInput > dailyInputs_;
+};
+
+//! NRLMSISE00 Input function, using preprocessed solar activity data.
+/*!
+ * This function is used to define the input for the NRLMSISE model, from solar activity data preprocessed into a
+ * NRLMSISE00SolarActivityTable. The results are identical to those of nrlmsiseInputFunction.
+ * \param altitude Altitude at which output is to be computed [m].
+ * \param longitude Longitude at which output is to be computed [rad].
+ * \param latitude Latitude at which output is to be computed [rad].
+ * \param time Time at which output is to be computed (seconds since J2000).
+ * \param solarActivityTable Preprocessed solar activity data
+ * \param adjustSolarTime Boolean denoting whether the computed local solar time should be overidden with localSolarTime
+ * input.
+ * \param localSolarTime Local solar time that is used when adjustSolarTime is set to true.
+ * \return NRLMSISE00Input nrlmsiseInputFunction
+ */
+NRLMSISE00Input nrlmsiseInputFunctionFromTable( const double altitude, const double longitude,
+                                                const double latitude, const double time,
+                                                const std::shared_ptr< NRLMSISE00SolarActivityTable > solarActivityTable,
+                                                const bool adjustSolarTime = false, const double localSolarTime = 0.0 );
+
 }  // namespace aerodynamics
 }  // namespace tudat
 
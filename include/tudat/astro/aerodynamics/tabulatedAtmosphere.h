@@ -17,6 +17,7 @@
 #ifndef TUDAT_TABULATED_ATMOSPHERE_H
 #define TUDAT_TABULATED_ATMOSPHERE_H
 
+#include <array>
 #include <string>
 
 #include <memory>
@@ -243,6 +244,23 @@ public:
         return interpolatorForDensity_->interpolate( independentVariableData_ );
     }
 
+    //! Get density at a list of points.
+    /*!
+     *  Computes the density of the atmosphere in kg per meter^3 at a list of points, distributed over the threads of the
+     *  thread pool (if any). The interpolation is performed directly on a contiguous copy of the density table, using
+     *  the interval found for the previous point as initial guess for the current point. Points outside the range of
+     *  the table are passed to the density interpolator, so that the boundary handling is identical to getDensity.
+     *  \param altitudes Altitudes of the points (array of size numberOfPoints).
+     *  \param longitudes Longitudes of the points (array of size numberOfPoints).
+     *  \param latitudes Latitudes of the points (array of size numberOfPoints).
+     *  \param times Times of the points (array of size numberOfPoints).
+     *  \param densities Atmospheric densities at the points (array of size numberOfPoints, returned by reference).
+     *  \param numberOfPoints Number of points at which the density is to be computed.
+     */
+    void getDensities( const double* altitudes, const double* longitudes,
+                       const double* latitudes, const double* times,
+                       double* densities, const int numberOfPoints );
+
     //! Get local pressure.
     /*!
      *  Returns the local pressure of the atmosphere in Newton per meter^2, at the specified conditions.
@@ -488,6 +506,17 @@ private:
     template< unsigned int NumberOfIndependentVariables >
     void createMultiDimensionalAtmosphereInterpolators( );
 
+    //! Function to compute the density at a block of points, from the contiguous copy of the density table.
+    /*!
+     *  Function to compute the density at a block of points, from the contiguous copy of the density table.
+     *  \param independentVariableInputs Pointers to arrays of values of the independent variables of the table.
+     *  \param densities Atmospheric densities at the points (returned by reference).
+     *  \param firstPoint Index of first point of block.
+     *  \param endPoint Index one past the last point of block.
+     */
+    void computeTabulatedDensities( const std::array< const double*, 4 >& independentVariableInputs,
+                                    double* densities, const int firstPoint, const int endPoint );
+
     //! The file name of the atmosphere table.
     /*!
      *  The file name of the atmosphere table. The file should contain four columns of data,
@@ -559,6 +588,15 @@ private:
 
     std::vector< double > independentVariableData_;
 
+    //! Values of density table, stored contiguously (in storage order of table), used by getDensities.
+    std::vector< double > densityTableValues_;
+
+    //! Strides of density table values for each independent variable, used by getDensities.
+    std::array< int, 4 > densityTableStrides_;
+
+    //! Second derivatives of density spline at table nodes (only for single independent variable), used by getDensities.
+    std::vector< double > densityTableSecondDerivatives_;
+
 };
 
 //! Typedef for shared-pointer to TabulatedAtmosphere object.
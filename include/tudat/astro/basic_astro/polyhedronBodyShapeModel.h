@@ -20,6 +20,7 @@
 #include "tudat/astro/basic_astro/bodyShapeModel.h"
 #include "tudat/astro/basic_astro/polyhedronFuntions.h"
 #include "tudat/math/basic/polyhedron.h"
+#include "tudat/math/basic/polyhedronFacetTree.h"
 #include <iostream>
 
 namespace tudat
@@ -118,6 +119,34 @@ public:
         return justComputeDistanceToVertices_;
     }
 
+    /*! Function to set the computation of the altitude using a bounding volume hierarchy of the facets.
+     *
+     * Function to set the computation of the altitude using a bounding volume hierarchy of the facets (see
+     * PolyhedronFacetTree), with which the closest vertex, edge or facet is found by a nearest-feature search that is
+     * logarithmic in the number of facets. The altitude sign is then determined from the pseudo-normal of the closest
+     * feature, instead of from the sum of the solid angles of all facets.
+     * @param facetTree Bounding volume hierarchy of the facets of the polyhedron (if nullptr, a new one is created from
+     * the vertices and facets of the shape model).
+     */
+    void setFacetTree( const std::shared_ptr< basic_mathematics::PolyhedronFacetTree > facetTree = nullptr )
+    {
+        if( facetTree == nullptr )
+        {
+            facetTree_ = std::make_shared< basic_mathematics::PolyhedronFacetTree >(
+                        verticesCoordinates_, verticesDefiningEachFacet_ );
+        }
+        else
+        {
+            facetTree_ = facetTree;
+        }
+    }
+
+    // Function to return the bounding volume hierarchy of the facets (nullptr if not used).
+    std::shared_ptr< basic_mathematics::PolyhedronFacetTree > getFacetTree( )
+    {
+        return facetTree_;
+    }
+
 private:
 
     /*! Computes the distance to the vertex closest to the field point.
@@ -183,6 +212,9 @@ private:
     // Average radius of the polyhedron
     double averageRadius_;
 
+    // Bounding volume hierarchy of the facets, used to compute the altitude (nullptr if not used).
+    std::shared_ptr< basic_mathematics::PolyhedronFacetTree > facetTree_;
+
 };
 
 } // namespace basic_astrodynamics
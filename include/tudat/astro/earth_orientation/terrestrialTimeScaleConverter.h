@@ -13,6 +13,7 @@
 #define TUDAT_TERRESTRIALTIMESCALECONVERTER_H
 
 #include <functional>
+#include <mutex>
 
 #include "tudat/math/interpolators/createInterpolator.h"
 #include "tudat/basics/timeType.h"
@@ -163,6 +164,9 @@ public:
         }
         else
         {
+            // Lock cached times, so that they are not modified by another thread between update and retrieval
+            std::lock_guard< std::mutex > currentTimesLock( currentTimesMutex_ );
+
             // Check if update is required
             if( !( static_cast< TimeType >( getCurrentTimeList< TimeType >( ).getTimeValue( inputScale ) ) ==
                    static_cast< TimeType >( inputTimeValue ) ) ||
@@ -248,6 +252,7 @@ public:
     template< typename TimeType >
     void resetTimes( )
     {
+        std::lock_guard< std::mutex > currentTimesLock( currentTimesMutex_ );
         CurrentTimes< TimeType >& timesToUpdate = getCurrentTimeList< TimeType >( );
         timesToUpdate.tai = TUDAT_NAN;
         timesToUpdate.tt = TUDAT_NAN;
@@ -258,7 +263,8 @@ public:
 
     //! Function to recalculate time-values at all time scales from given unput values.
     /*!
-     * Function to recalculate time-values at all time scales from given unput values.
+     * Function to recalculate time-values at all time scales from given unput values. Unlike getCurrentTime, this
+     * function does not lock the cached times, and should not be called concurrently from several threads.
      *  \param inputScale Time scale of inputTimeValue.
      *  \param inputTimeValue Time value from which there is to be converted.
      *  \param earthFixedPosition Earth-fixed position at which time conversions are to be evaluated
@@ -466,6 +472,9 @@ private:
     //! Value of ground station position used on last call to updateTimes< Time > function
     Eigen::Vector3d previousEarthFixedPositionSplit_;
 
+    //! Mutex protecting the current times and previous ground station positions, which are shared between threads
+    std::mutex currentTimesMutex_;
+
     std::map< std::tuple< double, double, double >, std::shared_ptr< interpolators::OneDimensionalInterpolator< double, double > > > tdbToTtInterpolators_;
 };
 
@@ -51,6 +51,12 @@ public:
         return targetModel_;
     }
 
+    //! Function to retrieve the index of the source in the target model, by which the forcing of the source is stored
+    int getSourceIndex( ) const
+    {
+        return sourceIndex_;
+    }
+
     std::shared_ptr<OccultationModel> getSourceToTargetOccultationModel() const
     {
         return sourceToTargetOccultationModel_;
@@ -145,7 +151,8 @@ protected:
             isScalingModelSet_( false ),
             sourceDirectionScaling_( 1.0 ),
             perpendicularSourceDirectionScaling_( 1.0 ),
-            sourceName_( sourceName )
+            sourceName_( sourceName ),
+            sourceIndex_( targetModel->getSourceIndex( sourceName ) )
             {}
 
     virtual void computeAcceleration( ) = 0;
@@ -191,6 +198,9 @@ protected:
 
     std::string sourceName_;
 
+    //! Index of the source in the target model (resolved upon creation, to avoid name look-ups during evaluation)
+    int sourceIndex_;
+
 };
 
 /*!
@@ -404,6 +414,11 @@ private:
 
     std::vector< Eigen::Vector7d > savedPanelGeometries_;
 
+    // Irradiances and source-to-target directions (in target frame) of visible and emitting source panels
+    std::vector< double > visibleSourcePanelIrradiances_;
+
+    std::vector< Eigen::Vector3d > visibleSourcePanelDirectionsInTargetFrame_;
+
 
 };
 
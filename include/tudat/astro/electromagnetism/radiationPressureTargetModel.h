@@ -58,10 +58,60 @@ public:
      *
      * @param sourceIrradiance Incident irradiance magnitude [W/m²]
      * @param sourceToTargetDirectionLocalFrame Direction of incoming radiation
-     * @return Radiation pressure force vector in local (i.e. target-fixed) coordinates [N]
+     * @param resetForces Boolean denoting whether the current force of the source is to be reset
+     * @param sourceIndex Index of the source, as retrieved from getSourceIndex
      */
     virtual void updateRadiationPressureForcing(
-            const double sourceIrradiance, const Eigen::Vector3d& sourceToTargetDirection, const bool resetForces, const std::string sourceName = "" ) = 0;
+            const double sourceIrradiance, const Eigen::Vector3d& sourceToTargetDirection, const bool resetForces,
+            const int sourceIndex ) = 0;
+
+    /*!
+     * Add radiation pressure force (and torque) from a list of source panels (e.g. of a paneled source) to the current
+     * force of the given source, without resetting it. By default, updateRadiationPressureForcing is called for each
+     * source panel; derived classes may override this with a more efficient evaluation.
+     *
+     * @param sourceIrradiances Incident irradiance magnitude per source panel [W/m²]
+     * @param sourceToTargetDirections Direction of incoming radiation per source panel
+     * @param sourceIndex Index of the source, as retrieved from getSourceIndex
+     */
+    virtual void updateRadiationPressureForcingFromSourcePanels(
+            const std::vector< double >& sourceIrradiances,
+            const std::vector< Eigen::Vector3d >& sourceToTargetDirections,
+            const int sourceIndex )
+    {
+        for( unsigned int i = 0; i < sourceIrradiances.size( ); i++ )
+        {
+            updateRadiationPressureForcing( sourceIrradiances.at( i ), sourceToTargetDirections.at( i ), false, sourceIndex );
+        }
+    }
+
+    /*!
+     * Retrieve the index of a source, by which its forcing is stored and evaluated, adding the source if it is not yet
+     * saved. The index is to be retrieved once (e.g. when creating the acceleration model), and then used for all
+     * evaluations.
+     *
+     * @param sourceName Name of the source
+     * @return Index of the source
+     */
+    int getSourceIndex( const std::string& sourceName );
+
+    /*!
+     * Retrieve the index of a source, by which its forcing is stored and evaluated.
+     *
+     * @param sourceName Name of the source
+     * @return Index of the source (-1 if the source is not saved)
+     */
+    int getSavedSourceIndex( const std::string& sourceName ) const
+    {
+        for( unsigned int i = 0; i < sourceNames_.size( ); i++ )
+        {
+            if( sourceNames_.at( i ) == sourceName )
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
 
 
     std::map<std::string, std::vector<std::string>> getSourceToTargetOccultingBodies() const
@@ -72,53 +122,81 @@ public:
     virtual bool forceFunctionRequiresLocalFrameInputs( ) = 0;
 
 
-    Eigen::Vector3d getCurrentRadiationPressureForce( const std::string& sourceName = "" )
+    const Eigen::Vector3d& getCurrentRadiationPressureForce( const int sourceIndex ) const
+    {
+        return currentRadiationPressureForce_.at( sourceIndex );
+    }
+
+    const Eigen::Vector3d& getCurrentRadiationPressureTorque( const int sourceIndex ) const
+    {
+        return currentRadiationPressureTorque_.at( sourceIndex );
+    }
+
+    Eigen::Vector3d getCurrentRadiationPressureForce( const std::string& sourceName = "" ) const
     {
-        return currentRadiationPressureForce_.at( sourceName );
+        return currentRadiationPressureForce_.at( getExistingSourceIndex( sourceName ) );
     }
 
-    Eigen::Vector3d getCurrentRadiationPressureTorque( const std::string& sourceName = "" )
+    Eigen::Vector3d getCurrentRadiationPressureTorque( const std::string& sourceName = "" ) const
     {
-        return currentRadiationPressureTorque_.at( sourceName );
+        return currentRadiationPressureTorque_.at( getExistingSourceIndex( sourceName ) );
     }
 
     Eigen::Vector3d updateAndGetRadiationPressureForce(
         const double sourceIrradiance, const Eigen::Vector3d& sourceToTargetDirection, const bool resetForces, const std::string sourceName = "" )
     {
-        updateRadiationPressureForcing( sourceIrradiance, sourceToTargetDirection, resetForces, sourceName );
-        return currentRadiationPressureForce_.at( sourceName );
+        const int sourceIndex = getSourceIndex( sourceName );
+        updateRadiationPressureForcing( sourceIrradiance, sourceToTargetDirection, resetForces, sourceIndex );
+        return currentRadiationPressureForce_.at( sourceIndex );
     }
 
     Eigen::Vector3d updateAndGetRadiationPressureTorque(
         const double sourceIrradiance, const Eigen::Vector3d& sourceToTargetDirection, const bool resetForces, const std::string sourceName = "" )
     {
-        updateRadiationPressureForcing( sourceIrradiance, sourceToTargetDirection, resetForces, sourceName );
-        return currentRadiationPressureTorque_.at( sourceName );
+        const int sourceIndex = getSourceIndex( sourceName );
+        updateRadiationPressureForcing( sourceIrradiance, sourceToTargetDirection, resetForces, sourceIndex );
+        return currentRadiationPressureTorque_.at( sourceIndex );
     }
 
-    virtual void resetDerivedComputations( const std::string sourceName ){ }
+    virtual void resetDerivedComputations( const int sourceIndex ){ }
 
-    void resetComputations( const std::string& sourceName )
+    void resetComputations( const int sourceIndex )
     {
-        currentRadiationPressureForce_[ sourceName ] = Eigen::Vector3d::Zero( );
-        currentRadiationPressureTorque_[ sourceName ] = Eigen::Vector3d::Zero( );
+        currentRadiationPressureForce_[ sourceIndex ].setZero( );
+        currentRadiationPressureTorque_[ sourceIndex ].setZero( );
 
-        resetDerivedComputations( sourceName );
+        resetDerivedComputations( sourceIndex );
     }
 
-    virtual void saveLocalComputations( const std::string sourceName, const bool saveCosines ){ }
+    virtual void saveLocalComputations( const int sourceIndex, const bool saveCosines ){ }
 
 protected:
     virtual void updateMembers_(const double currentTime) {};
 
+    //! Function to add the source-specific variables of derived classes for a newly saved source
+    virtual void addSourceVariables( ){ }
+
+    //! Function to retrieve the index of a source, throwing an exception if the source is not saved
+    int getExistingSourceIndex( const std::string& sourceName ) const
+    {
+        const int sourceIndex = getSavedSourceIndex( sourceName );
+        if( sourceIndex < 0 )
+        {
+            throw std::runtime_error( "Error when getting radiation pressure forcing due to source " + sourceName +
+                                      ", no such source is saved" );
+        }
+        return sourceIndex;
+    }
+
     double currentTime_{TUDAT_NAN};
     // Only needed to transfer occultation settings from body setup to acceleration setup
     std::map<std::string, std::vector<std::string>> sourceToTargetOccultingBodies_;
 
 
-    // Source-specific variables
-    std::map< std::string, Eigen::Vector3d > currentRadiationPressureForce_;
-    std::map< std::string, Eigen::Vector3d > currentRadiationPressureTorque_;
+    // Source-specific variables, with index of source given by its position in sourceNames_
+    std::vector< std::string > sourceNames_;
+    std::vector< Eigen::Vector3d > currentRadiationPressureForce_;
+    std::vector< Eigen::Vector3d > currentRadiationPressureTorque_;
     bool computeTorques_;
 
     std::function< Eigen::Vector3d( ) > centerOfMassFunction_;
@@ -179,7 +257,7 @@ public:
             double sourceIrradiance,
             const Eigen::Vector3d& sourceToTargetDirection,
             const bool resetForces,
-            const std::string sourceName = ""  ) override;
+            const int sourceIndex ) override;
 
 
     double getArea() const
@@ -231,6 +309,12 @@ private:
 
 /*!
  * Class modeling a target as collection of panels, e.g., representing the box body and solar panels.
+ *
+ * For the force computation, the panel properties are stored as structure-of-arrays: the surface normals (one column
+ * per component), areas and optical coefficients of all panels are stored in contiguous arrays, so that the forces on
+ * all panels (due to any number of source panels) are evaluated in a single vectorizable pass. The optical coefficients
+ * are retrieved from the panel reflection laws upon construction and whenever the model is updated to a new time.
+ * Panels with a reflection law other than SpecularDiffuseMixReflectionLaw are evaluated using their reflection law.
  */
 class PaneledRadiationPressureTargetModel : public RadiationPressureTargetModel
 {
@@ -258,16 +342,25 @@ public:
         totalNumberOfPanels_ = bodyFixedPanels_.size( );
         fullPanels_ = bodyFixedPanels_;
 
-        int counter = 1;
         for( auto it : segmentFixedPanels_ )
         {
             totalNumberOfPanels_ += it.second.size( );
             fullPanels_.insert( fullPanels_.end( ), it.second.begin( ), it.second.end( ) );
         }
 
-        panelForces_.resize( totalNumberOfPanels_ );
-        surfacePanelCosines_.resize( totalNumberOfPanels_ );
-        surfaceNormals_.resize( totalNumberOfPanels_ );
+        surfaceNormals_.setZero( totalNumberOfPanels_, 3 );
+        surfacePanelCosines_.setZero( totalNumberOfPanels_ );
+        panelAreas_.resize( totalNumberOfPanels_ );
+        incidenceReactionCoefficients_.resize( totalNumberOfPanels_ );
+        diffuseReactionCoefficients_.resize( totalNumberOfPanels_ );
+        specularReactionCoefficients_.resize( totalNumberOfPanels_ );
+        weightedCosines_.resize( totalNumberOfPanels_ );
+        weightedCosineSums_.resize( totalNumberOfPanels_ );
+        weightedSquaredCosineSums_.resize( totalNumberOfPanels_ );
+        weightedDirectionSums_.resize( totalNumberOfPanels_, 3 );
+        currentPanelForces_.resize( totalNumberOfPanels_, 3 );
+
+        updatePanelProperties( );
     }
 
     void enableTorqueComputation(
@@ -285,16 +378,24 @@ public:
 
         computeTorques_ = true;
         centerOfMassFunction_ = centerOfMassFunction;
-        panelTorques_.resize( totalNumberOfPanels_ );
-        panelCentroidMomentArms_.resize( totalNumberOfPanels_ );
+        panelCentroidMomentArms_.setZero( totalNumberOfPanels_, 3 );
+        currentPanelTorques_.resize( totalNumberOfPanels_, 3 );
+        for( unsigned int i = 0; i < panelTorquesPerSource_.size( ); i++ )
+        {
+            panelTorquesPerSource_.at( i ).setZero( totalNumberOfPanels_, 3 );
+        }
     }
 
     void updateRadiationPressureForcing(
         double sourceIrradiance,
         const Eigen::Vector3d &sourceToTargetDirectionLocalFrame,
         const bool resetForces,
-        const std::string sourceName = ""  ) override;
+        const int sourceIndex ) override;
 
+    void updateRadiationPressureForcingFromSourcePanels(
+        const std::vector< double >& sourceIrradiances,
+        const std::vector< Eigen::Vector3d >& sourceToTargetDirectionsLocalFrame,
+        const int sourceIndex ) override;
 
     std::vector< std::shared_ptr< system_models::VehicleExteriorPanel > >& getBodyFixedPanels( )
     {
@@ -311,27 +412,46 @@ public:
         return true;
     }
 
-    std::vector< Eigen::Vector3d >& getSurfaceNormals(  )
+    //! Function to retrieve the current surface normals (one row per panel) in the body-fixed frame
+    const Eigen::Matrix< double, Eigen::Dynamic, 3 >& getSurfaceNormals(  )
     {
         return surfaceNormals_;
     }
 
-    std::vector< double >& getSurfacePanelCosines( const std::string& sourceName )
+    const Eigen::VectorXd& getSurfacePanelCosines( const int sourceIndex )
     {
-        if( surfacePanelCosinesPerSource_.count( sourceName ) == 0 )
+        if( surfacePanelCosinesPerSource_.at( sourceIndex ).size( ) == 0 )
+        {
+            throw std::runtime_error( "Error wen getting panelled radiation pressure target surface cosines from body " + sourceNames_.at( sourceIndex ) + ", no cosines are saved" );
+        }
+        return surfacePanelCosinesPerSource_.at( sourceIndex );
+    }
+
+    const Eigen::VectorXd& getSurfacePanelCosines( const std::string& sourceName )
+    {
+        const int sourceIndex = getSavedSourceIndex( sourceName );
+        if( sourceIndex < 0 )
         {
             throw std::runtime_error( "Error wen getting panelled radiation pressure target surface cosines from body " + sourceName + ", no such source is saved" );
         }
-        return surfacePanelCosinesPerSource_[ sourceName ];
+        return getSurfacePanelCosines( sourceIndex );
     }
 
-    std::vector< Eigen::Vector3d >& getPanelForces( const std::string& sourceName )
+    //! Function to retrieve the current panel forces (one row per panel) due to the given source
+    const Eigen::Matrix< double, Eigen::Dynamic, 3 >& getPanelForces( const int sourceIndex )
     {
-        if( panelForcesPerSource_.count( sourceName ) == 0 )
+        return panelForcesPerSource_.at( sourceIndex );
+    }
+
+    //! Function to retrieve the current panel forces (one row per panel) due to the given source
+    const Eigen::Matrix< double, Eigen::Dynamic, 3 >& getPanelForces( const std::string& sourceName )
+    {
+        const int sourceIndex = getSavedSourceIndex( sourceName );
+        if( sourceIndex < 0 )
         {
             throw std::runtime_error( "Error wen getting panelled radiation pressure panel force from body " + sourceName + ", no such source is saved" );
         }
-        return panelForcesPerSource_[ sourceName ];
+        return panelForcesPerSource_.at( sourceIndex );
     }
 
     std::vector< std::shared_ptr< system_models::VehicleExteriorPanel > >& getFullPanels( )
@@ -345,26 +465,27 @@ public:
         return totalNumberOfPanels_;
     }
 
-    void saveLocalComputations( const std::string sourceName, const bool saveCosines ) override ;
+    void saveLocalComputations( const int sourceIndex, const bool saveCosines ) override ;
 
 private:
     void updateMembers_( double currentTime ) override;
 
-    void resetDerivedComputations( const std::string sourceName ) override
-    {
-        for( unsigned int i = 0; i < panelForces_.size( ); i++ )
-        {
-            panelForces_.at( i ).setZero( );
-        }
-        panelForcesPerSource_[ sourceName ] = panelForces_;
+    void resetDerivedComputations( const int sourceIndex ) override;
 
-        for( unsigned int i = 0; i < panelTorques_.size( ); i++ )
-        {
-            panelTorques_.at( i ).setZero( );
-        }
-        panelForcesPerSource_[ sourceName ] = panelTorques_;
-    }
+    void addSourceVariables( ) override;
+
+    //! Function to retrieve panel areas and optical coefficients from the panels
+    void updatePanelProperties( );
+
+    //! Function to evaluate the panel surface normals (and moment arms) in the body-fixed frame
+    void updatePanelOrientations( );
 
+    //! Function to add the panel forces (and torques) due to a list of source panels to the given source
+    void addPanelForcesFromSourcePanels(
+        const double* sourceIrradiances,
+        const Eigen::Vector3d* sourceToTargetDirectionsLocalFrame,
+        const int numberOfSourcePanels,
+        const int sourceIndex );
 
     std::vector< std::shared_ptr< system_models::VehicleExteriorPanel > > bodyFixedPanels_;
 
@@ -375,19 +496,46 @@ private:
     std::map< std::string, std::function< Eigen::Quaterniond( ) > > segmentFixedToBodyFixedRotations_;
 
     int totalNumberOfPanels_;
-    
-    std::vector< Eigen::Vector3d > surfaceNormals_;
 
-    std::vector< Eigen::Vector3d > panelCentroidMomentArms_;
+    //! Current surface normals in body-fixed frame (one row per panel)
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > surfaceNormals_;
+
+    //! Current moment arms of panel centroids w.r.t. center of mass (one row per panel)
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > panelCentroidMomentArms_;
+
+    //! Panel areas
+    Eigen::ArrayXd panelAreas_;
+
+    //! Coefficients of reaction vector along the incoming radiation, per panel (absorptivity + diffuse reflectivity)
+    Eigen::ArrayXd incidenceReactionCoefficients_;
+
+    //! Coefficients of reaction vector along the negative surface normal, independent of the cosine of the angle of
+    //! incidence, per panel (2/3 diffuse reflectivity, and 2/3 absorptivity in case of instantaneous reradiation)
+    Eigen::ArrayXd diffuseReactionCoefficients_;
+
+    //! Coefficients of reaction vector along the negative surface normal, proportional to the cosine of the angle of
+    //! incidence, per panel (2 specular reflectivity)
+    Eigen::ArrayXd specularReactionCoefficients_;
+
+    //! Boolean denoting whether all panels have a SpecularDiffuseMixReflectionLaw (so that the optical coefficients
+    //! above can be used)
+    bool useOpticalCoefficients_;
+
+    //! Panel cosines of angle of incidence for the last evaluated source panel
+    Eigen::VectorXd surfacePanelCosines_;
 
-    // Source-specific variables
-    std::vector< double > surfacePanelCosines_;
-    std::vector< Eigen::Vector3d > panelForces_;
-    std::vector< Eigen::Vector3d > panelTorques_;
+    // Pre-allocated work arrays for panel force computation
+    Eigen::ArrayXd weightedCosines_;
+    Eigen::ArrayXd weightedCosineSums_;
+    Eigen::ArrayXd weightedSquaredCosineSums_;
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > weightedDirectionSums_;
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > currentPanelForces_;
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > currentPanelTorques_;
 
-    std::map< std::string, std::vector< double > > surfacePanelCosinesPerSource_;
-    std::map< std::string, std::vector< Eigen::Vector3d > > panelForcesPerSource_;
-    std::map< std::string, std::vector< Eigen::Vector3d > > panelTorquesPerSource_;
+    // Source-specific variables, with index of source given by its position in sourceNames_
+    std::vector< Eigen::VectorXd > surfacePanelCosinesPerSource_;
+    std::vector< Eigen::Matrix< double, Eigen::Dynamic, 3 > > panelForcesPerSource_;
+    std::vector< Eigen::Matrix< double, Eigen::Dynamic, 3 > > panelTorquesPerSource_;
 
 };
 
@@ -53,7 +53,8 @@ public:
     void updateMembers(double currentTime) override
     {
         radiationPressureAcceleration_->updateMembers( currentTime );
-        currentTorque_ = radiationPressureAcceleration_->getTargetModel( )->getCurrentRadiationPressureTorque( );
+        currentTorque_ = radiationPressureAcceleration_->getTargetModel( )->getCurrentRadiationPressureTorque(
+                    radiationPressureAcceleration_->getSourceIndex( ) );
         if( !radiationPressureAcceleration_->getTargetModel( )->forceFunctionRequiresLocalFrameInputs( ) )
         {
             currentTorque_ = radiationPressureAcceleration_->getTargetRotationFromLocalToGlobalFrameFunction( )( ).inverse( ) * currentTorque_;
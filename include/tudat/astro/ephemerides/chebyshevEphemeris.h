@@ -0,0 +1,172 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_CHEBYSHEVEPHEMERIS_H
+#define TUDAT_CHEBYSHEVEPHEMERIS_H
+
+#include <functional>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/ephemeris.h"
+#include "tudat/basics/basicTypedefs.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Ephemeris class that represents a state history by piecewise Chebyshev polynomials.
+/*!
+ *  Ephemeris class that represents a state history by piecewise Chebyshev polynomials. Upon construction, a reference state
+ *  function (typically a Spice kernel) is sampled once over a given time window, which is divided into segments of equal
+ *  duration. In each segment, each of the six Cartesian state components is interpolated at the Chebyshev-Gauss-Lobatto
+ *  nodes of the segment (so that the representation is continuous across segment boundaries). Since the segments have equal
+ *  duration, the segment for a given time is found in constant time, without any search or stored search history. After
+ *  construction, the object is not modified, so that states may be retrieved concurrently from any number of threads
+ *  without locking.
+ *
+ *  The accuracy of the representation is verified during construction, by comparing the interpolated states with the
+ *  reference state function halfway between each pair of consecutive nodes. If a position tolerance is provided and the
+ *  maximum position error exceeds it, the segment duration is halved and the fit repeated, until the tolerance is met. The
+ *  maximum position and velocity errors found in this verification are available through getMaximumPositionError and
+ *  getMaximumVelocityError.
+ */
+class ChebyshevEphemeris : public Ephemeris
+{
+public:
+
+    using Ephemeris::getCartesianState;
+
+    //! Constructor, samples the reference state function and computes the Chebyshev coefficients of each segment.
+    /*!
+     *  Constructor, samples the reference state function and computes the Chebyshev coefficients of each segment.
+     *  \param stateFunction Reference state function, as a function of time, that is to be represented by this ephemeris.
+     *  \param initialTime Start time of the interval over which the ephemeris is valid.
+     *  \param finalTime End time of the interval over which the ephemeris is valid.
+     *  \param segmentDuration (Initial) duration of each segment. The actual segment duration is such that an integer number
+     *  of segments covers the interval, and is no larger than this value.
+     *  \param polynomialDegree Degree of the Chebyshev polynomial in each segment.
+     *  \param referenceFrameOrigin Origin of reference frame in which state is defined.
+     *  \param referenceFrameOrientation Orientation of reference frame in which state is defined.
+     *  \param positionTolerance Maximum allowed position error w.r.t. the reference state function (no refinement is performed
+     *  if this value is NaN or not positive).
+     *  \param maximumNumberOfRefinements Maximum number of times the segment duration is halved to meet the position tolerance;
+     *  an exception is thrown if the tolerance is not met after this number of refinements.
+     */
+    ChebyshevEphemeris( const std::function< Eigen::Vector6d( const double ) > stateFunction,
+                        const double initialTime,
+                        const double finalTime,
+                        const double segmentDuration,
+                        const int polynomialDegree,
+                        const std::string& referenceFrameOrigin = "SSB",
+                        const std::string& referenceFrameOrientation = "ECLIPJ2000",
+                        const double positionTolerance = TUDAT_NAN,
+                        const int maximumNumberOfRefinements = 8 );
+
+    //! Destructor
+    ~ChebyshevEphemeris( ){ }
+
+    //! Get cartesian state from ephemeris.
+    /*!
+     *  Returns cartesian state from ephemeris, evaluated from the Chebyshev polynomial of the segment containing the
+     *  requested time. This function may be called concurrently.
+     *  \param secondsSinceEpoch Seconds since epoch at which ephemeris is to be evaluated.
+     *  \return State from ephemeris.
+     */
+    Eigen::Vector6d getCartesianState( const double secondsSinceEpoch );
+
+    //! Function to retrieve the start time of the interval over which the ephemeris is valid.
+    double getInitialTime( ) const
+    {
+        return initialTime_;
+    }
+
+    //! Function to retrieve the end time of the interval over which the ephemeris is valid.
+    double getFinalTime( ) const
+    {
+        return finalTime_;
+    }
+
+    //! Function to retrieve the duration of each segment.
+    double getSegmentDuration( ) const
+    {
+        return segmentDuration_;
+    }
+
+    //! Function to retrieve the number of segments.
+    int getNumberOfSegments( ) const
+    {
+        return numberOfSegments_;
+    }
+
+    //! Function to retrieve the degree of the Chebyshev polynomial in each segment.
+    int getPolynomialDegree( ) const
+    {
+        return polynomialDegree_;
+    }
+
+    //! Function to retrieve the maximum position error found when verifying the fit against the reference state function.
+    double getMaximumPositionError( ) const
+    {
+        return maximumPositionError_;
+    }
+
+    //! Function to retrieve the maximum velocity error found when verifying the fit against the reference state function.
+    double getMaximumVelocityError( ) const
+    {
+        return maximumVelocityError_;
+    }
+
+private:
+
+    //! Function to compute the Chebyshev coefficients of all segments, for the current segment duration.
+    void computeSegmentCoefficients( const std::function< Eigen::Vector6d( const double ) >& stateFunction );
+
+    //! Function to compute the maximum position and velocity error w.r.t. the reference state function.
+    void computeMaximumErrors( const std::function< Eigen::Vector6d( const double ) >& stateFunction );
+
+    //! Function to evaluate the Chebyshev polynomial of a given segment at a given scaled time (in [-1,1])
+    Eigen::Vector6d evaluateSegment( const int segmentIndex, const double scaledTime ) const;
+
+    //! Start time of the interval over which the ephemeris is valid.
+    double initialTime_;
+
+    //! End time of the interval over which the ephemeris is valid.
+    double finalTime_;
+
+    //! Duration of each segment.
+    double segmentDuration_;
+
+    //! Number of segments.
+    int numberOfSegments_;
+
+    //! Degree of the Chebyshev polynomial in each segment.
+    int polynomialDegree_;
+
+    //! Chebyshev coefficients, ordered by segment, coefficient index and state component (6 entries per coefficient).
+    std::vector< double > coefficients_;
+
+    //! Maximum position error found when verifying the fit against the reference state function.
+    double maximumPositionError_;
+
+    //! Maximum velocity error found when verifying the fit against the reference state function.
+    double maximumVelocityError_;
+};
+
+} // namespace ephemerides
+
+} // namespace tudat
+
+#endif // TUDAT_CHEBYSHEVEPHEMERIS_H
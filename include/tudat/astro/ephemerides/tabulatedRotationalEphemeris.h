@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <memory>
+#include <mutex>
 
 #include <Eigen/Core>
 
@@ -79,7 +80,9 @@ public:
      */
     void reset( const std::shared_ptr< interpolators::OneDimensionalInterpolator< TimeType, StateType > > interpolator )
     {
+        std::lock_guard< std::mutex > currentStateLock( currentStateMutex_ );
         interpolator_ = interpolator;
+        currentTime_ = TUDAT_NAN;
     }
 
     //! Function to retrieve the rotational state interpolator.
@@ -102,8 +105,11 @@ public:
      */
     Eigen::Quaterniond getRotationToBaseFrame( const double secondsSinceEpoch )
     {
-        updateInterpolator( secondsSinceEpoch );
-        return currentRotationToBaseFrame_.template cast< double >( );
+        Eigen::Quaternion< StateScalarType > rotationToBaseFrame;
+        Eigen::Matrix< StateScalarType, 3, 1 > rotationalVelocityVectorInTargetFrame;
+        getCurrentRotationalState( secondsSinceEpoch, rotationToBaseFrame, rotationalVelocityVectorInTargetFrame );
+
+        return rotationToBaseFrame.template cast< double >( );
     }
 
     //! Get rotation quaternion from base frame to target frame.
@@ -125,9 +131,11 @@ public:
      */
     Eigen::Vector3d getRotationalVelocityVectorInBaseFrame( const double secondsSinceEpoch )
     {
-        updateInterpolator( secondsSinceEpoch );
+        Eigen::Quaternion< StateScalarType > rotationToBaseFrame;
+        Eigen::Matrix< StateScalarType, 3, 1 > rotationalVelocityVectorInTargetFrame;
+        getCurrentRotationalState( secondsSinceEpoch, rotationToBaseFrame, rotationalVelocityVectorInTargetFrame );
 
-        return ( currentRotationToBaseFrame_ * currentRotationalVelocityVectorInTargetFrame_ ).template cast< double >( );
+        return ( rotationToBaseFrame * rotationalVelocityVectorInTargetFrame ).template cast< double >( );
     }
 
     //! Function to retrieve the angular velocity vector of the body, expressed in the target (body-fixed) frame.
@@ -138,9 +146,11 @@ public:
      */
     Eigen::Vector3d getRotationalVelocityVectorInTargetFrame( const double secondsSinceEpoch )
     {
-        updateInterpolator( secondsSinceEpoch );
+        Eigen::Quaternion< StateScalarType > rotationToBaseFrame;
+        Eigen::Matrix< StateScalarType, 3, 1 > rotationalVelocityVectorInTargetFrame;
+        getCurrentRotationalState( secondsSinceEpoch, rotationToBaseFrame, rotationalVelocityVectorInTargetFrame );
 
-        return currentRotationalVelocityVectorInTargetFrame_.template cast< double >( );
+        return rotationalVelocityVectorInTargetFrame.template cast< double >( );
     }
 
     //! Function to calculate the derivative of the rotation matrix from base frame to target frame.
@@ -151,11 +161,13 @@ public:
      */
     Eigen::Matrix3d getDerivativeOfRotationToTargetFrame( const double secondsSinceEpoch )
     {
-        updateInterpolator( secondsSinceEpoch );
+        Eigen::Quaternion< StateScalarType > rotationToBaseFrame;
+        Eigen::Matrix< StateScalarType, 3, 1 > rotationalVelocityVectorInTargetFrame;
+        getCurrentRotationalState( secondsSinceEpoch, rotationToBaseFrame, rotationalVelocityVectorInTargetFrame );
 
         return getDerivativeOfRotationMatrixToFrame(
-                    ( currentRotationToBaseFrame_.inverse( ) ).toRotationMatrix( ).template cast< double >( ),
-                    ( currentRotationToBaseFrame_ * currentRotationalVelocityVectorInTargetFrame_ ).template cast< double >( ) );
+                    ( rotationToBaseFrame.inverse( ) ).toRotationMatrix( ).template cast< double >( ),
+                    ( rotationToBaseFrame * rotationalVelocityVectorInTargetFrame ).template cast< double >( ) );
     }
 
     //! Function to calculate the derivative of the rotation matrix from target frame to base frame.
@@ -166,17 +178,34 @@ public:
      */
     Eigen::Matrix3d getDerivativeOfRotationToBaseFrame( const double secondsSinceEpoch )
     {
-        updateInterpolator( secondsSinceEpoch );
-
         return getDerivativeOfRotationToTargetFrame( secondsSinceEpoch ).transpose( );
     }
 
 
 private:
 
+    //! Function to retrieve the rotational state at a given time
+    /*!
+     * Function to retrieve the rotational state at a given time, updating the current rotational state from the interpolator
+     * if needed. The current rotational state is shared between threads, so it is locked while it is updated and copied.
+     * \param time Time at which to evaluate the rotational state
+     * \param rotationToBaseFrame Rotation from body-fixed frame to base frame at given time (returned by reference)
+     * \param rotationalVelocityVectorInTargetFrame Angular velocity vector of body in body-fixed frame at given time
+     * (returned by reference)
+     */
+    void getCurrentRotationalState( const double time,
+                                    Eigen::Quaternion< StateScalarType >& rotationToBaseFrame,
+                                    Eigen::Matrix< StateScalarType, 3, 1 >& rotationalVelocityVectorInTargetFrame )
+    {
+        std::lock_guard< std::mutex > currentStateLock( currentStateMutex_ );
+        updateInterpolator( time );
+        rotationToBaseFrame = currentRotationToBaseFrame_;
+        rotationalVelocityVectorInTargetFrame = currentRotationalVelocityVectorInTargetFrame_;
+    }
+
     //! Function to retrieve the current rotational state from the interpolator
     /*!
-     * Function to retrieve the current rotational state from the interpolator
+     * Function to retrieve the current rotational state from the interpolator (currentStateMutex_ must be locked by caller)
      * \param time Time at which to evaluate the interpoaltor
      */
     void updateInterpolator( const double time )
@@ -221,6 +250,9 @@ private:
     //! Rotation from body-fixed frame to base frame obtained at last call to updateInterpolator.
     Eigen::Quaternion< StateScalarType > currentRotationToBaseFrame_;
 
+    //! Mutex protecting the current rotational state, which is shared between threads
+    std::mutex currentStateMutex_;
+
 };
 
 //! Create a tabulated rotation model from a given rotation model and interpolation settings
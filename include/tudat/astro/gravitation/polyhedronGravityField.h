@@ -25,8 +25,10 @@
 
 #include "tudat/astro/gravitation/gravityFieldModel.h"
 #include "tudat/astro/basic_astro/physicalConstants.h"
+#include "tudat/basics/threadPool.h"
 #include "tudat/astro/basic_astro/polyhedronFuntions.h"
 #include "tudat/math/basic/polyhedron.h"
+#include "tudat/math/basic/polyhedronFacetTree.h"
 
 namespace tudat
 {
@@ -35,6 +37,15 @@ namespace gravitation
 {
 
 //! Cache object in which variables that are required for the computation of polyhedron gravity field are stored.
+/*!
+ *  Cache object in which variables that are required for the computation of polyhedron gravity field are stored. The
+ *  vertex coordinates wrt the field point are stored per coordinate (one column per coordinate), and the facet and edge
+ *  dyads (if provided) are stored per dyad component, such that the per-facet and per-edge factors, and the sums over
+ *  the facets and edges that constitute the potential and its gradient (Werner and Scheeres, 1997), are computed in
+ *  vectorizable loops over contiguous arrays. The loops are split in blocks of facets/edges, which can be distributed
+ *  over a thread pool. The partial sums of the blocks are added in a fixed order, so the results do not depend on the
+ *  number of threads.
+ */
 class PolyhedronGravityCache
 {
 public:
@@ -55,11 +66,32 @@ public:
             const Eigen::MatrixXi& verticesDefiningEachEdge)
             : verticesCoordinates_( verticesCoordinates ),
               verticesDefiningEachFacet_( verticesDefiningEachFacet ),
-              verticesDefiningEachEdge_( verticesDefiningEachEdge )
+              verticesDefiningEachEdge_( verticesDefiningEachEdge ),
+              areSumsUpToDate_( false )
     {
         currentBodyFixedPosition_ = (Eigen::Vector3d() << TUDAT_NAN, TUDAT_NAN, TUDAT_NAN).finished();
     }
 
+    /*! Constructor, with facet and edge dyads.
+     *
+     * Constructor, with facet and edge dyads, required to compute the potential and its gradient with the
+     * calculateGravitationalPotential and calculateGradientOfGravitationalPotential functions.
+     * @param verticesCoordinates Matrix with coordinates of the polyhedron vertices. Each row represents the (x,y,z)
+     * coordinates of one vertex.
+     * @param verticesDefiningEachFacet Matrix with the indices (0 indexed) of the vertices defining each facet. Each
+     * row contains 3 indices, which must be provided in counterclockwise order when seen from outise the polyhedron.
+     * @param verticesDefiningEachEdge Matrix with the indices (0 indexed) of the vertices defining each facet. Each
+     * row contains 2 indices.
+     * @param facetDyads Vector containing facet dyads.
+     * @param edgeDyads Vector containing edge dyads.
+     */
+    PolyhedronGravityCache(
+            const Eigen::MatrixXd& verticesCoordinates,
+            const Eigen::MatrixXi& verticesDefiningEachFacet,
+            const Eigen::MatrixXi& verticesDefiningEachEdge,
+            const std::vector< Eigen::MatrixXd >& facetDyads,
+            const std::vector< Eigen::MatrixXd >& edgeDyads );
+
     /*! Update cached variables to current state.
      *
      * Update cached variables to current state.
@@ -67,6 +99,25 @@ public:
      */
     void update( const Eigen::Vector3d& currentBodyFixedPosition );
 
+    /*! Calculates the gravitational potential at the current body fixed position.
+     *
+     * Calculates the gravitational potential at the current body fixed position (i.e. last call to update), according
+     * to Eq. 10 of Werner and Scheeres (1997). Requires the facet and edge dyads to have been provided to the constructor.
+     * @param gravitationalConstantTimesDensity Product of the gravitational constant and density.
+     * @return Gravitational potential.
+     */
+    double calculateGravitationalPotential( const double gravitationalConstantTimesDensity );
+
+    /*! Calculates the gradient of the gravitational potential at the current body fixed position.
+     *
+     * Calculates the gradient of the gravitational potential at the current body fixed position (i.e. last call to
+     * update), according to Eq. 15 of Werner and Scheeres (1997). Requires the facet and edge dyads to have been
+     * provided to the constructor.
+     * @param gravitationalConstantTimesDensity Product of the gravitational constant and density.
+     * @return Gradient of gravitational potential.
+     */
+    Eigen::Vector3d calculateGradientOfGravitationalPotential( const double gravitationalConstantTimesDensity );
+
     /*! Function to retrieve the coordinates of the polyhedron vertices wrt field point.
      *
      * Function to retrieve the coordinates of the polyhedron vertices wrt field point.
@@ -91,11 +142,24 @@ public:
     Eigen::VectorXd& getPerEdgeFactor ( )
     { return currentPerEdgeFactor_; }
 
+    //! Function to set the number of threads over which the blocks of facets and edges are distributed (serial if 1).
+    void setNumberOfThreads( const unsigned int numberOfThreads );
+
+    //! Function to set the thread pool over which the blocks of facets and edges are distributed (serial if nullptr).
+    void setThreadPool( const std::shared_ptr< utilities::ThreadPool > threadPool )
+    { threadPool_ = threadPool; }
+
+    //! Function to retrieve the thread pool over which the blocks of facets and edges are distributed.
+    std::shared_ptr< utilities::ThreadPool > getThreadPool( )
+    { return threadPool_; }
 
 protected:
 
 private:
 
+    // Function to compute the sums over the facets and edges, used for the potential and its gradient.
+    void calculateFacetAndEdgeSums( );
+
     // Current body fixed position.
     Eigen::Vector3d currentBodyFixedPosition_;
 
@@ -108,14 +172,37 @@ private:
     // Matrix with the indices (0 indexed) of the vertices defining each facet.
     const Eigen::MatrixXi verticesDefiningEachEdge_;
 
+    // Components (xx, xy, xz, yy, yz, zz) of the (symmetric) dyad of each facet, one column per component.
+    Eigen::MatrixXd facetDyadComponents_;
+
+    // Components (xx, xy, xz, yx, yy, yz, zx, zy, zz) of the dyad of each edge, one column per component.
+    Eigen::MatrixXd edgeDyadComponents_;
+
     // Current vertices coordinates wrt body fixed position.
     Eigen::MatrixXd currentVerticesCoordinatesRelativeToFieldPoint_;
 
+    // Current distance of the vertices to the body fixed position.
+    Eigen::VectorXd currentVerticesDistancesToFieldPoint_;
+
     // Current value of the per-facet factors.
     Eigen::VectorXd currentPerFacetFactor_;
 
     // Current value of the per-edge factors.
     Eigen::VectorXd currentPerEdgeFactor_;
+
+    // Current sums over the edges (first element) and facets (second element) of dyad * r * factor (first three
+    // components) and r^T * dyad * r * factor (fourth component), with r the position of the facet/edge wrt field point.
+    std::pair< Eigen::Vector4d, Eigen::Vector4d > currentEdgeAndFacetSums_;
+
+    // Partial sums over the edges and facets of each block.
+    std::vector< Eigen::Vector4d > edgeBlockSums_;
+    std::vector< Eigen::Vector4d > facetBlockSums_;
+
+    // Boolean denoting whether currentEdgeAndFacetSums_ have been computed for the current body fixed position.
+    bool areSumsUpToDate_;
+
+    // Thread pool over which the blocks of facets and edges are distributed (serial if nullptr).
+    std::shared_ptr< utilities::ThreadPool > threadPool_;
 };
 
 
@@ -145,7 +232,8 @@ public:
         gravitationalParameter_( gravitationalParameter ),
         verticesCoordinates_( verticesCoordinates ),
         verticesDefiningEachFacet_( verticesDefiningEachFacet ),
-        fixedReferenceFrame_( fixedReferenceFrame )
+        fixedReferenceFrame_( fixedReferenceFrame ),
+        maximumRelativeTruncationError_( 0.0 )
     {
         // Check if provided arguments are valid
         basic_mathematics::checkValidityOfPolyhedronSettings(verticesCoordinates, verticesDefiningEachFacet);
@@ -165,7 +253,7 @@ public:
 
         // Create cache object
         polyhedronGravityCache_ = std::make_shared< PolyhedronGravityCache >(
-                verticesCoordinates_, verticesDefiningEachFacet_, verticesDefiningEachEdge_);
+                verticesCoordinates_, verticesDefiningEachFacet_, verticesDefiningEachEdge_, facetDyads_, edgeDyads_ );
 
         inertiaTensor_ = basic_astrodynamics::computePolyhedronInertiaTensor(
                 verticesCoordinates_, verticesDefiningEachFacet_, density_ );
@@ -179,17 +267,15 @@ public:
      */
     virtual double getGravitationalPotential( const Eigen::Vector3d& bodyFixedPosition )
     {
+        if( facetTree_ != nullptr )
+        {
+            return facetTree_->calculateGravitationalPotential(
+                        gravitationalParameter_ / volume_, bodyFixedPosition, maximumRelativeTruncationError_ );
+        }
+
         polyhedronGravityCache_->update(bodyFixedPosition);
 
-        return basic_mathematics::calculatePolyhedronGravitationalPotential(
-                gravitationalParameter_ / volume_,
-                polyhedronGravityCache_->getVerticesCoordinatesRelativeToFieldPoint(),
-                verticesDefiningEachFacet_,
-                verticesDefiningEachEdge_,
-                facetDyads_,
-                edgeDyads_,
-                polyhedronGravityCache_->getPerFacetFactor(),
-                polyhedronGravityCache_->getPerEdgeFactor() );
+        return polyhedronGravityCache_->calculateGravitationalPotential( gravitationalParameter_ / volume_ );
     }
 
     /*! Function to calculate the gradient of the gravitational potential (i.e. the acceleration).
@@ -200,17 +286,15 @@ public:
      */
     virtual Eigen::Vector3d getGradientOfPotential( const Eigen::Vector3d& bodyFixedPosition )
     {
+        if( facetTree_ != nullptr )
+        {
+            return facetTree_->calculateGradientOfGravitationalPotential(
+                        gravitationalParameter_ / volume_, bodyFixedPosition, maximumRelativeTruncationError_ );
+        }
+
         polyhedronGravityCache_->update(bodyFixedPosition);
 
-        return basic_mathematics::calculatePolyhedronGradientOfGravitationalPotential(
-                gravitationalParameter_ / volume_,
-                polyhedronGravityCache_->getVerticesCoordinatesRelativeToFieldPoint(),
-                verticesDefiningEachFacet_,
-                verticesDefiningEachEdge_,
-                facetDyads_,
-                edgeDyads_,
-                polyhedronGravityCache_->getPerFacetFactor(),
-                polyhedronGravityCache_->getPerEdgeFactor() );
+        return polyhedronGravityCache_->calculateGradientOfGravitationalPotential( gravitationalParameter_ / volume_ );
     }
 
     /*! Function to calculate the hessian matrix of the gravitational potential.
@@ -279,6 +363,44 @@ public:
         return inertiaTensor_;
     }
 
+    /*! Function to set the evaluation of the potential and its gradient using a bounding volume hierarchy of the facets.
+     *
+     * Function to set the evaluation of the potential and its gradient using a bounding volume hierarchy of the facets
+     * (see PolyhedronFacetTree), in which distant facet clusters are evaluated with a multipole approximation. The tree
+     * is built once, when calling this function. The hessian and laplacian of the potential are always computed exactly.
+     * @param maximumRelativeTruncationError Maximum relative truncation error of each approximated facet cluster (if
+     * zero, the tree is only used to reorganize the exact computation).
+     * @param maximumNumberOfFacetsPerLeaf Maximum number of facets in the leaf nodes of the tree.
+     */
+    void setFacetTreeEvaluation( const double maximumRelativeTruncationError,
+                                 const int maximumNumberOfFacetsPerLeaf = 8 )
+    {
+        if( maximumRelativeTruncationError < 0.0 )
+        {
+            throw std::runtime_error( "Error when setting polyhedron facet tree evaluation, maximum relative truncation "
+                                      "error must be non-negative." );
+        }
+        maximumRelativeTruncationError_ = maximumRelativeTruncationError;
+        facetTree_ = std::make_shared< basic_mathematics::PolyhedronFacetTree >(
+                    verticesCoordinates_, verticesDefiningEachFacet_, maximumNumberOfFacetsPerLeaf );
+    }
+
+    //! Function to return the bounding volume hierarchy of the facets (nullptr if not used).
+    std::shared_ptr< basic_mathematics::PolyhedronFacetTree > getFacetTree( )
+    { return facetTree_; }
+
+    //! Function to set the number of threads over which the exact facet and edge sums are distributed (serial if 1).
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    { polyhedronGravityCache_->setNumberOfThreads( numberOfThreads ); }
+
+    //! Function to retrieve the thread pool over which the exact facet and edge sums are distributed (nullptr if serial).
+    std::shared_ptr< utilities::ThreadPool > getThreadPool( )
+    { return polyhedronGravityCache_->getThreadPool( ); }
+
+    //! Function to return the maximum relative truncation error of each facet cluster evaluated using the facet tree.
+    double getMaximumRelativeTruncationError( )
+    { return maximumRelativeTruncationError_; }
+
 protected:
 
 private:
@@ -347,6 +469,12 @@ private:
     //! Identifier for body-fixed reference frame
     std::string fixedReferenceFrame_;
 
+    //! Bounding volume hierarchy of the facets, used to compute the potential and its gradient (nullptr if not used).
+    std::shared_ptr< basic_mathematics::PolyhedronFacetTree > facetTree_;
+
+    //! Maximum relative truncation error of each facet cluster evaluated using the facet tree.
+    double maximumRelativeTruncationError_;
+
 };
 
 } // namespace gravitation
@@ -98,11 +98,14 @@ public:
           rotationFromBodyFixedToIntegrationFrameFunction_( rotationFromBodyFixedToIntegrationFrameFunction ),
           isMutualAttractionUsed_( isMutualAttractionUsed ),
           polyhedronCache_( std::make_shared< PolyhedronGravityCache >(
-                 aVerticesCoordinatesMatrix, aVerticesDefiningEachFacetMatrix, aVerticesDefiningEachEdgeMatrix) ),
+                 aVerticesCoordinatesMatrix, aVerticesDefiningEachFacetMatrix, aVerticesDefiningEachEdgeMatrix,
+                 aFacetDyadsVector, aEdgeDyadsVector ) ),
           currentPotential_( TUDAT_NAN ),
           currentLaplacianOfPotential_( TUDAT_NAN ),
           updatePotential_( updateGravitationalPotential ),
-          updateLaplacianOfPotential_( updateLaplacianOfGravitationalPotential )
+          updateLaplacianOfPotential_( updateLaplacianOfGravitationalPotential ),
+          maximumRelativeTruncationError_( 0.0 ),
+          isPolyhedronCacheUpToDate_( false )
     { }
 
     //! Constructor taking functions for position of bodies, and parameters of polyhedron.
@@ -159,11 +162,13 @@ public:
           isMutualAttractionUsed_( isMutualAttractionUsed ),
           polyhedronCache_( std::make_shared< PolyhedronGravityCache >(
                  verticesCoordinatesFunction(), verticesDefiningEachFacetFunction(),
-                 verticesDefiningEachEdgeFunction() ) ),
+                 verticesDefiningEachEdgeFunction(), facetDyadsFunction(), edgeDyadsFunction() ) ),
           currentPotential_( TUDAT_NAN ),
           currentLaplacianOfPotential_( TUDAT_NAN ),
           updatePotential_( updateGravitationalPotential ),
-          updateLaplacianOfPotential_( updateLaplacianOfGravitationalPotential )
+          updateLaplacianOfPotential_( updateLaplacianOfGravitationalPotential ),
+          maximumRelativeTruncationError_( 0.0 ),
+          isPolyhedronCacheUpToDate_( false )
     { }
 
     //! Update class members.
@@ -252,12 +257,48 @@ public:
     StateFunction getStateFunctionOfBodyUndergoingAcceleration( )
     { return subjectPositionFunction_; }
 
-    //! Function to retrieve the spherical harmonics cache for this acceleration.
+    //! Function to retrieve the polyhedron cache for this acceleration.
+    /*!
+     * Function to retrieve the polyhedron cache for this acceleration. If the acceleration is computed using a facet
+     * tree, the cache is only updated to the current position when calling updatePolyhedronCache.
+     * \return Polyhedron cache for this acceleration.
+     */
     std::shared_ptr< PolyhedronGravityCache > getPolyhedronCache( )
     {
         return polyhedronCache_;
     }
 
+    //! Function to update the polyhedron cache to the current relative position, if not yet done since the last update.
+    void updatePolyhedronCache( )
+    {
+        if( !isPolyhedronCacheUpToDate_ )
+        {
+            polyhedronCache_->update( currentRelativePosition_ );
+            isPolyhedronCacheUpToDate_ = true;
+        }
+    }
+
+    //! Function to set the computation of the acceleration and potential using a bounding volume hierarchy of the facets.
+    /*!
+     * Function to set the computation of the acceleration and potential using a bounding volume hierarchy of the facets,
+     * in which distant facet clusters are evaluated with a multipole approximation (see PolyhedronFacetTree). The
+     * laplacian of the potential is always computed exactly.
+     * \param facetTree Bounding volume hierarchy of the facets of the polyhedron (nullptr to use exact computation).
+     * \param maximumRelativeTruncationError Maximum relative truncation error of each approximated facet cluster.
+     */
+    void setFacetTree( const std::shared_ptr< basic_mathematics::PolyhedronFacetTree > facetTree,
+                       const double maximumRelativeTruncationError )
+    {
+        facetTree_ = facetTree;
+        maximumRelativeTruncationError_ = maximumRelativeTruncationError;
+    }
+
+    //! Function to return the bounding volume hierarchy of the facets (nullptr if not used).
+    std::shared_ptr< basic_mathematics::PolyhedronFacetTree > getFacetTree( )
+    {
+        return facetTree_;
+    }
+
     //! Function to return the value of the current gravitational potential.
     double getCurrentPotential ( )
     { return currentPotential_; }
@@ -352,6 +393,15 @@ private:
 
     //! Flag indicating whether to update the laplacian of the gravitational potential when calling the updateMembers function.
     bool updateLaplacianOfPotential_;
+
+    //! Bounding volume hierarchy of the facets, used to compute the acceleration and potential (nullptr if not used).
+    std::shared_ptr< basic_mathematics::PolyhedronFacetTree > facetTree_;
+
+    //! Maximum relative truncation error of each facet cluster evaluated using the facet tree.
+    double maximumRelativeTruncationError_;
+
+    //! Flag indicating whether the polyhedron cache has been updated to the current relative position.
+    bool isPolyhedronCacheUpToDate_;
 };
 
 
@@ -0,0 +1,223 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_SPHERICAL_HARMONICS_GRADIENT_CALCULATOR_H
+#define TUDAT_SPHERICAL_HARMONICS_GRADIENT_CALCULATOR_H
+
+#include <memory>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/threadPool.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Class for the fast computation of the gradient of a geodesy-normalized spherical harmonic gravity field.
+/*!
+ *  Class for the fast computation of the gradient of a geodesy-normalized spherical harmonic gravity field, returning the
+ *  same result as computeGeodesyNormalizedGravitationalAccelerationSum (when not saving separate terms). Instead of
+ *  computing each term of the summation separately (through a LegendreCache and a std::function per coefficient), the
+ *  Legendre polynomials and the (transposed) coefficients are stored per degree, contiguously in the order. Both the
+ *  Legendre recursion and the summation over the orders of each degree are then done with Eigen array operations on
+ *  contiguous data, which Eigen vectorizes with the SIMD instruction set selected at compile time (SSE2, AVX2 or
+ *  AVX-512, see TUDAT_BUILD_WITH_NATIVE_ARCHITECTURE), falling back to scalar code if none is available.
+ *
+ *  Multiple positions can be evaluated in a single call (computeGradients), in which case the positions are processed in
+ *  blocks: the coefficients and recursion multipliers of each degree are then traversed once per block, rather than
+ *  once per position, and the blocks may be distributed over a thread pool.
+ *
+ *  The single-position function computeGradient uses intermediate results stored as member variables, so it should not
+ *  be called concurrently from multiple threads on a single object. The computeGradients function does not modify the
+ *  object.
+ */
+class SphericalHarmonicsGradientCalculator
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor, sets the coefficients of the gravity field.
+     *  \param cosineCoefficients Geodesy-normalized cosine coefficients (row index degree, column index order).
+     *  \param sineCoefficients Geodesy-normalized sine coefficients (row index degree, column index order).
+     */
+    SphericalHarmonicsGradientCalculator( const Eigen::MatrixXd& cosineCoefficients,
+                                          const Eigen::MatrixXd& sineCoefficients );
+
+    //! Function to reset the coefficients of the gravity field.
+    /*!
+     *  Function to reset the coefficients of the gravity field. The coefficients are only repacked into the internal
+     *  (per-degree) layout if they differ from the current coefficients, so that this function may be called before
+     *  each evaluation at negligible cost compared to the evaluation itself.
+     *  \param cosineCoefficients Geodesy-normalized cosine coefficients (row index degree, column index order).
+     *  \param sineCoefficients Geodesy-normalized sine coefficients (row index degree, column index order).
+     */
+    void setCoefficients( const Eigen::MatrixXd& cosineCoefficients,
+                          const Eigen::MatrixXd& sineCoefficients );
+
+    //! Function to compute the gradient of the gravitational potential (e.g. the gravitational acceleration).
+    /*!
+     *  Function to compute the gradient of the gravitational potential (e.g. the gravitational acceleration), in the
+     *  frame in which the coefficients are defined.
+     *  \param bodyFixedPosition Cartesian position, in frame in which coefficients are defined, at which the gradient is
+     *  to be computed.
+     *  \param gravitationalParameter Gravitational parameter of the gravity field.
+     *  \param referenceRadius Reference radius of the gravity field.
+     *  \return Cartesian gradient of the potential, in frame in which coefficients are defined.
+     */
+    Eigen::Vector3d computeGradient( const Eigen::Vector3d& bodyFixedPosition,
+                                     const double gravitationalParameter,
+                                     const double referenceRadius );
+
+    //! Function to compute the gradient of the gravitational potential at a list of positions.
+    /*!
+     *  Function to compute the gradient of the gravitational potential (e.g. the gravitational acceleration) at a list of
+     *  positions, in the frame in which the coefficients are defined.
+     *  \param bodyFixedPositions Cartesian positions (one per row), in frame in which coefficients are defined, at which
+     *  the gradient is to be computed.
+     *  \param gravitationalParameter Gravitational parameter of the gravity field.
+     *  \param referenceRadius Reference radius of the gravity field.
+     *  \param threadPool Thread pool over which the positions are to be distributed (serial evaluation if nullptr).
+     *  \return Cartesian gradients of the potential (one per row), in frame in which coefficients are defined.
+     */
+    Eigen::MatrixXd computeGradients( const Eigen::MatrixXd& bodyFixedPositions,
+                                      const double gravitationalParameter,
+                                      const double referenceRadius,
+                                      const std::shared_ptr< utilities::ThreadPool > threadPool = nullptr ) const;
+
+    //! Function to retrieve the maximum degree of the gravity field.
+    int getMaximumDegree( ) const
+    {
+        return maximumDegree_;
+    }
+
+    //! Function to retrieve the maximum order of the gravity field.
+    int getMaximumOrder( ) const
+    {
+        return maximumOrder_;
+    }
+
+    //! Maximum number of positions that is processed simultaneously in computeGradients.
+    static constexpr int POSITION_BLOCK_SIZE = 16;
+
+private:
+
+    //! Work arrays for the evaluation of the gradient at a block of positions.
+    struct Workspace
+    {
+        //! Function to (re)allocate the work arrays for given number of stored orders and maximum block size.
+        void resize( const int numberOfStoredOrders, const int blockSize );
+
+        //! Legendre polynomials of the current and two previous degrees (row index order, column index position).
+        Eigen::MatrixXd legendrePolynomials[ 3 ];
+
+        //! Cosines of order times longitude (row index order, column index position).
+        Eigen::MatrixXd cosinesOfOrderTimesLongitude;
+
+        //! Sines of order times longitude (row index order, column index position).
+        Eigen::MatrixXd sinesOfOrderTimesLongitude;
+
+        //! Terms C_{n,m} cos(m*lambda) + S_{n,m} sin(m*lambda) of a single degree and position.
+        Eigen::ArrayXd cosineTerms;
+
+        //! Terms S_{n,m} cos(m*lambda) - C_{n,m} sin(m*lambda) of a single degree and position.
+        Eigen::ArrayXd sineTerms;
+
+        //! Sines of latitude (index position).
+        Eigen::ArrayXd sinesOfLatitude;
+
+        //! Cosines of latitude (index position).
+        Eigen::ArrayXd cosinesOfLatitude;
+
+        //! Tangents of latitude (index position).
+        Eigen::ArrayXd tangentsOfLatitude;
+
+        //! Ratios of reference radius and radius (index position).
+        Eigen::ArrayXd radiusRatios;
+
+        //! Powers (of current degree + 1) of ratios of reference radius and radius (index position).
+        Eigen::ArrayXd radiusRatioPowers;
+
+        //! Spherical gradients (radius, latitude, longitude) accumulated over the degrees (column index position).
+        Eigen::Matrix3Xd sphericalGradients;
+    };
+
+    //! Function to (re)compute the recursion multipliers for the current maximum degree and order.
+    void resetRecursionMultipliers( );
+
+    //! Function to compute the gradient at a block of positions.
+    /*!
+     *  Function to compute the gradient at a block of positions, using (and modifying) the provided work arrays.
+     *  \param bodyFixedPositions Cartesian positions (one per row), at which the gradient is to be computed.
+     *  \param firstPositionIndex Index of first row of bodyFixedPositions in block.
+     *  \param numberOfPositions Number of positions in block (at most POSITION_BLOCK_SIZE).
+     *  \param gravitationalParameter Gravitational parameter of the gravity field.
+     *  \param referenceRadius Reference radius of the gravity field.
+     *  \param workspace Work arrays used for the computation.
+     *  \param gradients Cartesian gradients (one per row), of which the rows of the current block are set by this
+     *  function.
+     */
+    template< typename PositionsType, typename GradientsType >
+    void computeGradientsOfBlock( const PositionsType& bodyFixedPositions,
+                                  const int firstPositionIndex,
+                                  const int numberOfPositions,
+                                  const double gravitationalParameter,
+                                  const double referenceRadius,
+                                  Workspace& workspace,
+                                  GradientsType& gradients ) const;
+
+    //! Maximum degree of the gravity field.
+    int maximumDegree_;
+
+    //! Maximum order of the gravity field.
+    int maximumOrder_;
+
+    //! Number of orders stored per degree (maximumOrder_ + 2, to include order needed for the Legendre derivatives).
+    int numberOfStoredOrders_;
+
+    //! Cosine coefficients, as provided to setCoefficients.
+    Eigen::MatrixXd cosineCoefficients_;
+
+    //! Sine coefficients, as provided to setCoefficients.
+    Eigen::MatrixXd sineCoefficients_;
+
+    //! Transposed cosine coefficients (column index degree, row index order; zero for order > degree).
+    Eigen::MatrixXd packedCosineCoefficients_;
+
+    //! Transposed sine coefficients (column index degree, row index order; zero for order > degree).
+    Eigen::MatrixXd packedSineCoefficients_;
+
+    //! Multipliers of P_{n-1,m} (excluding factor sin(latitude)) in recursion for P_{n,m} (column index n, row index m)
+    Eigen::MatrixXd firstRecursionMultipliers_;
+
+    //! Multipliers of P_{n-2,m} in recursion for P_{n,m} (column index n, row index m)
+    Eigen::MatrixXd secondRecursionMultipliers_;
+
+    //! Multipliers of P_{n,m+1} in cos(latitude) times derivative of P_{n,m} (column index n, row index m)
+    Eigen::MatrixXd derivativeMultipliers_;
+
+    //! Multipliers of P_{n-1,n-1} (excluding factor cos(latitude)) in recursion for P_{n,n} (index n)
+    Eigen::ArrayXd sectoralRecursionMultipliers_;
+
+    //! List of orders 0 to maximumOrder_ + 1, as floating point values.
+    Eigen::ArrayXd orders_;
+
+    //! Work arrays used by computeGradient.
+    Workspace singlePositionWorkspace_;
+};
+
+} // namespace gravitation
+
+} // namespace tudat
+
+#endif // TUDAT_SPHERICAL_HARMONICS_GRADIENT_CALCULATOR_H
@@ -28,6 +28,7 @@
 #include "tudat/math/basic/legendrePolynomials.h"
 #include "tudat/astro/basic_astro/physicalConstants.h"
 #include "tudat/astro/gravitation/gravityFieldModel.h"
+#include "tudat/astro/gravitation/sphericalHarmonicsGradientCalculator.h"
 #include "tudat/math/basic/sphericalHarmonics.h"
 
 namespace tudat
@@ -434,6 +435,33 @@ public:
                     sineCoefficients_.block( 0, 0, maximumDegree, maximumOrder ), sphericalHarmonicsCache_, dummyMap );
     }
 
+    //! Get the gradient of the potential at a list of positions.
+    /*!
+     *  Returns the gradient of the potential for the gravity field selected (expanded to its maximum degree and order) at
+     *  a list of positions, for instance a grid of points or the positions of ensemble members at a single epoch. The
+     *  positions are processed in blocks, traversing the coefficients once per block (see
+     *  SphericalHarmonicsGradientCalculator), and the blocks are distributed over the threads of the thread pool
+     *  (if provided).
+     *  \param bodyFixedPositions Positions (one per row, N x 3) at which gradient of potential is to be determined
+     *  \param threadPool Thread pool over which the positions are to be distributed (serial evaluation if nullptr).
+     *  \return Gradients of potential (one per row, N x 3).
+     */
+    Eigen::MatrixXd getGradientsOfPotential( const Eigen::MatrixXd& bodyFixedPositions,
+                                             const std::shared_ptr< utilities::ThreadPool > threadPool = nullptr )
+    {
+        if( gradientCalculator_ == nullptr )
+        {
+            gradientCalculator_ = std::make_shared< SphericalHarmonicsGradientCalculator >(
+                        cosineCoefficients_, sineCoefficients_ );
+        }
+        else
+        {
+            gradientCalculator_->setCoefficients( cosineCoefficients_, sineCoefficients_ );
+        }
+        return gradientCalculator_->computeGradients(
+                    bodyFixedPositions, gravitationalParameter_, referenceRadius_, threadPool );
+    }
+
     //! Get the gradient of the laplacian of potential.
     /*!
      * Returns the laplacian of the gravitational potential for the gravity field selected.
@@ -527,6 +555,9 @@ protected:
 
     //! Cache object for potential calculations.
     std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache_;
+
+    //! Object for computing the gradient at a list of positions (created upon first use).
+    std::shared_ptr< SphericalHarmonicsGradientCalculator > gradientCalculator_;
 };
 
 //! Function to determine a body's inertia tensor from its degree two unnormalized gravity field coefficients
@@ -25,6 +25,7 @@
 #include <Eigen/Geometry>
 
 #include "tudat/astro/basic_astro/accelerationModel.h"
+#include "tudat/astro/gravitation/sphericalHarmonicsGradientCalculator.h"
 #include "tudat/astro/gravitation/sphericalHarmonicsGravityModelBase.h"
 #include "tudat/math/basic/sphericalHarmonics.h"
 #include "tudat/astro/gravitation/sphericalHarmonicsGravityField.h"
@@ -109,7 +110,8 @@ public:
           rotationFromBodyFixedToIntegrationFrameFunction_(
               rotationFromBodyFixedToIntegrationFrameFunction ),
           sphericalHarmonicsCache_( sphericalHarmonicsCache ),
-          saveSphericalHarmonicTermsSeparately_( false )
+          saveSphericalHarmonicTermsSeparately_( false ),
+          gradientCalculator_( getCosineHarmonicsCoefficients( ), getSineHarmonicsCoefficients( ) )
     {
         maximumDegree_ = static_cast< int >( getCosineHarmonicsCoefficients( ).rows( ) ) - 1 ;
         maximumOrder_ = static_cast< int >( getCosineHarmonicsCoefficients( ).cols( ) )- 1 ;
@@ -170,7 +172,8 @@ public:
           getSineHarmonicsCoefficients( sineHarmonicCoefficientsFunction ),
           rotationFromBodyFixedToIntegrationFrameFunction_( rotationFromBodyFixedToIntegrationFrameFunction ),
           sphericalHarmonicsCache_( sphericalHarmonicsCache ),
-          saveSphericalHarmonicTermsSeparately_( false )
+          saveSphericalHarmonicTermsSeparately_( false ),
+          gradientCalculator_( getCosineHarmonicsCoefficients( ), getSineHarmonicsCoefficients( ) )
     {
         maximumDegree_ = static_cast< int >( getCosineHarmonicsCoefficients( ).rows( ) - 1 );
         maximumOrder_ = static_cast< int >( getCosineHarmonicsCoefficients( ).cols( ) - 1 );
@@ -217,17 +220,28 @@ public:
             currentRelativePosition_ = rotationToIntegrationFrame_.inverse( ) * (
                         currentInertialRelativePosition_ );
 
-            currentAcceleration_ =
-                    computeGeodesyNormalizedGravitationalAccelerationSum(
-                        currentRelativePosition_,
-                        gravitationalParameter,
-                        equatorialRadius,
-                        cosineHarmonicCoefficients,
-                        sineHarmonicCoefficients, sphericalHarmonicsCache_,
-                        accelerationPerTerm_,
-                        saveSphericalHarmonicTermsSeparately_,
-                        rotationToIntegrationFrame_.toRotationMatrix( ) );
-            currentAccelerationInBodyFixedFrame_ = rotationToIntegrationFrame_.inverse( ) * currentAcceleration_;
+            if( !saveSphericalHarmonicTermsSeparately_ )
+            {
+                // Use vectorized summation if separate terms are not required
+                gradientCalculator_.setCoefficients( cosineHarmonicCoefficients, sineHarmonicCoefficients );
+                currentAccelerationInBodyFixedFrame_ = gradientCalculator_.computeGradient(
+                            currentRelativePosition_, gravitationalParameter, equatorialRadius );
+                currentAcceleration_ = rotationToIntegrationFrame_ * currentAccelerationInBodyFixedFrame_;
+            }
+            else
+            {
+                currentAcceleration_ =
+                        computeGeodesyNormalizedGravitationalAccelerationSum(
+                            currentRelativePosition_,
+                            gravitationalParameter,
+                            equatorialRadius,
+                            cosineHarmonicCoefficients,
+                            sineHarmonicCoefficients, sphericalHarmonicsCache_,
+                            accelerationPerTerm_,
+                            saveSphericalHarmonicTermsSeparately_,
+                            rotationToIntegrationFrame_.toRotationMatrix( ) );
+                currentAccelerationInBodyFixedFrame_ = rotationToIntegrationFrame_.inverse( ) * currentAcceleration_;
+            }
 
             if ( this->updatePotential_ )
             {
@@ -540,6 +554,9 @@ private:
     //! Maximum order of gravity field expansion
     int maximumOrder_;
 
+    //! Object for (vectorized) computation of the acceleration, used when separate terms are not saved.
+    SphericalHarmonicsGradientCalculator gradientCalculator_;
+
 };
 
 
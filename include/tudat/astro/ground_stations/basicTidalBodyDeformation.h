@@ -20,6 +20,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 
 #include "tudat/astro/basic_astro/stateRepresentationConversions.h"
 #include "tudat/astro/ground_stations/bodyDeformationModel.h"
@@ -104,6 +105,9 @@ protected:
     std::vector< Eigen::Vector3d > relativeBodyStates_;
 
     std::vector< double > gravitationalParameterRatios_;
+
+    //! Mutex protecting the body properties set by updateBodyProperties, which are shared between threads
+    std::mutex bodyPropertiesMutex_;
 };
 
 } // namespace basic_astrodynamics
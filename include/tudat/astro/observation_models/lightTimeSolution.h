@@ -482,6 +482,92 @@ public:
         return lightTime;
     }
 
+    //! Function to calculate the light times and link-ends states for a list of (ordered) times.
+    /*!
+     *  Function to calculate the transmitter states at transmission time, the receiver states at reception time, and the
+     *  light times, for a list of times of a single link. The states of the reference link end (receiver if
+     *  isTimeAtReception is true, transmitter otherwise) are evaluated for all times before the light-time iterations
+     *  start. For each time after the first, the solution at the previous time(s) is used as initial guess of the light
+     *  time: it is linearly extrapolated from the two preceding solutions (or taken directly from the preceding solution
+     *  if these are not available, or if the time gap to the preceding time is large). For closely spaced times, this
+     *  typically reduces the number of iterations per time to the single iteration required to update the light-time
+     *  corrections. The resulting light times are identical to those of calculateLightTimeWithLinkEndsStates, up to the
+     *  convergence tolerance of the iteration.
+     *  \param receiverStatesOutput Output by reference of receiver states (one per time).
+     *  \param transmitterStatesOutput Output by reference of transmitter states (one per time).
+     *  \param times Times at reception or transmission (for efficiency, these should be sorted).
+     *  \param isTimeAtReception True if input times are at reception, false if at transmission.
+     *  \param ancillarySettings Settings for ancilliary observation information
+     *  \return The values of the light time between the reciever states and the transmitter states (one per time).
+     */
+    std::vector< ObservationScalarType > calculateLightTimesWithLinkEndsStates(
+            std::vector< StateType >& receiverStatesOutput,
+            std::vector< StateType >& transmitterStatesOutput,
+            const std::vector< TimeType >& times,
+            const bool isTimeAtReception = true,
+            const std::shared_ptr< ObservationAncilliarySimulationSettings > ancillarySettings = nullptr )
+    {
+        const unsigned int numberOfTimes = times.size( );
+        std::vector< ObservationScalarType > lightTimes( numberOfTimes );
+        receiverStatesOutput.resize( numberOfTimes );
+        transmitterStatesOutput.resize( numberOfTimes );
+
+        // Evaluate states of reference link end at all times in a single pass
+        std::vector< StateType > referenceLinkEndStates( numberOfTimes );
+        for( unsigned int i = 0; i < numberOfTimes; i++ )
+        {
+            referenceLinkEndStates[ i ] = isTimeAtReception ?
+                        stateFunctionOfReceivingBody_( times[ i ] ) : stateFunctionOfTransmittingBody_( times[ i ] );
+        }
+
+        std::vector< StateType > linkEndsStates( 2 );
+        std::vector< TimeType > linkEndsTimes( 2 );
+        for( unsigned int i = 0; i < numberOfTimes; i++ )
+        {
+            // Compute initial guess of light time
+            ObservationScalarType initialLightTimeGuess;
+            if( i == 0 )
+            {
+                currentCorrection_ = 0.0;
+                initialLightTimeGuess = isTimeAtReception ?
+                            calculateNewLightTimeEstimate(
+                                referenceLinkEndStates[ i ], stateFunctionOfTransmittingBody_( times[ i ] ) ) :
+                            calculateNewLightTimeEstimate(
+                                stateFunctionOfReceivingBody_( times[ i ] ), referenceLinkEndStates[ i ] );
+            }
+            else
+            {
+                initialLightTimeGuess = lightTimes[ i - 1 ];
+                if( i > 1 )
+                {
+                    ObservationScalarType currentTimeStep = static_cast< ObservationScalarType >( times[ i ] - times[ i - 1 ] );
+                    ObservationScalarType previousTimeStep =
+                            static_cast< ObservationScalarType >( times[ i - 1 ] - times[ i - 2 ] );
+                    if( previousTimeStep != 0.0 &&
+                            std::fabs( currentTimeStep ) <= 2.0 * std::fabs( previousTimeStep ) )
+                    {
+                        ObservationScalarType extrapolatedLightTime = lightTimes[ i - 1 ] +
+                                ( lightTimes[ i - 1 ] - lightTimes[ i - 2 ] ) * currentTimeStep / previousTimeStep;
+                        if( extrapolatedLightTime > 0.0 )
+                        {
+                            initialLightTimeGuess = extrapolatedLightTime;
+                        }
+                    }
+                }
+            }
+
+            // Iterate light time solution
+            lightTimes[ i ] = iterateLightTimeSolution(
+                        linkEndsStates, linkEndsTimes, times[ i ], isTimeAtReception, 0, initialLightTimeGuess,
+                        ancillarySettings, true, true, referenceLinkEndStates[ i ] );
+
+            transmitterStatesOutput[ i ] = linkEndsStates.at( 0 );
+            receiverStatesOutput[ i ] = linkEndsStates.at( 1 );
+        }
+
+        return lightTimes;
+    }
+
     //! Function to calculate the light time and link-ends states, given an initial guess for all legs.
     /*!
      *  Function to calculate the transmitter state at transmission time, the receiver state at
@@ -534,6 +620,111 @@ public:
             previousLightTimeCalculation = calculateNewLightTimeEstimate( receiverState, transmitterState );
         }
 
+        return iterateLightTimeSolution(
+                    linkEndsStates, linkEndsTimes, time, isTimeAtReception, currentMultiLegTransmitterIndex,
+                    previousLightTimeCalculation, ancillarySettings, computeLightTimeCorrections );
+    }
+
+    //! Function to get the part wrt linkend position
+    /*!
+     *  Function to get the part wrt linkend position
+     *  \param transmitterState State of transmitter.
+     *  \param receiverState State of receiver.
+     *  \param transmitterTime Time at transmission.
+     *  \param receiverTime Time at reiver.
+     *  \param isPartialWrtReceiver If partial is to be calculated w.r.t. receiver or transmitter.
+     */
+    Eigen::Matrix< ObservationScalarType, 1, 3 > getPartialOfLightTimeWrtLinkEndPosition(
+            const StateType& transmitterState,
+            const StateType& receiverState,
+            const TimeType transmitterTime,
+            const TimeType receiverTime,
+            const bool isPartialWrtReceiver,
+            const std::shared_ptr< observation_models::ObservationAncilliarySimulationSettings > ancillarySettings = nullptr )
+    {
+        setTotalLightTimeCorrection( transmitterState, receiverState, transmitterTime, receiverTime, ancillarySettings );
+
+        Eigen::Matrix< ObservationScalarType, 3, 1 > relativePosition =
+                receiverState.segment( 0, 3 ) - transmitterState.segment( 0, 3 );
+        return ( relativePosition.normalized( ) ).transpose( ) *
+                ( mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) +
+                  currentCorrection_ / relativePosition.norm( ) ) *
+                ( isPartialWrtReceiver ? mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) :
+                                         mathematical_constants::getFloatingInteger< ObservationScalarType >( -1 ) );
+    }
+
+    //! Function to get list of light-time correction functions
+    /*!
+     * Function to get list of light-time correction functions
+     * \return List of light-time correction functions
+     */
+    std::vector< std::shared_ptr< LightTimeCorrection > > getLightTimeCorrection( )
+    {
+        return correctionFunctions_;
+    }
+
+    //! Function to get the current ideal light time (distance divided by the speed of light)
+    ObservationScalarType getCurrentIdealLightTime( )
+    {
+        return currentIdealLightTime_;
+    }
+
+    //! Function to get the value of the current light time corrections
+    ObservationScalarType getCurrentLightTimeCorrection( )
+    {
+        return currentCorrection_;
+    }
+
+    unsigned int getNumberOfIterations( )
+    {
+        return iterationCounter_;
+    }
+
+    std::function< StateType( const TimeType ) > getStateFunctionOfTransmittingBody( )
+    {
+        return stateFunctionOfTransmittingBody_;
+    }
+
+    std::function< StateType( const TimeType ) > getStateFunctionOfReceivingBody( )
+    {
+        return stateFunctionOfReceivingBody_;
+    }
+
+protected:
+
+    //! Function to iterate the light time solution of a single leg, starting from a given initial guess.
+    /*!
+     *  Function to iterate the light time solution of a single leg, starting from a given initial guess of the light time
+     *  (including corrections). The state of the reference link end (the link end at which the time is fixed) may be
+     *  provided as input, in which case it is not recomputed from its state function.
+     *  \param linkEndsStates Output link end states over all legs of model.
+     *  \param linkEndsTimes Output link end times over all legs of model.
+     *  \param time Time at reception or transmission.
+     *  \param isTimeAtReception True if input time is at reception, false if at transmission.
+     *  \param currentMultiLegTransmitterIndex Index of current transmitter in multi-leg model
+     *  \param initialLightTimeGuess Initial guess of the light time.
+     *  \param ancillarySettings Settings for ancilliary observation information
+     *  \param computeLightTimeCorrections Boolean denoting whether light-time corrections are to be computed
+     *  \param useReferenceLinkEndState Boolean denoting whether referenceLinkEndState is to be used
+     *  \param referenceLinkEndState State of reference link end at input time (used only if useReferenceLinkEndState is true)
+     *  \return The value of the light time between the reciever state and the transmitter state.
+     */
+    ObservationScalarType iterateLightTimeSolution(
+            std::vector< StateType >& linkEndsStates,
+            std::vector< TimeType >& linkEndsTimes,
+            const TimeType time,
+            const bool isTimeAtReception,
+            const unsigned int currentMultiLegTransmitterIndex,
+            const ObservationScalarType initialLightTimeGuess,
+            const std::shared_ptr< ObservationAncilliarySimulationSettings > ancillarySettings,
+            const bool computeLightTimeCorrections,
+            const bool useReferenceLinkEndState = false,
+            const StateType& referenceLinkEndState = StateType::Zero( ) )
+    {
+        TimeType receptionTime = time, transmissionTime = time;
+        StateType receiverState, transmitterState;
+        ObservationScalarType previousLightTimeCalculation = initialLightTimeGuess;
+
         // Set value of transmission and reception times based on initial guess for light time
         if ( isTimeAtReception ) // reference time is at reception
         {
@@ -543,9 +734,24 @@ public:
         {
             receptionTime = transmissionTime + previousLightTimeCalculation;
         }
-        // Set receiver and transmitter states to initial guess
-        receiverState = stateFunctionOfReceivingBody_( receptionTime );
-        transmitterState = stateFunctionOfTransmittingBody_( transmissionTime );
+        // Set receiver and transmitter states to initial guess (using precomputed state of reference link end, if provided)
+        if( useReferenceLinkEndState && isTimeAtReception )
+        {
+            receiverState = referenceLinkEndState;
+        }
+        else
+        {
+            receiverState = stateFunctionOfReceivingBody_( receptionTime );
+        }
+
+        if( useReferenceLinkEndState && !isTimeAtReception )
+        {
+            transmitterState = referenceLinkEndState;
+        }
+        else
+        {
+            transmitterState = stateFunctionOfTransmittingBody_( transmissionTime );
+        }
 
         // Set variables for iteration of light time
         iterationCounter_ = 0;
@@ -623,73 +829,6 @@ public:
         return newLightTimeCalculation;
     }
 
-    //! Function to get the part wrt linkend position
-    /*!
-     *  Function to get the part wrt linkend position
-     *  \param transmitterState State of transmitter.
-     *  \param receiverState State of receiver.
-     *  \param transmitterTime Time at transmission.
-     *  \param receiverTime Time at reiver.
-     *  \param isPartialWrtReceiver If partial is to be calculated w.r.t. receiver or transmitter.
-     */
-    Eigen::Matrix< ObservationScalarType, 1, 3 > getPartialOfLightTimeWrtLinkEndPosition(
-            const StateType& transmitterState,
-            const StateType& receiverState,
-            const TimeType transmitterTime,
-            const TimeType receiverTime,
-            const bool isPartialWrtReceiver,
-            const std::shared_ptr< observation_models::ObservationAncilliarySimulationSettings > ancillarySettings = nullptr )
-    {
-        setTotalLightTimeCorrection( transmitterState, receiverState, transmitterTime, receiverTime, ancillarySettings );
-
-        Eigen::Matrix< ObservationScalarType, 3, 1 > relativePosition =
-                receiverState.segment( 0, 3 ) - transmitterState.segment( 0, 3 );
-        return ( relativePosition.normalized( ) ).transpose( ) *
-                ( mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) +
-                  currentCorrection_ / relativePosition.norm( ) ) *
-                ( isPartialWrtReceiver ? mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) :
-                                         mathematical_constants::getFloatingInteger< ObservationScalarType >( -1 ) );
-    }
-
-    //! Function to get list of light-time correction functions
-    /*!
-     * Function to get list of light-time correction functions
-     * \return List of light-time correction functions
-     */
-    std::vector< std::shared_ptr< LightTimeCorrection > > getLightTimeCorrection( )
-    {
-        return correctionFunctions_;
-    }
-
-    //! Function to get the current ideal light time (distance divided by the speed of light)
-    ObservationScalarType getCurrentIdealLightTime( )
-    {
-        return currentIdealLightTime_;
-    }
-
-    //! Function to get the value of the current light time corrections
-    ObservationScalarType getCurrentLightTimeCorrection( )
-    {
-        return currentCorrection_;
-    }
-
-    unsigned int getNumberOfIterations( )
-    {
-        return iterationCounter_;
-    }
-
-    std::function< StateType( const TimeType ) > getStateFunctionOfTransmittingBody( )
-    {
-        return stateFunctionOfTransmittingBody_;
-    }
-
-    std::function< StateType( const TimeType ) > getStateFunctionOfReceivingBody( )
-    {
-        return stateFunctionOfReceivingBody_;
-    }
-
-protected:
-
     //! Transmitter state function.
     /*!
      *  Transmitter state function.
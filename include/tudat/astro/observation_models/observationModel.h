@@ -418,6 +418,91 @@ public:
         }
     }
 
+    //! Function to compute the observable without any corrections, for a list of times.
+    /*!
+     *  Function to compute the observable without any corrections (see computeIdealObservationsWithLinkEndData),
+     *  for a list of times of the same link. By default, the single-time function is called for each time. This function
+     *  may be redefined in derived class to compute the observables more efficiently as a batch (e.g. by re-using the
+     *  solution at preceding times).
+     *  \param times Times at which observable is to be evaluated (for efficiency, these should be sorted).
+     *  \param linkEndAssociatedWithTime Link end at which given times are valid.
+     *  \param observations List of ideal observables (one per time, returned by reference).
+     *  \param linkEndTimes List of times at each link end during observation (one list per time, returned by reference).
+     *  \param linkEndStates List of states at each link end during observation (one list per time, returned by reference).
+     *  \param ancilliarySetings Settings for ancilliary observation information (identical for all times)
+     */
+    virtual void computeIdealObservationsWithLinkEndDataForTimes(
+            const std::vector< TimeType >& times,
+            const LinkEndType linkEndAssociatedWithTime,
+            std::vector< Eigen::Matrix< ObservationScalarType, ObservationSize, 1 > >& observations,
+            std::vector< std::vector< double > >& linkEndTimes,
+            std::vector< std::vector< Eigen::Matrix< double, 6, 1 > > >& linkEndStates,
+            const std::shared_ptr< ObservationAncilliarySimulationSettings > ancilliarySetings = nullptr )
+    {
+        observations.resize( times.size( ) );
+        linkEndTimes.resize( times.size( ) );
+        linkEndStates.resize( times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            observations[ i ] = computeIdealObservationsWithLinkEndData(
+                        times[ i ], linkEndAssociatedWithTime, linkEndTimes[ i ], linkEndStates[ i ], ancilliarySetings );
+        }
+    }
+
+    //! Function to compute full observations at a list of times.
+    /*!
+     *  Function to compute observations at a list of times of the same link (include any defined non-ideal corrections),
+     *  using the batch computation of the ideal observables.
+     *  \param times Times at which observations are to be simulated (for efficiency, these should be sorted).
+     *  \param linkEndAssociatedWithTime Link end at which current times are measured, i.e. reference
+     *  link end for observable.
+     *  \param observations List of observations (one per time, returned by reference).
+     *  \param linkEndTimes List of times at each link end during observation (one list per time, returned by reference).
+     *  \param linkEndStates List of states at each link end during observation (one list per time, returned by reference).
+     *  \param ancilliarySetings Settings for ancilliary observation information (identical for all times)
+     */
+    void computeObservationsWithLinkEndData(
+            const std::vector< TimeType >& times,
+            const LinkEndType linkEndAssociatedWithTime,
+            std::vector< Eigen::Matrix< ObservationScalarType, ObservationSize, 1 > >& observations,
+            std::vector< std::vector< double > >& linkEndTimes,
+            std::vector< std::vector< Eigen::Matrix< double, 6, 1 > > >& linkEndStates,
+            const std::shared_ptr< ObservationAncilliarySimulationSettings > ancilliarySetings = nullptr )
+    {
+        // Check if any non-ideal models are set.
+        if( isBiasNullptr_ )
+        {
+            computeIdealObservationsWithLinkEndDataForTimes(
+                        times, linkEndAssociatedWithTime, observations, linkEndTimes, linkEndStates, ancilliarySetings );
+        }
+        else
+        {
+            // Add time bias if necessary
+            std::vector< TimeType > observationTimes = times;
+            if( this->observationBiasCalculator_->getHasTimeBias( ) )
+            {
+                for( unsigned int i = 0; i < observationTimes.size( ); i++ )
+                {
+                    observationTimes[ i ] -= this->observationBiasCalculator_->getTimeBias(
+                                observationTimes[ i ], linkEndAssociatedWithTime );
+                }
+            }
+
+            // Compute ideal observables
+            computeIdealObservationsWithLinkEndDataForTimes(
+                        observationTimes, linkEndAssociatedWithTime, observations, linkEndTimes, linkEndStates,
+                        ancilliarySetings );
+
+            // Add corrections
+            for( unsigned int i = 0; i < observations.size( ); i++ )
+            {
+                observations[ i ] += this->observationBiasCalculator_->getObservationBias(
+                            linkEndTimes[ i ], linkEndStates[ i ], observations[ i ].template cast< double >( ) ).
+                        template cast< ObservationScalarType >( );
+            }
+        }
+    }
+
     //! Function to compute the observable without any corrections.
     /*!
      * Function to compute the observable without any corrections, i.e. the ideal physical observable as computed
@@ -564,58 +564,58 @@ public:
             throw std::runtime_error( "Error, calling one-way Doppler observable with ancilliary settings, but none are supported." );
         }
 
-        linkEndTimes.clear( );
-        linkEndStates.clear( );
-
-        // Save link end times and states
-        linkEndTimes.push_back( transmissionTime );
-        linkEndTimes.push_back( receptionTime );
-
-        linkEndStates.push_back( transmitterState_.template cast< double >( ) );
-        linkEndStates.push_back( receiverState_.template cast< double >( ) );
+        return ( Eigen::Matrix<  ObservationScalarType, 1, 1  >( ) << computeDopplerObservableFromLightTimeSolution(
+                     transmitterState_, receiverState_, transmissionTime, receptionTime,
+                     linkEndTimes, linkEndStates ) ).finished( );
+    }
 
-        // Compute transmitter and receiver proper time rate
-        ObservationScalarType transmitterProperTimeDifference =
-                mathematical_constants::getFloatingInteger< ObservationScalarType >( 0 );
-        if( transmitterProperTimeRateCalculator_ != nullptr )
+    //! Function to compute one-way Doppler observables without any corrections, for a list of times.
+    /*!
+     *  Function to compute one-way Doppler observables without any corrections, for a list of times. The light times are
+     *  computed as a batch by the light-time calculator, which uses the solution at the preceding times as initial guess.
+     *  \param times Times at which observable is to be evaluated (for efficiency, these should be sorted).
+     *  \param linkEndAssociatedWithTime Link end at which given times are valid.
+     *  \param observations List of ideal one-way Doppler observables (one per time, returned by reference).
+     *  \param linkEndTimes List of times at each link end during observation (one list per time, returned by reference).
+     *  \param linkEndStates List of states at each link end during observation (one list per time, returned by reference).
+     *  \param ancilliarySetings Settings for ancilliary observation information (none are supported)
+     */
+    void computeIdealObservationsWithLinkEndDataForTimes(
+            const std::vector< TimeType >& times,
+            const LinkEndType linkEndAssociatedWithTime,
+            std::vector< Eigen::Matrix< ObservationScalarType, 1, 1 > >& observations,
+            std::vector< std::vector< double > >& linkEndTimes,
+            std::vector< std::vector< Eigen::Matrix< double, 6, 1 > > >& linkEndStates,
+            const std::shared_ptr< ObservationAncilliarySimulationSettings > ancilliarySetings = nullptr )
+    {
+        if( linkEndAssociatedWithTime != receiver && linkEndAssociatedWithTime != transmitter )
         {
-            transmitterProperTimeDifference = static_cast< ObservationScalarType >(
-                        transmitterProperTimeRateCalculator_->getOberverProperTimeDeviation(
-                        linkEndTimes, linkEndStates ) );
+            throw std::runtime_error(
+                        "Error when calculating one way Doppler observation, link end is not transmitter or receiver" );
         }
-        ObservationScalarType receiverProperTimeDifference =
-                mathematical_constants::getFloatingInteger< ObservationScalarType >( 0 );
-        if( receiverProperTimeRateCalculator_ != nullptr )
+
+        if( ancilliarySetings != nullptr )
         {
-            receiverProperTimeDifference =  static_cast< ObservationScalarType >(
-                        receiverProperTimeRateCalculator_->getOberverProperTimeDeviation(
-                        linkEndTimes, linkEndStates ) );
+            throw std::runtime_error( "Error, calling one-way Doppler observable with ancilliary settings, but none are supported." );
         }
+        const bool isTimeAtReception = ( linkEndAssociatedWithTime == receiver );
 
-        // Compute proper time correction term
-        ObservationScalarType properTimeCorrectionTerm =
-                computeDopplerProperTimeInfluenceTaylorSeriesExpansion(
-                    transmitterProperTimeDifference, receiverProperTimeDifference, taylorSeriesExpansionOrder_ );
-
-        // Compute first-order (geometrical) one-way Doppler contribution
-        lightTimePartialWrtReceiverPosition_ =
-                lightTimeCalculator_->getPartialOfLightTimeWrtLinkEndPosition(
-                    transmitterState_, receiverState_, transmissionTime, receptionTime, true );
-        lightTimePartialWrtTransmitterPosition_ =
-                lightTimeCalculator_->getPartialOfLightTimeWrtLinkEndPosition(
-                    transmitterState_, receiverState_, transmissionTime, receptionTime, false );
-        ObservationScalarType firstOrderDopplerObservable =
-                computeOneWayFirstOrderDopplerTaylorSeriesExpansion<
-                ObservationScalarType >(
-                    transmitterState_, receiverState_,
-                    lightTimePartialWrtTransmitterPosition_, lightTimePartialWrtReceiverPosition_,
-                    taylorSeriesExpansionOrder_ );
+        // Compute light times for all times
+        std::vector< ObservationScalarType > lightTimes = lightTimeCalculator_->calculateLightTimesWithLinkEndsStates(
+                    receiverStates_, transmitterStates_, times, isTimeAtReception, ancilliarySetings );
 
-        // Compute full Doppler observable and return
-        ObservationScalarType totalDopplerObservable = firstOrderDopplerObservable *
-                ( mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) + properTimeCorrectionTerm ) +
-                properTimeCorrectionTerm;
-        return ( Eigen::Matrix<  ObservationScalarType, 1, 1  >( ) << multiplicationTerm_ * totalDopplerObservable ).finished( );
+        // Compute Doppler observables from light-time solutions
+        observations.resize( times.size( ) );
+        linkEndTimes.resize( times.size( ) );
+        linkEndStates.resize( times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            observations[ i ]( 0 ) = computeDopplerObservableFromLightTimeSolution(
+                        transmitterStates_[ i ], receiverStates_[ i ],
+                        isTimeAtReception ? times[ i ] - lightTimes[ i ] : times[ i ],
+                        isTimeAtReception ? times[ i ] : times[ i ] + lightTimes[ i ],
+                        linkEndTimes[ i ], linkEndStates[ i ] );
+        }
     }
 
     //! Function to return the object to calculate light time.
@@ -666,6 +666,80 @@ public:
 
 private:
 
+    //! Function to compute the one-way Doppler observable from the solution of the light-time equation.
+    /*!
+     *  Function to compute the one-way Doppler observable from the solution of the light-time equation, and to set the
+     *  link end times and states.
+     *  \param transmitterState State of transmitter at transmission time
+     *  \param receiverState State of receiver at reception time
+     *  \param transmissionTime Time at transmission
+     *  \param receptionTime Time at reception
+     *  \param linkEndTimes List of times at each link end during observation (returned by reference).
+     *  \param linkEndStates List of states at each link end during observation (returned by reference).
+     *  \return Ideal one-way Doppler observable.
+     */
+    ObservationScalarType computeDopplerObservableFromLightTimeSolution(
+            StateType& transmitterState,
+            StateType& receiverState,
+            const TimeType transmissionTime,
+            const TimeType receptionTime,
+            std::vector< double >& linkEndTimes,
+            std::vector< Eigen::Matrix< double, 6, 1 > >& linkEndStates )
+    {
+        linkEndTimes.clear( );
+        linkEndStates.clear( );
+
+        // Save link end times and states
+        linkEndTimes.push_back( transmissionTime );
+        linkEndTimes.push_back( receptionTime );
+
+        linkEndStates.push_back( transmitterState.template cast< double >( ) );
+        linkEndStates.push_back( receiverState.template cast< double >( ) );
+
+        // Compute transmitter and receiver proper time rate
+        ObservationScalarType transmitterProperTimeDifference =
+                mathematical_constants::getFloatingInteger< ObservationScalarType >( 0 );
+        if( transmitterProperTimeRateCalculator_ != nullptr )
+        {
+            transmitterProperTimeDifference = static_cast< ObservationScalarType >(
+                        transmitterProperTimeRateCalculator_->getOberverProperTimeDeviation(
+                        linkEndTimes, linkEndStates ) );
+        }
+        ObservationScalarType receiverProperTimeDifference =
+                mathematical_constants::getFloatingInteger< ObservationScalarType >( 0 );
+        if( receiverProperTimeRateCalculator_ != nullptr )
+        {
+            receiverProperTimeDifference =  static_cast< ObservationScalarType >(
+                        receiverProperTimeRateCalculator_->getOberverProperTimeDeviation(
+                        linkEndTimes, linkEndStates ) );
+        }
+
+        // Compute proper time correction term
+        ObservationScalarType properTimeCorrectionTerm =
+                computeDopplerProperTimeInfluenceTaylorSeriesExpansion(
+                    transmitterProperTimeDifference, receiverProperTimeDifference, taylorSeriesExpansionOrder_ );
+
+        // Compute first-order (geometrical) one-way Doppler contribution
+        lightTimePartialWrtReceiverPosition_ =
+                lightTimeCalculator_->getPartialOfLightTimeWrtLinkEndPosition(
+                    transmitterState, receiverState, transmissionTime, receptionTime, true );
+        lightTimePartialWrtTransmitterPosition_ =
+                lightTimeCalculator_->getPartialOfLightTimeWrtLinkEndPosition(
+                    transmitterState, receiverState, transmissionTime, receptionTime, false );
+        ObservationScalarType firstOrderDopplerObservable =
+                computeOneWayFirstOrderDopplerTaylorSeriesExpansion<
+                ObservationScalarType >(
+                    transmitterState, receiverState,
+                    lightTimePartialWrtTransmitterPosition_, lightTimePartialWrtReceiverPosition_,
+                    taylorSeriesExpansionOrder_ );
+
+        // Compute full Doppler observable and return
+        ObservationScalarType totalDopplerObservable = firstOrderDopplerObservable *
+                ( mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) + properTimeCorrectionTerm ) +
+                properTimeCorrectionTerm;
+        return multiplicationTerm_ * totalDopplerObservable;
+    }
+
     //! Object to calculate light time, including possible corrections from troposphere, relativistic corrections, etc.
     std::shared_ptr< observation_models::LightTimeCalculator< ObservationScalarType, TimeType > > lightTimeCalculator_;
 
@@ -681,6 +755,12 @@ private:
     //! Pre-declared transmitter state, to prevent many (de-)allocations
     StateType transmitterState_;
 
+    //! Pre-declared receiver states for batch computation, to prevent many (de-)allocations
+    std::vector< StateType > receiverStates_;
+
+    //! Pre-declared transmitter states for batch computation, to prevent many (de-)allocations
+    std::vector< StateType > transmitterStates_;
+
     //! Object to compute derivative of deviation between proper and coordinate time at transmitter, w.r.t. coordinate time.
     std::shared_ptr< DopplerProperTimeRateInterface > transmitterProperTimeRateCalculator_;
 
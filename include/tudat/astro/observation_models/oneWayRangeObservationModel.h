@@ -131,6 +131,60 @@ public:
         return ( Eigen::Matrix< ObservationScalarType, 1, 1 >( ) << observation ).finished( );
     }
 
+    //! Function to compute one-way range observables without any corrections, for a list of times.
+    /*!
+     *  Function to compute one-way range observables without any corrections, for a list of times. The light times are
+     *  computed as a batch by the light-time calculator, which uses the solution at the preceding times as initial guess.
+     *  \param times Times at which observable is to be evaluated (for efficiency, these should be sorted).
+     *  \param linkEndAssociatedWithTime Link end at which given times are valid.
+     *  \param observations List of ideal one-way range observables (one per time, returned by reference).
+     *  \param linkEndTimes List of times at each link end during observation (one list per time, returned by reference).
+     *  \param linkEndStates List of states at each link end during observation (one list per time, returned by reference).
+     *  \param ancilliarySetings Settings for ancilliary observation information (none are supported)
+     */
+    void computeIdealObservationsWithLinkEndDataForTimes(
+            const std::vector< TimeType >& times,
+            const LinkEndType linkEndAssociatedWithTime,
+            std::vector< Eigen::Matrix< ObservationScalarType, 1, 1 > >& observations,
+            std::vector< std::vector< double > >& linkEndTimes,
+            std::vector< std::vector< Eigen::Matrix< double, 6, 1 > > >& linkEndStates,
+            const std::shared_ptr< ObservationAncilliarySimulationSettings > ancilliarySetings = nullptr )
+    {
+        if( ancilliarySetings != nullptr )
+        {
+            throw std::runtime_error( "Error, calling one-way range observable with ancilliary settings, but none are supported." );
+        }
+
+        if( linkEndAssociatedWithTime != receiver && linkEndAssociatedWithTime != transmitter )
+        {
+            std::string errorMessage = "Error, cannot have link end type: " +
+                    std::to_string( linkEndAssociatedWithTime ) + "for one-way range";
+            throw std::runtime_error( errorMessage );
+        }
+        const bool isTimeAtReception = ( linkEndAssociatedWithTime == receiver );
+
+        // Compute light times for all times
+        std::vector< ObservationScalarType > lightTimes = lightTimeCalculator_->calculateLightTimesWithLinkEndsStates(
+                    receiverStates_, transmitterStates_, times, isTimeAtReception, ancilliarySetings );
+
+        // Convert light times to range, and set link end states and times.
+        observations.resize( times.size( ) );
+        linkEndTimes.resize( times.size( ) );
+        linkEndStates.resize( times.size( ) );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            observations[ i ]( 0 ) = lightTimes[ i ] * physical_constants::getSpeedOfLight< ObservationScalarType >( );
+
+            linkEndTimes[ i ].resize( 2 );
+            linkEndTimes[ i ][ 0 ] = static_cast< double >( isTimeAtReception ? times[ i ] - lightTimes[ i ] : times[ i ] );
+            linkEndTimes[ i ][ 1 ] = static_cast< double >( isTimeAtReception ? times[ i ] : times[ i ] + lightTimes[ i ] );
+
+            linkEndStates[ i ].resize( 2 );
+            linkEndStates[ i ][ 0 ] = transmitterStates_[ i ].template cast< double >( );
+            linkEndStates[ i ][ 1 ] = receiverStates_[ i ].template cast< double >( );
+        }
+    }
+
     //! Function to get the object to calculate light time.
     /*!
      * Function to get the object to calculate light time.
@@ -157,6 +211,12 @@ private:
     //! Pre-declared transmitter state, to prevent many (de-)allocations
     StateType transmitterState;
 
+    //! Pre-declared receiver states for batch computation, to prevent many (de-)allocations
+    std::vector< StateType > receiverStates_;
+
+    //! Pre-declared transmitter states for batch computation, to prevent many (de-)allocations
+    std::vector< StateType > transmitterStates_;
+
 };
 
 } // namespace observation_models
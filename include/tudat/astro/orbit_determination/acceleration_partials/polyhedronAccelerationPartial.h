@@ -252,6 +252,13 @@ private:
      */
     std::function< void( const double ) > updateFunction_;
 
+    //! Function to update the polyhedron cache of the acceleration model to the current state.
+    /*!
+     *  Function to update the polyhedron cache of the acceleration model to the current state, which is not done when
+     *  computing the acceleration if the acceleration model uses a facet tree.
+     */
+    std::function< void( ) > updatePolyhedronCacheFunction_;
+
     //! Map of RotationMatrixPartial, one for each relevant rotation parameter
     /*!
      *  Map of RotationMatrixPartial, one for each parameter representing a property of the rotation of the
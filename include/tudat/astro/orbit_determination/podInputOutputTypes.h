@@ -46,7 +46,8 @@ public:
         reintegrateEquationsOnFirstIteration_( true ),
         reintegrateVariationalEquations_( true ),
         saveDesignMatrix_( true ),
-        printOutput_( true )
+        printOutput_( true ),
+        numberOfThreads_( 1 )
     {
         weightsMatrixDiagonals_ = Eigen::VectorXd::Zero( observationCollection->getTotalObservableSize( ) );
         setConstantWeightsMatrix( 1.0 );
@@ -493,6 +494,27 @@ public:
         return printOutput_;
     }
 
+    //! Function to set the number of threads used to compute the observations and partials.
+    /*!
+     * Function to set the number of threads used to compute the observations and partials (a value of 0 denotes that the
+     * number of available hardware threads is to be used).
+     * \param numberOfThreads Number of threads used to compute the observations and partials.
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
+    //! Function to return the number of threads used to compute the observations and partials.
+    /*!
+     * Function to return the number of threads used to compute the observations and partials.
+     * \return Number of threads used to compute the observations and partials.
+     */
+    unsigned int getNumberOfThreads( )
+    {
+        return numberOfThreads_;
+    }
+
     void defineCovarianceSettings( const bool reintegrateEquationsOnFirstIteration = 1,
                                    const bool reintegrateVariationalEquations = 1,
                                    const bool saveDesignMatrix = 1,
@@ -540,6 +562,9 @@ protected:
     //! Boolean denoting whether to print output to th terminal when running the estimation.
     bool printOutput_;
 
+    //! Number of threads used to compute the observations and partials (0 denotes number of available hardware threads).
+    unsigned int numberOfThreads_;
+
     //! Boolean denoting whether consider parameters are included in the covariance analysis
     bool considerParametersIncluded_;
 };
@@ -652,7 +677,8 @@ public:
         convergenceChecker_( convergenceChecker ),
         considerParametersDeviations_( considerParametersDeviations ),
         conditionNumberWarningEachIteration_( true ),
-        applyFinalParameterCorrection_( applyFinalParameterCorrection )
+        applyFinalParameterCorrection_( applyFinalParameterCorrection ),
+        useBlockSparseNormalEquations_( false )
 
     {
         if ( this->areConsiderParametersIncluded( ) )
@@ -748,6 +774,31 @@ public:
         return saveStateHistoryForEachIteration_;
     }
 
+    //! Function to set whether the estimation is to use block-sparse (arc-wise) normal equations.
+    /*!
+     * Function to set whether the estimation is to use block-sparse (arc-wise) normal equations. If true, the contribution
+     * of each set of observations is accumulated directly into normal equations with a block-arrowhead structure (arc-wise
+     * initial states and global parameters), without storing the full design matrix, and the normal equations are solved
+     * by Schur complement reduction over the arc-wise initial states (see linear_algebra::BlockArrowheadNormalEquations).
+     * This reduces memory use and computation time for multi-arc estimations with many arcs. It requires that no consider
+     * parameters and no constraints are used, and the design matrix is not saved in the output.
+     * \param useBlockSparseNormalEquations Boolean denoting whether to use block-sparse normal equations.
+     */
+    void setUseBlockSparseNormalEquations( const bool useBlockSparseNormalEquations )
+    {
+        useBlockSparseNormalEquations_ = useBlockSparseNormalEquations;
+    }
+
+    //! Function to return whether the estimation is to use block-sparse (arc-wise) normal equations.
+    /*!
+     * Function to return whether the estimation is to use block-sparse (arc-wise) normal equations.
+     * \return Boolean denoting whether to use block-sparse normal equations.
+     */
+    bool getUseBlockSparseNormalEquations( )
+    {
+        return useBlockSparseNormalEquations_;
+    }
+
     //! Boolean denoting whether the residuals and parameters from the each iteration are to be saved
     bool saveResidualsAndParametersFromEachIteration_;
 
@@ -763,6 +814,8 @@ public:
 
     bool applyFinalParameterCorrection_;
 
+    //! Boolean denoting whether the estimation is to use block-sparse (arc-wise) normal equations.
+    bool useBlockSparseNormalEquations_;
 
 };
 
@@ -23,6 +23,7 @@
 #include <Eigen/Core>
 
 #include "tudat/astro/basic_astro/torqueModelTypes.h"
+#include "tudat/basics/contiguousStateHistory.h"
 #include "tudat/astro/propagators/bodyMassStateDerivative.h"
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
 #include "tudat/astro/propagators/nBodyStateDerivative.h"
@@ -129,6 +130,25 @@ public:
                     Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
                         conventionalStateTypeSize_.at( stateDerivativeModels.at( i )->getIntegratedStateType( )  ), 1 );
         }
+
+        // Flatten state derivative models (in order of iteration over stateDerivativeModels_), with their indices in the
+        // propagated state, for use when evaluating the state derivative.
+        for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+             stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+             stateDerivativeModelsIterator_++ )
+        {
+            for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+            {
+                stateDerivativeModelList_.push_back( stateDerivativeModelsIterator_->second.at( i ) );
+                stateDerivativeModelPropagatedStateIndices_.push_back(
+                            propagatedStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i ) );
+                stateDerivativeModelPropagatedStates_.push_back(
+                            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
+                                stateDerivativeModelPropagatedStateIndices_.back( ).second ) );
+            }
+        }
+        stateDerivativeModelUpdateProfilerEntries_.assign( stateDerivativeModelList_.size( ), -1 );
+        stateDerivativeModelEvaluationProfilerEntries_.assign( stateDerivativeModelList_.size( ), -1 );
     }
 
 
@@ -145,109 +165,27 @@ public:
      */
     StateType computeStateDerivative( const TimeType time, const StateType& state )
     {
-
-        if( !( time == time ) )
-        {
-            throw std::invalid_argument( "Error when computing system state derivative. Input time is NaN" );
-        }
-
-        if( state.hasNaN( ) )
-        {
-            std::cout<<"State with NaN "<<std::endl<<state<<std::endl;
-            throw std::invalid_argument( "Error when computing system state derivative. State vector contains NaN" );
-        }
-
-        if( !state.allFinite( ) )
-        {
-            throw std::invalid_argument( "Error when computing system state derivative. State vector contains Inf" );
-        }
-
-        // Initialize state derivative
-        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
-        {
-            stateDerivative_.resize( state.rows( ), state.cols( ) );
-        }
-
-        // If dynamical equations are integrated, update the environment with the current state.
-        if( evaluateDynamicsEquations_ )
-        {
-            // Iterate over all types of equations.
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    stateDerivativeModelsIterator_->second.at( i )->clearStateDerivativeModel( );
-                }
-            }
-
-            convertCurrentStateToGlobalRepresentationPerType( state, time, evaluateVariationalEquations_ );
-            environmentUpdateFunction_( time, currentStatesPerTypeInConventionalRepresentation_,
-                                        integratedStatesFromEnvironment_ );
-        }
-        else
-        {
-            environmentUpdateFunction_(
-                        time, std::unordered_map<
-                        IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( ),
-                        integratedStatesFromEnvironment_ );
-
-        }
-
-        if( evaluateVariationalEquations_ )
-        {
-            variationalEquations_->clearPartials( );
-        }
-
-        // If dynamical equations are integrated, evaluate dynamics state derivatives.
-        std::pair< int, int > currentIndices;
-        if( evaluateDynamicsEquations_ )
-        {
-            // Iterate over all types of equations.
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    // Update state derivative models
-                    stateDerivativeModelsIterator_->second.at( i )->updateStateDerivativeModel( time );
-                }
-            }
-
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    // Evaluate and set current dynamical state derivative
-                    currentIndices = propagatedStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
-
-                    stateDerivativeModelsIterator_->second.at( i )->calculateSystemStateDerivative(
-                                time, state.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ),
-                                stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
-                }
-            }
-        }
-
-        // If variational equations are to be integrated: evaluate and set.
-        if( evaluateVariationalEquations_ )
-        {
-            variationalEquations_->updatePartials( time, currentStatesPerTypeInConventionalRepresentation_ );
-
-            variationalEquations_->evaluateVariationalEquations< StateScalarType >(
-                        time, state.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ),
-                        stateDerivative_.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ) );
-        }
-
-        // Update counters
-        functionEvaluationCounter_++;
-        cumulativeFunctionEvaluationCounter_[ time ] = functionEvaluationCounter_;
-
+        updateStateDerivative( time, state );
         return stateDerivative_;
+    }
 
+    //! Function to calculate the system state derivative for a state of fixed size.
+    /*!
+     *  Function to calculate the system state derivative for a state of fixed size, for use when numerically integrating
+     *  the dynamics with fixed-size state types (single column, dynamics only). The state is copied into a pre-allocated
+     *  member, so that (in contrast to computeStateDerivative) no memory is allocated on the heap during the call.
+     *  \sa computeStateDerivative
+     *  \param time Current time.
+     *  \param state Current complete state.
+     *  \return Calculated state derivative.
+     */
+    template< int NumberOfRows >
+    Eigen::Matrix< StateScalarType, NumberOfRows, 1 > computeFixedSizeStateDerivative(
+            const TimeType time, const Eigen::Matrix< StateScalarType, NumberOfRows, 1 >& state )
+    {
+        fixedSizeState_ = state;
+        updateStateDerivative( time, fixedSizeState_ );
+        return stateDerivative_;
     }
 
     //! Function to calculate the system state derivative with double precision, regardless of template arguments.
@@ -371,6 +309,33 @@ public:
         }
     }
 
+    //! Function to convert a contiguous state history from propagator-specific form to the conventional form.
+    /*!
+     * Function to convert a contiguous state history from propagator-specific form to the conventional form
+     * (not necessarily in inertial frame).
+     * \sa DynamicsStateDerivativeModel::convertToOutputSolution
+     * \param convertedSolution State history (rawSolution), converted to the 'conventional form' (by reference)
+     * \param rawSolution State history in propagator-specific form (i.e. form that is used in
+     *        numerical integration).
+     */
+    void convertNumericalStateSolutionsToOutputSolutions(
+            utilities::ContiguousStateHistory< TimeType, StateScalarType >& convertedSolution,
+            const utilities::ContiguousStateHistory< TimeType, StateScalarType >& rawSolution )
+    {
+        convertedSolution.clear( );
+        convertedSolution.reserve( rawSolution.size( ) );
+
+        // Iterate over all times.
+        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentRawState;
+        for( unsigned int i = 0; i < rawSolution.size( ); i++ )
+        {
+            // Convert solution at this time to output (Cartesian with propagation origin frame for
+            // translational dynamics) solution
+            currentRawState = rawSolution.getEntry( i );
+            convertedSolution.addEntry( rawSolution.getTime( i ), convertToOutputSolution( currentRawState, rawSolution.getTime( i ) ) );
+        }
+    }
+
     //! Function to process the state vector during propagation.
     /*!
      * Function to process the state vector during propagation.
@@ -585,7 +550,13 @@ public:
      */
     std::map< TimeType, unsigned int > getCumulativeNumberOfFunctionEvaluations( )
     {
-        return cumulativeFunctionEvaluationCounter_;
+        std::map< TimeType, unsigned int > cumulativeNumberOfFunctionEvaluations;
+        for( unsigned int i = 0; i < cumulativeFunctionEvaluationCounter_.size( ); i++ )
+        {
+            cumulativeNumberOfFunctionEvaluations[ cumulativeFunctionEvaluationCounter_[ i ].first ] =
+                    cumulativeFunctionEvaluationCounter_[ i ].second;
+        }
+        return cumulativeNumberOfFunctionEvaluations;
     }
 
     //! Function to reset the number of calls to the computeStateDerivative function to zero.
@@ -608,9 +579,194 @@ public:
         return variationalEquations_;
     }
 
+    //! Function to set the number of threads over which independent acceleration models are updated.
+    /*!
+     * Function to set the number of threads over which independent acceleration models are updated during each state
+     * derivative evaluation. The acceleration models of the translational dynamics are divided into groups that do not share
+     * any modified objects (see getIndependentAccelerationUpdateGroups), which are updated concurrently on a persistent
+     * thread pool, after the environment has been updated. The resulting state derivative is identical to that of a
+     * sequential update. Since the threads synchronize twice per state derivative evaluation, this is only beneficial if
+     * the update of the acceleration models is computationally expensive (e.g. high-degree gravity fields, paneled
+     * radiation pressure), and the dynamics cannot be parallelized otherwise (e.g. propagation of a single body).
+     * \param numberOfThreads Total number of threads used to update the acceleration models (if 0, the number of
+     * available hardware threads is used; if 1, acceleration models are updated sequentially).
+     */
+    void setNumberOfThreadsForAccelerationUpdates( const unsigned int numberOfThreads )
+    {
+        if( numberOfThreads == 1 )
+        {
+            accelerationUpdateThreadPool_ = nullptr;
+        }
+        else
+        {
+            accelerationUpdateThreadPool_ = std::make_shared< utilities::ThreadPool >( numberOfThreads );
+        }
+
+        if( stateDerivativeModels_.count( translational_state ) > 0 )
+        {
+            for( unsigned int i = 0; i < stateDerivativeModels_.at( translational_state ).size( ); i++ )
+            {
+                std::dynamic_pointer_cast< NBodyStateDerivative< StateScalarType, TimeType > >(
+                            stateDerivativeModels_.at( translational_state ).at( i ) )->setAccelerationUpdateThreadPool(
+                            accelerationUpdateThreadPool_ );
+            }
+        }
+    }
+
+    //! Function to set the profiler used to time the parts of the state derivative computation.
+    /*!
+     * Function to set the profiler used to time the parts of the state derivative computation. An entry (in category
+     * propagation) is added for the complete state derivative computation, and entries (in category state_derivative) for
+     * the conversion of the state, the environment update, the update and evaluation of each state derivative model, and the
+     * variational equations. The profiler is also set in the state derivative models, which add an entry for each of their
+     * acceleration/torque models (see SingleStateTypeDerivative::setProfiler). Note that the environment updates are
+     * timed per model only if the profiler is also set in the EnvironmentUpdater.
+     * \param profiler Profiler used to time the state derivative computation (no timing if nullptr).
+     */
+    void setProfiler( const std::shared_ptr< utilities::TimingProfiler > profiler )
+    {
+        profiler_ = profiler;
+        stateDerivativeModelUpdateProfilerEntries_.assign( stateDerivativeModelList_.size( ), -1 );
+        stateDerivativeModelEvaluationProfilerEntries_.assign( stateDerivativeModelList_.size( ), -1 );
+        if( profiler_ != nullptr )
+        {
+            totalProfilerEntry_ = profiler_->addEntry( "propagation", "state derivative" );
+            stateConversionProfilerEntry_ = profiler_->addEntry( "state_derivative", "state conversion" );
+            environmentUpdateProfilerEntry_ = profiler_->addEntry( "state_derivative", "environment update" );
+            for( unsigned int i = 0; i < stateDerivativeModelList_.size( ); i++ )
+            {
+                std::string stateTypeName = getIntegratedStateTypString(
+                            stateDerivativeModelList_[ i ]->getIntegratedStateType( ) );
+                stateDerivativeModelUpdateProfilerEntries_[ i ] =
+                        profiler_->addEntry( "state_derivative", stateTypeName + " model update" );
+                stateDerivativeModelEvaluationProfilerEntries_[ i ] =
+                        profiler_->addEntry( "state_derivative", stateTypeName + " state derivative" );
+            }
+            variationalEquationsProfilerEntry_ = profiler_->addEntry( "state_derivative", "variational equations" );
+        }
+
+        for( unsigned int i = 0; i < stateDerivativeModelList_.size( ); i++ )
+        {
+            stateDerivativeModelList_[ i ]->setProfiler( profiler_ );
+        }
+    }
+
+    //! Function to retrieve the profiler used to time the parts of the state derivative computation.
+    std::shared_ptr< utilities::TimingProfiler > getProfiler( )
+    {
+        return profiler_;
+    }
+
 
 private:
 
+    //! Function to calculate the system state derivative, and set it in the stateDerivative_ member
+    /*!
+     *  Function to calculate the system state derivative, and set it in the stateDerivative_ member.
+     *  \sa computeStateDerivative
+     *  \param time Current time.
+     *  \param state Current complete state.
+     */
+    void updateStateDerivative( const TimeType time, const StateType& state )
+    {
+        utilities::ScopedTimingMeasurement totalTimingMeasurement( profiler_.get( ), totalProfilerEntry_ );
+
+        if( !( time == time ) )
+        {
+            throw std::invalid_argument( "Error when computing system state derivative. Input time is NaN" );
+        }
+
+        if( state.hasNaN( ) )
+        {
+            std::cout<<"State with NaN "<<std::endl<<state<<std::endl;
+            throw std::invalid_argument( "Error when computing system state derivative. State vector contains NaN" );
+        }
+
+        if( !state.allFinite( ) )
+        {
+            throw std::invalid_argument( "Error when computing system state derivative. State vector contains Inf" );
+        }
+
+        // Initialize state derivative
+        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
+        {
+            stateDerivative_.resize( state.rows( ), state.cols( ) );
+        }
+
+        // If dynamical equations are integrated, update the environment with the current state.
+        if( evaluateDynamicsEquations_ )
+        {
+            // Iterate over all types of equations.
+            for( unsigned int i = 0; i < stateDerivativeModelList_.size( ); i++ )
+            {
+                stateDerivativeModelList_[ i ]->clearStateDerivativeModel( );
+            }
+
+            {
+                utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), stateConversionProfilerEntry_ );
+                convertCurrentStateToGlobalRepresentationPerType( state, time, evaluateVariationalEquations_ );
+            }
+
+            utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), environmentUpdateProfilerEntry_ );
+            environmentUpdateFunction_( time, currentStatesPerTypeInConventionalRepresentation_,
+                                        integratedStatesFromEnvironment_ );
+        }
+        else
+        {
+            utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), environmentUpdateProfilerEntry_ );
+            environmentUpdateFunction_(
+                        time, std::unordered_map<
+                        IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( ),
+                        integratedStatesFromEnvironment_ );
+
+        }
+
+        if( evaluateVariationalEquations_ )
+        {
+            variationalEquations_->clearPartials( );
+        }
+
+        // If dynamical equations are integrated, evaluate dynamics state derivatives.
+        if( evaluateDynamicsEquations_ )
+        {
+            // Update state derivative models
+            for( unsigned int i = 0; i < stateDerivativeModelList_.size( ); i++ )
+            {
+                utilities::ScopedTimingMeasurement timingMeasurement(
+                            profiler_.get( ), stateDerivativeModelUpdateProfilerEntries_[ i ] );
+                stateDerivativeModelList_[ i ]->updateStateDerivativeModel( time );
+            }
+
+            // Evaluate and set current dynamical state derivative
+            for( unsigned int i = 0; i < stateDerivativeModelList_.size( ); i++ )
+            {
+                utilities::ScopedTimingMeasurement timingMeasurement(
+                            profiler_.get( ), stateDerivativeModelEvaluationProfilerEntries_[ i ] );
+                const std::pair< int, int >& currentIndices = stateDerivativeModelPropagatedStateIndices_[ i ];
+                stateDerivativeModelPropagatedStates_[ i ] =
+                        state.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 );
+                stateDerivativeModelList_[ i ]->calculateSystemStateDerivative(
+                            time, stateDerivativeModelPropagatedStates_[ i ],
+                            stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
+            }
+        }
+
+        // If variational equations are to be integrated: evaluate and set.
+        if( evaluateVariationalEquations_ )
+        {
+            utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), variationalEquationsProfilerEntry_ );
+            variationalEquations_->updatePartials( time, currentStatesPerTypeInConventionalRepresentation_ );
+
+            variationalEquations_->evaluateVariationalEquations< StateScalarType >(
+                        time, state.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ),
+                        stateDerivative_.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ) );
+        }
+
+        // Update counters
+        functionEvaluationCounter_++;
+        cumulativeFunctionEvaluationCounter_.push_back( std::make_pair( time, functionEvaluationCounter_ ) );
+    }
+
     //! Function to convert the to the conventional form in the global frame per dynamics type.
     /*!
      * Function to convert the propagator-specific form of the state to the conventional form in the global frame, split
@@ -640,7 +796,8 @@ private:
 
         std::pair< int, int > currentPropagatedIndices, currentConventionalIndices;
 
-        // Iterate over all state derivative models
+        // Iterate over all state derivative models (in same order as stateDerivativeModelList_)
+        int currentModelIndex = 0;
         for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
              stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
              stateDerivativeModelsIterator_++ )
@@ -655,12 +812,14 @@ private:
                 currentConventionalIndices = conventionalStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
 
                 // Set current block in split state (in global form)
+                stateDerivativeModelPropagatedStates_[ currentModelIndex ] =
+                        state.block( currentPropagatedIndices.first, startColumn, currentPropagatedIndices.second, 1 );
                 stateDerivativeModelsIterator_->second.at( i )->convertCurrentStateToGlobalRepresentation(
-                            state.block( currentPropagatedIndices.first, startColumn, currentPropagatedIndices.second, 1 ), time,
+                            stateDerivativeModelPropagatedStates_[ currentModelIndex ], time,
                             currentStatesPerTypeInConventionalRepresentation_.at(
                                 stateDerivativeModelsIterator_->first ).block(
                                 currentStateTypeSize, 0, currentConventionalIndices.second, 1 ) );
-
+                currentModelIndex++;
             }
         }
     }
@@ -697,6 +856,21 @@ private:
     typename std::unordered_map< IntegratedStateType, std::vector< std::shared_ptr
     < SingleStateTypeDerivative< StateScalarType, TimeType > > > >::iterator stateDerivativeModelsIterator_;
 
+    //! List of all state derivative models (entries of stateDerivativeModels_), used when evaluating the state derivative.
+    std::vector< std::shared_ptr< SingleStateTypeDerivative< StateScalarType, TimeType > > > stateDerivativeModelList_;
+
+    //! Start index and size in propagated state vector of each entry of stateDerivativeModelList_.
+    std::vector< std::pair< int, int > > stateDerivativeModelPropagatedStateIndices_;
+
+    //! Pre-allocated propagated state of each entry of stateDerivativeModelList_, set when evaluating the state derivative.
+    std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > stateDerivativeModelPropagatedStates_;
+
+    //! Pre-allocated state used by computeFixedSizeStateDerivative.
+    StateType fixedSizeState_;
+
+    //! Thread pool over which independent acceleration models are updated (nullptr for sequential update).
+    std::shared_ptr< utilities::ThreadPool > accelerationUpdateThreadPool_;
+
     //! Total length of conventional state vector.
     /*!
      *  Total length of conventional state vector. For instance, for translational propagation, this is the
@@ -734,7 +908,33 @@ private:
     unsigned int functionEvaluationCounter_ = 0;
 
     //! Variable to keep track of the number of calls to the computeStateDerivative function per time step
-    std::map< TimeType, unsigned int > cumulativeFunctionEvaluationCounter_;
+    /*!
+     *  Variable to keep track of the number of calls to the computeStateDerivative function per time step, stored as
+     *  (time, number of calls) pairs in the order of the calls. Stored contiguously (with capacity retained when resetting),
+     *  so that no memory is allocated per call; converted to a map by getCumulativeNumberOfFunctionEvaluations.
+     */
+    std::vector< std::pair< TimeType, unsigned int > > cumulativeFunctionEvaluationCounter_;
+
+    //! Profiler used to time the parts of the state derivative computation (nullptr if no timing is performed).
+    std::shared_ptr< utilities::TimingProfiler > profiler_;
+
+    //! Index of profiler entry of the complete state derivative computation.
+    int totalProfilerEntry_ = -1;
+
+    //! Index of profiler entry of the conversion of the state to its conventional representation.
+    int stateConversionProfilerEntry_ = -1;
+
+    //! Index of profiler entry of the environment update.
+    int environmentUpdateProfilerEntry_ = -1;
+
+    //! Index of profiler entry of the update of each entry of stateDerivativeModelList_.
+    std::vector< int > stateDerivativeModelUpdateProfilerEntries_;
+
+    //! Index of profiler entry of the state derivative evaluation of each entry of stateDerivativeModelList_.
+    std::vector< int > stateDerivativeModelEvaluationProfilerEntries_;
+
+    //! Index of profiler entry of the variational equations.
+    int variationalEquationsProfilerEntry_ = -1;
 };
 
 extern template class DynamicsStateDerivativeModel< double, double >;
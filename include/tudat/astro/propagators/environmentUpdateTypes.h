@@ -37,6 +37,9 @@ enum EnvironmentModelsToUpdate
     body_segment_orientation_update = 9
 };
 
+//! Function to get a string representing an environment model update type (e.g. for profiling output)
+std::string getEnvironmentModelUpdateName( const EnvironmentModelsToUpdate updateType );
+
 //! Function to extend existing list of required environment update types
 /*!
  * Function to extend existing list of required environment update types
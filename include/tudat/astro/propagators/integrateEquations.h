@@ -24,12 +24,14 @@
 
 #include <map>
 
+#include "tudat/basics/contiguousStateHistory.h"
 #include "tudat/math/integrators/numericalIntegrator.h"
 #include "tudat/astro/basic_astro/timeConversions.h"
 #include "tudat/basics/timeType.h"
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
 #include "tudat/math/integrators/createNumericalIntegrator.h"
 #include "tudat/math/interpolators/lagrangeInterpolator.h"
+#include "tudat/math/interpolators/rungeKuttaDenseOutputInterpolator.h"
 #include "tudat/math/root_finders/createRootFinder.h"
 #include "tudat/simulation/propagation_setup/propagationTermination.h"
 #include "tudat/simulation/propagation_setup/propagationResults.h"
@@ -364,10 +366,10 @@ bool getFinalStateForExactTerminationCondition(
  * \param timeStep Last time step taken by integrator.
  * \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
  * derivative model).
- * \param solutionHistory History of state variables that are to be saved given as map
- * (time as key; returned by reference)
- * \param dependentVariableHistory History of dependent variables that are to be saved given as map
- * (time as key; returned by reference)
+ * \param solutionHistory History of state variables that are to be saved, in the order in which they were computed
+ * (returned by reference)
+ * \param dependentVariableHistory History of dependent variables that are to be saved, in the order in which they were
+ * computed (returned by reference)
  * \param currentCpuTime Current run time of propagation.
  */
 template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
@@ -376,8 +378,8 @@ void propagateToExactTerminationCondition(
         const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
         const TimeStepType timeStep,
         const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
-        std::map< TimeType, StateType >& solutionHistory,
-        std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
+        utilities::ContiguousStateHistory< TimeType, typename StateType::Scalar, StateType::ColsAtCompileTime >& solutionHistory,
+        utilities::ContiguousStateHistory< TimeType, double >& dependentVariableHistory,
         const double currentCpuTime )
 {
     // Turn off step size control
@@ -399,37 +401,22 @@ void propagateToExactTerminationCondition(
         bool recomputeDependentVariables = false;
         if( dependentVariableHistory.size( ) > 0 )
         {
-            if( dependentVariableHistory.rbegin( )->first == solutionHistory.rbegin( )->first )
+            if( dependentVariableHistory.getTimes( ).back( ) == solutionHistory.getTimes( ).back( ) )
             {
-                if( timeStep > 0 )
-                {
-                    dependentVariableHistory.erase( std::prev( dependentVariableHistory.end() ) );
-                }
-                else
-                {
-                    dependentVariableHistory.erase(  dependentVariableHistory.begin( ) );
-                }
+                dependentVariableHistory.removeLastEntry( );
                 recomputeDependentVariables = true;
             }
         }
 
         // Remove state entry last added, and enter converged final state
-        if( timeStep > 0 )
-        {
-            solutionHistory.erase( std::prev( solutionHistory.end() ) );
-            solutionHistory[ endTime ] = endState;
-        }
-        else
-        {
-            solutionHistory.erase( solutionHistory.begin( ) );
-            solutionHistory[ endTime ] = endState;
-        }
+        solutionHistory.removeLastEntry( );
+        solutionHistory.addEntry( endTime, endState );
 
         // Recompute final dependent variables, if required
         if( recomputeDependentVariables )
         {
             integrator->getStateDerivativeFunction( )( endTime, endState );
-            dependentVariableHistory[ endTime ] = dependentVariableFunction( );
+            dependentVariableHistory.addEntry( endTime, dependentVariableFunction( ) );
 
             // Check stopping conditions to be able to save details
             propagationTerminationCondition->checkStopCondition( endTime, currentCpuTime );
@@ -467,10 +454,10 @@ void integrateEquationsFromIntegrator(
 {
     int saveFrequency = 1;
 
-    // Define structures that will contain with numerical results
-    std::map< TimeType, StateType > solutionHistory;
-    std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
-    std::map< TimeType, double > cumulativeComputationTimeHistory;
+    // Define structures that will contain with numerical results (stored contiguously, in the order in which they are computed)
+    utilities::ContiguousStateHistory< TimeType, typename StateType::Scalar, StateType::ColsAtCompileTime > solutionHistory;
+    utilities::ContiguousStateHistory< TimeType, double > dependentVariableHistory;
+    utilities::ContiguousStateHistory< TimeType, double > cumulativeComputationTimeHistory;
     std::shared_ptr< PropagationTerminationDetails > terminationDetails;
 
     // Initialize timer.
@@ -486,20 +473,20 @@ void integrateEquationsFromIntegrator(
 
     // Add results at initial state
     solutionHistory.clear( );
-    solutionHistory[ currentTime ] = newState;
+    solutionHistory.addEntry( currentTime, newState );
     dependentVariableHistory.clear( );
     if( !( dependentVariableFunction == nullptr ) )
     {
         // If dependent variables are to be used, updated state derivative model and compute
         integrator->getStateDerivativeFunction( )( currentTime, newState );
-        dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+        dependentVariableHistory.addEntry( currentTime, dependentVariableFunction( ) );
     }
 
     // Add CPU time after first saving step
     cumulativeComputationTimeHistory.clear( );
     double currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
                 std::chrono::steady_clock::now( ) - initialClockTime ).count( ) * 1.0e-9;
-    cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
+    cumulativeComputationTimeHistory.addScalarEntry( currentTime, currentCPUTime );
 
     // Set initial time step
     TimeStepType timeStep = integrator->getNextStepSize( );
@@ -589,12 +576,12 @@ void integrateEquationsFromIntegrator(
                 if( processingSettings->saveCurrentStep( stepsSinceLastSave, std::fabs(
                         static_cast< double >( currentTime ) - timeOfLastSave ) ) )
                 {
-                    solutionHistory[ currentTime ] = newState;
+                    solutionHistory.addEntry( currentTime, newState );
 
                     if( !( dependentVariableFunction == nullptr ) )
                     {
                         integrator->getStateDerivativeFunction( )( currentTime, newState );
-                        dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+                        dependentVariableHistory.addEntry( currentTime, dependentVariableFunction( ) );
                     }
                     timeOfLastSave = currentTime;
                     stepsSinceLastSave = 0;
@@ -616,7 +603,7 @@ void integrateEquationsFromIntegrator(
 
             currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
                         std::chrono::steady_clock::now( ) - initialClockTime ).count( ) * 1.0e-9;
-            cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
+            cumulativeComputationTimeHistory.addScalarEntry( currentTime, currentCPUTime );
 
             if( propagationTerminationCondition->checkStopCondition( static_cast< double >( currentTime ), currentCPUTime ) )
             {
@@ -687,6 +674,62 @@ void integrateEquationsFromIntegrator(
 }
 
 
+//! Class to set the dense output of an integrator in the propagation results, for types for which this is not supported.
+/*!
+ *  Class to set the dense output of an integrator in the propagation results, as a function creating interpolators for the
+ *  Cartesian state of a single body (see SingleArcSimulationResults::setDenseOutputStateInterpolatorFunction). This general
+ *  implementation is used for time and state types for which the dense output is not used to reset the environment (i.e.
+ *  anything other than a single-column double state, with double time), and does nothing.
+ */
+template< typename TimeType, typename StateType, typename TimeStepType >
+struct DenseOutputResultsSetter
+{
+    template< typename SimulationResults >
+    static void setDenseOutput(
+            const std::shared_ptr< numerical_integrators::NumericalIntegrator<
+            TimeType, StateType, StateType, TimeStepType > > /* integrator */,
+            const std::shared_ptr< SimulationResults > /* simulationResults */ ){ }
+};
+
+//! Class to set the dense output of an integrator in the propagation results, for single-column double states and double time.
+template< int NumberOfRows >
+struct DenseOutputResultsSetter< double, Eigen::Matrix< double, NumberOfRows, 1 >, double >
+{
+    typedef Eigen::Matrix< double, NumberOfRows, 1 > StateType;
+
+    //! Function to set the dense output of an integrator in the propagation results
+    /*!
+     *  Function to set the dense output of an integrator in the propagation results, as a function creating interpolators for
+     *  the Cartesian state of a single body
+     *  \param integrator Integrator with which the propagation was performed (must be a RungeKuttaVariableStepSizeIntegrator
+     *  storing its dense output)
+     *  \param simulationResults Object in which the numerical results are stored
+     */
+    template< typename SimulationResults >
+    static void setDenseOutput(
+            const std::shared_ptr< numerical_integrators::NumericalIntegrator< double, StateType, StateType, double > > integrator,
+            const std::shared_ptr< SimulationResults > simulationResults )
+    {
+        std::shared_ptr< numerical_integrators::RungeKuttaVariableStepSizeIntegrator< double, StateType, StateType, double > >
+                variableStepIntegrator = std::dynamic_pointer_cast<
+                numerical_integrators::RungeKuttaVariableStepSizeIntegrator< double, StateType, StateType, double > >( integrator );
+        if( variableStepIntegrator == nullptr || variableStepIntegrator->getDenseOutput( ) == nullptr )
+        {
+            throw std::runtime_error( "Error when retrieving dense output of integrator, no dense output stored" );
+        }
+
+        std::shared_ptr< numerical_integrators::RungeKuttaDenseOutput< double, StateType, double > > denseOutput =
+                variableStepIntegrator->getDenseOutput( );
+        if( denseOutput->getNumberOfSteps( ) > 0 )
+        {
+            simulationResults->setDenseOutputStateInterpolatorFunction(
+                        [ = ]( const int startRow ){
+                return std::make_shared< interpolators::RungeKuttaDenseOutputInterpolator<
+                        double, Eigen::Vector6d, StateType, double > >( denseOutput, startRow ); } );
+        }
+    }
+};
+
     //! Function to numerically integrate a given first order differential equation
     /*!
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
@@ -694,7 +737,9 @@ void integrateEquationsFromIntegrator(
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
      *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
      *  \param initialState Initial state
-     *  \param integratorSettings Settings for numerical integrator.
+     *  \param integratorSettings Settings for numerical integrator. If requested in these settings, the dense output of the
+     *  integrator is stored in simulationResults, and the history of an Adams-Bashforth-Moulton integrator is stored in the
+     *  settings (see saveIntegrationHistoryToSettings) after the integration.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
      *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
      *  (time as key; returned by reference)
@@ -740,6 +785,14 @@ void integrateEquationsFromIntegrator(
                     dependentVariableFunction,
                     statePostProcessingFunction,
                     processingSettings );
+
+        numerical_integrators::saveIntegrationHistoryToSettings( integrator, integratorSettings );
+
+        if( integratorSettings->storeDenseOutput_ )
+        {
+            DenseOutputResultsSetter< TimeType, StateType, typename scalar_type< TimeType >::value_type >::setDenseOutput(
+                        integrator, simulationResults );
+        }
     }
 
 
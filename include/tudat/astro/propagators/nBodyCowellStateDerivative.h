@@ -101,6 +101,31 @@ public:
         currentCartesianLocalSoluton = internalSolution;
     }
 
+    //! Function to convert the propagator-specific form of the state to the conventional form in the global frame.
+    /*!
+     * Function to convert the propagator-specific form of the state to the conventional form in the global frame. For the
+     * Cowell propagator, the propagator-specific form is the Cartesian state w.r.t. the central bodies, so the internal
+     * solution is used directly to retrieve the central body states (without temporary copies).
+     * \param internalSolution State in propagator-specific form (i.e. form that is used in numerical integration).
+     * \param time Current time at which the state is valid.
+     * \param currentCartesianLocalSoluton State (internalSolution), converted to the Cartesian state in the global frame
+     * (returned by reference).
+     */
+    void convertCurrentStateToGlobalRepresentation(
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& internalSolution, const TimeType& time,
+            Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > currentCartesianLocalSoluton )
+    {
+        currentCartesianLocalSoluton = internalSolution;
+
+        this->centralBodyData_->getReferenceFrameOriginInertialStates(
+                    internalSolution, time, this->centralBodyStatesWrtGlobalOrigin_, true );
+
+        for( unsigned int i = 0; i < this->centralBodyStatesWrtGlobalOrigin_.size( ); i++ )
+        {
+            currentCartesianLocalSoluton.template block< 6, 1 >( i * 6, 0 ) += this->centralBodyStatesWrtGlobalOrigin_[ i ];
+        }
+    }
+
 };
 
 extern template class NBodyCowellStateDerivative< double, double >;
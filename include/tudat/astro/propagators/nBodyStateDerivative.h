@@ -11,6 +11,7 @@
 #ifndef TUDAT_NBODYSTATEDERIVATIVE_H
 #define TUDAT_NBODYSTATEDERIVATIVE_H
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <string>
@@ -23,6 +24,7 @@
 #include "tudat/astro/basic_astro/accelerationModelTypes.h"
 #include "tudat/astro/propagators/centralBodyData.h"
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
+#include "tudat/basics/threadPool.h"
 
 namespace tudat
 {
@@ -82,6 +84,33 @@ std::vector< std::string > determineEphemerisUpdateorder( std::vector< std::stri
                                                           std::vector< std::string > centralBodies,
                                                           std::vector< std::string > ephemerisOrigins );
 
+// Function to retrieve the objects that may be modified when updating an acceleration model.
+/*
+ * Function to retrieve the objects that may be modified when updating an acceleration model (by calling its updateMembers
+ * function), in addition to the acceleration model itself. For third-body accelerations, these are the constituent
+ * acceleration models, for radiation pressure accelerations the source, target and occultation models. For acceleration
+ * models of which the update may modify objects that cannot be retrieved (e.g. thrust, custom and EIH accelerations), a
+ * nullptr is added, which is shared by all such models. The environment must have been updated before the acceleration
+ * models, and is only read by the updates.
+ * \param accelerationModel Acceleration model for which the dependencies are to be retrieved.
+ * \return Objects that may be modified when updating the acceleration model.
+ */
+std::vector< const void* > getAccelerationModelUpdateDependencies(
+        const std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel );
+
+// Function to divide a list of acceleration models into groups that can be updated concurrently.
+/*
+ * Function to divide a list of acceleration models into groups that can be updated concurrently. Acceleration models that
+ * (directly or indirectly) depend on a common object (see getAccelerationModelUpdateDependencies) are placed in the same
+ * group, in which they are to be updated sequentially. Different groups do not share any such objects, and may be updated
+ * concurrently.
+ * \param accelerationModelList List of acceleration models that is to be divided into groups.
+ * \return Indices (in accelerationModelList) of the acceleration models in each group, with the groups, and the models
+ * in each group, in the order in which they appear in accelerationModelList.
+ */
+std::vector< std::vector< int > > getIndependentAccelerationUpdateGroups(
+        const std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >& accelerationModelList );
+
 // State derivative for the translational dynamics of N bodies
 /*
  * This class calculates the trabnslational state derivative of any
@@ -144,19 +173,8 @@ public:
             }
         }
 
-        // Correct order of propagated bodies.
-        for( outerAccelerationIterator = accelerationModelsPerBody_.begin( );
-             outerAccelerationIterator != accelerationModelsPerBody_.end( );
-             outerAccelerationIterator++ )
-        {
-            std::vector< std::string >::iterator findIterator =
-                    std::find( bodiesToBeIntegratedNumerically_.begin( ), bodiesToBeIntegratedNumerically_.end( ),
-                               outerAccelerationIterator->first );
-            bodyOrder_.push_back( std::distance( bodiesToBeIntegratedNumerically_.begin( ), findIterator ) );
-        }
-
-        createAccelerationModelList( );
         verifyInput( );
+        createAccelerationModelList( );
     }
 
     // Destructor
@@ -177,15 +195,12 @@ public:
     {
         for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
         {
-            accelerationModelList_.at( i )->resetCurrentTime( );
-        }        
+            accelerationModelList_[ i ]->resetCurrentTime( );
+        }
 
-        for( unsigned int i = 0; i < updateRemovedAccelerations_.size( ); i++ )
+        for( unsigned int i = 0; i < removedCentralAccelerationsToUpdate_.size( ); i++ )
         {
-            if( removedCentralAccelerations_.count( updateRemovedAccelerations_.at( i  ) ) > 0 )
-            {
-                removedCentralAccelerations_[ updateRemovedAccelerations_.at( i ) ]->resetCurrentTime( );
-            }
+            removedCentralAccelerationsToUpdate_[ i ]->resetCurrentTime( );
         }
     }
 
@@ -211,18 +226,34 @@ public:
      */
     void updateStateDerivativeModel( const TimeType currentTime )
     {
-        for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+        if( accelerationUpdateThreadPool_ != nullptr && accelerationUpdateGroups_.size( ) > 1 )
         {
-            accelerationModelList_.at( i )->updateMembers( currentTime );
+            // Update independent groups of acceleration models concurrently
+            utilities::runTasks( accelerationUpdateThreadPool_, accelerationUpdateGroups_.size( ),
+                                 [ & ]( const int groupIndex, const unsigned int )
+            {
+                const std::vector< int >& currentGroup = accelerationUpdateGroups_[ groupIndex ];
+                for( unsigned int i = 0; i < currentGroup.size( ); i++ )
+                {
+                    utilities::ScopedTimingMeasurement timingMeasurement(
+                                profiler_.get( ), accelerationModelProfilerEntries_[ currentGroup[ i ] ] );
+                    accelerationModelList_[ currentGroup[ i ] ]->updateMembers( currentTime );
+                }
+            } );
         }
-
-        for( unsigned int i = 0; i < updateRemovedAccelerations_.size( ); i++ )
+        else
         {
-            if( removedCentralAccelerations_.count( updateRemovedAccelerations_.at( i  ) ) > 0 )
+            for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
             {
-                removedCentralAccelerations_[ updateRemovedAccelerations_.at( i ) ]->updateMembers( currentTime );
+                utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), accelerationModelProfilerEntries_[ i ] );
+                accelerationModelList_[ i ]->updateMembers( currentTime );
             }
         }
+
+        for( unsigned int i = 0; i < removedCentralAccelerationsToUpdate_.size( ); i++ )
+        {
+            removedCentralAccelerationsToUpdate_[ i ]->updateMembers( currentTime );
+        }
     }
 
     // Function to convert the propagator-specific form of the state to the conventional form in the global frame.
@@ -370,7 +401,52 @@ public:
         if( removedCentralAccelerations_.count( bodyName ) > 0 )
         {
             updateRemovedAccelerations_.push_back( bodyName );
+            removedCentralAccelerationsToUpdate_.push_back( removedCentralAccelerations_.at( bodyName ) );
+        }
+    }
+
+    // Function to set the thread pool over which independent acceleration models are updated.
+    /*
+     * Function to set the thread pool over which independent acceleration models are updated by the
+     * updateStateDerivativeModel function. The acceleration models are divided into groups that do not share any modified
+     * objects (see getIndependentAccelerationUpdateGroups), which are updated concurrently. Within each group, the models
+     * are updated sequentially. Since the acceleration models are updated after the environment, the resulting
+     * accelerations are identical to those of a sequential update.
+     * \param threadPool Thread pool over which the acceleration model updates are distributed (sequential update if
+     * nullptr).
+     */
+    void setAccelerationUpdateThreadPool( const std::shared_ptr< utilities::ThreadPool > threadPool )
+    {
+        accelerationUpdateThreadPool_ = threadPool;
+        accelerationUpdateGroups_ = getIndependentAccelerationUpdateGroups( accelerationModelList_ );
+    }
+
+    // Function to retrieve the groups of acceleration models that are updated concurrently.
+    /*
+     * Function to retrieve the groups of acceleration models that are updated concurrently, if a thread pool has been set
+     * by setAccelerationUpdateThreadPool.
+     * \return Indices of the acceleration models in each group, in the list of acceleration models sorted by body
+     * undergoing acceleration.
+     */
+    std::vector< std::vector< int > > getAccelerationUpdateGroups( )
+    {
+        return accelerationUpdateGroups_;
+    }
+
+    // Function to set the profiler used to time the update of the individual acceleration models.
+    /*
+     * Function to set the profiler used to time the update of the individual acceleration models, by adding an entry (in
+     * category acceleration) for each acceleration model to the profiler.
+     * \param profiler Profiler used to time the acceleration model updates (no timing if nullptr).
+     */
+    void setProfiler( const std::shared_ptr< utilities::TimingProfiler > profiler )
+    {
+        if( profiler != profiler_ )
+        {
+            registeredAccelerationModelProfilerEntries_.clear( );
         }
+        profiler_ = profiler;
+        setAccelerationModelProfilerEntries( );
     }
 
 
@@ -405,25 +481,108 @@ protected:
 
     // Function to set the vector of acceleration models (accelerationModelList_) form the map of map of
     // acceleration models (accelerationModelsPerBody_).
+    /*
+     * Function to set the vector of acceleration models (accelerationModelList_) form the map of map of acceleration
+     * models (accelerationModelsPerBody_), sorted by the index of the body undergoing the acceleration. The index in the
+     * state derivative at which each acceleration is to be added is stored in accelerationModelStateIndices_, so that the
+     * state derivative is evaluated without iterating over the (string-keyed) acceleration map. The acceleration map is
+     * retained for setup and introspection only, and this function must be called after any modification to it.
+     */
     void createAccelerationModelList( )
     {
-        // Iterate over all accelerations and update their internal state.
-        accelerationModelList_.clear( );
+        // Retrieve all accelerations, with the index of the body on which they act.
+        std::vector< std::pair< int, std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > >
+                accelerationModelsWithBodyIndex;
         for( outerAccelerationIterator = accelerationModelsPerBody_.begin( );
              outerAccelerationIterator != accelerationModelsPerBody_.end( ); outerAccelerationIterator++ )
         {
+            int currentBodyIndex = std::distance(
+                        bodiesToBeIntegratedNumerically_.begin( ),
+                        std::find( bodiesToBeIntegratedNumerically_.begin( ), bodiesToBeIntegratedNumerically_.end( ),
+                                   outerAccelerationIterator->first ) );
+
             // Iterate over all accelerations acting on body
             for( innerAccelerationIterator  = outerAccelerationIterator->second.begin( );
                  innerAccelerationIterator != outerAccelerationIterator->second.end( );
                  innerAccelerationIterator++ )
             {
-                // Update accelerations
                 for( unsigned int j = 0; j < innerAccelerationIterator->second.size( ); j++ )
                 {
-                    accelerationModelList_.push_back( innerAccelerationIterator->second.at( j ) );
+                    accelerationModelsWithBodyIndex.push_back(
+                                std::make_pair( currentBodyIndex, innerAccelerationIterator->second.at( j ) ) );
                 }
             }
         }
+
+        // Sort accelerations by body, so that state derivative is filled sequentially
+        std::stable_sort( accelerationModelsWithBodyIndex.begin( ), accelerationModelsWithBodyIndex.end( ),
+                          [ ]( const std::pair< int, std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >& first,
+                               const std::pair< int, std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >& second )
+        { return first.first < second.first; } );
+
+        accelerationModelList_.clear( );
+        accelerationModelStateIndices_.clear( );
+        for( unsigned int i = 0; i < accelerationModelsWithBodyIndex.size( ); i++ )
+        {
+            accelerationModelList_.push_back( accelerationModelsWithBodyIndex.at( i ).second );
+            accelerationModelStateIndices_.push_back( 6 * accelerationModelsWithBodyIndex.at( i ).first + 3 );
+        }
+        setAccelerationModelProfilerEntries( );
+
+        if( accelerationUpdateThreadPool_ != nullptr )
+        {
+            accelerationUpdateGroups_ = getIndependentAccelerationUpdateGroups( accelerationModelList_ );
+        }
+    }
+
+    // Function to set the index of the profiler entry of each entry of accelerationModelList_ (-1 if no profiler is set).
+    // An entry is added to the profiler only for acceleration models that were not yet registered, so that rebuilding the
+    // acceleration model list does not create duplicate entries.
+    void setAccelerationModelProfilerEntries( )
+    {
+        accelerationModelProfilerEntries_.assign( accelerationModelList_.size( ), -1 );
+        if( profiler_ != nullptr )
+        {
+            for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+            {
+                auto registeredEntry = registeredAccelerationModelProfilerEntries_.find( accelerationModelList_[ i ] );
+                if( registeredEntry == registeredAccelerationModelProfilerEntries_.end( ) )
+                {
+                    registeredEntry = registeredAccelerationModelProfilerEntries_.insert(
+                                std::make_pair( accelerationModelList_[ i ], profiler_->addEntry(
+                                                    "acceleration",
+                                                    getAccelerationModelProfilerName( accelerationModelList_[ i ] ) ) ) ).first;
+                }
+                accelerationModelProfilerEntries_[ i ] = registeredEntry->second;
+            }
+        }
+    }
+
+    // Function to get the name of an acceleration model in accelerationModelsPerBody_, as used in the profiler.
+    std::string getAccelerationModelProfilerName(
+            const std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel )
+    {
+        std::string accelerationName = "acceleration";
+        try
+        {
+            accelerationName = basic_astrodynamics::getAccelerationModelName(
+                        basic_astrodynamics::getAccelerationModelType( accelerationModel ) );
+        }
+        catch( const std::runtime_error& )
+        { }
+
+        for( const auto& outerIterator : accelerationModelsPerBody_ )
+        {
+            for( const auto& innerIterator : outerIterator.second )
+            {
+                if( std::find( innerIterator.second.begin( ), innerIterator.second.end( ), accelerationModel ) !=
+                        innerIterator.second.end( ) )
+                {
+                    return accelerationName + " exerted by " + innerIterator.first + " on " + outerIterator.first;
+                }
+            }
+        }
+        return accelerationName;
     }
 
     // Function to get the state derivative of the system in Cartesian coordinates.
@@ -441,42 +600,23 @@ protected:
             Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > stateDerivative,
             const bool addPositionDerivatives = true )
     {
-        using namespace basic_astrodynamics;
-
         stateDerivative.setZero( );
 
-        int currentBodyIndex = 0;
-        int currentAccelerationIndex = 0;
-
-        // Iterate over all bodies with accelerations.
-        for( outerAccelerationIterator = accelerationModelsPerBody_.begin( );
-             outerAccelerationIterator != accelerationModelsPerBody_.end( );
-             outerAccelerationIterator++ )
+        // Add all accelerations to state derivative of body on which they act.
+        for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
         {
-            currentBodyIndex = bodyOrder_[ currentAccelerationIndex ];
-
-            // Iterate over all accelerations acting on body
-            for( innerAccelerationIterator  = outerAccelerationIterator->second.begin( );
-                 innerAccelerationIterator != outerAccelerationIterator->second.end( );
-                 innerAccelerationIterator++ )
-            {
-                for( unsigned int j = 0; j < innerAccelerationIterator->second.size( ); j++ )
-                {
-                    // Calculate acceleration and add to state derivative.
-                    stateDerivative.block( currentBodyIndex * 6 + 3, 0, 3, 1 ) +=
-                                                ( innerAccelerationIterator->second[ j ]->getAccelerationReference( ) ).
-                                                template cast< StateScalarType >( );
-
-                }
-            }
+            stateDerivative.template block< 3, 1 >( accelerationModelStateIndices_[ i ], 0 ) +=
+                    accelerationModelList_[ i ]->getAccelerationReference( ).template cast< StateScalarType >( );
+        }
 
-            if( addPositionDerivatives )
+        if( addPositionDerivatives )
+        {
+            // Add body velocity as derivative of its position.
+            for( unsigned int i = 0; i < bodiesToBeIntegratedNumerically_.size( ); i++ )
             {
-                // Add body velocity as derivative of its position.
-                stateDerivative.block( currentBodyIndex * 6, 0, 3, 1 ) =
-                        ( stateOfSystemToBeIntegrated.segment( currentBodyIndex * 6 + 3, 3 ) );
+                stateDerivative.template block< 3, 1 >( 6 * i, 0 ) =
+                        stateOfSystemToBeIntegrated.template segment< 3 >( 6 * i + 3 );
             }
-            currentAccelerationIndex++;
         }
     }
 
@@ -517,9 +657,33 @@ protected:
 
     std::vector< std::string > updateRemovedAccelerations_;
 
-    // Vector of acceleration models, containing all entries of accelerationModelsPerBody_.
+    // Removed central accelerations that are to be updated (entries of removedCentralAccelerations_ for the bodies in
+    // updateRemovedAccelerations_).
+    std::vector< std::shared_ptr< gravitation::CentralGravitationalAccelerationModel3d > > removedCentralAccelerationsToUpdate_;
+
+    // Vector of acceleration models, containing all entries of accelerationModelsPerBody_, sorted by body undergoing
+    // acceleration.
     std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > accelerationModelList_;
 
+    // Index in state derivative at which each entry of accelerationModelList_ is to be added.
+    std::vector< int > accelerationModelStateIndices_;
+
+    // Thread pool over which independent acceleration models are updated (nullptr for sequential update).
+    std::shared_ptr< utilities::ThreadPool > accelerationUpdateThreadPool_;
+
+    // Indices in accelerationModelList_ of groups of acceleration models that can be updated concurrently.
+    std::vector< std::vector< int > > accelerationUpdateGroups_;
+
+    // Profiler used to time the update of the acceleration models (nullptr if no timing is performed).
+    std::shared_ptr< utilities::TimingProfiler > profiler_;
+
+    // Index of profiler entry for each entry of accelerationModelList_ (-1 if no profiler is set).
+    std::vector< int > accelerationModelProfilerEntries_;
+
+    // Index of profiler entry of each acceleration model that has been registered with profiler_.
+    std::map< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > >, int >
+    registeredAccelerationModelProfilerEntries_;
+
     // Object responsible for providing the current integration origins from the global origins.
     std::shared_ptr< CentralBodyData< StateScalarType, TimeType > > centralBodyData_;
 
@@ -529,8 +693,6 @@ protected:
     // List of names of bodies that are to be integrated numerically.
     std::vector< std::string > bodiesToBeIntegratedNumerically_;
 
-    std::vector< int > bodyOrder_;
-
     // Predefined iterator to save (de-)allocation time.
     std::unordered_map< std::string, std::vector<
     std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > >::iterator innerAccelerationIterator;
@@ -0,0 +1,279 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_NBODY_TAYLOR_SERIES_EXPRESSIONS_H
+#define TUDAT_NBODY_TAYLOR_SERIES_EXPRESSIONS_H
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tudat/astro/basic_astro/accelerationModel.h"
+#include "tudat/astro/basic_astro/physicalConstants.h"
+#include "tudat/math/integrators/taylorSeriesExpression.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to check the consistency of an N-body state with the gravitational parameters of the bodies.
+template< typename ScalarType >
+void checkNBodyStateSize( const std::vector< ScalarType >& state, const std::vector< double >& gravitationalParameters )
+{
+    if( state.size( ) != 6 * gravitationalParameters.size( ) )
+    {
+        throw std::runtime_error( "Error when computing N-body state derivative, state size (" +
+                                  std::to_string( state.size( ) ) + ") is inconsistent with number of bodies (" +
+                                  std::to_string( gravitationalParameters.size( ) ) + ")" );
+    }
+}
+
+//! Function to compute the state derivative of N bodies under their mutual point-mass attraction.
+/*!
+ *  Function to compute the state derivative of N bodies under their mutual point-mass attraction, for a state consisting of
+ *  the inertial Cartesian position and velocity of each body (6 entries per body). The function is written generically in
+ *  the scalar type, so that it can be used both to evaluate the state derivative (ScalarType = double) and to record it for
+ *  Taylor series generation (ScalarType = TaylorSeriesVariable, see createNBodyPointMassTaylorSeriesExpression).
+ *  \param state Inertial Cartesian states of the bodies.
+ *  \param gravitationalParameters Gravitational parameters of the bodies.
+ *  \return State derivative (velocity and acceleration of each body).
+ */
+template< typename ScalarType >
+std::vector< ScalarType > computeNBodyPointMassStateDerivative(
+        const std::vector< ScalarType >& state, const std::vector< double >& gravitationalParameters )
+{
+    using std::sqrt;
+
+    checkNBodyStateSize( state, gravitationalParameters );
+    const int numberOfBodies = static_cast< int >( gravitationalParameters.size( ) );
+
+    std::vector< ScalarType > stateDerivative( state.size( ), ScalarType( 0.0 ) );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        for( int k = 0; k < 3; k++ )
+        {
+            stateDerivative[ 6 * i + k ] = state[ 6 * i + 3 + k ];
+        }
+    }
+
+    // Compute each mutual attraction once, and apply it to both bodies
+    ScalarType relativePosition[ 3 ];
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        for( int j = i + 1; j < numberOfBodies; j++ )
+        {
+            for( int k = 0; k < 3; k++ )
+            {
+                relativePosition[ k ] = state[ 6 * j + k ] - state[ 6 * i + k ];
+            }
+            ScalarType squaredDistance = relativePosition[ 0 ] * relativePosition[ 0 ] +
+                    relativePosition[ 1 ] * relativePosition[ 1 ] + relativePosition[ 2 ] * relativePosition[ 2 ];
+            ScalarType inverseCubedDistance = 1.0 / ( squaredDistance * sqrt( squaredDistance ) );
+
+            for( int k = 0; k < 3; k++ )
+            {
+                ScalarType scaledRelativePosition = relativePosition[ k ] * inverseCubedDistance;
+                stateDerivative[ 6 * i + 3 + k ] += gravitationalParameters[ j ] * scaledRelativePosition;
+                stateDerivative[ 6 * j + 3 + k ] -= gravitationalParameters[ i ] * scaledRelativePosition;
+            }
+        }
+    }
+    return stateDerivative;
+}
+
+//! Function to compute the state derivative of N bodies under their mutual attraction, using the EIH equations.
+/*!
+ *  Function to compute the state derivative of N bodies under their mutual attraction, using the first-order
+ *  post-Newtonian Einstein-Infeld-Hoffmann (EIH) equations with PPN parameters gamma and beta, for a state consisting of
+ *  the barycentric Cartesian position and velocity of each body (6 entries per body). The terms of the equations are
+ *  identical to those of relativity::EinsteinInfeldHoffmannEquations. The function is written generically in the scalar
+ *  type, so that it can be used both to evaluate the state derivative (ScalarType = double) and to record it for Taylor
+ *  series generation (ScalarType = TaylorSeriesVariable, see createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression).
+ *  \param state Barycentric Cartesian states of the bodies.
+ *  \param gravitationalParameters Gravitational parameters of the bodies.
+ *  \param ppnGamma PPN parameter gamma.
+ *  \param ppnBeta PPN parameter beta.
+ *  \return State derivative (velocity and acceleration of each body).
+ */
+template< typename ScalarType >
+std::vector< ScalarType > computeNBodyEinsteinInfeldHoffmannStateDerivative(
+        const std::vector< ScalarType >& state, const std::vector< double >& gravitationalParameters,
+        const double ppnGamma = 1.0, const double ppnBeta = 1.0 )
+{
+    using std::sqrt;
+
+    checkNBodyStateSize( state, gravitationalParameters );
+    const int numberOfBodies = static_cast< int >( gravitationalParameters.size( ) );
+
+    // Multipliers of the scalar and vector terms of the EIH equations
+    const double scalarTermMultipliers[ 7 ] =
+    { -2.0 * ( ppnGamma + ppnBeta ), -2.0 * ppnBeta - 1.0, ppnGamma, 1.0 + ppnGamma, -2.0 * ( 1.0 + ppnGamma ), -1.5, 0.5 };
+    const double vectorTermMultipliers[ 3 ] =
+    { 2.0 * ( 1.0 + ppnGamma ), -1.0 + 2.0 * ppnGamma, ( 3.0 + 4.0 * ppnGamma ) / 2.0 };
+
+    // Compute relative positions r_ij = r_j - r_i, inverse distances and point-mass terms (for each pair once)
+    std::vector< std::vector< std::vector< ScalarType > > > relativePositions(
+                numberOfBodies, std::vector< std::vector< ScalarType > >(
+                    numberOfBodies, std::vector< ScalarType >( 3, ScalarType( 0.0 ) ) ) );
+    std::vector< std::vector< ScalarType > > inverseDistances(
+                numberOfBodies, std::vector< ScalarType >( numberOfBodies, ScalarType( 0.0 ) ) );
+    std::vector< std::vector< ScalarType > > inverseCubedDistances(
+                numberOfBodies, std::vector< ScalarType >( numberOfBodies, ScalarType( 0.0 ) ) );
+    std::vector< ScalarType > localPotentials( numberOfBodies, ScalarType( 0.0 ) );
+    std::vector< std::vector< ScalarType > > pointMassAccelerations(
+                numberOfBodies, std::vector< ScalarType >( 3, ScalarType( 0.0 ) ) );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        for( int j = i + 1; j < numberOfBodies; j++ )
+        {
+            for( int k = 0; k < 3; k++ )
+            {
+                relativePositions[ i ][ j ][ k ] = state[ 6 * j + k ] - state[ 6 * i + k ];
+                relativePositions[ j ][ i ][ k ] = -relativePositions[ i ][ j ][ k ];
+            }
+            ScalarType squaredDistance = relativePositions[ i ][ j ][ 0 ] * relativePositions[ i ][ j ][ 0 ] +
+                    relativePositions[ i ][ j ][ 1 ] * relativePositions[ i ][ j ][ 1 ] +
+                    relativePositions[ i ][ j ][ 2 ] * relativePositions[ i ][ j ][ 2 ];
+            inverseDistances[ i ][ j ] = 1.0 / sqrt( squaredDistance );
+            inverseDistances[ j ][ i ] = inverseDistances[ i ][ j ];
+            inverseCubedDistances[ i ][ j ] = inverseDistances[ i ][ j ] / squaredDistance;
+            inverseCubedDistances[ j ][ i ] = inverseCubedDistances[ i ][ j ];
+
+            localPotentials[ i ] += gravitationalParameters[ j ] * inverseDistances[ i ][ j ];
+            localPotentials[ j ] += gravitationalParameters[ i ] * inverseDistances[ i ][ j ];
+            for( int k = 0; k < 3; k++ )
+            {
+                ScalarType scaledRelativePosition = relativePositions[ i ][ j ][ k ] * inverseCubedDistances[ i ][ j ];
+                pointMassAccelerations[ i ][ k ] += gravitationalParameters[ j ] * scaledRelativePosition;
+                pointMassAccelerations[ j ][ k ] -= gravitationalParameters[ i ] * scaledRelativePosition;
+            }
+        }
+    }
+
+    // Compute velocity inner products v_i * v_j
+    std::vector< std::vector< ScalarType > > velocityInnerProducts(
+                numberOfBodies, std::vector< ScalarType >( numberOfBodies, ScalarType( 0.0 ) ) );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        for( int j = i; j < numberOfBodies; j++ )
+        {
+            velocityInnerProducts[ i ][ j ] = state[ 6 * i + 3 ] * state[ 6 * j + 3 ] +
+                    state[ 6 * i + 4 ] * state[ 6 * j + 4 ] + state[ 6 * i + 5 ] * state[ 6 * j + 5 ];
+            velocityInnerProducts[ j ][ i ] = velocityInnerProducts[ i ][ j ];
+        }
+    }
+
+    std::vector< ScalarType > stateDerivative( state.size( ), ScalarType( 0.0 ) );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        ScalarType relativisticCorrection[ 3 ] = { ScalarType( 0.0 ), ScalarType( 0.0 ), ScalarType( 0.0 ) };
+        for( int j = 0; j < numberOfBodies; j++ )
+        {
+            if( i != j )
+            {
+                const std::vector< ScalarType >& relativePosition = relativePositions[ i ][ j ];
+
+                // r_ij * v_i, r_ij * v_j and r_ij * a_j
+                ScalarType relativePositionDotVelocityI = relativePosition[ 0 ] * state[ 6 * i + 3 ] +
+                        relativePosition[ 1 ] * state[ 6 * i + 4 ] + relativePosition[ 2 ] * state[ 6 * i + 5 ];
+                ScalarType lineOfSightSpeed = relativePosition[ 0 ] * state[ 6 * j + 3 ] +
+                        relativePosition[ 1 ] * state[ 6 * j + 4 ] + relativePosition[ 2 ] * state[ 6 * j + 5 ];
+                ScalarType relativePositionDotAcceleration = relativePosition[ 0 ] * pointMassAccelerations[ j ][ 0 ] +
+                        relativePosition[ 1 ] * pointMassAccelerations[ j ][ 1 ] +
+                        relativePosition[ 2 ] * pointMassAccelerations[ j ][ 2 ];
+                ScalarType inverseSquareDistance = inverseDistances[ i ][ j ] * inverseDistances[ i ][ j ];
+
+                ScalarType scalarTermCorrection =
+                        scalarTermMultipliers[ 0 ] * localPotentials[ i ] +
+                        scalarTermMultipliers[ 1 ] * localPotentials[ j ] +
+                        scalarTermMultipliers[ 2 ] * velocityInnerProducts[ i ][ i ] +
+                        scalarTermMultipliers[ 3 ] * velocityInnerProducts[ j ][ j ] +
+                        scalarTermMultipliers[ 4 ] * velocityInnerProducts[ i ][ j ] +
+                        scalarTermMultipliers[ 5 ] * lineOfSightSpeed * lineOfSightSpeed * inverseSquareDistance +
+                        scalarTermMultipliers[ 6 ] * relativePositionDotAcceleration;
+                ScalarType relativeVelocityFactor =
+                        ( vectorTermMultipliers[ 0 ] * relativePositionDotVelocityI +
+                          vectorTermMultipliers[ 1 ] * lineOfSightSpeed ) * inverseSquareDistance;
+
+                ScalarType scalarTermFactor = gravitationalParameters[ j ] * scalarTermCorrection *
+                        inverseCubedDistances[ i ][ j ];
+                ScalarType vectorTermFactor = gravitationalParameters[ j ] * inverseDistances[ i ][ j ];
+                for( int k = 0; k < 3; k++ )
+                {
+                    relativisticCorrection[ k ] +=
+                            scalarTermFactor * relativePosition[ k ] + vectorTermFactor * (
+                                relativeVelocityFactor * ( state[ 6 * j + 3 + k ] - state[ 6 * i + 3 + k ] ) +
+                                vectorTermMultipliers[ 2 ] * pointMassAccelerations[ j ][ k ] );
+                }
+            }
+        }
+
+        for( int k = 0; k < 3; k++ )
+        {
+            stateDerivative[ 6 * i + k ] = state[ 6 * i + 3 + k ];
+            stateDerivative[ 6 * i + 3 + k ] = pointMassAccelerations[ i ][ k ] +
+                    physical_constants::INVERSE_SQUARE_SPEED_OF_LIGHT * relativisticCorrection[ k ];
+        }
+    }
+    return stateDerivative;
+}
+
+//! Function to record the N-body point-mass state derivative for Taylor series generation.
+/*!
+ *  Function to record the N-body point-mass state derivative (see computeNBodyPointMassStateDerivative) for Taylor series
+ *  generation, for use with the Taylor series integrator. For a propagation, the bodies must be propagated w.r.t. an
+ *  inertial origin (Cowell propagator), in the same order as the gravitational parameters.
+ *  \param gravitationalParameters Gravitational parameters of the bodies.
+ *  \return Recorded state derivative function.
+ */
+std::shared_ptr< numerical_integrators::TaylorSeriesExpression > createNBodyPointMassTaylorSeriesExpression(
+        const std::vector< double >& gravitationalParameters );
+
+//! Function to record the N-body EIH state derivative for Taylor series generation.
+/*!
+ *  Function to record the N-body EIH state derivative (see computeNBodyEinsteinInfeldHoffmannStateDerivative) for Taylor
+ *  series generation, for use with the Taylor series integrator. For a propagation, the bodies must be propagated w.r.t.
+ *  the barycenter (Cowell propagator), in the same order as the gravitational parameters.
+ *  \param gravitationalParameters Gravitational parameters of the bodies.
+ *  \param ppnGamma PPN parameter gamma.
+ *  \param ppnBeta PPN parameter beta.
+ *  \return Recorded state derivative function.
+ */
+std::shared_ptr< numerical_integrators::TaylorSeriesExpression > createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression(
+        const std::vector< double >& gravitationalParameters, const double ppnGamma = 1.0, const double ppnBeta = 1.0 );
+
+//! Function to record the N-body state derivative for Taylor series generation, from the acceleration models of a propagation.
+/*!
+ *  Function to record the N-body state derivative for Taylor series generation, from the acceleration models of a
+ *  translational propagation with the Cowell propagator, so that the expression is guaranteed to describe the propagated
+ *  dynamics. The accelerations must be either point-mass gravity (without mutual attraction) or EIH accelerations (for all
+ *  bodies), exerted only by the propagated bodies, and all bodies must be propagated w.r.t. the same origin, which is not
+ *  itself propagated. A point-mass attraction exerted by one of the bodies must act on all other bodies, with the same
+ *  gravitational parameter. An exception is thrown for any other acceleration or configuration.
+ *  \param accelerationModelMap Acceleration models acting on the propagated bodies.
+ *  \param bodiesToPropagate Names of the propagated bodies, in the order of the propagated state.
+ *  \param centralBodies Names of the central bodies of the propagation.
+ *  \return Recorded state derivative function.
+ */
+std::shared_ptr< numerical_integrators::TaylorSeriesExpression > createNBodyTaylorSeriesExpression(
+        const basic_astrodynamics::AccelerationMap& accelerationModelMap,
+        const std::vector< std::string >& bodiesToPropagate,
+        const std::vector< std::string >& centralBodies );
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_NBODY_TAYLOR_SERIES_EXPRESSIONS_H
@@ -20,6 +20,7 @@
 #include <functional>
 
 #include "tudat/astro/basic_astro/torqueModel.h"
+#include "tudat/astro/basic_astro/torqueModelTypes.h"
 
 #include "tudat/astro/propagators/singleStateTypeDerivative.h"
 #include "tudat/simulation/environment_setup/body.h"
@@ -185,15 +186,64 @@ public:
      */
     void updateStateDerivativeModel( const TimeType currentTime )
     {
-        for( torqueModelMapIterator = torqueModelsPerBody_.begin( );
-             torqueModelMapIterator != torqueModelsPerBody_.end( ); torqueModelMapIterator++ )
+        if( profiler_ == nullptr )
         {
-            for( innerTorqueIterator = torqueModelMapIterator->second.begin( ); innerTorqueIterator !=
-                 torqueModelMapIterator->second.end( ); innerTorqueIterator++ )
+            for( torqueModelMapIterator = torqueModelsPerBody_.begin( );
+                 torqueModelMapIterator != torqueModelsPerBody_.end( ); torqueModelMapIterator++ )
             {
-                for( unsigned int j = 0; j < innerTorqueIterator->second.size( ); j++ )
+                for( innerTorqueIterator = torqueModelMapIterator->second.begin( ); innerTorqueIterator !=
+                     torqueModelMapIterator->second.end( ); innerTorqueIterator++ )
                 {
-                    innerTorqueIterator->second[ j ]->updateMembers( currentTime );
+                    for( unsigned int j = 0; j < innerTorqueIterator->second.size( ); j++ )
+                    {
+                        innerTorqueIterator->second[ j ]->updateMembers( currentTime );
+                    }
+                }
+            }
+        }
+        else
+        {
+            for( unsigned int i = 0; i < profiledTorqueModels_.size( ); i++ )
+            {
+                utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), torqueModelProfilerEntries_[ i ] );
+                profiledTorqueModels_[ i ]->updateMembers( currentTime );
+            }
+        }
+    }
+
+    // Function to set the profiler used to time the update of the individual torque models.
+    /*
+     * Function to set the profiler used to time the update of the individual torque models, by adding an entry (in
+     * category torque) for each torque model to the profiler.
+     * \param profiler Profiler used to time the torque model updates (no timing if nullptr).
+     */
+    void setProfiler( const std::shared_ptr< utilities::TimingProfiler > profiler )
+    {
+        profiler_ = profiler;
+        profiledTorqueModels_.clear( );
+        torqueModelProfilerEntries_.clear( );
+        if( profiler_ != nullptr )
+        {
+            for( const auto& outerIterator : torqueModelsPerBody_ )
+            {
+                for( const auto& innerIterator : outerIterator.second )
+                {
+                    for( unsigned int j = 0; j < innerIterator.second.size( ); j++ )
+                    {
+                        std::string torqueName = "torque";
+                        try
+                        {
+                            torqueName = basic_astrodynamics::getTorqueModelName(
+                                        basic_astrodynamics::getTorqueModelType( innerIterator.second.at( j ) ) );
+                        }
+                        catch( const std::runtime_error& )
+                        { }
+
+                        profiledTorqueModels_.push_back( innerIterator.second.at( j ) );
+                        torqueModelProfilerEntries_.push_back(
+                                    profiler_->addEntry( "torque", torqueName + " exerted by " + innerIterator.first +
+                                                         " on " + outerIterator.first ) );
+                    }
                 }
             }
         }
@@ -389,6 +439,15 @@ protected:
     // Predefined iterator to save (de-)allocation time.
     basic_astrodynamics::SingleBodyTorqueModelMap::iterator innerTorqueIterator;
 
+    // Profiler used to time the update of the torque models (nullptr if no timing is performed).
+    std::shared_ptr< utilities::TimingProfiler > profiler_;
+
+    // List of all torque models in torqueModelsPerBody_, updated in this order if a profiler is set.
+    std::vector< std::shared_ptr< basic_astrodynamics::TorqueModel > > profiledTorqueModels_;
+
+    // Index of profiler entry for each entry of profiledTorqueModels_.
+    std::vector< int > torqueModelProfilerEntries_;
+
 };
 
 
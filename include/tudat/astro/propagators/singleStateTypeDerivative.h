@@ -16,6 +16,7 @@
 #include <Eigen/Core>
 
 #include "tudat/basics/timeType.h"
+#include "tudat/basics/timingProfiler.h"
 #include <tudat/basics/utilityMacros.h>
 
 namespace tudat
@@ -233,6 +234,18 @@ public:
         return false;
     }
 
+    // Function to set the profiler used to time the update of the individual models of the state derivative.
+    /*
+     * Function to set the profiler used to time the update of the individual models of the state derivative (e.g.
+     * acceleration or torque models), by adding an entry for each model to the profiler. Default implementation is empty
+     * (no timing of individual models).
+     * \param profiler Profiler used to time the model updates (no timing if nullptr).
+     */
+    virtual void setProfiler( const std::shared_ptr< utilities::TimingProfiler > profiler )
+    {
+        TUDAT_UNUSED_PARAMETER( profiler );
+    }
+
 protected:
 
     // Type of dynamics for which the state derivative is calculated.
@@ -144,9 +144,6 @@ public:
         stateTransitionMatrixInterpolator_( stateTransitionMatrixInterpolator ),
         sensitivityMatrixInterpolator_( sensitivityMatrixInterpolator )
     {
-        combinedStateTransitionMatrix_ = Eigen::MatrixXd::Zero(
-                        stateTransitionMatrixSize_, stateTransitionMatrixSize_ + sensitivityMatrixSize_ );
-
         // Re-order state partial addition indices to match ephemeris update order (inverted in variational equations object)
         statePartialAdditionIndices_.clear( );
         for ( int i = statePartialAdditionIndices.size( ) - 1; i >= 0 ; i-- )
@@ -237,9 +234,6 @@ public:
 
 private:
 
-    //! Predefined matrix to use as return value when calling getCombinedStateTransitionAndSensitivityMatrix.
-    Eigen::MatrixXd combinedStateTransitionMatrix_;
-
     //! Interpolator returning the state transition matrix as a function of time.
     std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >
     stateTransitionMatrixInterpolator_;
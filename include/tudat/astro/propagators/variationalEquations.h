@@ -116,6 +116,7 @@ public:
         }
         setRotationalStatePartialScalingFunctions( parametersToEstimate );
         setParameterPartialFunctionList( parametersToEstimate );
+        setStatePartialBlockPattern( );
     }
 
     //! Calculates matrix containing partial derivatives of state derivatives w.r.t. body state.
@@ -141,9 +142,65 @@ public:
     {
         setBodyStatePartialMatrix( );
 
-        // Add partials of body positions and velocities.
-        currentMatrixDerivative.block( 0, 0, totalDynamicalStateSize_, numberOfParameterValues_ ) =
-                ( variationalMatrix_.template cast< StateScalarType >( ) * stateTransitionAndSensitivityMatrices );
+        // Add partials of body positions and velocities. Rows of translational positions that only contain the identity
+        // matrix w.r.t. the body's velocity are equal to the associated rows of the state transition matrix.
+        currentMatrixDerivative.block( 0, 0, totalDynamicalStateSize_, numberOfParameterValues_ ).setZero( );
+        for( unsigned int i = 0; i < translationalPositionRowIndices_.size( ); i++ )
+        {
+            currentMatrixDerivative.block( translationalPositionRowIndices_[ i ], 0, 3, numberOfParameterValues_ ) =
+                    stateTransitionAndSensitivityMatrices.block(
+                        translationalPositionRowIndices_[ i ] + 3, 0, 3, numberOfParameterValues_ );
+        }
+
+        // For all other rows, multiply only the blocks of the partial matrix that may be non-zero, grouped for all rows
+        // with the same sparsity pattern
+        for( unsigned int i = 0; i < statePartialProductRows_.size( ); i++ )
+        {
+            const std::vector< int >& currentRows = statePartialProductRows_[ i ];
+            const std::vector< std::pair< int, int > >& currentColumns = statePartialProductColumns_[ i ];
+
+            // Use fixed-size kernel for acceleration of single translational state, depending only on a single body
+            if( isTranslationalStatePartialProduct_[ i ] )
+            {
+                currentMatrixDerivative.block( currentRows[ 0 ], 0, 3, numberOfParameterValues_ ).noalias( ) =
+                        variationalMatrix_.template block< 3, 6 >( currentRows[ 0 ], currentColumns[ 0 ].first ).
+                        template cast< StateScalarType >( ) *
+                        stateTransitionAndSensitivityMatrices.template middleRows< 6 >( currentColumns[ 0 ].first );
+                continue;
+            }
+
+            Eigen::MatrixXd& currentPartials = statePartialProductMatrices_[ i ];
+
+            // Gather non-zero blocks of partial matrix
+            for( unsigned int j = 0; j < currentRows.size( ); j++ )
+            {
+                int columnOffset = 0;
+                for( unsigned int k = 0; k < currentColumns.size( ); k++ )
+                {
+                    currentPartials.block( j, columnOffset, 1, currentColumns[ k ].second ) =
+                            variationalMatrix_.block( currentRows[ j ], currentColumns[ k ].first, 1, currentColumns[ k ].second );
+                    columnOffset += currentColumns[ k ].second;
+                }
+            }
+
+            // Multiply with associated rows of state transition and sensitivity matrices, directly into each block of
+            // consecutive rows of the full matrix (which was set to zero above)
+            const std::vector< std::pair< int, int > >& currentRowBlocks = statePartialProductRowBlocks_[ i ];
+            for( unsigned int j = 0; j < currentRowBlocks.size( ); j++ )
+            {
+                int columnOffset = 0;
+                for( unsigned int k = 0; k < currentColumns.size( ); k++ )
+                {
+                    currentMatrixDerivative.block( currentRows[ currentRowBlocks[ j ].first ], 0,
+                                                   currentRowBlocks[ j ].second, numberOfParameterValues_ ).noalias( ) +=
+                            currentPartials.block( currentRowBlocks[ j ].first, columnOffset,
+                                                   currentRowBlocks[ j ].second, currentColumns[ k ].second ).
+                            template cast< StateScalarType >( ) *
+                            stateTransitionAndSensitivityMatrices.middleRows( currentColumns[ k ].first, currentColumns[ k ].second );
+                    columnOffset += currentColumns[ k ].second;
+                }
+            }
+        }
 
         if( couplingEntriesToSuppress_ > 0 )
         {
@@ -313,6 +370,17 @@ public:
         return numberOfParameterValues_;
     }
 
+    //! Function to retrieve the matrix of partial derivatives of state derivatives w.r.t. current states.
+    /*!
+     *  Function to retrieve the matrix of partial derivatives of state derivatives w.r.t. current states, as last computed
+     *  when evaluating the variational equations.
+     *  \return Matrix of partial derivatives of state derivatives w.r.t. current states.
+     */
+    Eigen::MatrixXd getStatePartialMatrix( )
+    {
+        return variationalMatrix_;
+    }
+
     std::vector< std::pair< int, int > > getStatePartialAdditionIndices( )
     {
         return statePartialAdditionIndices_;
@@ -334,6 +402,17 @@ private:
      */
     void setStatePartialFunctionList( );
 
+    //! Function (called by constructor) to determine which blocks of the state partial matrix may be non-zero
+    /*!
+     * Function (called by constructor) to determine which blocks of the matrix of partial derivatives of the state
+     * derivatives w.r.t. the current states (variationalMatrix_) may be non-zero, with the matrix divided into blocks per
+     * estimated body state. A block is non-zero if it contains the kinematic terms (translational and rotational states),
+     * if a state partial function is set for it in statePartialList_, or if it is filled by a column block addition
+     * (statePartialAdditionIndices_). Only these blocks are used when evaluating the variational equations, with the rows
+     * with the same sparsity pattern grouped, so that the product for each group is computed in a single evaluation.
+     */
+    void setStatePartialBlockPattern( );
+
     //! Function to add parameter partial functions for single state derivative model, and set of parameter objects.
     /*!
      *  Function to add parameter partial functions for single state derivative model, and set of parameter objects.
@@ -638,6 +717,25 @@ private:
     //! Total matrix of partial derivatives of state derivatives w.r.t. current states.
     Eigen::MatrixXd variationalMatrix_;
 
+    //! Start rows of position of translational states in variationalMatrix_ for which only the kinematic terms are non-zero
+    //! (copied from the velocity rows of the state transition matrix).
+    std::vector< int > translationalPositionRowIndices_;
+
+    //! Rows of variationalMatrix_ (other than translationalPositionRowIndices_), grouped by sparsity pattern.
+    std::vector< std::vector< int > > statePartialProductRows_;
+
+    //! Start index and size of column blocks that may be non-zero, for each group of rows in statePartialProductRows_.
+    std::vector< std::vector< std::pair< int, int > > > statePartialProductColumns_;
+
+    //! Index (in statePartialProductRows_) of first row and number of rows of each block of consecutive rows, per group.
+    std::vector< std::vector< std::pair< int, int > > > statePartialProductRowBlocks_;
+
+    //! Non-zero blocks of variationalMatrix_ for each group of rows in statePartialProductRows_ (gathered per evaluation).
+    std::vector< Eigen::MatrixXd > statePartialProductMatrices_;
+
+    //! Boolean per group of rows in statePartialProductRows_, denoting whether it consists of a single 3x6 block.
+    std::vector< bool > isTranslationalStatePartialProduct_;
+
     //! Total matrix of partial derivatives of state derivatives w.r.t. parameter vectors.
     Eigen::MatrixXd variationalParameterMatrix_;
 
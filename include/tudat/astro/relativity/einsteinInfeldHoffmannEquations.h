@@ -7,6 +7,7 @@
 
 #include <Eigen/Core>
 
+#include "tudat/basics/threadPool.h"
 #include "tudat/math/basic/mathematicalConstants.h"
 
 namespace tudat
@@ -37,49 +38,53 @@ public:
         return getAccelerationOfBody( acceleratedBodyMap_.at( bodyName ) );
     }
 
-    Eigen::Vector3d& getRelativePositions( const int bodyUndergoing, const int bodyExerting )
+    Eigen::Vector3d getRelativePositions( const int bodyUndergoing, const int bodyExerting )
     {
-        return currentRelativePositions_.at( bodyUndergoing ).at( bodyExerting );
+        return Eigen::Vector3d( relativePositionsX_( bodyExerting, bodyUndergoing ),
+                                relativePositionsY_( bodyExerting, bodyUndergoing ),
+                                relativePositionsZ_( bodyExerting, bodyUndergoing ) );
     }
 
     double getRelativeDistance( const int bodyUndergoing, const int bodyExerting )
     {
-        return currentRelativeDistances_.at( bodyUndergoing ).at( bodyExerting );
+        return relativeDistances_( bodyExerting, bodyUndergoing );
     }
 
     double getInverseSquareDistance( const int bodyUndergoing, const int bodyExerting )
     {
-        return currentInverseSquareDistances_.at( bodyUndergoing ).at( bodyExerting );
+        return inverseSquareDistances_( bodyExerting, bodyUndergoing );
     }
 
 
-    Eigen::Vector3d& getRelativeVelocity( const int bodyUndergoing, const int bodyExerting )
+    Eigen::Vector3d getRelativeVelocity( const int bodyUndergoing, const int bodyExerting )
     {
-        return currentRelativeVelocities_.at( bodyUndergoing ).at( bodyExerting );
+        return ( currentVelocities_.row( bodyExerting ) - currentVelocities_.row( bodyUndergoing ) ).transpose( );
     }
 
 
 
-    Eigen::Vector3d& getVelocity( const int bodyIndex )
+    Eigen::Vector3d getVelocity( const int bodyIndex )
     {
-        return currentVelocities_.at( bodyIndex );
+        return currentVelocities_.row( bodyIndex ).transpose( );
     }
 
     double getGravitationalParameter( const int bodyIndex )
     {
-        return currentGravitationalParameters_.at( bodyIndex );
+        return currentGravitationalParameters_( bodyIndex );
     }
 
 
 
     double getTotalScalarTermCorrection( const int bodyUndergoing, const int bodyExerting )
     {
-        return totalScalarTermCorrection.at( bodyUndergoing ).at( bodyExerting );
+        return totalScalarTermCorrection_( bodyExerting, bodyUndergoing );
     }
 
-    Eigen::Vector3d& getTotalVectorTermCorrection( const int bodyUndergoing, const int bodyExerting )
+    Eigen::Vector3d getTotalVectorTermCorrection( const int bodyUndergoing, const int bodyExerting )
     {
-        return totalVectorTermCorrection_.at( bodyUndergoing ).at( bodyExerting );
+        return Eigen::Vector3d( totalVectorTermCorrectionsX_( bodyExerting, bodyUndergoing ),
+                                totalVectorTermCorrectionsY_( bodyExerting, bodyUndergoing ),
+                                totalVectorTermCorrectionsZ_( bodyExerting, bodyUndergoing ) );
     }
 
 
@@ -87,49 +92,42 @@ public:
 
     double getSingleSourceLocalPotential( const int bodyUndergoing, const int bodyExerting )
     {
-        return currentSingleSourceLocalPotential_.at( bodyUndergoing ).at( bodyExerting );
+        return singleSourceLocalPotentials_( bodyExerting, bodyUndergoing );
     }
 
-    Eigen::Vector3d& getSinglePointMassAccelerations( const int bodyUndergoing, const int bodyExerting )
+    Eigen::Vector3d getSinglePointMassAccelerations( const int bodyUndergoing, const int bodyExerting )
     {
-        return singlePointMassAccelerations_.at( bodyUndergoing ).at( bodyExerting );
+        return Eigen::Vector3d( singlePointMassAccelerationsX_( bodyExerting, bodyUndergoing ),
+                                singlePointMassAccelerationsY_( bodyExerting, bodyUndergoing ),
+                                singlePointMassAccelerationsZ_( bodyExerting, bodyUndergoing ) );
     }
 
     double getLineOfSighSpeed( const int bodyUndergoing, const int bodyExerting )
     {
-        return lineOfSightSpeed_.at( bodyUndergoing ).at( bodyExerting );
+        return lineOfSightSpeeds_( bodyExerting, bodyUndergoing );
     }
 
     double getLocalPotential( const int bodyIndex )
     {
-        return currentLocalPotentials_.at( bodyIndex );
+        return currentLocalPotentials_( bodyIndex );
     }
 
-    Eigen::Vector3d& getTotalPointMassAcceleration( const int bodyIndex )
+    Eigen::Vector3d getTotalPointMassAcceleration( const int bodyIndex )
     {
-        return totalPointMassAccelerations_.at( bodyIndex );
+        return totalPointMassAccelerations_.row( bodyIndex ).transpose( );
     }
 
-    std::vector< std::vector< std::vector< double > > > getScalarEihCorrections( )
-    {
-        return scalarEihCorrections_;
-    }
+    std::vector< std::vector< std::vector< double > > > getScalarEihCorrections( );
 
     double getScalarEihCorrection( const int k, const int bodyUndergoing, const int bodyExerting )
     {
-        return scalarEihCorrections_.at( k ).at( bodyUndergoing ).at( bodyExerting );
+        return scalarEihCorrections_.at( k )( bodyExerting, bodyUndergoing );
     }
 
 
-    std::vector< std::vector< std::vector< Eigen::Vector3d > > > getVectorEihCorrections( )
-    {
-        return vectorEihCorrections_;
-    }
+    std::vector< std::vector< std::vector< Eigen::Vector3d > > > getVectorEihCorrections( );
 
-    Eigen::Vector3d getVectorEihCorrection( const int k, const int bodyUndergoing, const int bodyExerting )
-    {
-        return vectorEihCorrections_.at( k ).at( bodyUndergoing ).at( bodyExerting );
-    }
+    Eigen::Vector3d getVectorEihCorrection( const int k, const int bodyUndergoing, const int bodyExerting );
 
     std::vector< std::string > getBodiesUndergoingAcceleration( )
     {
@@ -171,14 +169,48 @@ public:
         return acceleratingBodyMap_;
     }
 
+    std::vector< std::function< double( ) > > getGravitationalParameterFunctions( )
+    {
+        return gravitationalParameterFunction_;
+    }
+
+    std::function< double( ) > getPpnGammaFunction( )
+    {
+        return ppnGammaFunction_;
+    }
+
+    std::function< double( ) > getPpnBetaFunction( )
+    {
+        return ppnBetaFunction_;
+    }
+
 
     void recomputeExpansionMultipliers( );
 
+    // Set number of threads over which the pair computations in update are distributed (sequential if 1)
+    void setNumberOfThreads( const unsigned int numberOfThreads );
+
+    void setThreadPool( const std::shared_ptr< utilities::ThreadPool > threadPool )
+    {
+        threadPool_ = threadPool;
+    }
+
+    std::shared_ptr< utilities::ThreadPool > getThreadPool( )
+    {
+        return threadPool_;
+    }
+
 
 private:
 
+    // Compute the symmetric pair geometry (r_{ij}, ||r_{ij}||, 1/||r_{ij}||^2) for all pairs (j > i) of body i
+    void calculatePairGeometry( const int bodyIndex );
 
-    void calculateAccelerations( );
+    // Compute the point-mass and velocity terms exerted on body i by all bodies, and their sums over the exerting bodies
+    void calculatePointMassTerms( const int bodyIndex );
+
+    // Compute the EIH corrections and acceleration exerted on body i by all bodies
+    void calculateAccelerations( const int bodyIndex );
 
     std::vector< std::string > acceleratedBodies_;
 
@@ -202,67 +234,79 @@ private:
     std::map< std::string, int > acceleratingBodyMap_;
 
 
+    // Pair quantities are stored in matrices with one column per body undergoing acceleration (i) and one row per body
+    // exerting acceleration (j), so that the sums over the exerting bodies are contiguous (vectorized) column operations.
+
     // mu_{i}
-    std::vector< double > currentGravitationalParameters_;
+    Eigen::VectorXd currentGravitationalParameters_;
 
-    // v_{i}
-    std::vector< Eigen::Vector3d > currentVelocities_;
+    // v_{i} (one row per body)
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > currentVelocities_;
 
-    // r_{i}
-    std::vector< Eigen::Vector3d > currentPositions_;
+    // r_{i} (one row per body)
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > currentPositions_;
 
     // v_{i} * v_{i}
-    std::vector< double > currentSquareSpeeds_;
+    Eigen::VectorXd currentSquareSpeeds_;
 
 
 
-    // sum_(j not i) ( mu_j / ||r_{ij}|| ) = sum( currentSingleSourceLocalPotential_ )
-    std::vector< double > currentLocalPotentials_;
+    // sum_(j not i) ( mu_j / ||r_{ij}|| ) = sum( singleSourceLocalPotentials_ )
+    Eigen::VectorXd currentLocalPotentials_;
 
-    // sum_(j not i) ( mu_{j} * r_{ij} / ||r_{ij}||^3 ) = sum( singlePointMassAccelerations_ )
-    std::vector< Eigen::Vector3d > totalPointMassAccelerations_;
+    // sum_(j not i) ( mu_{j} * r_{ij} / ||r_{ij}||^3 ) = sum( singlePointMassAccelerations_ ) (one row per body)
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > totalPointMassAccelerations_;
 
 
 
     // r_{ij} = r_{j} - r_{i}
-    std::vector< std::vector< Eigen::Vector3d > > currentRelativePositions_;
+    Eigen::MatrixXd relativePositionsX_;
 
-    // v_{ij} = v_{j} - v_{i}
-    std::vector< std::vector< Eigen::Vector3d > > currentRelativeVelocities_;
+    Eigen::MatrixXd relativePositionsY_;
+
+    Eigen::MatrixXd relativePositionsZ_;
 
     // || r_{ij} ||
-    std::vector< std::vector< double > > currentRelativeDistances_;
+    Eigen::MatrixXd relativeDistances_;
+
+    // 1  / || r_{ij} ||
+    Eigen::MatrixXd inverseDistances_;
 
     // 1  / || r_{ij} ||^2
-    std::vector< std::vector< double > > currentInverseSquareDistances_;
+    Eigen::MatrixXd inverseSquareDistances_;
 
     // r_{ij} * v_{j}
-    std::vector< std::vector< double > > lineOfSightSpeed_;
-
-    // v_{i} * v_{j}
-    std::vector< std::vector< double > > velocityInnerProducts_;
+    Eigen::MatrixXd lineOfSightSpeeds_;
 
     // mu_j / ||r_{ij}||
-    std::vector< std::vector< double > > currentSingleSourceLocalPotential_;
+    Eigen::MatrixXd singleSourceLocalPotentials_;
 
     // mu_{j} * r_{ij} / ||r_{ij}||^3
-    std::vector< std::vector< Eigen::Vector3d > > singlePointMassAccelerations_;
+    Eigen::MatrixXd singlePointMassAccelerationsX_;
+
+    Eigen::MatrixXd singlePointMassAccelerationsY_;
 
+    Eigen::MatrixXd singlePointMassAccelerationsZ_;
 
+    Eigen::MatrixXd totalScalarTermCorrection_;
 
-    std::vector< std::vector< Eigen::Vector3d > > currentSingleAccelerations_;
+    Eigen::MatrixXd totalVectorTermCorrectionsX_;
 
-    std::vector< std::vector< double > > totalScalarTermCorrection;
+    Eigen::MatrixXd totalVectorTermCorrectionsY_;
 
-    std::vector< std::vector< Eigen::Vector3d > > totalVectorTermCorrection_;
+    Eigen::MatrixXd totalVectorTermCorrectionsZ_;
 
     std::vector< Eigen::Vector3d > currentAccelerations_;
 
 
 
-    std::vector< std::vector< std::vector< double > > > scalarEihCorrections_;
+    std::vector< Eigen::MatrixXd > scalarEihCorrections_;
+
+    // Scalar multipliers of v_{j} - v_{i} in vector corrections 0 and 1 (vector correction 2 is proportional to the
+    // total point-mass acceleration of body j)
+    std::vector< Eigen::MatrixXd > vectorEihCorrectionMultipliers_;
 
-    std::vector< std::vector< std::vector< Eigen::Vector3d > > > vectorEihCorrections_;
+    std::shared_ptr< utilities::ThreadPool > threadPool_;
 
 
     double currentPpnGamma_;
@@ -0,0 +1,401 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_CONTIGUOUSSTATEHISTORY_H
+#define TUDAT_CONTIGUOUSSTATEHISTORY_H
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Container for a time history of equally-sized vectors/matrices, stored in contiguous memory.
+/*!
+ *  Container for a time history of equally-sized vectors/matrices, stored in contiguous memory. The epochs are stored in a
+ *  single vector, and the entries are stored (column-major, one after the other) in a single data vector, which may
+ *  alternatively be accessed as a matrix with one column per epoch. This prevents the memory allocation per epoch that is
+ *  incurred by storing the history as a std::map with vector values, and improves cache locality when processing the
+ *  history. New entries are appended with amortized constant cost (no allocation takes place as long as the capacity of the
+ *  container is sufficient; the capacity is retained when clearing the container). The entries are typically appended in
+ *  the order in which they are computed by a numerical integrator, which may be in increasing or decreasing order of time;
+ *  the sortByTime function may be used to order the entries in increasing time afterwards. As with a std::map, adding an
+ *  entry at an epoch that is already in the history overwrites the existing entry. The getMap function may be used to
+ *  retrieve the history in the 'conventional' (map) form.
+ */
+template< typename TimeType, typename ScalarType, int NumberOfColumns = 1 >
+class ContiguousStateHistory
+{
+public:
+
+    //! Typedef for single entry of the history.
+    typedef Eigen::Matrix< ScalarType, Eigen::Dynamic, NumberOfColumns > EntryType;
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param numberOfRows Number of rows of each entry in the history (-1 if to be determined from first entry)
+     * \param numberOfColumns Number of columns of each entry in the history (-1 if to be determined from first entry)
+     */
+    ContiguousStateHistory( const int numberOfRows = -1, const int numberOfColumns = -1 ):
+        numberOfRows_( numberOfRows ), numberOfColumns_( numberOfColumns )
+    {
+        if( NumberOfColumns != Eigen::Dynamic && numberOfColumns_ < 0 )
+        {
+            numberOfColumns_ = NumberOfColumns;
+        }
+    }
+
+    //! Function to reserve memory for a given number of entries.
+    /*!
+     * Function to reserve memory for a given number of entries. If the size of the entries is not yet known, only the
+     * memory for the epochs is reserved.
+     * \param numberOfEntries Number of entries for which memory is to be reserved.
+     */
+    void reserve( const unsigned int numberOfEntries )
+    {
+        times_.reserve( numberOfEntries );
+        if( isEntrySizeSet( ) )
+        {
+            values_.reserve( numberOfEntries * getEntrySize( ) );
+        }
+    }
+
+    //! Function to remove all entries from the history, retaining the allocated memory.
+    void clear( )
+    {
+        times_.clear( );
+        values_.clear( );
+    }
+
+    //! Function to add an entry to the history.
+    /*!
+     * Function to add an entry to the history. If the epoch is beyond the current final epoch (in the order in which the entries
+     * have been added), the entry is appended at amortized constant cost. If an entry already exists at the given epoch, it is
+     * overwritten. Otherwise, the entry is inserted at its sorted position.
+     * \param time Epoch of the entry
+     * \param entry Entry that is to be added
+     */
+    template< typename Derived >
+    void addEntry( const TimeType time, const Eigen::MatrixBase< Derived >& entry )
+    {
+        if( !isEntrySizeSet( ) || times_.size( ) == 0 )
+        {
+            numberOfRows_ = entry.rows( );
+            numberOfColumns_ = entry.cols( );
+        }
+        else if( entry.rows( ) != numberOfRows_ || entry.cols( ) != numberOfColumns_ )
+        {
+            throw std::runtime_error( "Error when adding entry to state history; entry size (" + std::to_string( entry.rows( ) ) +
+                                      ", " + std::to_string( entry.cols( ) ) + ") is inconsistent with history (" +
+                                      std::to_string( numberOfRows_ ) + ", " + std::to_string( numberOfColumns_ ) + ")" );
+        }
+
+        int entryIndex = getIndexForNewEntry( time );
+        if( entryIndex < 0 )
+        {
+            // Add entry to end of history
+            entryIndex = times_.size( );
+            times_.push_back( time );
+            values_.resize( values_.size( ) + getEntrySize( ) );
+        }
+        else if( times_.at( entryIndex ) != time )
+        {
+            // Insert entry in middle of history
+            times_.insert( times_.begin( ) + entryIndex, time );
+            values_.insert( values_.begin( ) + entryIndex * getEntrySize( ), getEntrySize( ), ScalarType( 0 ) );
+        }
+
+        Eigen::Map< Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic > >(
+                    values_.data( ) + entryIndex * getEntrySize( ), numberOfRows_, numberOfColumns_ ) = entry;
+    }
+
+    //! Function to add a scalar entry to the history (for histories with 1x1 entries)
+    /*!
+     * Function to add a scalar entry to the history (for histories with 1x1 entries), see addEntry.
+     * \param time Epoch of the entry
+     * \param entry Entry that is to be added
+     */
+    void addScalarEntry( const TimeType time, const ScalarType entry )
+    {
+        addEntry( time, Eigen::Matrix< ScalarType, 1, 1 >::Constant( entry ) );
+    }
+
+    //! Function to remove the entry that was added last (i.e. the final entry in the order in which the history is stored).
+    void removeLastEntry( )
+    {
+        if( times_.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error when removing last entry of state history; history is empty" );
+        }
+        times_.pop_back( );
+        values_.resize( values_.size( ) - getEntrySize( ) );
+    }
+
+    //! Function to order the entries in increasing time.
+    /*!
+     * Function to order the entries in increasing time. Since entries are always stored in monotonic order (see addEntry), this
+     * amounts to reversing the order of the entries when they are stored in decreasing order.
+     */
+    void sortByTime( )
+    {
+        if( times_.size( ) > 1 && times_.front( ) > times_.back( ) )
+        {
+            std::reverse( times_.begin( ), times_.end( ) );
+
+            const int entrySize = getEntrySize( );
+            const int numberOfEntries = times_.size( );
+            for( int i = 0; i < numberOfEntries / 2; i++ )
+            {
+                std::swap_ranges( values_.begin( ) + i * entrySize, values_.begin( ) + ( i + 1 ) * entrySize,
+                                  values_.begin( ) + ( numberOfEntries - 1 - i ) * entrySize );
+            }
+        }
+    }
+
+    //! Function to merge another history into the current history.
+    /*!
+     * Function to merge another history into the current history. Both histories are ordered in increasing time before the
+     * merge. For epochs that exist in both histories, the entry of the current history is retained (consistent with
+     * std::map::insert).
+     * \param historyToMerge History that is to be merged into the current history.
+     */
+    void merge( ContiguousStateHistory< TimeType, ScalarType, NumberOfColumns > historyToMerge )
+    {
+        if( historyToMerge.size( ) == 0 )
+        {
+            return;
+        }
+        else if( times_.size( ) == 0 )
+        {
+            *this = std::move( historyToMerge );
+            sortByTime( );
+            return;
+        }
+        else if( historyToMerge.getNumberOfRows( ) != numberOfRows_ || historyToMerge.getNumberOfColumns( ) != numberOfColumns_ )
+        {
+            throw std::runtime_error( "Error when merging state histories; entry sizes are inconsistent" );
+        }
+
+        sortByTime( );
+        historyToMerge.sortByTime( );
+
+        const int entrySize = getEntrySize( );
+        std::vector< TimeType > mergedTimes;
+        std::vector< ScalarType > mergedValues;
+        mergedTimes.reserve( times_.size( ) + historyToMerge.size( ) );
+        mergedValues.reserve( values_.size( ) + historyToMerge.values_.size( ) );
+
+        unsigned int currentIndex = 0, otherIndex = 0;
+        while( currentIndex < times_.size( ) || otherIndex < historyToMerge.size( ) )
+        {
+            // Skip entry of other history if epoch is also in current history
+            if( currentIndex < times_.size( ) && otherIndex < historyToMerge.size( ) &&
+                    times_.at( currentIndex ) == historyToMerge.times_.at( otherIndex ) )
+            {
+                otherIndex++;
+                continue;
+            }
+
+            bool useCurrentEntry = ( otherIndex >= historyToMerge.size( ) ) ||
+                    ( currentIndex < times_.size( ) && times_.at( currentIndex ) < historyToMerge.times_.at( otherIndex ) );
+
+            if( useCurrentEntry )
+            {
+                mergedTimes.push_back( times_.at( currentIndex ) );
+                mergedValues.insert( mergedValues.end( ), values_.begin( ) + currentIndex * entrySize,
+                                     values_.begin( ) + ( currentIndex + 1 ) * entrySize );
+                currentIndex++;
+            }
+            else
+            {
+                mergedTimes.push_back( historyToMerge.times_.at( otherIndex ) );
+                mergedValues.insert( mergedValues.end( ), historyToMerge.values_.begin( ) + otherIndex * entrySize,
+                                     historyToMerge.values_.begin( ) + ( otherIndex + 1 ) * entrySize );
+                otherIndex++;
+            }
+        }
+
+        times_.swap( mergedTimes );
+        values_.swap( mergedValues );
+    }
+
+    //! Function to retrieve the number of entries in the history.
+    unsigned int size( ) const
+    {
+        return times_.size( );
+    }
+
+    //! Function to retrieve the number of rows of each entry.
+    int getNumberOfRows( ) const
+    {
+        return numberOfRows_;
+    }
+
+    //! Function to retrieve the number of columns of each entry.
+    int getNumberOfColumns( ) const
+    {
+        return numberOfColumns_;
+    }
+
+    //! Function to retrieve the epochs of all entries, in the order in which they are stored.
+    const std::vector< TimeType >& getTimes( ) const
+    {
+        return times_;
+    }
+
+    //! Function to retrieve the epoch of a single entry.
+    const TimeType& getTime( const unsigned int index ) const
+    {
+        return times_.at( index );
+    }
+
+    //! Function to retrieve a single entry of the history (without copying the data).
+    /*!
+     * Function to retrieve a single entry of the history (without copying the data).
+     * \param index Index of the entry (in the order in which the entries are stored)
+     * \return Entry at given index
+     */
+    Eigen::Map< const EntryType > getEntry( const unsigned int index ) const
+    {
+        if( index >= times_.size( ) )
+        {
+            throw std::runtime_error( "Error when retrieving entry " + std::to_string( index ) + " of state history of size " +
+                                      std::to_string( times_.size( ) ) );
+        }
+        return Eigen::Map< const EntryType >( values_.data( ) + index * getEntrySize( ), numberOfRows_, numberOfColumns_ );
+    }
+
+    //! Function to retrieve all entries as a single matrix (without copying the data).
+    /*!
+     * Function to retrieve all entries as a single matrix (without copying the data), with each column containing a single
+     * entry (matrix entries are provided column-major).
+     * \return Matrix with all entries of the history
+     */
+    Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic > > getValuesMatrix( ) const
+    {
+        return Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic > >(
+                    values_.data( ), ( times_.size( ) > 0 ) ? getEntrySize( ) : 0, times_.size( ) );
+    }
+
+    //! Function to retrieve the history as a map, with the epoch as key
+    std::map< TimeType, EntryType > getMap( ) const
+    {
+        std::map< TimeType, EntryType > historyMap;
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            historyMap[ times_.at( i ) ] = getEntry( i );
+        }
+        return historyMap;
+    }
+
+    //! Function to retrieve the history as a map, with the epoch as key (for histories with 1x1 entries).
+    std::map< TimeType, ScalarType > getScalarMap( ) const
+    {
+        std::map< TimeType, ScalarType > historyMap;
+        for( unsigned int i = 0; i < times_.size( ); i++ )
+        {
+            historyMap[ times_.at( i ) ] = values_.at( i * getEntrySize( ) );
+        }
+        return historyMap;
+    }
+
+    //! Function to reset the history from a map, with the epoch as key
+    template< typename MapEntryType >
+    void setFromMap( const std::map< TimeType, MapEntryType >& historyMap )
+    {
+        clear( );
+        if( historyMap.size( ) > 0 )
+        {
+            numberOfRows_ = historyMap.begin( )->second.rows( );
+            numberOfColumns_ = historyMap.begin( )->second.cols( );
+            reserve( historyMap.size( ) );
+        }
+        for( auto it : historyMap )
+        {
+            addEntry( it.first, it.second );
+        }
+    }
+
+private:
+
+    bool isEntrySizeSet( ) const
+    {
+        return ( numberOfRows_ >= 0 && numberOfColumns_ >= 0 );
+    }
+
+    int getEntrySize( ) const
+    {
+        return numberOfRows_ * numberOfColumns_;
+    }
+
+    //! Function to determine where a new entry is to be added (-1 if at end of history)
+    int getIndexForNewEntry( const TimeType time ) const
+    {
+        if( times_.size( ) == 0 )
+        {
+            return -1;
+        }
+        else if( times_.back( ) == time )
+        {
+            return times_.size( ) - 1;
+        }
+        else if( times_.size( ) == 1 )
+        {
+            return -1;
+        }
+
+        // Check if new entry continues monotonic history
+        bool isIncreasing = ( times_.front( ) < times_.back( ) );
+        if( ( isIncreasing && times_.back( ) < time ) || ( !isIncreasing && time < times_.back( ) ) )
+        {
+            return -1;
+        }
+
+        // Find position in history
+        typename std::vector< TimeType >::const_iterator entryIterator;
+        if( isIncreasing )
+        {
+            entryIterator = std::lower_bound( times_.begin( ), times_.end( ), time );
+        }
+        else
+        {
+            entryIterator = std::lower_bound( times_.begin( ), times_.end( ), time,
+                                              []( const TimeType& first, const TimeType& second ){ return second < first; } );
+        }
+        return static_cast< int >( entryIterator - times_.begin( ) );
+    }
+
+    //! Epochs of entries
+    std::vector< TimeType > times_;
+
+    //! Concatenated values of entries
+    std::vector< ScalarType > values_;
+
+    //! Number of rows of each entry
+    int numberOfRows_;
+
+    //! Number of columns of each entry
+    int numberOfColumns_;
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_CONTIGUOUSSTATEHISTORY_H
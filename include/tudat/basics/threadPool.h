@@ -0,0 +1,159 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_THREADPOOL_H
+#define TUDAT_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to retrieve the number of hardware threads available on the current machine.
+/*!
+ * Function to retrieve the number of hardware threads available on the current machine. If this number cannot be determined,
+ * a value of 1 is returned.
+ * \return Number of hardware threads available on the current machine.
+ */
+unsigned int getNumberOfAvailableThreads( );
+
+//! Persistent pool of worker threads, used to distribute a list of independent tasks over a number of threads.
+/*!
+ *  Persistent pool of worker threads, used to distribute a list of independent tasks over a number of threads. The threads are
+ *  created once (upon construction), and are reused for each call to runParallelTasks. Tasks are distributed dynamically: each
+ *  thread retrieves the next task index from a shared atomic counter once it has finished its current task, so that tasks of
+ *  unequal cost are balanced automatically. The calling thread participates in the work (as thread index 0), so that a pool
+ *  with N threads creates N - 1 additional threads. Each task function receives the index of the thread on which it is executed,
+ *  which allows the user to provide per-thread (non-shared) work objects and caches. A single task list is distributed over the
+ *  pool at a time: if runParallelTasks is called while the pool is processing another task list (concurrently from a different
+ *  thread, or from within a task), the new task list is executed serially on the calling thread (as thread index 0). Per-thread
+ *  work objects must therefore be owned by the caller of runParallelTasks, and not shared between different callers of the pool.
+ */
+class ThreadPool
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param numberOfThreads Total number of threads (including the calling thread) over which tasks are distributed. If
+     * equal to 0, the number of available hardware threads is used.
+     */
+    ThreadPool( const unsigned int numberOfThreads = 0 );
+
+    //! Destructor, terminates and joins all worker threads.
+    ~ThreadPool( );
+
+    ThreadPool( const ThreadPool& ) = delete;
+
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    //! Function to execute a list of independent tasks, distributed over all threads of the pool.
+    /*!
+     * Function to execute a list of independent tasks, distributed over all threads of the pool. This function returns once all
+     * tasks have completed. If one or more tasks throw an exception, the remaining tasks are skipped, and the first exception
+     * that was thrown is rethrown on the calling thread. If the pool is already processing a task list, the tasks are executed
+     * serially on the calling thread instead.
+     * \param numberOfTasks Number of tasks that are to be executed
+     * \param taskFunction Function executing a single task, with as input the index of the task (from 0 to numberOfTasks - 1)
+     * and the index of the thread on which the task is executed (from 0 to getNumberOfThreads( ) - 1).
+     */
+    void runParallelTasks( const int numberOfTasks,
+                           const std::function< void( const int, const unsigned int ) >& taskFunction );
+
+    //! Function to retrieve the total number of threads (including the calling thread) of the pool.
+    /*!
+     * Function to retrieve the total number of threads (including the calling thread) of the pool.
+     * \return Total number of threads of the pool.
+     */
+    unsigned int getNumberOfThreads( ) const
+    {
+        return numberOfThreads_;
+    }
+
+private:
+
+    //! Function run by each worker thread, waiting for and executing work until the pool is destroyed.
+    void runWorkerThread( const unsigned int threadIndex );
+
+    //! Function that executes tasks from the current task list, until no tasks remain.
+    void executeAvailableTasks( const unsigned int threadIndex );
+
+    //! Total number of threads (including the calling thread).
+    unsigned int numberOfThreads_;
+
+    //! Worker threads (number of threads minus one).
+    std::vector< std::thread > workerThreads_;
+
+    //! Mutex protecting the state of the current task list and the termination flag.
+    std::mutex poolMutex_;
+
+    //! Condition variable used to signal worker threads that new work is available.
+    std::condition_variable workAvailableCondition_;
+
+    //! Condition variable used to signal the calling thread that all worker threads are finished.
+    std::condition_variable workFinishedCondition_;
+
+    //! Function executing a single task of the current task list.
+    const std::function< void( const int, const unsigned int ) >* currentTaskFunction_;
+
+    //! Number of tasks in current task list.
+    int numberOfTasks_;
+
+    //! Index of next task that is to be executed.
+    std::atomic< int > nextTaskIndex_;
+
+    //! Counter that is incremented each time a new task list is provided, used by worker threads to detect new work.
+    unsigned long taskListCounter_;
+
+    //! Number of worker threads that are still executing the current task list.
+    unsigned int numberOfActiveWorkers_;
+
+    //! Boolean denoting whether the worker threads are to terminate.
+    bool terminatePool_;
+
+    //! First exception that was thrown by a task of the current task list (if any).
+    std::exception_ptr taskException_;
+
+    //! Boolean denoting whether a task of the current task list has thrown an exception.
+    std::atomic< bool > isTaskExceptionThrown_;
+
+    //! Boolean denoting whether the pool is currently processing a task list.
+    std::atomic< bool > isProcessingTaskList_;
+};
+
+//! Function to execute a list of independent tasks, either serially or using a thread pool.
+/*!
+ * Function to execute a list of independent tasks, either serially (if threadPool is a nullptr, or has only a single thread)
+ * or distributed over the threads of a thread pool.
+ * \param threadPool Thread pool used to execute the tasks (may be nullptr)
+ * \param numberOfTasks Number of tasks that are to be executed
+ * \param taskFunction Function executing a single task, with as input the index of the task and the index of the thread on
+ * which the task is executed (always 0 when executing serially).
+ */
+void runTasks( const std::shared_ptr< ThreadPool > threadPool,
+               const int numberOfTasks,
+               const std::function< void( const int, const unsigned int ) >& taskFunction );
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_THREADPOOL_H
@@ -0,0 +1,195 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_TIMINGPROFILER_H
+#define TUDAT_TIMINGPROFILER_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Accumulated wall clock time and number of calls of a single profiled function.
+struct TimingProfileEntry
+{
+    //! Constructor
+    /*!
+     * Constructor
+     * \param category Category of the profiled function (e.g. acceleration, environment_update)
+     * \param name Name of the profiled function within its category (e.g. the acceleration type and bodies involved)
+     */
+    TimingProfileEntry( const std::string& category, const std::string& name ):
+        category_( category ), name_( name ), numberOfCalls_( 0 ),
+        totalTime_( std::chrono::steady_clock::duration::zero( ) ){ }
+
+    //! Category of the profiled function.
+    std::string category_;
+
+    //! Name of the profiled function within its category.
+    std::string name_;
+
+    //! Number of calls to the profiled function.
+    unsigned long numberOfCalls_;
+
+    //! Total wall clock time spent in the profiled function.
+    std::chrono::steady_clock::duration totalTime_;
+};
+
+//! Class that accumulates the wall clock time spent in a list of profiled functions.
+/*!
+ *  Class that accumulates the wall clock time spent in a list of profiled functions, and the number of calls to each. Each
+ *  function that is to be profiled is registered once using addEntry (typically when setting up a propagation), after which
+ *  each call is timed using a ScopedTimingMeasurement object. When the profiler is disabled, the measurements reduce to a
+ *  single check of a boolean. Entries are never merged, so that different entries may be updated concurrently from different
+ *  threads (but a single entry may not).
+ */
+class TimingProfiler
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param isEnabled Boolean denoting whether the timing measurements are to be performed
+     */
+    TimingProfiler( const bool isEnabled = true ):
+        isEnabled_( isEnabled ){ }
+
+    //! Function to register a new profiled function.
+    /*!
+     * Function to register a new profiled function. Must not be called while a measurement is ongoing.
+     * \param category Category of the profiled function (e.g. acceleration, environment_update)
+     * \param name Name of the profiled function within its category
+     * \return Index of the new entry, to be used for the timing measurements
+     */
+    int addEntry( const std::string& category, const std::string& name );
+
+    //! Function to add the duration of a single call to a profiled function.
+    void addTime( const int entryIndex, const std::chrono::steady_clock::duration duration )
+    {
+        entries_[ entryIndex ].numberOfCalls_++;
+        entries_[ entryIndex ].totalTime_ += duration;
+    }
+
+    //! Function to set the accumulated time and number of calls of a profiled function (e.g. for derived quantities).
+    void setTime( const int entryIndex, const unsigned long numberOfCalls, const std::chrono::steady_clock::duration duration );
+
+    //! Function to reset the accumulated times and number of calls of all entries to zero.
+    void resetTimes( );
+
+    //! Function to enable or disable the timing measurements.
+    void setIsEnabled( const bool isEnabled )
+    {
+        isEnabled_ = isEnabled;
+    }
+
+    //! Function to retrieve whether the timing measurements are performed.
+    bool isEnabled( ) const
+    {
+        return isEnabled_;
+    }
+
+    //! Function to retrieve all entries of the profiler, in the order in which they were registered.
+    const std::vector< TimingProfileEntry >& getEntries( ) const
+    {
+        return entries_;
+    }
+
+    //! Function to retrieve the total time (in seconds) spent in a single profiled function.
+    double getTotalTime( const int entryIndex ) const;
+
+    //! Function to retrieve the total time (in seconds) spent in all profiled functions of a given category.
+    double getTotalTimeOfCategory( const std::string& category ) const;
+
+    //! Function to retrieve the total time (in seconds) spent in each profiled function of a given category, with name as key.
+    std::map< std::string, double > getTimeBreakdownOfCategory( const std::string& category ) const;
+
+    //! Function to write the timing breakdown to a stream, in comma-separated format.
+    /*!
+     * Function to write the timing breakdown to a stream, in comma-separated format, with a header line and one line per
+     * entry, giving the category, name, number of calls, total time [s] and mean time per call [s].
+     * \param outputStream Stream to which the breakdown is written
+     */
+    void writeTimingBreakdown( std::ostream& outputStream ) const;
+
+    //! Function to write the timing breakdown to a file, in comma-separated format (see writeTimingBreakdown).
+    void writeTimingBreakdownToFile( const std::string& fileName ) const;
+
+private:
+
+    //! Boolean denoting whether the timing measurements are to be performed.
+    bool isEnabled_;
+
+    //! List of profiled functions, with their accumulated times.
+    std::vector< TimingProfileEntry > entries_;
+};
+
+//! Class that measures the wall clock time between its construction and destruction, and adds it to a profiler entry.
+/*!
+ *  Class that measures the wall clock time between its construction and destruction, and adds it to a profiler entry. If
+ *  the profiler is a nullptr, or is disabled, no measurement is performed.
+ */
+class ScopedTimingMeasurement
+{
+public:
+
+    //! Constructor, starts the measurement.
+    /*!
+     * Constructor, starts the measurement.
+     * \param profiler Profiler to which the measured time is to be added (may be nullptr)
+     * \param entryIndex Index of the profiled function in the profiler
+     */
+    ScopedTimingMeasurement( TimingProfiler* profiler, const int entryIndex ):
+        profiler_( ( profiler != nullptr && profiler->isEnabled( ) ) ? profiler : nullptr ), entryIndex_( entryIndex )
+    {
+        if( profiler_ != nullptr )
+        {
+            startTime_ = std::chrono::steady_clock::now( );
+        }
+    }
+
+    //! Destructor, stops the measurement and adds the measured time to the profiler.
+    ~ScopedTimingMeasurement( )
+    {
+        if( profiler_ != nullptr )
+        {
+            profiler_->addTime( entryIndex_, std::chrono::steady_clock::now( ) - startTime_ );
+        }
+    }
+
+    ScopedTimingMeasurement( const ScopedTimingMeasurement& ) = delete;
+
+    ScopedTimingMeasurement& operator=( const ScopedTimingMeasurement& ) = delete;
+
+private:
+
+    //! Profiler to which the measured time is to be added (nullptr if no measurement is performed).
+    TimingProfiler* profiler_;
+
+    //! Index of the profiled function in the profiler.
+    int entryIndex_;
+
+    //! Time at which the measurement was started.
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_TIMINGPROFILER_H
@@ -30,10 +30,11 @@ static std::map< AvailableIntegrators, std::string > integratorTypes =
     { rungeKuttaVariableStepSize, "rungeKuttaVariableStepSize" },
     { adamsBashforthMoulton, "adamsBashforthMoulton" },
     { bulirschStoer, "bulirschStoer" },
+    { taylorSeries, "taylorSeries" },
 };
 
 //! `AvailableIntegrators` not supported by `json_interface`.
-static std::vector< AvailableIntegrators > unsupportedIntegratorTypes = { };
+static std::vector< AvailableIntegrators > unsupportedIntegratorTypes = { taylorSeries };
 
 //! Convert `AvailableIntegrators` to `json`.
 inline void to_json( nlohmann::json& jsonObject, const AvailableIntegrators& availableIntegrator )
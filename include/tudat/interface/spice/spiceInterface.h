@@ -24,6 +24,7 @@
 #ifndef TUDAT_SPICE_INTERFACE_H
 #define TUDAT_SPICE_INTERFACE_H
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -44,6 +45,18 @@ namespace tudat {
 
 namespace spice_interface {
 
+//! Function to retrieve the mutex used to serialize calls to (non-reentrant) CSPICE routines.
+/*!
+ * Function to retrieve the mutex used to serialize calls to CSPICE routines. CSPICE is not reentrant (and its error status
+ * is global), so that all functions in this interface, which may be called concurrently when evaluating observations or
+ * propagations in parallel, lock this mutex while calling CSPICE and checking its error status. Code calling CSPICE
+ * directly should do the same, without calling functions of this interface while holding the lock. On first use, this
+ * function sets the Spice error action to RETURN, so that Spice errors are converted to exceptions rather than terminating
+ * the program.
+ * \return Mutex used to serialize calls to CSPICE routines
+ */
+std::mutex& getSpiceMutex( );
+
 //! @get_docstring(convert_julian_date_to_ephemeris_time)
 double convertJulianDateToEphemerisTime(const double julianDate);
 
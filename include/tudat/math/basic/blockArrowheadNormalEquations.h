@@ -0,0 +1,172 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_BLOCK_ARROWHEAD_NORMAL_EQUATIONS_H
+#define TUDAT_BLOCK_ARROWHEAD_NORMAL_EQUATIONS_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace linear_algebra
+{
+
+//! Class for the accumulation and solution of least-squares normal equations with a block-arrowhead structure.
+/*!
+ *  Class for the accumulation and solution of least-squares normal equations with a block-arrowhead structure, as occur in
+ *  multi-arc estimation. The parameter vector is split into a number of arc-local sets of parameters (typically the
+ *  arc-wise initial states), and the remaining global parameters. An observation may depend on the global parameters and
+ *  on the parameters of at most one arc, so that the normal matrix consists of a diagonal block per arc, a diagonal
+ *  block for the global parameters, and coupling blocks between each arc and the global parameters. Only these blocks are
+ *  stored.
+ *
+ *  Observations are added one block of rows at a time (addObservations), so that the full design matrix need never be
+ *  stored. The normal equations are solved by first eliminating the arc-local parameters (Schur complement), solving the
+ *  reduced system for the global parameters, and then back-substituting to obtain the arc-local parameters. The cost of the
+ *  solution therefore scales linearly with the number of arcs, rather than cubically.
+ *
+ *  The columns of the design matrix may be normalized after accumulation (see getDesignMatrixNormalizationTerms and
+ *  normalize), in the same manner as is done for the full design matrix during orbit determination.
+ */
+class BlockArrowheadNormalEquations
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param numberOfParameters Total number of parameters (columns of the design matrix).
+     * \param arcParameterIndices List (per arc) of the indices of the arc-local parameters. Each parameter may be assigned to
+     * at most one arc; all parameters not assigned to any arc are treated as global parameters.
+     */
+    BlockArrowheadNormalEquations( const int numberOfParameters,
+                                   const std::vector< std::vector< int > >& arcParameterIndices );
+
+    //! Function to reset all accumulated normal equations (and column extrema) to zero.
+    void reset( );
+
+    //! Function to add the contribution of a block of observations to the normal equations.
+    /*!
+     * Function to add the contribution of a block of observations to the normal equations. Each row of the partials may have
+     * non-zero entries for the global parameters, and for the parameters of at most one arc (an exception is thrown
+     * otherwise).
+     * \param partials Partial derivatives of the observations (rows) w.r.t. the parameters (columns)
+     * \param residuals Observation residuals (observed minus computed)
+     * \param weights Diagonal of the observation weights matrix
+     */
+    void addObservations( const Eigen::MatrixXd& partials,
+                          const Eigen::VectorXd& residuals,
+                          const Eigen::VectorXd& weights );
+
+    //! Function to add normal equations accumulated by another object (with identical structure) to this object.
+    /*!
+     * Function to add normal equations accumulated by another object (with identical structure) to this object, for instance
+     * to combine normal equations that were accumulated on separate threads.
+     * \param normalEquations Normal equations that are to be added to this object.
+     */
+    void add( const BlockArrowheadNormalEquations& normalEquations );
+
+    //! Function to add a matrix (e.g. the inverse a priori covariance) to the normal matrix.
+    /*!
+     * Function to add a matrix (e.g. the inverse a priori covariance) to the normal matrix. The matrix must not have any
+     * non-zero entries coupling different arcs (an exception is thrown otherwise).
+     * \param matrixToAdd Square matrix, of size equal to the number of parameters, that is to be added to the normal matrix.
+     */
+    void addToNormalMatrix( const Eigen::MatrixXd& matrixToAdd );
+
+    //! Function to retrieve the normalization terms of the columns of the design matrix.
+    /*!
+     * Function to retrieve the normalization terms of the columns of the design matrix, equal to the entry with largest
+     * absolute value (including its sign) of each column of all observation partials that have been added so far (or 1 if a
+     * column is fully zero). These are identical to the terms by which the design matrix is normalized in orbit
+     * determination.
+     * \return Normalization terms of the columns of the design matrix.
+     */
+    Eigen::VectorXd getDesignMatrixNormalizationTerms( ) const;
+
+    //! Function to normalize the accumulated normal equations.
+    /*!
+     * Function to normalize the accumulated normal equations, such that they correspond to a design matrix of which each
+     * column is divided by the corresponding normalization term.
+     * \param normalizationTerms Values by which each column of the design matrix is to be divided.
+     */
+    void normalize( const Eigen::VectorXd& normalizationTerms );
+
+    //! Function to solve the normal equations, using a Schur complement reduction over the arc-local parameters.
+    /*!
+     * Function to solve the normal equations, using a Schur complement reduction over the arc-local parameters.
+     * \param limitConditionNumberForWarning Maximum value of the condition number of the reduced (global) normal matrix that
+     * is allowed (warning printed when exceeded; no check if NaN)
+     * \return Solution of the normal equations (parameter adjustment).
+     */
+    Eigen::VectorXd solve( const double limitConditionNumberForWarning = 1.0E8 ) const;
+
+    //! Function to retrieve the full (dense) normal matrix, for instance to compute the covariance.
+    Eigen::MatrixXd getFullNormalMatrix( ) const;
+
+    //! Function to retrieve the full right-hand side of the normal equations.
+    Eigen::VectorXd getFullRightHandSide( ) const;
+
+    //! Function to retrieve the number of parameters.
+    int getNumberOfParameters( ) const
+    {
+        return numberOfParameters_;
+    }
+
+    //! Function to retrieve the number of arcs.
+    int getNumberOfArcs( ) const
+    {
+        return static_cast< int >( arcParameterIndices_.size( ) );
+    }
+
+private:
+
+    //! Total number of parameters.
+    int numberOfParameters_;
+
+    //! Indices of the arc-local parameters, per arc.
+    std::vector< std::vector< int > > arcParameterIndices_;
+
+    //! Indices of the global parameters.
+    std::vector< int > globalParameterIndices_;
+
+    //! Arc index of each parameter (-1 for global parameters).
+    std::vector< int > arcIndexPerParameter_;
+
+    //! Diagonal blocks of the normal matrix of each arc.
+    std::vector< Eigen::MatrixXd > arcNormalBlocks_;
+
+    //! Coupling blocks of the normal matrix between each arc (rows) and the global parameters (columns).
+    std::vector< Eigen::MatrixXd > arcGlobalNormalBlocks_;
+
+    //! Diagonal block of the normal matrix of the global parameters.
+    Eigen::MatrixXd globalNormalBlock_;
+
+    //! Right-hand side of the normal equations for the parameters of each arc.
+    std::vector< Eigen::VectorXd > arcRightHandSides_;
+
+    //! Right-hand side of the normal equations for the global parameters.
+    Eigen::VectorXd globalRightHandSide_;
+
+    //! Minimum value of each column of the partials that have been added.
+    Eigen::VectorXd columnMinima_;
+
+    //! Maximum value of each column of the partials that have been added.
+    Eigen::VectorXd columnMaxima_;
+};
+
+} // namespace linear_algebra
+
+} // namespace tudat
+
+#endif // TUDAT_BLOCK_ARROWHEAD_NORMAL_EQUATIONS_H
@@ -0,0 +1,236 @@
+/*    Copyright (c) 2010-2022, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References:
+ *       "EXTERIOR GRAVITATION OF A POLYHEDRON DERIVED AND COMPARED WITH HARMONIC AND MASCON GRAVITATION REPRESENTATIONS
+ *          OF ASTEROID 4769 CASTALIA", Werner and Scheeres (1997), Celestial Mechanics and Dynamical Astronomy
+ *       "Signed distance computation using the angle weighted pseudonormal", Baerentzen and Aanaes (2005), IEEE
+ *          Transactions on Visualization and Computer Graphics
+ *       "Real-Time Collision Detection", Ericson (2004), Morgan Kaufmann
+ */
+
+#ifndef TUDAT_POLYHEDRONFACETTREE_H
+#define TUDAT_POLYHEDRONFACETTREE_H
+
+#include <array>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace basic_mathematics
+{
+
+//! Node of a bounding volume hierarchy of polyhedron facets.
+struct PolyhedronFacetTreeNode
+{
+    // Corner of axis-aligned bounding box of the facets in the node, with minimum coordinates.
+    Eigen::Vector3d minimumCorner_;
+
+    // Corner of axis-aligned bounding box of the facets in the node, with maximum coordinates.
+    Eigen::Vector3d maximumCorner_;
+
+    // Center of the node, about which the moments of the facets are computed (center of bounding box).
+    Eigen::Vector3d center_;
+
+    // Maximum distance from the center to any vertex of the facets in the node.
+    double radius_;
+
+    // Index (in the tree ordering of the facets) of the first facet in the node.
+    int firstFacet_;
+
+    // Number of facets in the node.
+    int numberOfFacets_;
+
+    // Indices of the child nodes (-1 for leaf nodes).
+    int firstChild_;
+    int secondChild_;
+};
+
+//! Moments of the facets in a node, used for the multipole approximation of their surface integrals.
+/*!
+ *  Moments of the facets f in a node, w.r.t. the node center c, with n_f the facet normal, A_f the facet area,
+ *  s the position of a point on the facet w.r.t. c, and h_f = n_f . ( v_f - c ) for a vertex v_f of the facet.
+ */
+struct PolyhedronFacetClusterMoments
+{
+    // Sum of n_f A_f.
+    Eigen::Vector3d normalZerothMoment_;
+
+    // Sum of n_f (int s dA)^T.
+    Eigen::Matrix3d normalFirstMoment_;
+
+    // Sum of n_f,k (int s s^T dA), for k = x, y, z.
+    std::array< Eigen::Matrix3d, 3 > normalSecondMoment_;
+
+    // Sum of h_f A_f.
+    double heightZerothMoment_;
+
+    // Sum of h_f (int s dA).
+    Eigen::Vector3d heightFirstMoment_;
+
+    // Sum of h_f (int s s^T dA).
+    Eigen::Matrix3d heightSecondMoment_;
+};
+
+//! Bounding volume hierarchy of the facets of a polyhedron, for fast gravity field and altitude evaluations.
+/*!
+ *  Bounding volume hierarchy (binary tree of axis-aligned boxes) of the facets of a polyhedron, built once per polyhedron
+ *  model. It is used to:
+ *  - Evaluate the constant-density polyhedron gravity field, using the facet-wise surface integral form of the
+ *    Werner and Scheeres (1997) expressions: U = G rho / 2 sum_f ( n_f . r_f ) I_f and grad U = - G rho sum_f n_f I_f,
+ *    with I_f the integral of 1/|r| over facet f. Facet clusters that are sufficiently distant from the field point are
+ *    evaluated with a (quadrupole) multipole expansion of I_f, the others exactly. The opening criterion bounds the
+ *    relative truncation error of the surface integrals of each approximated cluster by a user-defined value.
+ *  - Compute the (signed) distance to the polyhedron surface, or to its closest vertex, with a nearest-feature search
+ *    that is logarithmic in the number of facets. The sign is determined from the angle-weighted pseudo-normal of the
+ *    closest feature (Baerentzen and Aanaes, 2005), so no loop over all facets is required.
+ */
+class PolyhedronFacetTree
+{
+public:
+
+    /*! Constructor.
+     *
+     * Constructor, builds the tree and the moments of the facets in each node.
+     * @param verticesCoordinates Cartesian coordinates of each vertex (one row per vertex, 3 columns).
+     * @param verticesDefiningEachFacet Index (0 based) of the vertices constituting each facet (one row per facet, 3
+     * columns), in counterclockwise order when seen from outside the polyhedron.
+     * @param maximumNumberOfFacetsPerLeaf Maximum number of facets in the leaf nodes of the tree.
+     */
+    PolyhedronFacetTree(
+            const Eigen::MatrixXd& verticesCoordinates,
+            const Eigen::MatrixXi& verticesDefiningEachFacet,
+            const int maximumNumberOfFacetsPerLeaf = 8 );
+
+    /*! Calculates the gravitational potential of the polyhedron.
+     *
+     * Calculates the gravitational potential of the polyhedron, using the multipole approximation for distant facet
+     * clusters (see class description).
+     * @param gravitationalConstantTimesDensity Product of the gravitational constant and the polyhedron density.
+     * @param bodyFixedPosition Position of the field point, in the frame of the polyhedron vertices.
+     * @param maximumRelativeTruncationError Maximum relative truncation error of each approximated facet cluster
+     * (if zero or negative, all facets are evaluated exactly).
+     * @return Gravitational potential.
+     */
+    double calculateGravitationalPotential(
+            const double gravitationalConstantTimesDensity,
+            const Eigen::Vector3d& bodyFixedPosition,
+            const double maximumRelativeTruncationError ) const;
+
+    /*! Calculates the gradient of the gravitational potential of the polyhedron.
+     *
+     * Calculates the gradient of the gravitational potential of the polyhedron, using the multipole approximation for
+     * distant facet clusters (see class description).
+     * @param gravitationalConstantTimesDensity Product of the gravitational constant and the polyhedron density.
+     * @param bodyFixedPosition Position of the field point, in the frame of the polyhedron vertices.
+     * @param maximumRelativeTruncationError Maximum relative truncation error of each approximated facet cluster
+     * (if zero or negative, all facets are evaluated exactly).
+     * @return Gradient of the gravitational potential.
+     */
+    Eigen::Vector3d calculateGradientOfGravitationalPotential(
+            const double gravitationalConstantTimesDensity,
+            const Eigen::Vector3d& bodyFixedPosition,
+            const double maximumRelativeTruncationError ) const;
+
+    /*! Calculates the distance to the polyhedron surface.
+     *
+     * Calculates the (minimum) distance from the field point to the polyhedron surface, i.e. to its closest facet, edge
+     * or vertex.
+     * @param bodyFixedPosition Position of the field point, in the frame of the polyhedron vertices.
+     * @param computeSign Boolean denoting whether the distance is to be negative for points inside the polyhedron.
+     * @return Distance to the polyhedron surface.
+     */
+    double calculateDistanceToSurface(
+            const Eigen::Vector3d& bodyFixedPosition,
+            const bool computeSign ) const;
+
+    /*! Calculates the distance to the closest polyhedron vertex.
+     *
+     * Calculates the distance to the closest polyhedron vertex.
+     * @param bodyFixedPosition Position of the field point, in the frame of the polyhedron vertices.
+     * @param closestVertex Index of the closest vertex (returned by reference).
+     * @return Distance to the closest vertex.
+     */
+    double calculateDistanceToClosestVertex(
+            const Eigen::Vector3d& bodyFixedPosition,
+            int& closestVertex ) const;
+
+    //! Function to return the nodes of the tree (the first node being the root).
+    const std::vector< PolyhedronFacetTreeNode >& getNodes( ) const
+    { return nodes_; }
+
+    //! Function to return the index of each facet (in the input ordering), in the order in which they are stored in the tree.
+    const std::vector< int >& getFacetOrder( ) const
+    { return facetOrder_; }
+
+private:
+
+    // Function to (recursively) create the node containing the facets in the given range of facetOrder_.
+    int createNode( const int firstFacet, const int numberOfFacets, const std::vector< Eigen::Vector3d >& facetCentroids );
+
+    // Function to compute the moments of the facets in a node.
+    void computeClusterMoments( const int nodeIndex );
+
+    // Function to compute the pseudo-normals of the vertices and edges, used to determine the sign of the distance.
+    void computePseudoNormals( );
+
+    // Function to add the (exact or approximated) surface integrals of all facets to the sums used for the potential
+    // (scalarSum: sum of ( n_f . r_f ) I_f) and gradient (vectorSum: sum of n_f I_f).
+    void calculateSurfaceIntegralSums(
+            const Eigen::Vector3d& bodyFixedPosition,
+            const double maximumRelativeTruncationError,
+            const bool computeScalarSum,
+            double& scalarSum,
+            Eigen::Vector3d& vectorSum ) const;
+
+    // Function to compute the closest point on a facet (in tree ordering), and the feature (0-2: vertex, 3-5: edge, 6:
+    // interior) on which it lies.
+    Eigen::Vector3d calculateClosestPointOnFacet(
+            const Eigen::Vector3d& bodyFixedPosition, const int facet, int& closestFeature ) const;
+
+    // Function to compute the squared distance from a point to the bounding box of a node.
+    double calculateSquaredDistanceToNode( const Eigen::Vector3d& bodyFixedPosition, const int nodeIndex ) const;
+
+    // Cartesian coordinates of each vertex.
+    std::vector< Eigen::Vector3d > vertices_;
+
+    // Nodes of the tree, the first one being the root.
+    std::vector< PolyhedronFacetTreeNode > nodes_;
+
+    // Moments of the facets in each node.
+    std::vector< PolyhedronFacetClusterMoments > clusterMoments_;
+
+    // Index of each facet in the input ordering, in the order in which they are stored in the tree.
+    std::vector< int > facetOrder_;
+
+    // Indices of the vertices of each facet (tree ordering).
+    std::vector< std::array< int, 3 > > facetVertices_;
+
+    // Outward normal of each facet (tree ordering).
+    std::vector< Eigen::Vector3d > facetNormals_;
+
+    // Outward in-plane normals of the edges (v0-v1, v1-v2, v2-v0) of each facet (tree ordering).
+    std::vector< std::array< Eigen::Vector3d, 3 > > facetEdgeNormals_;
+
+    // Angle-weighted pseudo-normals of the edges (v0-v1, v1-v2, v2-v0) of each facet (tree ordering).
+    std::vector< std::array< Eigen::Vector3d, 3 > > facetEdgePseudoNormals_;
+
+    // Angle-weighted pseudo-normal of each vertex.
+    std::vector< Eigen::Vector3d > vertexPseudoNormals_;
+
+    // Maximum number of facets in the leaf nodes of the tree.
+    int maximumNumberOfFacetsPerLeaf_;
+};
+
+} // namespace basic_mathematics
+} // namespace tudat
+
+#endif //TUDAT_POLYHEDRONFACETTREE_H
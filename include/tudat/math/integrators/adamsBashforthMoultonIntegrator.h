@@ -24,6 +24,8 @@
 #include <deque>
 #include <algorithm>
 #include <limits>
+#include <stdexcept>
+#include <string>
 
 #include <memory>
 
@@ -39,6 +41,44 @@ namespace tudat
 namespace numerical_integrators
 {
 
+//! Base class for the history of an Adams-Bashforth-Moulton integrator, independent of the state and time types.
+/*!
+ * Base class for the history of an Adams-Bashforth-Moulton integrator, independent of the state and time types, so that the
+ * history can be stored in the integrator settings (see AdamsBashforthMoultonSettings::integrationHistory_).
+ */
+struct AdamsBashforthMoultonHistoryBase
+{
+    //! Virtual destructor
+    virtual ~AdamsBashforthMoultonHistoryBase( ){ }
+};
+
+//! History of an Adams-Bashforth-Moulton integrator.
+/*!
+ * History of an Adams-Bashforth-Moulton integrator, as retrieved by AdamsBashforthMoultonIntegrator::getIntegrationHistory.
+ * It can be provided to an integrator that is restarted at the same state (e.g. after a propagation was terminated), using
+ * AdamsBashforthMoultonIntegrator::setIntegrationHistory, so that the integration continues without the single-step startup
+ * of the multi-step history.
+ */
+template< typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+          typename TimeStepType = IndependentVariableType >
+struct AdamsBashforthMoultonHistory: public AdamsBashforthMoultonHistoryBase
+{
+    //! Value of the independent variable at the most recent entry of the history.
+    IndependentVariableType currentIndependentVariable;
+
+    //! Step size of the next step, equal to the (constant) interval between subsequent entries of the history.
+    TimeStepType stepSize;
+
+    //! Order of the next step.
+    unsigned int order;
+
+    //! History of states, with the most recent state first.
+    std::deque< StateType > stateHistory;
+
+    //! History of state derivatives, with the most recent state derivative first.
+    std::deque< StateType > derivativeHistory;
+};
+
 //! Adams-Bashforth-Moulton Variable Order and Stepsize integrator.
 /*!
  * Class that implements the Adams-Bashforth-Moulton integrator, variable order, variable
@@ -586,7 +626,11 @@ public:
      * Sets the order to specified.
      * \param order desired.
      */
-    void setOrder( unsigned int order ) { order_ = order; }
+    void setOrder( unsigned int order )
+    {
+        checkOrder( order );
+        order_ = order;
+    }
 
     //! (Un)set fixed order.
     /*!
@@ -635,6 +679,7 @@ public:
      */
     void setMinimumOrder( unsigned int minimumOrder )
     {
+        checkOrder( minimumOrder );
         minimumOrder_ = minimumOrder;
         if( order_ < minimumOrder )
         {
@@ -649,6 +694,7 @@ public:
      */
     void setMaximumOrder( unsigned int maximumOrder )
     {
+        checkOrder( maximumOrder );
         maximumOrder_ = maximumOrder;
         if( order_ > maximumOrder_ )
         {
@@ -666,8 +712,126 @@ public:
         return lastState_;
     }
 
+    //! Function to compute the state within the last integration step, from the interpolating polynomial of the method.
+    /*!
+     * Function to compute the state within the last integration step (i.e. between getPreviousIndependentVariable( ) and
+     * getCurrentIndependentVariable( )), without additional state derivative evaluations. The Adams polynomial
+     * interpolating the current derivative history (at the current order) is integrated from the current state, so that
+     * the interpolated state is of the same order as the integration itself, and equal to the current state at the end of
+     * the step. During the single-step startup of the integrator, the available history, and therefore the order of the
+     * interpolation, is limited.
+     * \param independentVariable Value of the independent variable at which the state is to be computed.
+     * \return Interpolated state at the requested independent variable.
+     */
+    StateType getInterpolatedState( const IndependentVariableType independentVariable ) const
+    {
+        if( static_cast< double >( independentVariable - lastIndependentVariable_ ) *
+                static_cast< double >( independentVariable - currentIndependentVariable_ ) > 0.0 )
+        {
+            throw std::runtime_error( "Error when interpolating ABM integrator state, requested independent variable is "
+                                      "outside of the last integration step" );
+        }
+
+        // Normalized time w.r.t. the current state, in units of the interval between entries of the history.
+        const double theta = static_cast< double >( ( independentVariable - currentIndependentVariable_ ) / stepSize_ );
+        const unsigned int numberOfNodes = std::min( order_, static_cast< unsigned int >( derivHistory_.size( ) ) );
+
+        // Integrate the Lagrange polynomials for the derivative history (at nodes 0, -1, ...) from 0 to theta, using a
+        // Gauss-Legendre quadrature that is exact for the maximum order of 12.
+        StateType interpolatedState = stateHistory_.front( );
+        for( unsigned int j = 0; j < numberOfNodes; j++ )
+        {
+            double integratedLagrangePolynomial = 0.0;
+            for( unsigned int k = 0; k < 6; k++ )
+            {
+                const double quadratureNode = theta * gaussLegendreQuadratureNodes[ k ];
+                double lagrangePolynomial = 1.0;
+                for( unsigned int i = 0; i < numberOfNodes; i++ )
+                {
+                    if( i != j )
+                    {
+                        lagrangePolynomial *= ( quadratureNode + static_cast< double >( i ) ) /
+                                static_cast< double >( static_cast< int >( i ) - static_cast< int >( j ) );
+                    }
+                }
+                integratedLagrangePolynomial += gaussLegendreQuadratureWeights[ k ] * lagrangePolynomial;
+            }
+            interpolatedState += ( theta * integratedLagrangePolynomial ) * stepSize_ * derivHistory_.at( j );
+        }
+        return interpolatedState;
+    }
+
+    //! Function to retrieve the current history of the integrator.
+    /*!
+     * Function to retrieve the current history of the integrator (states and state derivatives at equidistant values of
+     * the independent variable), as well as the step size and order of the next step. This history may be provided to a
+     * new integrator starting at the current state, using setIntegrationHistory.
+     * \return Current history of the integrator.
+     */
+    AdamsBashforthMoultonHistory< IndependentVariableType, StateType, TimeStepType > getIntegrationHistory( ) const
+    {
+        AdamsBashforthMoultonHistory< IndependentVariableType, StateType, TimeStepType > integrationHistory;
+        integrationHistory.currentIndependentVariable = currentIndependentVariable_;
+        integrationHistory.stepSize = stepSize_;
+        integrationHistory.order = order_;
+        integrationHistory.stateHistory = stateHistory_;
+        integrationHistory.derivativeHistory = derivHistory_;
+        return integrationHistory;
+    }
+
+    //! Function to continue integration from a previously retrieved history.
+    /*!
+     * Function to continue integration from a previously retrieved history (see getIntegrationHistory), so that the
+     * single-step startup of the multi-step history is skipped. The history is only used if its most recent entry is
+     * identical to the current independent variable and state of this integrator, and if its most recent state derivative
+     * is identical to the state derivative evaluated for the current state, i.e. if the dynamics are unchanged. If the
+     * step size of this integrator is fixed, the step size of the history must also be identical. The order of the
+     * history is limited to the minimum and maximum order of this integrator.
+     * \param integrationHistory History from which integration is to be continued.
+     * \return True if the history is used, false if it is rejected (in which case the integrator is unchanged).
+     */
+    bool setIntegrationHistory(
+            const AdamsBashforthMoultonHistory< IndependentVariableType, StateType, TimeStepType >& integrationHistory )
+    {
+        if( integrationHistory.stateHistory.size( ) == 0 ||
+                integrationHistory.stateHistory.size( ) != integrationHistory.derivativeHistory.size( ) ||
+                !( integrationHistory.currentIndependentVariable == currentIndependentVariable_ ) ||
+                ( fixedStepSize_ && !( integrationHistory.stepSize == stepSize_ ) ) ||
+                !isEqualState( integrationHistory.stateHistory.front( ), stateHistory_.front( ) ) ||
+                !isEqualState( integrationHistory.derivativeHistory.front( ), derivHistory_.front( ) ) )
+        {
+            return false;
+        }
+
+        stateHistory_ = integrationHistory.stateHistory;
+        derivHistory_ = integrationHistory.derivativeHistory;
+        stepSize_ = integrationHistory.stepSize;
+        if( !fixedOrder_ )
+        {
+            order_ = std::max( minimumOrder_, std::min( maximumOrder_, integrationHistory.order ) );
+        }
+        return true;
+    }
+
 protected:
 
+    //! Function to check whether an order is supported by the integrator, throwing an exception if not.
+    void checkOrder( const unsigned int order ) const
+    {
+        if( order < 1 || order > 12 )
+        {
+            throw std::runtime_error( "Error in ABM integrator, order " + std::to_string( order ) +
+                                      " is not supported; order must be between 1 and 12" );
+        }
+    }
+
+    //! Function to check whether two states (of identical type) are identical in size and value.
+    bool isEqualState( const StateType& firstState, const StateType& secondState ) const
+    {
+        return firstState.rows( ) == secondState.rows( ) && firstState.cols( ) == secondState.cols( ) &&
+                firstState == secondState;
+    }
+
 
     //! Current independent variable.
     /*!
@@ -796,7 +960,7 @@ protected:
     /*!
      * Coefficients for estimating the truncation error.
      */
-    const static double truncationErrorCoefficients[ 12 ];
+    const static double truncationErrorCoefficients[ 13 ];
 
     //! Extrapolation coefficients.
     /*!
@@ -810,6 +974,12 @@ protected:
      */
     const static double interpolationCoefficients[ 132 ][ 24 ];
 
+    //! Nodes of the six-point Gauss-Legendre quadrature on the interval [0,1].
+    const static double gaussLegendreQuadratureNodes[ 6 ];
+
+    //! Weights of the six-point Gauss-Legendre quadrature on the interval [0,1].
+    const static double gaussLegendreQuadratureWeights[ 6 ];
+
     //! Perform integration step.
     /*!
      * Perform integration step using built-in Runge-Kutta fourth
@@ -897,7 +1067,7 @@ protected:
      * \param doubleStep boolean if stepsize should be considered double, true for estimating doubling error.
      * \return  after corrector step
      */
-    StateType performCorrectorStep( StateType predictedState, unsigned int order, bool doubleStep )
+    StateType performCorrectorStep( const StateType& predictedState, unsigned int order, bool doubleStep )
     {
         unsigned int stepsToSkip = static_cast< unsigned int>( doubleStep );
         TimeStepType stepSize = stepSize_ * static_cast< double >( stepsToSkip + 1 );
@@ -919,7 +1089,7 @@ protected:
      * \param order of the integration.
      * \return absolute error vector.
      */
-    StateType estimateAbsoluteError( StateType predictedState, StateType correctedState, unsigned int order )
+    StateType estimateAbsoluteError( const StateType& predictedState, const StateType& correctedState, unsigned int order )
     {
         // Estimate the maximum truncation error
         return truncationErrorCoefficients[ order ] * ( predictedState - correctedState ).cwiseAbs( ).array( );
@@ -933,7 +1103,8 @@ protected:
      * \param absoluteError
      * \return relative error vector.
      */
-    StateType estimateRelativeError( StateType predictedState, StateType correctedState, StateType absoluteError )
+    StateType estimateRelativeError( const StateType& predictedState, const StateType& correctedState,
+                                     const StateType& absoluteError )
     {
         // Estimate the maximum truncation error
         return absoluteError.cwiseQuotient( ( correctedState.cwiseAbs( ) ).cwiseMax( predictedState.cwiseAbs( ) ) );
@@ -949,8 +1120,8 @@ protected:
      * \param relativeError2 relative error two.
      * \return true if one is better than two, false otherwise.
      */
-    bool errorCompare( StateType absoluteError1, StateType relativeError1,
-                       StateType absoluteError2, StateType relativeError2 )
+    bool errorCompare( const StateType& absoluteError1, const StateType& relativeError1,
+                       const StateType& absoluteError2, const StateType& relativeError2 )
     {
         // Find compound error
         StateType c1 = absoluteError1.cwiseMin( relativeError1 );
@@ -978,7 +1149,7 @@ protected:
      * \param relativeError relative error.
      * \return true if one error is too big, false if within limits
      */
-    bool errorTooLarge( StateType absoluteError, StateType relativeError )
+    bool errorTooLarge( const StateType& absoluteError, const StateType& relativeError )
     {
         bool belowLimit = true;
         // All components needs to be below the upper limit (tol)
@@ -999,7 +1170,7 @@ protected:
      * \param relativeError relative error.
      * \return true if one error is too small, false if within limits
      */
-    bool errorTooSmall( StateType absoluteError, StateType relativeError )
+    bool errorTooSmall( const StateType& absoluteError, const StateType& relativeError )
     {
         bool belowLimit = true;
         // All components need to be above lower limit ( tol / bw )
@@ -1090,10 +1261,11 @@ typedef std::shared_ptr< AdamsBashforthMoultonIntegratord > AdamsBashforthMoulto
  * truncationErrorCoefficients( o - 1 )
  */
 template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType>
-const double AdamsBashforthMoultonIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >::truncationErrorCoefficients[ 12 ] = {
+const double AdamsBashforthMoultonIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >::truncationErrorCoefficients[ 13 ] = {
     +2.00000000000000000e+00, +6.00000000000000000e+00, +1.00000000000000000e+01, +1.42105263157894743e+01,
     +1.85925925925925917e+01, +2.31170336037079949e+01, +2.77629090909090905e+01, +3.25146526080169664e+01,
-    +3.73602765314851339e+01, +4.22902727113587602e+01, +4.72969156506348156e+01, +5.23738028029830431e+01
+    +3.73602765314851339e+01, +4.22902727113587602e+01, +4.72969156506348156e+01, +5.23738028029830431e+01,
+    +5.75155400092940994e+01
 };
 
 //! Extrapolation coefficients    ( size: o * 2 X o )
@@ -1984,6 +2156,20 @@ const double AdamsBashforthMoultonIntegrator< IndependentVariableType, StateType
 
 };
 
+//! Nodes of the six-point Gauss-Legendre quadrature on the interval [0,1].
+template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType>
+const double AdamsBashforthMoultonIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >::gaussLegendreQuadratureNodes[ 6 ] = {
+    +3.37652428984239888e-02, +1.69395306766867731e-01, +3.80690406958401562e-01,
+    +6.19309593041598494e-01, +8.30604693233132241e-01, +9.66234757101576025e-01
+};
+
+//! Weights of the six-point Gauss-Legendre quadrature on the interval [0,1].
+template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType>
+const double AdamsBashforthMoultonIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >::gaussLegendreQuadratureWeights[ 6 ] = {
+    +8.56622461895851783e-02, +1.80380786524069303e-01, +2.33956967286345519e-01,
+    +2.33956967286345519e-01, +1.80380786524069303e-01, +8.56622461895851783e-02
+};
+
 } // namespace integrators
 } // namespace tudat
 
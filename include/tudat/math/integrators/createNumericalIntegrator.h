@@ -25,6 +25,7 @@
 #include "tudat/math/integrators/adamsBashforthMoultonIntegrator.h"
 #include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
 #include "tudat/math/integrators/stepSizeController.h"
+#include "tudat/math/integrators/taylorSeriesIntegrator.h"
 
 namespace tudat
 {
@@ -41,7 +42,8 @@ enum AvailableIntegrators
     rungeKuttaFixedStepSize,
     rungeKuttaVariableStepSize,
     bulirschStoer,
-    adamsBashforthMoulton
+    adamsBashforthMoulton,
+    taylorSeries
 };
 
 class IntegratorStepSizeValidationSettings
@@ -337,13 +339,16 @@ public:
                         const bool assessTerminationOnMinorSteps = false ) :
         integratorType_( integratorType ), initialTimeDeprecated_( initialTime ),
         initialTimeStep_( initialTimeStep ), 
-        assessTerminationOnMinorSteps_( assessTerminationOnMinorSteps )
+        assessTerminationOnMinorSteps_( assessTerminationOnMinorSteps ),
+        storeDenseOutput_( false )
     { }
 
     virtual std::shared_ptr< IntegratorSettings > clone( ) const
     {
-        return std::make_shared< IntegratorSettings >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< IntegratorSettings >(
                     integratorType_, initialTimeDeprecated_, initialTimeStep_, assessTerminationOnMinorSteps_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
 
     
@@ -381,6 +386,16 @@ public:
      */
     bool assessTerminationOnMinorSteps_;
 
+    // Whether the dense output (continuous extension of each step) of the integrator is to be stored.
+    /*
+     * Whether the dense output (continuous extension of each accepted step, see RungeKuttaDenseOutput) of the integrator
+     * is to be stored. Only supported for the rungeKuttaVariableStepSize integrator type. When propagating dynamics, the
+     * dense output is used (instead of interpolation of the discrete state history) to reset the ephemerides of bodies
+     * of which the translational state is propagated with the Cowell propagator, if the state and time are of type double.
+     * The default value is false.
+     */
+    bool storeDenseOutput_;
+
 };
 
 // Class to define settings of fixed step RK numerical integrator.
@@ -434,8 +449,10 @@ public:
     { }
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< RungeKuttaFixedStepSizeSettings< IndependentVariableType > >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< RungeKuttaFixedStepSizeSettings< IndependentVariableType > >(
                     this->initialTimeDeprecated_, this->initialTimeStep_, coefficientSet_, orderToUse_, this->assessTerminationOnMinorSteps_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
 
     // Virtual destructor.
@@ -476,10 +493,12 @@ public:
 
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< MultiStageVariableStepSizeSettings< IndependentVariableType> >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< MultiStageVariableStepSizeSettings< IndependentVariableType> >(
             this->initialTimeStep_, coefficientSet_,
             stepSizeControlSettings_, stepSizeAcceptanceSettings_,
             this->assessTerminationOnMinorSteps_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
 
     // Destructor.
@@ -552,11 +571,13 @@ public:
 
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< RungeKuttaVariableStepSizeBaseSettings< IndependentVariableType> >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< RungeKuttaVariableStepSizeBaseSettings< IndependentVariableType> >(
                     areTolerancesDefinedAsScalar_, this->initialTimeDeprecated_, this->initialTimeStep_, coefficientSet_,
                     minimumStepSize_, maximumStepSize_, this->assessTerminationOnMinorSteps_,
                     safetyFactorForNextStepSize_, maximumFactorIncreaseForNextStepSize_, minimumFactorDecreaseForNextStepSize_,
                     exceptionIfMinimumStepExceeded_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
 
     // Virtual destructor.
@@ -643,12 +664,14 @@ public:
 
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< RungeKuttaVariableStepSizeSettingsScalarTolerances< IndependentVariableType> >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< RungeKuttaVariableStepSizeSettingsScalarTolerances< IndependentVariableType> >(
                     this->initialTimeDeprecated_, this->initialTimeStep_, this->coefficientSet_,
                     this->minimumStepSize_, this->maximumStepSize_, relativeErrorTolerance_, absoluteErrorTolerance_,
                     this->assessTerminationOnMinorSteps_,
                     this->safetyFactorForNextStepSize_, this->maximumFactorIncreaseForNextStepSize_, this->minimumFactorDecreaseForNextStepSize_,
                     this->exceptionIfMinimumStepExceeded_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
     // Constructor.
     /*
@@ -777,12 +800,14 @@ public:
 
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< RungeKuttaVariableStepSizeSettingsVectorTolerances< IndependentVariableType> >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< RungeKuttaVariableStepSizeSettingsVectorTolerances< IndependentVariableType> >(
                     this->initialTimeDeprecated_, this->initialTimeStep_, this->coefficientSet_,
                     this->minimumStepSize_, this->maximumStepSize_, relativeErrorTolerance_, absoluteErrorTolerance_,
                     this->assessTerminationOnMinorSteps_,
                     this->safetyFactorForNextStepSize_, this->maximumFactorIncreaseForNextStepSize_, this->minimumFactorDecreaseForNextStepSize_,
                     this->exceptionIfMinimumStepExceeded_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
 
     // Destructor.
@@ -867,10 +892,12 @@ public:
 
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< BulirschStoerIntegratorSettings< IndependentVariableType> >(
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< BulirschStoerIntegratorSettings< IndependentVariableType> >(
                     this->initialTimeStep_, extrapolationSequence_, maximumNumberOfSteps_,
                     stepSizeControlSettings_,
                     stepSizeAcceptanceSettings_, this->assessTerminationOnMinorSteps_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
     }
 
     // Destructor.
@@ -914,7 +941,7 @@ public:
      *  \param relativeErrorTolerance Relative error tolerance for step size control.
      *  \param absoluteErrorTolerance Absolute error tolerance for step size control.
      *  \param minimumOrder Minimum order of integrator (default 6).
-     *  \param maximumOrder Maximum order of integrator (default 11).
+     *  \param maximumOrder Maximum order of integrator (default 11, at most 12).
      *  \param saveFrequency Frequency at which to save the numerical integrated states (in units of i.e. per n integration
      *      time steps, with n = saveFrequency).
      *  \param assessTerminationOnMinorSteps Whether the propagation termination
@@ -939,15 +966,19 @@ public:
         minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
         relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
         minimumOrder_( minimumOrder ), maximumOrder_( maximumOrder ),
-        bandwidth_( bandwidth ) { }
+        bandwidth_( bandwidth ), reuseIntegrationHistory_( false ) { }
 
     virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
     {
-        return std::make_shared< AdamsBashforthMoultonSettings< IndependentVariableType> >(
+        std::shared_ptr< AdamsBashforthMoultonSettings< IndependentVariableType > > clonedSettings = std::make_shared< AdamsBashforthMoultonSettings< IndependentVariableType> >(
                     this->initialTimeDeprecated_, this->initialTimeStep_,
                     this->minimumStepSize_, this->maximumStepSize_, relativeErrorTolerance_, absoluteErrorTolerance_,
                     minimumOrder_, maximumOrder_,
                     this->assessTerminationOnMinorSteps_, bandwidth_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        clonedSettings->reuseIntegrationHistory_ = reuseIntegrationHistory_;
+        clonedSettings->integrationHistory_ = integrationHistory_;
+        return clonedSettings;
     }
 
     // Destructor
@@ -980,6 +1011,119 @@ public:
     // Safety factor for step size control
     IndependentVariableType bandwidth_;
 
+    // Whether the history of the integrator is to be stored at the end of a propagation, and reused when restarting
+    /*
+     *  Whether the history of the integrator is to be stored in integrationHistory_ at the end of a propagation (see
+     *  saveIntegrationHistoryToSettings), so that a subsequent propagation with these settings, starting at the final
+     *  time and state of the previous one, continues from the multi-step history instead of performing the single-step
+     *  startup. The default value is false.
+     */
+    bool reuseIntegrationHistory_;
+
+    // History of the integrator at the end of the most recent propagation (nullptr if none is stored).
+    /*
+     *  History of the integrator at the end of the most recent propagation (nullptr if none is stored). When creating an
+     *  integrator, this history is used if it is consistent with the initial time, state and dynamics of the integrator
+     *  (see AdamsBashforthMoultonIntegrator::setIntegrationHistory), and ignored otherwise.
+     */
+    std::shared_ptr< AdamsBashforthMoultonHistoryBase > integrationHistory_;
+
+};
+
+// Class to define settings of variable order, variable step size Taylor series numerical integrator
+/*
+ *  Class to define settings of variable order, variable step size Taylor series numerical integrator (see
+ *  TaylorSeriesIntegrator). The Taylor coefficients are generated from a recorded state derivative function, which must
+ *  be equivalent to the state derivative function that is integrated. For the propagation of translational dynamics, this
+ *  requires the Cowell propagator, with all bodies exerting accelerations propagated w.r.t. the same inertial (e.g.
+ *  barycentric) origin, such that the state contains 6 entries per body, in the order of the propagated bodies (see
+ *  e.g. createNBodyPointMassTaylorSeriesExpression). Variational equations are not supported. If no expression is
+ *  provided, it is created from the acceleration models by the single-arc dynamics simulator (see
+ *  createNBodyTaylorSeriesExpression), which throws an exception for accelerations that cannot be recorded. The
+ *  integrator checks the expression against the integrated state derivative function at the initial state.
+ */
+template< typename IndependentVariableType = double >
+class TaylorSeriesIntegratorSettings: public IntegratorSettings< IndependentVariableType >
+{
+public:
+
+    // Constructor
+    /*
+     *  Constructor for Taylor series integrator settings.
+     *  \param initialTime Start time (independent variable) of numerical integration.
+     *  \param initialTimeStep Initial time (independent variable) step used in numerical integration, of which the sign
+     *      defines the direction of integration (step size is selected from the Taylor coefficients).
+     *  \param taylorSeriesExpression Recorded state derivative function, from which the Taylor coefficients are generated
+     *      (if nullptr, created from the acceleration models of the propagation).
+     *  \param minimumStepSize Minimum step size for integration. Integration stops (exception thrown) if time step
+     *      comes below this value.
+     *  \param maximumStepSize Maximum step size for integration.
+     *  \param relativeErrorTolerance Relative error tolerance for order and step size selection.
+     *  \param absoluteErrorTolerance Absolute error tolerance for order and step size selection.
+     *  \param minimumOrder Minimum order of the series (default 2).
+     *  \param maximumOrder Maximum order of the series (default 30).
+     *  \param assessTerminationOnMinorSteps Whether the propagation termination
+     *      conditions should be evaluated during the intermediate sub-steps of the integrator (`true`) or only at the end of
+     *      each integration step (`false`).
+     */
+    TaylorSeriesIntegratorSettings(
+            const IndependentVariableType initialTime,
+            const IndependentVariableType initialTimeStep,
+            const std::shared_ptr< TaylorSeriesExpression > taylorSeriesExpression,
+            const IndependentVariableType minimumStepSize,
+            const IndependentVariableType maximumStepSize,
+            const double relativeErrorTolerance = 1.0E-15,
+            const double absoluteErrorTolerance = 1.0E-15,
+            const int minimumOrder = 2,
+            const int maximumOrder = 30,
+            const bool assessTerminationOnMinorSteps = false ):
+        IntegratorSettings< IndependentVariableType >(
+            taylorSeries, initialTime, initialTimeStep, assessTerminationOnMinorSteps ),
+        taylorSeriesExpression_( taylorSeriesExpression ),
+        minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
+        relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
+        minimumOrder_( minimumOrder ), maximumOrder_( maximumOrder ) { }
+
+    virtual std::shared_ptr< IntegratorSettings< IndependentVariableType > > clone( ) const
+    {
+        std::shared_ptr< IntegratorSettings< IndependentVariableType > > clonedSettings = std::make_shared< TaylorSeriesIntegratorSettings< IndependentVariableType > >(
+                    this->initialTimeDeprecated_, this->initialTimeStep_, taylorSeriesExpression_,
+                    minimumStepSize_, maximumStepSize_, relativeErrorTolerance_, absoluteErrorTolerance_,
+                    minimumOrder_, maximumOrder_, this->assessTerminationOnMinorSteps_ );
+        clonedSettings->storeDenseOutput_ = this->storeDenseOutput_;
+        return clonedSettings;
+    }
+
+    // Destructor
+    /*
+     *  Destructor
+     */
+    ~TaylorSeriesIntegratorSettings( ){ }
+
+    // Recorded state derivative function, from which the Taylor coefficients are generated.
+    std::shared_ptr< TaylorSeriesExpression > taylorSeriesExpression_;
+
+    // Minimum step size for integration.
+    /*
+     *  Minimum step size for integration. Integration stops (exception thrown) if time step comes below this value.
+     */
+    IndependentVariableType minimumStepSize_;
+
+    // Maximum step size for integration.
+    IndependentVariableType maximumStepSize_;
+
+    // Relative error tolerance for order and step size selection
+    double relativeErrorTolerance_;
+
+    // Absolute error tolerance for order and step size selection
+    double absoluteErrorTolerance_;
+
+    // Minimum order of the series
+    int minimumOrder_;
+
+    // Maximum order of the series
+    int maximumOrder_;
+
 };
 
 template< typename IndependentVariableType = double >
@@ -1363,6 +1507,26 @@ inline std::shared_ptr< IntegratorSettings< IndependentVariableType > > adamsBas
         assessTerminationOnMinorSteps, 1.0 );
 }
 
+template< typename IndependentVariableType = double >
+inline std::shared_ptr< IntegratorSettings< IndependentVariableType > > taylorSeriesSettings(
+        const IndependentVariableType initialTimeStep,
+        const std::shared_ptr< TaylorSeriesExpression > taylorSeriesExpression,
+        const IndependentVariableType minimumStepSize,
+        const IndependentVariableType maximumStepSize,
+        const double relativeErrorTolerance = 1.0E-15,
+        const double absoluteErrorTolerance = 1.0E-15,
+        const int minimumOrder = 2,
+        const int maximumOrder = 30,
+        const bool assessTerminationOnMinorSteps = false )
+{
+    return std::make_shared< TaylorSeriesIntegratorSettings< IndependentVariableType > >(
+                TUDAT_NAN, initialTimeStep, taylorSeriesExpression,
+                minimumStepSize, maximumStepSize,
+                relativeErrorTolerance, absoluteErrorTolerance,
+                minimumOrder, maximumOrder,
+                assessTerminationOnMinorSteps );
+}
+
 // Function to create a numerical integrator.
 /*
  *  Function to create a numerical integrator from given integrator settings, state derivative function and initial state.
@@ -1693,6 +1857,50 @@ DependentVariableType, IndependentVariableStepType > > createIntegrator(
                         < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >(
                             integrator )->setFixedStepSize( true );
             }
+
+            // Continue from history of previous propagation, if available (rejected by integrator if inconsistent)
+            std::shared_ptr< AdamsBashforthMoultonHistory
+                    < IndependentVariableType, DependentVariableType, IndependentVariableStepType > > integrationHistory =
+                    std::dynamic_pointer_cast< AdamsBashforthMoultonHistory
+                    < IndependentVariableType, DependentVariableType, IndependentVariableStepType > >(
+                        adamsBashforthMoultonIntegratorSettings->integrationHistory_ );
+            if( integrationHistory != nullptr )
+            {
+                std::dynamic_pointer_cast< AdamsBashforthMoultonIntegrator
+                        < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >(
+                            integrator )->setIntegrationHistory( *integrationHistory );
+            }
+        }
+        break;
+    }
+    case taylorSeries:
+    {
+        // Cast integrator settings
+        std::shared_ptr< TaylorSeriesIntegratorSettings< IndependentVariableType > > taylorSeriesIntegratorSettings =
+                std::dynamic_pointer_cast< TaylorSeriesIntegratorSettings< IndependentVariableType > >(
+                    integratorSettings );
+
+        // Check that integrator type has been cast properly
+        if ( taylorSeriesIntegratorSettings == nullptr )
+        {
+            throw std::runtime_error( "Error, type of integrator settings (TaylorSeriesIntegratorSettings) not compatible with "
+                                      "selected integrator (derived class of IntegratorSettings must be TaylorSeriesIntegratorSettings "
+                                      "for this type)." );
+        }
+        else
+        {
+            // Create integrator
+            integrator = TaylorSeriesIntegratorCreator<
+                    IndependentVariableType, DependentVariableType, IndependentVariableStepType >::createIntegrator(
+                        stateDerivativeFunction, taylorSeriesIntegratorSettings->taylorSeriesExpression_,
+                        initialTime, initialState,
+                        static_cast< IndependentVariableStepType >( integratorSettings->initialTimeStep_ ),
+                        static_cast< IndependentVariableStepType >( taylorSeriesIntegratorSettings->minimumStepSize_ ),
+                        static_cast< IndependentVariableStepType >( taylorSeriesIntegratorSettings->maximumStepSize_ ),
+                        taylorSeriesIntegratorSettings->relativeErrorTolerance_,
+                        taylorSeriesIntegratorSettings->absoluteErrorTolerance_,
+                        taylorSeriesIntegratorSettings->minimumOrder_,
+                        taylorSeriesIntegratorSettings->maximumOrder_ );
         }
         break;
     }
@@ -1706,10 +1914,59 @@ DependentVariableType, IndependentVariableStepType > > createIntegrator(
         throw std::runtime_error( "Error while creating integrator. The resulting integrator pointer is null." );
     }
 
+    // Enable storage of dense output, if requested
+    if( integratorSettings->storeDenseOutput_ )
+    {
+        std::shared_ptr< RungeKuttaVariableStepSizeIntegrator
+                < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
+                variableStepIntegrator = std::dynamic_pointer_cast< RungeKuttaVariableStepSizeIntegrator
+                < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >( integrator );
+        if( variableStepIntegrator == nullptr )
+        {
+            throw std::runtime_error( "Error while creating integrator, storage of dense output is only supported for the "
+                                      "rungeKuttaVariableStepSize integrator type." );
+        }
+        variableStepIntegrator->setDenseOutputStorage( true );
+    }
+
     // Give back integrator
     return integrator;
 }
 
+// Function to store the history of an integrator in its settings, for reuse when restarting the integration.
+/*
+ *  Function to store the history of an integrator in its settings (see AdamsBashforthMoultonSettings::integrationHistory_),
+ *  for reuse when creating an integrator that restarts the integration at the current state. Only done for
+ *  Adams-Bashforth-Moulton settings for which reuseIntegrationHistory_ is set, nothing is done otherwise.
+ *  \param integrator Integrator of which the history is to be stored.
+ *  \param integratorSettings Settings with which the integrator was created, in which the history is stored.
+ */
+template< typename IndependentVariableType, typename DependentVariableType,
+          typename IndependentVariableStepType = IndependentVariableType >
+void saveIntegrationHistoryToSettings(
+        const std::shared_ptr< NumericalIntegrator< IndependentVariableType, DependentVariableType,
+        DependentVariableType, IndependentVariableStepType > > integrator,
+        const std::shared_ptr< IntegratorSettings< IndependentVariableType > > integratorSettings )
+{
+    std::shared_ptr< AdamsBashforthMoultonSettings< IndependentVariableType > > adamsBashforthMoultonIntegratorSettings =
+            std::dynamic_pointer_cast< AdamsBashforthMoultonSettings< IndependentVariableType > >( integratorSettings );
+    if( adamsBashforthMoultonIntegratorSettings != nullptr && adamsBashforthMoultonIntegratorSettings->reuseIntegrationHistory_ )
+    {
+        std::shared_ptr< AdamsBashforthMoultonIntegrator
+                < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
+                adamsBashforthMoultonIntegrator = std::dynamic_pointer_cast< AdamsBashforthMoultonIntegrator
+                < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >(
+                    integrator );
+        if( adamsBashforthMoultonIntegrator == nullptr )
+        {
+            throw std::runtime_error( "Error when saving integration history, integrator is not of Adams-Bashforth-Moulton type" );
+        }
+        adamsBashforthMoultonIntegratorSettings->integrationHistory_ = std::make_shared< AdamsBashforthMoultonHistory
+                < IndependentVariableType, DependentVariableType, IndependentVariableStepType > >(
+                    adamsBashforthMoultonIntegrator->getIntegrationHistory( ) );
+    }
+}
+
 
 //extern template std::shared_ptr< numerical_integrators::NumericalIntegrator< double, Eigen::VectorXd,
 //                                                                             Eigen::VectorXd, double > > createIntegrator< double, Eigen::VectorXd, double >(
@@ -0,0 +1,446 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I: Nonstiff Problems,
+ *          2nd edition, Springer, 1993 (Section II.6).
+ *
+ */
+
+#ifndef TUDAT_RUNGE_KUTTA_DENSE_OUTPUT_H
+#define TUDAT_RUNGE_KUTTA_DENSE_OUTPUT_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/basicTypedefs.h"
+#include "tudat/math/integrators/rungeKuttaCoefficients.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Function to compute the coefficients of a continuous extension of an explicit Runge-Kutta method.
+/*!
+ * Function to compute the coefficients of a continuous extension of an explicit Runge-Kutta method, using only the stages
+ * of the method itself (no additional function evaluations). The state at a fraction theta of a step of size h is then
+ * given by y( t0 + theta h ) = y0 + h sum_i b_i( theta ) k_i, with k_i the stage derivatives and
+ * b_i( theta ) = sum_{j=1}^{d} B_{ij} theta^j. The coefficients B are computed by solving the order conditions of the
+ * continuous extension (one for each rooted tree, see Hairer et al., 1993) for the highest order at which they are
+ * consistent, subject to the condition that b_i( 1 ) is equal to the weights of the estimate that is integrated, so that
+ * the continuous extension is continuous over the steps. Of the solutions that satisfy these conditions, the one with
+ * minimum norm is selected. Without additional stages, the order of the continuous extension is lower than that of the
+ * method itself (e.g. 5 for RKF7(8) and RKDP8(7), 6 for RKF8(9) and RKV8(9), and 3 for RKF4(5)).
+ * \param coefficients Coefficients of the Runge-Kutta method.
+ * \param continuousExtensionOrder Order of the continuous extension that was obtained (returned by reference).
+ * \param maximumOrder Maximum order of the continuous extension that is attempted (limited by the order of the integrated
+ * estimate).
+ * \return Matrix B (number of stages x polynomial degree) defining the continuous extension.
+ */
+Eigen::MatrixXd computeRungeKuttaContinuousExtensionCoefficients(
+        const RungeKuttaCoefficients& coefficients,
+        int& continuousExtensionOrder,
+        const int maximumOrder = 8 );
+
+//! Function to compute the coefficients of a continuous extension of an explicit Runge-Kutta method, with additional stages.
+/*!
+ * Function to compute the coefficients of a continuous extension of an explicit Runge-Kutta method, using additional stages
+ * that are evaluated after the step has been accepted, in the manner of the dense output of DOP853 (Hairer et al., 1993,
+ * Section II.6). Each additional stage is evaluated at the state given by the continuous extension obtained from all
+ * preceding stages (an additional stage at a node of 1 is evaluated at the integrated state at the end of the step), so
+ * that the order of the continuous extension is raised as stages are added. The coefficients of the continuous extension
+ * are then computed as in computeRungeKuttaContinuousExtensionCoefficients, for the stages of the method followed by the
+ * additional stages.
+ * \param coefficients Coefficients of the Runge-Kutta method.
+ * \param additionalStageNodes Nodes (fraction of the step) of the additional stages, in order of evaluation.
+ * \param additionalStageCoefficients Coefficients (number of additional stages x total number of stages) defining the state
+ * at which each additional stage is evaluated, as y0 + h sum_j a_j k_j (returned by reference).
+ * \param continuousExtensionOrder Order of the continuous extension that was obtained (returned by reference).
+ * \param maximumOrder Maximum order of the continuous extension that is attempted (limited by the order of the integrated
+ * estimate).
+ * \return Matrix B (total number of stages x polynomial degree) defining the continuous extension.
+ */
+Eigen::MatrixXd computeRungeKuttaContinuousExtensionCoefficients(
+        const RungeKuttaCoefficients& coefficients,
+        const Eigen::VectorXd& additionalStageNodes,
+        Eigen::MatrixXd& additionalStageCoefficients,
+        int& continuousExtensionOrder,
+        const int maximumOrder = 8 );
+
+//! Function to retrieve the nodes of the additional stages used for the continuous extension of a Runge-Kutta method.
+/*!
+ * Function to retrieve the nodes of the additional stages used for the continuous extension of a Runge-Kutta method (see
+ * computeRungeKuttaContinuousExtensionCoefficients). Additional stages are defined for RKDP8(7) only, for which they raise
+ * the order of the continuous extension from 5 to 7. For all other methods, no additional stages are defined, and the
+ * continuous extension is of lower order than the method itself.
+ * \param coefficients Coefficients of the Runge-Kutta method.
+ * \return Nodes (fraction of the step) of the additional stages, in order of evaluation (empty if none are defined).
+ */
+Eigen::VectorXd getRungeKuttaContinuousExtensionAdditionalStageNodes( const RungeKuttaCoefficients& coefficients );
+
+//! Class to store, and evaluate, the continuous (dense) output of a Runge-Kutta integrator.
+/*!
+ * Class to store, and evaluate, the continuous (dense) output of a Runge-Kutta integrator. For each accepted step, the
+ * stage derivatives are combined (using the coefficients from computeRungeKuttaContinuousExtensionCoefficients) into a
+ * polynomial in the normalized step time theta = ( t - t0 ) / h, which is stored. The state anywhere in the integrated
+ * interval can subsequently be retrieved by directly evaluating the polynomial of the corresponding step, without
+ * interpolation of the discrete output. For methods for which additional stages are defined (see
+ * getRungeKuttaContinuousExtensionAdditionalStageNodes), these are evaluated when adding a step, so that the continuous
+ * extension is of order 7 for RKDP8(7). For all other methods, only the stages of the method are used, and the order of the
+ * continuous extension is lower than that of the method. The polynomial coefficients of all steps are stored in order of
+ * integration, in a single (growing) matrix; both forward and backward integration are supported.
+ * \tparam IndependentVariableType Type of the independent variable.
+ * \tparam StateType Type of the state (Eigen::Matrix derived type).
+ * \tparam TimeStepType Type of the step size.
+ */
+template< typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+          typename TimeStepType = IndependentVariableType >
+class RungeKuttaDenseOutput
+{
+public:
+
+    //! Typedef for the matrix in which the polynomial coefficients are stored.
+    typedef Eigen::Matrix< typename StateType::Scalar, Eigen::Dynamic, Eigen::Dynamic > CoefficientMatrixType;
+
+    //! Constructor
+    /*!
+     * Constructor, computes the coefficients of the continuous extension of the Runge-Kutta method.
+     * \param coefficients Coefficients of the Runge-Kutta method with which the steps are taken.
+     * \param useAdditionalStages Boolean denoting whether the additional stages of the continuous extension are to be
+     * evaluated, if any are defined for the method (see getRungeKuttaContinuousExtensionAdditionalStageNodes).
+     */
+    RungeKuttaDenseOutput( const RungeKuttaCoefficients& coefficients,
+                           const bool useAdditionalStages = true ):
+        numberOfStages_( coefficients.cCoefficients.rows( ) ), stateRows_( 0 ), stateColumns_( 0 )
+    {
+        if( useAdditionalStages )
+        {
+            additionalStageNodes_ = getRungeKuttaContinuousExtensionAdditionalStageNodes( coefficients );
+        }
+
+        if( additionalStageNodes_.rows( ) > 0 )
+        {
+            continuousExtensionCoefficients_ = computeRungeKuttaContinuousExtensionCoefficients(
+                        coefficients, additionalStageNodes_, additionalStageCoefficients_, continuousExtensionOrder_ );
+        }
+        else
+        {
+            continuousExtensionCoefficients_ = computeRungeKuttaContinuousExtensionCoefficients(
+                        coefficients, continuousExtensionOrder_ );
+        }
+    }
+
+    //! Function to add an accepted step to the dense output.
+    /*!
+     * Function to add an accepted step to the dense output, computing the polynomial coefficients from the stage
+     * derivatives (evaluating the additional stages of the continuous extension first, if any). The step must start where
+     * the previous step ended (up to a discrete change of the state).
+     * \param stepStart Value of the independent variable at the start of the step.
+     * \param stepSize Size of the step.
+     * \param initialState State at the start of the step.
+     * \param stageDerivatives State derivatives evaluated at each of the stages of the step.
+     * \param stateDerivativeFunction Function with which the additional stages are evaluated (only used, and required, if
+     * additional stages are defined).
+     */
+    template< typename StateDerivativeType >
+    void addStep( const IndependentVariableType stepStart,
+                  const TimeStepType stepSize,
+                  const StateType& initialState,
+                  const std::vector< StateDerivativeType >& stageDerivatives,
+                  const std::function< StateDerivativeType( const IndependentVariableType, const StateType& ) >&
+                  stateDerivativeFunction = nullptr )
+    {
+        if( static_cast< int >( stageDerivatives.size( ) ) != numberOfStages_ )
+        {
+            throw std::runtime_error( "Error when adding step to Runge-Kutta dense output, number of stages is inconsistent" );
+        }
+        if( stepSizes_.size( ) > 0 && ( ( stepSize > 0 ) != ( stepSizes_.back( ) > 0 ) ) )
+        {
+            throw std::runtime_error( "Error when adding step to Runge-Kutta dense output, direction of integration changed" );
+        }
+        if( stepSizes_.size( ) == 0 )
+        {
+            stateRows_ = initialState.rows( );
+            stateColumns_ = initialState.cols( );
+        }
+        else if( initialState.rows( ) != stateRows_ || initialState.cols( ) != stateColumns_ )
+        {
+            throw std::runtime_error( "Error when adding step to Runge-Kutta dense output, size of state changed" );
+        }
+
+        // Evaluate additional stages, each at the state given by the continuous extension of the preceding stages
+        std::vector< StateDerivativeType > additionalStageDerivatives;
+        if( additionalStageNodes_.rows( ) > 0 )
+        {
+            if( stateDerivativeFunction == nullptr )
+            {
+                throw std::runtime_error(
+                            "Error when adding step to Runge-Kutta dense output, no function provided to evaluate additional stages" );
+            }
+
+            additionalStageDerivatives.reserve( additionalStageNodes_.rows( ) );
+            for( int i = 0; i < additionalStageNodes_.rows( ); i++ )
+            {
+                StateType stageState = initialState;
+                for( int j = 0; j < numberOfStages_ + i; j++ )
+                {
+                    if( additionalStageCoefficients_( i, j ) != 0.0 )
+                    {
+                        stageState += ( stepSize * additionalStageCoefficients_( i, j ) ) *
+                                ( ( j < numberOfStages_ ) ? stageDerivatives[ j ] :
+                                                            additionalStageDerivatives[ j - numberOfStages_ ] );
+                    }
+                }
+                additionalStageDerivatives.push_back(
+                            stateDerivativeFunction( stepStart + additionalStageNodes_( i ) * stepSize, stageState ) );
+            }
+        }
+
+        // Extend storage of polynomial coefficients (doubling its capacity) if needed
+        const int numberOfPolynomialCoefficients = continuousExtensionCoefficients_.cols( ) + 1;
+        const int firstColumn = getNumberOfSteps( ) * numberOfPolynomialCoefficients;
+        if( polynomialCoefficients_.cols( ) < firstColumn + numberOfPolynomialCoefficients )
+        {
+            polynomialCoefficients_.conservativeResize(
+                        stateRows_ * stateColumns_,
+                        std::max( 2 * static_cast< int >( polynomialCoefficients_.cols( ) ),
+                                  firstColumn + numberOfPolynomialCoefficients ) );
+        }
+
+        // Compute polynomial coefficients P_j = h sum_i B_ij k_i, with P_0 = y0
+        getPolynomialCoefficient( firstColumn ) = initialState;
+        for( int j = 1; j < numberOfPolynomialCoefficients; j++ )
+        {
+            Eigen::Map< CoefficientMatrixType > currentCoefficient = getPolynomialCoefficient( firstColumn + j );
+            currentCoefficient.setZero( );
+            for( int i = 0; i < continuousExtensionCoefficients_.rows( ); i++ )
+            {
+                if( continuousExtensionCoefficients_( i, j - 1 ) != 0.0 )
+                {
+                    currentCoefficient += ( stepSize * continuousExtensionCoefficients_( i, j - 1 ) ) *
+                            ( ( i < numberOfStages_ ) ? stageDerivatives[ i ] :
+                                                        additionalStageDerivatives[ i - numberOfStages_ ] );
+                }
+            }
+        }
+
+        stepStarts_.push_back( stepStart );
+        stepSizes_.push_back( stepSize );
+    }
+
+    //! Function to remove the last step from the dense output (e.g. when the integrator is rolled back).
+    void removeLastStep( )
+    {
+        if( stepStarts_.size( ) > 0 )
+        {
+            stepStarts_.pop_back( );
+            stepSizes_.pop_back( );
+        }
+    }
+
+    //! Function to remove all steps from the dense output.
+    void clear( )
+    {
+        stepStarts_.clear( );
+        stepSizes_.clear( );
+        polynomialCoefficients_.resize( 0, 0 );
+    }
+
+    //! Function to evaluate the dense output.
+    /*!
+     * Function to evaluate the dense output. If the independent variable is outside of the integrated interval, the
+     * polynomial of the first/last step is extrapolated.
+     * \param independentVariable Value of the independent variable at which the state is to be evaluated.
+     * \return State at the requested independent variable
+     */
+    StateType getState( const IndependentVariableType independentVariable ) const
+    {
+        StateType state;
+        state.resize( stateRows_, stateColumns_ );
+        getStateBlock( independentVariable, 0, 0, state );
+        return state;
+    }
+
+    //! Function to evaluate a block of the dense output.
+    /*!
+     * Function to evaluate a block of the dense output (e.g. the translational state of a single body, out of the full
+     * propagated state), without evaluating the remainder of the state. If the independent variable is outside of the
+     * integrated interval, the polynomial of the first/last step is extrapolated.
+     * \param independentVariable Value of the independent variable at which the state is to be evaluated.
+     * \param startRow Index of the first row of the block.
+     * \param startColumn Index of the first column of the block.
+     * \param stateBlock Evaluated block of the state (returned by reference). Size of the block is taken from the size of
+     * this variable on input.
+     */
+    template< typename BlockType >
+    void getStateBlock( const IndependentVariableType independentVariable,
+                        const int startRow,
+                        const int startColumn,
+                        BlockType& stateBlock ) const
+    {
+        int stepIndex = findStep( independentVariable );
+        const double theta = computeNormalizedStepTime( independentVariable, stepIndex );
+
+        // Evaluate polynomial using Horner's scheme
+        const int numberOfPolynomialCoefficients = continuousExtensionCoefficients_.cols( ) + 1;
+        const int firstColumn = stepIndex * numberOfPolynomialCoefficients;
+        const int numberOfRows = stateBlock.rows( );
+        const int numberOfColumns = stateBlock.cols( );
+        stateBlock = getPolynomialCoefficient( firstColumn + numberOfPolynomialCoefficients - 1 ).block(
+                    startRow, startColumn, numberOfRows, numberOfColumns );
+        for( int j = numberOfPolynomialCoefficients - 2; j >= 0; j-- )
+        {
+            stateBlock = stateBlock * theta +
+                    getPolynomialCoefficient( firstColumn + j ).block( startRow, startColumn, numberOfRows, numberOfColumns );
+        }
+    }
+    //! Function to retrieve the values of the independent variable at the step boundaries, in order of integration.
+    std::vector< IndependentVariableType > getStepBoundaries( ) const
+    {
+        std::vector< IndependentVariableType > stepBoundaries = stepStarts_;
+        if( stepStarts_.size( ) > 0 )
+        {
+            stepBoundaries.push_back( getEndIndependentVariable( ) );
+        }
+        return stepBoundaries;
+    }
+
+    //! Function to retrieve the value of the independent variable at the start of the dense output.
+    IndependentVariableType getStartIndependentVariable( ) const
+    {
+        checkNonEmpty( );
+        return stepStarts_.front( );
+    }
+
+    //! Function to retrieve the value of the independent variable at the end of the dense output.
+    IndependentVariableType getEndIndependentVariable( ) const
+    {
+        checkNonEmpty( );
+        return stepStarts_.back( ) + stepSizes_.back( );
+    }
+
+    //! Function to retrieve the number of stored steps.
+    int getNumberOfSteps( ) const
+    {
+        return static_cast< int >( stepStarts_.size( ) );
+    }
+
+    //! Function to retrieve the order of the continuous extension.
+    int getContinuousExtensionOrder( ) const
+    {
+        return continuousExtensionOrder_;
+    }
+
+    //! Function to retrieve the coefficients of the continuous extension (see computeRungeKuttaContinuousExtensionCoefficients).
+    Eigen::MatrixXd getContinuousExtensionCoefficients( ) const
+    {
+        return continuousExtensionCoefficients_;
+    }
+
+private:
+
+    //! Function to check whether any steps have been stored, throwing an exception if not.
+    void checkNonEmpty( ) const
+    {
+        if( stepStarts_.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error in Runge-Kutta dense output, no steps have been stored" );
+        }
+    }
+
+    //! Function to find the index of the step in which the given independent variable lies.
+    int findStep( const IndependentVariableType independentVariable ) const
+    {
+        checkNonEmpty( );
+
+        // Find last step that starts at, or before (in the direction of integration), the independent variable
+        int stepIndex;
+        if( stepSizes_.front( ) > 0 )
+        {
+            stepIndex = static_cast< int >(
+                        std::upper_bound( stepStarts_.begin( ), stepStarts_.end( ), independentVariable ) -
+                        stepStarts_.begin( ) ) - 1;
+        }
+        else
+        {
+            stepIndex = static_cast< int >(
+                        std::upper_bound( stepStarts_.begin( ), stepStarts_.end( ), independentVariable,
+                                          std::greater< IndependentVariableType >( ) ) - stepStarts_.begin( ) ) - 1;
+        }
+        return std::max( stepIndex, 0 );
+    }
+
+    //! Function to retrieve (a map of) the column of polynomialCoefficients_ with given index, as a matrix of state size.
+    Eigen::Map< CoefficientMatrixType > getPolynomialCoefficient( const int columnIndex )
+    {
+        return Eigen::Map< CoefficientMatrixType >(
+                    polynomialCoefficients_.col( columnIndex ).data( ), stateRows_, stateColumns_ );
+    }
+
+    //! Function to retrieve (a map of) the column of polynomialCoefficients_ with given index, as a matrix of state size.
+    Eigen::Map< const CoefficientMatrixType > getPolynomialCoefficient( const int columnIndex ) const
+    {
+        return Eigen::Map< const CoefficientMatrixType >(
+                    polynomialCoefficients_.col( columnIndex ).data( ), stateRows_, stateColumns_ );
+    }
+
+    //! Function to compute the normalized time theta = ( t - t0 ) / h in a given step.
+    double computeNormalizedStepTime( const IndependentVariableType independentVariable, const int stepIndex ) const
+    {
+        return static_cast< double >( ( independentVariable - stepStarts_[ stepIndex ] ) / stepSizes_[ stepIndex ] );
+    }
+
+    //! Coefficients of the continuous extension (see computeRungeKuttaContinuousExtensionCoefficients).
+    Eigen::MatrixXd continuousExtensionCoefficients_;
+
+    //! Order of the continuous extension.
+    int continuousExtensionOrder_;
+
+    //! Nodes of the additional stages of the continuous extension (empty if none are used).
+    Eigen::VectorXd additionalStageNodes_;
+
+    //! Coefficients defining the states at which the additional stages are evaluated.
+    Eigen::MatrixXd additionalStageCoefficients_;
+
+    //! Number of stages of the Runge-Kutta method (excluding additional stages).
+    int numberOfStages_;
+
+    //! Number of rows of the state.
+    int stateRows_;
+
+    //! Number of columns of the state.
+    int stateColumns_;
+
+    //! Values of the independent variable at the start of each step.
+    std::vector< IndependentVariableType > stepStarts_;
+
+    //! Size of each step.
+    std::vector< TimeStepType > stepSizes_;
+
+    //! Polynomial coefficients (in normalized step time) of the state in each step. Each column contains one coefficient
+    //! (column-major flattened state), with the coefficients of each step stored in consecutive columns, in order of
+    //! increasing power, and the steps stored in order of integration. Number of columns may exceed the number in use.
+    CoefficientMatrixType polynomialCoefficients_;
+};
+
+extern template class RungeKuttaDenseOutput< double, Eigen::VectorXd, double >;
+extern template class RungeKuttaDenseOutput< double, Eigen::Vector6d, double >;
+extern template class RungeKuttaDenseOutput< double, Eigen::MatrixXd, double >;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDAT_RUNGE_KUTTA_DENSE_OUTPUT_H
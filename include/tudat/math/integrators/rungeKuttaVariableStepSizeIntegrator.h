@@ -30,6 +30,7 @@
 #include "tudat/basics/utilityMacros.h"
 #include "tudat/math/integrators/reinitializableNumericalIntegrator.h"
 #include "tudat/math/integrators/rungeKuttaCoefficients.h"
+#include "tudat/math/integrators/rungeKuttaDenseOutput.h"
 #include "tudat/math/integrators/stepSizeController.h"
 
 namespace tudat
@@ -156,6 +157,8 @@ public:
             stepSizeValidator->resetMinimumIntegrationTimeStepHandling( set_to_minimum_step_silently );
         }
         stepSizeValidator_ = stepSizeValidator;
+
+        initializeStageWorkspaces( initialState );
     }
 
     //! Default constructor.
@@ -233,6 +236,8 @@ public:
         {
             throw std::runtime_error( "Error when creating variable step-size RK integrator, fixed step coefficients are used ("+ coefficients_.name +")." );
         }
+
+        initializeStageWorkspaces( initialState );
     }
 
     RungeKuttaVariableStepSizeIntegrator(
@@ -260,6 +265,8 @@ public:
         {
             throw std::runtime_error( "Error when creating variable step-size RK integrator, fixed step coefficients are used ("+ coefficients_.name +")." );
         }
+
+        initializeStageWorkspaces( initialState );
     }
 
     //! Get step size of the next step.
@@ -323,6 +330,11 @@ public:
 
         this->currentIndependentVariable_ = this->lastIndependentVariable_;
         this->currentState_ = this->lastState_;
+
+        if( denseOutput_ != nullptr )
+        {
+            denseOutput_->removeLastStep( );
+        }
         return true;
     }
 
@@ -409,6 +421,37 @@ public:
         return stepSizeValidator_;
     }
 
+    //! Function to toggle the storage of the dense output of the integrator.
+    /*!
+     * Function to toggle the storage of the dense output of the integrator. If set to true, the continuous extension of
+     * each accepted step is stored (see RungeKuttaDenseOutput), so that the state can be evaluated anywhere in the
+     * integrated interval without interpolation. Steps that are rolled back are removed from the dense output. Previously
+     * stored dense output is discarded when calling this function. For RKDP8(7), the continuous extension uses additional
+     * stages (by default), requiring additional state derivative evaluations after each accepted step (see
+     * getRungeKuttaContinuousExtensionAdditionalStageNodes).
+     * \param storeDenseOutput Boolean denoting whether the dense output is to be stored.
+     * \param useAdditionalStages Boolean denoting whether the additional stages of the continuous extension are to be
+     * evaluated, if any are defined for the coefficient set.
+     */
+    void setDenseOutputStorage( const bool storeDenseOutput, const bool useAdditionalStages = true )
+    {
+        if( storeDenseOutput )
+        {
+            denseOutput_ = std::make_shared< RungeKuttaDenseOutput< IndependentVariableType, StateType, TimeStepType > >(
+                        coefficients_, useAdditionalStages );
+        }
+        else
+        {
+            denseOutput_ = nullptr;
+        }
+    }
+
+    //! Function to retrieve the dense output of the integrator (nullptr if not stored, see setDenseOutputStorage).
+    std::shared_ptr< RungeKuttaDenseOutput< IndependentVariableType, StateType, TimeStepType > > getDenseOutput( )
+    {
+        return denseOutput_;
+    }
+
 protected:
 
     //! Computes the next step size and validates the result.
@@ -424,6 +467,24 @@ protected:
                                                        const StateType& higherOrderEstimate,
                                                        const TimeStepType stepSize );
 
+    //! Function to allocate the workspaces of the stage computations.
+    /*!
+     * Function to allocate the workspaces of the stage computations (state derivatives per stage, intermediate state and
+     * lower/higher order estimates), sized from the number of stages of the coefficients and the size of the state. These
+     * are reused in each call of performIntegrationStep, so that no memory is allocated by the integrator when taking
+     * (or rejecting) a step.
+     * \param initialState Initial state of the integrator, used to size the workspaces.
+     */
+    void initializeStageWorkspaces( const StateType& initialState )
+    {
+        currentStateDerivatives_.assign( this->coefficients_.cCoefficients.rows( ),
+                                         StateDerivativeType::Zero( initialState.rows( ), initialState.cols( ) ) );
+        intermediateState_ = initialState;
+        lowerOrderEstimate_ = initialState;
+        higherOrderEstimate_ = initialState;
+        lastState_ = initialState;
+    }
+
 
     //! Current independent variable.
     /*!
@@ -480,6 +541,14 @@ protected:
      */
     std::vector< StateDerivativeType > currentStateDerivatives_;
 
+    //! Workspace for the intermediate state at which the state derivative of a stage is evaluated.
+    StateType intermediateState_;
+
+    //! Workspace for the integrated result with the lower order coefficients.
+    StateType lowerOrderEstimate_;
+
+    //! Workspace for the integrated result with the higher order coefficients.
+    StateType higherOrderEstimate_;
 
 
     std::shared_ptr< IntegratorStepSizeController< TimeStepType, StateType > > stepSizeController_;
@@ -489,6 +558,9 @@ protected:
     //! Boolean denoting whether step size control is to be used
     bool useStepSizeControl_;
 
+    //! Dense output of the accepted steps (nullptr if not stored).
+    std::shared_ptr< RungeKuttaDenseOutput< IndependentVariableType, StateType, TimeStepType > > denseOutput_;
+
 };
 
 extern template class RungeKuttaVariableStepSizeIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
@@ -507,30 +579,28 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         throw std::invalid_argument( "Error in RKF integrator, step size is NaN" );
     }
 
-    // Define and allocated vector for the number of stages.
-    currentStateDerivatives_.clear( );
-    currentStateDerivatives_.reserve( this->coefficients_.cCoefficients.rows( ) );
+    // Resize vector of state derivatives to the number of stages (no-op, unless the coefficients have changed).
+    currentStateDerivatives_.resize( this->coefficients_.cCoefficients.rows( ) );
 
-    // Define lower and higher order estimates.
-    StateType lowerOrderEstimate( this->currentState_ ), higherOrderEstimate( this->currentState_ );
+    // Initialize lower and higher order estimates.
+    lowerOrderEstimate_ = this->currentState_;
+    higherOrderEstimate_ = this->currentState_;
 
     // Compute the k_i state derivatives per stage.
     for ( int stage = 0; stage < this->coefficients_.cCoefficients.rows( ); stage++ )
     {
         // Compute the intermediate state to pass to the state derivative for this stage.
-        StateType intermediateState( this->currentState_ );
-
-        // Compute the intermediate state.
+        intermediateState_ = this->currentState_;
         for ( int column = 0; column < stage; column++ )
         {
-            intermediateState += stepSize * this->coefficients_.aCoefficients( stage, column ) *
+            intermediateState_ += stepSize * this->coefficients_.aCoefficients( stage, column ) *
                     currentStateDerivatives_[ column ];
         }
 
         // Compute the state derivative.
         const IndependentVariableType time = this->currentIndependentVariable_ +
                 this->coefficients_.cCoefficients( stage ) * stepSize;
-        currentStateDerivatives_.push_back( this->stateDerivativeFunction_( time, intermediateState ) );
+        currentStateDerivatives_[ stage ] = this->stateDerivativeFunction_( time, intermediateState_ );
 
         // Check if propagation should terminate because the propagation termination condition has been reached
         // while computing the intermediate state.
@@ -542,17 +612,22 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         }
 
         // Update the estimate.
-        lowerOrderEstimate += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
+        lowerOrderEstimate_ += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
                 currentStateDerivatives_[ stage ];
-        higherOrderEstimate += this->coefficients_.bCoefficients( 1, stage ) * stepSize *
+        higherOrderEstimate_ += this->coefficients_.bCoefficients( 1, stage ) * stepSize *
                 currentStateDerivatives_[ stage ];
     }
 
     // Determine if the error was within bounds and compute a new step size.
-    if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate,
-                                               higherOrderEstimate, stepSize ) )
+    if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate_,
+                                               higherOrderEstimate_, stepSize ) )
     {
         // Accept the current step.
+        if( denseOutput_ != nullptr )
+        {
+            denseOutput_->addStep( this->currentIndependentVariable_, stepSize, this->currentState_,
+                                   currentStateDerivatives_, this->stateDerivativeFunction_ );
+        }
         this->lastIndependentVariable_ = this->currentIndependentVariable_;
         this->lastState_ = this->currentState_;
         this->currentIndependentVariable_ += stepSize;
@@ -560,11 +635,11 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         switch ( this->coefficients_.orderEstimateToIntegrate )
         {
         case RungeKuttaCoefficients::lower:
-            this->currentState_ = lowerOrderEstimate;
+            this->currentState_ = lowerOrderEstimate_;
             return this->currentState_;
 
         case RungeKuttaCoefficients::higher:
-            this->currentState_ = higherOrderEstimate;
+            this->currentState_ = higherOrderEstimate_;
             return this->currentState_;
 
         default: // The default case will never occur because OrderEstimateToIntegrate is an enum.
@@ -288,26 +288,15 @@ public:
         {
             throw std::runtime_error( "Error in per-element step size control; tolerances not initialized" );
         }
-        // Compute the truncation error based on the higher and lower order estimates.
-        const StateType truncationError_ =
-            ( firstStateEstimate - secondStateEstimate ).array( ).abs( );
-
-        // Compute error tolerance based on relative and absolute error tolerances.
-        const StateType errorTolerance_ =
-            ( firstStateEstimate.array( ).abs( ) *
-              relativeErrorTolerance_.array( ) ).matrix( )
-            + absoluteErrorTolerance_;
-
-        // Compute relative truncation error. This will indicate if the current step satisfies the
-        // required tolerances.
-        const StateType relativeTruncationError_ = truncationError_.array( ) /
-                                                   errorTolerance_.array( );
+        // Compute the maximum relative truncation error, from the truncation error (difference between the higher and
+        // lower order estimates) and the error tolerance (based on relative and absolute error tolerances). This will
+        // indicate if the current step satisfies the required tolerances. The expression is evaluated in a single pass,
+        // without temporary states.
+        const typename StateType::Scalar maximumErrorInState_ =
+            ( ( firstStateEstimate - secondStateEstimate ).array( ).abs( ) /
+              ( firstStateEstimate.array( ).abs( ) * relativeErrorTolerance_.array( ) +
+                absoluteErrorTolerance_.array( ) ) ).maxCoeff( );
 
-        // Compute the maximum error based on the largest coefficient in the relative truncation error
-        // matrix.
-        const typename StateType::Scalar maximumErrorInState_
-            = relativeTruncationError_.array( ).abs( ).maxCoeff( );
-        
         return this->computeTimeStepFromErrorEstimate( maximumErrorInState_, currentStep );
 
     }
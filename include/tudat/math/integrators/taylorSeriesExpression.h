@@ -0,0 +1,306 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Jorba, A. and Zou, M., A software package for the numerical integration of ODEs by means of high-order Taylor
+ *          methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *      Griewank, A. and Walther, A., Evaluating Derivatives, 2nd edition, SIAM, 2008 (Chapter 13).
+ *
+ */
+
+#ifndef TUDAT_TAYLOR_SERIES_EXPRESSION_H
+#define TUDAT_TAYLOR_SERIES_EXPRESSION_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Types of elementary operations from which a state derivative function is recorded, for Taylor series generation.
+enum TaylorSeriesOperationTypes
+{
+    taylor_series_independent_variable,
+    taylor_series_state_variable,
+    taylor_series_constant,
+    taylor_series_addition,
+    taylor_series_subtraction,
+    taylor_series_multiplication,
+    taylor_series_division,
+    taylor_series_negation,
+    taylor_series_scalar_addition,
+    taylor_series_scalar_multiplication,
+    taylor_series_square_root,
+    taylor_series_power
+};
+
+//! Elementary operation in a recorded state derivative function.
+struct TaylorSeriesOperation
+{
+    //! Type of operation.
+    TaylorSeriesOperationTypes operationType;
+
+    //! Index of the (first) operation that is the argument of this operation (-1 if none).
+    int firstArgument;
+
+    //! Index of the second operation that is the argument of this operation (-1 if none).
+    int secondArgument;
+
+    //! Scalar (constant value, scalar term or factor, or exponent) used by the operation.
+    double scalar;
+};
+
+class TaylorSeriesExpression;
+
+//! Variable used to record a state derivative function as a sequence of elementary operations.
+/*!
+ *  Variable used to record a state derivative function as a sequence of elementary operations (see
+ *  TaylorSeriesExpression). The variable either refers to an operation in an expression, or is a constant that is not (yet)
+ *  part of an expression. Arithmetic with the variables records the corresponding operations, where operations on
+ *  constants are folded into a single constant or into a scalar operation. The state derivative function that is to be
+ *  recorded should therefore be written generically in the scalar type, using only the operations defined below.
+ */
+class TaylorSeriesVariable
+{
+public:
+
+    //! Constructor for a constant variable.
+    /*!
+     *  Constructor for a constant variable, which is not (yet) part of an expression.
+     *  \param constantValue Value of the constant.
+     */
+    TaylorSeriesVariable( const double constantValue = 0.0 ):
+        expression_( nullptr ), operationIndex_( -1 ), constantValue_( constantValue ){ }
+
+    //! Constructor for a variable referring to an operation in an expression.
+    /*!
+     *  Constructor for a variable referring to an operation in an expression.
+     *  \param expression Expression in which the operation is recorded.
+     *  \param operationIndex Index of the operation in the expression.
+     */
+    TaylorSeriesVariable( TaylorSeriesExpression* expression, const int operationIndex ):
+        expression_( expression ), operationIndex_( operationIndex ), constantValue_( 0.0 ){ }
+
+    //! Function to retrieve whether the variable is a constant that is not part of an expression.
+    bool isConstant( ) const
+    {
+        return expression_ == nullptr;
+    }
+
+    //! Function to retrieve the expression in which the variable is recorded (nullptr for constants).
+    TaylorSeriesExpression* getExpression( ) const
+    {
+        return expression_;
+    }
+
+    //! Function to retrieve the index of the operation in the expression (-1 for constants).
+    int getOperationIndex( ) const
+    {
+        return operationIndex_;
+    }
+
+    //! Function to retrieve the value of the constant (only meaningful for constants).
+    double getConstantValue( ) const
+    {
+        return constantValue_;
+    }
+
+    //! Addition assignment operator.
+    TaylorSeriesVariable& operator+=( const TaylorSeriesVariable& variable );
+
+    //! Subtraction assignment operator.
+    TaylorSeriesVariable& operator-=( const TaylorSeriesVariable& variable );
+
+    //! Multiplication assignment operator.
+    TaylorSeriesVariable& operator*=( const TaylorSeriesVariable& variable );
+
+    //! Division assignment operator.
+    TaylorSeriesVariable& operator/=( const TaylorSeriesVariable& variable );
+
+    // The arithmetic operations are declared as friends only, so that they are found by argument-dependent lookup for
+    // TaylorSeriesVariable arguments, but do not hide the standard functions (e.g. std::pow) for other code in this namespace.
+
+    //! Addition of two variables.
+    friend TaylorSeriesVariable operator+( const TaylorSeriesVariable& firstVariable,
+                                           const TaylorSeriesVariable& secondVariable );
+
+    //! Subtraction of two variables.
+    friend TaylorSeriesVariable operator-( const TaylorSeriesVariable& firstVariable,
+                                           const TaylorSeriesVariable& secondVariable );
+
+    //! Multiplication of two variables.
+    friend TaylorSeriesVariable operator*( const TaylorSeriesVariable& firstVariable,
+                                           const TaylorSeriesVariable& secondVariable );
+
+    //! Division of two variables.
+    friend TaylorSeriesVariable operator/( const TaylorSeriesVariable& firstVariable,
+                                           const TaylorSeriesVariable& secondVariable );
+
+    //! Negation of a variable.
+    friend TaylorSeriesVariable operator-( const TaylorSeriesVariable& variable );
+
+    //! Square root of a variable.
+    friend TaylorSeriesVariable sqrt( const TaylorSeriesVariable& variable );
+
+    //! Power of a variable, with a constant exponent.
+    friend TaylorSeriesVariable pow( const TaylorSeriesVariable& variable, const double exponent );
+
+private:
+
+    //! Expression in which the variable is recorded (nullptr for constants).
+    TaylorSeriesExpression* expression_;
+
+    //! Index of the operation in the expression (-1 for constants).
+    int operationIndex_;
+
+    //! Value of the constant (only meaningful for constants).
+    double constantValue_;
+};
+
+//! Class storing a recorded state derivative function, from which the Taylor series of the solution are generated.
+/*!
+ *  Class storing a state derivative function, recorded as a sequence of elementary operations on the independent variable
+ *  and the state entries, from which the Taylor series of the solution of the differential equation are generated by
+ *  automatic differentiation (Griewank and Walther, 2008; Jorba and Zou, 2005). For each elementary operation, the Taylor
+ *  coefficient of order k of its result follows from a recurrence relation in the coefficients up to order k of its
+ *  arguments. Since the coefficient of order k + 1 of the state follows from that of order k of the state derivative, all
+ *  coefficients up to order p are obtained in p passes over the operations, at a cost of O( p^2 ) for the complete series.
+ *
+ *  The expression is created by createTaylorSeriesExpression, by evaluating a state derivative function that is written
+ *  generically in the scalar type with TaylorSeriesVariable. Since the operations are recorded once, the function may not
+ *  branch on the values of its input. Functions of time that are not recorded (e.g. ephemerides) cannot be included.
+ */
+class TaylorSeriesExpression
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor, creates the operations for the independent variable and the state entries (at indices 0 and 1 to
+     *  numberOfStateEntries, respectively).
+     *  \param numberOfStateEntries Number of entries in the state vector.
+     */
+    TaylorSeriesExpression( const int numberOfStateEntries );
+
+    //! Function to retrieve the variable representing the independent variable.
+    TaylorSeriesVariable getIndependentVariable( )
+    {
+        return TaylorSeriesVariable( this, 0 );
+    }
+
+    //! Function to retrieve the variables representing the entries of the state.
+    std::vector< TaylorSeriesVariable > getStateVariables( );
+
+    //! Function to record an operation.
+    /*!
+     *  Function to record an operation, and retrieve the variable representing its result.
+     *  \param operationType Type of operation.
+     *  \param firstArgument Index of the (first) operation that is the argument of this operation (-1 if none).
+     *  \param secondArgument Index of the second operation that is the argument of this operation (-1 if none).
+     *  \param scalar Scalar used by the operation.
+     *  \return Variable representing the result of the operation.
+     */
+    TaylorSeriesVariable addOperation( const TaylorSeriesOperationTypes operationType,
+                                       const int firstArgument,
+                                       const int secondArgument = -1,
+                                       const double scalar = 0.0 );
+
+    //! Function to set the variables representing the entries of the state derivative.
+    /*!
+     *  Function to set the variables representing the entries of the state derivative, after the state derivative function
+     *  has been recorded. Constant entries are added to the expression.
+     *  \param stateDerivative Variables representing the entries of the state derivative.
+     */
+    void setStateDerivative( const std::vector< TaylorSeriesVariable >& stateDerivative );
+
+    //! Function to retrieve the number of entries in the state vector.
+    int getNumberOfStateEntries( ) const
+    {
+        return numberOfStateEntries_;
+    }
+
+    //! Function to retrieve the number of recorded operations (including independent variable and state entries).
+    int getNumberOfOperations( ) const
+    {
+        return static_cast< int >( operations_.size( ) );
+    }
+
+    //! Function to retrieve the recorded operations.
+    const std::vector< TaylorSeriesOperation >& getOperations( ) const
+    {
+        return operations_;
+    }
+
+    //! Function to compute the Taylor coefficients of the solution through a given state, up to a given order.
+    /*!
+     *  Function to compute the (normalized) Taylor coefficients x_k of the solution x( t + h ) = sum_k x_k h^k through a
+     *  given state at a given independent variable, up to a given order.
+     *  \param independentVariable Value of the independent variable t.
+     *  \param state State x( t ) (x_0).
+     *  \param order Order up to which the coefficients are to be computed.
+     *  \param taylorCoefficients Taylor coefficients x_k, with one column for each order k from 0 to order (returned by
+     *  reference, resized if needed).
+     */
+    void computeTaylorCoefficients( const double independentVariable,
+                                    const Eigen::VectorXd& state,
+                                    const int order,
+                                    Eigen::MatrixXd& taylorCoefficients );
+
+    //! Function to compute the state derivative from the recorded function.
+    /*!
+     *  Function to compute the state derivative from the recorded function (i.e. the first-order Taylor coefficient).
+     *  \param independentVariable Value of the independent variable.
+     *  \param state Current state.
+     *  \return State derivative.
+     */
+    Eigen::VectorXd computeStateDerivative( const double independentVariable, const Eigen::VectorXd& state );
+
+private:
+
+    //! Function to compute the Taylor coefficient of given order of all operations (other than state entries).
+    void computeOperationCoefficients( const int order );
+
+    //! Number of entries in the state vector.
+    int numberOfStateEntries_;
+
+    //! Recorded operations, with the independent variable first, followed by the state entries.
+    std::vector< TaylorSeriesOperation > operations_;
+
+    //! Indices of the operations representing the entries of the state derivative.
+    std::vector< int > stateDerivativeIndices_;
+
+    //! Taylor coefficients of all operations, with one column per operation and one row per order (pre-allocated).
+    Eigen::MatrixXd operationCoefficients_;
+};
+
+//! Function to record a state derivative function as an expression for Taylor series generation.
+/*!
+ *  Function to record a state derivative function as an expression for Taylor series generation (see
+ *  TaylorSeriesExpression).
+ *  \param numberOfStateEntries Number of entries in the state vector.
+ *  \param stateDerivativeFunction State derivative function, written generically in the scalar type, with as input the
+ *  independent variable and state entries, and as output the state derivative entries.
+ *  \return Recorded expression.
+ */
+std::shared_ptr< TaylorSeriesExpression > createTaylorSeriesExpression(
+        const int numberOfStateEntries,
+        const std::function< std::vector< TaylorSeriesVariable >(
+            const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& ) >& stateDerivativeFunction );
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDAT_TAYLOR_SERIES_EXPRESSION_H
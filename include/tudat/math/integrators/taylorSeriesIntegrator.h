@@ -0,0 +1,539 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Jorba, A. and Zou, M., A software package for the numerical integration of ODEs by means of high-order Taylor
+ *          methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *
+ */
+
+#ifndef TUDAT_TAYLOR_SERIES_INTEGRATOR_H
+#define TUDAT_TAYLOR_SERIES_INTEGRATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/Core>
+
+#include "tudat/math/integrators/numericalIntegrator.h"
+#include "tudat/math/integrators/taylorSeriesExpression.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Class that implements a variable order, variable step size Taylor series integrator.
+/*!
+ *  Class that implements a variable order, variable step size Taylor series integrator (Jorba and Zou, 2005). The Taylor
+ *  coefficients of the solution through the current state are generated by automatic differentiation of a recorded state
+ *  derivative function (see TaylorSeriesExpression), and the state at the end of a step is obtained by evaluating the
+ *  series. At each step, the order p and the step size h are selected from the error tolerance and the norms of the last
+ *  two coefficients, such that the truncation error of the series is at the level of the tolerance:
+ *
+ *      p = ceil( 1 - 0.5 ln( epsilon ) ),
+ *      h = exp( -0.7 / ( p - 1 ) ) min( ( epsilon / |x_{p-1}| )^( 1 / ( p - 1 ) ), ( epsilon / |x_p| )^( 1 / p ) ),
+ *
+ *  with epsilon the absolute tolerance if the product of relative tolerance and state norm is smaller than it, and the
+ *  relative tolerance otherwise (in which case the coefficient norms are scaled by the state norm). Steps are not rejected,
+ *  so that each step requires a single computation of the Taylor coefficients.
+ *
+ *  The state derivative function that is passed to the constructor is not used to integrate the state, but is evaluated
+ *  once at the end of each step, so that any models that are updated through it (e.g. the environment during a
+ *  propagation) are consistent with the current state. It must therefore be equivalent to the recorded expression, which
+ *  is checked at the initial state when the integrator is created.
+ *  \tparam IndependentVariableType The type of the independent variable.
+ *  \tparam StateType The type of the state, which must be an Eigen column vector of doubles.
+ *  \tparam StateDerivativeType The type of the state derivative.
+ *  \tparam TimeStepType The type of the time step.
+ *  \sa NumericalIntegrator.
+ */
+template< typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+          typename StateDerivativeType = Eigen::VectorXd, typename TimeStepType = IndependentVariableType >
+class TaylorSeriesIntegrator :
+        public NumericalIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+{
+public:
+
+    //! Typedef for the base class.
+    typedef NumericalIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType > NumericalIntegratorBase;
+
+    //! Typedef for the state derivative function.
+    typedef typename NumericalIntegratorBase::StateDerivativeFunction StateDerivativeFunction;
+
+    //! Constructor.
+    /*!
+     *  Constructor, checks that the recorded expression is consistent with the state derivative function at the initial
+     *  state (see checkExpressionConsistency), and computes the Taylor coefficients through the initial state.
+     *  \param stateDerivativeFunction State derivative function, evaluated once at the end of each step (see class
+     *  description).
+     *  \param taylorSeriesExpression Recorded state derivative function, from which the Taylor coefficients are generated.
+     *  \param intervalStart The start of the integration interval.
+     *  \param initialState The initial state.
+     *  \param initialStepSize The initial step size, of which the sign defines the direction of integration.
+     *  \param minimumStepSize The minimum step size (absolute value). An exception is thrown if the selected step size is
+     *  smaller.
+     *  \param maximumStepSize The maximum step size (absolute value).
+     *  \param relativeErrorTolerance The relative error tolerance.
+     *  \param absoluteErrorTolerance The absolute error tolerance.
+     *  \param minimumOrder The minimum order of the series.
+     *  \param maximumOrder The maximum order of the series.
+     */
+    TaylorSeriesIntegrator( const StateDerivativeFunction& stateDerivativeFunction,
+                            const std::shared_ptr< TaylorSeriesExpression > taylorSeriesExpression,
+                            const IndependentVariableType intervalStart,
+                            const StateType& initialState,
+                            const TimeStepType initialStepSize,
+                            const TimeStepType minimumStepSize,
+                            const TimeStepType maximumStepSize,
+                            const double relativeErrorTolerance,
+                            const double absoluteErrorTolerance,
+                            const int minimumOrder = 2,
+                            const int maximumOrder = 30 ):
+        NumericalIntegratorBase( stateDerivativeFunction ),
+        taylorSeriesExpression_( taylorSeriesExpression ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
+        minimumStepSize_( std::fabs( static_cast< double >( minimumStepSize ) ) ),
+        maximumStepSize_( std::fabs( static_cast< double >( maximumStepSize ) ) ),
+        relativeErrorTolerance_( relativeErrorTolerance ),
+        absoluteErrorTolerance_( absoluteErrorTolerance ),
+        minimumOrder_( minimumOrder ),
+        maximumOrder_( maximumOrder ),
+        integrationDirection_( ( static_cast< double >( initialStepSize ) < 0.0 ) ? -1.0 : 1.0 ),
+        currentOrder_( 0 ),
+        lastOrder_( 0 ),
+        stepSize_( initialStepSize ),
+        lastStepSize_( initialStepSize ),
+        useStepSizeControl_( true ),
+        isRollbackAvailable_( false )
+    {
+        if( taylorSeriesExpression_ == nullptr )
+        {
+            throw std::runtime_error( "Error when creating Taylor series integrator, no expression provided" );
+        }
+        else if( currentState_.cols( ) != 1 ||
+                 currentState_.rows( ) != taylorSeriesExpression_->getNumberOfStateEntries( ) )
+        {
+            throw std::runtime_error( "Error when creating Taylor series integrator, state size (" +
+                                      std::to_string( currentState_.rows( ) ) + "x" +
+                                      std::to_string( currentState_.cols( ) ) + ") is inconsistent with expression (" +
+                                      std::to_string( taylorSeriesExpression_->getNumberOfStateEntries( ) ) + "x1)" );
+        }
+        else if( minimumOrder_ < 2 || maximumOrder_ < minimumOrder_ )
+        {
+            throw std::runtime_error( "Error when creating Taylor series integrator, orders (" + std::to_string( minimumOrder_ ) +
+                                      ", " + std::to_string( maximumOrder_ ) + ") are inconsistent" );
+        }
+        else if( !( relativeErrorTolerance_ > 0.0 ) || !( absoluteErrorTolerance_ > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating Taylor series integrator, tolerances must be positive" );
+        }
+        else if( minimumStepSize_ > maximumStepSize_ )
+        {
+            throw std::runtime_error( "Error when creating Taylor series integrator, minimum step size is larger than maximum" );
+        }
+
+        checkExpressionConsistency( );
+        computeTaylorCoefficientsAndStepSize( );
+    }
+
+    //! Get step size of the next step.
+    /*!
+     *  Returns the step size of the next step, as selected from the Taylor coefficients through the current state.
+     *  \return Step size to be used for the next step.
+     */
+    TimeStepType getNextStepSize( ) const
+    {
+        return stepSize_;
+    }
+
+    //! Get current state.
+    StateType getCurrentState( ) const
+    {
+        return currentState_;
+    }
+
+    //! Returns the current independent variable.
+    IndependentVariableType getCurrentIndependentVariable( ) const
+    {
+        return currentIndependentVariable_;
+    }
+
+    //! Returns the previous independent variable.
+    IndependentVariableType getPreviousIndependentVariable( )
+    {
+        return lastIndependentVariable_;
+    }
+
+    //! Returns the previous state.
+    StateType getPreviousState( )
+    {
+        return lastState_;
+    }
+
+    //! Returns the order of the series used for the next step.
+    int getCurrentOrder( ) const
+    {
+        return currentOrder_;
+    }
+
+    //! Returns the Taylor coefficients through the current state, with one column for each order.
+    const Eigen::MatrixXd& getCurrentTaylorCoefficients( ) const
+    {
+        return currentCoefficients_;
+    }
+
+    //! Perform a single integration step.
+    /*!
+     *  Perform a single integration step, by evaluating the Taylor series through the current state. If step-size control
+     *  is used, the step size is limited to the one selected from the Taylor coefficients (as returned by
+     *  getNextStepSize), so that a larger requested step results in a shorter step.
+     *  \param stepSize The requested step size.
+     *  \return The state at the end of the interval.
+     */
+    StateType performIntegrationStep( const TimeStepType stepSize )
+    {
+        TimeStepType usedStepSize = stepSize;
+        if( useStepSizeControl_ && std::fabs( static_cast< double >( stepSize ) ) >
+                std::fabs( static_cast< double >( stepSize_ ) ) )
+        {
+            usedStepSize = stepSize_;
+        }
+
+        // Store current step for rollback and interpolation
+        lastIndependentVariable_ = currentIndependentVariable_;
+        lastState_ = currentState_;
+        lastOrder_ = currentOrder_;
+        lastStepSize_ = usedStepSize;
+        lastCoefficients_.swap( currentCoefficients_ );
+        isRollbackAvailable_ = true;
+
+        currentState_ = evaluateTaylorSeries( lastCoefficients_, lastOrder_, static_cast< double >( usedStepSize ) );
+        currentIndependentVariable_ = lastIndependentVariable_ + usedStepSize;
+
+        computeTaylorCoefficientsAndStepSize( );
+
+        // Evaluate state derivative function to update models depending on the current state.
+        this->stateDerivativeFunction_( currentIndependentVariable_, currentState_ );
+
+        return currentState_;
+    }
+
+    //! Rollback internal state to the last state.
+    /*!
+     *  Performs rollback of the internal state to the last state. This function can only be called once after calling
+     *  integrateTo( ) or performIntegrationStep( ) unless specified otherwise by implementations, and can not be called
+     *  before any of these functions have been called.
+     *  \return True if rollback was successful.
+     */
+    bool rollbackToPreviousState( )
+    {
+        if( !isRollbackAvailable_ )
+        {
+            return false;
+        }
+
+        currentIndependentVariable_ = lastIndependentVariable_;
+        currentState_ = lastState_;
+        currentOrder_ = lastOrder_;
+        currentCoefficients_.swap( lastCoefficients_ );
+        isRollbackAvailable_ = false;
+        computeStepSize( );
+
+        // Evaluate state derivative function to update models depending on the current state.
+        this->stateDerivativeFunction_( currentIndependentVariable_, currentState_ );
+        return true;
+    }
+
+    //! Function to toggle the use of step-size control.
+    /*!
+     *  Function to toggle the use of step-size control, which limits the requested step size to the one selected from the
+     *  Taylor coefficients.
+     *  \param useStepSizeControl Boolean denoting whether step size control is to be used.
+     */
+    void setStepSizeControl( const bool useStepSizeControl )
+    {
+        useStepSizeControl_ = useStepSizeControl;
+    }
+
+    //! Replace the state with a new value.
+    /*!
+     *  Replace the state with a new value, and recompute the Taylor coefficients through it.
+     *  \param newState The value of the new state.
+     *  \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentState( const StateType& newState, const bool allowRollback = false )
+    {
+        currentState_ = newState;
+        computeTaylorCoefficientsAndStepSize( );
+        if( !allowRollback )
+        {
+            isRollbackAvailable_ = false;
+        }
+    }
+
+    //! Modify the state and time for the current step.
+    /*!
+     *  Modify the state and time for the current step, and recompute the Taylor coefficients through them.
+     *  \param newState The new state to set the current state to.
+     *  \param newTime The time to set the current time to.
+     *  \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentIntegrationVariables( const StateType& newState, const IndependentVariableType newTime,
+                                            const bool allowRollback = false )
+    {
+        currentIndependentVariable_ = newTime;
+        modifyCurrentState( newState, allowRollback );
+    }
+
+    //! Function to retrieve the state at an independent variable in the last integration step.
+    /*!
+     *  Function to retrieve the state at an independent variable in the last integration step, by evaluating the Taylor
+     *  series through the state at the start of the step, so that the interpolation error is at the level of the
+     *  integration error.
+     *  \param independentVariable Independent variable at which the state is to be computed, which must lie in the last
+     *  integration step.
+     *  \return Interpolated state.
+     */
+    StateType getInterpolatedState( const IndependentVariableType independentVariable ) const
+    {
+        if( !isRollbackAvailable_ ||
+                static_cast< double >( independentVariable - lastIndependentVariable_ ) *
+                static_cast< double >( independentVariable - currentIndependentVariable_ ) > 0.0 )
+        {
+            throw std::runtime_error( "Error when interpolating Taylor series integrator state, requested independent "
+                                      "variable is outside of the last integration step" );
+        }
+        return evaluateTaylorSeries( lastCoefficients_, lastOrder_,
+                                     static_cast< double >( independentVariable - lastIndependentVariable_ ) );
+    }
+
+private:
+
+    //! Function to evaluate a Taylor series, up to a given order, using Horner's scheme.
+    StateType evaluateTaylorSeries( const Eigen::MatrixXd& coefficients, const int order, const double stepSize ) const
+    {
+        Eigen::VectorXd state = coefficients.col( order );
+        for( int k = order - 1; k >= 0; k-- )
+        {
+            state = state * stepSize + coefficients.col( k );
+        }
+        return StateType( state );
+    }
+
+    //! Function to check that the recorded expression is equivalent to the state derivative function, at the initial state.
+    /*!
+     *  Function to check that the recorded expression is equivalent to the state derivative function, by evaluating both at
+     *  the initial state. The state derivatives are compared per three consecutive entries (i.e. per velocity or
+     *  acceleration vector for a Cartesian state), relative to the norm of these entries, so that small components of a
+     *  vector do not lead to spurious differences. An exception is thrown if the difference exceeds
+     *  1E-12, which indicates that the expression does not describe the integrated dynamics.
+     */
+    void checkExpressionConsistency( )
+    {
+        const double consistencyTolerance = 1.0E-12;
+        const Eigen::VectorXd expressionStateDerivative = taylorSeriesExpression_->computeStateDerivative(
+                    static_cast< double >( currentIndependentVariable_ ), Eigen::VectorXd( currentState_ ) );
+        const Eigen::VectorXd stateDerivative = Eigen::VectorXd(
+                    this->stateDerivativeFunction_( currentIndependentVariable_, currentState_ ) );
+        if( stateDerivative.rows( ) != expressionStateDerivative.rows( ) )
+        {
+            throw std::runtime_error( "Error when creating Taylor series integrator, size of state derivative (" +
+                                      std::to_string( stateDerivative.rows( ) ) + ") is inconsistent with expression (" +
+                                      std::to_string( expressionStateDerivative.rows( ) ) + ")" );
+        }
+
+        for( int i = 0; i < stateDerivative.rows( ); i += 3 )
+        {
+            const int numberOfEntries = std::min( 3, static_cast< int >( stateDerivative.rows( ) ) - i );
+            const double difference =
+                    ( stateDerivative.segment( i, numberOfEntries ) -
+                      expressionStateDerivative.segment( i, numberOfEntries ) ).norm( );
+            const double scale = std::max( stateDerivative.segment( i, numberOfEntries ).norm( ),
+                                           expressionStateDerivative.segment( i, numberOfEntries ).norm( ) );
+            if( !( difference <= consistencyTolerance * scale ) )
+            {
+                throw std::runtime_error(
+                            "Error when creating Taylor series integrator, recorded expression is inconsistent with the state "
+                            "derivative function for entries " + std::to_string( i ) + " to " +
+                            std::to_string( i + numberOfEntries - 1 ) + " (relative difference " +
+                            std::to_string( difference / scale ) + "); the expression must describe the same dynamics "
+                            "as the integrated state derivative" );
+            }
+        }
+    }
+
+    //! Function to select the order and compute the Taylor coefficients and step size through the current state.
+    void computeTaylorCoefficientsAndStepSize( )
+    {
+        const double stateNorm = currentState_.cwiseAbs( ).maxCoeff( );
+        const double tolerance = ( relativeErrorTolerance_ * stateNorm <= absoluteErrorTolerance_ ) ?
+                    absoluteErrorTolerance_ : relativeErrorTolerance_;
+        currentOrder_ = std::min( std::max( static_cast< int >( std::ceil( 1.0 - 0.5 * std::log( tolerance ) ) ),
+                                            minimumOrder_ ), maximumOrder_ );
+
+        taylorSeriesExpression_->computeTaylorCoefficients(
+                    static_cast< double >( currentIndependentVariable_ ), Eigen::VectorXd( currentState_ ),
+                    currentOrder_, currentCoefficients_ );
+        computeStepSize( );
+    }
+
+    //! Function to compute the step size from the Taylor coefficients through the current state.
+    void computeStepSize( )
+    {
+        const double stateNorm = currentState_.cwiseAbs( ).maxCoeff( );
+        double tolerance = absoluteErrorTolerance_;
+        double scale = 1.0;
+        if( relativeErrorTolerance_ * stateNorm > absoluteErrorTolerance_ )
+        {
+            tolerance = relativeErrorTolerance_;
+            scale = stateNorm;
+        }
+
+        // Radius of convergence estimate from the last two coefficients
+        double stepSize = std::numeric_limits< double >::infinity( );
+        for( int k = currentOrder_ - 1; k <= currentOrder_; k++ )
+        {
+            const double coefficientNorm = currentCoefficients_.col( k ).cwiseAbs( ).maxCoeff( ) / scale;
+            if( coefficientNorm > 0.0 )
+            {
+                stepSize = std::min( stepSize, std::pow( tolerance / coefficientNorm, 1.0 / static_cast< double >( k ) ) );
+            }
+        }
+        stepSize *= std::exp( -0.7 / static_cast< double >( currentOrder_ - 1 ) );
+
+        if( stepSize < minimumStepSize_ )
+        {
+            throw std::runtime_error( "Error in Taylor series integrator, step size " + std::to_string( stepSize ) +
+                                      " is smaller than minimum step size " + std::to_string( minimumStepSize_ ) +
+                                      " at t = " + std::to_string( static_cast< double >( currentIndependentVariable_ ) ) );
+        }
+        stepSize_ = static_cast< TimeStepType >( integrationDirection_ * std::min( stepSize, maximumStepSize_ ) );
+    }
+
+    //! Recorded state derivative function, from which the Taylor coefficients are generated.
+    std::shared_ptr< TaylorSeriesExpression > taylorSeriesExpression_;
+
+    //! Current independent variable.
+    IndependentVariableType currentIndependentVariable_;
+
+    //! Current state.
+    StateType currentState_;
+
+    //! Independent variable at the start of the last step.
+    IndependentVariableType lastIndependentVariable_;
+
+    //! State at the start of the last step.
+    StateType lastState_;
+
+    //! Minimum step size (absolute value).
+    double minimumStepSize_;
+
+    //! Maximum step size (absolute value).
+    double maximumStepSize_;
+
+    //! Relative error tolerance.
+    double relativeErrorTolerance_;
+
+    //! Absolute error tolerance.
+    double absoluteErrorTolerance_;
+
+    //! Minimum order of the series.
+    int minimumOrder_;
+
+    //! Maximum order of the series.
+    int maximumOrder_;
+
+    //! Direction of integration (1 or -1).
+    double integrationDirection_;
+
+    //! Order of the series through the current state.
+    int currentOrder_;
+
+    //! Order of the series through the state at the start of the last step.
+    int lastOrder_;
+
+    //! Step size selected from the Taylor coefficients through the current state.
+    TimeStepType stepSize_;
+
+    //! Step size of the last step.
+    TimeStepType lastStepSize_;
+
+    //! Taylor coefficients through the current state, with one column for each order.
+    Eigen::MatrixXd currentCoefficients_;
+
+    //! Taylor coefficients through the state at the start of the last step, with one column for each order.
+    Eigen::MatrixXd lastCoefficients_;
+
+    //! Boolean denoting whether step-size control is used.
+    bool useStepSizeControl_;
+
+    //! Boolean denoting whether the last step can be rolled back (and the state in it interpolated).
+    bool isRollbackAvailable_;
+};
+
+//! Class to create a Taylor series integrator, for the supported independent variable and state types.
+/*!
+ *  Class to create a Taylor series integrator, for the supported independent variable and state types. The general
+ *  implementation throws an exception, the supported combinations (double independent variable and column vector of
+ *  doubles) are implemented by specializations.
+ */
+template< typename IndependentVariableType, typename StateType, typename TimeStepType >
+struct TaylorSeriesIntegratorCreator
+{
+    template< typename... ArgumentTypes >
+    static std::shared_ptr< NumericalIntegrator< IndependentVariableType, StateType, StateType, TimeStepType > >
+    createIntegrator( const ArgumentTypes&... )
+    {
+        throw std::runtime_error( "Error, Taylor series integrator is only supported for double independent variable and "
+                                  "state entries" );
+    }
+};
+
+//! Class to create a Taylor series integrator, for double independent variable and an Eigen matrix of doubles as state.
+template< int Rows, int Columns, int Options, int MaximumRows, int MaximumColumns >
+struct TaylorSeriesIntegratorCreator< double, Eigen::Matrix< double, Rows, Columns, Options, MaximumRows, MaximumColumns >,
+        double >
+{
+    typedef Eigen::Matrix< double, Rows, Columns, Options, MaximumRows, MaximumColumns > StateType;
+
+    static std::shared_ptr< NumericalIntegrator< double, StateType, StateType, double > > createIntegrator(
+            const std::function< StateType( const double, const StateType& ) >& stateDerivativeFunction,
+            const std::shared_ptr< TaylorSeriesExpression > taylorSeriesExpression,
+            const double intervalStart, const StateType& initialState,
+            const double initialStepSize, const double minimumStepSize, const double maximumStepSize,
+            const double relativeErrorTolerance, const double absoluteErrorTolerance,
+            const int minimumOrder, const int maximumOrder )
+    {
+        return std::make_shared< TaylorSeriesIntegrator< double, StateType, StateType, double > >(
+                    stateDerivativeFunction, taylorSeriesExpression, intervalStart, initialState,
+                    initialStepSize, minimumStepSize, maximumStepSize, relativeErrorTolerance, absoluteErrorTolerance,
+                    minimumOrder, maximumOrder );
+    }
+};
+
+//! Typedef of Taylor series integrator (state/state derivative = VectorXd, independent variable = double).
+typedef TaylorSeriesIntegrator< > TaylorSeriesIntegratorXd;
+
+//! Typedef of a shared-pointer to a Taylor series integrator with VectorXd state and double independent variable.
+typedef std::shared_ptr< TaylorSeriesIntegratorXd > TaylorSeriesIntegratorXdPointer;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDAT_TAYLOR_SERIES_INTEGRATOR_H
@@ -333,6 +333,17 @@ public:
 
     InterpolatorTypes getInterpolatorType( ){ return cubic_spline_interpolator; }
 
+    //! Function to return the second derivatives of the curve at the nodes.
+    /*!
+     *  Function to return the second derivatives of the curve at the nodes, which define the spline together with the
+     *  independent and dependent values.
+     *  \return Second derivatives of the curve at the nodes.
+     */
+    std::vector< DependentVariableType > getSecondDerivativeOfCurve( )
+    {
+        return secondDerivativeOfCurve_;
+    }
+
 protected:
 
 private:
@@ -140,9 +140,6 @@ public:
         // interpolation call.
         initializeDenominators( );
         initializeBoundaryInterpolators( selectedLookupScheme );
-
-        // Pre-allocate cache vector for computational efficiency.
-        independentVariableDifferenceCache.resize( 2 * offsetEntries_ + 2 );
     }
 
     //! Constructor from map of independent/dependent data.
@@ -222,7 +219,6 @@ public:
         initializeDenominators( );
         initializeBoundaryInterpolators( selectedLookupScheme );
 
-        independentVariableDifferenceCache.resize( 2 * offsetEntries_ + 2 );
     }
 
     //! Destructor.
@@ -290,6 +286,14 @@ public:
             }
             else
             {
+                // Cache of differences w.r.t. interpolation nodes; thread-local, so that the interpolator may be
+                // evaluated concurrently from multiple threads.
+                static thread_local std::vector< ScalarType > independentVariableDifferenceCache;
+                if( static_cast< int >( independentVariableDifferenceCache.size( ) ) < 2 * offsetEntries_ + 2 )
+                {
+                    independentVariableDifferenceCache.resize( 2 * offsetEntries_ + 2 );
+                }
+
                 // Set up repeated numerator and cache of independent variable values from which
                 // interpolant is created.
                 int j = 0;
@@ -501,8 +505,6 @@ private:
      */
     int offsetEntries_;
 
-    std::vector< ScalarType > independentVariableDifferenceCache;
-
     //! Interpolator to be used at beginning of domain.
     std::shared_ptr< OneDimensionalInterpolator
     < IndependentVariableType, DependentVariableType > > beginInterpolator_;
@@ -12,6 +12,7 @@
 #ifndef TUDAT_LOOK_UP_SCHEME_H
 #define TUDAT_LOOK_UP_SCHEME_H
 
+#include <atomic>
 #include <vector>
 #include <iostream>
 #include <memory>
@@ -137,20 +138,22 @@ public:
         int newNearestLowerIndex = 0;
 
         // If this is first call of function, use binary search.
-        if ( !isFirstLookupDone )
+        if ( !isFirstLookupDone.load( std::memory_order_relaxed ) )
         {
             newNearestLowerIndex = basic_mathematics::computeNearestLeftNeighborUsingBinarySearch
                     < IndependentVariableType >( independentVariableValues_, valueToLookup );
-            isFirstLookupDone = 1;
+            isFirstLookupDone.store( true, std::memory_order_relaxed );
         }
 
         else
         {
+            int previousNearestLowerIndex = previousNearestLowerIndex_.load( std::memory_order_relaxed );
+
             // If requested value is in same interval, return same value as previous time.
             if ( basic_mathematics::isIndependentVariableInInterval< IndependentVariableType >
-                 ( previousNearestLowerIndex_, valueToLookup, independentVariableValues_ ) )
+                 ( previousNearestLowerIndex, valueToLookup, independentVariableValues_ ) )
             {
-                newNearestLowerIndex = previousNearestLowerIndex_;
+                newNearestLowerIndex = previousNearestLowerIndex;
 
             }
 
@@ -160,13 +163,13 @@ public:
                 newNearestLowerIndex =
                         basic_mathematics::findNearestLeftNeighbourUsingHuntingAlgorithm<
                         IndependentVariableType >
-                        (  valueToLookup, previousNearestLowerIndex_, independentVariableValues_ );
+                        (  valueToLookup, previousNearestLowerIndex, independentVariableValues_ );
 
             }
         }
 
         // Set calculated value for use in next call.
-        previousNearestLowerIndex_ = newNearestLowerIndex;
+        previousNearestLowerIndex_.store( newNearestLowerIndex, std::memory_order_relaxed );
 
         return newNearestLowerIndex;
     }
@@ -175,15 +178,17 @@ private:
 
     //! Boolean to denote whether a lookup has been done.
     /*!
-     * Boolean to denote whether a lookup has been done.
+     * Boolean to denote whether a lookup has been done. Stored as atomic, so that the lookup scheme may be used
+     * concurrently from multiple threads (the value is only used as an initial guess, so that it need not be synchronized
+     * with other lookups).
      */
-    bool isFirstLookupDone;
+    std::atomic< bool > isFirstLookupDone;
 
     //! Nearest left index during previous call.
     /*!
-     * Nearest left index during previous call
+     * Nearest left index during previous call (atomic, see isFirstLookupDone)
      */
-    int previousNearestLowerIndex_;
+    std::atomic< int > previousNearestLowerIndex_;
 };
 
 //! Look-up scheme class for nearest left neighbour search using binary search algorithm.
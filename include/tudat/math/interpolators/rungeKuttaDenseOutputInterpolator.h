@@ -0,0 +1,167 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_RUNGE_KUTTA_DENSE_OUTPUT_INTERPOLATOR_H
+#define TUDAT_RUNGE_KUTTA_DENSE_OUTPUT_INTERPOLATOR_H
+
+#include <algorithm>
+#include <memory>
+
+#include "tudat/math/integrators/rungeKuttaDenseOutput.h"
+#include "tudat/math/interpolators/oneDimensionalInterpolator.h"
+
+namespace tudat
+{
+
+namespace interpolators
+{
+
+//! Interpolator that directly evaluates (a block of) the dense output of a Runge-Kutta integrator.
+/*!
+ * Interpolator that directly evaluates (a block of) the dense output of a Runge-Kutta integrator, for instance the
+ * translational state of a single body out of the full propagated state. No interpolation of the discrete integrator output
+ * is performed: the continuous extension of the integration step in which the independent variable lies is evaluated. The
+ * independent and dependent values of the interpolator (as returned by getIndependentValues/getDependentValues, and as
+ * used for boundary handling) are the step boundaries of the integration, and the state at these boundaries.
+ * \tparam IndependentVariableType Type of independent variable.
+ * \tparam DependentVariableType Type of dependent variable (block of the state). For dynamically sized types, the size of
+ * the block must be provided to the constructor.
+ * \tparam StateType Type of the full state of the dense output.
+ * \tparam TimeStepType Type of the step size of the dense output.
+ */
+template< typename IndependentVariableType, typename DependentVariableType,
+          typename StateType = Eigen::VectorXd, typename TimeStepType = IndependentVariableType >
+class RungeKuttaDenseOutputInterpolator : public OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >
+{
+public:
+
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::dependentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::independentValues_;
+    using Interpolator< IndependentVariableType, DependentVariableType >::interpolate;
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param denseOutput Dense output of the Runge-Kutta integrator, containing at least one step.
+     * \param startRow Index of the first row of the block of the state that is to be evaluated.
+     * \param startColumn Index of the first column of the block of the state that is to be evaluated.
+     * \param blockRows Number of rows of the block of the state (only used for dynamically sized DependentVariableType).
+     * \param blockColumns Number of columns of the block of the state (only used for dynamically sized
+     * DependentVariableType).
+     * \param boundaryHandling Boundary handling method, in case the independent variable is outside the integrated
+     * interval (by default, the continuous extension of the first/last step is extrapolated).
+     * \param defaultExtrapolationValue Pair of default values to be used for extrapolation, in case of use_default_value or
+     * use_default_value_with_warning as methods for boundaryHandling.
+     */
+    RungeKuttaDenseOutputInterpolator(
+            const std::shared_ptr< numerical_integrators::RungeKuttaDenseOutput<
+            IndependentVariableType, StateType, TimeStepType > > denseOutput,
+            const int startRow = 0,
+            const int startColumn = 0,
+            const int blockRows = DependentVariableType::RowsAtCompileTime,
+            const int blockColumns = DependentVariableType::ColsAtCompileTime,
+            const BoundaryInterpolationType boundaryHandling = extrapolate_at_boundary,
+            const std::pair< DependentVariableType, DependentVariableType >& defaultExtrapolationValue =
+            std::make_pair( IdentityElement::getAdditionIdentity< DependentVariableType >( ),
+                            IdentityElement::getAdditionIdentity< DependentVariableType >( ) ) ):
+        OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >(
+            boundaryHandling, defaultExtrapolationValue ),
+        denseOutput_( denseOutput ), startRow_( startRow ), startColumn_( startColumn ),
+        blockRows_( blockRows ), blockColumns_( blockColumns )
+    {
+        if( denseOutput_ == nullptr || denseOutput_->getNumberOfSteps( ) == 0 )
+        {
+            throw std::runtime_error( "Error when creating Runge-Kutta dense output interpolator, no dense output provided" );
+        }
+        if( blockRows_ < 0 || blockColumns_ < 0 )
+        {
+            throw std::runtime_error(
+                        "Error when creating Runge-Kutta dense output interpolator, size of dynamic block not provided" );
+        }
+
+        // Set step boundaries (in ascending order) as independent values
+        independentValues_ = denseOutput_->getStepBoundaries( );
+        if( independentValues_.front( ) > independentValues_.back( ) )
+        {
+            std::reverse( independentValues_.begin( ), independentValues_.end( ) );
+        }
+        for( unsigned int i = 0; i < independentValues_.size( ); i++ )
+        {
+            dependentValues_.push_back( interpolateWithoutBoundaryHandling( independentValues_.at( i ) ) );
+        }
+        this->makeLookupScheme( huntingAlgorithm );
+    }
+
+    //! Destructor
+    ~RungeKuttaDenseOutputInterpolator( ){ }
+
+    //! Function to evaluate the dense output at the given independent variable value.
+    /*!
+     * Function to evaluate the dense output at the given independent variable value.
+     * \param targetIndependentVariableValue Value of independent variable at which the state is to be evaluated.
+     * \return Block of the state at the requested independent variable
+     */
+    DependentVariableType interpolate( const IndependentVariableType targetIndependentVariableValue )
+    {
+        // Check whether boundary handling needs to be applied, if independent variable is beyond its defined range.
+        DependentVariableType targetValue;
+        bool useValue = false;
+        this->checkBoundaryCase( targetValue, useValue, targetIndependentVariableValue );
+        if( useValue )
+        {
+            return targetValue;
+        }
+
+        return interpolateWithoutBoundaryHandling( targetIndependentVariableValue );
+    }
+
+    //! Function to retrieve the dense output that is evaluated.
+    std::shared_ptr< numerical_integrators::RungeKuttaDenseOutput< IndependentVariableType, StateType, TimeStepType > >
+    getDenseOutput( )
+    {
+        return denseOutput_;
+    }
+
+    InterpolatorTypes getInterpolatorType( ){ return runge_kutta_dense_output_interpolator; }
+
+private:
+
+    //! Function to evaluate the dense output, without checking the boundaries of the integrated interval.
+    DependentVariableType interpolateWithoutBoundaryHandling( const IndependentVariableType targetIndependentVariableValue )
+    {
+        DependentVariableType targetValue;
+        targetValue.resize( blockRows_, blockColumns_ );
+        denseOutput_->getStateBlock( targetIndependentVariableValue, startRow_, startColumn_, targetValue );
+        return targetValue;
+    }
+
+    //! Dense output of the Runge-Kutta integrator.
+    std::shared_ptr< numerical_integrators::RungeKuttaDenseOutput< IndependentVariableType, StateType, TimeStepType > >
+    denseOutput_;
+
+    //! Index of the first row of the block of the state that is evaluated.
+    int startRow_;
+
+    //! Index of the first column of the block of the state that is evaluated.
+    int startColumn_;
+
+    //! Number of rows of the block of the state that is evaluated.
+    int blockRows_;
+
+    //! Number of columns of the block of the state that is evaluated.
+    int blockColumns_;
+};
+
+} // namespace interpolators
+
+} // namespace tudat
+
+#endif // TUDAT_RUNGE_KUTTA_DENSE_OUTPUT_INTERPOLATOR_H
@@ -509,7 +509,8 @@ public:
      *  https://celestrak.com/SpaceData/sw19571001.txt
      */
     NRLMSISE00AtmosphereSettings( const std::string& spaceWeatherFile ):
-        AtmosphereSettings( nrlmsise00 ), spaceWeatherFile_( spaceWeatherFile ){ }
+        AtmosphereSettings( nrlmsise00 ), spaceWeatherFile_( spaceWeatherFile ),
+        densityInterpolationTolerance_( TUDAT_NAN ){ }
 
     //  Function to return file containing space weather data.
     /* 
@@ -518,6 +519,16 @@ public:
      */
     std::string getSpaceWeatherFile( ){ return spaceWeatherFile_; }
 
+    //  Function to set the density to be computed by interpolation on an adaptive local grid (see
+    //  NRLMSISE00Atmosphere::setDensityInterpolation), with given relative tolerance (NaN to use full model).
+    void setDensityInterpolation( const double relativeTolerance )
+    {
+        densityInterpolationTolerance_ = relativeTolerance;
+    }
+
+    //  Function to return the relative tolerance of the interpolated density (NaN if full model is used).
+    double getDensityInterpolationTolerance( ){ return densityInterpolationTolerance_; }
+
 private:
 
     //  File containing space weather data.
@@ -525,6 +536,9 @@ private:
      *  File containing space weather data, as in https://celestrak.com/SpaceData/sw19571001.txt
      */
     std::string spaceWeatherFile_;
+
+    //  Relative tolerance of the interpolated density (NaN if full model is used).
+    double densityInterpolationTolerance_;
 };
 
 
@@ -182,7 +182,8 @@ public:
         verticesCoordinates_( verticesCoordinates ),
         verticesDefiningEachFacet_( verticesDefiningEachFacet ),
         computeAltitudeWithSign_( computeAltitudeWithSign ),
-        justComputeDistanceToVertices_( justComputeDistanceToVertices )
+        justComputeDistanceToVertices_( justComputeDistanceToVertices ),
+        useFacetTree_( false )
     { }
 
     //! Destructor
@@ -220,6 +221,14 @@ public:
     void resetJustComputeDistanceToVertices( bool justComputeDistanceToVertices )
     { justComputeDistanceToVertices_ = justComputeDistanceToVertices; }
 
+    // Function to return the useFacetTree flag.
+    bool getUseFacetTree( )
+    { return useFacetTree_; }
+
+    // Function to reset the useFacetTree flag.
+    void resetUseFacetTree( bool useFacetTree )
+    { useFacetTree_ = useFacetTree; }
+
 private:
 
     // Matrix with coordinates of the polyhedron vertices.
@@ -236,6 +245,10 @@ private:
     // vertices.
     bool justComputeDistanceToVertices_;
 
+    // Flag indicating whether the altitude should be computed using a bounding volume hierarchy of the facets (see
+    // PolyhedronFacetTree), i.e. with a nearest-feature search that is logarithmic in the number of facets.
+    bool useFacetTree_;
+
 };
 
 //  BodyShapeSettings derived class for defining settings of a hybrid shape model.
@@ -343,10 +356,13 @@ inline std::shared_ptr< BodyShapeSettings > polyhedronBodyShapeSettings(
         const Eigen::MatrixXd& verticesCoordinates,
         const Eigen::MatrixXi& verticesDefiningEachFacet,
         const bool computeAltitudeWithSign = true,
-        const bool justComputeDistanceToVertices = false )
+        const bool justComputeDistanceToVertices = false,
+        const bool useFacetTree = false )
 {
-    return std::make_shared< PolyhedronBodyShapeSettings >( verticesCoordinates, verticesDefiningEachFacet,
-                                                            computeAltitudeWithSign, justComputeDistanceToVertices);
+    std::shared_ptr< PolyhedronBodyShapeSettings > shapeSettings = std::make_shared< PolyhedronBodyShapeSettings >(
+                verticesCoordinates, verticesDefiningEachFacet, computeAltitudeWithSign, justComputeDistanceToVertices);
+    shapeSettings->resetUseFacetTree( useFacetTree );
+    return shapeSettings;
 }
 
 inline std::shared_ptr< BodyShapeSettings > hybridBodyShapeSettings(
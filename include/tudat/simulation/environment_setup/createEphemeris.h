@@ -20,6 +20,7 @@
 #include "tudat/astro/basic_astro/orbitalElementConversions.h"
 #include "tudat/astro/ephemerides/ephemeris.h"
 #include "tudat/astro/ephemerides/tabulatedEphemeris.h"
+#include "tudat/astro/ephemerides/chebyshevEphemeris.h"
 #include "tudat/astro/ephemerides/tleEphemeris.h"
 #include "tudat/astro/ephemerides/customEphemeris.h"
 #include "tudat/astro/ephemerides/keplerEphemeris.h"
@@ -55,7 +56,8 @@ enum EphemerisType
     custom_ephemeris,
     direct_tle_ephemeris,
     interpolated_tle_ephemeris,
-    scaled_ephemeris
+    scaled_ephemeris,
+    chebyshev_spice_ephemeris
 };
 
 // Class for providing settings for ephemeris model.
@@ -398,6 +400,80 @@ private:
     std::shared_ptr< interpolators::InterpolatorSettings > interpolatorSettings_;
 };
 
+// EphemerisSettings derived class for defining settings of a piecewise Chebyshev ephemeris pre-computed from Spice data.
+/*
+ *  EphemerisSettings derived class for defining settings of a piecewise Chebyshev ephemeris pre-computed from Spice
+ *  data. Upon creation, the Spice kernels are sampled once over the requested time interval, which is divided into
+ *  segments of equal duration, each of which is represented by a Chebyshev polynomial (see ChebyshevEphemeris). Unlike
+ *  the DirectSpiceEphemerisSettings and InterpolatedSpiceEphemerisSettings, retrieving a state from the resulting
+ *  ephemeris requires no call to Spice, no search for the interval containing the requested time, and no locking, so
+ *  that it may be used concurrently from any number of threads. If a position tolerance is provided, the segment
+ *  duration is reduced until the maximum position difference w.r.t. the Spice kernels (evaluated between the
+ *  interpolation nodes) is below this tolerance.
+ */
+class ChebyshevSpiceEphemerisSettings: public DirectSpiceEphemerisSettings
+{
+public:
+
+    // Constructor.
+    /* Constructor, sets the properties from which the Chebyshev segments are to be created from Spice data.
+     * \param initialTime Initial time from which the Chebyshev ephemeris should be created.
+     * \param finalTime Final time until which the Chebyshev ephemeris should be created.
+     * \param segmentDuration (Maximum) duration of each segment.
+     * \param polynomialDegree Degree of the Chebyshev polynomial in each segment.
+     * \param positionTolerance Maximum allowed position difference w.r.t. Spice data (NaN if no check is to be enforced).
+     * \param frameOrigin Name of body relative to which the ephemeris is to be calculated
+     *        (optional "SSB" by default).
+     * \param frameOrientation Orientatioan of the reference frame in which the epehemeris is to be
+     *          calculated (optional "ECLIPJ2000" by default).
+     * \param bodyNameOverride Name of body in Spice, if different from name of body in simulation (empty by default)
+     */
+    ChebyshevSpiceEphemerisSettings( const double initialTime,
+                                     const double finalTime,
+                                     const double segmentDuration,
+                                     const int polynomialDegree = 12,
+                                     const double positionTolerance = TUDAT_NAN,
+                                     const std::string frameOrigin = "SSB",
+                                     const std::string frameOrientation = "ECLIPJ2000",
+                                     const std::string bodyNameOverride = "" ):
+        DirectSpiceEphemerisSettings( frameOrigin, frameOrientation, bodyNameOverride,
+                                      chebyshev_spice_ephemeris ),
+        initialTime_( initialTime ), finalTime_( finalTime ), segmentDuration_( segmentDuration ),
+        polynomialDegree_( polynomialDegree ), positionTolerance_( positionTolerance ){ }
+
+    // Function to return initial time from which the Chebyshev ephemeris should be created.
+    double getInitialTime( ){ return initialTime_; }
+
+    // Function to return final time until which the Chebyshev ephemeris should be created.
+    double getFinalTime( ){ return finalTime_; }
+
+    // Function to return (maximum) duration of each segment.
+    double getSegmentDuration( ){ return segmentDuration_; }
+
+    // Function to return degree of the Chebyshev polynomial in each segment.
+    int getPolynomialDegree( ){ return polynomialDegree_; }
+
+    // Function to return maximum allowed position difference w.r.t. Spice data.
+    double getPositionTolerance( ){ return positionTolerance_; }
+
+private:
+
+    // Initial time from which the Chebyshev ephemeris should be created.
+    double initialTime_;
+
+    // Final time until which the Chebyshev ephemeris should be created.
+    double finalTime_;
+
+    // (Maximum) duration of each segment.
+    double segmentDuration_;
+
+    // Degree of the Chebyshev polynomial in each segment.
+    int polynomialDegree_;
+
+    // Maximum allowed position difference w.r.t. Spice data (NaN if no check is to be enforced).
+    double positionTolerance_;
+};
+
 // EphemerisSettings derived class for defining settings of an approximate ephemeris for major
 // planets.
 /*
@@ -997,6 +1073,21 @@ inline std::shared_ptr< EphemerisSettings > interpolatedSpiceEphemerisSettings(
             initialTime, finalTime, timeStep, frameOrigin, frameOrientation, interpolatorSettings, bodyNameOverride );
 }
 
+inline std::shared_ptr< EphemerisSettings > chebyshevSpiceEphemerisSettings(
+        const double initialTime,
+        const double finalTime,
+        const double segmentDuration,
+        const int polynomialDegree = 12,
+        const double positionTolerance = TUDAT_NAN,
+        const std::string frameOrigin = "SSB",
+        const std::string frameOrientation = "ECLIPJ2000",
+        const std::string bodyNameOverride = "" )
+{
+    return std::make_shared< ChebyshevSpiceEphemerisSettings >(
+            initialTime, finalTime, segmentDuration, polynomialDegree, positionTolerance,
+            frameOrigin, frameOrientation, bodyNameOverride );
+}
+
 //! @get_docstring(tabulatedEphemerisSettings)
 inline std::shared_ptr< EphemerisSettings > tabulatedEphemerisSettings(
 		const std::map< double, Eigen::Vector6d >& bodyStateHistory,
@@ -1177,6 +1268,39 @@ std::shared_ptr< ephemerides::Ephemeris > createBodyEphemeris(
             }
         }
         break;
+        case chebyshev_spice_ephemeris:
+        {
+            // Check consistency of type and class.
+            std::shared_ptr< ChebyshevSpiceEphemerisSettings > chebyshevEphemerisSettings =
+                    std::dynamic_pointer_cast< ChebyshevSpiceEphemerisSettings >( ephemerisSettings );
+            if( chebyshevEphemerisSettings == nullptr )
+            {
+                throw std::runtime_error(
+                            "Error, expected Chebyshev spice ephemeris settings for body " + bodyName );
+            }
+            else
+            {
+                std::string inputName = ( chebyshevEphemerisSettings->getBodyNameOverride( ) == "" ) ?
+                            bodyName : chebyshevEphemerisSettings->getBodyNameOverride( );
+                std::string frameOrigin = chebyshevEphemerisSettings->getFrameOrigin( );
+                std::string frameOrientation = chebyshevEphemerisSettings->getFrameOrientation( );
+
+                // Create corresponding ephemeris object, sampling Spice only during its creation.
+                ephemeris = std::make_shared< ChebyshevEphemeris >(
+                            [ = ]( const double time )
+                {
+                    return spice_interface::getBodyCartesianStateAtEpoch(
+                                inputName, frameOrigin, frameOrientation, "none", time );
+                },
+                chebyshevEphemerisSettings->getInitialTime( ),
+                chebyshevEphemerisSettings->getFinalTime( ),
+                chebyshevEphemerisSettings->getSegmentDuration( ),
+                chebyshevEphemerisSettings->getPolynomialDegree( ),
+                frameOrigin, frameOrientation,
+                chebyshevEphemerisSettings->getPositionTolerance( ) );
+            }
+        }
+        break;
         case tabulated_ephemeris:
         {
             // Check consistency of type and class.
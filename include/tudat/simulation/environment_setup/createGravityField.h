@@ -315,7 +315,10 @@ public:
         verticesCoordinates_( verticesCoordinates ),
         verticesDefiningEachFacet_( verticesDefiningEachFacet ),
         associatedReferenceFrame_( associatedReferenceFrame ),
-        gravitationalConstant_( gravitationalConstant )
+        gravitationalConstant_( gravitationalConstant ),
+        useFacetTree_( false ),
+        maximumRelativeTruncationError_( 0.0 ),
+        numberOfThreads_( 1 )
     {
         volume_ = basic_astrodynamics::computePolyhedronVolume( verticesCoordinates, verticesDefiningEachFacet );
         gravitationalParameter_ = gravitationalConstant_ * density_ * volume_;
@@ -341,7 +344,10 @@ public:
         verticesCoordinates_( verticesCoordinates ),
         verticesDefiningEachFacet_( verticesDefiningEachFacet ),
         associatedReferenceFrame_( associatedReferenceFrame ),
-        gravitationalConstant_( gravitationalConstant )
+        gravitationalConstant_( gravitationalConstant ),
+        useFacetTree_( false ),
+        maximumRelativeTruncationError_( 0.0 ),
+        numberOfThreads_( 1 )
     {
         volume_ = basic_astrodynamics::computePolyhedronVolume( verticesCoordinates, verticesDefiningEachFacet );
         density_ = gravitationalParameter_ / ( gravitationalConstant_ * volume_ );
@@ -396,6 +402,35 @@ public:
     void resetVerticesDefiningEachFacet ( const Eigen::MatrixXi& verticesDefiningEachFacet )
     { verticesDefiningEachFacet_ = verticesDefiningEachFacet; }
 
+    /*! Function to set the evaluation of the gravity field using a bounding volume hierarchy of the facets.
+     *
+     * Function to set the evaluation of the potential and its gradient using a bounding volume hierarchy of the facets,
+     * in which distant facet clusters are evaluated with a multipole approximation (see PolyhedronFacetTree).
+     * @param maximumRelativeTruncationError Maximum relative truncation error of each approximated facet cluster (if
+     * zero, all facets are evaluated exactly).
+     */
+    void setFacetTreeEvaluation( const double maximumRelativeTruncationError )
+    {
+        useFacetTree_ = true;
+        maximumRelativeTruncationError_ = maximumRelativeTruncationError;
+    }
+
+    //! Function to return whether the gravity field is to be evaluated using a bounding volume hierarchy of the facets.
+    bool getUseFacetTree( )
+    { return useFacetTree_; }
+
+    //! Function to return the maximum relative truncation error of each facet cluster evaluated using the facet tree.
+    double getMaximumRelativeTruncationError( )
+    { return maximumRelativeTruncationError_; }
+
+    //! Function to set the number of threads over which the exact sums over the facets and edges are distributed.
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    { numberOfThreads_ = numberOfThreads; }
+
+    //! Function to return the number of threads over which the exact sums over the facets and edges are distributed.
+    unsigned int getNumberOfThreads( )
+    { return numberOfThreads_; }
+
 protected:
 
     // Gravitational parameter
@@ -417,6 +452,15 @@ protected:
 
     double volume_;
 
+    // Boolean denoting whether the gravity field is to be evaluated using a bounding volume hierarchy of the facets.
+    bool useFacetTree_;
+
+    // Maximum relative truncation error of each facet cluster evaluated using the facet tree.
+    double maximumRelativeTruncationError_;
+
+    // Number of threads over which the exact sums over the facets and edges are distributed (serial if 1).
+    unsigned int numberOfThreads_;
+
 };
 
 // Derived class of GravityFieldSettings defining settings of polyhedron gravity
@@ -15,7 +15,9 @@
 
 
 
+#include "tudat/basics/threadPool.h"
 #include "tudat/io/basicInputOutput.h"
+#include "tudat/math/basic/blockArrowheadNormalEquations.h"
 #include "tudat/math/basic/leastSquaresEstimation.h"
 #include "tudat/astro/observation_models/observationManager.h"
 #include "tudat/astro/orbit_determination/podInputOutputTypes.h"
@@ -89,12 +91,20 @@ void calculateResiduals(
 /*!
  *  This function calculates the observation partials matrix and residuals, based on the state transition matrix,
  *  sensitivity matrix and body states resulting from the previous numerical integration iteration.
- *  Partials and observations are calculated by the observationManagers_.
+ *  Partials and observations are calculated by the observationManagers_. Each single observation set in the observation
+ *  collection is processed as a separate task, and its results are written directly into the preassigned rows of the
+ *  design matrix/residual vector. If a thread pool is provided, these tasks are distributed over the threads of the pool, where
+ *  each thread uses its own set of observation managers (with its own light-time calculators and partial caches), so that the
+ *  results are identical to those of a serial evaluation.
  *  \param observationsAndTimes Observable values and associated time tags, per observable type and set of link ends.
  *  \param parameterVectorSize Length of the vector of estimated parameters
  *  \param totalObservationSize Total number of observations in observationsAndTimes map.
  *  \param residualsAndPartials Pair of residuals of computed w.r.t. input observable values and partials of
  *  observables w.r.t. parameter vector (return by reference).
+ *  \param threadPool Thread pool over which the computation of the observation sets is to be distributed (serial computation
+ *  if nullptr)
+ *  \param perThreadObservationManagers Observation managers for each thread of the thread pool (must be of same size as
+ *  number of threads in pool, if a thread pool is provided).
  */
 template< typename ObservationScalarType = double, typename TimeType = double,
     typename std::enable_if< is_state_scalar_and_time_type< ObservationScalarType, TimeType >::value, int >::type = 0 >
@@ -107,13 +117,25 @@ void calculateDesignMatrixAndResiduals(
     Eigen::MatrixXd& designMatrix,
     Eigen::VectorXd& residuals,
     const bool calculateResiduals = true,
-    const bool calculatePartials = true )
+    const bool calculatePartials = true,
+    const std::shared_ptr< utilities::ThreadPool > threadPool = nullptr,
+    const std::vector< std::map< observation_models::ObservableType,
+        std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > > >&
+    perThreadObservationManagers = std::vector< std::map< observation_models::ObservableType,
+        std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > > >( ) )
 {
     if( calculatePartials && totalNumberParameters <= 0 )
     {
         throw std::runtime_error( "Error when computing observation partials; number of parameters is 0 or smaller: " + std::to_string( totalNumberParameters ) );
     }
 
+    if( threadPool != nullptr && perThreadObservationManagers.size( ) != threadPool->getNumberOfThreads( ) )
+    {
+        throw std::runtime_error( "Error when computing observations and partials in parallel; number of observation manager sets (" +
+                                  std::to_string( perThreadObservationManagers.size( ) ) + ") is not equal to number of threads (" +
+                                  std::to_string( threadPool->getNumberOfThreads( ) ) + ")" );
+    }
+
     // Initialize return data.
     if( calculatePartials )
     {
@@ -128,70 +150,226 @@ void calculateDesignMatrixAndResiduals(
     typename observation_models::ObservationCollection< ObservationScalarType, TimeType >::SortedObservationSets
         sortedObservations = observationsCollection->getObservations( );
 
-    // Iterate over all observable types in observationsAndTimes
+    // Create list of all (non-empty) single observation sets, and their location in the design matrix. Each set is processed
+    // as a single task
+    std::vector< observation_models::ObservableType > observableTypePerTask;
+    std::vector< observation_models::LinkEnds > linkEndsPerTask;
+    std::vector< std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > > observationSetPerTask;
+    std::vector< std::pair< int, int > > observationIndicesPerTask;
     for( auto observablesIterator : sortedObservations )
     {
         observation_models::ObservableType currentObservableType = observablesIterator.first;
-
-        // Iterate over all link ends for current observable type in observationsAndTimes
         for( auto dataIterator : observablesIterator.second )
         {
             observation_models::LinkEnds currentLinkEnds = dataIterator.first;
             for( unsigned int i = 0; i < dataIterator.second.size( ); i++ )
             {
-                std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > currentObservations =
-                    dataIterator.second.at( i );
                 std::pair< int, int > observationIndices = observationsCollection->getObservationSetStartAndSize( ).at(
                     currentObservableType ).at( currentLinkEnds ).at( i );
-
-//                std::cout<<"Current size "<<currentObservations->getObservationTimes( ).size( )<<
-//                " "<<currentObservations->getObservations( ).size( )<<" "<<observationIndices.first<<" "<<observationIndices.second<<std::endl;
                 if( observationIndices.second > 0 )
                 {
-                    // Compute estimated ranges and range partials from current parameter estimate.
-                    Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > observationsVector;
-                    Eigen::MatrixXd partialsMatrix;
-                    observationManagers.at( currentObservableType )->
-                            computeObservationsWithPartials(
-                            currentObservations->getObservationTimes( ), currentLinkEnds,
-                            currentObservations->getReferenceLinkEnd( ),
-                            currentObservations->getAncilliarySettings( ),
-                            observationsVector,
-                            partialsMatrix,
-                            calculateResiduals,
-                            calculatePartials );
-
-                    if( calculatePartials )
-                    {
-//                        std::cout<<designMatrix.rows( )<<" "<<designMatrix.cols( )<<std::endl;
-//                        std::cout<<observationIndices.first<<" "<<0<<" "<<observationIndices.second<<" "<<totalNumberParameters<<std::endl;
-//                        std::cout<<partialsMatrix.rows( )<<" "<<partialsMatrix.cols( )<<std::endl<<std::endl;
-
-                        // Set current observation partials in matrix of all partials
-                        designMatrix.block( observationIndices.first, 0, observationIndices.second,
-                                            totalNumberParameters ) = partialsMatrix;
-                    }
-
-                    // Compute residuals for current link ends and observable type.
-                    if( calculateResiduals )
-                    {
-                        residuals.segment( observationIndices.first, observationIndices.second ) =
-                            ( currentObservations->getObservationsVector( ) - observationsVector ).template cast< double >( );
-
-                    }
+                    observableTypePerTask.push_back( currentObservableType );
+                    linkEndsPerTask.push_back( currentLinkEnds );
+                    observationSetPerTask.push_back( dataIterator.second.at( i ) );
+                    observationIndicesPerTask.push_back( observationIndices );
                 }
             }
         }
+    }
+
+    // Compute observations and partials for all observation sets
+    utilities::runTasks(
+        threadPool, observationSetPerTask.size( ), [ & ]( const int taskIndex, const unsigned int threadIndex )
+    {
+        const std::map< observation_models::ObservableType,
+            std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > >& currentObservationManagers =
+            ( threadPool == nullptr ) ? observationManagers : perThreadObservationManagers.at( threadIndex );
+
+        std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > currentObservations =
+            observationSetPerTask.at( taskIndex );
+        std::pair< int, int > observationIndices = observationIndicesPerTask.at( taskIndex );
+
+        // Compute estimated ranges and range partials from current parameter estimate.
+        Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > observationsVector;
+        Eigen::MatrixXd partialsMatrix;
+        currentObservationManagers.at( observableTypePerTask.at( taskIndex ) )->
+                computeObservationsWithPartials(
+                currentObservations->getObservationTimes( ), linkEndsPerTask.at( taskIndex ),
+                currentObservations->getReferenceLinkEnd( ),
+                currentObservations->getAncilliarySettings( ),
+                observationsVector,
+                partialsMatrix,
+                calculateResiduals,
+                calculatePartials );
+
+        if( calculatePartials )
+        {
+            // Set current observation partials in matrix of all partials
+            designMatrix.block( observationIndices.first, 0, observationIndices.second,
+                                totalNumberParameters ) = partialsMatrix;
+        }
 
+        // Compute residuals for current link ends and observable type.
         if( calculateResiduals )
         {
-            std::pair< int, int > observableStartAndSize = observationsCollection->getObservationTypeStartAndSize( ).at( currentObservableType );
+            residuals.segment( observationIndices.first, observationIndices.second ) =
+                ( currentObservations->getObservationsVector( ) - observationsVector ).template cast< double >( );
+        }
+    } );
+
+    if( calculateResiduals )
+    {
+        for( auto observablesIterator : sortedObservations )
+        {
+            std::pair< int, int > observableStartAndSize = observationsCollection->getObservationTypeStartAndSize( ).at( observablesIterator.first );
 
             observation_models::checkObservationResidualDiscontinuities(
                 residuals.block( observableStartAndSize.first, 0, observableStartAndSize.second, 1 ),
-                currentObservableType );
+                observablesIterator.first );
+        }
+    }
+}
+
+//! Maximum number of chunks of observation sets for which the normal equations are accumulated separately.
+/*!
+ *  Maximum number of chunks of observation sets for which the normal equations are accumulated separately (see
+ *  calculateNormalEquationsAndResiduals). This number is independent of the number of threads, so that the combined normal
+ *  equations are identical for any number of threads; it limits both the parallelism and the memory usage.
+ */
+const int maximumNumberOfNormalEquationsChunks = 32;
+
+//! Function to calculate the observation residuals and the block-sparse normal equations, without storing the design matrix
+/*!
+ *  Function to calculate the observation residuals and to accumulate the (unnormalized) normal equations for a given set of
+ *  observations and current parameter estimate, without storing the full design matrix. The computation is split into the
+ *  same tasks as in calculateDesignMatrixAndResiduals (one per single observation set), and the partials of each task are
+ *  added to the normal equations directly after computation. The tasks are split into a fixed number of contiguous chunks
+ *  (independent of the number of threads), each of which accumulates its own normal equations, in task order. These are
+ *  combined in chunk order once all tasks are completed, so that the result is bit-wise identical for any number of threads,
+ *  and independent of the order in which the tasks are executed.
+ *  \param observationsCollection Observable values and associated time tags, per observable type and set of link ends.
+ *  \param observationManagers Observation managers used to compute the observations and partials
+ *  \param totalObservationSize Total number of observations in observationsCollection.
+ *  \param weightsMatrixDiagonal Diagonal of the observation weights matrix
+ *  \param normalEquations Normal equations to which the contributions of all observations are added. The accumulated
+ *  normal equations are reset by this function before adding the observations.
+ *  \param residuals Residuals of computed w.r.t. input observable values (returned by reference)
+ *  \param threadPool Thread pool over which the computation of the observation sets is to be distributed (serial computation
+ *  if nullptr)
+ *  \param perThreadObservationManagers Observation managers for each thread of the thread pool (must be of same size as
+ *  number of threads in pool, if a thread pool is provided).
+ */
+template< typename ObservationScalarType = double, typename TimeType = double,
+    typename std::enable_if< is_state_scalar_and_time_type< ObservationScalarType, TimeType >::value, int >::type = 0 >
+void calculateNormalEquationsAndResiduals(
+    const std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observationsCollection,
+    const std::map< observation_models::ObservableType,
+        std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > >& observationManagers,
+    const int totalObservationSize,
+    const Eigen::VectorXd& weightsMatrixDiagonal,
+    linear_algebra::BlockArrowheadNormalEquations& normalEquations,
+    Eigen::VectorXd& residuals,
+    const std::shared_ptr< utilities::ThreadPool > threadPool = nullptr,
+    const std::vector< std::map< observation_models::ObservableType,
+        std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > > >&
+    perThreadObservationManagers = std::vector< std::map< observation_models::ObservableType,
+        std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > > >( ) )
+{
+    if( threadPool != nullptr && perThreadObservationManagers.size( ) != threadPool->getNumberOfThreads( ) )
+    {
+        throw std::runtime_error( "Error when computing normal equations in parallel; number of observation manager sets (" +
+                                  std::to_string( perThreadObservationManagers.size( ) ) + ") is not equal to number of threads (" +
+                                  std::to_string( threadPool->getNumberOfThreads( ) ) + ")" );
+    }
+
+    residuals = Eigen::VectorXd::Zero( totalObservationSize );
+    normalEquations.reset( );
+
+    typename observation_models::ObservationCollection< ObservationScalarType, TimeType >::SortedObservationSets
+        sortedObservations = observationsCollection->getObservations( );
+
+    // Create list of all (non-empty) single observation sets, and their location in the residual vector
+    std::vector< observation_models::ObservableType > observableTypePerTask;
+    std::vector< observation_models::LinkEnds > linkEndsPerTask;
+    std::vector< std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > > observationSetPerTask;
+    std::vector< std::pair< int, int > > observationIndicesPerTask;
+    for( auto observablesIterator : sortedObservations )
+    {
+        observation_models::ObservableType currentObservableType = observablesIterator.first;
+        for( auto dataIterator : observablesIterator.second )
+        {
+            observation_models::LinkEnds currentLinkEnds = dataIterator.first;
+            for( unsigned int i = 0; i < dataIterator.second.size( ); i++ )
+            {
+                std::pair< int, int > observationIndices = observationsCollection->getObservationSetStartAndSize( ).at(
+                    currentObservableType ).at( currentLinkEnds ).at( i );
+                if( observationIndices.second > 0 )
+                {
+                    observableTypePerTask.push_back( currentObservableType );
+                    linkEndsPerTask.push_back( currentLinkEnds );
+                    observationSetPerTask.push_back( dataIterator.second.at( i ) );
+                    observationIndicesPerTask.push_back( observationIndices );
+                }
+            }
         }
     }
+
+    // Split observation sets into contiguous chunks, each with its own normal equations
+    const int numberOfTasks = observationSetPerTask.size( );
+    const int numberOfChunks = std::min( numberOfTasks, maximumNumberOfNormalEquationsChunks );
+    std::vector< linear_algebra::BlockArrowheadNormalEquations > perChunkNormalEquations( numberOfChunks, normalEquations );
+
+    // Compute observations and partials for all observation sets, and add them to normal equations of current chunk
+    utilities::runTasks(
+        threadPool, numberOfChunks, [ & ]( const int chunkIndex, const unsigned int threadIndex )
+    {
+        const std::map< observation_models::ObservableType,
+            std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > >& currentObservationManagers =
+            ( threadPool == nullptr ) ? observationManagers : perThreadObservationManagers.at( threadIndex );
+
+        const int firstTaskIndex = static_cast< int >(
+                    static_cast< long >( chunkIndex ) * numberOfTasks / numberOfChunks );
+        const int lastTaskIndex = static_cast< int >(
+                    static_cast< long >( chunkIndex + 1 ) * numberOfTasks / numberOfChunks );
+        for( int taskIndex = firstTaskIndex; taskIndex < lastTaskIndex; taskIndex++ )
+        {
+            std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > currentObservations =
+                observationSetPerTask.at( taskIndex );
+            std::pair< int, int > observationIndices = observationIndicesPerTask.at( taskIndex );
+
+            Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > observationsVector;
+            Eigen::MatrixXd partialsMatrix;
+            currentObservationManagers.at( observableTypePerTask.at( taskIndex ) )->
+                    computeObservationsWithPartials(
+                    currentObservations->getObservationTimes( ), linkEndsPerTask.at( taskIndex ),
+                    currentObservations->getReferenceLinkEnd( ),
+                    currentObservations->getAncilliarySettings( ),
+                    observationsVector,
+                    partialsMatrix,
+                    true, true );
+
+            residuals.segment( observationIndices.first, observationIndices.second ) =
+                ( currentObservations->getObservationsVector( ) - observationsVector ).template cast< double >( );
+
+            perChunkNormalEquations.at( chunkIndex ).addObservations(
+                partialsMatrix, residuals.segment( observationIndices.first, observationIndices.second ),
+                weightsMatrixDiagonal.segment( observationIndices.first, observationIndices.second ) );
+        }
+    } );
+
+    for( int i = 0; i < numberOfChunks; i++ )
+    {
+        normalEquations.add( perChunkNormalEquations.at( i ) );
+    }
+
+    for( auto observablesIterator : sortedObservations )
+    {
+        std::pair< int, int > observableStartAndSize = observationsCollection->getObservationTypeStartAndSize( ).at( observablesIterator.first );
+
+        observation_models::checkObservationResidualDiscontinuities(
+            residuals.block( observableStartAndSize.first, 0, observableStartAndSize.second, 1 ),
+            observablesIterator.first );
+    }
 }
 
 template< typename ObservationScalarType = double, typename TimeType = double,
@@ -695,12 +873,32 @@ public:
                 std::to_string( estimationInput->getWeightsMatrixDiagonals( ).rows( ) ) + ") is not compatible with number of observations (" +
                 std::to_string( totalNumberOfObservations ) + ")" );
         }
+
+        // Create block-sparse normal equations, if required (design matrix is then not computed)
+        const bool useBlockSparseNormalEquations = estimationInput->getUseBlockSparseNormalEquations( );
+        std::shared_ptr< linear_algebra::BlockArrowheadNormalEquations > normalEquations;
+        if( useBlockSparseNormalEquations )
+        {
+            Eigen::MatrixXd constraintStateMultiplier;
+            Eigen::VectorXd constraintRightHandSide;
+            parametersToEstimate_->getConstraints( constraintStateMultiplier, constraintRightHandSide );
+            if( considerParametersIncluded_ || constraintStateMultiplier.rows( ) > 0 )
+            {
+                throw std::runtime_error( "Error when estimating parameters with block-sparse normal equations, consider "
+                                          "parameters and constraints are not supported." );
+            }
+            normalEquations = std::make_shared< linear_algebra::BlockArrowheadNormalEquations >(
+                        numberEstimatedParameters_, getArcWiseInitialStateParameterIndices( ) );
+        }
+
         // Declare variables to be returned (i.e. results from best iteration)
         double bestResidual = TUDAT_NAN;
         ParameterVectorType bestParameterEstimate = ParameterVectorType::Constant( numberEstimatedParameters_, TUDAT_NAN );
         Eigen::VectorXd bestTransformationData = Eigen::VectorXd::Constant( numberEstimatedParameters_, TUDAT_NAN );
         Eigen::VectorXd bestResiduals = Eigen::VectorXd::Constant( totalNumberOfObservations, TUDAT_NAN );
-        Eigen::MatrixXd bestDesignMatrixEstimatedParameters = Eigen::MatrixXd::Constant( totalNumberOfObservations, totalNumberParameters_, TUDAT_NAN );
+        Eigen::MatrixXd bestDesignMatrixEstimatedParameters = useBlockSparseNormalEquations ?
+                    Eigen::MatrixXd( 0, numberEstimatedParameters_ ) :
+                    Eigen::MatrixXd::Constant( totalNumberOfObservations, totalNumberParameters_, TUDAT_NAN );
         Eigen::VectorXd bestWeightsMatrixDiagonal = Eigen::VectorXd::Constant( totalNumberOfObservations, TUDAT_NAN );
         Eigen::MatrixXd bestInverseNormalizedCovarianceMatrix = Eigen::MatrixXd::Constant( numberEstimatedParameters_, numberEstimatedParameters_, TUDAT_NAN );
 
@@ -748,20 +946,32 @@ public:
                 newFullParameterEstimate.segment( numberEstimatedParameters_, numberConsiderParameters_ ) = considerParametersValues_;
             }
 
-            // Compute design matrices (for estimated and consider parameters) and residuals.
+            // Compute design matrices (for estimated and consider parameters), or normal equations, and residuals.
             std::shared_ptr< propagators::SimulationResults< ObservationScalarType, TimeType > > simulationResults;
-            std::pair< std::pair< Eigen::MatrixXd, Eigen::MatrixXd >, Eigen::VectorXd > designMatricesAndResiduals = performPreEstimationSteps(
-                    estimationInput, newFullParameterEstimate, true, numberOfIterations, exceptionDuringPropagation, simulationResults );
-            Eigen::VectorXd residuals = designMatricesAndResiduals.second;
-            Eigen::MatrixXd designMatrixEstimatedParameters = designMatricesAndResiduals.first.first;
+            Eigen::VectorXd residuals;
+            Eigen::MatrixXd designMatrixEstimatedParameters;
             Eigen::MatrixXd designMatrixConsiderParameters;
-            if ( considerParametersIncluded_ )
+            if( useBlockSparseNormalEquations )
             {
-                designMatrixConsiderParameters = designMatricesAndResiduals.first.second;
+                residuals = performPreEstimationStepsWithNormalEquations(
+                        estimationInput, newFullParameterEstimate, numberOfIterations, exceptionDuringPropagation,
+                        simulationResults, *normalEquations );
+                designMatrixConsiderParameters = Eigen::MatrixXd::Zero( 0, 0 );
             }
             else
             {
-                designMatrixConsiderParameters = Eigen::MatrixXd::Zero( 0, 0 );
+                std::pair< std::pair< Eigen::MatrixXd, Eigen::MatrixXd >, Eigen::VectorXd > designMatricesAndResiduals = performPreEstimationSteps(
+                        estimationInput, newFullParameterEstimate, true, numberOfIterations, exceptionDuringPropagation, simulationResults );
+                residuals = designMatricesAndResiduals.second;
+                designMatrixEstimatedParameters = designMatricesAndResiduals.first.first;
+                if ( considerParametersIncluded_ )
+                {
+                    designMatrixConsiderParameters = designMatricesAndResiduals.first.second;
+                }
+                else
+                {
+                    designMatrixConsiderParameters = Eigen::MatrixXd::Zero( 0, 0 );
+                }
             }
 
             // Set simulation results
@@ -770,8 +980,17 @@ public:
                 simulationResultsPerIteration.push_back( simulationResults );
             }
 
-            // Normalise estimated parameters partials and inverse apriori covariance
-            Eigen::VectorXd normalizationTerms = normalizeDesignMatrix( designMatrixEstimatedParameters );
+            // Normalise estimated parameters partials (or normal equations) and inverse apriori covariance
+            Eigen::VectorXd normalizationTerms;
+            if( useBlockSparseNormalEquations )
+            {
+                normalizationTerms = normalEquations->getDesignMatrixNormalizationTerms( );
+                normalEquations->normalize( normalizationTerms );
+            }
+            else
+            {
+                normalizationTerms = normalizeDesignMatrix( designMatrixEstimatedParameters );
+            }
             Eigen::MatrixXd normalizedInverseAprioriCovarianceMatrix = normalizeAprioriCovariance(
                     estimationInput->getInverseOfAprioriCovariance( numberEstimatedParameters_ ), normalizationTerms );
 
@@ -806,10 +1025,19 @@ public:
                     conditionNumberCheck = TUDAT_NAN;
                 }
                 // Perform LSQ inversion
-                leastSquaresOutput = std::move( linear_algebra::performLeastSquaresAdjustmentFromDesignMatrix(
-                        designMatrixEstimatedParameters, residuals, estimationInput->getWeightsMatrixDiagonals( ),
-                        normalizedInverseAprioriCovarianceMatrix, conditionNumberCheck, constraintStateMultiplier, constraintRightHandSide,
-                        designMatrixConsiderParameters, normalizedConsiderParametersDeviation ) );
+                if( useBlockSparseNormalEquations )
+                {
+                    normalEquations->addToNormalMatrix( normalizedInverseAprioriCovarianceMatrix );
+                    leastSquaresOutput = std::make_pair( normalEquations->solve( conditionNumberCheck ),
+                                                         normalEquations->getFullNormalMatrix( ) );
+                }
+                else
+                {
+                    leastSquaresOutput = std::move( linear_algebra::performLeastSquaresAdjustmentFromDesignMatrix(
+                            designMatrixEstimatedParameters, residuals, estimationInput->getWeightsMatrixDiagonals( ),
+                            normalizedInverseAprioriCovarianceMatrix, conditionNumberCheck, constraintStateMultiplier, constraintRightHandSide,
+                            designMatrixConsiderParameters, normalizedConsiderParametersDeviation ) );
+                }
 
                 if( constraintStateMultiplier.rows( ) > 0 )
                 {
@@ -864,7 +1092,7 @@ public:
                 bestResidual = residualRms;
                 bestParameterEstimate = oldParameterEstimate;
                 bestResiduals = std::move( residuals );
-                if( estimationInput->getSaveDesignMatrix( ) )
+                if( estimationInput->getSaveDesignMatrix( ) && !useBlockSparseNormalEquations )
                 {
                     bestDesignMatrixEstimatedParameters = std::move( designMatrixEstimatedParameters );
                     if ( considerParametersIncluded_ )
@@ -1176,6 +1404,8 @@ protected:
 
 
         // Iterate over all observables and create observation managers.
+        bodies_ = bodies;
+        observationSettingsList_ = observationSettingsList;
         observationManagers_ = createObservationManagersBase(
             observationSettingsList, bodies, fullParameters_,
             stateTransitionAndSensitivityMatrixInterface_, dependentVariablesInterface_ );
@@ -1258,18 +1488,73 @@ protected:
     }
 
 
-    std::pair< std::pair< Eigen::MatrixXd, Eigen::MatrixXd >, Eigen::VectorXd > performPreEstimationSteps(
+    //! Function to (re)create the thread pool and per-thread observation managers used to compute observations and partials.
+    /*!
+     *  Function to (re)create the thread pool and per-thread observation managers used to compute observations and partials.
+     *  The observation managers for thread 0 are the observationManagers_; for each additional thread, a new set of observation
+     *  managers is created from the same observation settings. If parameters are estimated that are a property of the
+     *  observation link (e.g. observation biases), the computations are performed serially, since the creation of additional
+     *  observation managers would reset the coupling between these parameters and the observation models.
+     *  \param numberOfThreads Requested number of threads (0 denotes the number of available hardware threads)
+     */
+    void setObservationThreadPool( const unsigned int numberOfThreads )
+    {
+        unsigned int numberOfThreadsToUse = ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+
+        if( numberOfThreadsToUse > 1 )
+        {
+            std::vector< estimatable_parameters::EstimatebleParametersEnum > parameterTypes;
+            for( auto parameter : fullParameters_->getEstimatedDoubleParameters( ) )
+            {
+                parameterTypes.push_back( parameter->getParameterName( ).first );
+            }
+            for( auto parameter : fullParameters_->getEstimatedVectorParameters( ) )
+            {
+                parameterTypes.push_back( parameter->getParameterName( ).first );
+            }
+
+            for( unsigned int i = 0; i < parameterTypes.size( ); i++ )
+            {
+                if( estimatable_parameters::isParameterObservationLinkProperty( parameterTypes.at( i ) ) ||
+                        estimatable_parameters::isParameterObservationLinkTimeProperty( parameterTypes.at( i ) ) )
+                {
+                    std::cerr << "Warning, observation link parameters are estimated; observations and partials are "
+                              << "computed using a single thread." << std::endl;
+                    numberOfThreadsToUse = 1;
+                    break;
+                }
+            }
+        }
+
+        if( numberOfThreadsToUse <= 1 )
+        {
+            observationThreadPool_ = nullptr;
+            perThreadObservationManagers_.clear( );
+        }
+        else if( observationThreadPool_ == nullptr || observationThreadPool_->getNumberOfThreads( ) != numberOfThreadsToUse )
+        {
+            observationThreadPool_ = std::make_shared< utilities::ThreadPool >( numberOfThreadsToUse );
+
+            perThreadObservationManagers_.resize( 1 );
+            perThreadObservationManagers_.at( 0 ) = observationManagers_;
+            for( unsigned int i = 1; i < numberOfThreadsToUse; i++ )
+            {
+                perThreadObservationManagers_.push_back(
+                            createObservationManagersBase(
+                                observationSettingsList_, bodies_, fullParameters_,
+                                stateTransitionAndSensitivityMatrixInterface_, dependentVariablesInterface_ ) );
+            }
+        }
+    }
+
+    //! Function to reintegrate the equations of motion and variational equations for a new parameter estimate
+    void resetParametersForEstimationIteration(
             std::shared_ptr< CovarianceAnalysisInput< ObservationScalarType, TimeType > > estimationInput,
             ParameterVectorType& newParameterEstimate,
-            const bool calculateResiduals,
             const int numberOfIterations,
             bool& exceptionDuringPropagation,
             std::shared_ptr< propagators::SimulationResults< ObservationScalarType, TimeType > >& simulationResults )
     {
-        // Get number of observations
-        int totalNumberOfObservations = estimationInput->getObservationCollection( )->getTotalObservableSize( );
-
-        // Re-integrate equations of motion and variational equations with new parameter estimate.
         try
         {
             if( ( numberOfIterations > 0 ) || ( estimationInput->getReintegrateEquationsOnFirstIteration( ) ) )
@@ -1291,6 +1576,22 @@ protected:
                      error.what( )<<std::endl<<"Terminating estimation"<<std::endl;
             exceptionDuringPropagation = true;
         }
+    }
+
+    std::pair< std::pair< Eigen::MatrixXd, Eigen::MatrixXd >, Eigen::VectorXd > performPreEstimationSteps(
+            std::shared_ptr< CovarianceAnalysisInput< ObservationScalarType, TimeType > > estimationInput,
+            ParameterVectorType& newParameterEstimate,
+            const bool calculateResiduals,
+            const int numberOfIterations,
+            bool& exceptionDuringPropagation,
+            std::shared_ptr< propagators::SimulationResults< ObservationScalarType, TimeType > >& simulationResults )
+    {
+        // Get number of observations
+        int totalNumberOfObservations = estimationInput->getObservationCollection( )->getTotalObservableSize( );
+
+        // Re-integrate equations of motion and variational equations with new parameter estimate.
+        resetParametersForEstimationIteration(
+                    estimationInput, newParameterEstimate, numberOfIterations, exceptionDuringPropagation, simulationResults );
 
         if( estimationInput->getPrintOutput( ) )
         {
@@ -1298,18 +1599,12 @@ protected:
         }
 
         // Calculate residuals and observation matrix for current parameter estimate.
+        setObservationThreadPool( estimationInput->getNumberOfThreads( ) );
         Eigen::VectorXd residuals;
         Eigen::MatrixXd designMatrix;
-        if ( calculateResiduals )
-        {
-            calculateDesignMatrixAndResiduals< ObservationScalarType, TimeType >(
-                    estimationInput->getObservationCollection( ), observationManagers_, totalNumberParameters_, totalNumberOfObservations, designMatrix, residuals, true );
-        }
-        else
-        {
-            calculateDesignMatrix< ObservationScalarType, TimeType >(
-                    estimationInput->getObservationCollection( ), observationManagers_, totalNumberParameters_, totalNumberOfObservations, designMatrix );
-        }
+        calculateDesignMatrixAndResiduals< ObservationScalarType, TimeType >(
+                estimationInput->getObservationCollection( ), observationManagers_, totalNumberParameters_, totalNumberOfObservations,
+                designMatrix, residuals, calculateResiduals, true, observationThreadPool_, perThreadObservationManagers_ );
 
         // Divide partials matrix between estimated and consider parameters
         std::pair< Eigen::MatrixXd, Eigen::MatrixXd > designMatrices = separateEstimatedAndConsiderDesignMatrices( designMatrix, totalNumberOfObservations );
@@ -1317,6 +1612,84 @@ protected:
         return std::make_pair( designMatrices, residuals );
     }
 
+    //! Function to perform the steps before an estimation iteration, accumulating block-sparse normal equations
+    /*!
+     *  Function to perform the steps before an estimation iteration (see performPreEstimationSteps), but accumulating the
+     *  observation partials directly into block-sparse normal equations, instead of computing the full design matrix.
+     *  \param estimationInput Object containing the observations and estimation settings
+     *  \param newParameterEstimate New estimate of parameter vector.
+     *  \param numberOfIterations Number of iterations that have been performed
+     *  \param exceptionDuringPropagation Boolean that is set to true if an exception occured during propagation
+     *  \param simulationResults Simulation results of current iteration (set if required by estimationInput)
+     *  \param normalEquations Normal equations to which the contributions of all observations are added (after reset)
+     *  \return Observation residuals
+     */
+    Eigen::VectorXd performPreEstimationStepsWithNormalEquations(
+            std::shared_ptr< CovarianceAnalysisInput< ObservationScalarType, TimeType > > estimationInput,
+            ParameterVectorType& newParameterEstimate,
+            const int numberOfIterations,
+            bool& exceptionDuringPropagation,
+            std::shared_ptr< propagators::SimulationResults< ObservationScalarType, TimeType > >& simulationResults,
+            linear_algebra::BlockArrowheadNormalEquations& normalEquations )
+    {
+        int totalNumberOfObservations = estimationInput->getObservationCollection( )->getTotalObservableSize( );
+
+        resetParametersForEstimationIteration(
+                    estimationInput, newParameterEstimate, numberOfIterations, exceptionDuringPropagation, simulationResults );
+
+        if( estimationInput->getPrintOutput( ) )
+        {
+            std::cout << "Calculating residuals and normal equations " << totalNumberOfObservations << std::endl;
+        }
+
+        setObservationThreadPool( estimationInput->getNumberOfThreads( ) );
+        Eigen::VectorXd residuals;
+        calculateNormalEquationsAndResiduals< ObservationScalarType, TimeType >(
+                estimationInput->getObservationCollection( ), observationManagers_, totalNumberOfObservations,
+                estimationInput->getWeightsMatrixDiagonals( ), normalEquations, residuals,
+                observationThreadPool_, perThreadObservationManagers_ );
+        return residuals;
+    }
+
+    //! Function to retrieve the indices of the arc-wise initial state parameters, per arc
+    /*!
+     *  Function to retrieve the indices (in estimated parameter vector) of the arc-wise initial state parameters, per arc. Arcs
+     *  of different bodies with identical start times are grouped as a single arc.
+     *  \return Indices of arc-wise initial state parameters, per arc (in order of arc start time)
+     */
+    std::vector< std::vector< int > > getArcWiseInitialStateParameterIndices( )
+    {
+        std::map< double, std::vector< int > > parameterIndicesPerArcStartTime;
+        for( auto parameterIterator : parametersToEstimate_->getInitialMultiArcStateParameters( ) )
+        {
+            std::shared_ptr< estimatable_parameters::ArcWiseInitialTranslationalStateParameter< ObservationScalarType > >
+                    arcWiseStateParameter = std::dynamic_pointer_cast<
+                    estimatable_parameters::ArcWiseInitialTranslationalStateParameter< ObservationScalarType > >(
+                        parameterIterator.second );
+            if( arcWiseStateParameter == nullptr )
+            {
+                continue;
+            }
+
+            std::vector< double > arcStartTimes = arcWiseStateParameter->getArcStartTimes( );
+            for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+            {
+                for( int j = 0; j < 6; j++ )
+                {
+                    parameterIndicesPerArcStartTime[ arcStartTimes.at( i ) ].push_back(
+                                parameterIterator.first + 6 * i + j );
+                }
+            }
+        }
+
+        std::vector< std::vector< int > > parameterIndicesPerArc;
+        for( auto arcIterator : parameterIndicesPerArcStartTime )
+        {
+            parameterIndicesPerArc.push_back( arcIterator.second );
+        }
+        return parameterIndicesPerArc;
+    }
+
     std::pair< Eigen::MatrixXd, Eigen::MatrixXd > separateEstimatedAndConsiderDesignMatrices(
             const Eigen::MatrixXd& designMatrix,
             const int numberObservations )
@@ -1361,6 +1734,16 @@ protected:
 
     SystemOfBodies bodies_;
 
+    //! Settings for the observation models, used to create additional (per-thread) observation managers
+    std::vector< std::shared_ptr< observation_models::ObservationModelSettings > > observationSettingsList_;
+
+    //! Thread pool used to compute observations and partials (nullptr if computed serially)
+    std::shared_ptr< utilities::ThreadPool > observationThreadPool_;
+
+    //! Observation managers for each thread of observationThreadPool_ (entry 0 equal to observationManagers_)
+    std::vector< std::map< observation_models::ObservableType,
+    std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > > > perThreadObservationManagers_;
+
     //! Current values of the vector of estimated parameters
     ParameterVectorType currentParameterEstimate_;
 
@@ -141,21 +141,30 @@ simulateObservationsWithCheck(
         const std::shared_ptr< observation_models::ObservationAncilliarySimulationSettings > ancilliarySettings = nullptr )
 {
     std::map< TimeType, Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > observations;
-    std::tuple< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 >, bool, Eigen::VectorXd > simulatedObservation;
     std::vector< Eigen::VectorXd > dependentVariables;
 
+    // Simulate observables at all times as a batch, and retrieve link end times and states
+    std::vector< Eigen::Matrix< ObservationScalarType, ObservationSize, 1 > > calculatedObservations;
+    std::vector< std::vector< double > > vectorsOfTimes;
+    std::vector< std::vector< Eigen::Vector6d > > vectorsOfStates;
+    observationModel->computeObservationsWithLinkEndData(
+                observationTimes, referenceLinkEnd, calculatedObservations, vectorsOfTimes, vectorsOfStates,
+                ancilliarySettings );
+
     for( unsigned int i = 0; i < observationTimes.size( ); i++ )
     {
-        simulatedObservation = simulateObservationWithCheck< ObservationSize, ObservationScalarType, TimeType >(
-                    observationTimes.at( i ), observationModel, referenceLinkEnd, linkViabilityCalculators, noiseFunction,
-                    dependentVariableCalculator, ancilliarySettings );
-
         // Check if receiving station can view transmitting station.
-        if( std::get< 1 >( simulatedObservation ) )
+        if( isObservationViable( vectorsOfStates[ i ], vectorsOfTimes[ i ], linkViabilityCalculators ) )
         {
+            Eigen::VectorXd currentDependentVariables = Eigen::VectorXd::Zero( 0 );
+            addNoiseAndDependentVariableToObservation< ObservationSize , ObservationScalarType, TimeType >(
+                        calculatedObservations[ i ], observationTimes[ i ], currentDependentVariables,
+                        vectorsOfStates[ i ], vectorsOfTimes[ i ], ancilliarySettings, observationModel->getObservableType( ),
+                        noiseFunction, dependentVariableCalculator );
+
             // If viable, add observable and time to vector of simulated data.
-            observations[ observationTimes[ i ] ] = std::get< 0 >( simulatedObservation );
-            dependentVariables.push_back( std::get< 2 >( simulatedObservation ) );
+            observations[ observationTimes[ i ] ] = calculatedObservations[ i ];
+            dependentVariables.push_back( currentDependentVariables );
         }
     }
 
@@ -1197,6 +1197,27 @@ public:
             arcWiseParameterVectorSize_.push_back( estimatable_parameters::getSingleArcParameterSetSize( parametersToEstimate, arc ) );
         }
 
+        // When propagating arcs concurrently, the partials of each arc are created from the environment of that arc. Since
+        // parameters other than the arc-wise initial states are linked to the environment provided to this solver, they
+        // would not be used by (or be reset in) the arc-wise environments.
+        std::vector< simulation_setup::SystemOfBodies > arcWiseBodies;
+        if( propagatorSettings_->getPropagateArcsConcurrently( ) )
+        {
+            if( parametersToEstimate->getEstimatedDoubleParameters( ).size( ) > 0 ||
+                    parametersToEstimate->getEstimatedVectorParameters( ).size( ) > 0 )
+            {
+                throw std::runtime_error( "Error in multi-arc variational equations solver, when propagating arcs concurrently, "
+                                          "only arc-wise initial states can be estimated (see "
+                                          "MultiArcPropagatorSettings::setConcurrentArcPropagation)" );
+            }
+            arcWiseBodies = propagatorSettings_->getArcWiseBodies( );
+        }
+        else
+        {
+            arcWiseBodies = std::vector< simulation_setup::SystemOfBodies >(
+                        propagatorSettings_->getSingleArcSettings( ).size( ), bodies );
+        }
+
         dynamicsSimulator_ =  std::make_shared< MultiArcDynamicsSimulator< StateScalarType, TimeType > >(
                     bodies, propagatorSettings, false );
 
@@ -1222,7 +1243,8 @@ public:
             // Create variational equations objects.
             std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap > stateDerivativePartials =
                     simulation_setup::createStateDerivativePartials< StateScalarType, TimeType >(
-                        dynamicsStateDerivatives_.at( i )->getStateDerivativeModels( ), bodies, arcWiseParametersToEstimate_[ i ] );
+                        dynamicsStateDerivatives_.at( i )->getStateDerivativeModels( ), arcWiseBodies.at( i ),
+                        arcWiseParametersToEstimate_[ i ] );
 
             std::shared_ptr< VariationalEquations > variationalEquationsObject_ =
                     std::make_shared< VariationalEquations >(
@@ -1706,6 +1728,11 @@ public:
         {
             throw std::runtime_error( "Error when making HybridArcVariationalEquationsSolver, input propagation settings are not hybrid arc" );
         }
+        else if( originalPopagatorSettings_->getMultiArcPropagatorSettings( )->getPropagateArcsConcurrently( ) )
+        {
+            throw std::runtime_error( "Error when making HybridArcVariationalEquationsSolver, concurrent propagation of arcs is "
+                                      "not supported for hybrid-arc dynamics" );
+        }
 
         // Retrive arc properties
         singleArcInitialTime_ = originalPopagatorSettings_->getSingleArcPropagatorSettings( )->getInitialTime( );
@@ -19,6 +19,8 @@
 #include "propagation_setup/createTorqueModel.h"
 #include "propagation_setup/dynamicsSimulator.h"
 #include "propagation_setup/environmentUpdater.h"
+#include "propagation_setup/ensemblePropagation.h"
+#include "propagation_setup/pararealPropagation.h"
 #include "propagation_setup/propagationCR3BPFullProblem.h"
 //#include "propagation_setup/propagationLambertTargeterFullProblem.h"
 #include "propagation_setup/propagationOutput.h"
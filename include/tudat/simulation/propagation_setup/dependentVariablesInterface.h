@@ -106,7 +106,6 @@ public:
             dependentVariablesIdsAndSize_[ getDependentVariableId( dependentVariablesSettings_[ i ] ) ] = getDependentVariableSaveSize( dependentVariablesSettings_[ i ], bodies );
             dependentVariablesSize_ += dependentVariablesIdsAndSize_[ getDependentVariableId( dependentVariablesSettings_[ i ] ) ];
         }
-        dependentVariables_ = Eigen::VectorXd::Zero( dependentVariablesSize_ );
 
         if( dependentVariablesInterpolator_ != nullptr )
         {
@@ -160,14 +159,13 @@ public:
      */
     Eigen::VectorXd getDependentVariables( const TimeType evaluationTime )
     {
-        dependentVariables_.setZero( );
-
-        // Set dependent variable.
+        // Set dependent variable (local return variable, so that function may be called concurrently).
+        Eigen::VectorXd dependentVariables = Eigen::VectorXd::Zero( dependentVariablesSize_ );
         if( dependentVariablesInterpolator_ != nullptr )
         {
-            dependentVariables_ = dependentVariablesInterpolator_->interpolate( evaluationTime );
+            dependentVariables = dependentVariablesInterpolator_->interpolate( evaluationTime );
         }
-        return dependentVariables_;
+        return dependentVariables;
     }
 
     //! Function to get the value of a single dependent variable at a given time.
@@ -274,9 +272,6 @@ private:
 
     std::map< std::pair< int, int >, std::shared_ptr< SingleDependentVariableSaveSettings > > orderedDependentVariableSettings_;
 
-    //! Predefined vector to use as return value when calling getDependentVariables.
-    Eigen::VectorXd dependentVariables_;
-
     //! Type of the dependent variables of interest
     std::vector< PropagationDependentVariables > dependentVariablesTypes_;
 
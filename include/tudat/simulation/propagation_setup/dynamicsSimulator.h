@@ -19,7 +19,9 @@
 
 #include "tudat/basics/tudatTypeTraits.h"
 #include "tudat/basics/utilities.h"
+#include "tudat/basics/threadPool.h"
 #include "tudat/astro/propagators/nBodyStateDerivative.h"
+#include "tudat/astro/propagators/nBodyTaylorSeriesExpressions.h"
 #include "tudat/astro/ephemerides/frameManager.h"
 #include "tudat/simulation/propagation_setup/propagationSettings.h"
 #include "tudat/simulation/propagation_setup/setNumericallyIntegratedStates.h"
@@ -657,6 +659,163 @@ struct PostProcessingFunctionProvider< StateScalarType, TimeType, Eigen::Dynamic
     }
 };
 
+//! Function to determine the size of the fixed-size state with which the dynamics can be numerically integrated.
+/*!
+ *  Function to determine the size of the fixed-size state with which the dynamics can be numerically integrated (as a single
+ *  column, without variational equations). Integrating with a fixed-size state type prevents heap allocation of the state
+ *  (and stage) temporaries by the numerical integrator. This is possible for the translational dynamics of a single body
+ *  using the Cowell propagator, optionally combined with the propagation of the mass of a single body.
+ *  \param stateDerivativeModel Model used to compute the state derivative of the dynamics
+ *  \return Size of the fixed-size state with which the dynamics can be integrated (6 or 7), or Eigen::Dynamic if the
+ *  dynamics cannot be integrated with a fixed-size state.
+ */
+template< typename StateScalarType, typename TimeType >
+int getFixedPropagatedStateSize(
+        const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > stateDerivativeModel )
+{
+    std::unordered_map< IntegratedStateType, std::vector< std::shared_ptr
+            < SingleStateTypeDerivative< StateScalarType, TimeType > > > > stateDerivativeModels =
+            stateDerivativeModel->getStateDerivativeModels( );
+
+    // Check if translational dynamics of a single body is propagated with Cowell propagator
+    if( stateDerivativeModels.count( translational_state ) == 0 ||
+            stateDerivativeModels.at( translational_state ).size( ) != 1 )
+    {
+        return Eigen::Dynamic;
+    }
+    std::shared_ptr< NBodyStateDerivative< StateScalarType, TimeType > > translationalStateDerivative =
+            std::dynamic_pointer_cast< NBodyStateDerivative< StateScalarType, TimeType > >(
+                stateDerivativeModels.at( translational_state ).at( 0 ) );
+    if( translationalStateDerivative == nullptr ||
+            translationalStateDerivative->getTranslationalPropagatorType( ) != cowell ||
+            translationalStateDerivative->getPropagatedStateSize( ) != 6 ||
+            translationalStateDerivative->isStateToBePostProcessed( ) )
+    {
+        return Eigen::Dynamic;
+    }
+
+    // Check if (at most) the mass of a single body is propagated in addition
+    int fixedStateSize = 6;
+    for( auto modelIterator : stateDerivativeModels )
+    {
+        if( modelIterator.first == body_mass_state )
+        {
+            if( modelIterator.second.size( ) != 1 || modelIterator.second.at( 0 )->getPropagatedStateSize( ) != 1 ||
+                    modelIterator.second.at( 0 )->isStateToBePostProcessed( ) )
+            {
+                return Eigen::Dynamic;
+            }
+            fixedStateSize = 7;
+        }
+        else if( modelIterator.first != translational_state )
+        {
+            return Eigen::Dynamic;
+        }
+    }
+    return fixedStateSize;
+}
+
+//! Class to numerically integrate the dynamics using a fixed-size state, for dynamics for which this is possible.
+/*!
+ *  Class to numerically integrate the dynamics using a fixed-size state, for dynamics for which this is possible (see
+ *  getFixedPropagatedStateSize). This general implementation is used when the state has more than one column (i.e.
+ *  when variational equations are propagated), for which a fixed-size state is never used.
+ */
+template< typename StateScalarType, typename TimeType, int NumberOfColumns >
+struct FixedSizeStateIntegrator
+{
+    template< typename SimulationResults >
+    static bool integrateEquations(
+            const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > /* stateDerivativeModel */,
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, NumberOfColumns >& /* initialState */,
+            const TimeType /* initialTime */,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > /* integratorSettings */,
+            const std::shared_ptr< PropagationTerminationCondition > /* propagationTerminationCondition */,
+            const std::shared_ptr< SimulationResults > /* propagationResults */,
+            const std::function< Eigen::VectorXd( ) > /* dependentVariableFunction */,
+            const std::shared_ptr< SingleArcPropagatorProcessingSettings > /* processingSettings */ )
+    {
+        return false;
+    }
+};
+
+//! Class to numerically integrate the dynamics using a fixed-size state, for single-column states.
+template< typename StateScalarType, typename TimeType >
+struct FixedSizeStateIntegrator< StateScalarType, TimeType, 1 >
+{
+    //! Function to numerically integrate the dynamics using a fixed-size state, if the dynamics allows it.
+    /*!
+     *  Function to numerically integrate the dynamics using a fixed-size state, if the dynamics allows it (see
+     *  getFixedPropagatedStateSize). The results are stored in propagationResults in the same form as when integrating
+     *  with a dynamically sized state (see integrateEquations).
+     *  \param stateDerivativeModel Model used to compute the state derivative of the dynamics
+     *  \param initialState Initial state (in propagator-specific form)
+     *  \param initialTime Initial time
+     *  \param integratorSettings Settings for numerical integrator.
+     *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped.
+     *  \param propagationResults Object in which the numerical results are to be stored.
+     *  \param dependentVariableFunction Function returning dependent variables
+     *  \param processingSettings Settings for saving and printing the propagation results.
+     *  \return True if the dynamics was integrated with a fixed-size state, false if this is not possible (in which case
+     *  nothing has been integrated).
+     */
+    template< typename SimulationResults >
+    static bool integrateEquations(
+            const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > stateDerivativeModel,
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialState,
+            const TimeType initialTime,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+            const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
+            const std::shared_ptr< SimulationResults > propagationResults,
+            const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
+            const std::shared_ptr< SingleArcPropagatorProcessingSettings > processingSettings )
+    {
+        switch( getFixedPropagatedStateSize( stateDerivativeModel ) )
+        {
+        case 6:
+            integrateEquationsWithFixedSizeState< 6, SimulationResults >(
+                        stateDerivativeModel, initialState, initialTime, integratorSettings, propagationTerminationCondition,
+                        propagationResults, dependentVariableFunction, processingSettings );
+            return true;
+        case 7:
+            integrateEquationsWithFixedSizeState< 7, SimulationResults >(
+                        stateDerivativeModel, initialState, initialTime, integratorSettings, propagationTerminationCondition,
+                        propagationResults, dependentVariableFunction, processingSettings );
+            return true;
+        default:
+            return false;
+        }
+    }
+
+private:
+
+    //! Function to numerically integrate the dynamics using a fixed-size state of given size (see integrateEquations).
+    template< int NumberOfRows, typename SimulationResults >
+    static void integrateEquationsWithFixedSizeState(
+            const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > stateDerivativeModel,
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialState,
+            const TimeType initialTime,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+            const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
+            const std::shared_ptr< SimulationResults > propagationResults,
+            const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
+            const std::shared_ptr< SingleArcPropagatorProcessingSettings > processingSettings )
+    {
+        typedef Eigen::Matrix< StateScalarType, NumberOfRows, 1 > FixedSizeStateType;
+
+        std::function< FixedSizeStateType( const TimeType, const FixedSizeStateType& ) > stateDerivativeFunction =
+                std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::template
+                           computeFixedSizeStateDerivative< NumberOfRows >,
+                           stateDerivativeModel, std::placeholders::_1, std::placeholders::_2 );
+
+        // No post-processing of state is required for dynamics that allows fixed-size state
+        propagators::integrateEquations< SimulationResults, FixedSizeStateType, TimeType >(
+                    stateDerivativeFunction, FixedSizeStateType( initialState ), initialTime, integratorSettings,
+                    propagationTerminationCondition, propagationResults, dependentVariableFunction,
+                    std::function< void( FixedSizeStateType& ) >( ), processingSettings );
+    }
+};
+
 //!Class for performing full numerical integration of a dynamical system in a single arc.
 /*!
  *  Class for performing full numerical integration of a dynamical system in a single arc, i.e. the equations of motion
@@ -739,6 +898,19 @@ public:
                 std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::computeStateDerivative,
                            dynamicsStateDerivative_, std::placeholders::_1, std::placeholders::_2 );
 
+        // Create recorded state derivative for Taylor series integrator from acceleration models, if not provided
+        createTaylorSeriesExpressionFromAccelerationModels( );
+
+        // Create object that measures the time spent in the various parts of the propagation, if requested
+        if( outputSettings_->getProfilePropagation( ) )
+        {
+            propagationProfiler_ = std::make_shared< utilities::TimingProfiler >( );
+            totalPropagationProfilerEntry_ = propagationProfiler_->addEntry( "propagation", "total" );
+            integratorOverheadProfilerEntry_ = propagationProfiler_->addEntry( "propagation", "integrator and output overhead" );
+            environmentUpdater_->setProfiler( propagationProfiler_ );
+            dynamicsStateDerivative_->setProfiler( propagationProfiler_ );
+        }
+
         // Create object that determines if the propagation is to be terminated
         propagationTerminationCondition_ = createPropagationTerminationConditions(
                     propagatorSettings_->getTerminationSettings( ), bodies_,
@@ -770,7 +942,8 @@ public:
                         propagatorSettings_->getDependentVariablesToSave( ), bodies_,
                         orderedDependentVariableSettings_,
                         dynamicsStateDerivative_->getStateDerivativeModels( ),
-                        predefinedStateDerivativeModels.stateDerivativePartials_ );
+                        predefinedStateDerivativeModels.stateDerivativePartials_,
+                        propagationProfiler_ );
             dependentVariablesFunctions_ = dependentVariableData.first;
             dependentVariableIds_ = dependentVariableData.second;
         }
@@ -785,9 +958,13 @@ public:
 
         propagationResults_= std::make_shared< SingleArcSimulationResults< StateScalarType, TimeType > >(
                     integratedStateAndBodyList, propagatorSettings_->getOutputSettingsWithCheck( ),
-                    std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::convertNumericalStateSolutionsToOutputSolutions,
+                    std::bind( static_cast< void( DynamicsStateDerivativeModel< TimeType, StateScalarType >::* )(
+                                   utilities::ContiguousStateHistory< TimeType, StateScalarType >&,
+                                   const utilities::ContiguousStateHistory< TimeType, StateScalarType >& ) >(
+                                   &DynamicsStateDerivativeModel< TimeType, StateScalarType >::convertNumericalStateSolutionsToOutputSolutions ),
                                dynamicsStateDerivative_,
                                std::placeholders::_1, std::placeholders::_2 ), dependentVariableInterface, sequentialPropagation_ ) ;
+        propagationResults_->setPropagationProfiler( propagationProfiler_ );
 
         // Integrate equations of motion if required.
         if( areEquationsOfMotionToBeIntegrated )
@@ -1031,6 +1208,20 @@ public:
         return dependentVariablesFunctions_;
     }
 
+    //! Function to retrieve the object containing the time spent in the various parts of the most recent propagation
+    /*!
+     * Function to retrieve the object containing the wall clock time spent in the various parts of the most recent
+     * propagation: the complete propagation and integrator/output overhead (category propagation), the parts of the state
+     * derivative computation (state_derivative), each environment update (environment_update), each acceleration
+     * (acceleration) and torque (torque) model, and each dependent variable (dependent_variable). Only created if requested
+     * by SingleArcPropagatorProcessingSettings::setProfilePropagation.
+     * \return Profiler of the propagation (nullptr if profiling is not requested)
+     */
+    std::shared_ptr< utilities::TimingProfiler > getPropagationProfiler( )
+    {
+        return propagationProfiler_;
+    }
+
     //! Function to reset the object that checks whether the simulation has finished from
     //! (newly defined) propagation settings.
     /*!
@@ -1056,9 +1247,17 @@ public:
         if( outputSettings_->getSetIntegratedResult( ) )
         {
             try {
+                // Retrieve dense output of integrator, if stored, and if the propagated state is the processed state
+                std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >
+                        denseOutputStateInterpolatorFunction;
+                if( sequentialPropagation_ && propagationResults_->isPropagatedAndProcessedStateEqual( ) )
+                {
+                    denseOutputStateInterpolatorFunction = propagationResults_->getDenseOutputStateInterpolatorFunction( );
+                }
+
                 // Create and set interpolators for ephemerides
                 resetIntegratedStates( propagationResults_->equationsOfMotionNumericalSolution_,
-                                       integratedStateProcessors_ );
+                                       integratedStateProcessors_, denseOutputStateInterpolatorFunction );
             }
             catch ( const std::exception &caughtException ) {
                 std::cerr
@@ -1130,7 +1329,7 @@ public:
      */
     const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getEquationsOfMotionNumericalSolution( )
     {
-        return propagationResults_->equationsOfMotionNumericalSolution_;
+        return propagationResults_->getEquationsOfMotionNumericalSolutionMap( );
     }
 
     //! Function to return the map of state history of numerically integrated bodies, in propagation coordinates.
@@ -1140,7 +1339,7 @@ public:
      */
     const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getEquationsOfMotionNumericalSolutionRaw( )
     {
-        return propagationResults_->equationsOfMotionNumericalSolutionRaw_;
+        return propagationResults_->getEquationsOfMotionNumericalSolutionRawMap( );
     }
 
     //! Function to return the map of dependent variable history that was saved during numerical propagation.
@@ -1150,7 +1349,7 @@ public:
      */
     const std::map< TimeType, Eigen::VectorXd >& getDependentVariableHistory( )
     {
-        return propagationResults_->dependentVariableHistory_;
+        return propagationResults_->getDependentVariableHistoryMap( );
     }
 
     //! Function to return the map of cumulative computation time history that was saved during numerical propagation.
@@ -1160,7 +1359,7 @@ public:
      */
     std::map< TimeType, double > getCumulativeComputationTimeHistory( )
     {
-        return propagationResults_->cumulativeComputationTimeHistory_;
+        return propagationResults_->getCumulativeComputationTimeHistoryMap( );
     }
 
     //! Function to return the map of number of cumulative function evaluations that was saved during numerical propagation.
@@ -1274,9 +1473,52 @@ protected:
     //! Boolean denoting whether the propagation is performing sequentially, or both forward and backward (default = true).
     bool sequentialPropagation_;
 
+    //! Object measuring the time spent in the various parts of the propagation (nullptr if profiling is not requested)
+    std::shared_ptr< utilities::TimingProfiler > propagationProfiler_;
+
+    //! Index of profiler entry for the complete propagation
+    int totalPropagationProfilerEntry_ = -1;
+
+    //! Index of profiler entry for the time spent outside the state derivative and dependent variable computations
+    int integratorOverheadProfilerEntry_ = -1;
+
 
 private:
 
+    //! Function to create the recorded state derivative of the Taylor series integrator from the acceleration models.
+    /*!
+     *  Function to create the recorded state derivative of the Taylor series integrator from the acceleration models of
+     *  the propagation (see createNBodyTaylorSeriesExpression), if the Taylor series integrator is used without a
+     *  recorded state derivative. This requires translational dynamics with the Cowell propagator, and an exception is
+     *  thrown otherwise. The integrator settings are copied before the expression is set, so that the settings provided
+     *  by the user are not modified.
+     */
+    void createTaylorSeriesExpressionFromAccelerationModels( )
+    {
+        std::shared_ptr< numerical_integrators::TaylorSeriesIntegratorSettings< TimeType > > taylorSeriesSettings =
+                std::dynamic_pointer_cast< numerical_integrators::TaylorSeriesIntegratorSettings< TimeType > >(
+                    integratorSettings_ );
+        if( taylorSeriesSettings != nullptr && taylorSeriesSettings->taylorSeriesExpression_ == nullptr )
+        {
+            std::shared_ptr< TranslationalStatePropagatorSettings< StateScalarType, TimeType > > translationalSettings =
+                    std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< StateScalarType, TimeType > >(
+                        propagatorSettings_ );
+            if( translationalSettings == nullptr || translationalSettings->propagator_ != cowell )
+            {
+                throw std::runtime_error( "Error in dynamics simulator, recorded state derivative for Taylor series "
+                                          "integrator can only be created automatically for translational dynamics with "
+                                          "the Cowell propagator." );
+            }
+
+            taylorSeriesSettings = std::dynamic_pointer_cast< numerical_integrators::TaylorSeriesIntegratorSettings< TimeType > >(
+                        taylorSeriesSettings->clone( ) );
+            taylorSeriesSettings->taylorSeriesExpression_ = createNBodyTaylorSeriesExpression(
+                        translationalSettings->getAccelerationsMap( ), translationalSettings->bodiesToIntegrate_,
+                        translationalSettings->centralBodies_ );
+            integratorSettings_ = taylorSeriesSettings;
+        }
+    }
+
     //! Function that propagates the dynamics and (if requested) variational equations.
     /*
     *  Function that propagates the dynamics and (if requested) variational equations. Whether the variational
@@ -1293,6 +1535,9 @@ private:
             const std::shared_ptr< SimulationResults > propagationResults,
             const std::function< void( Eigen::Matrix< StateScalarType, Eigen::Dynamic, SimulationResults::number_of_columns >& ) > statePostProcessingFunction )
     {
+        utilities::ScopedTimingMeasurement propagationTimingMeasurement(
+                    propagationProfiler_.get( ), totalPropagationProfilerEntry_ );
+
         // Integrate equations of motion numerically.
         simulation_setup::setAreBodiesInPropagation( bodies_, true );
         dynamicsStateDerivative_->updateStateDerivativeModelSettings( processedInitialState.block(
@@ -1300,16 +1545,29 @@ private:
 
         if ( sequentialPropagation_ )
         {
-            integrateEquations< SimulationResults, Eigen::Matrix< StateScalarType, Eigen::Dynamic, SimulationResults::number_of_columns >, TimeType >(
-                    stateDerivativeFunction_,
-                    processedInitialState ,
-                    propagatorSettings_->getInitialTime( ),
-                    integratorSettings_,
-                    propagationTerminationCondition_,
-                    propagationResults,
-                    dependentVariablesFunctions_,
-                    statePostProcessingFunction,
-                    propagatorSettings_->getOutputSettings( ) );
+            // Integrate with fixed-size state if possible (single-body Cowell propagation), dynamic-size state otherwise
+            if( !FixedSizeStateIntegrator< StateScalarType, TimeType, SimulationResults::number_of_columns >::template
+                    integrateEquations< SimulationResults >(
+                        dynamicsStateDerivative_,
+                        processedInitialState,
+                        propagatorSettings_->getInitialTime( ),
+                        integratorSettings_,
+                        propagationTerminationCondition_,
+                        propagationResults,
+                        dependentVariablesFunctions_,
+                        propagatorSettings_->getOutputSettings( ) ) )
+            {
+                integrateEquations< SimulationResults, Eigen::Matrix< StateScalarType, Eigen::Dynamic, SimulationResults::number_of_columns >, TimeType >(
+                        stateDerivativeFunction_,
+                        processedInitialState ,
+                        propagatorSettings_->getInitialTime( ),
+                        integratorSettings_,
+                        propagationTerminationCondition_,
+                        propagationResults,
+                        dependentVariablesFunctions_,
+                        statePostProcessingFunction,
+                        propagatorSettings_->getOutputSettings( ) );
+            }
         }
         else
         {
@@ -1364,6 +1622,10 @@ private:
 
         // Empty solution maps
         propagationResults->reset( );
+        if( propagationProfiler_ != nullptr )
+        {
+            propagationProfiler_->resetTimes( );
+        }
 
         PropagationPrintingInterface< SimulationResults, StateScalarType, TimeType >::printSingleArcPrePropagationMessages(
                 outputSettings_->getPrintSettings( ),
@@ -1385,6 +1647,23 @@ private:
     {
         // Retrieve number of cumulative function evaluations
         propagationResults->finalizePropagation( dynamicsStateDerivative_->getCumulativeNumberOfFunctionEvaluations( ) );
+
+        // Set time spent in integrator and output, from total time minus that of state derivatives and dependent variables
+        if( propagationProfiler_ != nullptr )
+        {
+            const std::vector< utilities::TimingProfileEntry >& profilerEntries = propagationProfiler_->getEntries( );
+            std::chrono::steady_clock::duration overheadTime = profilerEntries.at( totalPropagationProfilerEntry_ ).totalTime_;
+            for( unsigned int i = 0; i < profilerEntries.size( ); i++ )
+            {
+                if( profilerEntries.at( i ).category_ == "dependent_variable" ||
+                        ( profilerEntries.at( i ).category_ == "propagation" && profilerEntries.at( i ).name_ == "state derivative" ) )
+                {
+                    overheadTime -= profilerEntries.at( i ).totalTime_;
+                }
+            }
+            propagationProfiler_->setTime( integratorOverheadProfilerEntry_, 1, overheadTime );
+        }
+
         PropagationPrintingInterface< SimulationResults, StateScalarType, TimeType >::printSingleArcPostPropagationMessages(
                 outputSettings_->getPrintSettings( ),
                                                outputSettings_->getPropagationEndHeader( ),
@@ -1713,12 +1992,35 @@ public:
             std::vector<std::shared_ptr<SingleArcPropagatorSettings<StateScalarType, TimeType> > > singleArcSettings =
                     multiArcPropagatorSettings_->getSingleArcSettings( );
 
+            // Retrieve environment for each arc, and create thread pool if arcs are to be propagated concurrently
+            std::vector< simulation_setup::SystemOfBodies > arcWiseBodies;
+            if( multiArcPropagatorSettings_->getPropagateArcsConcurrently( ) )
+            {
+                arcWiseBodies = multiArcPropagatorSettings_->getArcWiseBodies( );
+
+                // Check propagated states (and create ephemerides, if needed) for environment in which results are set
+                for ( unsigned int i = 0; i < singleArcSettings.size( ); i++ )
+                {
+                    checkPropagatedStatesFeasibility( singleArcSettings.at( i ), bodies, true );
+                }
+
+                if( multiArcPropagatorSettings_->getNumberOfThreadsForArcPropagation( ) != 1 )
+                {
+                    threadPool_ = std::make_shared< utilities::ThreadPool >(
+                                multiArcPropagatorSettings_->getNumberOfThreadsForArcPropagation( ) );
+                }
+            }
+            else
+            {
+                arcWiseBodies = std::vector< simulation_setup::SystemOfBodies >( singleArcSettings.size( ), bodies );
+            }
+
             // Create dynamics simulators
             std::vector<std::shared_ptr<SingleArcSimulationResults<StateScalarType, TimeType> > > singleArcResults;
             for ( unsigned int i = 0; i < singleArcSettings.size( ); i++ ) {
                 singleArcDynamicsSimulators_.push_back(
                         std::make_shared<SingleArcDynamicsSimulator<StateScalarType, TimeType> >(
-                                bodies, singleArcSettings.at( i ), false, PredefinedSingleArcStateDerivativeModels< StateScalarType, TimeType >( ), true ) );
+                                arcWiseBodies.at( i ), singleArcSettings.at( i ), false, PredefinedSingleArcStateDerivativeModels< StateScalarType, TimeType >( ), true ) );
                 singleArcResults.push_back( singleArcDynamicsSimulators_.at( i )->getSingleArcPropagationResults( ));
                 singleArcDynamicsSimulators_.at( i )->createAndSetIntegratedStateProcessors( );
             }
@@ -1884,13 +2186,41 @@ public:
 
 
         // Propagate dynamics for each arc
-        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+        if( !multiArcPropagatorSettings_->getPropagateArcsConcurrently( ) )
         {
-            currentArcInitialState = getArcInitialState( i, initialStateProvider );
-            arcInitialStateList.push_back( currentArcInitialState );
+            for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+            {
+                currentArcInitialState = getArcInitialState( i, initialStateProvider );
+                arcInitialStateList.push_back( currentArcInitialState );
 
-            singleArcDynamicsSimulators_.at( i )->template integrateEquationsOfMotion<
-                    typename MultiArcSimulationResults::single_arc_type >( currentArcInitialState, propagationResults->getSingleArcResults( ).at( i ) );
+                singleArcDynamicsSimulators_.at( i )->template integrateEquationsOfMotion<
+                        typename MultiArcSimulationResults::single_arc_type >( currentArcInitialState, propagationResults->getSingleArcResults( ).at( i ) );
+            }
+        }
+        else
+        {
+            // Retrieve initial states of all arcs before propagation, which requires arcs to be independent
+            for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+            {
+                bool initialStateFromPreviousArc = false;
+                arcInitialStateList.push_back( initialStateProvider->getArcInitialState( i, initialStateFromPreviousArc ) );
+                if( initialStateFromPreviousArc )
+                {
+                    throw std::runtime_error( "Error when propagating arcs concurrently, initial state of arc " +
+                                              std::to_string( i ) + " is to be taken from previous arc" );
+                }
+            }
+
+            // Propagate arcs concurrently, each in its own environment; results are stored per arc, in order of the arcs
+            std::vector< std::shared_ptr< typename MultiArcSimulationResults::single_arc_type > > singleArcResults =
+                    propagationResults->getSingleArcResults( );
+            utilities::runTasks( threadPool_, singleArcDynamicsSimulators_.size( ),
+                                 [ & ]( const int arcIndex, const unsigned int )
+            {
+                singleArcDynamicsSimulators_.at( arcIndex )->template integrateEquationsOfMotion<
+                        typename MultiArcSimulationResults::single_arc_type >(
+                            arcInitialStateList.at( arcIndex ), singleArcResults.at( arcIndex ) );
+            } );
         }
 
         printPostPropagationMessages( );
@@ -2140,6 +2470,9 @@ protected:
 
     std::shared_ptr< MultiArcResults > propagationResults_;
 
+    //! Thread pool used to propagate arcs concurrently (nullptr if arcs are propagated serially).
+    std::shared_ptr< utilities::ThreadPool > threadPool_;
+
 };
 
 
@@ -2248,6 +2581,11 @@ public:
         {
             throw std::runtime_error( "Error when making HybridArcDynamicsSimulator, propagator settings are incompatible" );
         }
+        else if( hybridPropagatorSettings_->getMultiArcPropagatorSettings( )->getPropagateArcsConcurrently( ) )
+        {
+            throw std::runtime_error( "Error when making HybridArcDynamicsSimulator, concurrent propagation of arcs is not "
+                                      "supported for hybrid-arc dynamics" );
+        }
 
         singleArcDynamicsSize_ = hybridPropagatorSettings_->getSingleArcPropagatorSettings( )->getPropagatedStateSize( );
         multiArcDynamicsSize_ = hybridPropagatorSettings_->getMultiArcPropagatorSettings( )->getPropagatedStateSize( );
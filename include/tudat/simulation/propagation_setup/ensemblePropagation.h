@@ -0,0 +1,277 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_ENSEMBLEPROPAGATION_H
+#define TUDAT_ENSEMBLEPROPAGATION_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/threadPool.h"
+#include "tudat/simulation/environment_setup/body.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Class storing the (reduced) results of an ensemble of single-arc propagations.
+/*!
+ *  Class storing the (reduced) results of an ensemble of single-arc propagations, as produced by propagateSingleArcEnsemble.
+ *  For each run, the final time, final (conventional) state, final dependent variables and termination reason are stored.
+ *  The final states and dependent variables are stored contiguously, with one column per run, and are allocated once before
+ *  the ensemble is distributed over the threads.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class SingleArcEnsembleResults
+{
+public:
+
+    //! Constructor, allocates the output for all runs.
+    /*!
+     *  Constructor, allocates the output for all runs.
+     *  \param numberOfRuns Number of runs in the ensemble.
+     *  \param stateSize Size of the (conventional) propagated state.
+     *  \param dependentVariableSize Size of the dependent variable vector.
+     */
+    SingleArcEnsembleResults( const int numberOfRuns,
+                              const int stateSize,
+                              const int dependentVariableSize ):
+        finalTimes_( numberOfRuns, TUDAT_NAN ),
+        finalStates_( Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >::Constant(
+                          stateSize, numberOfRuns, TUDAT_NAN ) ),
+        finalDependentVariables_( Eigen::MatrixXd::Constant( dependentVariableSize, numberOfRuns, TUDAT_NAN ) ),
+        terminationReasons_( numberOfRuns ){ }
+
+    //! Function to store the results of a single run.
+    /*!
+     *  Function to store the results of a single run. May be called concurrently for different run indices.
+     *  \param runIndex Index of the run for which the results are to be stored.
+     *  \param runResults Results of the propagation of the run.
+     *  \param initialTime Initial time of the propagation of the run.
+     */
+    void setRunResults( const int runIndex,
+                        const std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > runResults,
+                        const TimeType initialTime )
+    {
+        const typename SingleArcSimulationResults< StateScalarType, TimeType >::StateHistoryType& stateHistory =
+                runResults->getContiguousEquationsOfMotionNumericalSolution( );
+        if( stateHistory.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error when saving results of ensemble run " + std::to_string( runIndex ) +
+                                      ", state history is empty" );
+        }
+        else if( stateHistory.getNumberOfRows( ) != finalStates_.rows( ) )
+        {
+            throw std::runtime_error( "Error when saving results of ensemble run " + std::to_string( runIndex ) +
+                                      ", state size is inconsistent with that of first run" );
+        }
+
+        // Histories are sorted by time; select final entry depending on propagation direction
+        unsigned int finalIndex = ( stateHistory.getTime( 0 ) == initialTime ) ? stateHistory.size( ) - 1 : 0;
+
+        finalTimes_[ runIndex ] = stateHistory.getTime( finalIndex );
+        finalStates_.col( runIndex ) = stateHistory.getEntry( finalIndex );
+
+        if( finalDependentVariables_.rows( ) > 0 )
+        {
+            const typename SingleArcSimulationResults< StateScalarType, TimeType >::DependentVariableHistoryType&
+                    dependentVariableHistory = runResults->getContiguousDependentVariableHistory( );
+            if( dependentVariableHistory.size( ) != stateHistory.size( ) ||
+                    dependentVariableHistory.getNumberOfRows( ) != finalDependentVariables_.rows( ) )
+            {
+                throw std::runtime_error( "Error when saving results of ensemble run " + std::to_string( runIndex ) +
+                                          ", dependent variable history is inconsistent" );
+            }
+            finalDependentVariables_.col( runIndex ) = dependentVariableHistory.getEntry( finalIndex );
+        }
+
+        terminationReasons_[ runIndex ] = runResults->getPropagationTerminationReason( );
+    }
+
+    //! Function to retrieve the number of runs in the ensemble.
+    int getNumberOfRuns( ) const
+    {
+        return static_cast< int >( finalTimes_.size( ) );
+    }
+
+    //! Function to retrieve the final time of each run.
+    const std::vector< TimeType >& getFinalTimes( ) const
+    {
+        return finalTimes_;
+    }
+
+    //! Function to retrieve the final (conventional) state of each run (one column per run).
+    const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& getFinalStates( ) const
+    {
+        return finalStates_;
+    }
+
+    //! Function to retrieve the final dependent variables of each run (one column per run).
+    const Eigen::MatrixXd& getFinalDependentVariables( ) const
+    {
+        return finalDependentVariables_;
+    }
+
+    //! Function to retrieve the termination reason of each run.
+    const std::vector< std::shared_ptr< PropagationTerminationDetails > >& getTerminationReasons( ) const
+    {
+        return terminationReasons_;
+    }
+
+    //! Function to retrieve whether a given run terminated on its termination condition.
+    bool integrationCompletedSuccessfully( const int runIndex ) const
+    {
+        return ( terminationReasons_.at( runIndex ) != nullptr &&
+                 terminationReasons_.at( runIndex )->getPropagationTerminationReason( ) == termination_condition_reached );
+    }
+
+private:
+
+    //! Final time of each run.
+    std::vector< TimeType > finalTimes_;
+
+    //! Final (conventional) state of each run (one column per run).
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > finalStates_;
+
+    //! Final dependent variables of each run (one column per run).
+    Eigen::MatrixXd finalDependentVariables_;
+
+    //! Termination reason of each run.
+    std::vector< std::shared_ptr< PropagationTerminationDetails > > terminationReasons_;
+};
+
+//! Function to propagate an ensemble of single-arc dynamics (e.g. for a Monte Carlo analysis) over a thread pool.
+/*!
+ *  Function to propagate an ensemble of single-arc dynamics (e.g. for a Monte Carlo analysis) over a thread pool. Since the
+ *  environment models store their current state, a SystemOfBodies cannot be shared between concurrent propagations. Instead,
+ *  the bodyCreationFunction is called once for each thread of the pool (serially, on the calling thread) to create an
+ *  independent set of bodies. Each run is then propagated using the bodies of the thread on which it is executed, with
+ *  propagation settings created by propagatorSettingsFunction from these bodies. The bodies of a thread are reused for all
+ *  runs on that thread, so the propagatorSettingsFunction must (re)set any run-specific environment property (e.g. a dispersed
+ *  gravitational parameter) itself.
+ *
+ *  The first run is propagated before the others, to determine the sizes of the (preallocated) output. The remaining runs are
+ *  distributed dynamically over the threads. For each run, the final time, state, dependent variables and termination reason
+ *  are stored in the returned object. Additional (e.g. full history) output may be extracted by the resultsProcessingFunction,
+ *  which is called on the thread executing the run, directly after its propagation.
+ *  \param bodyCreationFunction Function creating a new, independent, set of bodies.
+ *  \param propagatorSettingsFunction Function creating the propagation settings for a given run index, from a given set of
+ *  bodies (which may be modified by this function).
+ *  \param numberOfRuns Number of runs in the ensemble.
+ *  \param threadPool Thread pool over which the runs are distributed (runs are executed serially if nullptr).
+ *  \param resultsProcessingFunction Function called with the full results of each run, after its propagation (may be empty).
+ *  Must be safe to call concurrently for different run indices.
+ *  \return Final time, state, dependent variables and termination reason of all runs.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::shared_ptr< SingleArcEnsembleResults< StateScalarType, TimeType > > propagateSingleArcEnsemble(
+        const std::function< simulation_setup::SystemOfBodies( ) > bodyCreationFunction,
+        const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+            const int, const simulation_setup::SystemOfBodies& ) > propagatorSettingsFunction,
+        const int numberOfRuns,
+        const std::shared_ptr< utilities::ThreadPool > threadPool,
+        const std::function< void( const int, const std::shared_ptr<
+                                   SingleArcSimulationResults< StateScalarType, TimeType > > ) > resultsProcessingFunction =
+        std::function< void( const int, const std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > ) >( ) )
+{
+    if( numberOfRuns < 1 )
+    {
+        throw std::runtime_error( "Error when propagating ensemble, at least one run is required" );
+    }
+
+    // Create independent set of bodies for each thread
+    unsigned int numberOfThreads = ( threadPool == nullptr ) ? 1 : threadPool->getNumberOfThreads( );
+    std::vector< simulation_setup::SystemOfBodies > perThreadBodies;
+    for( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        perThreadBodies.push_back( bodyCreationFunction( ) );
+    }
+
+    // Function to propagate a single run, and retrieve its results
+    std::shared_ptr< SingleArcEnsembleResults< StateScalarType, TimeType > > ensembleResults;
+    auto propagateRun = [ & ]( const int runIndex, const unsigned int threadIndex )
+    {
+        std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > > propagatorSettings =
+                propagatorSettingsFunction( runIndex, perThreadBodies.at( threadIndex ) );
+        SingleArcDynamicsSimulator< StateScalarType, TimeType > dynamicsSimulator(
+                    perThreadBodies.at( threadIndex ), propagatorSettings );
+        std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > runResults =
+                dynamicsSimulator.getSingleArcPropagationResults( );
+
+        // Allocate output from first run
+        if( ensembleResults == nullptr )
+        {
+            const typename SingleArcSimulationResults< StateScalarType, TimeType >::DependentVariableHistoryType&
+                    dependentVariableHistory = runResults->getContiguousDependentVariableHistory( );
+            ensembleResults = std::make_shared< SingleArcEnsembleResults< StateScalarType, TimeType > >(
+                        numberOfRuns, runResults->getContiguousEquationsOfMotionNumericalSolution( ).getNumberOfRows( ),
+                        ( dependentVariableHistory.size( ) > 0 ) ? dependentVariableHistory.getNumberOfRows( ) : 0 );
+        }
+
+        ensembleResults->setRunResults( runIndex, runResults, propagatorSettings->getInitialTime( ) );
+        if( resultsProcessingFunction != nullptr )
+        {
+            resultsProcessingFunction( runIndex, runResults );
+        }
+    };
+
+    // Propagate first run to determine output size, and distribute remaining runs over threads
+    propagateRun( 0, 0 );
+    utilities::runTasks( threadPool, numberOfRuns - 1, [ & ]( const int taskIndex, const unsigned int threadIndex )
+    {
+        propagateRun( taskIndex + 1, threadIndex );
+    } );
+
+    return ensembleResults;
+}
+
+//! Function to propagate an ensemble of single-arc dynamics (e.g. for a Monte Carlo analysis) over a given number of threads.
+/*!
+ *  Function to propagate an ensemble of single-arc dynamics (e.g. for a Monte Carlo analysis) over a given number of threads,
+ *  creating a thread pool for the purpose (see overload taking a thread pool for details).
+ *  \param bodyCreationFunction Function creating a new, independent, set of bodies.
+ *  \param propagatorSettingsFunction Function creating the propagation settings for a given run index, from a given set of
+ *  bodies.
+ *  \param numberOfRuns Number of runs in the ensemble.
+ *  \param numberOfThreads Number of threads over which the runs are distributed (0 to use all available hardware threads).
+ *  \param resultsProcessingFunction Function called with the full results of each run, after its propagation (may be empty).
+ *  \return Final time, state, dependent variables and termination reason of all runs.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::shared_ptr< SingleArcEnsembleResults< StateScalarType, TimeType > > propagateSingleArcEnsemble(
+        const std::function< simulation_setup::SystemOfBodies( ) > bodyCreationFunction,
+        const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+            const int, const simulation_setup::SystemOfBodies& ) > propagatorSettingsFunction,
+        const int numberOfRuns,
+        const unsigned int numberOfThreads = 0,
+        const std::function< void( const int, const std::shared_ptr<
+                                   SingleArcSimulationResults< StateScalarType, TimeType > > ) > resultsProcessingFunction =
+        std::function< void( const int, const std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > ) >( ) )
+{
+    std::shared_ptr< utilities::ThreadPool > threadPool;
+    if( numberOfThreads != 1 )
+    {
+        threadPool = std::make_shared< utilities::ThreadPool >( numberOfThreads );
+    }
+    return propagateSingleArcEnsemble< StateScalarType, TimeType >(
+                bodyCreationFunction, propagatorSettingsFunction, numberOfRuns, threadPool, resultsProcessingFunction );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_ENSEMBLEPROPAGATION_H
@@ -23,6 +23,7 @@
 #include <boost/tuple/tuple_comparison.hpp>
 #include <boost/tuple/tuple_io.hpp>
 
+#include "tudat/basics/timingProfiler.h"
 #include "tudat/simulation/environment_setup/body.h"
 #include "tudat/astro/gravitation/timeDependentSphericalHarmonicsGravityField.h"
 #include "tudat/simulation/propagation_setup/propagationSettings.h"
@@ -113,17 +114,56 @@ public:
             resetFunctionVector_.at( i ).template get< 2 >( )( );
         }
 
-        // Set integrated state variables in environment.
-        setIntegratedStatesInEnvironment( integratedStatesToSet );
+        {
+            utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), integratedStatesProfilerEntry_ );
+
+            // Set integrated state variables in environment.
+            setIntegratedStatesInEnvironment( integratedStatesToSet );
 
-        // Set current state from environment for override settings setIntegratedStatesFromEnvironment
-        setStatesFromEnvironment( setIntegratedStatesFromEnvironment, currentTime );
+            // Set current state from environment for override settings setIntegratedStatesFromEnvironment
+            setStatesFromEnvironment( setIntegratedStatesFromEnvironment, currentTime );
+        }
 
         // Evaluate time-dependent update functions (dependent variables of state and time)
         // determined by setUpdateFunctions
-        for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+        if( profiler_ == nullptr )
+        {
+            for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+            {
+                updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+            }
+        }
+        else
         {
-            updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+            for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+            {
+                utilities::ScopedTimingMeasurement timingMeasurement( profiler_.get( ), updateFunctionProfilerEntries_[ i ] );
+                updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+            }
+        }
+    }
+
+    //! Function to set the profiler used to time the individual environment updates.
+    /*!
+     * Function to set the profiler used to time the individual environment updates. An entry (in category
+     * environment_update) is added to the profiler for each update function, and for setting the integrated states in the
+     * environment.
+     * \param profiler Profiler used to time the environment updates (no timing if nullptr).
+     */
+    void setProfiler( const std::shared_ptr< utilities::TimingProfiler > profiler )
+    {
+        profiler_ = profiler;
+        updateFunctionProfilerEntries_.clear( );
+        if( profiler_ != nullptr )
+        {
+            integratedStatesProfilerEntry_ = profiler_->addEntry( "environment_update", "integrated states" );
+            for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+            {
+                updateFunctionProfilerEntries_.push_back(
+                            profiler_->addEntry( "environment_update",
+                                                 getEnvironmentModelUpdateName( updateFunctionVector_.at( i ).template get< 0 >( ) ) +
+                                                 " of " + updateFunctionVector_.at( i ).template get< 1 >( ) ) );
+            }
         }
     }
 
@@ -161,7 +201,7 @@ private:
             }
             case rotational_state:
             {
-                std::vector< std::tuple< std::string, std::string, PropagatorType > > bodiesWithIntegratedStates =
+                const std::vector< std::tuple< std::string, std::string, PropagatorType > >& bodiesWithIntegratedStates =
                         integratedStates_.at( rotational_state );
                 for( unsigned int i = 0; i < bodiesWithIntegratedStates.size( ); i++ )
                 {
@@ -173,7 +213,7 @@ private:
             case body_mass_state:
             {
                 // Set mass for bodies provided as input.
-                std::vector< std::tuple< std::string, std::string, PropagatorType > > bodiesWithIntegratedMass =
+                const std::vector< std::tuple< std::string, std::string, PropagatorType > >& bodiesWithIntegratedMass =
                         integratedStates_.at( body_mass_state );
 
                 for( unsigned int i = 0; i < bodiesWithIntegratedMass.size( ); i++ )
@@ -854,6 +894,15 @@ private:
     //! time step).
     std::vector< boost::tuple< EnvironmentModelsToUpdate, std::string, std::function< void( ) > > > resetFunctionVector_;
 
+    //! Profiler used to time the environment updates (nullptr if no timing is performed).
+    std::shared_ptr< utilities::TimingProfiler > profiler_;
+
+    //! Index of profiler entry for each entry of updateFunctionVector_.
+    std::vector< int > updateFunctionProfilerEntries_;
+
+    //! Index of profiler entry for setting the integrated states in the environment.
+    int integratedStatesProfilerEntry_ = -1;
+
 
 
 
@@ -0,0 +1,581 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Lions, J.-L., Maday, Y. and Turinici, G., A "parareal" in time discretization of PDE's, Comptes Rendus de
+ *          l'Academie des Sciences, Series I, Mathematics, 332(7), 661-668, 2001.
+ *      Gander, M.J. and Vandewalle, S., Analysis of the parareal time-parallel time-integration method, SIAM Journal on
+ *          Scientific Computing, 29(2), 556-578, 2007.
+ */
+
+#ifndef TUDAT_PARAREALPROPAGATION_H
+#define TUDAT_PARAREALPROPAGATION_H
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/basics/threadPool.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+#include "tudat/simulation/environment_setup/body.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Class storing the results of a parallel-in-time (Parareal) propagation.
+/*!
+ *  Class storing the results of a parallel-in-time (Parareal) propagation, as produced by performPararealIterations or
+ *  propagateSingleArcParareal. The propagation interval is divided into a number of slices, on which the fine propagator
+ *  is started from the initial states stored here. In addition to the slice boundaries, the boundary defect of each
+ *  iteration and the wall clock times of the propagation are stored, from which the speedup w.r.t. a serial propagation
+ *  with the fine propagator is obtained.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class PararealPropagationResults
+{
+public:
+
+    //! Typedef for the state vector.
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > StateType;
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param sliceBoundaryTimes Times at the boundaries of the slices (number of slices + 1 entries).
+     *  \param sliceInitialStates Initial states of the (last) fine propagation of each slice (one column per slice).
+     *  \param finalState State at the end of the (last) fine propagation of the final slice.
+     *  \param iterationBoundaryDefects Maximum boundary defect for each iteration.
+     *  \param isConverged Boolean denoting whether the boundary defect has converged to the required tolerance.
+     *  \param fineSliceWallClockTimes Wall clock time [s] of the (last) fine propagation of each slice.
+     *  \param pararealWallClockTime Wall clock time [s] of the complete Parareal propagation.
+     */
+    PararealPropagationResults( const std::vector< TimeType >& sliceBoundaryTimes,
+                                const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& sliceInitialStates,
+                                const StateType& finalState,
+                                const std::vector< double >& iterationBoundaryDefects,
+                                const bool isConverged,
+                                const std::vector< double >& fineSliceWallClockTimes,
+                                const double pararealWallClockTime ):
+        sliceBoundaryTimes_( sliceBoundaryTimes ), sliceInitialStates_( sliceInitialStates ), finalState_( finalState ),
+        iterationBoundaryDefects_( iterationBoundaryDefects ), isConverged_( isConverged ),
+        fineSliceWallClockTimes_( fineSliceWallClockTimes ), pararealWallClockTime_( pararealWallClockTime ),
+        serialReferenceWallClockTime_( TUDAT_NAN ){ }
+
+    //! Function to retrieve the number of time slices.
+    int getNumberOfSlices( ) const
+    {
+        return static_cast< int >( sliceInitialStates_.cols( ) );
+    }
+
+    //! Function to retrieve the times at the boundaries of the slices (number of slices + 1 entries).
+    const std::vector< TimeType >& getSliceBoundaryTimes( ) const
+    {
+        return sliceBoundaryTimes_;
+    }
+
+    //! Function to retrieve the initial states of the (last) fine propagation of each slice (one column per slice).
+    const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& getSliceInitialStates( ) const
+    {
+        return sliceInitialStates_;
+    }
+
+    //! Function to retrieve the state at the end of the propagation (from the fine propagation of the final slice).
+    const StateType& getFinalState( ) const
+    {
+        return finalState_;
+    }
+
+    //! Function to retrieve the number of Parareal iterations (number of fine propagation sweeps) that was performed.
+    int getNumberOfIterations( ) const
+    {
+        return static_cast< int >( iterationBoundaryDefects_.size( ) );
+    }
+
+    //! Function to retrieve the maximum boundary defect (difference between the final state of the fine propagation of a
+    //! slice and the initial state of the next slice) for each iteration.
+    const std::vector< double >& getIterationBoundaryDefects( ) const
+    {
+        return iterationBoundaryDefects_;
+    }
+
+    //! Function to retrieve whether the boundary defect has converged to the required tolerance.
+    bool isConverged( ) const
+    {
+        return isConverged_;
+    }
+
+    //! Function to retrieve the wall clock time [s] of the (last) fine propagation of each slice.
+    const std::vector< double >& getFineSliceWallClockTimes( ) const
+    {
+        return fineSliceWallClockTimes_;
+    }
+
+    //! Function to retrieve the wall clock time [s] of the complete Parareal propagation.
+    double getPararealWallClockTime( ) const
+    {
+        return pararealWallClockTime_;
+    }
+
+    //! Function to retrieve the wall clock time [s] of the serial propagation with the fine propagator.
+    /*!
+     *  Function to retrieve the wall clock time [s] of the serial propagation with the fine propagator. If the serial
+     *  reference propagation was performed, its wall clock time is returned. Otherwise, it is estimated as the sum of the
+     *  wall clock times of the fine propagation of the slices.
+     *  \return Wall clock time [s] of the serial propagation with the fine propagator.
+     */
+    double getSerialWallClockTime( ) const
+    {
+        return isSerialReferenceAvailable( ) ? serialReferenceWallClockTime_ :
+                                               std::accumulate( fineSliceWallClockTimes_.begin( ),
+                                                                fineSliceWallClockTimes_.end( ), 0.0 );
+    }
+
+    //! Function to retrieve the speedup of the Parareal propagation w.r.t. the serial propagation with the fine propagator.
+    double getSpeedup( ) const
+    {
+        return getSerialWallClockTime( ) / pararealWallClockTime_;
+    }
+
+    //! Function to set the results of the serial reference propagation with the fine propagator.
+    /*!
+     *  Function to set the results of the serial reference propagation with the fine propagator.
+     *  \param serialReferenceFinalState Final state of the serial reference propagation.
+     *  \param serialReferenceWallClockTime Wall clock time [s] of the serial reference propagation.
+     */
+    void setSerialReference( const StateType& serialReferenceFinalState,
+                             const double serialReferenceWallClockTime )
+    {
+        serialReferenceFinalState_ = serialReferenceFinalState;
+        serialReferenceWallClockTime_ = serialReferenceWallClockTime;
+    }
+
+    //! Function to retrieve whether the serial reference propagation was performed.
+    bool isSerialReferenceAvailable( ) const
+    {
+        return !std::isnan( serialReferenceWallClockTime_ );
+    }
+
+    //! Function to retrieve the final state of the serial reference propagation (empty if not performed).
+    const StateType& getSerialReferenceFinalState( ) const
+    {
+        return serialReferenceFinalState_;
+    }
+
+    //! Function to set the full results of the (last) fine propagation of each slice.
+    void setFineSliceResults(
+            const std::vector< std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > >& fineSliceResults )
+    {
+        fineSliceResults_ = fineSliceResults;
+    }
+
+    //! Function to retrieve the full results of the (last) fine propagation of each slice (empty if not set).
+    const std::vector< std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > >& getFineSliceResults( ) const
+    {
+        return fineSliceResults_;
+    }
+
+private:
+
+    //! Times at the boundaries of the slices (number of slices + 1 entries).
+    std::vector< TimeType > sliceBoundaryTimes_;
+
+    //! Initial states of the (last) fine propagation of each slice (one column per slice).
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > sliceInitialStates_;
+
+    //! State at the end of the (last) fine propagation of the final slice.
+    StateType finalState_;
+
+    //! Maximum boundary defect for each iteration.
+    std::vector< double > iterationBoundaryDefects_;
+
+    //! Boolean denoting whether the boundary defect has converged to the required tolerance.
+    bool isConverged_;
+
+    //! Wall clock time [s] of the (last) fine propagation of each slice.
+    std::vector< double > fineSliceWallClockTimes_;
+
+    //! Wall clock time [s] of the complete Parareal propagation.
+    double pararealWallClockTime_;
+
+    //! Final state of the serial reference propagation (empty if not performed).
+    StateType serialReferenceFinalState_;
+
+    //! Wall clock time [s] of the serial reference propagation (NaN if not performed).
+    double serialReferenceWallClockTime_;
+
+    //! Full results of the (last) fine propagation of each slice (empty if not set).
+    std::vector< std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > > fineSliceResults_;
+};
+
+//! Function to perform a parallel-in-time (Parareal) propagation, using given coarse and fine propagation functions.
+/*!
+ *  Function to perform a parallel-in-time (Parareal) propagation, using given coarse and fine propagation functions. The
+ *  propagation interval is divided into numberOfSlices slices of equal length. First, the initial states of the slices are
+ *  obtained from a (serial) propagation with the cheap coarse propagator. Then, in each iteration:
+ *
+ *   - The fine propagator is used to propagate each slice from its current initial state, with the slices distributed over
+ *     the thread pool.
+ *   - The maximum boundary defect, i.e. the difference between the final state of the fine propagation of a slice and the
+ *     initial state of the next slice (infinity norm), is computed. If it is below the tolerance, the iterations are
+ *     stopped.
+ *   - The initial states are updated (serially) by the Parareal correction U_k+1 = G( U_k ) + F( U_k^old ) - G( U_k^old ),
+ *     with F and G the fine and coarse propagators.
+ *
+ *  After iteration j, the initial states of the first j + 1 slices are identical to those of a serial fine propagation, so
+ *  these slices are not propagated again, and the iterations terminate after at most numberOfSlices iterations. The
+ *  speedup w.r.t. a serial fine propagation is therefore only obtained if convergence occurs in (considerably) fewer
+ *  iterations, which requires the coarse propagator to be sufficiently accurate.
+ *  \param finePropagationFunction Function propagating a slice with the fine propagator, with as input the index of the
+ *  slice (-1 for the serial reference propagation), the index of the thread on which it is called, the initial time, the
+ *  initial state and the final time, returning the final state. Must be safe to call concurrently for different threads.
+ *  \param coarsePropagationFunction Function propagating a slice with the coarse propagator, with as input the index of
+ *  the slice, the initial time, the initial state and the final time, returning the final state. Called serially, on the
+ *  calling thread.
+ *  \param initialState Initial state of the propagation.
+ *  \param initialTime Initial time of the propagation.
+ *  \param finalTime Final time of the propagation.
+ *  \param numberOfSlices Number of slices into which the propagation interval is divided (typically a small multiple of
+ *  the number of threads).
+ *  \param boundaryDefectTolerance Tolerance on the maximum boundary defect (in units of the state entries).
+ *  \param maximumNumberOfIterations Maximum number of Parareal iterations (fine propagation sweeps).
+ *  \param threadPool Thread pool over which the fine propagation of the slices is distributed (serial if nullptr).
+ *  \param computeSerialReference Boolean denoting whether a serial propagation with the fine propagator is to be performed
+ *  (after the Parareal propagation), to determine the actual speedup and the error of the Parareal propagation.
+ *  \return Results of the Parareal propagation.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::shared_ptr< PararealPropagationResults< StateScalarType, TimeType > > performPararealIterations(
+        const std::function< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >(
+            const int, const unsigned int, const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+            const TimeType ) > finePropagationFunction,
+        const std::function< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >(
+            const int, const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+            const TimeType ) > coarsePropagationFunction,
+        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialState,
+        const TimeType initialTime,
+        const TimeType finalTime,
+        const int numberOfSlices,
+        const double boundaryDefectTolerance,
+        const int maximumNumberOfIterations,
+        const std::shared_ptr< utilities::ThreadPool > threadPool,
+        const bool computeSerialReference = false )
+{
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > StateType;
+
+    if( numberOfSlices < 1 )
+    {
+        throw std::runtime_error( "Error in Parareal propagation, at least one slice is required" );
+    }
+    else if( maximumNumberOfIterations < 1 )
+    {
+        throw std::runtime_error( "Error in Parareal propagation, at least one iteration is required" );
+    }
+    else if( !( boundaryDefectTolerance >= 0.0 ) )
+    {
+        throw std::runtime_error( "Error in Parareal propagation, boundary defect tolerance must be non-negative" );
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+
+    // Set times at slice boundaries
+    std::vector< TimeType > sliceBoundaryTimes( numberOfSlices + 1 );
+    for( int k = 0; k < numberOfSlices; k++ )
+    {
+        sliceBoundaryTimes[ k ] = initialTime + ( finalTime - initialTime ) *
+                static_cast< double >( k ) / static_cast< double >( numberOfSlices );
+    }
+    sliceBoundaryTimes[ numberOfSlices ] = finalTime;
+
+    // Compute initial states of slices with coarse propagator
+    std::vector< StateType > sliceInitialStates( numberOfSlices );
+    std::vector< StateType > coarseFinalStates( numberOfSlices );
+    sliceInitialStates[ 0 ] = initialState;
+    for( int k = 0; k < numberOfSlices; k++ )
+    {
+        coarseFinalStates[ k ] = coarsePropagationFunction(
+                    k, sliceBoundaryTimes[ k ], sliceInitialStates[ k ], sliceBoundaryTimes[ k + 1 ] );
+        if( k < numberOfSlices - 1 )
+        {
+            sliceInitialStates[ k + 1 ] = coarseFinalStates[ k ];
+        }
+    }
+
+    std::vector< StateType > fineFinalStates( numberOfSlices );
+    std::vector< double > fineSliceWallClockTimes( numberOfSlices, TUDAT_NAN );
+    std::vector< double > iterationBoundaryDefects;
+    bool isConverged = false;
+
+    // Index of first slice for which the initial state is not yet identical to that of the serial fine propagation
+    int firstUnconvergedSlice = 0;
+    while( static_cast< int >( iterationBoundaryDefects.size( ) ) < maximumNumberOfIterations )
+    {
+        // Propagate all unconverged slices with fine propagator, in parallel
+        utilities::runTasks(
+                    threadPool, numberOfSlices - firstUnconvergedSlice,
+                    [ & ]( const int taskIndex, const unsigned int threadIndex )
+        {
+            const int k = firstUnconvergedSlice + taskIndex;
+            std::chrono::steady_clock::time_point sliceStartTime = std::chrono::steady_clock::now( );
+            fineFinalStates[ k ] = finePropagationFunction(
+                        k, threadIndex, sliceBoundaryTimes[ k ], sliceInitialStates[ k ], sliceBoundaryTimes[ k + 1 ] );
+            fineSliceWallClockTimes[ k ] = std::chrono::duration< double >(
+                        std::chrono::steady_clock::now( ) - sliceStartTime ).count( );
+        } );
+
+        // Compute maximum defect between fine propagation and initial state of next slice
+        double maximumBoundaryDefect = 0.0;
+        for( int k = firstUnconvergedSlice; k < numberOfSlices - 1; k++ )
+        {
+            maximumBoundaryDefect = std::max(
+                        maximumBoundaryDefect,
+                        static_cast< double >( ( fineFinalStates[ k ] - sliceInitialStates[ k + 1 ] ).cwiseAbs( ).maxCoeff( ) ) );
+        }
+        iterationBoundaryDefects.push_back( maximumBoundaryDefect );
+        if( maximumBoundaryDefect <= boundaryDefectTolerance )
+        {
+            isConverged = true;
+            break;
+        }
+
+        // Update initial states with Parareal correction; initial state of first unconverged slice is unchanged, so that its
+        // coarse propagation need not be repeated.
+        if( firstUnconvergedSlice < numberOfSlices - 1 )
+        {
+            sliceInitialStates[ firstUnconvergedSlice + 1 ] = fineFinalStates[ firstUnconvergedSlice ];
+        }
+        for( int k = firstUnconvergedSlice + 1; k < numberOfSlices; k++ )
+        {
+            StateType newCoarseFinalState = coarsePropagationFunction(
+                        k, sliceBoundaryTimes[ k ], sliceInitialStates[ k ], sliceBoundaryTimes[ k + 1 ] );
+            if( k < numberOfSlices - 1 )
+            {
+                sliceInitialStates[ k + 1 ] = newCoarseFinalState + fineFinalStates[ k ] - coarseFinalStates[ k ];
+            }
+            coarseFinalStates[ k ] = newCoarseFinalState;
+        }
+        firstUnconvergedSlice++;
+    }
+
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > sliceInitialStatesMatrix(
+                initialState.rows( ), numberOfSlices );
+    for( int k = 0; k < numberOfSlices; k++ )
+    {
+        sliceInitialStatesMatrix.col( k ) = sliceInitialStates[ k ];
+    }
+
+    std::shared_ptr< PararealPropagationResults< StateScalarType, TimeType > > pararealResults =
+            std::make_shared< PararealPropagationResults< StateScalarType, TimeType > >(
+                sliceBoundaryTimes, sliceInitialStatesMatrix, fineFinalStates[ numberOfSlices - 1 ],
+                iterationBoundaryDefects, isConverged, fineSliceWallClockTimes,
+                std::chrono::duration< double >( std::chrono::steady_clock::now( ) - startTime ).count( ) );
+
+    // Propagate full interval serially with fine propagator, for comparison
+    if( computeSerialReference )
+    {
+        std::chrono::steady_clock::time_point referenceStartTime = std::chrono::steady_clock::now( );
+        StateType serialReferenceFinalState = finePropagationFunction( -1, 0, initialTime, initialState, finalTime );
+        pararealResults->setSerialReference(
+                    serialReferenceFinalState,
+                    std::chrono::duration< double >( std::chrono::steady_clock::now( ) - referenceStartTime ).count( ) );
+    }
+
+    return pararealResults;
+}
+
+//! Function to retrieve the final (conventional) state of a single-arc propagation, checking that it ended at a given time.
+/*!
+ *  Function to retrieve the final (conventional) state of a single-arc propagation, checking that the propagation
+ *  terminated successfully at a given time (to within rounding errors).
+ *  \param propagationResults Results of the propagation.
+ *  \param initialTime Initial time of the propagation.
+ *  \param finalTime Time at which the propagation must have ended.
+ *  \return Final (conventional) state of the propagation.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getFinalStateAtTime(
+        const std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > propagationResults,
+        const TimeType initialTime,
+        const TimeType finalTime )
+{
+    const typename SingleArcSimulationResults< StateScalarType, TimeType >::StateHistoryType& stateHistory =
+            propagationResults->getContiguousEquationsOfMotionNumericalSolution( );
+    if( stateHistory.size( ) == 0 || !propagationResults->integrationCompletedSuccessfully( ) )
+    {
+        throw std::runtime_error( "Error when retrieving final state of propagation, propagation did not complete successfully" );
+    }
+
+    // Histories are sorted by time; select final entry depending on propagation direction
+    unsigned int finalIndex = ( stateHistory.getTime( 0 ) == initialTime ) ? stateHistory.size( ) - 1 : 0;
+    if( std::fabs( static_cast< double >( stateHistory.getTime( finalIndex ) - finalTime ) ) >
+            1.0E-9 * std::max( 1.0, std::fabs( static_cast< double >( finalTime - initialTime ) ) ) )
+    {
+        throw std::runtime_error( "Error when retrieving final state of propagation, propagation did not end at required time" );
+    }
+    return stateHistory.getEntry( finalIndex );
+}
+
+//! Function to perform a parallel-in-time (Parareal) propagation of single-arc dynamics.
+/*!
+ *  Function to perform a parallel-in-time (Parareal) propagation of single-arc dynamics (see performPararealIterations for
+ *  details on the algorithm). The fine propagator is typically that of the serial propagation that is to be accelerated,
+ *  while the coarse propagator must be considerably cheaper, for instance by using a large fixed step size and/or a
+ *  lower-fidelity set of accelerations. Both are defined by functions creating the propagator settings from a set of
+ *  bodies. For each propagation of a slice, these settings are created anew, after which their initial time and state are
+ *  reset, and their termination settings replaced by termination exactly at the end of the slice.
+ *
+ *  As for propagateSingleArcEnsemble, a SystemOfBodies cannot be shared between concurrent propagations. The
+ *  bodyCreationFunction is therefore called once for each thread of the pool (serially, on the calling thread), and each
+ *  slice is propagated with the bodies of the thread on which it is executed. The coarse propagations are performed with the
+ *  bodies of the first thread.
+ *  \param bodyCreationFunction Function creating a new, independent, set of bodies.
+ *  \param finePropagatorSettingsFunction Function creating the fine propagation settings from a set of bodies.
+ *  \param coarsePropagatorSettingsFunction Function creating the coarse propagation settings from a set of bodies.
+ *  \param initialState Initial (conventional) state of the propagation.
+ *  \param initialTime Initial time of the propagation.
+ *  \param finalTime Final time of the propagation.
+ *  \param numberOfSlices Number of slices into which the propagation interval is divided.
+ *  \param boundaryDefectTolerance Tolerance on the maximum boundary defect (in units of the state entries).
+ *  \param maximumNumberOfIterations Maximum number of Parareal iterations (fine propagation sweeps).
+ *  \param threadPool Thread pool over which the fine propagation of the slices is distributed (serial if nullptr).
+ *  \param computeSerialReference Boolean denoting whether a serial propagation with the fine propagator is to be performed,
+ *  to determine the actual speedup and the error of the Parareal propagation.
+ *  \return Results of the Parareal propagation, including the full results of the last fine propagation of each slice.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::shared_ptr< PararealPropagationResults< StateScalarType, TimeType > > propagateSingleArcParareal(
+        const std::function< simulation_setup::SystemOfBodies( ) > bodyCreationFunction,
+        const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+            const simulation_setup::SystemOfBodies& ) > finePropagatorSettingsFunction,
+        const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+            const simulation_setup::SystemOfBodies& ) > coarsePropagatorSettingsFunction,
+        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialState,
+        const TimeType initialTime,
+        const TimeType finalTime,
+        const int numberOfSlices,
+        const double boundaryDefectTolerance,
+        const int maximumNumberOfIterations,
+        const std::shared_ptr< utilities::ThreadPool > threadPool,
+        const bool computeSerialReference = false )
+{
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > StateType;
+
+    // Create independent set of bodies for each thread
+    unsigned int numberOfThreads = ( threadPool == nullptr ) ? 1 : threadPool->getNumberOfThreads( );
+    std::vector< simulation_setup::SystemOfBodies > perThreadBodies;
+    for( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        perThreadBodies.push_back( bodyCreationFunction( ) );
+    }
+
+    // Function to propagate a single slice with given settings
+    auto propagateSlice = [ ]( const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+                                   const simulation_setup::SystemOfBodies& ) >& propagatorSettingsFunction,
+                               const simulation_setup::SystemOfBodies& bodies,
+                               const TimeType sliceInitialTime, const StateType& sliceInitialState,
+                               const TimeType sliceFinalTime )
+    {
+        std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > > propagatorSettings =
+                propagatorSettingsFunction( bodies );
+        propagatorSettings->resetInitialTime( sliceInitialTime );
+        propagatorSettings->resetInitialStates( sliceInitialState );
+        propagatorSettings->resetTerminationSettings(
+                    std::make_shared< PropagationTimeTerminationSettings >( static_cast< double >( sliceFinalTime ), true ) );
+
+        SingleArcDynamicsSimulator< StateScalarType, TimeType > dynamicsSimulator( bodies, propagatorSettings );
+        return dynamicsSimulator.getSingleArcPropagationResults( );
+    };
+
+    std::vector< std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > > fineSliceResults(
+                numberOfSlices );
+    std::shared_ptr< PararealPropagationResults< StateScalarType, TimeType > > pararealResults =
+            performPararealIterations< StateScalarType, TimeType >(
+                [ & ]( const int sliceIndex, const unsigned int threadIndex, const TimeType sliceInitialTime,
+                       const StateType& sliceInitialState, const TimeType sliceFinalTime )
+    {
+        std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > sliceResults = propagateSlice(
+                    finePropagatorSettingsFunction, perThreadBodies.at( threadIndex ),
+                    sliceInitialTime, sliceInitialState, sliceFinalTime );
+        if( sliceIndex >= 0 )
+        {
+            fineSliceResults[ sliceIndex ] = sliceResults;
+        }
+        return getFinalStateAtTime< StateScalarType, TimeType >( sliceResults, sliceInitialTime, sliceFinalTime );
+    },
+    [ & ]( const int, const TimeType sliceInitialTime, const StateType& sliceInitialState, const TimeType sliceFinalTime )
+    {
+        return getFinalStateAtTime< StateScalarType, TimeType >(
+                    propagateSlice( coarsePropagatorSettingsFunction, perThreadBodies.at( 0 ),
+                                    sliceInitialTime, sliceInitialState, sliceFinalTime ),
+                    sliceInitialTime, sliceFinalTime );
+    }, initialState, initialTime, finalTime, numberOfSlices, boundaryDefectTolerance, maximumNumberOfIterations,
+    threadPool, computeSerialReference );
+
+    pararealResults->setFineSliceResults( fineSliceResults );
+    return pararealResults;
+}
+
+//! Function to perform a parallel-in-time (Parareal) propagation of single-arc dynamics over a given number of threads.
+/*!
+ *  Function to perform a parallel-in-time (Parareal) propagation of single-arc dynamics over a given number of threads,
+ *  creating a thread pool for the purpose (see overload taking a thread pool for details).
+ *  \param bodyCreationFunction Function creating a new, independent, set of bodies.
+ *  \param finePropagatorSettingsFunction Function creating the fine propagation settings from a set of bodies.
+ *  \param coarsePropagatorSettingsFunction Function creating the coarse propagation settings from a set of bodies.
+ *  \param initialState Initial (conventional) state of the propagation.
+ *  \param initialTime Initial time of the propagation.
+ *  \param finalTime Final time of the propagation.
+ *  \param numberOfSlices Number of slices into which the propagation interval is divided.
+ *  \param boundaryDefectTolerance Tolerance on the maximum boundary defect (in units of the state entries).
+ *  \param maximumNumberOfIterations Maximum number of Parareal iterations (fine propagation sweeps).
+ *  \param numberOfThreads Number of threads over which the slices are distributed (0 to use all hardware threads).
+ *  \param computeSerialReference Boolean denoting whether a serial propagation with the fine propagator is to be performed,
+ *  to determine the actual speedup and the error of the Parareal propagation.
+ *  \return Results of the Parareal propagation, including the full results of the last fine propagation of each slice.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::shared_ptr< PararealPropagationResults< StateScalarType, TimeType > > propagateSingleArcParareal(
+        const std::function< simulation_setup::SystemOfBodies( ) > bodyCreationFunction,
+        const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+            const simulation_setup::SystemOfBodies& ) > finePropagatorSettingsFunction,
+        const std::function< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType, TimeType > >(
+            const simulation_setup::SystemOfBodies& ) > coarsePropagatorSettingsFunction,
+        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialState,
+        const TimeType initialTime,
+        const TimeType finalTime,
+        const int numberOfSlices,
+        const double boundaryDefectTolerance,
+        const int maximumNumberOfIterations,
+        const unsigned int numberOfThreads = 0,
+        const bool computeSerialReference = false )
+{
+    std::shared_ptr< utilities::ThreadPool > threadPool;
+    if( numberOfThreads != 1 )
+    {
+        threadPool = std::make_shared< utilities::ThreadPool >( numberOfThreads );
+    }
+    return propagateSingleArcParareal< StateScalarType, TimeType >(
+                bodyCreationFunction, finePropagatorSettingsFunction, coarsePropagatorSettingsFunction, initialState,
+                initialTime, finalTime, numberOfSlices, boundaryDefectTolerance, maximumNumberOfIterations, threadPool,
+                computeSerialReference );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PARAREALPROPAGATION_H
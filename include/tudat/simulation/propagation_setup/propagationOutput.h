@@ -13,6 +13,7 @@
 
 #include <functional>
 
+#include "tudat/basics/timingProfiler.h"
 #include "tudat/basics/utilities.h"
 #include "tudat/astro/basic_astro/astrodynamicsFunctions.h"
 #include "tudat/astro/aerodynamics/aerodynamics.h"
@@ -1673,14 +1674,15 @@ std::pair< std::function< Eigen::VectorXd( ) >, int > getVectorDependentVariable
             std::shared_ptr< electromagnetism::PaneledRadiationPressureTargetModel > paneledTarget =
                 std::dynamic_pointer_cast< electromagnetism::PaneledRadiationPressureTargetModel >( radiationPressureAcceleration->getTargetModel( ) );
             parameterSize = 3 * paneledTarget->getTotalNumberOfPanels( );
+            const int sourceIndex = radiationPressureAcceleration->getSourceIndex( );
 
             variableFunction = [=]( )
             {
                 Eigen::VectorXd panelForces = Eigen::VectorXd::Zero( parameterSize );
-                std::vector< Eigen::Vector3d >& panelForceList = paneledTarget->getPanelForces( secondaryBody );
-                for( unsigned int i = 0; i < panelForceList.size( ); i++ )
+                const Eigen::Matrix< double, Eigen::Dynamic, 3 >& panelForceList = paneledTarget->getPanelForces( sourceIndex );
+                for( int i = 0; i < panelForceList.rows( ); i++ )
                 {
-                    panelForces.segment( 3 * i, 3 ) = panelForceList.at( i );
+                    panelForces.segment( 3 * i, 3 ) = panelForceList.row( i ).transpose( );
                 }
                 return panelForces;
             };
@@ -2744,6 +2746,8 @@ Eigen::VectorXd evaluateListOfVectorFunctions(
  *  \param saveSettings Object containing types and other properties of dependent variables.
  *  \param bodies List of bodies to use in simulations (containing full environment).
  *  \param stateDerivativeModels List of state derivative models used in simulations (sorted by dynamics type as key)
+ *  \param stateDerivativePartials List of state derivative partials, used for partial-derived dependent variables
+ *  \param profiler Profiler in which the time spent computing each dependent variable is accumulated (none if nullptr)
  *  \return Pair with function returning requested dependent variable values, and list variable names with start entries.
  *  NOTE: The environment and state derivative models need to
  *  be updated to current state and independent variable before computation is performed.
@@ -2756,7 +2760,8 @@ std::pair< std::function< Eigen::VectorXd( ) >, std::map< std::pair< int, int >,
         const std::unordered_map< IntegratedStateType,
         std::vector< std::shared_ptr< SingleStateTypeDerivative< StateScalarType, TimeType > > > >& stateDerivativeModels,
         const std::map< propagators::IntegratedStateType, orbit_determination::StateDerivativePartialsMap >& stateDerivativePartials =
-        std::map< propagators::IntegratedStateType, orbit_determination::StateDerivativePartialsMap >( ) )
+        std::map< propagators::IntegratedStateType, orbit_determination::StateDerivativePartialsMap >( ),
+        const std::shared_ptr< utilities::TimingProfiler > profiler = nullptr )
 {
     // create list of vector parameters
     std::vector< std::pair< std::function< Eigen::VectorXd( ) >, int > > vectorFunctionList;
@@ -2788,6 +2793,18 @@ std::pair< std::function< Eigen::VectorXd( ) >, std::map< std::pair< int, int >,
                     getVectorDependentVariableFunction( variable, bodies, stateDerivativeModels );
 #endif
         }
+
+        // Add timing of dependent variable, if requested
+        if( profiler != nullptr )
+        {
+            const int profilerEntry = profiler->addEntry( "dependent_variable", getDependentVariableId( variable ) );
+            const std::function< Eigen::VectorXd( ) > unprofiledFunction = vectorFunction.first;
+            vectorFunction.first = [ = ]( )
+            {
+                utilities::ScopedTimingMeasurement timingMeasurement( profiler.get( ), profilerEntry );
+                return Eigen::VectorXd( unprofiledFunction( ) );
+            };
+        }
         vectorFunctionList.push_back( vectorFunction );
         vectorVariableList.push_back( std::make_pair( getDependentVariableId( variable ), vectorFunction.second ) );
     }
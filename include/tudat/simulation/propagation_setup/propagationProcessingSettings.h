@@ -108,6 +108,7 @@ public:
             resultsSaveFrequencyInSteps_( resultsSaveFrequencyInSteps ),
             resultsSaveFrequencyInSeconds_( resultsSaveFrequencyInSeconds ),
             printSettings_( printSettings ),
+            profilePropagation_( false ),
         isPartOfMultiArc_( false ), arcIndex_( -1 ){ }
     virtual ~SingleArcPropagatorProcessingSettings( ){ }
 
@@ -136,6 +137,18 @@ public:
         return resultsSaveFrequencyInSeconds_;
     }
 
+    //! Function to set whether the wall clock time spent in each environment update, acceleration/torque model and dependent
+    //! variable is to be measured during the propagation (see SingleArcDynamicsSimulator::getPropagationProfiler).
+    void setProfilePropagation( const bool profilePropagation )
+    {
+        profilePropagation_ = profilePropagation;
+    }
+
+    bool getProfilePropagation( )
+    {
+        return profilePropagation_;
+    }
+
     bool saveCurrentStep(
             const int stepsSinceLastSave, const double timeSinceLastSave )
     {
@@ -192,6 +205,8 @@ private:
 
     const std::shared_ptr< PropagationPrintSettings > printSettings_;
 
+    bool profilePropagation_;
+
     void setAsMultiArc( const unsigned int arcIndex, const bool printArcIndex )
     {
         isPartOfMultiArc_ = true;
@@ -8,6 +8,8 @@
 #include <map>
 #include <string>
 
+#include "tudat/basics/contiguousStateHistory.h"
+#include "tudat/basics/timingProfiler.h"
 #include "tudat/simulation/propagation_setup/propagationProcessingSettings.h"
 #include "tudat/simulation/propagation_setup/propagationTermination.h"
 #include "tudat/simulation/propagation_setup/dependentVariablesInterface.h"
@@ -71,10 +73,15 @@ namespace tudat
             static const bool is_variational = false;
             static const int number_of_columns = 1;
 
+            //! Typedef for contiguous history of (unprocessed or processed) state vectors
+            typedef utilities::ContiguousStateHistory< TimeType, StateScalarType > StateHistoryType;
+
+            //! Typedef for contiguous history of dependent variables
+            typedef utilities::ContiguousStateHistory< TimeType, double > DependentVariableHistoryType;
+
             SingleArcSimulationResults(const std::map< IntegratedStateType, std::vector< std::tuple< std::string, std::string, PropagatorType > > > integratedStateAndBodyList,
                                        const std::shared_ptr <SingleArcPropagatorProcessingSettings> &outputSettings,
-                                       const std::function< void ( std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&,
-                                                                   const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& ) > rawSolutionConversionFunction,
+                                       const std::function< void ( StateHistoryType&, const StateHistoryType& ) > rawSolutionConversionFunction,
                                        const std::shared_ptr< SingleArcDependentVariablesInterface< TimeType > > dependentVariableInterface,
                                        const bool sequentialPropagation = true ) :
                     SimulationResults<StateScalarType, TimeType>(),
@@ -101,33 +108,45 @@ namespace tudat
                 solutionIsCleared_ = false;
                 onlyProcessedSolutionSet_ = false;
                 propagationTerminationReason_ = std::make_shared<PropagationTerminationDetails>(propagation_never_run);
+                denseOutputStateInterpolatorFunction_ = nullptr;
             }
             
             void manuallySetSecondaryData( const std::shared_ptr< SingleArcSimulationResults< StateScalarType, TimeType > > resultsToCopy )
             {
-                dependentVariableHistory_ = resultsToCopy->getDependentVariableHistory( );
-                cumulativeComputationTimeHistory_ =  resultsToCopy->getCumulativeComputationTimeHistory( );
+                resultsToCopy->checkAvailabilityOfSolution( "dependent variable history", false );
+                dependentVariableHistory_ = resultsToCopy->dependentVariableHistory_;
+                cumulativeComputationTimeHistory_ = resultsToCopy->cumulativeComputationTimeHistory_;
+                invalidateMapViews( );
                 cumulativeNumberOfFunctionEvaluations_ =  resultsToCopy->getCumulativeNumberOfFunctionEvaluations( );
                 propagationTerminationReason_ = resultsToCopy->getPropagationTerminationReason( );
+                propagationProfiler_ = resultsToCopy->getPropagationProfiler( );
                 propagationIsPerformed_ = true;
             }
 
             //! Function that sets new numerical results of a propagation, after the propagation of the dynamics
+            /*!
+             *  Function that sets new numerical results of a propagation, after the propagation of the dynamics. The input
+             *  histories are moved into this object (and are empty upon return). The histories are ordered in increasing time.
+             */
             void reset(
-                    const std::map <TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >>& equationsOfMotionNumericalSolutionRaw,
-                    const std::map <TimeType, Eigen::VectorXd>& dependentVariableHistory,
-                    const std::map<TimeType, double>& cumulativeComputationTimeHistory,
+                    StateHistoryType& equationsOfMotionNumericalSolutionRaw,
+                    DependentVariableHistoryType& dependentVariableHistory,
+                    DependentVariableHistoryType& cumulativeComputationTimeHistory,
                     const std::map<TimeType, unsigned int>& cumulativeNumberOfFunctionEvaluations,
                     std::shared_ptr <PropagationTerminationDetails> propagationTerminationReason )
             {
                 if ( sequentialPropagation_ || !isPropagationOngoing_ )
                 {
                     reset( );
-                    equationsOfMotionNumericalSolutionRaw_ = equationsOfMotionNumericalSolutionRaw;
-                    dependentVariableHistory_ = dependentVariableHistory;
-                    cumulativeComputationTimeHistory_ = cumulativeComputationTimeHistory;
+                    equationsOfMotionNumericalSolutionRaw_ = std::move( equationsOfMotionNumericalSolutionRaw );
+                    dependentVariableHistory_ = std::move( dependentVariableHistory );
+                    cumulativeComputationTimeHistory_ = std::move( cumulativeComputationTimeHistory );
                     cumulativeNumberOfFunctionEvaluations_ = cumulativeNumberOfFunctionEvaluations;
 
+                    equationsOfMotionNumericalSolutionRaw_.sortByTime( );
+                    dependentVariableHistory_.sortByTime( );
+                    cumulativeComputationTimeHistory_.sortByTime( );
+
                     if ( !sequentialPropagation_ )
                     {
                         isPropagationOngoing_ = true;
@@ -135,15 +154,16 @@ namespace tudat
                 }
                 else if ( !sequentialPropagation_ && isPropagationOngoing_ )
                 {
-                    equationsOfMotionNumericalSolutionRaw_.insert( equationsOfMotionNumericalSolutionRaw.begin( ), equationsOfMotionNumericalSolutionRaw.end( ) );
-                    dependentVariableHistory_.insert( dependentVariableHistory.begin( ), dependentVariableHistory.end( ) );
-                    cumulativeComputationTimeHistory_.insert ( cumulativeComputationTimeHistory.begin( ), cumulativeComputationTimeHistory.end( ) );
+                    equationsOfMotionNumericalSolutionRaw_.merge( std::move( equationsOfMotionNumericalSolutionRaw ) );
+                    dependentVariableHistory_.merge( std::move( dependentVariableHistory ) );
+                    cumulativeComputationTimeHistory_.merge( std::move( cumulativeComputationTimeHistory ) );
                     cumulativeNumberOfFunctionEvaluations_.insert( cumulativeNumberOfFunctionEvaluations.begin( ), cumulativeNumberOfFunctionEvaluations.end( ) );
                     isPropagationOngoing_ = false;
                 }
+                equationsOfMotionNumericalSolution_.clear( );
                 rawSolutionConversionFunction_( equationsOfMotionNumericalSolution_, equationsOfMotionNumericalSolutionRaw_ );
                 propagationTerminationReason_ = propagationTerminationReason;
-
+                invalidateMapViews( );
             }
 
             //! Function to clear all maps with numerical results, but *not* signal that a new propagation will start,
@@ -156,6 +176,8 @@ namespace tudat
                 dependentVariableHistory_.clear();
                 cumulativeComputationTimeHistory_.clear();
                 cumulativeNumberOfFunctionEvaluations_.clear();
+                invalidateMapViews( );
+                denseOutputStateInterpolatorFunction_ = nullptr;
                 solutionIsCleared_ = true;
             }
 
@@ -166,7 +188,8 @@ namespace tudat
                 {
                     throw std::runtime_error( "Error when getting single-arc dynamics initial and final times; no results set" );
                 }
-                return std::make_pair( equationsOfMotionNumericalSolutionRaw_.begin( )->first, equationsOfMotionNumericalSolutionRaw_.rbegin( )->first );
+                return std::make_pair( equationsOfMotionNumericalSolutionRaw_.getTimes( ).front( ),
+                                       equationsOfMotionNumericalSolutionRaw_.getTimes( ).back( ) );
             }
 
             //! Function to signal that propagation is finished, and add number of function evaluations
@@ -182,7 +205,8 @@ namespace tudat
                     const std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1>> & equationsOfMotionNumericalSolution )
             {
                 onlyProcessedSolutionSet_ = true;
-                equationsOfMotionNumericalSolution_ = equationsOfMotionNumericalSolution;
+                equationsOfMotionNumericalSolution_.setFromMap( equationsOfMotionNumericalSolution );
+                invalidateMapViews( );
             }
 
             //! Function to check if output map that is requested is available
@@ -202,6 +226,11 @@ namespace tudat
                 }
             }
 
+            //! Function to retrieve the processed state history, as a map (created from the contiguous history upon first call).
+            /*!
+             *  Function to retrieve the processed state history, as a map (created from the contiguous history upon first call).
+             *  NOTE: modifications made to the returned map are not reflected in the contiguous history.
+             */
             std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1>> &
             getEquationsOfMotionNumericalSolution( )
             {
@@ -209,33 +238,60 @@ namespace tudat
                 {
                     checkAvailabilityOfSolution( "equations of motion numerical solution", false );
                 }
-                return equationsOfMotionNumericalSolution_;
+                return getEquationsOfMotionNumericalSolutionMap( );
             }
 
+            //! Function to retrieve the unprocessed state history, as a map (created from the contiguous history upon first call).
             std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1>> &
             getEquationsOfMotionNumericalSolutionRaw( )
             {
                 checkAvailabilityOfSolution( "equations of motion unprocessed numerical solution" );
-                return equationsOfMotionNumericalSolutionRaw_;
+                return getEquationsOfMotionNumericalSolutionRawMap( );
             }
 
+            //! Function to retrieve the dependent variable history, as a map (created from the contiguous history upon first call).
             std::map <TimeType, Eigen::VectorXd> &getDependentVariableHistory( )
             {
                 checkAvailabilityOfSolution( "dependent variable history", false );
-                return dependentVariableHistory_;
+                return getDependentVariableHistoryMap( );
             }
 
+            //! Function to retrieve the cumulative computation time history, as a map (created from the contiguous history upon first call).
             std::map<TimeType, double> &getCumulativeComputationTimeHistory( )
             {
                 checkAvailabilityOfSolution( "cumulative computation time history", false );
-                return cumulativeComputationTimeHistory_;
+                return getCumulativeComputationTimeHistoryMap( );
+            }
+
+            //! Function to retrieve the processed state history, in contiguous form (ordered in increasing time).
+            const StateHistoryType& getContiguousEquationsOfMotionNumericalSolution( )
+            {
+                if( !onlyProcessedSolutionSet_ )
+                {
+                    checkAvailabilityOfSolution( "equations of motion numerical solution", false );
+                }
+                return equationsOfMotionNumericalSolution_;
+            }
+
+            //! Function to retrieve the unprocessed state history, in contiguous form (ordered in increasing time).
+            const StateHistoryType& getContiguousEquationsOfMotionNumericalSolutionRaw( )
+            {
+                checkAvailabilityOfSolution( "equations of motion unprocessed numerical solution" );
+                return equationsOfMotionNumericalSolutionRaw_;
+            }
+
+            //! Function to retrieve the dependent variable history, in contiguous form (ordered in increasing time).
+            const DependentVariableHistoryType& getContiguousDependentVariableHistory( )
+            {
+                checkAvailabilityOfSolution( "dependent variable history", false );
+                return dependentVariableHistory_;
             }
 
             double getTotalComputationRuntime( )
             {
                 checkAvailabilityOfSolution( "cumulative computation time history", false );
-                return std::max( cumulativeComputationTimeHistory_.begin( )->second,
-                                 cumulativeComputationTimeHistory_.rbegin( )->second );
+                return std::max( cumulativeComputationTimeHistory_.getEntry( 0 )( 0 ),
+                                 cumulativeComputationTimeHistory_.getEntry( cumulativeComputationTimeHistory_.size( ) - 1 )( 0 ) );
             }
 
             std::map<TimeType, unsigned int> &getCumulativeNumberOfFunctionEvaluations( )
@@ -256,6 +312,41 @@ namespace tudat
                 return propagationTerminationReason_;
             }
 
+            //! Function to set the object measuring the time spent in the various parts of the propagation
+            void setPropagationProfiler( const std::shared_ptr< utilities::TimingProfiler > propagationProfiler )
+            {
+                propagationProfiler_ = propagationProfiler;
+            }
+
+            //! Function to retrieve the object containing the time spent in the various parts of the most recent propagation
+            //! (nullptr if profiling is not requested, see SingleArcPropagatorProcessingSettings::setProfilePropagation)
+            std::shared_ptr< utilities::TimingProfiler > getPropagationProfiler( )
+            {
+                return propagationProfiler_;
+            }
+
+            //! Function to set the function that creates interpolators evaluating the dense output of the integrator
+            /*!
+             *  Function to set the function that creates interpolators evaluating the dense output (continuous extension of
+             *  each step, see RungeKuttaDenseOutput) of the integrator, for a Cartesian state (6 rows, starting at the row
+             *  given as input) in the propagated state vector. Only set if requested by IntegratorSettings::storeDenseOutput_,
+             *  and if the propagated state and time are of type double.
+             */
+            void setDenseOutputStateInterpolatorFunction(
+                    const std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >(
+                        const int ) > denseOutputStateInterpolatorFunction )
+            {
+                denseOutputStateInterpolatorFunction_ = denseOutputStateInterpolatorFunction;
+            }
+
+            //! Function to retrieve the function that creates interpolators evaluating the dense output of the integrator
+            //! (nullptr if no dense output is stored, see setDenseOutputStateInterpolatorFunction)
+            std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >
+            getDenseOutputStateInterpolatorFunction( )
+            {
+                return denseOutputStateInterpolatorFunction_;
+            }
+
             bool integrationCompletedSuccessfully( ) const
             {
                 return (propagationTerminationReason_->getPropagationTerminationReason() ==
@@ -353,10 +444,16 @@ namespace tudat
             {
                 if( dependentVariableHistory_.size( ) > 0 && dependentVariableInterface_ != nullptr )
                 {
+                    std::vector< Eigen::VectorXd > dependentVariableValues;
+                    dependentVariableValues.reserve( dependentVariableHistory_.size( ) );
+                    for( unsigned int i = 0; i < dependentVariableHistory_.size( ); i++ )
+                    {
+                        dependentVariableValues.push_back( dependentVariableHistory_.getEntry( i ) );
+                    }
+
                     std::shared_ptr< interpolators::LagrangeInterpolator< TimeType, Eigen::VectorXd > > dependentVariablesInterpolator =
                             std::make_shared< interpolators::LagrangeInterpolator< TimeType, Eigen::VectorXd > >(
-                                    utilities::createVectorFromMapKeys< Eigen::VectorXd, TimeType >( dependentVariableHistory_ ),
-                                    utilities::createVectorFromMapValues< Eigen::VectorXd, TimeType >( dependentVariableHistory_ ), 8 );
+                                    dependentVariableHistory_.getTimes( ), dependentVariableValues, 8 );
                     dependentVariableInterface_->updateDependentVariablesInterpolator( dependentVariablesInterpolator );
                 }
             }
@@ -374,29 +471,105 @@ namespace tudat
 
         private:
 
-            //! Map of state history of numerically integrated bodies.
+            //! Function to signal that the map views of the contiguous histories are to be recreated upon next retrieval.
+            void invalidateMapViews( )
+            {
+                equationsOfMotionNumericalSolutionMap_.clear( );
+                equationsOfMotionNumericalSolutionRawMap_.clear( );
+                dependentVariableHistoryMap_.clear( );
+                cumulativeComputationTimeHistoryMap_.clear( );
+
+                isEquationsOfMotionNumericalSolutionMapSet_ = false;
+                isEquationsOfMotionNumericalSolutionRawMapSet_ = false;
+                isDependentVariableHistoryMapSet_ = false;
+                isCumulativeComputationTimeHistoryMapSet_ = false;
+            }
+
+            //! Function to retrieve map view of equationsOfMotionNumericalSolution_ (without checking availability)
+            std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1>>& getEquationsOfMotionNumericalSolutionMap( )
+            {
+                if( !isEquationsOfMotionNumericalSolutionMapSet_ )
+                {
+                    equationsOfMotionNumericalSolutionMap_ = equationsOfMotionNumericalSolution_.getMap( );
+                    isEquationsOfMotionNumericalSolutionMapSet_ = true;
+                }
+                return equationsOfMotionNumericalSolutionMap_;
+            }
+
+            //! Function to retrieve map view of equationsOfMotionNumericalSolutionRaw_ (without checking availability)
+            std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1>>& getEquationsOfMotionNumericalSolutionRawMap( )
+            {
+                if( !isEquationsOfMotionNumericalSolutionRawMapSet_ )
+                {
+                    equationsOfMotionNumericalSolutionRawMap_ = equationsOfMotionNumericalSolutionRaw_.getMap( );
+                    isEquationsOfMotionNumericalSolutionRawMapSet_ = true;
+                }
+                return equationsOfMotionNumericalSolutionRawMap_;
+            }
+
+            //! Function to retrieve map view of dependentVariableHistory_ (without checking availability)
+            std::map <TimeType, Eigen::VectorXd>& getDependentVariableHistoryMap( )
+            {
+                if( !isDependentVariableHistoryMapSet_ )
+                {
+                    dependentVariableHistoryMap_ = dependentVariableHistory_.getMap( );
+                    isDependentVariableHistoryMapSet_ = true;
+                }
+                return dependentVariableHistoryMap_;
+            }
+
+            //! Function to retrieve map view of cumulativeComputationTimeHistory_ (without checking availability)
+            std::map<TimeType, double>& getCumulativeComputationTimeHistoryMap( )
+            {
+                if( !isCumulativeComputationTimeHistoryMapSet_ )
+                {
+                    cumulativeComputationTimeHistoryMap_ = cumulativeComputationTimeHistory_.getScalarMap( );
+                    isCumulativeComputationTimeHistoryMapSet_ = true;
+                }
+                return cumulativeComputationTimeHistoryMap_;
+            }
+
+            //! State history of numerically integrated bodies.
             /*!
-             *  Map of state history of numerically integrated bodies, i.e. the result of the numerical integration, transformed
-             *  into the 'conventional form' (\sa SingleStateTypeDerivative::convertToOutputSolution). Key of map denotes time,
-             *  values are concatenated vectors of integrated body states (order defined by propagatorSettings_).
-             *  NOTE: this map is empty if clearNumericalSolutions_ is set to true.
+             *  State history of numerically integrated bodies, i.e. the result of the numerical integration, transformed
+             *  into the 'conventional form' (\sa SingleStateTypeDerivative::convertToOutputSolution). Entries are
+             *  concatenated vectors of integrated body states (order defined by propagatorSettings_).
+             *  NOTE: this history is empty if clearNumericalSolutions_ is set to true.
              */
-            std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolution_;
+            StateHistoryType equationsOfMotionNumericalSolution_;
 
-            //! Map of state history of numerically integrated bodies.
+            //! State history of numerically integrated bodies.
             /*!
-            *  Map of state history of numerically integrated bodies, i.e. the result of the numerical integration, in the
-            *  original propagation coordinates. Key of map denotes time, values are concatenated vectors of integrated body
-            * states (order defined by propagatorSettings_).
-            *  NOTE: this map is empty if clearNumericalSolutions_ is set to true.
+            *  State history of numerically integrated bodies, i.e. the result of the numerical integration, in the
+            *  original propagation coordinates. Entries are concatenated vectors of integrated body
+            *  states (order defined by propagatorSettings_).
+            *  NOTE: this history is empty if clearNumericalSolutions_ is set to true.
             */
-            std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1>> equationsOfMotionNumericalSolutionRaw_;
+            StateHistoryType equationsOfMotionNumericalSolutionRaw_;
+
+            //! Dependent variable history that was saved during numerical propagation.
+            DependentVariableHistoryType dependentVariableHistory_;
+
+            //! Cumulative computation time history that was saved during numerical propagation.
+            DependentVariableHistoryType cumulativeComputationTimeHistory_;
+
+            //! Map view of equationsOfMotionNumericalSolution_, created upon request
+            std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolutionMap_;
+
+            //! Map view of equationsOfMotionNumericalSolutionRaw_, created upon request
+            std::map <TimeType, Eigen::Matrix<StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolutionRawMap_;
 
-            //! Map of dependent variable history that was saved during numerical propagation.
-            std::map <TimeType, Eigen::VectorXd> dependentVariableHistory_;
+            //! Map view of dependentVariableHistory_, created upon request
+            std::map <TimeType, Eigen::VectorXd> dependentVariableHistoryMap_;
 
-            //! Map of cumulative computation time history that was saved during numerical propagation.
-            std::map<TimeType, double> cumulativeComputationTimeHistory_;
+            //! Map view of cumulativeComputationTimeHistory_, created upon request
+            std::map<TimeType, double> cumulativeComputationTimeHistoryMap_;
+
+            //! Booleans denoting whether the map views are up to date with the contiguous histories
+            bool isEquationsOfMotionNumericalSolutionMapSet_ = false;
+            bool isEquationsOfMotionNumericalSolutionRawMapSet_ = false;
+            bool isDependentVariableHistoryMapSet_ = false;
+            bool isCumulativeComputationTimeHistoryMapSet_ = false;
 
             //! Map of cumulative number of function evaluations that was saved during numerical propagation.
             std::map<TimeType, unsigned int> cumulativeNumberOfFunctionEvaluations_;
@@ -417,8 +590,7 @@ namespace tudat
             bool sequentialPropagation_;
 
             //! Function to convert the propagated solution to conventional solution (see DynamicsStateDerivativeModel::convertToOutputSolution)
-            const std::function< void ( std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&,
-                                        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& ) > rawSolutionConversionFunction_;
+            const std::function< void ( StateHistoryType&, const StateHistoryType& ) > rawSolutionConversionFunction_;
 
             bool propagationIsPerformed_;
 
@@ -429,6 +601,14 @@ namespace tudat
             //! Event that triggered the termination of the propagation
             std::shared_ptr <PropagationTerminationDetails> propagationTerminationReason_;
 
+            //! Object containing the time spent in the various parts of the propagation (nullptr if not requested)
+            std::shared_ptr< utilities::TimingProfiler > propagationProfiler_;
+
+            //! Function creating interpolators that evaluate the dense output of the integrator, for a Cartesian state starting
+            //! at the given row of the propagated state (nullptr if no dense output is stored)
+            std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >
+            denseOutputStateInterpolatorFunction_;
+
             friend class SingleArcDynamicsSimulator<StateScalarType, TimeType>;
 
 //            friend class MultiArcSimulationResults<StateScalarType, TimeType, NumberOfStateColumns >;
@@ -463,14 +643,17 @@ namespace tudat
                 singleArcDynamicsResults_->reset( );
             }
 
+            //! Typedef for contiguous history of combined state transition, sensitivity matrices and state vector
+            typedef utilities::ContiguousStateHistory< TimeType, StateScalarType, Eigen::Dynamic > FullSolutionHistoryType;
+
             void reset(
-                    std::map <TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >>& fullSolution,
-                    const std::map <TimeType, Eigen::VectorXd>& dependentVariableHistory,
-                    const std::map<TimeType, double>& cumulativeComputationTimeHistory,
+                    FullSolutionHistoryType& fullSolution,
+                    typename SingleArcSimulationResults< StateScalarType, TimeType >::DependentVariableHistoryType& dependentVariableHistory,
+                    typename SingleArcSimulationResults< StateScalarType, TimeType >::DependentVariableHistoryType& cumulativeComputationTimeHistory,
                     const std::map<TimeType, unsigned int>& cumulativeNumberOfFunctionEvaluations,
                     std::shared_ptr <PropagationTerminationDetails> propagationTerminationReason )
             {
-                std::map <TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >> equationsOfMotionNumericalSolutionRaw;
+                typename SingleArcSimulationResults< StateScalarType, TimeType >::StateHistoryType equationsOfMotionNumericalSolutionRaw;
                 splitSolution( fullSolution, equationsOfMotionNumericalSolutionRaw );
                 singleArcDynamicsResults_->reset(
                         equationsOfMotionNumericalSolutionRaw,
@@ -487,14 +670,18 @@ namespace tudat
 
             //! Function to split the full numerical solution into the solution for state transition matrix, sensitivity matrix, and unprocessed dynamics solution
             void splitSolution(
-                    const std::map <TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >>& fullSolution,
-                    std::map <TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >>& equationsOfMotionNumericalSolutionRaw )
+                    const FullSolutionHistoryType& fullSolution,
+                    typename SingleArcSimulationResults< StateScalarType, TimeType >::StateHistoryType& equationsOfMotionNumericalSolutionRaw )
             {
-                for( auto it : fullSolution )
+                equationsOfMotionNumericalSolutionRaw.clear( );
+                equationsOfMotionNumericalSolutionRaw.reserve( fullSolution.size( ) );
+                for( unsigned int i = 0; i < fullSolution.size( ); i++ )
                 {
-                    stateTransitionSolution_[ static_cast< double >( it.first ) ] = it.second.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ).template cast< double >( );
-                    sensitivitySolution_[ static_cast< double >( it.first ) ] = it.second.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ).template cast< double >( );
-                    equationsOfMotionNumericalSolutionRaw[ static_cast< double >( it.first ) ] = it.second.block( 0, stateTransitionMatrixSize_ + sensitivityMatrixSize_, stateTransitionMatrixSize_, 1 );
+                    const TimeType currentTime = fullSolution.getTime( i );
+                    Eigen::Map< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentSolution = fullSolution.getEntry( i );
+                    stateTransitionSolution_[ static_cast< double >( currentTime ) ] = currentSolution.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ).template cast< double >( );
+                    sensitivitySolution_[ static_cast< double >( currentTime ) ] = currentSolution.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ).template cast< double >( );
+                    equationsOfMotionNumericalSolutionRaw.addEntry( static_cast< double >( currentTime ), currentSolution.block( 0, stateTransitionMatrixSize_ + sensitivityMatrixSize_, stateTransitionMatrixSize_, 1 ) );
                 }
             }
 
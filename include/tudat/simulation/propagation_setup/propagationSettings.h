@@ -449,7 +449,9 @@ public:
             std::make_shared< MultiArcPropagatorProcessingSettings >( ) ):
         PropagatorSettings< StateScalarType >( getConcatenatedInitialStates( singleArcSettings ), outputSettings, true ),
         singleArcSettings_( singleArcSettings ),
-        outputSettings_( outputSettings )
+        outputSettings_( outputSettings ),
+        transferInitialStateInformationPerArc_( transferInitialStateInformationPerArc ),
+        numberOfThreadsForArcPropagation_( 1 )
     {
         std::vector< std::shared_ptr< SingleArcPropagatorProcessingSettings > > singleArcOutputSettings;
         for( unsigned int i = 0; i < singleArcSettings.size( ); i++ )
@@ -611,6 +613,77 @@ public:
         return outputSettings_;
     }
 
+    //! Function to set the arcs to be propagated concurrently, each using its own environment.
+    /*!
+     * Function to set the arcs to be propagated concurrently on a thread pool (including their variational equations,
+     * when used in a variational equations solver), each arc using its own environment. Since the environment models
+     * (e.g. ephemerides, rotation models) of a body are updated during the propagation, the environment may not be shared
+     * between arcs that are propagated simultaneously: the bodies of each arc must be created separately (e.g. by calling
+     * createSystemOfBodies once per arc), and the single-arc propagator settings of each arc must be created using the
+     * bodies of that arc (e.g. by creating the acceleration models of each arc from the arc's own bodies). Environment
+     * models that use Spice may be used, but all calls to Spice are serialized (see spice_interface::getSpiceMutex), so
+     * that these should be replaced by (for instance) tabulated or Chebyshev ephemerides for the arcs to be propagated
+     * efficiently in parallel. The arcs are required to be independent: the initial state of an arc may not be taken from
+     * the previous arc (see constructor). The results are stored per arc, so that the results are identical to those of a
+     * serial propagation, and are post-processed (e.g. used to reset the ephemerides of the propagated bodies) in the
+     * environment provided to the dynamics simulator, in order of the arcs. When used in a variational equations solver
+     * (e.g. for an estimation), only the arc-wise initial states may be estimated: other parameters are linked to the
+     * models of the environment provided to the solver, so that their values would not be set in the arc-wise bodies.
+     * \param arcWiseBodies List of bodies for each arc, which the single-arc propagator settings of each arc use
+     * \param numberOfThreads Number of threads over which the arcs are distributed (if 0, the number of available hardware
+     * threads is used; if 1, arcs are propagated serially, each with their own environment).
+     */
+    void setConcurrentArcPropagation( const std::vector< simulation_setup::SystemOfBodies >& arcWiseBodies,
+                                      const unsigned int numberOfThreads = 0 )
+    {
+        if( arcWiseBodies.size( ) != singleArcSettings_.size( ) )
+        {
+            throw std::runtime_error( "Error when setting concurrent multi-arc propagation, number of arc-wise bodies (" +
+                                      std::to_string( arcWiseBodies.size( ) ) + ") is not equal to number of arcs (" +
+                                      std::to_string( singleArcSettings_.size( ) ) + ")" );
+        }
+        else if( transferInitialStateInformationPerArc_ )
+        {
+            throw std::runtime_error( "Error when setting concurrent multi-arc propagation, arcs cannot be propagated "
+                                      "concurrently when initial state information is transferred between arcs" );
+        }
+        arcWiseBodies_ = arcWiseBodies;
+        numberOfThreadsForArcPropagation_ = numberOfThreads;
+    }
+
+    //! Function to retrieve whether the arcs are propagated concurrently, each using its own environment.
+    /*!
+     * Function to retrieve whether the arcs are propagated concurrently, each using its own environment (see
+     * setConcurrentArcPropagation).
+     * \return Boolean denoting whether the arcs are propagated concurrently.
+     */
+    bool getPropagateArcsConcurrently( )
+    {
+        return arcWiseBodies_.size( ) > 0;
+    }
+
+    //! Function to retrieve the bodies used for each arc when propagating the arcs concurrently.
+    /*!
+     * Function to retrieve the bodies used for each arc when propagating the arcs concurrently (empty if arcs are
+     * propagated serially, using a single environment)
+     * \return Bodies used for each arc.
+     */
+    std::vector< simulation_setup::SystemOfBodies > getArcWiseBodies( )
+    {
+        return arcWiseBodies_;
+    }
+
+    //! Function to retrieve the number of threads over which arcs are distributed when propagating the arcs concurrently.
+    /*!
+     * Function to retrieve the number of threads over which arcs are distributed when propagating the arcs concurrently
+     * (0 denoting all available hardware threads).
+     * \return Number of threads over which arcs are distributed.
+     */
+    unsigned int getNumberOfThreadsForArcPropagation( )
+    {
+        return numberOfThreadsForArcPropagation_;
+    }
+
 
 protected:
 
@@ -621,6 +694,15 @@ protected:
 
     //! List of initial states for each arc in propagation.
     std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > initialStateList_;
+
+    //! Boolean denoting whether the initial state of arc N+1 is to be taken from arc N (for N>0)
+    bool transferInitialStateInformationPerArc_;
+
+    //! List of bodies for each arc, used when propagating arcs concurrently (empty for serial propagation).
+    std::vector< simulation_setup::SystemOfBodies > arcWiseBodies_;
+
+    //! Number of threads over which arcs are distributed when propagating arcs concurrently (0: all available threads).
+    unsigned int numberOfThreadsForArcPropagation_;
 };
 
 template< typename StateScalarType = double, typename TimeType = double >
@@ -11,6 +11,7 @@
 #ifndef TUDAT_SETNUMERICALLYINTEGRATEDSTATES_H
 #define TUDAT_SETNUMERICALLYINTEGRATEDSTATES_H
 
+#include "tudat/basics/contiguousStateHistory.h"
 #include "tudat/basics/utilities.h"
 #include "tudat/basics/timeType.h"
 #include "tudat/simulation/environment_setup/body.h"
@@ -21,6 +22,7 @@
 #include "tudat/simulation/propagation_setup/propagationSettings.h"
 
 #include "tudat/math/interpolators/lagrangeInterpolator.h"
+#include "tudat/math/interpolators/rungeKuttaDenseOutputInterpolator.h"
 
 
 namespace tudat
@@ -87,23 +89,45 @@ std::shared_ptr< interpolators::OneDimensionalInterpolator< TimeType, Eigen::Mat
 createStateInterpolator(
         const std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > >& stateMap );
 
+//! Function to create an interpolator for the new translational state of a body.
+/*!
+ * Function to create an interpolator for the new translational state of a body, from the epochs and states given as
+ * separate vectors.
+ * \param times Epochs of new state history, in increasing order.
+ * \param states New state history (at epochs given by times), w.r.t. the required ephemeris origin.
+ * \return Lagrange interpolator (order 6) that produces the required continuous state.
+ */
+template< typename TimeType, typename StateScalarType >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > > >
+createStateInterpolator(
+        const std::vector< TimeType >& times,
+        const std::vector< Eigen::Matrix< StateScalarType, 6, 1 > >& states );
+
 //! Function to reset the tabulated ephemeris of a body
 /*!
  * Function to reset the tabulated ephemeris of a body
- * \param ephemerisInput New state history that is to be set
- * \param tabulatedEphemeris Ephemeris in which the ephemerisInput is to be set.
+ * \param times Epochs of new state history that is to be set, in increasing order.
+ * \param states New state history that is to be set (at epochs given by times).
+ * \param tabulatedEphemeris Ephemeris in which the new state history is to be set.
  */
 template< typename StateTimeType, typename StateScalarType, typename EphemerisTimeType, typename EphemerisScalarType  >
 void resetIntegratedEphemerisOfBody(
-        const std::map< StateTimeType, Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisInput,
+        const std::vector< StateTimeType >& times,
+        const std::vector< Eigen::Matrix< StateScalarType, 6, 1 > >& states,
         const std::shared_ptr< ephemerides::TabulatedCartesianEphemeris< EphemerisScalarType, EphemerisTimeType > > tabulatedEphemeris )
 {
-    std::map< EphemerisTimeType, Eigen::Matrix< EphemerisScalarType, 6, 1 > > castEphemerisInput;
-    utilities::castMatrixMap< StateTimeType, StateScalarType, EphemerisTimeType, EphemerisScalarType, 6, 1 >(
-                ephemerisInput, castEphemerisInput );
-    
+    std::vector< EphemerisTimeType > castTimes;
+    std::vector< Eigen::Matrix< EphemerisScalarType, 6, 1 > > castStates;
+    castTimes.reserve( times.size( ) );
+    castStates.reserve( states.size( ) );
+    for( unsigned int i = 0; i < times.size( ); i++ )
+    {
+        castTimes.push_back( static_cast< EphemerisTimeType >( times.at( i ) ) );
+        castStates.push_back( states.at( i ).template cast< EphemerisScalarType >( ) );
+    }
+
     std::shared_ptr< interpolators::OneDimensionalInterpolator< EphemerisTimeType, Eigen::Matrix< EphemerisScalarType, 6, 1 > > >
-            ephemerisInterpolator = createStateInterpolator( castEphemerisInput );
+            ephemerisInterpolator = createStateInterpolator( castTimes, castStates );
     tabulatedEphemeris->resetInterpolator( ephemerisInterpolator );
 }
 
@@ -112,13 +136,15 @@ void resetIntegratedEphemerisOfBody(
  * Function to reset the tabulated ephemeris of a body, this requires the requested body to possess
  * an ephemeris of type TabulatedCartesianEphemeris< StateScalarType, TimeType >
  * \param bodies List of bodies used in simulations.
- * \param ephemerisInput New state history of the body
+ * \param times Epochs of new state history of the body, in increasing order.
+ * \param states New state history of the body (at epochs given by times).
  * \param bodyToIntegrate Name of body for which the ephemeris is to be reset.
  */
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedEphemerisOfBody(
         const simulation_setup::SystemOfBodies& bodies,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisInput,
+        const std::vector< TimeType >& times,
+        const std::vector< Eigen::Matrix< StateScalarType, 6, 1 > >& states,
         const std::string& bodyToIntegrate )
 {
     using namespace tudat::interpolators;
@@ -145,7 +171,7 @@ void resetIntegratedEphemerisOfBody(
                     bodies.at( bodyToIntegrate )->getEphemeris( ) ) != nullptr )
         {
             std::shared_ptr< OneDimensionalInterpolator< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > > >
-                    ephemerisInterpolator = createStateInterpolator( ephemerisInput );
+                    ephemerisInterpolator = createStateInterpolator( times, states );
             std::shared_ptr< TabulatedCartesianEphemeris< StateScalarType, TimeType > > tabulatedEphemeris =
                     std::dynamic_pointer_cast< TabulatedCartesianEphemeris< StateScalarType, TimeType > >(
                         bodies.at( bodyToIntegrate )->getEphemeris( ) );
@@ -157,28 +183,28 @@ void resetIntegratedEphemerisOfBody(
                         bodies.at( bodyToIntegrate )->getEphemeris( ) ) != nullptr )
             {
                 resetIntegratedEphemerisOfBody(
-                            ephemerisInput, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, double > >(
+                            times, states, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, double > >(
                                 bodies.at( bodyToIntegrate )->getEphemeris( ) ) );
             }
             else if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, double > >(
                          bodies.at( bodyToIntegrate )->getEphemeris( ) ) != nullptr )
             {
                 resetIntegratedEphemerisOfBody(
-                            ephemerisInput, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, double > >(
+                            times, states, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, double > >(
                                 bodies.at( bodyToIntegrate )->getEphemeris( ) ) );
             }
             else if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, Time > >(
                          bodies.at( bodyToIntegrate )->getEphemeris( ) ) != nullptr )
             {
                 resetIntegratedEphemerisOfBody(
-                            ephemerisInput, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, Time > >(
+                            times, states, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< double, Time > >(
                                 bodies.at( bodyToIntegrate )->getEphemeris( ) ) );
             }
             else if( std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, Time > >(
                          bodies.at( bodyToIntegrate )->getEphemeris( ) ) != nullptr )
             {
                 resetIntegratedEphemerisOfBody(
-                            ephemerisInput, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, Time > >(
+                            times, states, std::dynamic_pointer_cast< TabulatedCartesianEphemeris< long double, Time > >(
                                 bodies.at( bodyToIntegrate )->getEphemeris( ) ) );
             }
             else
@@ -189,6 +215,54 @@ void resetIntegratedEphemerisOfBody(
     }
 }
 
+//! Function to create an interpolator for the new translational state of a body, from the dense output of an integrator.
+/*!
+ * Function to create an interpolator for the new translational state of a body, which evaluates the continuous extension
+ * of the steps of a Runge-Kutta integrator (see RungeKuttaDenseOutput), instead of interpolating the discrete state history.
+ * \param denseOutput Dense output of the Runge-Kutta integrator, of which the rows startRow to startRow + 5 contain the
+ * Cartesian state of the body w.r.t. the required ephemeris origin.
+ * \param startRow Index of the first row of the state of the body in the state of the dense output.
+ * \return Interpolator that evaluates the dense output of the integrator.
+ */
+template< typename DenseOutputStateType >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > createStateInterpolator(
+        const std::shared_ptr< numerical_integrators::RungeKuttaDenseOutput< double, DenseOutputStateType, double > > denseOutput,
+        const int startRow )
+{
+    return std::make_shared< interpolators::RungeKuttaDenseOutputInterpolator<
+            double, Eigen::Vector6d, DenseOutputStateType, double > >( denseOutput, startRow );
+}
+
+//! Function to reset the tabulated ephemeris of a body from the dense output of a Runge-Kutta integrator
+/*!
+ * Function to reset the tabulated ephemeris of a body from the dense output of a Runge-Kutta integrator (as an alternative
+ * to resetting it from the discrete state history, which is interpolated), this requires the requested body to possess
+ * an ephemeris of type TabulatedCartesianEphemeris< double, double >. The dense output must be of the Cartesian state
+ * w.r.t. the origin of the ephemeris of the body (e.g. Cowell propagation w.r.t. this origin), so that no conversion or
+ * frame translation of the state is required.
+ * \param bodies List of bodies used in simulations.
+ * \param denseOutput Dense output of the Runge-Kutta integrator (see RungeKuttaVariableStepSizeIntegrator::getDenseOutput).
+ * \param startRow Index of the first row of the state of the body in the state of the dense output.
+ * \param bodyToIntegrate Name of body for which the ephemeris is to be reset.
+ */
+template< typename DenseOutputStateType >
+void resetIntegratedEphemerisOfBody(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::shared_ptr< numerical_integrators::RungeKuttaDenseOutput< double, DenseOutputStateType, double > > denseOutput,
+        const int startRow,
+        const std::string& bodyToIntegrate )
+{
+    std::shared_ptr< ephemerides::TabulatedCartesianEphemeris< double, double > > tabulatedEphemeris =
+            std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< double, double > >(
+                bodies.at( bodyToIntegrate )->getEphemeris( ) );
+    if( tabulatedEphemeris == nullptr )
+    {
+        throw std::runtime_error( "Error when resetting integrated ephemeris of body " + bodyToIntegrate +
+                                  " from dense output, no tabulated ephemeris with double state and time found" );
+    }
+    tabulatedEphemeris->resetInterpolator( createStateInterpolator( denseOutput, startRow ) );
+}
+
 //! Function to convert output of translational motion to input for the ephemeris.
 /*!
  * Function to convert output of translational motion from the numerical integrator to the required
@@ -239,6 +313,45 @@ void convertNumericalSolutionToEphemerisInput(
     }
 }
 
+//! Function to convert output of translational motion to input for the ephemeris.
+/*!
+ * Function to convert output of translational motion from the numerical integrator, stored as a contiguous history, to the
+ * required input for the ephemeris.  It extracts the state history of a single body from the full history of integrated
+ * states, without creating a map of the full solution. Additionally, it changes the origin of the reference frame in which
+ * the states are given, by using the integrationToEphemerisFrameFunction input variable.
+ * \param bodyIndex Index of integrated body for which the state is to be retrieved
+ * \param startIndex Index in entries of equationsOfMotionNumericalSolution where the translational states start.
+ * \param equationsOfMotionNumericalSolution Full numerical solution of numerical integrator,
+ * already converted to Cartesian states (w.r.t. the integration origin of the body of bodyIndex)
+ * \param ephemerisStates State history of body bodyIndex w.r.t. the origin with which its ephemeris is defined, at the
+ * epochs of equationsOfMotionNumericalSolution (returned by reference).
+ * \param integrationToEphemerisFrameFunction Function to provide the state of the ephemeris origin
+ * of the current body w.r.t. its integration origin.
+*/
+template< typename TimeType, typename StateScalarType >
+void convertNumericalSolutionToEphemerisInput(
+        const int bodyIndex,
+        const int startIndex,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
+        std::vector< Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisStates,
+        const std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) >
+        integrationToEphemerisFrameFunction = nullptr )
+{
+    const std::vector< TimeType >& times = equationsOfMotionNumericalSolution.getTimes( );
+    Eigen::Map< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > solutionMatrix =
+            equationsOfMotionNumericalSolution.getValuesMatrix( );
+
+    ephemerisStates.resize( times.size( ) );
+    for( unsigned int i = 0; i < times.size( ); i++ )
+    {
+        ephemerisStates[ i ] = solutionMatrix.block( startIndex + 6 * bodyIndex, i, 6, 1 );
+        if( integrationToEphemerisFrameFunction != nullptr )
+        {
+            ephemerisStates[ i ] -= integrationToEphemerisFrameFunction( times.at( i ) );
+        }
+    }
+}
+
 //! Function to extract the numerical solution for the translational dynamics of a single body from full propagation history.
 /*!
  * Function to extract the numerical solution for the translational dynamics of a single body from full propagation history.
@@ -249,7 +362,8 @@ void convertNumericalSolutionToEphemerisInput(
  * \param bodyForWhichToRetrieveState Name of body for which the states are to be extracted
  * \param equationsOfMotionNumericalSolution Numerical solution of dynamics, with translational results in Cartesian elements
  * w.r.t. integratation origins.
- * \param ephemerisInput State history of requested body (returned by reference)
+ * \param ephemerisStates State history of requested body, at the epochs of equationsOfMotionNumericalSolution
+ * (returned by reference)
  * \param bodyIndex Index of bodyForWhichToRetrieveState in bodiesToIntegrate (returned by reference)
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
@@ -259,8 +373,8 @@ void getSingleBodyStateHistoryFromPropagationOutpiut(
         const std::vector< std::string >& bodiesToIntegrate,
         const int translationalStateStartIndex,
         const std::string& bodyForWhichToRetrieveState,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
-        std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisInput,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
+        std::vector< Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisStates,
         int& bodyIndex,
         const std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
         integrationToEphemerisFrameFunctions =
@@ -286,7 +400,7 @@ void getSingleBodyStateHistoryFromPropagationOutpiut(
     
     // Create and reset interpolator.
     convertNumericalSolutionToEphemerisInput(
-                bodyIndex, translationalStateStartIndex, equationsOfMotionNumericalSolution, ephemerisInput, integrationToEphemerisFrameFunction );
+                bodyIndex, translationalStateStartIndex, equationsOfMotionNumericalSolution, ephemerisStates, integrationToEphemerisFrameFunction );
 }
 
 //! Create and reset ephemerides interpolator
@@ -302,6 +416,11 @@ void getSingleBodyStateHistoryFromPropagationOutpiut(
  * motion, in Cartesian elements w.r.t. integratation origins.
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
+ * \param denseOutputStateInterpolatorFunction Function creating interpolators that evaluate the dense output of the
+ * integrator, for the Cartesian state starting at the given row (see
+ * SingleArcSimulationResults::setDenseOutputStateInterpolatorFunction). If provided, it is used (instead of interpolating
+ * equationsOfMotionNumericalSolution) for each body that requires no frame translation, and has a tabulated ephemeris with
+ * double state and time. Rows of the dense output must correspond to those of equationsOfMotionNumericalSolution.
  */
 template< typename TimeType, typename StateScalarType >
 void createAndSetInterpolatorsForEphemerides(
@@ -309,25 +428,43 @@ void createAndSetInterpolatorsForEphemerides(
         const std::vector< std::string >& bodiesToIntegrate,
         const int startIndex,
         const std::vector< std::string >& ephemerisUpdateOrder,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
         const std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
         integrationToEphemerisFrameFunctions =
-        std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ) )
+        std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ),
+        const std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >& denseOutputStateInterpolatorFunction = nullptr )
 {
     using namespace tudat::interpolators;
     
-    std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > > ephemerisInput;
+    std::vector< Eigen::Matrix< StateScalarType, 6, 1 > > ephemerisStates;
     int bodyIndex;
     
     // Iterate over all bodies that are integrated numerically and create state interpolator.
     for( unsigned int i = 0; i < ephemerisUpdateOrder.size( ); i++ )
     {
-        ephemerisInput.clear( );
-        getSingleBodyStateHistoryFromPropagationOutpiut(
-                    bodiesToIntegrate, startIndex, ephemerisUpdateOrder.at( i ), equationsOfMotionNumericalSolution,
-                    ephemerisInput, bodyIndex, integrationToEphemerisFrameFunctions );
-        resetIntegratedEphemerisOfBody(
-                    bodies, ephemerisInput, bodiesToIntegrate.at( bodyIndex ) );
+        // Evaluate dense output of integrator directly, if possible
+        std::shared_ptr< ephemerides::TabulatedCartesianEphemeris< double, double > > denseOutputEphemeris;
+        if( denseOutputStateInterpolatorFunction != nullptr &&
+                integrationToEphemerisFrameFunctions.count( ephemerisUpdateOrder.at( i ) ) == 0 )
+        {
+            denseOutputEphemeris = std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< double, double > >(
+                        bodies.at( ephemerisUpdateOrder.at( i ) )->getEphemeris( ) );
+        }
+
+        if( denseOutputEphemeris != nullptr )
+        {
+            bodyIndex = std::distance( bodiesToIntegrate.begin( ), std::find(
+                                           bodiesToIntegrate.begin( ), bodiesToIntegrate.end( ), ephemerisUpdateOrder.at( i ) ) );
+            denseOutputEphemeris->resetInterpolator( denseOutputStateInterpolatorFunction( startIndex + 6 * bodyIndex ) );
+        }
+        else
+        {
+            getSingleBodyStateHistoryFromPropagationOutpiut(
+                        bodiesToIntegrate, startIndex, ephemerisUpdateOrder.at( i ), equationsOfMotionNumericalSolution,
+                        ephemerisStates, bodyIndex, integrationToEphemerisFrameFunctions );
+            resetIntegratedEphemerisOfBody(
+                        bodies, equationsOfMotionNumericalSolution.getTimes( ), ephemerisStates, bodiesToIntegrate.at( bodyIndex ) );
+        }
     }
 }
 
@@ -345,17 +482,20 @@ void createAndSetInterpolatorsForEphemerides(
  * motion, in Cartesian elements w.r.t. integratation origins.
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
+ * \param denseOutputStateInterpolatorFunction Function creating interpolators that evaluate the dense output of the
+ * integrator (see createAndSetInterpolatorsForEphemerides; nullptr if not used).
  */
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedEphemerides(
         const simulation_setup::SystemOfBodies& bodies,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
         const std::vector< std::string >& bodiesToIntegrate,
         const std::pair< unsigned int, unsigned int > startIndexAndSize,
         std::vector< std::string > ephemerisUpdateOrder = std::vector< std::string >( ),
         const std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
         integrationToEphemerisFrameFunctions =
-        std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ) )
+        std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ),
+        const std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >& denseOutputStateInterpolatorFunction = nullptr )
 {
     // Set update order arbitrarily if no order is provided.
     if( ephemerisUpdateOrder.size( ) == 0 )
@@ -368,7 +508,7 @@ void resetIntegratedEphemerides(
         throw std::runtime_error( "Error when resetting ephemerides, input vectors have inconsistent size" );
     }
     
-    if( static_cast< unsigned int >( equationsOfMotionNumericalSolution.begin( )->second.rows( ) )
+    if( static_cast< unsigned int >( equationsOfMotionNumericalSolution.getNumberOfRows( ) )
             < startIndexAndSize.first + startIndexAndSize.second )
     {
         throw std::runtime_error( "Error when resetting ephemerides, input solution inconsistent with start index and size." );
@@ -383,7 +523,8 @@ void resetIntegratedEphemerides(
     // Create interpolators from numerical integration results (states) at discrete times.
     createAndSetInterpolatorsForEphemerides(
                 bodies, bodiesToIntegrate, startIndexAndSize.first, ephemerisUpdateOrder,
-                equationsOfMotionNumericalSolution, integrationToEphemerisFrameFunctions );
+                equationsOfMotionNumericalSolution, integrationToEphemerisFrameFunctions,
+                denseOutputStateInterpolatorFunction );
 }
 
 //! Resets the ephemerides of the integrated bodies from the numerical multi-arc integration results.
@@ -575,22 +716,24 @@ void resetIntegratedRotationalEphemerisOfBody(
  * integrated states.
  * \param startIndex Index in entries of equationsOfMotionNumericalSolution where the rotational states start.
  * \param bodyIndex Index of integrated body for which the state is to be retrieved
- * \param ephemerisTable State history of body bodyIndex w.r.t. the origin with which its ephemeris is defined
+ * \param ephemerisStates Rotational state history of body bodyIndex, at the epochs of equationsOfMotionNumericalSolution
  * (returned by reference).
- * \param equationsOfMotionNumericalSolution Full numerical solution of numerical integrator,
- * already converted to Cartesian states (w.r.t. the integration origin of the body of bodyIndex)
+ * \param equationsOfMotionNumericalSolution Full numerical solution of numerical integrator, in global representation
 */
 template< typename TimeType, typename StateScalarType >
 void convertNumericalSolutionToRotationalEphemerisInput(
         const int startIndex,
         const int bodyIndex,
-        std::map< TimeType, Eigen::Matrix< StateScalarType, 7, 1 > >& ephemerisTable,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution )
+        std::vector< Eigen::Matrix< StateScalarType, 7, 1 > >& ephemerisStates,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution )
 {
-    for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator bodyIterator =
-         equationsOfMotionNumericalSolution.begin( ); bodyIterator != equationsOfMotionNumericalSolution.end( ); bodyIterator++ )
+    Eigen::Map< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > solutionMatrix =
+            equationsOfMotionNumericalSolution.getValuesMatrix( );
+
+    ephemerisStates.resize( solutionMatrix.cols( ) );
+    for( unsigned int i = 0; i < ephemerisStates.size( ); i++ )
     {
-        ephemerisTable[ bodyIterator->first ] = bodyIterator->second.block( startIndex + 7 * bodyIndex, 0, 7, 1 );
+        ephemerisStates[ i ] = solutionMatrix.block( startIndex + 7 * bodyIndex, i, 7, 1 );
     }
 }
 
@@ -616,6 +759,20 @@ std::shared_ptr< interpolators::OneDimensionalInterpolator< TimeType, Eigen::Mat
 createRotationalStateInterpolator(
         const std::map< TimeType, Eigen::Matrix< StateScalarType, 7, 1 > >& stateMap );
 
+//! Function to create an interpolator for the new rotational state of a body.
+/*!
+ * Function to create an interpolator for the new rotational state of a body, from the epochs and states given as
+ * separate vectors.
+ * \param times Epochs of new rotational state history, in increasing order.
+ * \param states New rotational state history (at epochs given by times).
+ * \return Lagrange interpolator (order 6) that produces the required continuous rotational state.
+ */
+template< typename TimeType, typename StateScalarType >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< TimeType, Eigen::Matrix< StateScalarType, 7, 1 > > >
+createRotationalStateInterpolator(
+        const std::vector< TimeType >& times,
+        const std::vector< Eigen::Matrix< StateScalarType, 7, 1 > >& states );
+
 //! Function to reset the tabulated rotational ephemeris of a body
 /*!
  * Function to reset the tabulated rotational ephemeris of a body
@@ -629,20 +786,20 @@ void createAndSetInterpolatorsForRotationalEphemerides(
         const simulation_setup::SystemOfBodies& bodies,
         const std::vector< std::string >& bodiesToIntegrate,
         const int startIndex,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution )
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution )
 {
     using namespace tudat::interpolators;
     
     // Iterate over all bodies that are integrated numerically and create state interpolator.
+    std::vector< Eigen::Matrix< StateScalarType, 7, 1 > > ephemerisStates;
     for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
     {
-        std::map< TimeType, Eigen::Matrix< StateScalarType, 7, 1 > > ephemerisInput;
-        convertNumericalSolutionToRotationalEphemerisInput( startIndex, i, ephemerisInput, equationsOfMotionNumericalSolution );
+        convertNumericalSolutionToRotationalEphemerisInput( startIndex, i, ephemerisStates, equationsOfMotionNumericalSolution );
 
         // Create interpolator.
         std::shared_ptr< OneDimensionalInterpolator< TimeType, Eigen::Matrix< StateScalarType, 7, 1 > > >
                 ephemerisInterpolator = createRotationalStateInterpolator(
-                    ephemerisInput );
+                    equationsOfMotionNumericalSolution.getTimes( ), ephemerisStates );
         
         resetIntegratedRotationalEphemerisOfBody( bodies, ephemerisInterpolator, bodiesToIntegrate.at( i ) );
     }
@@ -662,7 +819,7 @@ void createAndSetInterpolatorsForRotationalEphemerides(
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedRotationalEphemerides(
         const simulation_setup::SystemOfBodies& bodies,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
         const std::vector< std::string >& bodiesToIntegrate,
         const std::pair< unsigned int, unsigned int > startIndexAndSize )
 {
@@ -691,7 +848,7 @@ void resetIntegratedRotationalEphemerides(
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedBodyMass(
         const simulation_setup::SystemOfBodies& bodies,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
         const std::vector< std::string >& bodiesToIntegrate ,
         const std::pair< unsigned int, unsigned int > startIndexAndSize )
 {
@@ -700,18 +857,27 @@ void resetIntegratedBodyMass(
         throw std::runtime_error( "Error when resetting body masses, number of bodies inconsistent with input size." );
     }
     
+    const std::vector< TimeType >& times = equationsOfMotionNumericalSolution.getTimes( );
+    Eigen::Map< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > solutionMatrix =
+            equationsOfMotionNumericalSolution.getValuesMatrix( );
+
+    // Create vector of epochs with double entries.
+    std::vector< double > massTimes;
+    massTimes.reserve( times.size( ) );
+    for( unsigned int j = 0; j < times.size( ); j++ )
+    {
+        massTimes.push_back( static_cast< double >( times.at( j ) ) );
+    }
+
     // Iterate over all bodies for which mass is propagated.
     for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
     {
-        std::map< double, double > currentBodyMassMap;
-        
-        // Create mass map with double entries.
-        for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator
-             stateIterator = equationsOfMotionNumericalSolution.begin( );
-             stateIterator != equationsOfMotionNumericalSolution.end( ); stateIterator++ )
+        // Create mass history with double entries.
+        std::vector< double > currentBodyMasses;
+        currentBodyMasses.reserve( times.size( ) );
+        for( unsigned int j = 0; j < times.size( ); j++ )
         {
-            currentBodyMassMap[ static_cast< double >( stateIterator->first ) ] =
-                    static_cast< double >( stateIterator->second( startIndexAndSize.first + i ) );
+            currentBodyMasses.push_back( static_cast< double >( solutionMatrix( startIndexAndSize.first + i, j ) ) );
         }
         
         typedef interpolators::OneDimensionalInterpolator< double, double > LocalInterpolator;
@@ -721,7 +887,8 @@ void resetIntegratedBodyMass(
                     std::bind(
                         static_cast< double( LocalInterpolator::* )( const double ) >
                         ( &LocalInterpolator::interpolate ),
-                        std::make_shared< interpolators::LagrangeInterpolatorDouble >( currentBodyMassMap, 6 ), std::placeholders::_1 ) );
+                        std::make_shared< interpolators::LagrangeInterpolatorDouble >( massTimes, currentBodyMasses, 6 ),
+                        std::placeholders::_1 ) );
     }
 }
 
@@ -797,8 +964,7 @@ public:
      * convertToOutputSolution function in associated SingleStateTypeDerivative derived class.
      */
     virtual void processIntegratedStates(
-            const std::map< TimeType, Eigen::Matrix< StateScalarType,
-            Eigen::Dynamic, 1 > >& numericalSolution ) = 0;
+            const utilities::ContiguousStateHistory< TimeType, StateScalarType >& numericalSolution ) = 0;
 
     //! List of bodies used in simulations.
     simulation_setup::SystemOfBodies bodies_;
@@ -911,12 +1077,28 @@ public:
      * convertToOutputSolution function in NBodyStateDerivative class.
      */
     void processIntegratedStates(
-            const std::map< TimeType,
-            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
+            const utilities::ContiguousStateHistory< TimeType, StateScalarType >& numericalSolution )
+    {
+        processIntegratedStates( numericalSolution, nullptr );
+    }
+
+    //! Function processing single-arc translational state, resetting bodies' ephemerides from the dense output, if possible
+    /*!
+     * Function processing single-arc translational state, resetting bodies' ephemerides with new states, evaluating the dense
+     * output of the integrator where possible (see createAndSetInterpolatorsForEphemerides), and interpolating the states
+     * in numericalSolution otherwise.
+     * \param numericalSolution Full numerical solution, in global representation (see
+     * convertToOutputSolution function in NBodyStateDerivative class.
+     * \param denseOutputStateInterpolatorFunction Function creating interpolators that evaluate the dense output of the
+     * integrator (nullptr if not used).
+     */
+    void processIntegratedStates(
+            const utilities::ContiguousStateHistory< TimeType, StateScalarType >& numericalSolution,
+            const std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >& denseOutputStateInterpolatorFunction )
     {
         resetIntegratedEphemerides< TimeType, StateScalarType >(
                     this->bodies_, numericalSolution, this->bodiesToIntegrate_, this->startIndexAndSize_, ephemerisUpdateOrder_,
-                    integrationToEphemerisFrameFunctions_ );
+                    integrationToEphemerisFrameFunctions_, denseOutputStateInterpolatorFunction );
     }
 
     std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > > getIntegrationToEphemerisFrameFunctions( )
@@ -1102,7 +1284,7 @@ public:
      * convertToOutputSolution function in RotationalMotionStateDerivative class.
      */
     void processIntegratedStates(
-            const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
+            const utilities::ContiguousStateHistory< TimeType, StateScalarType >& numericalSolution )
     {
         resetIntegratedRotationalEphemerides< TimeType, StateScalarType >(
                     this->bodies_, numericalSolution, this->bodiesToIntegrate_, this->startIndexAndSize_ );
@@ -1144,7 +1326,7 @@ public:
      * for mass).
      */
     void processIntegratedStates(
-            const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
+            const utilities::ContiguousStateHistory< TimeType, StateScalarType >& numericalSolution )
     {
         resetIntegratedBodyMass( this->bodies_, numericalSolution, this->bodiesToIntegrate_, this->startIndexAndSize_ );
     }
@@ -1596,22 +1778,36 @@ createMultiArcIntegratedStateProcessors(
  * Function to reset the dynamical properties of the environment from the numerically integrated
  * dynamics solution
  * \param equationsOfMotionNumericalSolution Solution produced by the numerical integration, in the
- * 'conventional form'
+ * 'conventional form', ordered in increasing time
  * \sa SingleStateTypeDerivative::convertToOutputSolution
  * \param integratedStateProcessors List of objects (per dynamics type) used to process integrated
  * results into environment
+ * \param denseOutputStateInterpolatorFunction Function creating interpolators that evaluate the dense output of the
+ * integrator, used to reset the translational states (see TranslationalStateIntegratedStateProcessor; nullptr if not used).
  */
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedStates(
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const utilities::ContiguousStateHistory< TimeType, StateScalarType >& equationsOfMotionNumericalSolution,
         const std::map< IntegratedStateType, std::shared_ptr<
-        SingleArcIntegratedStateProcessor< TimeType, StateScalarType > > > integratedStateProcessors )
+        SingleArcIntegratedStateProcessor< TimeType, StateScalarType > > > integratedStateProcessors,
+        const std::function< std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( const int ) >& denseOutputStateInterpolatorFunction = nullptr )
 {
     for( typename std::map< IntegratedStateType, std::shared_ptr< SingleArcIntegratedStateProcessor<
          TimeType, StateScalarType > > >::const_iterator updateIterator = integratedStateProcessors.begin( );
          updateIterator != integratedStateProcessors.end( ); updateIterator++ )
     {
-        updateIterator->second->processIntegratedStates( equationsOfMotionNumericalSolution );
+        std::shared_ptr< TranslationalStateIntegratedStateProcessor< TimeType, StateScalarType > > translationalStateProcessor =
+                std::dynamic_pointer_cast< TranslationalStateIntegratedStateProcessor< TimeType, StateScalarType > >(
+                    updateIterator->second );
+        if( denseOutputStateInterpolatorFunction != nullptr && translationalStateProcessor != nullptr )
+        {
+            translationalStateProcessor->processIntegratedStates(
+                        equationsOfMotionNumericalSolution, denseOutputStateInterpolatorFunction );
+        }
+        else
+        {
+            updateIterator->second->processIntegratedStates( equationsOfMotionNumericalSolution );
+        }
     }
 }
 
@@ -8,6 +8,7 @@
  *    http://tudat.tudelft.nl/LICENSE.
  */
 
+#include <cmath>
 #include <stdexcept>
 
 #include "tudat/astro/aerodynamics/exponentialAtmosphere.h"
@@ -72,6 +73,23 @@ ExponentialAtmosphere::ExponentialAtmosphere(
     }
 }
 
+//! Get density at a list of points.
+void ExponentialAtmosphere::getDensities( const double* altitudes, const double* longitudes,
+                                          const double* latitudes, const double* times,
+                                          double* densities, const int numberOfPoints )
+{
+    TUDAT_UNUSED_PARAMETER( longitudes );
+    TUDAT_UNUSED_PARAMETER( latitudes );
+    TUDAT_UNUSED_PARAMETER( times );
+    processPointsInBlocks( numberOfPoints, [ & ]( const int firstPoint, const int endPoint )
+    {
+        for( int i = firstPoint; i < endPoint; i++ )
+        {
+            densities[ i ] = densityAtZeroAltitude_ * std::exp( -altitudes[ i ] / scaleHeight_ );
+        }
+    } );
+}
+
 } // namespace aerodynamics
 
 } // namespace tudat
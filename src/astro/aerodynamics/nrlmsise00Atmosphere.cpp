@@ -11,6 +11,7 @@
 #include "tudat/astro/aerodynamics/nrlmsise00Atmosphere.h"
 #include "tudat/math/basic/mathematicalConstants.h"
 #include <iostream>
+#include <numeric>
 
 //! Tudat library namespace.
 namespace tudat
@@ -18,6 +19,39 @@ namespace tudat
 namespace aerodynamics
 {
 
+namespace
+{
+
+//! Maximum number of bisections of a cell of the unrefined density grid.
+const int maximumNumberOfDensityGridRefinements = 24;
+
+//! Maximum number of density grid nodes that are stored, before the grid is cleared.
+const unsigned int maximumNumberOfDensityGridNodes = 1 << 20;
+
+//! Function to set the input structures of the NRLMSISE00 model from the Tudat input data and position.
+void setNRLMSISE00ModelInput( const NRLMSISE00Input& inputData,
+                              const double altitude, const double longitude, const double latitude,
+                              nrlmsise_input& input, nrlmsise_flags& flags, ap_array& aph )
+{
+    std::copy( inputData.apVector.begin( ), inputData.apVector.begin( ) +
+               std::min( inputData.apVector.size( ), sizeof aph.a / sizeof aph.a[ 0 ] ), aph.a );
+    std::copy( inputData.switches.begin( ), inputData.switches.end( ), flags.switches);
+
+    input.g_lat  = latitude * 180.0 / mathematical_constants::PI; // rad to deg
+    input.g_long = longitude * 180.0 / mathematical_constants::PI; // rad to deg
+    input.alt    = altitude * 1.0E-3; // m to km
+    input.year   = inputData.year;
+    input.doy    = inputData.dayOfTheYear;
+    input.sec    = inputData.secondOfTheDay;
+    input.lst    = inputData.localSolarTime;
+    input.f107   = inputData.f107;
+    input.f107A  = inputData.f107a;
+    input.ap     = inputData.apDaily;
+    input.ap_a   = &aph;
+}
+
+} // namespace
+
 void NRLMSISE00Atmosphere::computeProperties(
         const double altitude, const double longitude,
         const double latitude, const double time )
@@ -32,23 +66,17 @@ void NRLMSISE00Atmosphere::computeProperties(
     }
     hashKey_ = hashKey;
 
-    // Retrieve input data.
-    inputData_ = nrlmsise00InputFunction_(
-                altitude, longitude, latitude, time );
-    std::copy( inputData_.apVector.begin( ), inputData_.apVector.end( ), aph_.a );
-    std::copy( inputData_.switches.begin( ), inputData_.switches.end( ), flags_.switches);
-
-    input_.g_lat  = latitude * 180.0 / mathematical_constants::PI; // rad to deg
-    input_.g_long = longitude * 180.0 / mathematical_constants::PI; // rad to deg
-    input_.alt    = altitude * 1.0E-3; // m to km
-    input_.year   = inputData_.year;
-    input_.doy    = inputData_.dayOfTheYear;
-    input_.sec    = inputData_.secondOfTheDay;
-    input_.lst    = inputData_.localSolarTime;
-    input_.f107   = inputData_.f107;
-    input_.f107A  = inputData_.f107a;
-    input_.ap     = inputData_.apDaily;
-    input_.ap_a   = &aph_;
+    // Retrieve input data (directly from preprocessed solar activity data, if available).
+    if( solarActivityTable_ != nullptr )
+    {
+        solarActivityTable_->updateInput( inputData_, time, longitude );
+    }
+    else
+    {
+        inputData_ = nrlmsise00InputFunction_(
+                    altitude, longitude, latitude, time );
+    }
+    setNRLMSISE00ModelInput( inputData_, altitude, longitude, latitude, input_, flags_, aph_ );
 
     // Call NRLMSISE00
     gtd7(&input_, &flags_, &output_);
@@ -116,6 +144,310 @@ void NRLMSISE00Atmosphere::computeProperties(
     }
 }
 
+//! Function to set the density to be computed by interpolation on an adaptive local grid.
+void NRLMSISE00Atmosphere::setDensityInterpolation( const double relativeTolerance,
+                                                    const double initialAltitudeStep,
+                                                    const double initialAngularStep,
+                                                    const double initialTimeStep )
+{
+    if( relativeTolerance != relativeTolerance )
+    {
+        useDensityInterpolation_ = false;
+        return;
+    }
+
+    if( solarActivityTable_ == nullptr )
+    {
+        throw std::runtime_error( "Error when setting NRLMSISE00 density interpolation, model must be created from "
+                                  "solar activity data." );
+    }
+    if( !( relativeTolerance > 0.0 ) || !( initialAltitudeStep > 0.0 ) || !( initialAngularStep > 0.0 ) ||
+            !( initialTimeStep > 0.0 ) )
+    {
+        throw std::runtime_error( "Error when setting NRLMSISE00 density interpolation, tolerance and step sizes must "
+                                  "be positive." );
+    }
+
+    // Round time step down to 86400 s divided by a power of 2
+    double timeStep = physical_constants::JULIAN_DAY;
+    while( timeStep > initialTimeStep )
+    {
+        timeStep /= 2.0;
+    }
+
+    useDensityInterpolation_ = true;
+    densityInterpolationTolerance_ = relativeTolerance;
+    densityGridStepSizes_ = { { initialAltitudeStep, initialAngularStep, initialAngularStep, timeStep } };
+    densityGridNodeValues_.clear( );
+    densityGridCellRefinements_.clear( );
+    isDensityGridCellSet_ = false;
+    numberOfDensityGridModelEvaluations_ = 0;
+}
+
+//! Get density at a list of points.
+void NRLMSISE00Atmosphere::getDensities( const double* altitudes, const double* longitudes,
+                                         const double* latitudes, const double* times,
+                                         double* densities, const int numberOfPoints )
+{
+    if( useDensityInterpolation_ )
+    {
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            densities[ i ] = computeInterpolatedDensity( altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+        }
+    }
+    else if( solarActivityTable_ != nullptr )
+    {
+        NRLMSISE00Input inputData = inputData_;
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            solarActivityTable_->updateInput( inputData, times[ i ], longitudes[ i ] );
+            densities[ i ] = computeFullModelDensity( inputData, altitudes[ i ], longitudes[ i ], latitudes[ i ] );
+        }
+    }
+    else
+    {
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            densities[ i ] = computeFullModelDensity(
+                        nrlmsise00InputFunction_( altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] ),
+                        altitudes[ i ], longitudes[ i ], latitudes[ i ] );
+        }
+    }
+}
+
+//! Function to compute the density using the full model, without modifying the current atmospheric properties.
+double NRLMSISE00Atmosphere::computeFullModelDensity( const NRLMSISE00Input& inputData, const double altitude,
+                                                      const double longitude, const double latitude )
+{
+    nrlmsise_input input;
+    nrlmsise_flags flags;
+    ap_array aph;
+    nrlmsise_output output;
+    setNRLMSISE00ModelInput( inputData, altitude, longitude, latitude, input, flags, aph );
+
+    gtd7( &input, &flags, &output );
+    return output.d[ 5 ] * 1000.0; // GM/CM3 to kg/M3
+}
+
+//! Function to compute the density by interpolation on the density grid (building the grid cell if required).
+double NRLMSISE00Atmosphere::computeInterpolatedDensity( const double altitude, const double longitude,
+                                                         const double latitude, const double time )
+{
+    // Compute grid coordinates, using local solar time angle (in [0, 2 pi)) instead of longitude
+    const int dayNumber = solarActivityTable_->getDayNumber( time );
+    const double secondOfTheDay = solarActivityTable_->getSecondOfTheDay( time, dayNumber );
+    double localSolarTimeAngle = std::fmod(
+                longitude + secondOfTheDay * 2.0 * mathematical_constants::PI / physical_constants::JULIAN_DAY,
+                2.0 * mathematical_constants::PI );
+    if( localSolarTimeAngle < 0.0 )
+    {
+        localSolarTimeAngle += 2.0 * mathematical_constants::PI;
+    }
+    const std::array< double, 4 > gridCoordinates = { { altitude, localSolarTimeAngle, latitude, secondOfTheDay } };
+
+    // Update grid cell if point is not in current grid cell
+    bool isPointInCurrentCell = isDensityGridCellSet_ && ( dayNumber == currentDensityGridCell_[ 8 ] );
+    for( int i = 0; i < 4 && isPointInCurrentCell; i++ )
+    {
+        isPointInCurrentCell = ( static_cast< int64_t >( std::floor( gridCoordinates[ i ] / currentDensityGridCellStepSizes_[ i ] ) )
+                                 == currentDensityGridCell_[ i ] );
+    }
+    if( !isPointInCurrentCell )
+    {
+        updateDensityGridCell( gridCoordinates, dayNumber );
+    }
+
+    // Compute position in grid cell
+    std::array< double, 4 > cellFractions;
+    for( int i = 0; i < 4; i++ )
+    {
+        cellFractions[ i ] = gridCoordinates[ i ] / currentDensityGridCellStepSizes_[ i ] -
+                static_cast< double >( currentDensityGridCell_[ i ] );
+    }
+
+    // Interpolate logarithm of density multi-linearly, one dimension at a time
+    std::array< double, 16 > values = currentDensityGridCellValues_;
+    int numberOfValues = 16;
+    for( int i = 0; i < 4; i++ )
+    {
+        numberOfValues /= 2;
+        for( int j = 0; j < numberOfValues; j++ )
+        {
+            values[ j ] = ( 1.0 - cellFractions[ i ] ) * values[ 2 * j ] + cellFractions[ i ] * values[ 2 * j + 1 ];
+        }
+    }
+    return std::exp( values[ 0 ] );
+}
+
+//! Function to set the current grid cell, and the logarithm of the density at its nodes.
+void NRLMSISE00Atmosphere::updateDensityGridCell( const std::array< double, 4 >& gridCoordinates, const int dayNumber )
+{
+    // Limit memory usage by discarding the full grid when it becomes too large.
+    if( densityGridNodeValues_.size( ) >= maximumNumberOfDensityGridNodes )
+    {
+        densityGridNodeValues_.clear( );
+        densityGridCellRefinements_.clear( );
+    }
+
+    // Function to set indices of grid cell containing the point, at the current refinement levels
+    std::array< int, 4 > refinementLevels = { { 0, 0, 0, 0 } };
+    auto setCurrentCell = [ & ]( )
+    {
+        for( int i = 0; i < 4; i++ )
+        {
+            currentDensityGridCellStepSizes_[ i ] = std::ldexp( densityGridStepSizes_[ i ], -refinementLevels[ i ] );
+            currentDensityGridCell_[ i ] = static_cast< int64_t >(
+                        std::floor( gridCoordinates[ i ] / currentDensityGridCellStepSizes_[ i ] ) );
+            currentDensityGridCell_[ i + 4 ] = refinementLevels[ i ];
+        }
+        currentDensityGridCell_[ 8 ] = dayNumber;
+    };
+
+    // Descend from cell of unrefined grid, through the cells that have been bisected
+    int numberOfBisections = 0;
+    while( true )
+    {
+        setCurrentCell( );
+        std::unordered_map< std::array< int64_t, 9 >, int, DensityGridIndicesHash >::const_iterator cellIterator =
+                densityGridCellRefinements_.find( currentDensityGridCell_ );
+        if( cellIterator != densityGridCellRefinements_.end( ) && cellIterator->second >= 0 )
+        {
+            refinementLevels[ cellIterator->second ]++;
+            numberOfBisections++;
+            continue;
+        }
+
+        // Retrieve density at nodes of grid cell (with node index bit i denoting upper node in dimension i)
+        for( int node = 0; node < 16; node++ )
+        {
+            std::array< int64_t, 9 > nodeIndices = currentDensityGridCell_;
+            for( int i = 0; i < 4; i++ )
+            {
+                nodeIndices[ i ] += ( node >> i ) & 1;
+            }
+            currentDensityGridCellValues_[ node ] = getDensityGridNodeValue( nodeIndices );
+        }
+        isDensityGridCellSet_ = true;
+
+        if( cellIterator != densityGridCellRefinements_.end( ) )
+        {
+            break;
+        }
+
+        // Check interpolation error for new cell
+        std::array< double, 4 > interpolationErrors;
+        if( estimateDensityGridCellError( interpolationErrors ) <= densityInterpolationTolerance_ ||
+                numberOfBisections >= maximumNumberOfDensityGridRefinements )
+        {
+            densityGridCellRefinements_[ currentDensityGridCell_ ] = -1;
+            break;
+        }
+
+        // Bisect cell in dimension with largest error, and repeat (without checking the intermediate cells) while the
+        // predicted error (scaling with square of step size) exceeds tolerance; the resulting cell is checked above.
+        do
+        {
+            const int refinementDimension = static_cast< int >( std::distance(
+                        interpolationErrors.begin( ),
+                        std::max_element( interpolationErrors.begin( ), interpolationErrors.end( ) ) ) );
+            densityGridCellRefinements_[ currentDensityGridCell_ ] = refinementDimension;
+            interpolationErrors[ refinementDimension ] /= 4.0;
+            refinementLevels[ refinementDimension ]++;
+            numberOfBisections++;
+            setCurrentCell( );
+        }
+        while( std::accumulate( interpolationErrors.begin( ), interpolationErrors.end( ), 0.0 ) >
+               densityInterpolationTolerance_ && numberOfBisections < maximumNumberOfDensityGridRefinements &&
+               densityGridCellRefinements_.count( currentDensityGridCell_ ) == 0 );
+    }
+}
+
+//! Function to estimate the interpolation error in the current grid cell, from full model evaluations.
+double NRLMSISE00Atmosphere::estimateDensityGridCellError( std::array< double, 4 >& interpolationErrors )
+{
+    // The center and edge midpoints of the cell are nodes of the grid refined once in each (or a single) dimension, so
+    // they are retrieved as such: they are reused as nodes when the cell is bisected, and shared with neighbouring cells.
+    std::array< int64_t, 9 > centerIndices = currentDensityGridCell_;
+    for( int j = 0; j < 4; j++ )
+    {
+        centerIndices[ j ] = 2 * centerIndices[ j ] + 1;
+        centerIndices[ j + 4 ]++;
+    }
+
+    // Estimate error at center of cell (where interpolated value is mean of node values)
+    const double centerError = std::fabs(
+                getDensityGridNodeValue( centerIndices ) -
+                std::accumulate( currentDensityGridCellValues_.begin( ), currentDensityGridCellValues_.end( ), 0.0 ) / 16.0 );
+
+    // Estimate error along each dimension, at midpoint of an edge (through lowest node for even dimensions, and through
+    // highest node for odd dimensions, so that the edges do not all meet at a single node)
+    double totalEdgeError = 0.0;
+    for( int i = 0; i < 4; i++ )
+    {
+        const int lowerNode = ( i % 2 == 0 ) ? 0 : ( 15 & ~( 1 << i ) );
+        std::array< int64_t, 9 > edgeMidpointIndices = currentDensityGridCell_;
+        for( int j = 0; j < 4; j++ )
+        {
+            edgeMidpointIndices[ j ] += ( lowerNode >> j ) & 1;
+        }
+        edgeMidpointIndices[ i ] = centerIndices[ i ];
+        edgeMidpointIndices[ i + 4 ] = centerIndices[ i + 4 ];
+
+        interpolationErrors[ i ] = std::fabs(
+                    getDensityGridNodeValue( edgeMidpointIndices ) -
+                    0.5 * ( currentDensityGridCellValues_[ lowerNode ] +
+                            currentDensityGridCellValues_[ lowerNode | ( 1 << i ) ] ) );
+        totalEdgeError += interpolationErrors[ i ];
+    }
+
+    return std::max( centerError, totalEdgeError );
+}
+
+//! Function to retrieve the logarithm of the density at a node of the grid, computing it if not yet available.
+double NRLMSISE00Atmosphere::getDensityGridNodeValue( const std::array< int64_t, 9 >& nodeIndices )
+{
+    // Reduce node indices to the lowest refinement level at which the node exists, so that nodes are shared between levels
+    std::array< int64_t, 9 > reducedNodeIndices = nodeIndices;
+    for( int i = 0; i < 4; i++ )
+    {
+        while( reducedNodeIndices[ i + 4 ] > 0 && reducedNodeIndices[ i ] % 2 == 0 )
+        {
+            reducedNodeIndices[ i ] /= 2;
+            reducedNodeIndices[ i + 4 ]--;
+        }
+    }
+
+    std::unordered_map< std::array< int64_t, 9 >, double, DensityGridIndicesHash >::const_iterator nodeIterator =
+            densityGridNodeValues_.find( reducedNodeIndices );
+    if( nodeIterator != densityGridNodeValues_.end( ) )
+    {
+        return nodeIterator->second;
+    }
+
+    std::array< double, 4 > nodeCoordinates;
+    for( int i = 0; i < 4; i++ )
+    {
+        nodeCoordinates[ i ] = static_cast< double >( reducedNodeIndices[ i ] ) *
+                std::ldexp( densityGridStepSizes_[ i ], -reducedNodeIndices[ i + 4 ] );
+    }
+    const double nodeValue = computeDensityGridValue( nodeCoordinates, static_cast< int >( reducedNodeIndices[ 8 ] ) );
+    densityGridNodeValues_[ reducedNodeIndices ] = nodeValue;
+    return nodeValue;
+}
+
+//! Function to compute the logarithm of the density at given grid coordinates using the full model.
+double NRLMSISE00Atmosphere::computeDensityGridValue( const std::array< double, 4 >& gridCoordinates,
+                                                      const int dayNumber )
+{
+    numberOfDensityGridModelEvaluations_++;
+    const double longitude = gridCoordinates[ 1 ] -
+            gridCoordinates[ 3 ] * 2.0 * mathematical_constants::PI / physical_constants::JULIAN_DAY;
+    solarActivityTable_->updateInput( densityGridInputData_, dayNumber, gridCoordinates[ 3 ], longitude );
+    return std::log( computeFullModelDensity(
+                         densityGridInputData_, gridCoordinates[ 0 ], longitude, gridCoordinates[ 2 ] ) );
+}
+
 //! Overloaded ostream to print class information.
 std::ostream& operator << ( std::ostream& stream,
                             NRLMSISE00Input& nrlmsiseInput ){
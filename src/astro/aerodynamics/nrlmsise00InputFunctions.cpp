@@ -105,5 +105,124 @@ NRLMSISE00Input nrlmsiseInputFunction( const double altitude, const double longi
     return nrlmsiseInputData;
 }
 
+//! Constructor, preprocesses the solar activity data.
+NRLMSISE00SolarActivityTable::NRLMSISE00SolarActivityTable(
+        const tudat::input_output::solar_activity::SolarActivityDataMap& solarActivityMap )
+{
+    using namespace tudat::input_output::solar_activity;
+
+    if( solarActivityMap.empty( ) )
+    {
+        throw std::runtime_error( "Error when creating NRLMSISE00 solar activity table, no solar activity data provided." );
+    }
+
+    firstJulianDay_ = solarActivityMap.begin( )->first;
+    const int numberOfDays = static_cast< int >( std::round( solarActivityMap.rbegin( )->first - firstJulianDay_ ) ) + 1;
+    dailyInputs_.resize( numberOfDays );
+
+    // Retrieve data for each day, using data of next available day if data is missing (as in nrlmsiseInputFunction)
+    SolarActivityDataMap::const_iterator activityIterator = solarActivityMap.begin( );
+    for( int dayNumber = 0; dayNumber < numberOfDays; dayNumber++ )
+    {
+        const double julianDay = firstJulianDay_ + static_cast< double >( dayNumber );
+        while( activityIterator->first < julianDay )
+        {
+            activityIterator++;
+        }
+        const SolarActivityDataPtr solarActivity = activityIterator->second;
+
+        DailyInput& dailyInput = dailyInputs_[ dayNumber ];
+        dailyInput.year = solarActivity->year;
+        dailyInput.julianDayOnFirstOfJanuary = tudat::basic_astrodynamics::convertCalendarDateToJulianDay(
+                    solarActivity->year, 1, 1, 0, 0, 0.0 );
+        if( solarActivity->fluxQualifier == 1 )
+        { // requires adjustment
+            dailyInput.f107 = solarActivity->solarRadioFlux107Adjusted;
+            dailyInput.f107a = solarActivity->centered81DaySolarRadioFlux107Adjusted;
+        }
+        else
+        { // no adjustment required
+            dailyInput.f107 = solarActivity->solarRadioFlux107Observed;
+            dailyInput.f107a = solarActivity->centered81DaySolarRadioFlux107Observed;
+        }
+        dailyInput.apDaily = solarActivity->planetaryEquivalentAmplitudeAverage;
+
+        if( solarActivity->planetaryEquivalentAmplitudeVector.rows( ) > 8 )
+        {
+            throw std::runtime_error( "Error when creating NRLMSISE00 solar activity table, more than 8 magnetic indices "
+                                      "provided for a single day." );
+        }
+        dailyInput.numberOfApEntries = solarActivity->planetaryEquivalentAmplitudeVector.rows( );
+        for( int i = 0; i < dailyInput.numberOfApEntries; i++ )
+        {
+            dailyInput.apVector[ i ] = solarActivity->planetaryEquivalentAmplitudeVector( i );
+        }
+    }
+}
+
+//! Function to retrieve the number of the day (since the first day of the data) in which a given time falls.
+int NRLMSISE00SolarActivityTable::getDayNumber( const double time ) const
+{
+    const double julianDate = tudat::basic_astrodynamics::convertSecondsSinceEpochToJulianDay(
+                time, basic_astrodynamics::JULIAN_DAY_ON_J2000 );
+    const double julianDay = std::floor( julianDate - 0.5 ) + 0.5;
+    const int dayNumber = static_cast< int >( std::round( julianDay - firstJulianDay_ ) );
+
+    if( dayNumber >= static_cast< int >( dailyInputs_.size( ) ) )
+    {
+        throw std::runtime_error( "Error when retrieving solar activity data at JD" + std::to_string( julianDate ) +
+                                  ", no data available" );
+    }
+    return dayNumber;
+}
+
+//! Function to retrieve the number of seconds into the day for a given time.
+double NRLMSISE00SolarActivityTable::getSecondOfTheDay( const double time, const int dayNumber ) const
+{
+    return time - tudat::basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                firstJulianDay_ + static_cast< double >( dayNumber ), tudat::basic_astrodynamics::JULIAN_DAY_ON_J2000 );
+}
+
+//! Function to update the NRLMSISE00 input to a given day, second of the day and longitude.
+void NRLMSISE00SolarActivityTable::updateInput(
+        NRLMSISE00Input& nrlmsiseInputData,
+        const int dayNumber, const double secondOfTheDay, const double longitude,
+        const bool adjustSolarTime, const double localSolarTime ) const
+{
+    const DailyInput& dailyInput = dailyInputs_[ std::max( dayNumber, 0 ) ];
+
+    nrlmsiseInputData.year = dailyInput.year;
+    nrlmsiseInputData.dayOfTheYear = firstJulianDay_ + static_cast< double >( dayNumber ) -
+            dailyInput.julianDayOnFirstOfJanuary + 1;
+    nrlmsiseInputData.secondOfTheDay = secondOfTheDay;
+    nrlmsiseInputData.f107 = dailyInput.f107;
+    nrlmsiseInputData.f107a = dailyInput.f107a;
+    nrlmsiseInputData.apDaily = dailyInput.apDaily;
+    nrlmsiseInputData.apVector.assign( dailyInput.apVector.begin( ),
+                                       dailyInput.apVector.begin( ) + dailyInput.numberOfApEntries );
+
+    // Compute local solar time
+    if( adjustSolarTime )
+    {
+        nrlmsiseInputData.localSolarTime = localSolarTime;
+    }
+    else
+    {
+        nrlmsiseInputData.localSolarTime = nrlmsiseInputData.secondOfTheDay / 3600.0
+                + longitude / ( tudat::mathematical_constants::PI / 12.0 );
+    }
+}
+
+//! NRLMSISE00 Input function, using preprocessed solar activity data.
+NRLMSISE00Input nrlmsiseInputFunctionFromTable( const double altitude, const double longitude,
+                                                const double latitude, const double time,
+                                                const std::shared_ptr< NRLMSISE00SolarActivityTable > solarActivityTable,
+                                                const bool adjustSolarTime, const double localSolarTime )
+{
+    NRLMSISE00Input nrlmsiseInputData;
+    solarActivityTable->updateInput( nrlmsiseInputData, time, longitude, adjustSolarTime, localSolarTime );
+    return nrlmsiseInputData;
+}
+
 }  // namespace aerodynamics
 }  // namespace tudat
@@ -11,6 +11,7 @@
 
 #include "tudat/astro/aerodynamics/tabulatedAtmosphere.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "tudat/io/matrixTextFileReader.h"
@@ -41,6 +42,150 @@ void checkVariableUniqueness( std::vector< VariableType > variables )
     }
 }
 
+namespace
+{
+
+//! Function to find the lower index of the interval of an ascending grid in which a value (within grid range) lies.
+/*!
+ *  Function to find the lower index of the interval of an ascending grid in which a value (within the grid range) lies,
+ *  consistent with the lookup schemes of the interpolators: the last interval is used for a value equal to the final
+ *  grid value.
+ *  \param grid Values of grid, sorted in ascending order.
+ *  \param value Value for which interval is to be found.
+ *  \param initialGuess Initial guess of lower index (typically the index found for the previous value).
+ *  \return Lower index of interval in which value lies.
+ */
+int findTableInterval( const std::vector< double >& grid, const double value, const int initialGuess )
+{
+    const int lastInterval = static_cast< int >( grid.size( ) ) - 2;
+    if ( value >= grid[ initialGuess ] && ( value < grid[ initialGuess + 1 ] || initialGuess == lastInterval ) )
+    {
+        return initialGuess;
+    }
+    return std::min( static_cast< int >( std::upper_bound( grid.begin( ), grid.end( ), value ) - grid.begin( ) ) - 1,
+                     lastInterval );
+}
+
+} // namespace
+
+//! Get density at a list of points.
+void TabulatedAtmosphere::getDensities( const double* altitudes, const double* longitudes,
+                                        const double* latitudes, const double* times,
+                                        double* densities, const int numberOfPoints )
+{
+    // Set input array for each independent variable of table
+    std::array< const double*, 4 > independentVariableInputs = { { nullptr, nullptr, nullptr, nullptr } };
+    for ( unsigned int i = 0; i < numberOfIndependentVariables_; i++ )
+    {
+        switch ( independentVariables_.at( i ) )
+        {
+        case altitude_dependent_atmosphere:
+            independentVariableInputs[ i ] = altitudes;
+            break;
+        case longitude_dependent_atmosphere:
+            independentVariableInputs[ i ] = longitudes;
+            break;
+        case latitude_dependent_atmosphere:
+            independentVariableInputs[ i ] = latitudes;
+            break;
+        case time_dependent_atmosphere:
+            independentVariableInputs[ i ] = times;
+            break;
+        }
+    }
+
+    processPointsInBlocks( numberOfPoints, [ & ]( const int firstPoint, const int endPoint )
+    {
+        computeTabulatedDensities( independentVariableInputs, densities, firstPoint, endPoint );
+    } );
+}
+
+//! Function to compute the density at a block of points, from the contiguous copy of the density table.
+void TabulatedAtmosphere::computeTabulatedDensities( const std::array< const double*, 4 >& independentVariableInputs,
+                                                     double* densities, const int firstPoint, const int endPoint )
+{
+    const int numberOfDimensions = static_cast< int >( numberOfIndependentVariables_ );
+    std::array< int, 4 > lowerIndices = { { 0, 0, 0, 0 } };
+    std::array< double, 4 > upperFractions, lowerFractions;
+    std::array< double, 16 > cornerValues;
+    std::vector< double > outOfRangeIndependentVariables( numberOfDimensions );
+
+    for ( int j = firstPoint; j < endPoint; j++ )
+    {
+        // Find interval and interpolation fractions for each independent variable
+        bool isInRange = true;
+        for ( int i = 0; i < numberOfDimensions; i++ )
+        {
+            const std::vector< double >& grid = independentVariablesData_[ i ];
+            const double value = independentVariableInputs[ i ][ j ];
+            if ( !( value >= grid.front( ) && value <= grid.back( ) ) )
+            {
+                isInRange = false;
+                break;
+            }
+            lowerIndices[ i ] = findTableInterval( grid, value, lowerIndices[ i ] );
+            const double lowerValue = grid[ lowerIndices[ i ] ];
+            const double upperValue = grid[ lowerIndices[ i ] + 1 ];
+            const double inverseIntervalSize = 1.0 / ( upperValue - lowerValue );
+            upperFractions[ i ] = ( value - lowerValue ) * inverseIntervalSize;
+            lowerFractions[ i ] = ( upperValue - value ) * inverseIntervalSize;
+        }
+
+        // Use interpolator for points outside of table, to apply boundary handling
+        if ( !isInRange )
+        {
+            for ( int i = 0; i < numberOfDimensions; i++ )
+            {
+                outOfRangeIndependentVariables[ i ] = independentVariableInputs[ i ][ j ];
+            }
+            densities[ j ] = interpolatorForDensity_->interpolate( outOfRangeIndependentVariables );
+        }
+        else if ( numberOfDimensions == 1 )
+        {
+            // Evaluate cubic spline (as in CubicSplineInterpolator)
+            const int lowerIndex = lowerIndices[ 0 ];
+            const double intervalSize = independentVariablesData_[ 0 ][ lowerIndex + 1 ] -
+                    independentVariablesData_[ 0 ][ lowerIndex ];
+            const double squareDifference = intervalSize * intervalSize;
+            const double coefficientA = lowerFractions[ 0 ];
+            const double coefficientB = 1.0 - coefficientA;
+            const double coefficientC = ( coefficientA * coefficientA * coefficientA - coefficientA ) / 6.0 *
+                    squareDifference;
+            const double coefficientD = ( coefficientB * coefficientB * coefficientB - coefficientB ) / 6.0 *
+                    squareDifference;
+            densities[ j ] = coefficientA * densityTableValues_[ lowerIndex ] +
+                    coefficientB * densityTableValues_[ lowerIndex + 1 ] +
+                    coefficientC * densityTableSecondDerivatives_[ lowerIndex ] +
+                    coefficientD * densityTableSecondDerivatives_[ lowerIndex + 1 ];
+        }
+        else
+        {
+            // Retrieve table values at corners of grid cell (bit i of corner index denotes upper node in dimension i)
+            const int numberOfCorners = 1 << numberOfDimensions;
+            for ( int corner = 0; corner < numberOfCorners; corner++ )
+            {
+                int tableIndex = 0;
+                for ( int i = 0; i < numberOfDimensions; i++ )
+                {
+                    tableIndex += ( lowerIndices[ i ] + ( ( corner >> i ) & 1 ) ) * densityTableStrides_[ i ];
+                }
+                cornerValues[ corner ] = densityTableValues_[ tableIndex ];
+            }
+
+            // Interpolate linearly in one dimension at a time, starting at the last (as in MultiLinearInterpolator)
+            for ( int i = numberOfDimensions - 1; i >= 0; i-- )
+            {
+                for ( int corner = 0; corner < ( 1 << i ); corner++ )
+                {
+                    cornerValues[ corner ] = upperFractions[ i ] * cornerValues[ corner + ( 1 << i ) ] +
+                            lowerFractions[ i ] * cornerValues[ corner ];
+                }
+            }
+            densities[ j ] = cornerValues[ 0 ];
+        }
+    }
+}
+
 //! Function to create the interpolators based on the tabulated atmosphere files.
 void TabulatedAtmosphere::createAtmosphereInterpolators( )
 {
@@ -197,6 +342,12 @@ void TabulatedAtmosphere::createAtmosphereInterpolators( )
                     independentVariablesData_.at( 0 ), dependentVariablesData.at( dependentVariableIndices_.at( 2 ) ),
                     huntingAlgorithm, boundaryHandling_.at( 0 ), defaultExtrapolationValue_.at( dependentVariableIndices_.at( 2 ) ).at( 0 ) );
 
+        // Store density table (and second derivatives of its spline) for evaluation by getDensities
+        densityTableValues_ = dependentVariablesData.at( dependentVariableIndices_.at( 0 ) );
+        densityTableStrides_ = { { 1, 0, 0, 0 } };
+        densityTableSecondDerivatives_ = std::dynamic_pointer_cast< CubicSplineInterpolatorDouble >(
+                    interpolatorForDensity_ )->getSecondDerivativeOfCurve( );
+
         // Create remaining interpolators, if requested by user
         if ( dependentVariablesDependency_.at( 3 ) )
         {
@@ -267,6 +418,16 @@ void TabulatedAtmosphere::createMultiDimensionalAtmosphereInterpolators( )
                 independentVariablesData_, tabulatedAtmosphereData.first.at( dependentVariableIndices_.at( 2 ) ),
                 huntingAlgorithm, boundaryHandling_, defaultExtrapolationValue_.at( dependentVariableIndices_.at( 2 ) ) );
 
+    // Store density table for evaluation by getDensities
+    const boost::multi_array< double, static_cast< size_t >( NumberOfIndependentVariables ) >& densityTable =
+            tabulatedAtmosphereData.first.at( dependentVariableIndices_.at( 0 ) );
+    densityTableValues_.assign( densityTable.data( ), densityTable.data( ) + densityTable.num_elements( ) );
+    densityTableStrides_ = { { 0, 0, 0, 0 } };
+    for ( unsigned int i = 0; i < NumberOfIndependentVariables; i++ )
+    {
+        densityTableStrides_[ i ] = static_cast< int >( densityTable.strides( )[ i ] );
+    }
+
     // Create remaining interpolators, if requested by user
     if ( dependentVariablesDependency_.at( 3 ) )
     {
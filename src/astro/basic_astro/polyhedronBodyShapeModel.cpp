@@ -18,6 +18,25 @@ namespace basic_astrodynamics
 
 double PolyhedronBodyShapeModel::getAltitude( const Eigen::Vector3d& bodyFixedPosition )
 {
+    // Compute altitude using nearest-feature search in facet tree
+    if ( facetTree_ != nullptr )
+    {
+        if ( justComputeDistanceToVertices_ )
+        {
+            int closestVertex;
+            double altitude = facetTree_->calculateDistanceToClosestVertex( bodyFixedPosition, closestVertex );
+            if ( computeAltitudeWithSign_ && facetTree_->calculateDistanceToSurface( bodyFixedPosition, true ) < 0.0 )
+            {
+                altitude = - altitude;
+            }
+            return altitude;
+        }
+        else
+        {
+            return facetTree_->calculateDistanceToSurface( bodyFixedPosition, computeAltitudeWithSign_ );
+        }
+    }
+
     // Initialize the variable that will hold the altitude
     double altitude;
 
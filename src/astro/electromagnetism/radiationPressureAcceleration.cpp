@@ -49,7 +49,7 @@ void IsotropicPointSourceRadiationPressureAcceleration::computeAcceleration()
     {
         // Some body is occluding source as seen from target
         currentUnscaledAcceleration_ = Eigen::Vector3d::Zero();
-        targetModel_->resetComputations( sourceName_ );
+        targetModel_->resetComputations( sourceIndex_ );
     }
     else
     {
@@ -62,17 +62,17 @@ void IsotropicPointSourceRadiationPressureAcceleration::computeAcceleration()
             // Calculate acceleration due to radiation pressure in global frame
             targetModel_->updateRadiationPressureForcing(
                 receivedIrradiance, targetRotationFromGlobalToLocalFrame_ *
-                                    targetCenterPositionInSourceFrame_.normalized( ), true, sourceName_ );
-            targetModel_->saveLocalComputations( sourceName_, true );
+                                    targetCenterPositionInSourceFrame_.normalized( ), true, sourceIndex_ );
+            targetModel_->saveLocalComputations( sourceIndex_, true );
             currentUnscaledAcceleration_ = targetRotationFromLocalToGlobalFrame_ *
-                                   targetModel_->getCurrentRadiationPressureForce( sourceName_ ) /
+                                   targetModel_->getCurrentRadiationPressureForce( sourceIndex_ ) /
                                    currentTargetMass_;
         }
         else
         {
             targetModel_->updateRadiationPressureForcing(
-                receivedIrradiance, targetCenterPositionInSourceFrame_.normalized( ), true, sourceName_ );
-            currentUnscaledAcceleration_ = targetModel_->getCurrentRadiationPressureForce( sourceName_ ) / currentTargetMass_;
+                receivedIrradiance, targetCenterPositionInSourceFrame_.normalized( ), true, sourceIndex_ );
+            currentUnscaledAcceleration_ = targetModel_->getCurrentRadiationPressureForce( sourceIndex_ ) / currentTargetMass_;
         }
     }
     scaleRadiationPressureAcceleration( );
@@ -103,7 +103,9 @@ void PaneledSourceRadiationPressureAcceleration::computeAcceleration()
 
     // Calculate radiation pressure force due to all sub-sources in target frame
     Eigen::Vector3d totalForceInTargetFrame = Eigen::Vector3d::Zero();
-    targetModel_->resetComputations( sourceName_ );
+    targetModel_->resetComputations( sourceIndex_ );
+    visibleSourcePanelIrradiances_.clear( );
+    visibleSourcePanelDirectionsInTargetFrame_.clear( );
     int counter = 0;
     for (auto sourceIrradianceAndPosition : sourceIrradiancesAndPositions)
     {
@@ -125,7 +127,8 @@ void PaneledSourceRadiationPressureAcceleration::computeAcceleration()
             Eigen::Vector3d sourceToTargetDirectionInTargetFrame =
                 targetRotationFromGlobalToLocalFrame * ( targetCenterPositionInGlobalFrame_ - sourcePositionInGlobalFrame ).normalized();
 
-            targetModel_->updateRadiationPressureForcing( occultedSourceIrradiance, sourceToTargetDirectionInTargetFrame, false, sourceName_ );
+            visibleSourcePanelIrradiances_.push_back( occultedSourceIrradiance );
+            visibleSourcePanelDirectionsInTargetFrame_.push_back( sourceToTargetDirectionInTargetFrame );
 
             totalReceivedIrradiance += occultedSourceIrradiance;
             visibleAndEmittingSourcePanelCounter += 1;
@@ -136,12 +139,16 @@ void PaneledSourceRadiationPressureAcceleration::computeAcceleration()
         }
         counter++;
     }
-    targetModel_->saveLocalComputations( sourceName_, false );
+
+    // Compute force due to all visible source panels at once
+    targetModel_->updateRadiationPressureForcingFromSourcePanels(
+        visibleSourcePanelIrradiances_, visibleSourcePanelDirectionsInTargetFrame_, sourceIndex_ );
+    targetModel_->saveLocalComputations( sourceIndex_, false );
     if( savePanellingGeometry_ )
     {
         savedPanelGeometries_ = sourceModel_->getCurrentPanelGeomtry( );
     }
-    totalForceInTargetFrame = targetModel_->getCurrentRadiationPressureForce( sourceName_ );
+    totalForceInTargetFrame = targetModel_->getCurrentRadiationPressureForce( sourceIndex_ );
 
 
     // Update dependent variables
@@ -29,23 +29,37 @@ void RadiationPressureTargetModel::updateMembers(const double currentTime)
     }
 }
 
+int RadiationPressureTargetModel::getSourceIndex( const std::string& sourceName )
+{
+    int sourceIndex = getSavedSourceIndex( sourceName );
+    if( sourceIndex < 0 )
+    {
+        sourceIndex = sourceNames_.size( );
+        sourceNames_.push_back( sourceName );
+        currentRadiationPressureForce_.push_back( Eigen::Vector3d::Zero( ) );
+        currentRadiationPressureTorque_.push_back( Eigen::Vector3d::Zero( ) );
+        addSourceVariables( );
+    }
+    return sourceIndex;
+}
+
 void CannonballRadiationPressureTargetModel::updateRadiationPressureForcing(
     double sourceIrradiance,
     const Eigen::Vector3d &sourceToTargetDirection,
     const bool resetForces,
-    const std::string sourceName )
+    const int sourceIndex )
 {
     if( resetForces )
     {
-        resetComputations( sourceName );
+        resetComputations( sourceIndex );
     }
 
     // From Montenbruck (2000), Sec. 3.4
     double radiationPressure = sourceIrradiance / physical_constants::SPEED_OF_LIGHT;
-    this->currentRadiationPressureForce_[ sourceName ] += currentCoefficient_ * area_ * radiationPressure * sourceToTargetDirection;
+    this->currentRadiationPressureForce_[ sourceIndex ] += currentCoefficient_ * area_ * radiationPressure * sourceToTargetDirection;
     if( computeTorques_ )
     {
-        this->currentRadiationPressureTorque_[ sourceName ] += -centerOfMassFunction_( ).cross( this->currentRadiationPressureForce_.at( sourceName ) );
+        this->currentRadiationPressureTorque_[ sourceIndex ] += -centerOfMassFunction_( ).cross( this->currentRadiationPressureForce_[ sourceIndex ] );
     }
 }
 
@@ -53,97 +67,209 @@ void PaneledRadiationPressureTargetModel::updateRadiationPressureForcing(
         double sourceIrradiance,
         const Eigen::Vector3d& sourceToTargetDirectionLocalFrame,
         const bool resetForces,
-        const std::string sourceName )
+        const int sourceIndex )
 {
-    double radiationPressure = sourceIrradiance / physical_constants::SPEED_OF_LIGHT;
-
     if( resetForces )
     {
-        resetComputations( sourceName );
+        resetComputations( sourceIndex );
     }
-    auto segmentFixedPanelsIterator = segmentFixedPanels_.begin( );
+    addPanelForcesFromSourcePanels( &sourceIrradiance, &sourceToTargetDirectionLocalFrame, 1, sourceIndex );
+}
 
-    int counter = 0;
-    Eigen::Quaterniond currentOrientation;
-    Eigen::Vector3d currentCenterOfMass = Eigen::Vector3d::Constant( TUDAT_NAN );
-    if( computeTorques_ )
+void PaneledRadiationPressureTargetModel::updateRadiationPressureForcingFromSourcePanels(
+        const std::vector< double >& sourceIrradiances,
+        const std::vector< Eigen::Vector3d >& sourceToTargetDirectionsLocalFrame,
+        const int sourceIndex )
+{
+    if( sourceIrradiances.size( ) != sourceToTargetDirectionsLocalFrame.size( ) )
     {
-        currentCenterOfMass = centerOfMassFunction_( );
+        throw std::runtime_error( "Error when computing panelled radiation pressure from source panels of " +
+                                  sourceNames_.at( sourceIndex ) + ", number of irradiances and directions is inconsistent." );
+    }
+    addPanelForcesFromSourcePanels( sourceIrradiances.data( ), sourceToTargetDirectionsLocalFrame.data( ),
+                                    sourceIrradiances.size( ), sourceIndex );
+}
+
+void PaneledRadiationPressureTargetModel::addPanelForcesFromSourcePanels(
+        const double* sourceIrradiances,
+        const Eigen::Vector3d* sourceToTargetDirectionsLocalFrame,
+        const int numberOfSourcePanels,
+        const int sourceIndex )
+{
+    if( numberOfSourcePanels == 0 )
+    {
+        return;
     }
-    Eigen::Vector3d currentPanelForce = Eigen::Vector3d::Zero( );
-    Eigen::Vector3d currentPanelTorque = Eigen::Vector3d::Zero( );
 
-    for( unsigned int i = 0; i < segmentFixedPanels_.size( ) + 1; i++ )
+    if( useOpticalCoefficients_ )
     {
-        currentOrientation = Eigen::Quaterniond( Eigen::Matrix3d::Identity( ) );
-        if( i > 0 )
+        // From Montenbruck (2014) Eq. 5 and 6, the force on panel j due to source panel k (for positive cosine c_jk of
+        // angle of incidence) is p_k * A_j * c_jk * ( C_inc,j * d_k - ( C_diff,j + C_spec,j * c_jk ) * n_j ). The sums
+        // over the source panels of p_k * c_jk * d_k, p_k * c_jk and p_k * c_jk^2 are accumulated for all panels first.
+        weightedCosineSums_.setZero( );
+        weightedSquaredCosineSums_.setZero( );
+        weightedDirectionSums_.setZero( );
+        for( int k = 0; k < numberOfSourcePanels; k++ )
         {
-            currentOrientation = segmentFixedToBodyFixedRotations_.at( segmentFixedPanelsIterator->first )( );
-            if( computeTorques_ )
+            const Eigen::Vector3d& sourceToTargetDirection = sourceToTargetDirectionsLocalFrame[ k ];
+            const double radiationPressure = sourceIrradiances[ k ] / physical_constants::SPEED_OF_LIGHT;
+
+            surfacePanelCosines_.array( ) = -( sourceToTargetDirection( 0 ) * surfaceNormals_.col( 0 ).array( ) +
+                                               sourceToTargetDirection( 1 ) * surfaceNormals_.col( 1 ).array( ) +
+                                               sourceToTargetDirection( 2 ) * surfaceNormals_.col( 2 ).array( ) );
+
+            // Radiation incident on backside of panel exerts no force
+            weightedCosines_ = radiationPressure * surfacePanelCosines_.array( ).max( 0.0 );
+            weightedCosineSums_ += weightedCosines_;
+            weightedSquaredCosineSums_ += weightedCosines_ * surfacePanelCosines_.array( );
+            for( int i = 0; i < 3; i++ )
             {
-                throw std::runtime_error( "Torques not yet supported for moving vehicle parts." );
+                weightedDirectionSums_.col( i ).array( ) += sourceToTargetDirection( i ) * weightedCosines_;
             }
         }
 
-        const std::vector< std::shared_ptr< system_models::VehicleExteriorPanel > >& currentPanels_ =
-            ( i == 0 ) ? bodyFixedPanels_ : segmentFixedPanels_.at( segmentFixedPanelsIterator->first );
-        for( unsigned int j = 0; j < currentPanels_.size( ); j++ )
+        weightedCosines_ = diffuseReactionCoefficients_ * weightedCosineSums_ +
+                specularReactionCoefficients_ * weightedSquaredCosineSums_;
+        for( int i = 0; i < 3; i++ )
         {
-            surfaceNormals_[ counter ] = currentOrientation * currentPanels_.at( j )->getFrameFixedSurfaceNormal( )( );
-            surfacePanelCosines_[ counter ] = (-sourceToTargetDirectionLocalFrame).dot(surfaceNormals_[ counter ]);
-            if( computeTorques_ )
-            {
-                panelCentroidMomentArms_[ counter ] = currentOrientation * ( currentPanels_.at( j )->getFrameFixedPositionVector( )( ) - currentCenterOfMass );
-            }
-            if (surfacePanelCosines_[ counter ] > 0)
-            {
-                currentPanelForce = radiationPressure * currentPanels_.at( j )->getPanelArea() * surfacePanelCosines_[ counter ] *
-                    currentPanels_.at( j )->getReflectionLaw()->evaluateReactionVector(surfaceNormals_[ counter ], sourceToTargetDirectionLocalFrame );
-                this->currentRadiationPressureForce_[ sourceName ] += currentPanelForce;
-                if( computeTorques_ )
-                {
-                    currentPanelTorque = panelCentroidMomentArms_[ counter ].cross( currentPanelForce );
-                    this->currentRadiationPressureTorque_[ sourceName ]  += currentPanelTorque;
-                }
-
-            }
-            else
+            currentPanelForces_.col( i ).array( ) = panelAreas_ * (
+                        incidenceReactionCoefficients_ * weightedDirectionSums_.col( i ).array( ) -
+                        weightedCosines_ * surfaceNormals_.col( i ).array( ) );
+        }
+    }
+    else
+    {
+        currentPanelForces_.setZero( );
+        for( int k = 0; k < numberOfSourcePanels; k++ )
+        {
+            const Eigen::Vector3d& sourceToTargetDirection = sourceToTargetDirectionsLocalFrame[ k ];
+            const double radiationPressure = sourceIrradiances[ k ] / physical_constants::SPEED_OF_LIGHT;
+            for( int j = 0; j < totalNumberOfPanels_; j++ )
             {
-                currentPanelForce.setZero( );
-                if( computeTorques_ )
+                const Eigen::Vector3d surfaceNormal = surfaceNormals_.row( j ).transpose( );
+                surfacePanelCosines_( j ) = ( -sourceToTargetDirection ).dot( surfaceNormal );
+                if( surfacePanelCosines_( j ) > 0 )
                 {
-                    currentPanelTorque.setZero( );
+                    currentPanelForces_.row( j ) += radiationPressure * panelAreas_( j ) * surfacePanelCosines_( j ) *
+                            fullPanels_.at( j )->getReflectionLaw( )->evaluateReactionVector(
+                                surfaceNormal, sourceToTargetDirection ).transpose( );
                 }
             }
-            panelForces_[ counter ] += currentPanelForce;
+        }
+    }
 
-            if( computeTorques_ )
-            {
-                panelTorques_[ counter ] += currentPanelTorque;
-            }
+    panelForcesPerSource_.at( sourceIndex ) += currentPanelForces_;
+    this->currentRadiationPressureForce_[ sourceIndex ] += currentPanelForces_.colwise( ).sum( ).transpose( );
 
-            counter++;
-        }
-        if( i > 0 )
+    if( computeTorques_ )
+    {
+        for( int i = 0; i < 3; i++ )
         {
-            segmentFixedPanelsIterator++;
+            currentPanelTorques_.col( i ) =
+                    panelCentroidMomentArms_.col( ( i + 1 ) % 3 ).cwiseProduct( currentPanelForces_.col( ( i + 2 ) % 3 ) ) -
+                    panelCentroidMomentArms_.col( ( i + 2 ) % 3 ).cwiseProduct( currentPanelForces_.col( ( i + 1 ) % 3 ) );
         }
+        panelTorquesPerSource_.at( sourceIndex ) += currentPanelTorques_;
+        this->currentRadiationPressureTorque_[ sourceIndex ] += currentPanelTorques_.colwise( ).sum( ).transpose( );
     }
 }
 
-void PaneledRadiationPressureTargetModel::saveLocalComputations( const std::string sourceName, const bool saveCosines )
+void PaneledRadiationPressureTargetModel::saveLocalComputations( const int sourceIndex, const bool saveCosines )
 {
+    // Panel forces and torques are stored per source directly upon computation
     if( saveCosines )
     {
-        surfacePanelCosinesPerSource_[ sourceName ] = surfacePanelCosines_;
+        surfacePanelCosinesPerSource_.at( sourceIndex ) = surfacePanelCosines_;
     }
-    panelForcesPerSource_[ sourceName ] = panelForces_;
-    panelTorquesPerSource_[ sourceName ] = panelTorques_;
 }
 
 void PaneledRadiationPressureTargetModel::updateMembers_(double currentTime)
 {
+    updatePanelProperties( );
+}
+
+void PaneledRadiationPressureTargetModel::resetDerivedComputations( const int sourceIndex )
+{
+    updatePanelOrientations( );
 
+    panelForcesPerSource_.at( sourceIndex ).setZero( );
+    if( computeTorques_ )
+    {
+        panelTorquesPerSource_.at( sourceIndex ).setZero( );
+    }
+}
+
+void PaneledRadiationPressureTargetModel::updatePanelProperties( )
+{
+    useOpticalCoefficients_ = true;
+    for( int i = 0; i < totalNumberOfPanels_; i++ )
+    {
+        panelAreas_( i ) = fullPanels_.at( i )->getPanelArea( );
+
+        // Montenbruck (2014) Eq. 5 and 6
+        std::shared_ptr< SpecularDiffuseMixReflectionLaw > reflectionLaw =
+                std::dynamic_pointer_cast< SpecularDiffuseMixReflectionLaw >( fullPanels_.at( i )->getReflectionLaw( ) );
+        if( reflectionLaw != nullptr )
+        {
+            incidenceReactionCoefficients_( i ) =
+                    reflectionLaw->getAbsorptivity( ) + reflectionLaw->getDiffuseReflectivity( );
+            diffuseReactionCoefficients_( i ) = 2.0 / 3.0 * reflectionLaw->getDiffuseReflectivity( );
+            if( reflectionLaw->isWithInstantaneousReradiation( ) )
+            {
+                diffuseReactionCoefficients_( i ) += 2.0 / 3.0 * reflectionLaw->getAbsorptivity( );
+            }
+            specularReactionCoefficients_( i ) = 2.0 * reflectionLaw->getSpecularReflectivity( );
+        }
+        else
+        {
+            useOpticalCoefficients_ = false;
+        }
+    }
+}
+
+void PaneledRadiationPressureTargetModel::updatePanelOrientations( )
+{
+    Eigen::Vector3d currentCenterOfMass = Eigen::Vector3d::Constant( TUDAT_NAN );
+    if( computeTorques_ )
+    {
+        currentCenterOfMass = centerOfMassFunction_( );
+    }
+
+    int counter = 0;
+    for( unsigned int j = 0; j < bodyFixedPanels_.size( ); j++ )
+    {
+        surfaceNormals_.row( counter ) = bodyFixedPanels_.at( j )->getFrameFixedSurfaceNormal( )( ).transpose( );
+        if( computeTorques_ )
+        {
+            panelCentroidMomentArms_.row( counter ) =
+                    ( bodyFixedPanels_.at( j )->getFrameFixedPositionVector( )( ) - currentCenterOfMass ).transpose( );
+        }
+        counter++;
+    }
+
+    for( auto it : segmentFixedPanels_ )
+    {
+        if( computeTorques_ && it.second.size( ) > 0 )
+        {
+            throw std::runtime_error( "Torques not yet supported for moving vehicle parts." );
+        }
+
+        const Eigen::Quaterniond currentOrientation = segmentFixedToBodyFixedRotations_.at( it.first )( );
+        for( unsigned int j = 0; j < it.second.size( ); j++ )
+        {
+            surfaceNormals_.row( counter ) =
+                    ( currentOrientation * it.second.at( j )->getFrameFixedSurfaceNormal( )( ) ).transpose( );
+            counter++;
+        }
+    }
+}
+
+void PaneledRadiationPressureTargetModel::addSourceVariables( )
+{
+    surfacePanelCosinesPerSource_.push_back( Eigen::VectorXd( ) );
+    panelForcesPerSource_.push_back( Eigen::Matrix< double, Eigen::Dynamic, 3 >::Zero( totalNumberOfPanels_, 3 ) );
+    panelTorquesPerSource_.push_back( Eigen::Matrix< double, Eigen::Dynamic, 3 >::Zero(
+                                          computeTorques_ ? totalNumberOfPanels_ : 0, 3 ) );
 }
 
 } // tudat
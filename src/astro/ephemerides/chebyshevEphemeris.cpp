@@ -0,0 +1,208 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "tudat/astro/ephemerides/chebyshevEphemeris.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Constructor, samples the reference state function and computes the Chebyshev coefficients of each segment.
+ChebyshevEphemeris::ChebyshevEphemeris(
+        const std::function< Eigen::Vector6d( const double ) > stateFunction,
+        const double initialTime,
+        const double finalTime,
+        const double segmentDuration,
+        const int polynomialDegree,
+        const std::string& referenceFrameOrigin,
+        const std::string& referenceFrameOrientation,
+        const double positionTolerance,
+        const int maximumNumberOfRefinements ):
+    Ephemeris( referenceFrameOrigin, referenceFrameOrientation ),
+    initialTime_( initialTime ), finalTime_( finalTime ), polynomialDegree_( polynomialDegree )
+{
+    if( !( finalTime_ > initialTime_ ) )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev ephemeris, final time must be larger than initial time" );
+    }
+
+    if( !( segmentDuration > 0.0 ) )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev ephemeris, segment duration must be positive" );
+    }
+
+    if( polynomialDegree_ < 1 )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev ephemeris, polynomial degree must be at least 1" );
+    }
+
+    // Determine number of segments, such that the segment duration does not exceed the requested value
+    numberOfSegments_ = static_cast< int >( std::ceil( ( finalTime_ - initialTime_ ) / segmentDuration ) );
+    if( numberOfSegments_ < 1 )
+    {
+        numberOfSegments_ = 1;
+    }
+
+    // Compute coefficients, and refine segments until position tolerance is met
+    int numberOfRefinements = 0;
+    while( true )
+    {
+        segmentDuration_ = ( finalTime_ - initialTime_ ) / static_cast< double >( numberOfSegments_ );
+        computeSegmentCoefficients( stateFunction );
+        computeMaximumErrors( stateFunction );
+
+        if( !( positionTolerance > 0.0 ) || !( maximumPositionError_ > positionTolerance ) )
+        {
+            break;
+        }
+        else if( numberOfRefinements >= maximumNumberOfRefinements )
+        {
+            throw std::runtime_error(
+                        "Error when creating Chebyshev ephemeris, position tolerance of " +
+                        std::to_string( positionTolerance ) + " not met after " +
+                        std::to_string( numberOfRefinements ) + " refinements; maximum error is " +
+                        std::to_string( maximumPositionError_ ) );
+        }
+
+        numberOfSegments_ *= 2;
+        numberOfRefinements++;
+    }
+}
+
+//! Get cartesian state from ephemeris.
+Eigen::Vector6d ChebyshevEphemeris::getCartesianState( const double secondsSinceEpoch )
+{
+    if( !( secondsSinceEpoch >= initialTime_ && secondsSinceEpoch <= finalTime_ ) )
+    {
+        throw std::runtime_error(
+                    "Error when retrieving state from Chebyshev ephemeris, requested time " +
+                    std::to_string( secondsSinceEpoch ) + " is outside of interval [" +
+                    std::to_string( initialTime_ ) + ", " + std::to_string( finalTime_ ) + "]" );
+    }
+
+    // Find segment directly from time (clamped to last segment to include final time)
+    int segmentIndex = static_cast< int >( ( secondsSinceEpoch - initialTime_ ) / segmentDuration_ );
+    if( segmentIndex >= numberOfSegments_ )
+    {
+        segmentIndex = numberOfSegments_ - 1;
+    }
+
+    double segmentStartTime = initialTime_ + static_cast< double >( segmentIndex ) * segmentDuration_;
+    double scaledTime = 2.0 * ( secondsSinceEpoch - segmentStartTime ) / segmentDuration_ - 1.0;
+
+    return evaluateSegment( segmentIndex, scaledTime );
+}
+
+//! Function to compute the Chebyshev coefficients of all segments, for the current segment duration.
+void ChebyshevEphemeris::computeSegmentCoefficients(
+        const std::function< Eigen::Vector6d( const double ) >& stateFunction )
+{
+    const int numberOfNodes = polynomialDegree_ + 1;
+    const double degree = static_cast< double >( polynomialDegree_ );
+
+    // Pre-compute cosine terms cos( pi * j * k / N ), used for both nodes and discrete cosine transform
+    Eigen::MatrixXd cosineTerms = Eigen::MatrixXd( numberOfNodes, numberOfNodes );
+    for( int j = 0; j < numberOfNodes; j++ )
+    {
+        for( int k = 0; k < numberOfNodes; k++ )
+        {
+            cosineTerms( j, k ) = std::cos( mathematical_constants::PI * static_cast< double >( j * k ) / degree );
+        }
+    }
+
+    coefficients_.assign( 6 * numberOfNodes * numberOfSegments_, 0.0 );
+
+    // Node k = 0 corresponds to the end of the segment, node k = N to the start of the segment. The state at the start of
+    // each segment is taken from the end of the previous segment, so that each epoch is sampled only once.
+    Eigen::Matrix< double, 6, Eigen::Dynamic > nodeStates = Eigen::Matrix< double, 6, Eigen::Dynamic >( 6, numberOfNodes );
+    Eigen::Vector6d previousSegmentEndState = stateFunction( initialTime_ );
+    for( int segment = 0; segment < numberOfSegments_; segment++ )
+    {
+        double segmentMidTime = initialTime_ + ( static_cast< double >( segment ) + 0.5 ) * segmentDuration_;
+        nodeStates.col( polynomialDegree_ ) = previousSegmentEndState;
+        for( int k = 0; k < polynomialDegree_; k++ )
+        {
+            nodeStates.col( k ) = stateFunction( segmentMidTime + 0.5 * segmentDuration_ * cosineTerms( 1, k ) );
+        }
+        previousSegmentEndState = nodeStates.col( 0 );
+
+        // Compute coefficients from discrete cosine transform of node values
+        double* segmentCoefficients = coefficients_.data( ) + 6 * numberOfNodes * segment;
+        for( int j = 0; j < numberOfNodes; j++ )
+        {
+            Eigen::Vector6d currentCoefficient = Eigen::Vector6d::Zero( );
+            for( int k = 0; k < numberOfNodes; k++ )
+            {
+                double weight = ( k == 0 || k == polynomialDegree_ ) ? 0.5 : 1.0;
+                currentCoefficient += weight * cosineTerms( j, k ) * nodeStates.col( k );
+            }
+            currentCoefficient *= 2.0 / degree;
+            if( j == 0 || j == polynomialDegree_ )
+            {
+                currentCoefficient *= 0.5;
+            }
+            Eigen::Map< Eigen::Vector6d >( segmentCoefficients + 6 * j ) = currentCoefficient;
+        }
+    }
+}
+
+//! Function to compute the maximum position and velocity error w.r.t. the reference state function.
+void ChebyshevEphemeris::computeMaximumErrors(
+        const std::function< Eigen::Vector6d( const double ) >& stateFunction )
+{
+    maximumPositionError_ = 0.0;
+    maximumVelocityError_ = 0.0;
+
+    // Verify fit halfway (in angle) between each pair of consecutive nodes, where interpolation error is largest
+    for( int segment = 0; segment < numberOfSegments_; segment++ )
+    {
+        double segmentMidTime = initialTime_ + ( static_cast< double >( segment ) + 0.5 ) * segmentDuration_;
+        for( int k = 0; k < polynomialDegree_; k++ )
+        {
+            double scaledTime = std::cos( mathematical_constants::PI * ( static_cast< double >( k ) + 0.5 ) /
+                                          static_cast< double >( polynomialDegree_ ) );
+            Eigen::Vector6d stateError = evaluateSegment( segment, scaledTime ) -
+                    stateFunction( segmentMidTime + 0.5 * segmentDuration_ * scaledTime );
+
+            maximumPositionError_ = std::max( maximumPositionError_, stateError.segment< 3 >( 0 ).norm( ) );
+            maximumVelocityError_ = std::max( maximumVelocityError_, stateError.segment< 3 >( 3 ).norm( ) );
+        }
+    }
+}
+
+//! Function to evaluate the Chebyshev polynomial of a given segment at a given scaled time (in [-1,1])
+Eigen::Vector6d ChebyshevEphemeris::evaluateSegment( const int segmentIndex, const double scaledTime ) const
+{
+    const double* segmentCoefficients = coefficients_.data( ) + 6 * ( polynomialDegree_ + 1 ) * segmentIndex;
+
+    // Evaluate Chebyshev series using Clenshaw recurrence
+    Eigen::Vector6d currentTerm = Eigen::Vector6d::Zero( );
+    Eigen::Vector6d nextTerm = Eigen::Vector6d::Zero( );
+    Eigen::Vector6d previousTerm;
+    for( int j = polynomialDegree_; j >= 1; j-- )
+    {
+        previousTerm = 2.0 * scaledTime * currentTerm - nextTerm +
+                Eigen::Map< const Eigen::Vector6d >( segmentCoefficients + 6 * j );
+        nextTerm = currentTerm;
+        currentTerm = previousTerm;
+    }
+    return scaledTime * currentTerm - nextTerm + Eigen::Map< const Eigen::Vector6d >( segmentCoefficients );
+}
+
+} // namespace ephemerides
+
+} // namespace tudat
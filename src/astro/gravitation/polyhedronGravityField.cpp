@@ -9,6 +9,9 @@
  *
  */
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "tudat/astro/gravitation/polyhedronGravityField.h"
 
 namespace tudat
@@ -17,24 +20,277 @@ namespace tudat
 namespace gravitation
 {
 
+namespace
+{
+
+//! Number of facets or edges per block in the polyhedron gravity cache, i.e. per task when distributed over threads.
+const int polyhedronCacheBlockSize = 2048;
+
+//! Function to retrieve the number of blocks required to process a number of facets or edges.
+int getNumberOfPolyhedronCacheBlocks( const int numberOfElements )
+{
+    return ( numberOfElements + polyhedronCacheBlockSize - 1 ) / polyhedronCacheBlockSize;
+}
+
+} // namespace
+
+PolyhedronGravityCache::PolyhedronGravityCache(
+        const Eigen::MatrixXd& verticesCoordinates,
+        const Eigen::MatrixXi& verticesDefiningEachFacet,
+        const Eigen::MatrixXi& verticesDefiningEachEdge,
+        const std::vector< Eigen::MatrixXd >& facetDyads,
+        const std::vector< Eigen::MatrixXd >& edgeDyads ):
+    verticesCoordinates_( verticesCoordinates ),
+    verticesDefiningEachFacet_( verticesDefiningEachFacet ),
+    verticesDefiningEachEdge_( verticesDefiningEachEdge ),
+    areSumsUpToDate_( false )
+{
+    currentBodyFixedPosition_ = (Eigen::Vector3d() << TUDAT_NAN, TUDAT_NAN, TUDAT_NAN).finished();
+
+    if( static_cast< int >( facetDyads.size( ) ) != verticesDefiningEachFacet_.rows( ) ||
+            static_cast< int >( edgeDyads.size( ) ) != verticesDefiningEachEdge_.rows( ) )
+    {
+        throw std::runtime_error( "Error when creating polyhedron gravity cache, number of facet (" +
+                                  std::to_string( facetDyads.size( ) ) + ") or edge (" + std::to_string( edgeDyads.size( ) ) +
+                                  ") dyads is inconsistent with number of facets or edges." );
+    }
+
+    // Store dyads per component
+    facetDyadComponents_.resize( facetDyads.size( ), 6 );
+    for( unsigned int facet = 0; facet < facetDyads.size( ); ++facet )
+    {
+        const Eigen::MatrixXd& facetDyad = facetDyads.at( facet );
+        facetDyadComponents_.row( facet ) << facetDyad( 0, 0 ), facetDyad( 0, 1 ), facetDyad( 0, 2 ),
+                facetDyad( 1, 1 ), facetDyad( 1, 2 ), facetDyad( 2, 2 );
+    }
+
+    edgeDyadComponents_.resize( edgeDyads.size( ), 9 );
+    for( unsigned int edge = 0; edge < edgeDyads.size( ); ++edge )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            for( int j = 0; j < 3; ++j )
+            {
+                edgeDyadComponents_( edge, 3 * i + j ) = edgeDyads.at( edge )( i, j );
+            }
+        }
+    }
+}
+
 void PolyhedronGravityCache::update (const Eigen::Vector3d& currentBodyFixedPosition)
 {
 //    if ( currentBodyFixedPosition_.hasNaN( ) || currentBodyFixedPosition != currentBodyFixedPosition_ )
     {
         currentBodyFixedPosition_ = currentBodyFixedPosition;
+        areSumsUpToDate_ = false;
+
+        const int numberOfVertices = verticesCoordinates_.rows( );
+        const int numberOfFacets = verticesDefiningEachFacet_.rows( );
+        const int numberOfEdges = verticesDefiningEachEdge_.rows( );
+
+        // Compute coordinates and distances of vertices with respect to field point
+        currentVerticesCoordinatesRelativeToFieldPoint_.resize( numberOfVertices, 3 );
+        currentVerticesDistancesToFieldPoint_.resize( numberOfVertices );
+        for( int i = 0; i < 3; ++i )
+        {
+            currentVerticesCoordinatesRelativeToFieldPoint_.col( i ) =
+                    verticesCoordinates_.col( i ).array( ) - currentBodyFixedPosition_( i );
+        }
+        const double* x = currentVerticesCoordinatesRelativeToFieldPoint_.col( 0 ).data( );
+        const double* y = currentVerticesCoordinatesRelativeToFieldPoint_.col( 1 ).data( );
+        const double* z = currentVerticesCoordinatesRelativeToFieldPoint_.col( 2 ).data( );
+        double* r = currentVerticesDistancesToFieldPoint_.data( );
+        for( int vertex = 0; vertex < numberOfVertices; ++vertex )
+        {
+            r[ vertex ] = std::sqrt( x[ vertex ] * x[ vertex ] + y[ vertex ] * y[ vertex ] + z[ vertex ] * z[ vertex ] );
+        }
+
+        currentPerFacetFactor_.resize( numberOfFacets );
+        currentPerEdgeFactor_.resize( numberOfEdges );
+
+        const int* facetVertex0 = verticesDefiningEachFacet_.col( 0 ).data( );
+        const int* facetVertex1 = verticesDefiningEachFacet_.col( 1 ).data( );
+        const int* facetVertex2 = verticesDefiningEachFacet_.col( 2 ).data( );
+        const int* edgeVertex0 = verticesDefiningEachEdge_.col( 0 ).data( );
+        const int* edgeVertex1 = verticesDefiningEachEdge_.col( 1 ).data( );
+        double* perFacetFactor = currentPerFacetFactor_.data( );
+        double* perEdgeFactor = currentPerEdgeFactor_.data( );
+
+        const int numberOfFacetBlocks = getNumberOfPolyhedronCacheBlocks( numberOfFacets );
+        const int numberOfEdgeBlocks = getNumberOfPolyhedronCacheBlocks( numberOfEdges );
+        utilities::runTasks( threadPool_, numberOfFacetBlocks + numberOfEdgeBlocks,
+                             [ & ]( const int block, const unsigned int )
+        {
+            if( block < numberOfFacetBlocks )
+            {
+                // Compute per-facet factor (Eq. 27 of Werner and Scheeres, 1997)
+                const int firstFacet = block * polyhedronCacheBlockSize;
+                const int lastFacet = std::min( firstFacet + polyhedronCacheBlockSize, numberOfFacets );
+                for( int facet = firstFacet; facet < lastFacet; ++facet )
+                {
+                    const int i = facetVertex0[ facet ], j = facetVertex1[ facet ], k = facetVertex2[ facet ];
+                    const double numerator =
+                            x[ i ] * ( y[ j ] * z[ k ] - z[ j ] * y[ k ] ) +
+                            y[ i ] * ( z[ j ] * x[ k ] - x[ j ] * z[ k ] ) +
+                            z[ i ] * ( x[ j ] * y[ k ] - y[ j ] * x[ k ] );
+                    const double denominator =
+                            r[ i ] * r[ j ] * r[ k ] +
+                            r[ i ] * ( x[ j ] * x[ k ] + y[ j ] * y[ k ] + z[ j ] * z[ k ] ) +
+                            r[ j ] * ( x[ k ] * x[ i ] + y[ k ] * y[ i ] + z[ k ] * z[ i ] ) +
+                            r[ k ] * ( x[ i ] * x[ j ] + y[ i ] * y[ j ] + z[ i ] * z[ j ] );
+                    perFacetFactor[ facet ] = ( numerator == 0.0 ) ? 0.0 : 2.0 * std::atan2( numerator, denominator );
+                }
+            }
+            else
+            {
+                // Compute per-edge factor (Eq. 7 of Werner and Scheeres, 1997); taken to be 0 at edge singularities,
+                // see basic_mathematics::calculatePolyhedronPerEdgeFactor
+                const int firstEdge = ( block - numberOfFacetBlocks ) * polyhedronCacheBlockSize;
+                const int lastEdge = std::min( firstEdge + polyhedronCacheBlockSize, numberOfEdges );
+                for( int edge = firstEdge; edge < lastEdge; ++edge )
+                {
+                    const int i = edgeVertex0[ edge ], j = edgeVertex1[ edge ];
+                    const double edgeLength = std::sqrt(
+                                ( x[ i ] - x[ j ] ) * ( x[ i ] - x[ j ] ) + ( y[ i ] - y[ j ] ) * ( y[ i ] - y[ j ] ) +
+                                ( z[ i ] - z[ j ] ) * ( z[ i ] - z[ j ] ) );
+                    const double denominator = r[ i ] + r[ j ] - edgeLength;
+                    perEdgeFactor[ edge ] = ( std::abs( denominator ) < 1e-18 ) ?
+                                0.0 : std::log( ( r[ i ] + r[ j ] + edgeLength ) / denominator );
+                }
+            }
+        } );
+    }
+}
+
+double PolyhedronGravityCache::calculateGravitationalPotential( const double gravitationalConstantTimesDensity )
+{
+    calculateFacetAndEdgeSums( );
+    return 0.5 * gravitationalConstantTimesDensity * (
+                currentEdgeAndFacetSums_.first( 3 ) - currentEdgeAndFacetSums_.second( 3 ) );
+}
 
-        // Compute coordinates of vertices with respect to field point
-        basic_mathematics::calculatePolyhedronVerticesCoordinatesRelativeToFieldPoint(
-                currentVerticesCoordinatesRelativeToFieldPoint_, currentBodyFixedPosition_, verticesCoordinates_);
+Eigen::Vector3d PolyhedronGravityCache::calculateGradientOfGravitationalPotential( const double gravitationalConstantTimesDensity )
+{
+    calculateFacetAndEdgeSums( );
+    return - gravitationalConstantTimesDensity * (
+                currentEdgeAndFacetSums_.first.segment< 3 >( 0 ) - currentEdgeAndFacetSums_.second.segment< 3 >( 0 ) );
+}
+
+void PolyhedronGravityCache::setNumberOfThreads( const unsigned int numberOfThreads )
+{
+    if( numberOfThreads > 1 )
+    {
+        threadPool_ = std::make_shared< utilities::ThreadPool >( numberOfThreads );
+    }
+    else
+    {
+        threadPool_ = nullptr;
+    }
+}
 
-        // Compute per-facet factor
-        basic_mathematics::calculatePolyhedronPerFacetFactor(
-                currentPerFacetFactor_, currentVerticesCoordinatesRelativeToFieldPoint_, verticesDefiningEachFacet_);
+void PolyhedronGravityCache::calculateFacetAndEdgeSums( )
+{
+    if( areSumsUpToDate_ )
+    {
+        return;
+    }
 
-        // Compute per-edge factor
-        basic_mathematics::calculatePolyhedronPerEdgeFactor(
-                currentPerEdgeFactor_, currentVerticesCoordinatesRelativeToFieldPoint_, verticesDefiningEachEdge_);
+    const int numberOfFacets = verticesDefiningEachFacet_.rows( );
+    const int numberOfEdges = verticesDefiningEachEdge_.rows( );
+    if( facetDyadComponents_.rows( ) != numberOfFacets || edgeDyadComponents_.rows( ) != numberOfEdges )
+    {
+        throw std::runtime_error( "Error when computing polyhedron gravity from cache, facet and edge dyads not provided." );
+    }
+    if( currentPerFacetFactor_.rows( ) != numberOfFacets )
+    {
+        throw std::runtime_error( "Error when computing polyhedron gravity from cache, cache has not been updated." );
     }
+
+    const double* x = currentVerticesCoordinatesRelativeToFieldPoint_.col( 0 ).data( );
+    const double* y = currentVerticesCoordinatesRelativeToFieldPoint_.col( 1 ).data( );
+    const double* z = currentVerticesCoordinatesRelativeToFieldPoint_.col( 2 ).data( );
+    const int* facetVertex0 = verticesDefiningEachFacet_.col( 0 ).data( );
+    const int* edgeVertex0 = verticesDefiningEachEdge_.col( 0 ).data( );
+    const double* perFacetFactor = currentPerFacetFactor_.data( );
+    const double* perEdgeFactor = currentPerEdgeFactor_.data( );
+
+    const int numberOfFacetBlocks = getNumberOfPolyhedronCacheBlocks( numberOfFacets );
+    const int numberOfEdgeBlocks = getNumberOfPolyhedronCacheBlocks( numberOfEdges );
+    facetBlockSums_.resize( numberOfFacetBlocks );
+    edgeBlockSums_.resize( numberOfEdgeBlocks );
+
+    // Compute sums per block. Since the dyad projects any vector onto the facet normal (or edge normals), the position
+    // of the facet/edge may be taken as that of any of its vertices; the first vertex is used.
+    utilities::runTasks( threadPool_, numberOfFacetBlocks + numberOfEdgeBlocks,
+                         [ & ]( const int block, const unsigned int )
+    {
+        double sumX = 0.0, sumY = 0.0, sumZ = 0.0, sumScalar = 0.0;
+        if( block < numberOfFacetBlocks )
+        {
+            const int firstFacet = block * polyhedronCacheBlockSize;
+            const int lastFacet = std::min( firstFacet + polyhedronCacheBlockSize, numberOfFacets );
+            const double* dyadXX = facetDyadComponents_.col( 0 ).data( );
+            const double* dyadXY = facetDyadComponents_.col( 1 ).data( );
+            const double* dyadXZ = facetDyadComponents_.col( 2 ).data( );
+            const double* dyadYY = facetDyadComponents_.col( 3 ).data( );
+            const double* dyadYZ = facetDyadComponents_.col( 4 ).data( );
+            const double* dyadZZ = facetDyadComponents_.col( 5 ).data( );
+            for( int facet = firstFacet; facet < lastFacet; ++facet )
+            {
+                const int i = facetVertex0[ facet ];
+                const double projectedX = ( dyadXX[ facet ] * x[ i ] + dyadXY[ facet ] * y[ i ] + dyadXZ[ facet ] * z[ i ] ) *
+                        perFacetFactor[ facet ];
+                const double projectedY = ( dyadXY[ facet ] * x[ i ] + dyadYY[ facet ] * y[ i ] + dyadYZ[ facet ] * z[ i ] ) *
+                        perFacetFactor[ facet ];
+                const double projectedZ = ( dyadXZ[ facet ] * x[ i ] + dyadYZ[ facet ] * y[ i ] + dyadZZ[ facet ] * z[ i ] ) *
+                        perFacetFactor[ facet ];
+                sumX += projectedX;
+                sumY += projectedY;
+                sumZ += projectedZ;
+                sumScalar += x[ i ] * projectedX + y[ i ] * projectedY + z[ i ] * projectedZ;
+            }
+            facetBlockSums_[ block ] << sumX, sumY, sumZ, sumScalar;
+        }
+        else
+        {
+            const int firstEdge = ( block - numberOfFacetBlocks ) * polyhedronCacheBlockSize;
+            const int lastEdge = std::min( firstEdge + polyhedronCacheBlockSize, numberOfEdges );
+            const double* dyad[ 9 ];
+            for( int component = 0; component < 9; ++component )
+            {
+                dyad[ component ] = edgeDyadComponents_.col( component ).data( );
+            }
+            for( int edge = firstEdge; edge < lastEdge; ++edge )
+            {
+                const int i = edgeVertex0[ edge ];
+                const double projectedX = ( dyad[ 0 ][ edge ] * x[ i ] + dyad[ 1 ][ edge ] * y[ i ] + dyad[ 2 ][ edge ] * z[ i ] ) *
+                        perEdgeFactor[ edge ];
+                const double projectedY = ( dyad[ 3 ][ edge ] * x[ i ] + dyad[ 4 ][ edge ] * y[ i ] + dyad[ 5 ][ edge ] * z[ i ] ) *
+                        perEdgeFactor[ edge ];
+                const double projectedZ = ( dyad[ 6 ][ edge ] * x[ i ] + dyad[ 7 ][ edge ] * y[ i ] + dyad[ 8 ][ edge ] * z[ i ] ) *
+                        perEdgeFactor[ edge ];
+                sumX += projectedX;
+                sumY += projectedY;
+                sumZ += projectedZ;
+                sumScalar += x[ i ] * projectedX + y[ i ] * projectedY + z[ i ] * projectedZ;
+            }
+            edgeBlockSums_[ block - numberOfFacetBlocks ] << sumX, sumY, sumZ, sumScalar;
+        }
+    } );
+
+    // Add block sums in fixed order
+    currentEdgeAndFacetSums_.first.setZero( );
+    for( int block = 0; block < numberOfEdgeBlocks; ++block )
+    {
+        currentEdgeAndFacetSums_.first += edgeBlockSums_[ block ];
+    }
+    currentEdgeAndFacetSums_.second.setZero( );
+    for( int block = 0; block < numberOfFacetBlocks; ++block )
+    {
+        currentEdgeAndFacetSums_.second += facetBlockSums_[ block ];
+    }
+
+    areSumsUpToDate_ = true;
 }
 
 void PolyhedronGravityField::computeVerticesAndFacetsDefiningEachEdge ( )
@@ -46,41 +302,39 @@ void PolyhedronGravityField::computeVerticesAndFacetsDefiningEachEdge ( )
     verticesDefiningEachEdge_ = Eigen::MatrixXi::Constant( numberOfEdges, 2, -1 );
     facetsDefiningEachEdge_ = Eigen::MatrixXi::Constant( numberOfEdges, 2, -1 );
 
+    // Edges are identified by their (sorted) vertex indices, and numbered in order of first occurrence
+    std::unordered_map< long long, unsigned int > edgeIndices;
+    edgeIndices.reserve( numberOfEdges );
+
     unsigned int numberOfInsertedEdges = 0;
     for ( unsigned int facet = 0; facet < numberOfFacets; ++facet )
     {
-        // Extract edges from face
-        std::vector< std::vector< int > > edgesToInsert;
-        const int vertex0 = verticesDefiningEachFacet_(facet,0);
-        const int vertex1 = verticesDefiningEachFacet_(facet,1);
-        const int vertex2 = verticesDefiningEachFacet_(facet,2);
-        edgesToInsert.push_back( { vertex0, vertex1 } );
-        edgesToInsert.push_back( { vertex1, vertex2 } );
-        edgesToInsert.push_back( { vertex2, vertex0 } );
-
-        // Check if all edges of the facet have been included in verticesDefiningEachEdge. If so, remove the edge from
-        // the edgesToInsert vector and add the facet to facetsDefiningEachEdge
-        for ( unsigned int edge = 0; edge < numberOfInsertedEdges && !edgesToInsert.empty(); ++edge )
+        for ( unsigned int i = 0; i < 3; ++i )
         {
-            // Loop over edges of current facet still to be inserted
-            for ( unsigned int i = 0; i < edgesToInsert.size(); ++i)
+            const int vertexA = verticesDefiningEachFacet_(facet,i);
+            const int vertexB = verticesDefiningEachFacet_(facet,(i+1)%3);
+            const long long edgeKey = static_cast< long long >( std::min( vertexA, vertexB ) ) * numberOfVertices +
+                    std::max( vertexA, vertexB );
+
+            // If the edge has already been inserted, add the facet to facetsDefiningEachEdge. Otherwise, add the edge
+            // to verticesDefiningEachEdge
+            std::unordered_map< long long, unsigned int >::const_iterator edgeIterator = edgeIndices.find( edgeKey );
+            if ( edgeIterator != edgeIndices.end( ) )
             {
-                if ( ( edgesToInsert.at(i).at(0) == verticesDefiningEachEdge_(edge, 0) && edgesToInsert.at(i).at(1) == verticesDefiningEachEdge_(edge, 1) ) ||
-                        ( edgesToInsert.at(i).at(0) == verticesDefiningEachEdge_(edge, 1) && edgesToInsert.at(i).at(1) == verticesDefiningEachEdge_(edge, 0) ) )
-                {
-                    edgesToInsert.erase(edgesToInsert.begin() + i);
-                    facetsDefiningEachEdge_(edge, 1) = facet;
-                }
+                facetsDefiningEachEdge_(edgeIterator->second, 1) = facet;
+            }
+            else if ( numberOfInsertedEdges < numberOfEdges )
+            {
+                verticesDefiningEachEdge_(numberOfInsertedEdges,0) = vertexA;
+                verticesDefiningEachEdge_(numberOfInsertedEdges,1) = vertexB;
+                facetsDefiningEachEdge_(numberOfInsertedEdges, 0) = facet;
+                edgeIndices[ edgeKey ] = numberOfInsertedEdges;
+                ++numberOfInsertedEdges;
+            }
+            else
+            {
+                throw std::runtime_error( "Extracted number of polyhedron edges not correct." );
             }
-        }
-
-        // Check if any of the facet's edges still needs to be added to verticesDefiningEachEdge, and add it/them if so
-        for ( unsigned int i = 0; i < edgesToInsert.size(); ++i)
-        {
-            verticesDefiningEachEdge_(numberOfInsertedEdges,0) = edgesToInsert.at(i).at(0);
-            verticesDefiningEachEdge_(numberOfInsertedEdges,1) = edgesToInsert.at(i).at(1);
-            facetsDefiningEachEdge_(numberOfInsertedEdges, 0) = facet;
-            ++numberOfInsertedEdges;
         }
     }
 
@@ -31,38 +31,46 @@ void PolyhedronGravitationalAccelerationModel::updateMembers( const double curre
 
         currentRelativePosition_ = rotationToIntegrationFrame_.inverse( ) * currentInertialRelativePosition_;
 
-        polyhedronCache_->update( currentRelativePosition_ );
-
-        // Compute the current acceleration
-        currentAccelerationInBodyFixedFrame_ = basic_mathematics::calculatePolyhedronGradientOfGravitationalPotential(
-                gravitationalParameterFunction_() / volumeFunction_(),
-                polyhedronCache_->getVerticesCoordinatesRelativeToFieldPoint(),
-                getVerticesDefiningEachFacet_(),
-                getVerticesDefiningEachEdge_(),
-                getFacetDyads_(),
-                getEdgeDyads_(),
-                polyhedronCache_->getPerFacetFactor(),
-                polyhedronCache_->getPerEdgeFactor() );
-
-        currentAcceleration_ = rotationToIntegrationFrame_ * currentAccelerationInBodyFixedFrame_;
-
-        // Compute the current gravitational potential
-        if ( updatePotential_ )
+        isPolyhedronCacheUpToDate_ = false;
+
+        if( facetTree_ != nullptr )
         {
-            currentPotential_ = basic_mathematics::calculatePolyhedronGravitationalPotential(
+            // Compute the current acceleration and gravitational potential using the facet tree
+            currentAccelerationInBodyFixedFrame_ = facetTree_->calculateGradientOfGravitationalPotential(
                     gravitationalParameterFunction_( ) / volumeFunction_( ),
-                    polyhedronCache_->getVerticesCoordinatesRelativeToFieldPoint( ),
-                    getVerticesDefiningEachFacet_( ),
-                    getVerticesDefiningEachEdge_( ),
-                    getFacetDyads_( ),
-                    getEdgeDyads_( ),
-                    polyhedronCache_->getPerFacetFactor( ),
-                    polyhedronCache_->getPerEdgeFactor( ) );
+                    currentRelativePosition_, maximumRelativeTruncationError_ );
+
+            currentAcceleration_ = rotationToIntegrationFrame_ * currentAccelerationInBodyFixedFrame_;
+
+            if ( updatePotential_ )
+            {
+                currentPotential_ = facetTree_->calculateGravitationalPotential(
+                        gravitationalParameterFunction_( ) / volumeFunction_( ),
+                        currentRelativePosition_, maximumRelativeTruncationError_ );
+            }
+        }
+        else
+        {
+            updatePolyhedronCache( );
+
+            // Compute the current acceleration
+            currentAccelerationInBodyFixedFrame_ = polyhedronCache_->calculateGradientOfGravitationalPotential(
+                    gravitationalParameterFunction_() / volumeFunction_() );
+
+            currentAcceleration_ = rotationToIntegrationFrame_ * currentAccelerationInBodyFixedFrame_;
+
+            // Compute the current gravitational potential
+            if ( updatePotential_ )
+            {
+                currentPotential_ = polyhedronCache_->calculateGravitationalPotential(
+                        gravitationalParameterFunction_( ) / volumeFunction_( ) );
+            }
         }
 
         // Compute the current laplacian
         if ( updateLaplacianOfPotential_ )
         {
+            updatePolyhedronCache( );
             currentLaplacianOfPotential_ = basic_mathematics::calculatePolyhedronLaplacianOfGravitationalPotential(
                     gravitationalParameterFunction_( ) / volumeFunction_( ),
                     polyhedronCache_->getPerFacetFactor( ) );
@@ -0,0 +1,352 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the recursive computation of
+ *          very high degree and order normalised associated Legendre functions. Journal of Geodesy 76, 2002.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "tudat/astro/gravitation/sphericalHarmonicsGradientCalculator.h"
+#include "tudat/math/basic/coordinateConversions.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Constructor.
+SphericalHarmonicsGradientCalculator::SphericalHarmonicsGradientCalculator(
+        const Eigen::MatrixXd& cosineCoefficients,
+        const Eigen::MatrixXd& sineCoefficients ):
+    maximumDegree_( -1 ), maximumOrder_( -1 ), numberOfStoredOrders_( 0 )
+{
+    setCoefficients( cosineCoefficients, sineCoefficients );
+}
+
+//! Function to reset the coefficients of the gravity field.
+void SphericalHarmonicsGradientCalculator::setCoefficients(
+        const Eigen::MatrixXd& cosineCoefficients,
+        const Eigen::MatrixXd& sineCoefficients )
+{
+    if( ( cosineCoefficients.rows( ) != sineCoefficients.rows( ) ) ||
+            ( cosineCoefficients.cols( ) != sineCoefficients.cols( ) ) )
+    {
+        throw std::runtime_error( "Error in spherical harmonic gradient calculator, cosine and sine coefficient "
+                                  "matrices have different sizes" );
+    }
+    else if( cosineCoefficients.rows( ) == 0 || cosineCoefficients.cols( ) == 0 )
+    {
+        throw std::runtime_error( "Error in spherical harmonic gradient calculator, coefficient matrices are empty" );
+    }
+
+    // Check if coefficients have changed
+    bool sizeHasChanged = ( cosineCoefficients.rows( ) != cosineCoefficients_.rows( ) ) ||
+            ( cosineCoefficients.cols( ) != cosineCoefficients_.cols( ) );
+    if( !sizeHasChanged && ( cosineCoefficients == cosineCoefficients_ ) && ( sineCoefficients == sineCoefficients_ ) )
+    {
+        return;
+    }
+
+    cosineCoefficients_ = cosineCoefficients;
+    sineCoefficients_ = sineCoefficients;
+
+    if( sizeHasChanged )
+    {
+        maximumDegree_ = cosineCoefficients.rows( ) - 1;
+        maximumOrder_ = std::min( cosineCoefficients.cols( ) - 1, cosineCoefficients.rows( ) - 1 );
+        numberOfStoredOrders_ = maximumOrder_ + 2;
+        resetRecursionMultipliers( );
+    }
+
+    // Store coefficients of each degree contiguously in order, with zeroes for orders exceeding degree
+    packedCosineCoefficients_.setZero( numberOfStoredOrders_, maximumDegree_ + 1 );
+    packedSineCoefficients_.setZero( numberOfStoredOrders_, maximumDegree_ + 1 );
+    for( int degree = 0; degree <= maximumDegree_; degree++ )
+    {
+        int numberOfOrders = std::min( degree, maximumOrder_ ) + 1;
+        packedCosineCoefficients_.col( degree ).head( numberOfOrders ) =
+                cosineCoefficients.row( degree ).head( numberOfOrders ).transpose( );
+        packedSineCoefficients_.col( degree ).head( numberOfOrders ) =
+                sineCoefficients.row( degree ).head( numberOfOrders ).transpose( );
+    }
+}
+
+//! Function to (re)compute the recursion multipliers for the current maximum degree and order.
+void SphericalHarmonicsGradientCalculator::resetRecursionMultipliers( )
+{
+    firstRecursionMultipliers_.setZero( numberOfStoredOrders_, maximumDegree_ + 1 );
+    secondRecursionMultipliers_.setZero( numberOfStoredOrders_, maximumDegree_ + 1 );
+    derivativeMultipliers_.setZero( numberOfStoredOrders_, maximumDegree_ + 1 );
+    sectoralRecursionMultipliers_.setZero( maximumDegree_ + 1 );
+
+    for( int degree = 0; degree <= maximumDegree_; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+        for( int order = 0; order <= std::min( degree, numberOfStoredOrders_ - 1 ); order++ )
+        {
+            const double m = static_cast< double >( order );
+
+            // Multipliers of non-sectoral recursion (Holmes and Featherstone, 2002)
+            if( order < degree && degree >= 2 )
+            {
+                const double commonMultiplier = std::sqrt( ( 2.0 * n + 1.0 ) / ( ( n + m ) * ( n - m ) ) );
+                firstRecursionMultipliers_( order, degree ) = commonMultiplier * std::sqrt( 2.0 * n - 1.0 );
+                if( order < degree - 1 )
+                {
+                    secondRecursionMultipliers_( order, degree ) = commonMultiplier *
+                            std::sqrt( ( n + m - 1.0 ) * ( n - m - 1.0 ) / ( 2.0 * n - 3.0 ) );
+                }
+            }
+
+            // Multipliers of derivative, in which the geodesy-normalization differs for order zero
+            derivativeMultipliers_( order, degree ) = std::sqrt( ( n + m + 1.0 ) * ( n - m ) );
+            if( order == 0 )
+            {
+                derivativeMultipliers_( order, degree ) *= std::sqrt( 0.5 );
+            }
+        }
+
+        if( degree >= 2 )
+        {
+            sectoralRecursionMultipliers_( degree ) = std::sqrt( ( 2.0 * n + 1.0 ) / ( 2.0 * n ) );
+        }
+    }
+
+    orders_ = Eigen::ArrayXd::LinSpaced( numberOfStoredOrders_, 0.0, static_cast< double >( numberOfStoredOrders_ - 1 ) );
+    singlePositionWorkspace_.resize( numberOfStoredOrders_, 1 );
+}
+
+//! Function to (re)allocate the work arrays for given number of stored orders and maximum block size.
+void SphericalHarmonicsGradientCalculator::Workspace::resize( const int numberOfStoredOrders, const int blockSize )
+{
+    for( int i = 0; i < 3; i++ )
+    {
+        legendrePolynomials[ i ].setZero( numberOfStoredOrders, blockSize );
+    }
+    cosinesOfOrderTimesLongitude.setZero( numberOfStoredOrders, blockSize );
+    sinesOfOrderTimesLongitude.setZero( numberOfStoredOrders, blockSize );
+    cosineTerms.setZero( numberOfStoredOrders );
+    sineTerms.setZero( numberOfStoredOrders );
+    sinesOfLatitude.setZero( blockSize );
+    cosinesOfLatitude.setZero( blockSize );
+    tangentsOfLatitude.setZero( blockSize );
+    radiusRatios.setZero( blockSize );
+    radiusRatioPowers.setZero( blockSize );
+    sphericalGradients.setZero( 3, blockSize );
+}
+
+//! Function to compute the gradient at a block of positions.
+template< typename PositionsType, typename GradientsType >
+void SphericalHarmonicsGradientCalculator::computeGradientsOfBlock(
+        const PositionsType& bodyFixedPositions,
+        const int firstPositionIndex,
+        const int numberOfPositions,
+        const double gravitationalParameter,
+        const double referenceRadius,
+        Workspace& workspace,
+        GradientsType& gradients ) const
+{
+    // Compute position-dependent terms that are independent of degree
+    for( int k = 0; k < numberOfPositions; k++ )
+    {
+        Eigen::Vector3d sphericalPosition = coordinate_conversions::convertCartesianToSpherical(
+                    Eigen::Vector3d( bodyFixedPositions.row( firstPositionIndex + k ).transpose( ) ) );
+        workspace.sinesOfLatitude( k ) = std::sin( mathematical_constants::PI / 2.0 - sphericalPosition( 1 ) );
+        workspace.cosinesOfLatitude( k ) =
+                std::sqrt( 1.0 - workspace.sinesOfLatitude( k ) * workspace.sinesOfLatitude( k ) );
+        workspace.tangentsOfLatitude( k ) = workspace.sinesOfLatitude( k ) / workspace.cosinesOfLatitude( k );
+        if( !std::isfinite( workspace.tangentsOfLatitude( k ) ) && maximumDegree_ > 0 )
+        {
+            throw std::runtime_error( "Error when computing spherical harmonic gradient, found NaN/Inf value. This may be "
+                                      "caused by evaluating at the poles, where a singularity occurs" );
+        }
+        workspace.radiusRatios( k ) = referenceRadius / sphericalPosition( 0 );
+        workspace.radiusRatioPowers( k ) = workspace.radiusRatios( k );
+
+        // Compute cosines and sines of order times longitude by recursion
+        const double cosineOfLongitude = std::cos( sphericalPosition( 2 ) );
+        const double sineOfLongitude = std::sin( sphericalPosition( 2 ) );
+        workspace.cosinesOfOrderTimesLongitude( 0, k ) = 1.0;
+        workspace.sinesOfOrderTimesLongitude( 0, k ) = 0.0;
+        for( int order = 1; order < numberOfStoredOrders_; order++ )
+        {
+            workspace.cosinesOfOrderTimesLongitude( order, k ) =
+                    workspace.cosinesOfOrderTimesLongitude( order - 1, k ) * cosineOfLongitude -
+                    workspace.sinesOfOrderTimesLongitude( order - 1, k ) * sineOfLongitude;
+            workspace.sinesOfOrderTimesLongitude( order, k ) =
+                    workspace.sinesOfOrderTimesLongitude( order - 1, k ) * cosineOfLongitude +
+                    workspace.cosinesOfOrderTimesLongitude( order - 1, k ) * sineOfLongitude;
+        }
+    }
+    workspace.sphericalGradients.leftCols( numberOfPositions ).setZero( );
+    for( int i = 0; i < 3; i++ )
+    {
+        workspace.legendrePolynomials[ i ].leftCols( numberOfPositions ).setZero( );
+    }
+
+    // Sum contributions per degree (looping over the positions of the block for each degree, so that the coefficients
+    // and multipliers of each degree are only traversed once per block), vectorized over the orders.
+    for( int degree = 0; degree <= maximumDegree_; degree++ )
+    {
+        Eigen::MatrixXd& currentLegendrePolynomials = workspace.legendrePolynomials[ degree % 3 ];
+        const Eigen::MatrixXd& previousLegendrePolynomials = workspace.legendrePolynomials[ ( degree + 2 ) % 3 ];
+        const Eigen::MatrixXd& secondPreviousLegendrePolynomials = workspace.legendrePolynomials[ ( degree + 1 ) % 3 ];
+
+        const int numberOfOrders = std::min( degree, maximumOrder_ ) + 1;
+        const int numberOfRecursionOrders = std::min( degree - 1, numberOfStoredOrders_ );
+
+        for( int k = 0; k < numberOfPositions; k++ )
+        {
+            // Compute geodesy-normalized Legendre polynomials of current degree, up to order maximumOrder_ + 1
+            const double sineOfLatitude = workspace.sinesOfLatitude( k );
+            if( degree == 0 )
+            {
+                currentLegendrePolynomials( 0, k ) = 1.0;
+            }
+            else if( degree == 1 )
+            {
+                currentLegendrePolynomials( 0, k ) = std::sqrt( 3.0 ) * sineOfLatitude;
+                currentLegendrePolynomials( 1, k ) = std::sqrt( 3.0 ) * workspace.cosinesOfLatitude( k );
+            }
+            else
+            {
+                // Compute non-sectoral terms up to order degree - 2 in a single (vectorized) array operation
+                currentLegendrePolynomials.col( k ).head( numberOfRecursionOrders ).array( ) =
+                        sineOfLatitude * firstRecursionMultipliers_.col( degree ).head( numberOfRecursionOrders ).array( ) *
+                        previousLegendrePolynomials.col( k ).head( numberOfRecursionOrders ).array( ) -
+                        secondRecursionMultipliers_.col( degree ).head( numberOfRecursionOrders ).array( ) *
+                        secondPreviousLegendrePolynomials.col( k ).head( numberOfRecursionOrders ).array( );
+
+                // Compute term of order degree - 1 (for which P_{n-2,m} is zero)
+                if( degree - 1 < numberOfStoredOrders_ )
+                {
+                    currentLegendrePolynomials( degree - 1, k ) =
+                            sineOfLatitude * firstRecursionMultipliers_( degree - 1, degree ) *
+                            previousLegendrePolynomials( degree - 1, k );
+                }
+
+                // Compute sectoral term
+                if( degree < numberOfStoredOrders_ )
+                {
+                    currentLegendrePolynomials( degree, k ) =
+                            workspace.cosinesOfLatitude( k ) * sectoralRecursionMultipliers_( degree ) *
+                            previousLegendrePolynomials( degree - 1, k );
+                }
+            }
+
+            workspace.cosineTerms.head( numberOfOrders ) =
+                    packedCosineCoefficients_.col( degree ).head( numberOfOrders ).array( ) *
+                    workspace.cosinesOfOrderTimesLongitude.col( k ).head( numberOfOrders ).array( ) +
+                    packedSineCoefficients_.col( degree ).head( numberOfOrders ).array( ) *
+                    workspace.sinesOfOrderTimesLongitude.col( k ).head( numberOfOrders ).array( );
+            workspace.sineTerms.head( numberOfOrders ) =
+                    packedSineCoefficients_.col( degree ).head( numberOfOrders ).array( ) *
+                    workspace.cosinesOfOrderTimesLongitude.col( k ).head( numberOfOrders ).array( ) -
+                    packedCosineCoefficients_.col( degree ).head( numberOfOrders ).array( ) *
+                    workspace.sinesOfOrderTimesLongitude.col( k ).head( numberOfOrders ).array( );
+
+            // Radial term
+            const double radialSum = ( currentLegendrePolynomials.col( k ).head( numberOfOrders ).array( ) *
+                                       workspace.cosineTerms.head( numberOfOrders ) ).sum( );
+
+            // Latitude term, using cos(latitude) times derivative of P_{n,m} w.r.t. sin(latitude)
+            const double latitudeSum =
+                    ( ( derivativeMultipliers_.col( degree ).head( numberOfOrders ).array( ) *
+                        currentLegendrePolynomials.col( k ).segment( 1, numberOfOrders ).array( ) -
+                        workspace.tangentsOfLatitude( k ) * orders_.head( numberOfOrders ) *
+                        currentLegendrePolynomials.col( k ).head( numberOfOrders ).array( ) ) *
+                      workspace.cosineTerms.head( numberOfOrders ) ).sum( );
+
+            // Longitude term
+            const double longitudeSum = ( orders_.head( numberOfOrders ) *
+                                          currentLegendrePolynomials.col( k ).head( numberOfOrders ).array( ) *
+                                          workspace.sineTerms.head( numberOfOrders ) ).sum( );
+
+            const double radiusRatioPower = workspace.radiusRatioPowers( k );
+            workspace.sphericalGradients( 0, k ) -= radiusRatioPower * static_cast< double >( degree + 1 ) * radialSum;
+            workspace.sphericalGradients( 1, k ) += radiusRatioPower * latitudeSum;
+            workspace.sphericalGradients( 2, k ) += radiusRatioPower * longitudeSum;
+            workspace.radiusRatioPowers( k ) *= workspace.radiusRatios( k );
+        }
+    }
+
+    // Scale and convert gradients to Cartesian coordinates
+    const double preMultiplier = gravitationalParameter / referenceRadius;
+    for( int k = 0; k < numberOfPositions; k++ )
+    {
+        const Eigen::Vector3d currentPosition = bodyFixedPositions.row( firstPositionIndex + k ).transpose( );
+        Eigen::Vector3d sphericalGradient = preMultiplier * workspace.sphericalGradients.col( k );
+        sphericalGradient( 0 ) *= workspace.radiusRatios( k ) / referenceRadius;
+        gradients.row( firstPositionIndex + k ) =
+                ( coordinate_conversions::getSphericalToCartesianGradientMatrix( currentPosition ) *
+                  sphericalGradient ).transpose( );
+    }
+}
+
+//! Function to compute the gradient of the gravitational potential (e.g. the gravitational acceleration).
+Eigen::Vector3d SphericalHarmonicsGradientCalculator::computeGradient(
+        const Eigen::Vector3d& bodyFixedPosition,
+        const double gravitationalParameter,
+        const double referenceRadius )
+{
+    const Eigen::RowVector3d bodyFixedPositionRow = bodyFixedPosition.transpose( );
+    Eigen::RowVector3d gradient;
+    computeGradientsOfBlock( bodyFixedPositionRow, 0, 1, gravitationalParameter, referenceRadius,
+                             singlePositionWorkspace_, gradient );
+    return gradient.transpose( );
+}
+
+//! Function to compute the gradient of the gravitational potential at a list of positions.
+Eigen::MatrixXd SphericalHarmonicsGradientCalculator::computeGradients(
+        const Eigen::MatrixXd& bodyFixedPositions,
+        const double gravitationalParameter,
+        const double referenceRadius,
+        const std::shared_ptr< utilities::ThreadPool > threadPool ) const
+{
+    if( bodyFixedPositions.cols( ) != 3 )
+    {
+        throw std::runtime_error( "Error when computing spherical harmonic gradients, positions must be provided as "
+                                  "N x 3 matrix" );
+    }
+
+    const int numberOfPositions = bodyFixedPositions.rows( );
+    const int numberOfBlocks = ( numberOfPositions + POSITION_BLOCK_SIZE - 1 ) / POSITION_BLOCK_SIZE;
+
+    // Create work arrays for each thread
+    std::vector< Workspace > workspaces( ( threadPool == nullptr ) ? 1 : threadPool->getNumberOfThreads( ) );
+    for( unsigned int i = 0; i < workspaces.size( ); i++ )
+    {
+        workspaces.at( i ).resize( numberOfStoredOrders_, POSITION_BLOCK_SIZE );
+    }
+
+    // Compute gradients, with each block of positions written to separate rows of output
+    Eigen::MatrixXd gradients = Eigen::MatrixXd::Zero( numberOfPositions, 3 );
+    utilities::runTasks( threadPool, numberOfBlocks, [ & ]( const int blockIndex, const unsigned int threadIndex )
+    {
+        const int firstPositionIndex = blockIndex * POSITION_BLOCK_SIZE;
+        computeGradientsOfBlock(
+                    bodyFixedPositions, firstPositionIndex,
+                    std::min( POSITION_BLOCK_SIZE, numberOfPositions - firstPositionIndex ),
+                    gravitationalParameter, referenceRadius, workspaces.at( threadIndex ), gradients );
+    } );
+
+    return gradients;
+}
+
+} // namespace gravitation
+
+} // namespace tudat
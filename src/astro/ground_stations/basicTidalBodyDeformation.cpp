@@ -140,6 +140,7 @@ Eigen::Vector3d BasicTidalBodyDeformation::calculateDisplacement(
         const double time,
         const Eigen::Vector3d& bodyFixedPosition )
 {
+    std::lock_guard< std::mutex > bodyPropertiesLock( bodyPropertiesMutex_ );
     updateBodyProperties( time );
     return calculateBasicTicalDisplacement( bodyFixedPosition, displacementLoveNumbers_ );
 
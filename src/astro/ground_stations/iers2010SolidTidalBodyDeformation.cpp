@@ -375,6 +375,8 @@ Eigen::Vector3d Iers2010EarthDeformation::calculateDisplacement(
         const double ephemerisTime,
         const std::shared_ptr< ground_stations::GroundStationState > nominalSiteState )
 {
+    // Lock body properties until displacement is computed, as they are shared between threads
+    std::lock_guard< std::mutex > bodyPropertiesLock( bodyPropertiesMutex_ );
     updateBodyProperties( ephemerisTime );
 
     // If Doodson arguments are required and not provided by user, calculate them.
@@ -40,10 +40,13 @@ void PanelledRadiationPressurePartial::update( const double currentTime )
 
             double currentPanelArea = 0.0, currentPanelEmissivity = 0.0, cosineOfPanelInclination = 0.0;
 
+            const int sourceIndex = radiationPressureAcceleration_->getSourceIndex( );
+            const Eigen::VectorXd& surfacePanelCosines = panelledTargetModel_->getSurfacePanelCosines( sourceIndex );
+            const Eigen::Matrix< double, Eigen::Dynamic, 3 >& panelForces = panelledTargetModel_->getPanelForces( sourceIndex );
             for( int i = 0; i < panelledTargetModel_->getTotalNumberOfPanels( ); i++ )
             {
-                currentPanelNormal = panelledTargetModel_->getSurfaceNormals( ).at( i );
-                cosineOfPanelInclination = panelledTargetModel_->getSurfacePanelCosines( acceleratingBody_ ).at( i );
+                currentPanelNormal = panelledTargetModel_->getSurfaceNormals( ).row( i ).transpose( );
+                cosineOfPanelInclination = surfacePanelCosines( i );
 
                 currentPanelPartialContribution.setZero( );
                 if( cosineOfPanelInclination > 0.0 )
@@ -51,7 +54,7 @@ void PanelledRadiationPressurePartial::update( const double currentTime )
                     currentCosineAnglePartial_ = currentPanelNormal.transpose( ) * currentSourceUnitVectorPartial_;
 
                     currentPanelArea = panelledTargetModel_->getBodyFixedPanels( ).at( i )->getPanelArea( );
-                    currentPanelReactionVector = panelledTargetModel_->getPanelForces( acceleratingBody_ ).at( i ) / ( currentRadiationPressure * currentPanelArea );
+                    currentPanelReactionVector = panelForces.row( i ).transpose( ) / ( currentRadiationPressure * currentPanelArea );
 
                     currentPanelPartialContribution += panelledTargetModel_->getFullPanels( ).at( i )->getReflectionLaw( )->
                         evaluateReactionVectorDerivativeWrtTargetPosition(
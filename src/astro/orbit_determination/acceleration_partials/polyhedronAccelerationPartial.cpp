@@ -39,6 +39,8 @@ PolyhedronGravityPartial::PolyhedronGravityPartial (
                                       accelerationModel ) ),
     updateFunction_( std::bind( &gravitation::PolyhedronGravitationalAccelerationModel::updateMembers,
                                 accelerationModel, std::placeholders::_1 ) ),
+    updatePolyhedronCacheFunction_( std::bind( &gravitation::PolyhedronGravitationalAccelerationModel::updatePolyhedronCache,
+                                               accelerationModel ) ),
     rotationMatrixPartials_( rotationMatrixPartials )
 {
 
@@ -52,6 +54,7 @@ void PolyhedronGravityPartial::update( const double currentTime )
     {
         // Update acceleration model
         updateFunction_( currentTime );
+        updatePolyhedronCacheFunction_( );
 
         // Calculate Cartesian position in frame fixed to body exerting acceleration
         Eigen::Matrix3d currentRotationToBodyFixedFrame_ = fromBodyFixedToIntegrationFrameRotation_( ).inverse( );
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <stdexcept>
 #include "tudat/astro/propagators/environmentUpdateTypes.h"
 
 namespace tudat
@@ -17,6 +18,48 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to get a string representing an environment model update type (e.g. for profiling output)
+std::string getEnvironmentModelUpdateName( const EnvironmentModelsToUpdate updateType )
+{
+    std::string updateName;
+    switch( updateType )
+    {
+    case body_translational_state_update:
+        updateName = "translational state";
+        break;
+    case body_rotational_state_update:
+        updateName = "rotational state";
+        break;
+    case spherical_harmonic_gravity_field_update:
+        updateName = "spherical harmonic gravity field";
+        break;
+    case body_mass_update:
+        updateName = "mass";
+        break;
+    case body_mass_distribution_update:
+        updateName = "mass distribution";
+        break;
+    case vehicle_flight_conditions_update:
+        updateName = "flight conditions";
+        break;
+    case radiation_source_model_update:
+        updateName = "radiation source model";
+        break;
+    case cannonball_radiation_pressure_target_model_update:
+        updateName = "cannonball radiation pressure target model";
+        break;
+    case panelled_radiation_pressure_target_model_update:
+        updateName = "panelled radiation pressure target model";
+        break;
+    case body_segment_orientation_update:
+        updateName = "body segment orientation";
+        break;
+    default:
+        throw std::runtime_error( "Error, environment model update type " + std::to_string( updateType ) + " not recognized." );
+    }
+    return updateName;
+}
+
 //! Function to extend existing list of required environment update types
 void addEnvironmentUpdates( std::map< propagators::EnvironmentModelsToUpdate,
                             std::vector< std::string > >& environmentUpdateList,
@@ -317,6 +317,128 @@ std::vector< std::string > determineEphemerisUpdateorder( std::vector< std::stri
     return updateOrder;
 }
 
+//! Function to add the constituent acceleration models of a third-body acceleration to its update dependencies.
+template< typename ThirdBodyAccelerationType >
+bool addThirdBodyAccelerationUpdateDependencies(
+        const std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel,
+        std::vector< const void* >& updateDependencies )
+{
+    std::shared_ptr< ThirdBodyAccelerationType > thirdBodyAcceleration =
+            std::dynamic_pointer_cast< ThirdBodyAccelerationType >( accelerationModel );
+    if( thirdBodyAcceleration == nullptr )
+    {
+        return false;
+    }
+
+    updateDependencies.push_back( thirdBodyAcceleration->getAccelerationModelForBodyUndergoingAcceleration( ).get( ) );
+    updateDependencies.push_back( thirdBodyAcceleration->getAccelerationModelForCentralBody( ).get( ) );
+    return true;
+}
+
+//! Function to retrieve the objects that may be modified when updating an acceleration model.
+std::vector< const void* > getAccelerationModelUpdateDependencies(
+        const std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel )
+{
+    using namespace gravitation;
+
+    std::vector< const void* > updateDependencies = { accelerationModel.get( ) };
+
+    std::shared_ptr< electromagnetism::RadiationPressureAcceleration > radiationPressureAcceleration =
+            std::dynamic_pointer_cast< electromagnetism::RadiationPressureAcceleration >( accelerationModel );
+
+    if( addThirdBodyAccelerationUpdateDependencies< ThirdBodyCentralGravityAcceleration >(
+            accelerationModel, updateDependencies ) ||
+        addThirdBodyAccelerationUpdateDependencies< ThirdBodySphericalHarmonicsGravitationalAccelerationModel >(
+            accelerationModel, updateDependencies ) ||
+        addThirdBodyAccelerationUpdateDependencies< ThirdBodyMutualSphericalHarmonicsGravitationalAccelerationModel >(
+            accelerationModel, updateDependencies ) ||
+        addThirdBodyAccelerationUpdateDependencies< ThirdBodyPolyhedronGravitationalAccelerationModel >(
+            accelerationModel, updateDependencies ) ||
+        addThirdBodyAccelerationUpdateDependencies< ThirdBodyRingGravitationalAccelerationModel >(
+            accelerationModel, updateDependencies ) )
+    {
+        return updateDependencies;
+    }
+    else if( radiationPressureAcceleration != nullptr )
+    {
+        // Source and target models may store intermediate results of the acceleration computation
+        updateDependencies.push_back( radiationPressureAcceleration->getSourceModel( ).get( ) );
+        updateDependencies.push_back( radiationPressureAcceleration->getTargetModel( ).get( ) );
+        updateDependencies.push_back( radiationPressureAcceleration->getSourceToTargetOccultationModel( ).get( ) );
+    }
+    else if( std::dynamic_pointer_cast< CentralGravitationalAccelerationModel3d >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< SphericalHarmonicsGravitationalAccelerationModel >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< MutualSphericalHarmonicsGravitationalAccelerationModel >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< PolyhedronGravitationalAccelerationModel >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< RingGravitationalAccelerationModel >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< aerodynamics::AerodynamicAcceleration >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< relativity::RelativisticAccelerationCorrection >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< basic_astrodynamics::EmpiricalAcceleration >( accelerationModel ) == nullptr &&
+             std::dynamic_pointer_cast< DirectTidalDissipationAcceleration >( accelerationModel ) == nullptr )
+    {
+        // Update of other acceleration models (e.g. thrust, custom) may modify objects shared with other models.
+        updateDependencies.push_back( nullptr );
+    }
+
+    return updateDependencies;
+}
+
+//! Function to divide a list of acceleration models into groups that can be updated concurrently.
+std::vector< std::vector< int > > getIndependentAccelerationUpdateGroups(
+        const std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >& accelerationModelList )
+{
+    // Merge acceleration models sharing a dependency into a single group, identified by the index of one of its models.
+    std::vector< int > parentModelIndices( accelerationModelList.size( ) );
+    std::function< int( const int ) > getGroupIndex = [ & ]( const int modelIndex )
+    {
+        int groupIndex = modelIndex;
+        while( parentModelIndices.at( groupIndex ) != groupIndex )
+        {
+            groupIndex = parentModelIndices.at( groupIndex );
+        }
+        parentModelIndices.at( modelIndex ) = groupIndex;
+        return groupIndex;
+    };
+
+    std::map< const void*, int > dependencyModelIndices;
+    for( unsigned int i = 0; i < accelerationModelList.size( ); i++ )
+    {
+        parentModelIndices.at( i ) = i;
+        std::vector< const void* > updateDependencies =
+                getAccelerationModelUpdateDependencies( accelerationModelList.at( i ) );
+        for( unsigned int j = 0; j < updateDependencies.size( ); j++ )
+        {
+            if( dependencyModelIndices.count( updateDependencies.at( j ) ) == 0 )
+            {
+                dependencyModelIndices[ updateDependencies.at( j ) ] = i;
+            }
+            else
+            {
+                int firstGroupIndex = getGroupIndex( dependencyModelIndices.at( updateDependencies.at( j ) ) );
+                int secondGroupIndex = getGroupIndex( i );
+                parentModelIndices.at( std::max( firstGroupIndex, secondGroupIndex ) ) =
+                        std::min( firstGroupIndex, secondGroupIndex );
+            }
+        }
+    }
+
+    // Collect the models in each group, in order of first appearance
+    std::vector< std::vector< int > > accelerationUpdateGroups;
+    std::map< int, int > groupListIndices;
+    for( unsigned int i = 0; i < accelerationModelList.size( ); i++ )
+    {
+        int groupIndex = getGroupIndex( i );
+        if( groupListIndices.count( groupIndex ) == 0 )
+        {
+            groupListIndices[ groupIndex ] = accelerationUpdateGroups.size( );
+            accelerationUpdateGroups.push_back( std::vector< int >( ) );
+        }
+        accelerationUpdateGroups.at( groupListIndices.at( groupIndex ) ).push_back( i );
+    }
+
+    return accelerationUpdateGroups;
+}
+
 template class NBodyStateDerivative< double, double >;
 
 }
@@ -0,0 +1,242 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "tudat/astro/basic_astro/accelerationModelTypes.h"
+#include "tudat/astro/gravitation/centralGravityModel.h"
+#include "tudat/astro/propagators/nBodyTaylorSeriesExpressions.h"
+#include "tudat/astro/relativity/einsteinInfeldHoffmannAcceleration.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+using numerical_integrators::TaylorSeriesVariable;
+
+//! Function to record the N-body point-mass state derivative for Taylor series generation.
+std::shared_ptr< numerical_integrators::TaylorSeriesExpression > createNBodyPointMassTaylorSeriesExpression(
+        const std::vector< double >& gravitationalParameters )
+{
+    return numerical_integrators::createTaylorSeriesExpression(
+                6 * static_cast< int >( gravitationalParameters.size( ) ),
+                [ & ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return computeNBodyPointMassStateDerivative( state, gravitationalParameters );
+    } );
+}
+
+//! Function to record the N-body EIH state derivative for Taylor series generation.
+std::shared_ptr< numerical_integrators::TaylorSeriesExpression > createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression(
+        const std::vector< double >& gravitationalParameters, const double ppnGamma, const double ppnBeta )
+{
+    return numerical_integrators::createTaylorSeriesExpression(
+                6 * static_cast< int >( gravitationalParameters.size( ) ),
+                [ & ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return computeNBodyEinsteinInfeldHoffmannStateDerivative( state, gravitationalParameters, ppnGamma, ppnBeta );
+    } );
+}
+
+//! Function to record the N-body state derivative for Taylor series generation, from the acceleration models of a propagation.
+std::shared_ptr< numerical_integrators::TaylorSeriesExpression > createNBodyTaylorSeriesExpression(
+        const basic_astrodynamics::AccelerationMap& accelerationModelMap,
+        const std::vector< std::string >& bodiesToPropagate,
+        const std::vector< std::string >& centralBodies )
+{
+    using namespace basic_astrodynamics;
+
+    const int numberOfBodies = static_cast< int >( bodiesToPropagate.size( ) );
+    if( static_cast< int >( centralBodies.size( ) ) != numberOfBodies )
+    {
+        throw std::runtime_error( "Error when creating N-body Taylor series expression, number of central bodies (" +
+                                  std::to_string( centralBodies.size( ) ) + ") and propagated bodies (" +
+                                  std::to_string( numberOfBodies ) + ") are inconsistent" );
+    }
+
+    // Check that all bodies are propagated w.r.t. the same origin, which is not propagated
+    std::map< std::string, int > bodyIndices;
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        bodyIndices[ bodiesToPropagate.at( i ) ] = i;
+    }
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        if( centralBodies.at( i ) != centralBodies.at( 0 ) )
+        {
+            throw std::runtime_error( "Error when creating N-body Taylor series expression, all bodies must be propagated "
+                                      "w.r.t. the same origin (found " + centralBodies.at( 0 ) + " and " +
+                                      centralBodies.at( i ) + ")" );
+        }
+        else if( bodyIndices.count( centralBodies.at( i ) ) > 0 )
+        {
+            throw std::runtime_error( "Error when creating N-body Taylor series expression, central body " +
+                                      centralBodies.at( i ) + " is propagated" );
+        }
+    }
+
+    // Retrieve gravitational parameters of point-mass attractions between all pairs of bodies, and EIH equations
+    std::vector< std::vector< double > > pointMassGravitationalParameters(
+                numberOfBodies, std::vector< double >( numberOfBodies, TUDAT_NAN ) );
+    std::vector< bool > isEihAccelerationUsed( numberOfBodies, false );
+    std::shared_ptr< relativity::EinsteinInfeldHoffmannEquations > eihEquations;
+    bool isPointMassAccelerationUsed = false;
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        if( accelerationModelMap.count( bodiesToPropagate.at( i ) ) == 0 )
+        {
+            continue;
+        }
+
+        for( auto accelerationIterator : accelerationModelMap.at( bodiesToPropagate.at( i ) ) )
+        {
+            const std::string bodyExertingAcceleration = accelerationIterator.first;
+            for( auto accelerationModel : accelerationIterator.second )
+            {
+                const AvailableAcceleration accelerationType = getAccelerationModelType( accelerationModel );
+                if( accelerationType == point_mass_gravity )
+                {
+                    std::shared_ptr< gravitation::CentralGravitationalAccelerationModel3d > pointMassAcceleration =
+                            std::dynamic_pointer_cast< gravitation::CentralGravitationalAccelerationModel3d >(
+                                accelerationModel );
+                    if( bodyIndices.count( bodyExertingAcceleration ) == 0 )
+                    {
+                        throw std::runtime_error( "Error when creating N-body Taylor series expression, point-mass "
+                                                  "acceleration on " + bodiesToPropagate.at( i ) + " is exerted by " +
+                                                  bodyExertingAcceleration + ", which is not propagated" );
+                    }
+                    else if( pointMassAcceleration->getIsMutualAttractionUsed( ) )
+                    {
+                        throw std::runtime_error( "Error when creating N-body Taylor series expression, point-mass "
+                                                  "acceleration of " + bodyExertingAcceleration + " on " +
+                                                  bodiesToPropagate.at( i ) + " uses mutual attraction" );
+                    }
+
+                    const int exertingBodyIndex = bodyIndices.at( bodyExertingAcceleration );
+                    if( !std::isnan( pointMassGravitationalParameters.at( i ).at( exertingBodyIndex ) ) )
+                    {
+                        throw std::runtime_error( "Error when creating N-body Taylor series expression, multiple point-mass "
+                                                  "accelerations of " + bodyExertingAcceleration + " on " +
+                                                  bodiesToPropagate.at( i ) );
+                    }
+                    pointMassGravitationalParameters.at( i ).at( exertingBodyIndex ) =
+                            pointMassAcceleration->getGravitationalParameterFunction( )( );
+                    isPointMassAccelerationUsed = true;
+                }
+                else if( accelerationType == einstein_infeld_hoffmann_acceleration )
+                {
+                    std::shared_ptr< relativity::EinsteinInfeldHoffmannEquations > currentEihEquations =
+                            std::dynamic_pointer_cast< relativity::EinsteinInfeldHoffmannAcceleration >(
+                                accelerationModel )->getEihEquations( );
+                    if( eihEquations != nullptr && eihEquations != currentEihEquations )
+                    {
+                        throw std::runtime_error( "Error when creating N-body Taylor series expression, EIH accelerations "
+                                                  "must be computed from a single set of EIH equations" );
+                    }
+                    eihEquations = currentEihEquations;
+                    isEihAccelerationUsed.at( i ) = true;
+                }
+                else
+                {
+                    throw std::runtime_error( "Error when creating N-body Taylor series expression, acceleration of type " +
+                                              getAccelerationModelName( accelerationType ) + " exerted by " +
+                                              bodyExertingAcceleration + " on " + bodiesToPropagate.at( i ) +
+                                              " is not supported; only point-mass gravity and EIH accelerations are" );
+                }
+            }
+        }
+    }
+
+    std::vector< double > gravitationalParameters( numberOfBodies, 0.0 );
+    if( eihEquations != nullptr )
+    {
+        // Check that the EIH equations describe the mutual attraction of (only) the propagated bodies
+        if( isPointMassAccelerationUsed )
+        {
+            throw std::runtime_error( "Error when creating N-body Taylor series expression, point-mass and EIH accelerations "
+                                      "cannot be combined" );
+        }
+        else if( std::find( isEihAccelerationUsed.begin( ), isEihAccelerationUsed.end( ), false ) !=
+                 isEihAccelerationUsed.end( ) )
+        {
+            throw std::runtime_error( "Error when creating N-body Taylor series expression, EIH acceleration must act on all "
+                                      "propagated bodies" );
+        }
+        else if( eihEquations->getOmitMainTerm( ) )
+        {
+            throw std::runtime_error( "Error when creating N-body Taylor series expression, EIH accelerations without main "
+                                      "(point-mass) term are not supported" );
+        }
+
+        std::vector< std::string > bodiesUndergoingAcceleration = eihEquations->getBodiesUndergoingAcceleration( );
+        std::vector< std::string > bodiesExertingAcceleration = eihEquations->getBodiesExertingAcceleration( );
+        std::vector< std::string > sortedBodiesToPropagate = bodiesToPropagate;
+        std::sort( bodiesUndergoingAcceleration.begin( ), bodiesUndergoingAcceleration.end( ) );
+        std::sort( bodiesExertingAcceleration.begin( ), bodiesExertingAcceleration.end( ) );
+        std::sort( sortedBodiesToPropagate.begin( ), sortedBodiesToPropagate.end( ) );
+        if( bodiesUndergoingAcceleration != sortedBodiesToPropagate || bodiesExertingAcceleration != sortedBodiesToPropagate )
+        {
+            throw std::runtime_error( "Error when creating N-body Taylor series expression, bodies undergoing and exerting "
+                                      "EIH accelerations must be the propagated bodies" );
+        }
+
+        const std::map< std::string, int > acceleratingBodyMap = eihEquations->getAcceleratingBodyMap( );
+        const std::vector< std::function< double( ) > > gravitationalParameterFunctions =
+                eihEquations->getGravitationalParameterFunctions( );
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            gravitationalParameters.at( i ) =
+                    gravitationalParameterFunctions.at( acceleratingBodyMap.at( bodiesToPropagate.at( i ) ) )( );
+        }
+        return createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression(
+                    gravitationalParameters, eihEquations->getPpnGammaFunction( )( ),
+                    eihEquations->getPpnBetaFunction( )( ) );
+    }
+    else
+    {
+        // Check that the point-mass attraction of each body acts on all other bodies, with the same gravitational parameter
+        for( int j = 0; j < numberOfBodies; j++ )
+        {
+            int numberOfAttractedBodies = 0;
+            for( int i = 0; i < numberOfBodies; i++ )
+            {
+                const double gravitationalParameter = pointMassGravitationalParameters.at( i ).at( j );
+                if( !std::isnan( gravitationalParameter ) )
+                {
+                    if( numberOfAttractedBodies > 0 && gravitationalParameter != gravitationalParameters.at( j ) )
+                    {
+                        throw std::runtime_error( "Error when creating N-body Taylor series expression, point-mass "
+                                                  "accelerations of " + bodiesToPropagate.at( j ) + " use different "
+                                                  "gravitational parameters" );
+                    }
+                    gravitationalParameters.at( j ) = gravitationalParameter;
+                    numberOfAttractedBodies++;
+                }
+            }
+
+            if( numberOfAttractedBodies > 0 && numberOfAttractedBodies != numberOfBodies - 1 )
+            {
+                throw std::runtime_error( "Error when creating N-body Taylor series expression, point-mass acceleration of " +
+                                          bodiesToPropagate.at( j ) + " must act on all other propagated bodies" );
+            }
+        }
+        return createNBodyPointMassTaylorSeriesExpression( gravitationalParameters );
+    }
+}
+
+} // namespace propagators
+
+} // namespace tudat
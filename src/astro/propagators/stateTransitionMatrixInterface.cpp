@@ -43,16 +43,18 @@ Eigen::MatrixXd SingleArcCombinedStateTransitionAndSensitivityMatrixInterface::g
         const bool addCentralBodyDependency,
         const std::vector< std::string >& arcDefiningBodies )
 {
-    combinedStateTransitionMatrix_.setZero( );
+    // Matrix is created locally (rather than stored as member), so that this function may be called concurrently
+    Eigen::MatrixXd combinedStateTransitionMatrix = Eigen::MatrixXd::Zero(
+                stateTransitionMatrixSize_, stateTransitionMatrixSize_ + sensitivityMatrixSize_ );
 
 
     // Set Phi and S matrices.
-    combinedStateTransitionMatrix_.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
+    combinedStateTransitionMatrix.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
             stateTransitionMatrixInterpolator_->interpolate( evaluationTime );
 
     if( sensitivityMatrixSize_ > 0 )
     {
-        combinedStateTransitionMatrix_.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
+        combinedStateTransitionMatrix.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
                 sensitivityMatrixInterpolator_->interpolate( evaluationTime );
     }
 
@@ -60,14 +62,14 @@ Eigen::MatrixXd SingleArcCombinedStateTransitionAndSensitivityMatrixInterface::g
     {
         for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
         {
-            combinedStateTransitionMatrix_.block(
+            combinedStateTransitionMatrix.block(
                     statePartialAdditionIndices_.at( i ).first, 0, 6, stateTransitionMatrixSize_ + sensitivityMatrixSize_ ) +=
-                    combinedStateTransitionMatrix_.block(
+                    combinedStateTransitionMatrix.block(
                             statePartialAdditionIndices_.at( i ).second, 0, 6, stateTransitionMatrixSize_ + sensitivityMatrixSize_ );
         }
     }
 
-    return combinedStateTransitionMatrix_;
+    return combinedStateTransitionMatrix;
 }
 
 }
@@ -7,6 +7,7 @@
  *    a copy of the license with this file. If not, please or visit:
  *    http://tudat.tudelft.nl/LICENSE.
  */
+#include <algorithm>
 #include <map>
 
 
@@ -168,6 +169,217 @@ void VariationalEquations::setStatePartialFunctionList( )
     }
 }
 
+//! Function (called by constructor) to determine which blocks of the state partial matrix may be non-zero
+void VariationalEquations::setStatePartialBlockPattern( )
+{
+    // Set start index and size of state of each estimated body
+    std::vector< std::pair< int, int > > stateBlockIndices;
+    std::vector< bool > isTranslationalStateBlock;
+    for( auto partialTypeIterator : stateDerivativePartialList_ )
+    {
+        int startIndex = stateTypeStartIndices_.at( partialTypeIterator.first );
+        int currentStateSize = getSingleIntegrationSize( partialTypeIterator.first );
+        for( unsigned int i = 0; i < partialTypeIterator.second.size( ); i++ )
+        {
+            stateBlockIndices.push_back( std::make_pair( startIndex + i * currentStateSize, currentStateSize ) );
+            isTranslationalStateBlock.push_back( partialTypeIterator.first == translational_state );
+        }
+    }
+
+    // Function to retrieve indices of all blocks that overlap with given range of rows/columns
+    std::function< std::vector< int >( const int, const int ) > getOverlappingStateBlocks =
+            [ = ]( const int startIndex, const int size )
+    {
+        std::vector< int > overlappingBlocks;
+        for( unsigned int i = 0; i < stateBlockIndices.size( ); i++ )
+        {
+            if( stateBlockIndices.at( i ).first < startIndex + size &&
+                    startIndex < stateBlockIndices.at( i ).first + stateBlockIndices.at( i ).second )
+            {
+                overlappingBlocks.push_back( i );
+            }
+        }
+        return overlappingBlocks;
+    };
+
+    // Set kinematic terms of translational and rotational states on diagonal.
+    int numberOfBlocks = stateBlockIndices.size( );
+    std::vector< std::vector< bool > > isBlockNonZero( numberOfBlocks, std::vector< bool >( numberOfBlocks, false ) );
+    for( auto stateTypeIterator : dynamicalStatesToEstimate_ )
+    {
+        if( ( stateTypeIterator.first == translational_state || stateTypeIterator.first == rotational_state ) &&
+                stateTypeStartIndices_.count( stateTypeIterator.first ) > 0 )
+        {
+            int startIndex = stateTypeStartIndices_.at( stateTypeIterator.first );
+            int currentStateSize = getSingleIntegrationSize( stateTypeIterator.first );
+            for( unsigned int i = 0; i < stateTypeIterator.second.size( ); i++ )
+            {
+                for( int block : getOverlappingStateBlocks( startIndex + i * currentStateSize, currentStateSize ) )
+                {
+                    isBlockNonZero[ block ][ block ] = true;
+                }
+            }
+        }
+    }
+
+    // Set blocks with state partial functions
+    for( auto typeIterator : statePartialList_ )
+    {
+        int startIndex = stateTypeStartIndices_.at( typeIterator.first );
+        int currentStateSize = getSingleIntegrationSize( typeIterator.first );
+        for( unsigned int i = 0; i < typeIterator.second.size( ); i++ )
+        {
+            for( int rowBlock : getOverlappingStateBlocks( startIndex + i * currentStateSize, currentStateSize ) )
+            {
+                for( auto partialIterator : typeIterator.second.at( i ) )
+                {
+                    for( int columnBlock : getOverlappingStateBlocks(
+                             partialIterator.first.first, partialIterator.first.second ) )
+                    {
+                        isBlockNonZero[ rowBlock ][ columnBlock ] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Set blocks filled by column block additions (in same order as in setBodyStatePartialMatrix)
+    for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
+    {
+        for( int fromBlock : getOverlappingStateBlocks( statePartialAdditionIndices_.at( i ).first, 3 ) )
+        {
+            for( int toBlock : getOverlappingStateBlocks( statePartialAdditionIndices_.at( i ).second, 3 ) )
+            {
+                for( int j = 0; j < numberOfBlocks; j++ )
+                {
+                    if( isBlockNonZero[ j ][ fromBlock ] )
+                    {
+                        isBlockNonZero[ j ][ toBlock ] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Check for which translational states the position rows only contain the identity matrix w.r.t. the body's velocity
+    // (kinematic terms), accounting for the column additions at the level of single columns.
+    std::vector< bool > arePositionRowsKinematic( numberOfBlocks, false );
+    for( int i = 0; i < numberOfBlocks; i++ )
+    {
+        if( isTranslationalStateBlock.at( i ) )
+        {
+            int velocityStartIndex = stateBlockIndices.at( i ).first + 3;
+            std::vector< bool > isColumnNonZero( totalDynamicalStateSize_, false );
+            for( int j = 0; j < 3; j++ )
+            {
+                isColumnNonZero[ velocityStartIndex + j ] = true;
+            }
+
+            for( unsigned int j = 0; j < statePartialAdditionIndices_.size( ); j++ )
+            {
+                for( int k = 0; k < 3; k++ )
+                {
+                    if( isColumnNonZero[ statePartialAdditionIndices_.at( j ).first + k ] )
+                    {
+                        isColumnNonZero[ statePartialAdditionIndices_.at( j ).second + k ] = true;
+                    }
+                }
+            }
+
+            arePositionRowsKinematic[ i ] =
+                    ( std::count( isColumnNonZero.begin( ), isColumnNonZero.end( ), true ) == 3 );
+        }
+    }
+
+    // Group rows by sparsity pattern (kinematic position rows of translational states are handled separately)
+    translationalPositionRowIndices_.clear( );
+    statePartialProductRows_.clear( );
+    statePartialProductColumns_.clear( );
+    statePartialProductRowBlocks_.clear( );
+    statePartialProductMatrices_.clear( );
+    isTranslationalStatePartialProduct_.clear( );
+    std::map< std::vector< int >, int > groupIndicesPerPattern;
+    for( int i = 0; i < numberOfBlocks; i++ )
+    {
+        std::vector< int > nonZeroBlocks;
+        for( int j = 0; j < numberOfBlocks; j++ )
+        {
+            if( isBlockNonZero[ i ][ j ] )
+            {
+                nonZeroBlocks.push_back( j );
+            }
+        }
+
+        if( nonZeroBlocks.size( ) > 0 )
+        {
+            if( groupIndicesPerPattern.count( nonZeroBlocks ) == 0 )
+            {
+                // Merge adjacent column blocks
+                std::vector< std::pair< int, int > > columnBlocks;
+                for( unsigned int j = 0; j < nonZeroBlocks.size( ); j++ )
+                {
+                    const std::pair< int, int >& currentBlock = stateBlockIndices.at( nonZeroBlocks.at( j ) );
+                    if( columnBlocks.size( ) > 0 &&
+                            columnBlocks.back( ).first + columnBlocks.back( ).second == currentBlock.first )
+                    {
+                        columnBlocks.back( ).second += currentBlock.second;
+                    }
+                    else
+                    {
+                        columnBlocks.push_back( currentBlock );
+                    }
+                }
+
+                groupIndicesPerPattern[ nonZeroBlocks ] = statePartialProductRows_.size( );
+                statePartialProductRows_.push_back( std::vector< int >( ) );
+                statePartialProductColumns_.push_back( columnBlocks );
+            }
+
+            int groupIndex = groupIndicesPerPattern.at( nonZeroBlocks );
+            int firstRowInGroup = stateBlockIndices.at( i ).first;
+            if( arePositionRowsKinematic.at( i ) )
+            {
+                translationalPositionRowIndices_.push_back( firstRowInGroup );
+                firstRowInGroup += 3;
+            }
+            for( int j = firstRowInGroup; j < stateBlockIndices.at( i ).first + stateBlockIndices.at( i ).second; j++ )
+            {
+                statePartialProductRows_.at( groupIndex ).push_back( j );
+            }
+        }
+    }
+
+    for( unsigned int i = 0; i < statePartialProductRows_.size( ); i++ )
+    {
+        int numberOfColumns = 0;
+        for( unsigned int j = 0; j < statePartialProductColumns_.at( i ).size( ); j++ )
+        {
+            numberOfColumns += statePartialProductColumns_.at( i ).at( j ).second;
+        }
+        statePartialProductMatrices_.push_back(
+                    Eigen::MatrixXd::Zero( statePartialProductRows_.at( i ).size( ), numberOfColumns ) );
+
+        // Merge consecutive rows, so that their contribution is computed as a single matrix product
+        std::vector< std::pair< int, int > > rowBlocks;
+        for( unsigned int j = 0; j < statePartialProductRows_.at( i ).size( ); j++ )
+        {
+            if( rowBlocks.size( ) > 0 && statePartialProductRows_.at( i ).at( j ) ==
+                    statePartialProductRows_.at( i ).at( rowBlocks.back( ).first ) + rowBlocks.back( ).second )
+            {
+                rowBlocks.back( ).second++;
+            }
+            else
+            {
+                rowBlocks.push_back( std::make_pair( j, 1 ) );
+            }
+        }
+        statePartialProductRowBlocks_.push_back( rowBlocks );
+        isTranslationalStatePartialProduct_.push_back(
+                    statePartialProductRows_.at( i ).size( ) == 3 && statePartialProductColumns_.at( i ).size( ) == 1 &&
+                    statePartialProductColumns_.at( i ).at( 0 ).second == 6 &&
+                    statePartialProductRows_.at( i ).at( 2 ) == statePartialProductRows_.at( i ).at( 0 ) + 2 );
+    }
+}
 
 } // namespace propagators
 
@@ -39,68 +39,37 @@ EinsteinInfeldHoffmannEquations::EinsteinInfeldHoffmannEquations(
 //        }
 //    }
 
-    scalarEihCorrections_.resize( 7 );
-    vectorEihCorrections_.resize( 3 );
-
-    currentGravitationalParameters_.resize( acceleratingBodies_.size() );
-    currentPositions_.resize( acceleratingBodies_.size() );
-    currentVelocities_.resize( acceleratingBodies_.size() );
-    currentSquareSpeeds_.resize( acceleratingBodies_.size() );
-    currentLocalPotentials_.resize( acceleratingBodies_.size() );
-    totalPointMassAccelerations_.resize( acceleratingBodies_.size() );
-
-    currentRelativePositions_.resize( acceleratingBodies_.size() );
-    currentInverseSquareDistances_.resize( acceleratingBodies_.size() );
-    currentRelativeDistances_.resize( acceleratingBodies_.size() );
-    currentRelativeVelocities_.resize( acceleratingBodies_.size() );
-
-    lineOfSightSpeed_.resize( acceleratingBodies_.size() );
-    velocityInnerProducts_.resize( acceleratingBodies_.size() );
-    currentSingleSourceLocalPotential_.resize( acceleratingBodies_.size() );
-    singlePointMassAccelerations_.resize( acceleratingBodies_.size() );
-    currentSingleAccelerations_.resize( acceleratingBodies_.size() );
-
-    totalScalarTermCorrection.resize( acceleratingBodies_.size() );
-    totalVectorTermCorrection_.resize( acceleratingBodies_.size() );
-
-    for( int k = 0; k < 7; k++ )
-    {
-        scalarEihCorrections_[ k ].resize( acceleratingBodies_.size( ) );
-    }
-
-    for( int k = 0; k < 3; k++ )
-    {
-        vectorEihCorrections_[ k ].resize( acceleratingBodies_.size( ) );
-    }
-
-    for( unsigned int i = 0; i < acceleratingBodies_.size( ); i++ )
-    {
-        currentRelativePositions_[ i ].resize( acceleratingBodies_.size( ) );
-        currentInverseSquareDistances_[ i ].resize( acceleratingBodies_.size( ) );
-        currentRelativeDistances_[ i ].resize( acceleratingBodies_.size( ) );
-        currentRelativeVelocities_[ i ].resize( acceleratingBodies_.size( ) );
-
-        lineOfSightSpeed_[ i ].resize( acceleratingBodies_.size( ) );
-        velocityInnerProducts_[ i ].resize( acceleratingBodies_.size( ) );
-        currentSingleSourceLocalPotential_[ i ].resize( acceleratingBodies_.size( ) );
-        singlePointMassAccelerations_[ i ].resize( acceleratingBodies_.size( ) );
-        currentSingleAccelerations_[ i ].resize( acceleratingBodies_.size( ) );
-        totalScalarTermCorrection[ i ].resize( acceleratingBodies_.size() );
-        totalVectorTermCorrection_[ i ].resize( acceleratingBodies_.size() );
-
-        for( int k = 0; k < 7; k++ )
-        {
-            scalarEihCorrections_[ k ][ i ].resize( acceleratingBodies_.size( ) );
-        }
-
-        for( int k = 0; k < 3; k++ )
-        {
-            vectorEihCorrections_[ k ][ i ].resize( acceleratingBodies_.size( ) );
-        }
-    }
-
-    currentAccelerations_.resize( acceleratedBodies_.size( ) );
-
+    const int numberOfBodies = acceleratingBodies_.size( );
+
+    currentGravitationalParameters_.setZero( numberOfBodies );
+    currentPositions_.setZero( numberOfBodies, 3 );
+    currentVelocities_.setZero( numberOfBodies, 3 );
+    currentSquareSpeeds_.setZero( numberOfBodies );
+    currentLocalPotentials_.setZero( numberOfBodies );
+    totalPointMassAccelerations_.setZero( numberOfBodies, 3 );
+
+    relativePositionsX_.setZero( numberOfBodies, numberOfBodies );
+    relativePositionsY_.setZero( numberOfBodies, numberOfBodies );
+    relativePositionsZ_.setZero( numberOfBodies, numberOfBodies );
+    relativeDistances_.setZero( numberOfBodies, numberOfBodies );
+    inverseDistances_.setZero( numberOfBodies, numberOfBodies );
+    inverseSquareDistances_.setZero( numberOfBodies, numberOfBodies );
+
+    lineOfSightSpeeds_.setZero( numberOfBodies, numberOfBodies );
+    singleSourceLocalPotentials_.setZero( numberOfBodies, numberOfBodies );
+    singlePointMassAccelerationsX_.setZero( numberOfBodies, numberOfBodies );
+    singlePointMassAccelerationsY_.setZero( numberOfBodies, numberOfBodies );
+    singlePointMassAccelerationsZ_.setZero( numberOfBodies, numberOfBodies );
+
+    totalScalarTermCorrection_.setZero( numberOfBodies, numberOfBodies );
+    totalVectorTermCorrectionsX_.setZero( numberOfBodies, numberOfBodies );
+    totalVectorTermCorrectionsY_.setZero( numberOfBodies, numberOfBodies );
+    totalVectorTermCorrectionsZ_.setZero( numberOfBodies, numberOfBodies );
+
+    scalarEihCorrections_.resize( 7, Eigen::MatrixXd::Zero( numberOfBodies, numberOfBodies ) );
+    vectorEihCorrectionMultipliers_.resize( 2, Eigen::MatrixXd::Zero( numberOfBodies, numberOfBodies ) );
+
+    currentAccelerations_.resize( acceleratedBodies_.size( ), Eigen::Vector3d::Zero( ) );
 
     for( unsigned int i = 0; i < acceleratedBodies.size(); i++ )
     {
@@ -135,6 +104,73 @@ void EinsteinInfeldHoffmannEquations::recomputeExpansionMultipliers( )
     vectorTermMultipliers_[ 2 ] = ( 3.0 + 4.0 * currentPpnGamma_ ) / 2.0;
 }
 
+void EinsteinInfeldHoffmannEquations::setNumberOfThreads( const unsigned int numberOfThreads )
+{
+    if( numberOfThreads > 1 )
+    {
+        threadPool_ = std::make_shared< utilities::ThreadPool >( numberOfThreads );
+    }
+    else
+    {
+        threadPool_ = nullptr;
+    }
+}
+
+std::vector< std::vector< std::vector< double > > > EinsteinInfeldHoffmannEquations::getScalarEihCorrections( )
+{
+    const int numberOfBodies = acceleratingBodies_.size( );
+    std::vector< std::vector< std::vector< double > > > scalarEihCorrections(
+                7, std::vector< std::vector< double > >( numberOfBodies, std::vector< double >( numberOfBodies ) ) );
+    for( int k = 0; k < 7; k++ )
+    {
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            for( int j = 0; j < numberOfBodies; j++ )
+            {
+                scalarEihCorrections[ k ][ i ][ j ] = scalarEihCorrections_[ k ]( j, i );
+            }
+        }
+    }
+    return scalarEihCorrections;
+}
+
+std::vector< std::vector< std::vector< Eigen::Vector3d > > > EinsteinInfeldHoffmannEquations::getVectorEihCorrections( )
+{
+    const int numberOfBodies = acceleratingBodies_.size( );
+    std::vector< std::vector< std::vector< Eigen::Vector3d > > > vectorEihCorrections(
+                3, std::vector< std::vector< Eigen::Vector3d > >(
+                    numberOfBodies, std::vector< Eigen::Vector3d >( numberOfBodies ) ) );
+    for( int k = 0; k < 3; k++ )
+    {
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            for( int j = 0; j < numberOfBodies; j++ )
+            {
+                vectorEihCorrections[ k ][ i ][ j ] = getVectorEihCorrection( k, i, j );
+            }
+        }
+    }
+    return vectorEihCorrections;
+}
+
+Eigen::Vector3d EinsteinInfeldHoffmannEquations::getVectorEihCorrection(
+        const int k, const int bodyUndergoing, const int bodyExerting )
+{
+    if( bodyUndergoing == bodyExerting || bodyUndergoing >= static_cast< int >( acceleratedBodies_.size( ) ) )
+    {
+        return Eigen::Vector3d::Zero( );
+    }
+    else if( k < 2 )
+    {
+        return vectorEihCorrectionMultipliers_.at( k )( bodyExerting, bodyUndergoing ) *
+                getRelativeVelocity( bodyUndergoing, bodyExerting );
+    }
+    else
+    {
+        return vectorTermMultipliers_.at( k ) * getTotalPointMassAcceleration( bodyExerting );
+    }
+}
+
 void EinsteinInfeldHoffmannEquations::update( const double currentTime )
 {
     if( currentTime_ != currentTime )
@@ -145,78 +181,30 @@ void EinsteinInfeldHoffmannEquations::update( const double currentTime )
         {
             // Extract data from environment
             currentBodyState = bodyStateFunctions_[ i ]( );
-            currentGravitationalParameters_[ i ] = gravitationalParameterFunction_[ i ]( );
+            currentGravitationalParameters_( i ) = gravitationalParameterFunction_[ i ]( );
 
             // Set local variables
-            currentPositions_[ i ] = currentBodyState.segment( 0, 3 );
-            currentVelocities_[ i ] = currentBodyState.segment( 3, 3 );
-            currentSquareSpeeds_[ i ] = currentVelocities_[ i ].dot( currentVelocities_[ i ] );
-
+            currentPositions_.row( i ) = currentBodyState.segment( 0, 3 ).transpose( );
+            currentVelocities_.row( i ) = currentBodyState.segment( 3, 3 ).transpose( );
+            currentSquareSpeeds_( i ) = currentVelocities_.row( i ).squaredNorm( );
         }
 
-        for( unsigned int i = 0; i < acceleratingBodies_.size( ); i++ )
+        // Each stage requires the results of the previous stage for all bodies; within a stage, the tasks for the
+        // different bodies write to disjoint entries, and are distributed over the thread pool (if any).
+        utilities::runTasks( threadPool_, acceleratingBodies_.size( ), [ & ]( const int i, const unsigned int )
         {
-            // Reset value
-            currentLocalPotentials_[ i ] = 0.0;
-            totalPointMassAccelerations_[ i ].setZero( );
-
-            for( unsigned int j = 0; j < acceleratingBodies_.size( ); j++ )
-            {
-
-                // v_{i} * v_{j}
-                velocityInnerProducts_[ i ][ j ] = currentVelocities_[ i ].dot( currentVelocities_[ j ] );
-
-                if( i != j )
-                {
-                    // r_{ij} = r_{j} - r_{i}
-                    currentRelativePositions_[ i ][ j ] = currentPositions_[ j ] - currentPositions_[ i ];
-                    currentRelativeDistances_[ i ][ j ] = currentRelativePositions_[ i ][ j ].norm( );
-                    currentInverseSquareDistances_[ i ][ j ] = 1.0 / ( currentRelativeDistances_[ i ][ j ] * currentRelativeDistances_[ i ][ j ]  );
-
-                    currentRelativeVelocities_[ i ][ j ] = currentVelocities_[ j ] - currentVelocities_[ i ];
-
-                    // r_{ij} * v_{j}
-                    lineOfSightSpeed_[ i ][ j ] = currentRelativePositions_[ i ][ j ].dot( currentVelocities_[ j ] );
-
-                    // mu_j / ||r_{ij}||
-                    currentSingleSourceLocalPotential_[ i ][ j ] = currentGravitationalParameters_[ j ] / currentRelativeDistances_[ i ][ j ];
-
-                    // mu_{j} * r_{ij} / ||r_{ij}||^3
-                    singlePointMassAccelerations_[ i ][ j ] = currentGravitationalParameters_[ j ] * currentRelativePositions_[ i ][ j ] *
-                        currentInverseSquareDistances_[ i ][ j ] / currentRelativeDistances_[ i ][ j ];
-
-
-                    currentLocalPotentials_[ i ] += currentSingleSourceLocalPotential_[ i ][ j ];
-                    totalPointMassAccelerations_[ i ] += singlePointMassAccelerations_[ i ][ j ];
-                }
-            }
-        }
+            calculatePairGeometry( i );
+        } );
 
-        for( unsigned int i = 0; i < acceleratedBodies_.size( ); i++ )
+        utilities::runTasks( threadPool_, acceleratingBodies_.size( ), [ & ]( const int i, const unsigned int )
         {
-            for( unsigned int j = 0; j < acceleratingBodies_.size( ); j++ )
-            {
-                if( i != j )
-                {
-                    scalarEihCorrections_[ 0 ][ i ][ j ] = scalarTermMultipliers_[ 0 ] * currentLocalPotentials_[ i ];
-                    scalarEihCorrections_[ 1 ][ i ][ j ] = scalarTermMultipliers_[ 1 ] * currentLocalPotentials_[ j ];
-                    scalarEihCorrections_[ 2 ][ i ][ j ] = scalarTermMultipliers_[ 2 ] * velocityInnerProducts_[ i ][ i ];
-
-                    scalarEihCorrections_[ 3 ][ i ][ j ] = scalarTermMultipliers_[ 3 ] * currentVelocities_[ j ].dot( currentVelocities_[ j ] );
-                    scalarEihCorrections_[ 4 ][ i ][ j ] = scalarTermMultipliers_[ 4 ] * velocityInnerProducts_[ i ][ j ];
-                    scalarEihCorrections_[ 5 ][ i ][ j ] =
-                        scalarTermMultipliers_[ 5 ] * lineOfSightSpeed_[ i ][ j ] * lineOfSightSpeed_[ i ][ j ] /
-                         ( currentRelativeDistances_[ i ][ j ] * currentRelativeDistances_[ i ][ j ] );
-                    scalarEihCorrections_[ 6 ][ i ][ j ] = scalarTermMultipliers_[ 6 ] * currentRelativePositions_[ i ][ j ].dot( totalPointMassAccelerations_[ j ] );
-
-                    vectorEihCorrections_[ 0 ][ i ][ j ] = vectorTermMultipliers_[ 0 ] * currentRelativePositions_[ i ][ j ].dot( currentVelocities_[ i ] ) * currentInverseSquareDistances_[ i ][ j ] * currentRelativeVelocities_[ i ][ j ];
-                    vectorEihCorrections_[ 1 ][ i ][ j ] = vectorTermMultipliers_[ 1 ] * lineOfSightSpeed_[ i ][ j ] * currentInverseSquareDistances_[ i ][ j ] * currentRelativeVelocities_[ i ][ j ];
-                    vectorEihCorrections_[ 2 ][ i ][ j ] = vectorTermMultipliers_[ 2 ] * totalPointMassAccelerations_[ j ];
-                }
-            }
-        }
+            calculatePointMassTerms( i );
+        } );
 
-        calculateAccelerations( );
+        utilities::runTasks( threadPool_, acceleratedBodies_.size( ), [ & ]( const int i, const unsigned int )
+        {
+            calculateAccelerations( i );
+        } );
     }
     else
     {
@@ -224,46 +212,145 @@ void EinsteinInfeldHoffmannEquations::update( const double currentTime )
     }
 }
 
-void EinsteinInfeldHoffmannEquations::calculateAccelerations( )
+void EinsteinInfeldHoffmannEquations::calculatePairGeometry( const int bodyIndex )
 {
-    using namespace tudat::physical_constants;
-
-    double summedTerm1, summedTerm2;
-    Eigen::Vector3d singleTerm;
-
-    for( unsigned int i = 0; i < acceleratedBodies_.size( ); i++ )
-    {
-
-        currentAccelerations_[ i ].setZero( );
+    const int i = bodyIndex;
+    const int numberOfPairs = acceleratingBodies_.size( ) - i - 1;
+
+    relativePositionsX_( i, i ) = 0.0;
+    relativePositionsY_( i, i ) = 0.0;
+    relativePositionsZ_( i, i ) = 0.0;
+    relativeDistances_( i, i ) = 0.0;
+    inverseDistances_( i, i ) = 0.0;
+    inverseSquareDistances_( i, i ) = 0.0;
+
+    // r_{ij} = r_{j} - r_{i}, for j > i, stored in column i
+    relativePositionsX_.col( i ).tail( numberOfPairs ) =
+            currentPositions_.col( 0 ).tail( numberOfPairs ).array( ) - currentPositions_( i, 0 );
+    relativePositionsY_.col( i ).tail( numberOfPairs ) =
+            currentPositions_.col( 1 ).tail( numberOfPairs ).array( ) - currentPositions_( i, 1 );
+    relativePositionsZ_.col( i ).tail( numberOfPairs ) =
+            currentPositions_.col( 2 ).tail( numberOfPairs ).array( ) - currentPositions_( i, 2 );
+
+    relativeDistances_.col( i ).tail( numberOfPairs ) =
+            ( relativePositionsX_.col( i ).tail( numberOfPairs ).array( ).square( ) +
+              relativePositionsY_.col( i ).tail( numberOfPairs ).array( ).square( ) +
+              relativePositionsZ_.col( i ).tail( numberOfPairs ).array( ).square( ) ).sqrt( );
+    inverseDistances_.col( i ).tail( numberOfPairs ) =
+            relativeDistances_.col( i ).tail( numberOfPairs ).cwiseInverse( );
+    inverseSquareDistances_.col( i ).tail( numberOfPairs ) =
+            inverseDistances_.col( i ).tail( numberOfPairs ).array( ).square( );
+
+    // r_{ji} = -r_{ij}, for j > i, stored in row i
+    relativePositionsX_.row( i ).tail( numberOfPairs ) = -relativePositionsX_.col( i ).tail( numberOfPairs ).transpose( );
+    relativePositionsY_.row( i ).tail( numberOfPairs ) = -relativePositionsY_.col( i ).tail( numberOfPairs ).transpose( );
+    relativePositionsZ_.row( i ).tail( numberOfPairs ) = -relativePositionsZ_.col( i ).tail( numberOfPairs ).transpose( );
+    relativeDistances_.row( i ).tail( numberOfPairs ) = relativeDistances_.col( i ).tail( numberOfPairs ).transpose( );
+    inverseDistances_.row( i ).tail( numberOfPairs ) = inverseDistances_.col( i ).tail( numberOfPairs ).transpose( );
+    inverseSquareDistances_.row( i ).tail( numberOfPairs ) =
+            inverseSquareDistances_.col( i ).tail( numberOfPairs ).transpose( );
+}
 
-        for( unsigned int j = 0; j < acceleratingBodies_.size( ); j++ )
-        {
-            currentSingleAccelerations_[ i ][ j ].setZero( );
+void EinsteinInfeldHoffmannEquations::calculatePointMassTerms( const int bodyIndex )
+{
+    const int i = bodyIndex;
+
+    // mu_j / ||r_{ij}|| (zero for j = i, since inverse distance is set to zero)
+    singleSourceLocalPotentials_.col( i ) = currentGravitationalParameters_.cwiseProduct( inverseDistances_.col( i ) );
+
+    // mu_{j} * r_{ij} / ||r_{ij}||^3
+    singlePointMassAccelerationsX_.col( i ) = singleSourceLocalPotentials_.col( i ).cwiseProduct(
+                inverseSquareDistances_.col( i ) ).cwiseProduct( relativePositionsX_.col( i ) );
+    singlePointMassAccelerationsY_.col( i ) = singleSourceLocalPotentials_.col( i ).cwiseProduct(
+                inverseSquareDistances_.col( i ) ).cwiseProduct( relativePositionsY_.col( i ) );
+    singlePointMassAccelerationsZ_.col( i ) = singleSourceLocalPotentials_.col( i ).cwiseProduct(
+                inverseSquareDistances_.col( i ) ).cwiseProduct( relativePositionsZ_.col( i ) );
+
+    currentLocalPotentials_( i ) = singleSourceLocalPotentials_.col( i ).sum( );
+    totalPointMassAccelerations_( i, 0 ) = singlePointMassAccelerationsX_.col( i ).sum( );
+    totalPointMassAccelerations_( i, 1 ) = singlePointMassAccelerationsY_.col( i ).sum( );
+    totalPointMassAccelerations_( i, 2 ) = singlePointMassAccelerationsZ_.col( i ).sum( );
+
+    // r_{ij} * v_{j}
+    lineOfSightSpeeds_.col( i ) = relativePositionsX_.col( i ).cwiseProduct( currentVelocities_.col( 0 ) ) +
+            relativePositionsY_.col( i ).cwiseProduct( currentVelocities_.col( 1 ) ) +
+            relativePositionsZ_.col( i ).cwiseProduct( currentVelocities_.col( 2 ) );
+}
 
-            if( i != j )
-            {
-                totalScalarTermCorrection[ i ][ j ] = 0;
-                totalVectorTermCorrection_[ i ][ j ].setZero( );
-                for(  int k = 0; k < 7; k++ )
-                {
-                    totalScalarTermCorrection[ i ][ j ] += scalarEihCorrections_[ k ][ i ][ j ];
-                }
-                currentSingleAccelerations_[ i ][ j ] = singlePointMassAccelerations_[ i ][ j ] *
-                    ( 1.0 + totalScalarTermCorrection[ i ][ j ] * physical_constants::INVERSE_SQUARE_SPEED_OF_LIGHT );
-
-                for(  int k = 0; k < 3; k++ )
-                {
-                    totalVectorTermCorrection_[ i ][ j ] += vectorEihCorrections_[ k ][ i ][ j ];
-                }
-                currentSingleAccelerations_[ i ][ j ] += currentSingleSourceLocalPotential_[ i ][ j ] *
-                    totalVectorTermCorrection_[ i ][ j ] * physical_constants::INVERSE_SQUARE_SPEED_OF_LIGHT;
+void EinsteinInfeldHoffmannEquations::calculateAccelerations( const int bodyIndex )
+{
+    using namespace tudat::physical_constants;
 
-            }
-            currentAccelerations_[ i ] += currentSingleAccelerations_[ i ][ j ];
-        }
+    const int i = bodyIndex;
+
+    scalarEihCorrections_[ 0 ].col( i ).setConstant( scalarTermMultipliers_[ 0 ] * currentLocalPotentials_( i ) );
+    scalarEihCorrections_[ 1 ].col( i ) = scalarTermMultipliers_[ 1 ] * currentLocalPotentials_;
+    scalarEihCorrections_[ 2 ].col( i ).setConstant( scalarTermMultipliers_[ 2 ] * currentSquareSpeeds_( i ) );
+    scalarEihCorrections_[ 3 ].col( i ) = scalarTermMultipliers_[ 3 ] * currentSquareSpeeds_;
+    scalarEihCorrections_[ 4 ].col( i ) = scalarTermMultipliers_[ 4 ] * (
+                currentVelocities_.col( 0 ) * currentVelocities_( i, 0 ) +
+                currentVelocities_.col( 1 ) * currentVelocities_( i, 1 ) +
+                currentVelocities_.col( 2 ) * currentVelocities_( i, 2 ) );
+    scalarEihCorrections_[ 5 ].col( i ) = scalarTermMultipliers_[ 5 ] *
+            lineOfSightSpeeds_.col( i ).cwiseAbs2( ).cwiseProduct( inverseSquareDistances_.col( i ) );
+    scalarEihCorrections_[ 6 ].col( i ) = scalarTermMultipliers_[ 6 ] * (
+                relativePositionsX_.col( i ).cwiseProduct( totalPointMassAccelerations_.col( 0 ) ) +
+                relativePositionsY_.col( i ).cwiseProduct( totalPointMassAccelerations_.col( 1 ) ) +
+                relativePositionsZ_.col( i ).cwiseProduct( totalPointMassAccelerations_.col( 2 ) ) );
+    for( int k = 0; k < 7; k++ )
+    {
+        scalarEihCorrections_[ k ]( i, i ) = 0.0;
     }
+
+    totalScalarTermCorrection_.col( i ) =
+            scalarEihCorrections_[ 0 ].col( i ) + scalarEihCorrections_[ 1 ].col( i ) +
+            scalarEihCorrections_[ 2 ].col( i ) + scalarEihCorrections_[ 3 ].col( i ) +
+            scalarEihCorrections_[ 4 ].col( i ) + scalarEihCorrections_[ 5 ].col( i ) +
+            scalarEihCorrections_[ 6 ].col( i );
+
+    // Multipliers of v_{j} - v_{i} (zero for j = i, since inverse square distance is set to zero)
+    vectorEihCorrectionMultipliers_[ 0 ].col( i ) = vectorTermMultipliers_[ 0 ] * (
+                relativePositionsX_.col( i ) * currentVelocities_( i, 0 ) +
+                relativePositionsY_.col( i ) * currentVelocities_( i, 1 ) +
+                relativePositionsZ_.col( i ) * currentVelocities_( i, 2 ) ).cwiseProduct( inverseSquareDistances_.col( i ) );
+    vectorEihCorrectionMultipliers_[ 1 ].col( i ) = vectorTermMultipliers_[ 1 ] *
+            lineOfSightSpeeds_.col( i ).cwiseProduct( inverseSquareDistances_.col( i ) );
+
+    totalVectorTermCorrectionsX_.col( i ) =
+            ( vectorEihCorrectionMultipliers_[ 0 ].col( i ) + vectorEihCorrectionMultipliers_[ 1 ].col( i ) ).cwiseProduct(
+                ( currentVelocities_.col( 0 ).array( ) - currentVelocities_( i, 0 ) ).matrix( ) ) +
+            vectorTermMultipliers_[ 2 ] * totalPointMassAccelerations_.col( 0 );
+    totalVectorTermCorrectionsY_.col( i ) =
+            ( vectorEihCorrectionMultipliers_[ 0 ].col( i ) + vectorEihCorrectionMultipliers_[ 1 ].col( i ) ).cwiseProduct(
+                ( currentVelocities_.col( 1 ).array( ) - currentVelocities_( i, 1 ) ).matrix( ) ) +
+            vectorTermMultipliers_[ 2 ] * totalPointMassAccelerations_.col( 1 );
+    totalVectorTermCorrectionsZ_.col( i ) =
+            ( vectorEihCorrectionMultipliers_[ 0 ].col( i ) + vectorEihCorrectionMultipliers_[ 1 ].col( i ) ).cwiseProduct(
+                ( currentVelocities_.col( 2 ).array( ) - currentVelocities_( i, 2 ) ).matrix( ) ) +
+            vectorTermMultipliers_[ 2 ] * totalPointMassAccelerations_.col( 2 );
+    totalVectorTermCorrectionsX_( i, i ) = 0.0;
+    totalVectorTermCorrectionsY_( i, i ) = 0.0;
+    totalVectorTermCorrectionsZ_( i, i ) = 0.0;
+
+    // Sum of mu_{j} * r_{ij} / ||r_{ij}||^3 * ( 1 + scalar / c^2 ) + mu_{j} / ||r_{ij}|| * vector / c^2 over all j
+    // (all terms for j = i are zero)
+    currentAccelerations_[ i ]( 0 ) =
+            singlePointMassAccelerationsX_.col( i ).sum( ) +
+            ( singlePointMassAccelerationsX_.col( i ).cwiseProduct( totalScalarTermCorrection_.col( i ) ) +
+              singleSourceLocalPotentials_.col( i ).cwiseProduct( totalVectorTermCorrectionsX_.col( i ) ) ).sum( ) *
+            INVERSE_SQUARE_SPEED_OF_LIGHT;
+    currentAccelerations_[ i ]( 1 ) =
+            singlePointMassAccelerationsY_.col( i ).sum( ) +
+            ( singlePointMassAccelerationsY_.col( i ).cwiseProduct( totalScalarTermCorrection_.col( i ) ) +
+              singleSourceLocalPotentials_.col( i ).cwiseProduct( totalVectorTermCorrectionsY_.col( i ) ) ).sum( ) *
+            INVERSE_SQUARE_SPEED_OF_LIGHT;
+    currentAccelerations_[ i ]( 2 ) =
+            singlePointMassAccelerationsZ_.col( i ).sum( ) +
+            ( singlePointMassAccelerationsZ_.col( i ).cwiseProduct( totalScalarTermCorrection_.col( i ) ) +
+              singleSourceLocalPotentials_.col( i ).cwiseProduct( totalVectorTermCorrectionsZ_.col( i ) ) ).sum( ) *
+            INVERSE_SQUARE_SPEED_OF_LIGHT;
 }
 
 }
 
-}
\ No newline at end of file
+}
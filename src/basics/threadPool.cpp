@@ -0,0 +1,197 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include "tudat/basics/threadPool.h"
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to retrieve the number of hardware threads available on the current machine.
+unsigned int getNumberOfAvailableThreads( )
+{
+    unsigned int numberOfThreads = std::thread::hardware_concurrency( );
+    return ( numberOfThreads > 0 ) ? numberOfThreads : 1;
+}
+
+//! Constructor
+ThreadPool::ThreadPool( const unsigned int numberOfThreads ):
+    numberOfThreads_( ( numberOfThreads == 0 ) ? getNumberOfAvailableThreads( ) : numberOfThreads ),
+    currentTaskFunction_( nullptr ),
+    numberOfTasks_( 0 ),
+    nextTaskIndex_( 0 ),
+    taskListCounter_( 0 ),
+    numberOfActiveWorkers_( 0 ),
+    terminatePool_( false ),
+    isTaskExceptionThrown_( false ),
+    isProcessingTaskList_( false )
+{
+    // Create worker threads; the calling thread acts as thread 0.
+    for( unsigned int i = 1; i < numberOfThreads_; i++ )
+    {
+        workerThreads_.push_back( std::thread( &ThreadPool::runWorkerThread, this, i ) );
+    }
+}
+
+//! Destructor, terminates and joins all worker threads.
+ThreadPool::~ThreadPool( )
+{
+    {
+        std::lock_guard< std::mutex > lock( poolMutex_ );
+        terminatePool_ = true;
+    }
+    workAvailableCondition_.notify_all( );
+
+    for( unsigned int i = 0; i < workerThreads_.size( ); i++ )
+    {
+        workerThreads_.at( i ).join( );
+    }
+}
+
+//! Function to execute a list of independent tasks, distributed over all threads of the pool.
+void ThreadPool::runParallelTasks( const int numberOfTasks,
+                                   const std::function< void( const int, const unsigned int ) >& taskFunction )
+{
+    if( numberOfTasks <= 0 )
+    {
+        return;
+    }
+
+    // Run tasks directly if no worker threads are available, or if the pool is already processing a task list (called
+    // concurrently by another thread, or from within a task)
+    bool isPoolAvailable = false;
+    if( workerThreads_.size( ) > 0 && numberOfTasks > 1 )
+    {
+        bool isProcessingTaskList = false;
+        isPoolAvailable = isProcessingTaskList_.compare_exchange_strong( isProcessingTaskList, true );
+    }
+
+    if( !isPoolAvailable )
+    {
+        for( int i = 0; i < numberOfTasks; i++ )
+        {
+            taskFunction( i, 0 );
+        }
+        return;
+    }
+
+    // Set new task list, and wake up worker threads
+    {
+        std::lock_guard< std::mutex > lock( poolMutex_ );
+        currentTaskFunction_ = &taskFunction;
+        numberOfTasks_ = numberOfTasks;
+        nextTaskIndex_ = 0;
+        taskException_ = nullptr;
+        isTaskExceptionThrown_ = false;
+        numberOfActiveWorkers_ = workerThreads_.size( );
+        taskListCounter_++;
+    }
+    workAvailableCondition_.notify_all( );
+
+    // Participate in executing tasks
+    executeAvailableTasks( 0 );
+
+    // Wait for all worker threads to finish their current task
+    std::exception_ptr taskException;
+    {
+        std::unique_lock< std::mutex > lock( poolMutex_ );
+        workFinishedCondition_.wait( lock, [ this ]{ return numberOfActiveWorkers_ == 0; } );
+        currentTaskFunction_ = nullptr;
+        taskException = taskException_;
+        taskException_ = nullptr;
+    }
+    isProcessingTaskList_ = false;
+
+    if( taskException != nullptr )
+    {
+        std::rethrow_exception( taskException );
+    }
+}
+
+//! Function run by each worker thread, waiting for and executing work until the pool is destroyed.
+void ThreadPool::runWorkerThread( const unsigned int threadIndex )
+{
+    unsigned long lastTaskListCounter = 0;
+    while( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( poolMutex_ );
+            workAvailableCondition_.wait(
+                        lock, [ this, lastTaskListCounter ]{ return terminatePool_ || ( taskListCounter_ != lastTaskListCounter ); } );
+            if( terminatePool_ )
+            {
+                return;
+            }
+            lastTaskListCounter = taskListCounter_;
+        }
+
+        executeAvailableTasks( threadIndex );
+
+        {
+            std::lock_guard< std::mutex > lock( poolMutex_ );
+            numberOfActiveWorkers_--;
+            if( numberOfActiveWorkers_ == 0 )
+            {
+                workFinishedCondition_.notify_one( );
+            }
+        }
+    }
+}
+
+//! Function that executes tasks from the current task list, until no tasks remain.
+void ThreadPool::executeAvailableTasks( const unsigned int threadIndex )
+{
+    while( !isTaskExceptionThrown_ )
+    {
+        int currentTaskIndex = nextTaskIndex_.fetch_add( 1 );
+        if( currentTaskIndex >= numberOfTasks_ )
+        {
+            break;
+        }
+
+        try
+        {
+            ( *currentTaskFunction_ )( currentTaskIndex, threadIndex );
+        }
+        catch( ... )
+        {
+            std::lock_guard< std::mutex > lock( poolMutex_ );
+            if( taskException_ == nullptr )
+            {
+                taskException_ = std::current_exception( );
+            }
+            isTaskExceptionThrown_ = true;
+        }
+    }
+}
+
+//! Function to execute a list of independent tasks, either serially or using a thread pool.
+void runTasks( const std::shared_ptr< ThreadPool > threadPool,
+               const int numberOfTasks,
+               const std::function< void( const int, const unsigned int ) >& taskFunction )
+{
+    if( threadPool == nullptr )
+    {
+        for( int i = 0; i < numberOfTasks; i++ )
+        {
+            taskFunction( i, 0 );
+        }
+    }
+    else
+    {
+        threadPool->runParallelTasks( numberOfTasks, taskFunction );
+    }
+}
+
+} // namespace utilities
+
+} // namespace tudat
@@ -0,0 +1,133 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "tudat/basics/timingProfiler.h"
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to convert a duration to seconds.
+double convertDurationToSeconds( const std::chrono::steady_clock::duration duration )
+{
+    return std::chrono::duration_cast< std::chrono::duration< double > >( duration ).count( );
+}
+
+//! Function to write a string as a quoted field of a comma-separated file.
+std::string getQuotedCsvField( const std::string& field )
+{
+    std::string quotedField = "\"";
+    for( unsigned int i = 0; i < field.size( ); i++ )
+    {
+        if( field[ i ] == '"' )
+        {
+            quotedField += '"';
+        }
+        quotedField += field[ i ];
+    }
+    return quotedField + "\"";
+}
+
+//! Function to register a new profiled function.
+int TimingProfiler::addEntry( const std::string& category, const std::string& name )
+{
+    entries_.push_back( TimingProfileEntry( category, name ) );
+    return static_cast< int >( entries_.size( ) ) - 1;
+}
+
+//! Function to set the accumulated time and number of calls of a profiled function.
+void TimingProfiler::setTime( const int entryIndex, const unsigned long numberOfCalls,
+                              const std::chrono::steady_clock::duration duration )
+{
+    entries_.at( entryIndex ).numberOfCalls_ = numberOfCalls;
+    entries_.at( entryIndex ).totalTime_ = duration;
+}
+
+//! Function to reset the accumulated times and number of calls of all entries to zero.
+void TimingProfiler::resetTimes( )
+{
+    for( unsigned int i = 0; i < entries_.size( ); i++ )
+    {
+        entries_[ i ].numberOfCalls_ = 0;
+        entries_[ i ].totalTime_ = std::chrono::steady_clock::duration::zero( );
+    }
+}
+
+//! Function to retrieve the total time (in seconds) spent in a single profiled function.
+double TimingProfiler::getTotalTime( const int entryIndex ) const
+{
+    return convertDurationToSeconds( entries_.at( entryIndex ).totalTime_ );
+}
+
+//! Function to retrieve the total time (in seconds) spent in all profiled functions of a given category.
+double TimingProfiler::getTotalTimeOfCategory( const std::string& category ) const
+{
+    std::chrono::steady_clock::duration totalTime = std::chrono::steady_clock::duration::zero( );
+    for( unsigned int i = 0; i < entries_.size( ); i++ )
+    {
+        if( entries_[ i ].category_ == category )
+        {
+            totalTime += entries_[ i ].totalTime_;
+        }
+    }
+    return convertDurationToSeconds( totalTime );
+}
+
+//! Function to retrieve the total time (in seconds) spent in each profiled function of a given category.
+std::map< std::string, double > TimingProfiler::getTimeBreakdownOfCategory( const std::string& category ) const
+{
+    std::map< std::string, double > timeBreakdown;
+    for( unsigned int i = 0; i < entries_.size( ); i++ )
+    {
+        if( entries_[ i ].category_ == category )
+        {
+            timeBreakdown[ entries_[ i ].name_ ] += convertDurationToSeconds( entries_[ i ].totalTime_ );
+        }
+    }
+    return timeBreakdown;
+}
+
+//! Function to write the timing breakdown to a stream, in comma-separated format.
+void TimingProfiler::writeTimingBreakdown( std::ostream& outputStream ) const
+{
+    outputStream << "category,name,number_of_calls,total_time,mean_time" << std::endl;
+    outputStream << std::setprecision( 9 );
+    for( unsigned int i = 0; i < entries_.size( ); i++ )
+    {
+        double totalTime = convertDurationToSeconds( entries_[ i ].totalTime_ );
+        outputStream << getQuotedCsvField( entries_[ i ].category_ ) << ","
+                     << getQuotedCsvField( entries_[ i ].name_ ) << ","
+                     << entries_[ i ].numberOfCalls_ << ","
+                     << totalTime << ","
+                     << ( ( entries_[ i ].numberOfCalls_ > 0 ) ?
+                              totalTime / static_cast< double >( entries_[ i ].numberOfCalls_ ) : 0.0 ) << std::endl;
+    }
+}
+
+//! Function to write the timing breakdown to a file, in comma-separated format.
+void TimingProfiler::writeTimingBreakdownToFile( const std::string& fileName ) const
+{
+    std::ofstream outputFile( fileName );
+    if( !outputFile.is_open( ) )
+    {
+        throw std::runtime_error( "Error when writing timing breakdown, could not open file " + fileName );
+    }
+    writeTimingBreakdown( outputFile );
+}
+
+} // namespace utilities
+
+} // namespace tudat
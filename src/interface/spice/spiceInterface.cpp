@@ -20,6 +20,45 @@ namespace tudat {
 namespace spice_interface {
 using Eigen::Vector6d;
 
+//! Function to retrieve the mutex used to serialize calls to (non-reentrant) CSPICE routines.
+std::mutex& getSpiceMutex( )
+{
+    static std::mutex spiceMutex;
+
+    // On first use, set the Spice error action to RETURN, so that errors are signalled to checkSpiceErrors, instead of
+    // terminating the program
+    static const bool isSpiceErrorActionSet = [ ]( )
+    {
+        std::lock_guard< std::mutex > spiceLock( spiceMutex );
+        SpiceChar errorAction[ ] = "RETURN";
+        erract_c( "SET", 0, errorAction );
+        return true;
+    }( );
+    static_cast< void >( isSpiceErrorActionSet );
+
+    return spiceMutex;
+}
+
+//! Function to check whether the preceding CSPICE call failed, throwing an exception with the Spice error message if so.
+/*!
+ * Function to check whether the preceding CSPICE call failed, throwing an exception with the Spice error message if so (and
+ * resetting the Spice error status). Must be called while the Spice mutex (see getSpiceMutex) is still locked for the call
+ * that is checked, so that the error status cannot be that of (or be reset by) a call from another thread. Failures are
+ * signalled in this manner since the Spice error action is set to RETURN on first use of getSpiceMutex.
+ * \param spiceRoutineName Name of the CSPICE routine that was called (used in error message).
+ */
+void checkSpiceErrors( const std::string& spiceRoutineName )
+{
+    if( failed_c( ) )
+    {
+        // Maximum length of long Spice error message is 1840 (+1 for null terminator)
+        SpiceChar errorMessage[ 1841 ];
+        getmsg_c( "LONG", 1841, errorMessage );
+        reset_c( );
+        throw std::runtime_error( "Error in Spice routine " + spiceRoutineName + ": " + std::string( errorMessage ) );
+    }
+}
+
 std::string getCorrectedTargetBodyName(
         const std::string &targetBodyName )
 {
@@ -44,18 +83,22 @@ std::string getCorrectedTargetBodyName(
 
 //! Convert a Julian date to ephemeris time (equivalent to TDB in Spice).
 double convertJulianDateToEphemerisTime(const double julianDate) {
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     return (julianDate - j2000_c()) * spd_c();
 }
 
 //! Convert ephemeris time (equivalent to TDB) to a Julian date.
 double convertEphemerisTimeToJulianDate(const double ephemerisTime) {
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     return j2000_c() + (ephemerisTime) / spd_c();
 }
 
 //! Converts a date string to ephemeris time.
 double convertDateStringToEphemerisTime(const std::string &dateString) {
     double ephemerisTime = 0.0;
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     str2et_c(dateString.c_str(), &ephemerisTime);
+    checkSpiceErrors( "str2et_c" );
     return ephemerisTime;
 }
 
@@ -75,10 +118,12 @@ Vector6d getBodyCartesianStateAtEpoch(
     double lightTime;
 
     // Call Spice function to calculate state and light-time.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     spkezr_c(getCorrectedTargetBodyName( targetBodyName ).c_str(), ephemerisTime, referenceFrameName.c_str(),
              aberrationCorrections.c_str(),
              getCorrectedTargetBodyName( observerBodyName ).c_str(), stateAtEpoch,
              &lightTime);
+    checkSpiceErrors( "spkezr_c" );
 
     // Put result in Eigen Vector.
     Vector6d cartesianStateVector;
@@ -107,10 +152,12 @@ Eigen::Vector3d getBodyCartesianPositionAtEpoch(const std::string &targetBodyNam
     double lightTime;
 
     // Call Spice function to calculate position and light-time.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     spkpos_c(getCorrectedTargetBodyName( targetBodyName ).c_str(), ephemerisTime, referenceFrameName.c_str(),
              aberrationCorrections.c_str(),
              getCorrectedTargetBodyName( observerBodyName ).c_str(), positionAtEpoch,
              &lightTime);
+    checkSpiceErrors( "spkpos_c" );
 
     // Put result in Eigen Vector.
     Eigen::Vector3d cartesianPositionVector;
@@ -150,7 +197,9 @@ Vector6d getCartesianStateFromTleAtEpoch(double epoch, std::shared_ptr<ephemerid
     elements[9] = tle->getEpoch();// TLE ephemeris epoch in seconds since J2000
 
     // Call Spice function. Return value is always 0, so no need to save it.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     ev2lin_(&epoch, physicalConstants, elements, stateAtEpoch);
+    checkSpiceErrors( "ev2lin_" );
 
     // Put result in Eigen Vector.
     Vector6d cartesianStateVector;
@@ -175,7 +224,9 @@ Eigen::Quaterniond computeRotationQuaternionBetweenFrames(const std::string &ori
     double rotationArray[3][3];
 
     // Calculate rotation matrix.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     pxform_c(originalFrame.c_str(), newFrame.c_str(), ephemerisTime, rotationArray);
+    checkSpiceErrors( "pxform_c" );
 
     // Put rotation matrix in Eigen Matrix3d.
     Eigen::Matrix3d rotationMatrix;
@@ -209,7 +260,9 @@ Eigen::Matrix6d computeStateRotationMatrixBetweenFrames(const std::string &origi
     double stateTransition[6][6];
 
     // Calculate state transition matrix.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     sxform_c(originalFrame.c_str(), newFrame.c_str(), ephemerisTime, stateTransition);
+    checkSpiceErrors( "sxform_c" );
 
     // Put rotation matrix in Eigen Matrix6d
     Eigen::Matrix6d stateTransitionMatrix = Eigen::Matrix6d::Zero();
@@ -235,7 +288,9 @@ Eigen::Matrix3d computeRotationMatrixDerivativeBetweenFrames(const std::string &
     double stateTransition[6][6];
 
     // Calculate state transition matrix.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     sxform_c(originalFrame.c_str(), newFrame.c_str(), ephemerisTime, stateTransition);
+    checkSpiceErrors( "sxform_c" );
 
     // Put rotation matrix derivative in Eigen Matrix3d
     Eigen::Matrix3d matrixDerivative = Eigen::Matrix3d::Zero();
@@ -261,13 +316,16 @@ Eigen::Vector3d getAngularVelocityVectorOfFrameInOriginalFrame(const std::string
     double stateTransition[6][6];
 
     // Calculate state transition matrix.
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     sxform_c(originalFrame.c_str(), newFrame.c_str(), ephemerisTime, stateTransition);
+    checkSpiceErrors( "sxform_c" );
 
     double rotation[3][3];
     double angularVelocity[3];
 
     // Calculate angular velocity vector.
     xf2rav_c(stateTransition, rotation, angularVelocity);
+    checkSpiceErrors( "xf2rav_c" );
 
     return (Eigen::Vector3d() << angularVelocity[0], angularVelocity[1], angularVelocity[2]).finished();
 }
@@ -281,7 +339,9 @@ std::pair<Eigen::Quaterniond, Eigen::Matrix3d> computeRotationQuaternionAndRotat
         throw std::invalid_argument( "Error when retrieving rotational state from Spice, input time is " + std::to_string(ephemerisTime) );
     }
 
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     sxform_c(originalFrame.c_str(), newFrame.c_str(), ephemerisTime, stateTransition);
+    checkSpiceErrors( "sxform_c" );
 
     Eigen::Matrix3d matrixDerivative;
     Eigen::Matrix3d rotationMatrix;
@@ -299,12 +359,16 @@ std::pair<Eigen::Quaterniond, Eigen::Matrix3d> computeRotationQuaternionAndRotat
 std::vector<double> getBodyProperties(const std::string &body, const std::string &property,
                                       const int maximumNumberOfValues) {
     // Delcare variable in which raw result is to be put by Spice function.
-    double* propertyArray = new double[maximumNumberOfValues];
+    std::vector< double > propertyArray( maximumNumberOfValues );
 
     // Call Spice function to retrieve property.
     SpiceInt numberOfReturnedParameters;
-    bodvrd_c(body.c_str(), property.c_str(), maximumNumberOfValues, &numberOfReturnedParameters,
-             propertyArray);
+    {
+        std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
+        bodvrd_c(body.c_str(), property.c_str(), maximumNumberOfValues, &numberOfReturnedParameters,
+                 propertyArray.data( ));
+        checkSpiceErrors( "bodvrd_c" );
+    }
 
     // Put result in STL vector.
     std::vector<double> bodyProperties;
@@ -312,7 +376,6 @@ std::vector<double> getBodyProperties(const std::string &body, const std::string
     for (int i = 0; i < numberOfReturnedParameters; i++) {
         bodyProperties.at(i) = propertyArray[i];
     }
-    delete [] propertyArray;
     return bodyProperties;
 }
 
@@ -323,7 +386,11 @@ double getBodyGravitationalParameter(const std::string &body) {
 
     // Call Spice function to retrieve gravitational parameter.
     SpiceInt numberOfReturnedParameters;
-    bodvrd_c(body.c_str(), "GM", 1, &numberOfReturnedParameters, gravitationalParameter);
+    {
+        std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
+        bodvrd_c(body.c_str(), "GM", 1, &numberOfReturnedParameters, gravitationalParameter);
+        checkSpiceErrors( "bodvrd_c" );
+    }
 
     // Convert from km^3/s^2 to m^3/s^2
     return unit_conversions::convertKilometersToMeters<double>(
@@ -339,7 +406,11 @@ double getAverageRadius(const std::string &body) {
 
     // Call Spice function to retrieve gravitational parameter.
     SpiceInt numberOfReturnedParameters;
-    bodvrd_c(body.c_str(), "RADII", 3, &numberOfReturnedParameters, radii);
+    {
+        std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
+        bodvrd_c(body.c_str(), "RADII", 3, &numberOfReturnedParameters, radii);
+        checkSpiceErrors( "bodvrd_c" );
+    }
 
     // Compute average and convert from km to m.
     return unit_conversions::convertKilometersToMeters<double>(
@@ -355,7 +426,11 @@ double getAverageEquatorialRadius( const std::string& body )
 
     // Call Spice function to retrieve gravitational parameter.
     SpiceInt numberOfReturnedParameters;
-    bodvrd_c( body.c_str(), "RADII", 3, &numberOfReturnedParameters, radii );
+    {
+        std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
+        bodvrd_c( body.c_str(), "RADII", 3, &numberOfReturnedParameters, radii );
+        checkSpiceErrors( "bodvrd_c" );
+    }
 
     // Compute average and convert from km to m.
     return unit_conversions::convertKilometersToMeters< double >(
@@ -370,7 +445,11 @@ double getPolarRadius( const std::string& body )
 
     // Call Spice function to retrieve gravitational parameter.
     SpiceInt numberOfReturnedParameters;
-    bodvrd_c( body.c_str(), "RADII", 3, &numberOfReturnedParameters, radii );
+    {
+        std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
+        bodvrd_c( body.c_str(), "RADII", 3, &numberOfReturnedParameters, radii );
+        checkSpiceErrors( "bodvrd_c" );
+    }
 
     // Compute average and convert from km to m.
     return unit_conversions::convertKilometersToMeters< double >(radii[2] );
@@ -381,7 +460,9 @@ int convertBodyNameToNaifId(const std::string &bodyName) {
     // Convert body name to NAIF ID number.
     SpiceInt bodyNaifId;
     SpiceBoolean isIdFound;
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     bods2c_c(bodyName.c_str(), &bodyNaifId, &isIdFound);
+    checkSpiceErrors( "bods2c_c" );
 
     // Convert SpiceInt (typedef for long) to int and return.
     return static_cast<int>(bodyNaifId);
@@ -393,7 +474,9 @@ std::string convertNaifIdToBodyName( int bodyNaifId )
     // Maximum SPICE name length is 32. Therefore, a name length of 33 is used (+1 for null terminator)
     SpiceChar bodyName[33];
 
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     bodc2s_c( bodyNaifId, 33, bodyName );
+    checkSpiceErrors( "bodc2s_c" );
 
     // Convert SpiceChar to std::string
     return static_cast< std::string >( bodyName );
@@ -404,25 +487,35 @@ bool checkBodyPropertyInKernelPool(const std::string &bodyName, const std::strin
     // Convert body name to NAIF ID.
     const int naifId = convertBodyNameToNaifId(bodyName);
 
-    // Determine if property is in pool.
+    // Determine if property is in pool (Spice mutex is locked only now, as it is locked when converting the name to an ID).
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     SpiceBoolean isPropertyInPool = bodfnd_c(naifId, bodyProperty.c_str());
+    checkSpiceErrors( "bodfnd_c" );
     return static_cast<bool>(isPropertyInPool);
 }
 
 //! Load a Spice kernel.
 void loadSpiceKernelInTudat(const std::string &fileName) {
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     furnsh_c(fileName.c_str());
+    checkSpiceErrors( "furnsh_c" );
 }
 
 //! Get the amount of loaded Spice kernels.
 int getTotalCountOfKernelsLoaded() {
     SpiceInt count;
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
     ktotal_c("ALL", &count);
+    checkSpiceErrors( "ktotal_c" );
     return count;
 }
 
 //! Clear all Spice kernels.
-void clearSpiceKernels() { kclear_c(); }
+void clearSpiceKernels() {
+    std::lock_guard< std::mutex > spiceLock( getSpiceMutex( ) );
+    kclear_c();
+    checkSpiceErrors( "kclear_c" );
+}
 
 //! Get all standard Spice kernels used in tudat.
 std::vector<std::string> getStandardSpiceKernels(const std::vector<std::string> alternativeEphemerisKernels) {
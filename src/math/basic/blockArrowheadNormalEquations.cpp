@@ -0,0 +1,421 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/SVD>
+
+#include "tudat/math/basic/blockArrowheadNormalEquations.h"
+#include "tudat/math/basic/leastSquaresEstimation.h"
+
+namespace tudat
+{
+
+namespace linear_algebra
+{
+
+//! Constructor
+BlockArrowheadNormalEquations::BlockArrowheadNormalEquations(
+        const int numberOfParameters,
+        const std::vector< std::vector< int > >& arcParameterIndices ):
+    numberOfParameters_( numberOfParameters ), arcParameterIndices_( arcParameterIndices ),
+    arcIndexPerParameter_( numberOfParameters, -1 )
+{
+    for( unsigned int i = 0; i < arcParameterIndices_.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < arcParameterIndices_.at( i ).size( ); j++ )
+        {
+            int parameterIndex = arcParameterIndices_.at( i ).at( j );
+            if( parameterIndex < 0 || parameterIndex >= numberOfParameters_ )
+            {
+                throw std::runtime_error( "Error when creating block-arrowhead normal equations, parameter index " +
+                                          std::to_string( parameterIndex ) + " is out of range." );
+            }
+            if( arcIndexPerParameter_.at( parameterIndex ) != -1 )
+            {
+                throw std::runtime_error( "Error when creating block-arrowhead normal equations, parameter " +
+                                          std::to_string( parameterIndex ) + " is assigned to multiple arcs." );
+            }
+            arcIndexPerParameter_[ parameterIndex ] = i;
+        }
+    }
+
+    for( int i = 0; i < numberOfParameters_; i++ )
+    {
+        if( arcIndexPerParameter_.at( i ) == -1 )
+        {
+            globalParameterIndices_.push_back( i );
+        }
+    }
+
+    reset( );
+}
+
+//! Function to reset all accumulated normal equations (and column extrema) to zero.
+void BlockArrowheadNormalEquations::reset( )
+{
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+
+    arcNormalBlocks_.clear( );
+    arcGlobalNormalBlocks_.clear( );
+    arcRightHandSides_.clear( );
+    for( unsigned int i = 0; i < arcParameterIndices_.size( ); i++ )
+    {
+        const int numberOfArcParameters = arcParameterIndices_.at( i ).size( );
+        arcNormalBlocks_.push_back( Eigen::MatrixXd::Zero( numberOfArcParameters, numberOfArcParameters ) );
+        arcGlobalNormalBlocks_.push_back( Eigen::MatrixXd::Zero( numberOfArcParameters, numberOfGlobalParameters ) );
+        arcRightHandSides_.push_back( Eigen::VectorXd::Zero( numberOfArcParameters ) );
+    }
+    globalNormalBlock_ = Eigen::MatrixXd::Zero( numberOfGlobalParameters, numberOfGlobalParameters );
+    globalRightHandSide_ = Eigen::VectorXd::Zero( numberOfGlobalParameters );
+
+    columnMinima_ = Eigen::VectorXd::Constant( numberOfParameters_, std::numeric_limits< double >::infinity( ) );
+    columnMaxima_ = Eigen::VectorXd::Constant( numberOfParameters_, -std::numeric_limits< double >::infinity( ) );
+}
+
+//! Function to add the contribution of a block of observations to the normal equations.
+void BlockArrowheadNormalEquations::addObservations(
+        const Eigen::MatrixXd& partials,
+        const Eigen::VectorXd& residuals,
+        const Eigen::VectorXd& weights )
+{
+    const int numberOfRows = partials.rows( );
+    if( partials.cols( ) != numberOfParameters_ || residuals.rows( ) != numberOfRows || weights.rows( ) != numberOfRows )
+    {
+        throw std::runtime_error( "Error when adding observations to block-arrowhead normal equations, input sizes are "
+                                  "inconsistent." );
+    }
+    if( numberOfRows == 0 )
+    {
+        return;
+    }
+
+    columnMinima_ = columnMinima_.cwiseMin( partials.colwise( ).minCoeff( ).transpose( ) );
+    columnMaxima_ = columnMaxima_.cwiseMax( partials.colwise( ).maxCoeff( ).transpose( ) );
+
+    // Determine arc on which each row depends, and group rows per arc
+    std::vector< std::vector< int > > rowsPerArc( arcParameterIndices_.size( ) );
+    for( int i = 0; i < numberOfRows; i++ )
+    {
+        int currentArc = -1;
+        for( unsigned int j = 0; j < arcParameterIndices_.size( ); j++ )
+        {
+            for( unsigned int k = 0; k < arcParameterIndices_.at( j ).size( ); k++ )
+            {
+                if( partials( i, arcParameterIndices_.at( j ).at( k ) ) != 0.0 )
+                {
+                    if( currentArc != -1 && currentArc != static_cast< int >( j ) )
+                    {
+                        throw std::runtime_error(
+                                    "Error when adding observations to block-arrowhead normal equations, observation "
+                                    "depends on parameters of arcs " + std::to_string( currentArc ) + " and " +
+                                    std::to_string( j ) + "." );
+                    }
+                    currentArc = j;
+                    break;
+                }
+            }
+        }
+        if( currentArc != -1 )
+        {
+            rowsPerArc[ currentArc ].push_back( i );
+        }
+    }
+
+    // Add contribution of all rows to global block
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+    Eigen::MatrixXd globalPartials( numberOfRows, numberOfGlobalParameters );
+    for( int j = 0; j < numberOfGlobalParameters; j++ )
+    {
+        globalPartials.col( j ) = partials.col( globalParameterIndices_.at( j ) );
+    }
+    Eigen::MatrixXd weightedGlobalPartials = weights.asDiagonal( ) * globalPartials;
+    globalNormalBlock_.noalias( ) += globalPartials.transpose( ) * weightedGlobalPartials;
+    globalRightHandSide_.noalias( ) += weightedGlobalPartials.transpose( ) * residuals;
+
+    // Add contribution of rows of each arc to arc-local and coupling blocks
+    for( unsigned int i = 0; i < rowsPerArc.size( ); i++ )
+    {
+        const std::vector< int >& currentRows = rowsPerArc.at( i );
+        if( currentRows.size( ) == 0 )
+        {
+            continue;
+        }
+
+        const int numberOfArcRows = currentRows.size( );
+        const int numberOfArcParameters = arcParameterIndices_.at( i ).size( );
+        Eigen::MatrixXd arcPartials( numberOfArcRows, numberOfArcParameters );
+        Eigen::MatrixXd arcWeightedGlobalPartials( numberOfArcRows, numberOfGlobalParameters );
+        Eigen::VectorXd arcWeights( numberOfArcRows );
+        Eigen::VectorXd arcWeightedResiduals( numberOfArcRows );
+        for( int j = 0; j < numberOfArcRows; j++ )
+        {
+            const int currentRow = currentRows.at( j );
+            for( int k = 0; k < numberOfArcParameters; k++ )
+            {
+                arcPartials( j, k ) = partials( currentRow, arcParameterIndices_.at( i ).at( k ) );
+            }
+            arcWeightedGlobalPartials.row( j ) = weightedGlobalPartials.row( currentRow );
+            arcWeights( j ) = weights( currentRow );
+            arcWeightedResiduals( j ) = weights( currentRow ) * residuals( currentRow );
+        }
+
+        arcNormalBlocks_[ i ].noalias( ) += arcPartials.transpose( ) * ( arcWeights.asDiagonal( ) * arcPartials );
+        arcGlobalNormalBlocks_[ i ].noalias( ) += arcPartials.transpose( ) * arcWeightedGlobalPartials;
+        arcRightHandSides_[ i ].noalias( ) += arcPartials.transpose( ) * arcWeightedResiduals;
+    }
+}
+
+//! Function to add normal equations accumulated by another object (with identical structure) to this object.
+void BlockArrowheadNormalEquations::add( const BlockArrowheadNormalEquations& normalEquations )
+{
+    if( normalEquations.numberOfParameters_ != numberOfParameters_ ||
+            normalEquations.arcParameterIndices_ != arcParameterIndices_ )
+    {
+        throw std::runtime_error( "Error when adding block-arrowhead normal equations, structures are inconsistent." );
+    }
+
+    for( unsigned int i = 0; i < arcParameterIndices_.size( ); i++ )
+    {
+        arcNormalBlocks_[ i ] += normalEquations.arcNormalBlocks_.at( i );
+        arcGlobalNormalBlocks_[ i ] += normalEquations.arcGlobalNormalBlocks_.at( i );
+        arcRightHandSides_[ i ] += normalEquations.arcRightHandSides_.at( i );
+    }
+    globalNormalBlock_ += normalEquations.globalNormalBlock_;
+    globalRightHandSide_ += normalEquations.globalRightHandSide_;
+
+    columnMinima_ = columnMinima_.cwiseMin( normalEquations.columnMinima_ );
+    columnMaxima_ = columnMaxima_.cwiseMax( normalEquations.columnMaxima_ );
+}
+
+//! Function to add a matrix (e.g. the inverse a priori covariance) to the normal matrix.
+void BlockArrowheadNormalEquations::addToNormalMatrix( const Eigen::MatrixXd& matrixToAdd )
+{
+    if( matrixToAdd.rows( ) != numberOfParameters_ || matrixToAdd.cols( ) != numberOfParameters_ )
+    {
+        throw std::runtime_error( "Error when adding matrix to block-arrowhead normal equations, size is inconsistent." );
+    }
+
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+    for( int i = 0; i < numberOfParameters_; i++ )
+    {
+        for( int j = 0; j < numberOfParameters_; j++ )
+        {
+            if( matrixToAdd( i, j ) == 0.0 )
+            {
+                continue;
+            }
+
+            const int firstArc = arcIndexPerParameter_.at( i );
+            const int secondArc = arcIndexPerParameter_.at( j );
+            if( firstArc != -1 && secondArc != -1 && firstArc != secondArc )
+            {
+                throw std::runtime_error( "Error when adding matrix to block-arrowhead normal equations, matrix couples "
+                                          "arcs " + std::to_string( firstArc ) + " and " +
+                                          std::to_string( secondArc ) + "." );
+            }
+        }
+    }
+
+    for( int j = 0; j < numberOfGlobalParameters; j++ )
+    {
+        for( int i = 0; i < numberOfGlobalParameters; i++ )
+        {
+            globalNormalBlock_( i, j ) += matrixToAdd( globalParameterIndices_.at( i ), globalParameterIndices_.at( j ) );
+        }
+    }
+
+    for( unsigned int k = 0; k < arcParameterIndices_.size( ); k++ )
+    {
+        const std::vector< int >& currentIndices = arcParameterIndices_.at( k );
+        for( unsigned int i = 0; i < currentIndices.size( ); i++ )
+        {
+            for( unsigned int j = 0; j < currentIndices.size( ); j++ )
+            {
+                arcNormalBlocks_[ k ]( i, j ) += matrixToAdd( currentIndices.at( i ), currentIndices.at( j ) );
+            }
+            for( int j = 0; j < numberOfGlobalParameters; j++ )
+            {
+                arcGlobalNormalBlocks_[ k ]( i, j ) += matrixToAdd(
+                            currentIndices.at( i ), globalParameterIndices_.at( j ) );
+            }
+        }
+    }
+}
+
+//! Function to retrieve the normalization terms of the columns of the design matrix.
+Eigen::VectorXd BlockArrowheadNormalEquations::getDesignMatrixNormalizationTerms( ) const
+{
+    Eigen::VectorXd normalizationTerms = Eigen::VectorXd::Ones( numberOfParameters_ );
+    for( int i = 0; i < numberOfParameters_; i++ )
+    {
+        // No observations added: leave column unscaled
+        if( !( columnMinima_( i ) <= columnMaxima_( i ) ) )
+        {
+            continue;
+        }
+
+        if( std::fabs( columnMinima_( i ) ) > columnMaxima_( i ) )
+        {
+            normalizationTerms( i ) = columnMinima_( i );
+        }
+        else
+        {
+            normalizationTerms( i ) = columnMaxima_( i );
+        }
+
+        if( normalizationTerms( i ) == 0.0 )
+        {
+            normalizationTerms( i ) = 1.0;
+        }
+    }
+    return normalizationTerms;
+}
+
+//! Function to normalize the accumulated normal equations.
+void BlockArrowheadNormalEquations::normalize( const Eigen::VectorXd& normalizationTerms )
+{
+    if( normalizationTerms.rows( ) != numberOfParameters_ )
+    {
+        throw std::runtime_error( "Error when normalizing block-arrowhead normal equations, size is inconsistent." );
+    }
+
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+    Eigen::VectorXd inverseGlobalTerms( numberOfGlobalParameters );
+    for( int i = 0; i < numberOfGlobalParameters; i++ )
+    {
+        inverseGlobalTerms( i ) = 1.0 / normalizationTerms( globalParameterIndices_.at( i ) );
+    }
+    globalNormalBlock_ = inverseGlobalTerms.asDiagonal( ) * globalNormalBlock_ * inverseGlobalTerms.asDiagonal( );
+    globalRightHandSide_ = globalRightHandSide_.cwiseProduct( inverseGlobalTerms );
+
+    for( unsigned int k = 0; k < arcParameterIndices_.size( ); k++ )
+    {
+        const int numberOfArcParameters = arcParameterIndices_.at( k ).size( );
+        Eigen::VectorXd inverseArcTerms( numberOfArcParameters );
+        for( int i = 0; i < numberOfArcParameters; i++ )
+        {
+            inverseArcTerms( i ) = 1.0 / normalizationTerms( arcParameterIndices_.at( k ).at( i ) );
+        }
+        arcNormalBlocks_[ k ] = inverseArcTerms.asDiagonal( ) * arcNormalBlocks_[ k ] * inverseArcTerms.asDiagonal( );
+        arcGlobalNormalBlocks_[ k ] = inverseArcTerms.asDiagonal( ) * arcGlobalNormalBlocks_[ k ] *
+                inverseGlobalTerms.asDiagonal( );
+        arcRightHandSides_[ k ] = arcRightHandSides_[ k ].cwiseProduct( inverseArcTerms );
+    }
+}
+
+//! Function to solve the normal equations, using a Schur complement reduction over the arc-local parameters.
+Eigen::VectorXd BlockArrowheadNormalEquations::solve( const double limitConditionNumberForWarning ) const
+{
+    const int numberOfArcs = arcParameterIndices_.size( );
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+
+    // Eliminate arc-local parameters: S = N_gg - sum( N_ag^T N_aa^-1 N_ag ), r = b_g - sum( N_ag^T N_aa^-1 b_a )
+    std::vector< Eigen::JacobiSVD< Eigen::MatrixXd > > arcDecompositions;
+    std::vector< Eigen::MatrixXd > reducedArcGlobalBlocks;
+    std::vector< Eigen::VectorXd > reducedArcRightHandSides;
+    Eigen::MatrixXd reducedNormalMatrix = globalNormalBlock_;
+    Eigen::VectorXd reducedRightHandSide = globalRightHandSide_;
+    for( int i = 0; i < numberOfArcs; i++ )
+    {
+        arcDecompositions.push_back( Eigen::JacobiSVD< Eigen::MatrixXd >(
+                                         arcNormalBlocks_.at( i ), Eigen::ComputeThinU | Eigen::ComputeThinV ) );
+        reducedArcGlobalBlocks.push_back( arcDecompositions.at( i ).solve( arcGlobalNormalBlocks_.at( i ) ) );
+        reducedArcRightHandSides.push_back( arcDecompositions.at( i ).solve( arcRightHandSides_.at( i ) ) );
+
+        reducedNormalMatrix.noalias( ) -= arcGlobalNormalBlocks_.at( i ).transpose( ) * reducedArcGlobalBlocks.at( i );
+        reducedRightHandSide.noalias( ) -= arcGlobalNormalBlocks_.at( i ).transpose( ) * reducedArcRightHandSides.at( i );
+    }
+
+    // Solve reduced system for global parameters
+    Eigen::VectorXd globalSolution = Eigen::VectorXd::Zero( numberOfGlobalParameters );
+    if( numberOfGlobalParameters > 0 )
+    {
+        globalSolution = solveSystemOfEquationsWithSvd(
+                    reducedNormalMatrix, reducedRightHandSide, limitConditionNumberForWarning );
+    }
+
+    // Back-substitute to obtain arc-local parameters: x_a = N_aa^-1 ( b_a - N_ag x_g )
+    Eigen::VectorXd solution = Eigen::VectorXd::Zero( numberOfParameters_ );
+    for( int i = 0; i < numberOfGlobalParameters; i++ )
+    {
+        solution( globalParameterIndices_.at( i ) ) = globalSolution( i );
+    }
+    for( int i = 0; i < numberOfArcs; i++ )
+    {
+        Eigen::VectorXd arcSolution = reducedArcRightHandSides.at( i ) - reducedArcGlobalBlocks.at( i ) * globalSolution;
+        for( unsigned int j = 0; j < arcParameterIndices_.at( i ).size( ); j++ )
+        {
+            solution( arcParameterIndices_.at( i ).at( j ) ) = arcSolution( j );
+        }
+    }
+    return solution;
+}
+
+//! Function to retrieve the full (dense) normal matrix, for instance to compute the covariance.
+Eigen::MatrixXd BlockArrowheadNormalEquations::getFullNormalMatrix( ) const
+{
+    const int numberOfGlobalParameters = globalParameterIndices_.size( );
+
+    Eigen::MatrixXd normalMatrix = Eigen::MatrixXd::Zero( numberOfParameters_, numberOfParameters_ );
+    for( int i = 0; i < numberOfGlobalParameters; i++ )
+    {
+        for( int j = 0; j < numberOfGlobalParameters; j++ )
+        {
+            normalMatrix( globalParameterIndices_.at( i ), globalParameterIndices_.at( j ) ) = globalNormalBlock_( i, j );
+        }
+    }
+
+    for( unsigned int k = 0; k < arcParameterIndices_.size( ); k++ )
+    {
+        const std::vector< int >& currentIndices = arcParameterIndices_.at( k );
+        for( unsigned int i = 0; i < currentIndices.size( ); i++ )
+        {
+            for( unsigned int j = 0; j < currentIndices.size( ); j++ )
+            {
+                normalMatrix( currentIndices.at( i ), currentIndices.at( j ) ) = arcNormalBlocks_.at( k )( i, j );
+            }
+            for( int j = 0; j < numberOfGlobalParameters; j++ )
+            {
+                normalMatrix( currentIndices.at( i ), globalParameterIndices_.at( j ) ) =
+                        arcGlobalNormalBlocks_.at( k )( i, j );
+                normalMatrix( globalParameterIndices_.at( j ), currentIndices.at( i ) ) =
+                        arcGlobalNormalBlocks_.at( k )( i, j );
+            }
+        }
+    }
+    return normalMatrix;
+}
+
+//! Function to retrieve the full right-hand side of the normal equations.
+Eigen::VectorXd BlockArrowheadNormalEquations::getFullRightHandSide( ) const
+{
+    Eigen::VectorXd rightHandSide = Eigen::VectorXd::Zero( numberOfParameters_ );
+    for( unsigned int i = 0; i < globalParameterIndices_.size( ); i++ )
+    {
+        rightHandSide( globalParameterIndices_.at( i ) ) = globalRightHandSide_( i );
+    }
+    for( unsigned int k = 0; k < arcParameterIndices_.size( ); k++ )
+    {
+        for( unsigned int i = 0; i < arcParameterIndices_.at( k ).size( ); i++ )
+        {
+            rightHandSide( arcParameterIndices_.at( k ).at( i ) ) = arcRightHandSides_.at( k )( i );
+        }
+    }
+    return rightHandSide;
+}
+
+} // namespace linear_algebra
+
+} // namespace tudat
@@ -26,41 +26,43 @@ namespace numerical_derivatives
 //! Get coefficients of a certain order for central difference numerical derivatives.
 const std::map< int, double >& getCentralDifferenceCoefficients( CentralDifferenceOrders order )
 {
-    static std::map< CentralDifferenceOrders, std::map< int, double > > coefficients;
-
-    if ( coefficients.empty( ) )
+    // Initialize the coefficients map once (thread-safe static initialization)
+    static const std::map< CentralDifferenceOrders, std::map< int, double > > coefficients = [ ]( )
     {
-        // Initialize the coefficients map
-        coefficients[ order2 ] = std::map< int, double >( );
-        coefficients[ order2 ][ -1 ] = -1.0 / 2.0;
-        coefficients[ order2 ][ 1 ] = 1.0 / 2.0;
-
-        coefficients[ order4 ] = std::map< int, double >( );
-        coefficients[ order4 ][ -2 ] = 1.0 / 12.0;
-        coefficients[ order4 ][ -1 ] = -2.0 / 3.0;
-        coefficients[ order4 ][ 1 ] = 2.0 / 3.0;
-        coefficients[ order4 ][ 2 ] = -1.0 / 12.0;
-
-        coefficients[ order6 ] = std::map< int, double >( );
-        coefficients[ order6 ][ -3 ] = -1.0 / 60.0;
-        coefficients[ order6 ][ -2 ] = 3.0 / 20.0;
-        coefficients[ order6 ][ -1 ] = -3.0 / 4.0;
-        coefficients[ order6 ][ 1 ] = 1.0 / 60.0;
-        coefficients[ order6 ][ 2 ] = -3.0 / 20.0;
-        coefficients[ order6 ][ 3 ] = 3.0 / 4.0;
-
-        coefficients[ order8 ] = std::map< int, double >( );
-        coefficients[ order8 ][ -4 ] = 1.0 / 280.0;
-        coefficients[ order8 ][ -3 ] = -4.0 / 105.0;
-        coefficients[ order8 ][ -2 ] = 1.0 / 5.0;
-        coefficients[ order8 ][ -1 ] = -4.0 / 5.0;
-        coefficients[ order8 ][ 1 ] = 4.0 / 5.0;
-        coefficients[ order8 ][ 2 ] = -1.0 / 5.0;
-        coefficients[ order8 ][ 3 ] = 4.0 / 105.0;
-        coefficients[ order8 ][ 4 ] = -1.0 / 280.0;
-    }
+        std::map< CentralDifferenceOrders, std::map< int, double > > coefficientMap;
+
+        coefficientMap[ order2 ] = std::map< int, double >( );
+        coefficientMap[ order2 ][ -1 ] = -1.0 / 2.0;
+        coefficientMap[ order2 ][ 1 ] = 1.0 / 2.0;
+
+        coefficientMap[ order4 ] = std::map< int, double >( );
+        coefficientMap[ order4 ][ -2 ] = 1.0 / 12.0;
+        coefficientMap[ order4 ][ -1 ] = -2.0 / 3.0;
+        coefficientMap[ order4 ][ 1 ] = 2.0 / 3.0;
+        coefficientMap[ order4 ][ 2 ] = -1.0 / 12.0;
+
+        coefficientMap[ order6 ] = std::map< int, double >( );
+        coefficientMap[ order6 ][ -3 ] = -1.0 / 60.0;
+        coefficientMap[ order6 ][ -2 ] = 3.0 / 20.0;
+        coefficientMap[ order6 ][ -1 ] = -3.0 / 4.0;
+        coefficientMap[ order6 ][ 1 ] = 1.0 / 60.0;
+        coefficientMap[ order6 ][ 2 ] = -3.0 / 20.0;
+        coefficientMap[ order6 ][ 3 ] = 3.0 / 4.0;
+
+        coefficientMap[ order8 ] = std::map< int, double >( );
+        coefficientMap[ order8 ][ -4 ] = 1.0 / 280.0;
+        coefficientMap[ order8 ][ -3 ] = -4.0 / 105.0;
+        coefficientMap[ order8 ][ -2 ] = 1.0 / 5.0;
+        coefficientMap[ order8 ][ -1 ] = -4.0 / 5.0;
+        coefficientMap[ order8 ][ 1 ] = 4.0 / 5.0;
+        coefficientMap[ order8 ][ 2 ] = -1.0 / 5.0;
+        coefficientMap[ order8 ][ 3 ] = 4.0 / 105.0;
+        coefficientMap[ order8 ][ 4 ] = -1.0 / 280.0;
+
+        return coefficientMap;
+    }( );
 
-    return coefficients[ order ];
+    return coefficients.at( order );
 }
 
 Eigen::MatrixXd computeCentralDifference( const Eigen::VectorXd& input, const std::function<
@@ -0,0 +1,591 @@
+/*    Copyright (c) 2010-2022, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "tudat/math/basic/polyhedron.h"
+#include "tudat/math/basic/polyhedronFacetTree.h"
+
+namespace tudat
+{
+namespace basic_mathematics
+{
+
+PolyhedronFacetTree::PolyhedronFacetTree(
+        const Eigen::MatrixXd& verticesCoordinates,
+        const Eigen::MatrixXi& verticesDefiningEachFacet,
+        const int maximumNumberOfFacetsPerLeaf ):
+    maximumNumberOfFacetsPerLeaf_( maximumNumberOfFacetsPerLeaf )
+{
+    checkValidityOfPolyhedronSettings( verticesCoordinates, verticesDefiningEachFacet );
+    if( maximumNumberOfFacetsPerLeaf_ < 1 )
+    {
+        throw std::runtime_error( "Error when creating polyhedron facet tree, maximum number of facets per leaf (" +
+                                  std::to_string( maximumNumberOfFacetsPerLeaf_ ) + ") must be positive." );
+    }
+
+    const int numberOfVertices = verticesCoordinates.rows( );
+    const int numberOfFacets = verticesDefiningEachFacet.rows( );
+
+    vertices_.resize( numberOfVertices );
+    for( int vertex = 0; vertex < numberOfVertices; ++vertex )
+    {
+        vertices_[ vertex ] = verticesCoordinates.block< 1, 3 >( vertex, 0 ).transpose( );
+    }
+
+    // Set facet vertices and centroids (input ordering), and build tree
+    std::vector< Eigen::Vector3d > facetCentroids( numberOfFacets );
+    facetVertices_.resize( numberOfFacets );
+    facetOrder_.resize( numberOfFacets );
+    for( int facet = 0; facet < numberOfFacets; ++facet )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            facetVertices_[ facet ][ i ] = verticesDefiningEachFacet( facet, i );
+        }
+        facetCentroids[ facet ] = ( vertices_[ facetVertices_[ facet ][ 0 ] ] + vertices_[ facetVertices_[ facet ][ 1 ] ] +
+                vertices_[ facetVertices_[ facet ][ 2 ] ] ) / 3.0;
+        facetOrder_[ facet ] = facet;
+    }
+
+    nodes_.reserve( 4 * numberOfFacets / maximumNumberOfFacetsPerLeaf_ + 1 );
+    createNode( 0, numberOfFacets, facetCentroids );
+
+    // Reorder facet data to tree ordering, and compute facet and edge normals
+    std::vector< std::array< int, 3 > > inputFacetVertices = facetVertices_;
+    facetNormals_.resize( numberOfFacets );
+    facetEdgeNormals_.resize( numberOfFacets );
+    for( int facet = 0; facet < numberOfFacets; ++facet )
+    {
+        facetVertices_[ facet ] = inputFacetVertices[ facetOrder_[ facet ] ];
+
+        const Eigen::Vector3d& vertex0 = vertices_[ facetVertices_[ facet ][ 0 ] ];
+        const Eigen::Vector3d& vertex1 = vertices_[ facetVertices_[ facet ][ 1 ] ];
+        const Eigen::Vector3d& vertex2 = vertices_[ facetVertices_[ facet ][ 2 ] ];
+        facetNormals_[ facet ] = ( ( vertex1 - vertex0 ).cross( vertex2 - vertex1 ) ).normalized( );
+        facetEdgeNormals_[ facet ][ 0 ] = ( ( vertex1 - vertex0 ).cross( facetNormals_[ facet ] ) ).normalized( );
+        facetEdgeNormals_[ facet ][ 1 ] = ( ( vertex2 - vertex1 ).cross( facetNormals_[ facet ] ) ).normalized( );
+        facetEdgeNormals_[ facet ][ 2 ] = ( ( vertex0 - vertex2 ).cross( facetNormals_[ facet ] ) ).normalized( );
+    }
+
+    computePseudoNormals( );
+
+    clusterMoments_.resize( nodes_.size( ) );
+    for( unsigned int node = 0; node < nodes_.size( ); ++node )
+    {
+        computeClusterMoments( node );
+    }
+}
+
+double PolyhedronFacetTree::calculateGravitationalPotential(
+        const double gravitationalConstantTimesDensity,
+        const Eigen::Vector3d& bodyFixedPosition,
+        const double maximumRelativeTruncationError ) const
+{
+    double scalarSum = 0.0;
+    Eigen::Vector3d vectorSum = Eigen::Vector3d::Zero( );
+    calculateSurfaceIntegralSums( bodyFixedPosition, maximumRelativeTruncationError, true, scalarSum, vectorSum );
+
+    return 0.5 * gravitationalConstantTimesDensity * scalarSum;
+}
+
+Eigen::Vector3d PolyhedronFacetTree::calculateGradientOfGravitationalPotential(
+        const double gravitationalConstantTimesDensity,
+        const Eigen::Vector3d& bodyFixedPosition,
+        const double maximumRelativeTruncationError ) const
+{
+    double scalarSum = 0.0;
+    Eigen::Vector3d vectorSum = Eigen::Vector3d::Zero( );
+    calculateSurfaceIntegralSums( bodyFixedPosition, maximumRelativeTruncationError, false, scalarSum, vectorSum );
+
+    return - gravitationalConstantTimesDensity * vectorSum;
+}
+
+double PolyhedronFacetTree::calculateDistanceToSurface(
+        const Eigen::Vector3d& bodyFixedPosition,
+        const bool computeSign ) const
+{
+    double closestSquaredDistance = std::numeric_limits< double >::infinity( );
+    Eigen::Vector3d closestPoint = Eigen::Vector3d::Zero( );
+    int closestFacet = -1;
+    int closestFeature = -1;
+
+    // Depth-first search, visiting closest child first and skipping nodes that are further than the closest facet so far
+    std::vector< int > nodesToVisit;
+    nodesToVisit.push_back( 0 );
+    while( !nodesToVisit.empty( ) )
+    {
+        const int nodeIndex = nodesToVisit.back( );
+        nodesToVisit.pop_back( );
+        if( calculateSquaredDistanceToNode( bodyFixedPosition, nodeIndex ) >= closestSquaredDistance )
+        {
+            continue;
+        }
+
+        const PolyhedronFacetTreeNode& node = nodes_[ nodeIndex ];
+        if( node.firstChild_ < 0 )
+        {
+            for( int facet = node.firstFacet_; facet < node.firstFacet_ + node.numberOfFacets_; ++facet )
+            {
+                int feature;
+                const Eigen::Vector3d point = calculateClosestPointOnFacet( bodyFixedPosition, facet, feature );
+                const double squaredDistance = ( bodyFixedPosition - point ).squaredNorm( );
+                if( squaredDistance < closestSquaredDistance )
+                {
+                    closestSquaredDistance = squaredDistance;
+                    closestPoint = point;
+                    closestFacet = facet;
+                    closestFeature = feature;
+                }
+            }
+        }
+        else
+        {
+            const double firstChildDistance = calculateSquaredDistanceToNode( bodyFixedPosition, node.firstChild_ );
+            const double secondChildDistance = calculateSquaredDistanceToNode( bodyFixedPosition, node.secondChild_ );
+            if( firstChildDistance < secondChildDistance )
+            {
+                nodesToVisit.push_back( node.secondChild_ );
+                nodesToVisit.push_back( node.firstChild_ );
+            }
+            else
+            {
+                nodesToVisit.push_back( node.firstChild_ );
+                nodesToVisit.push_back( node.secondChild_ );
+            }
+        }
+    }
+
+    double distance = std::sqrt( closestSquaredDistance );
+
+    // Determine sign from pseudo-normal of closest feature
+    if( computeSign && distance > 0.0 )
+    {
+        Eigen::Vector3d pseudoNormal;
+        if( closestFeature < 3 )
+        {
+            pseudoNormal = vertexPseudoNormals_[ facetVertices_[ closestFacet ][ closestFeature ] ];
+        }
+        else if( closestFeature < 6 )
+        {
+            pseudoNormal = facetEdgePseudoNormals_[ closestFacet ][ closestFeature - 3 ];
+        }
+        else
+        {
+            pseudoNormal = facetNormals_[ closestFacet ];
+        }
+
+        if( ( bodyFixedPosition - closestPoint ).dot( pseudoNormal ) < 0.0 )
+        {
+            distance = -distance;
+        }
+    }
+
+    return distance;
+}
+
+double PolyhedronFacetTree::calculateDistanceToClosestVertex(
+        const Eigen::Vector3d& bodyFixedPosition,
+        int& closestVertex ) const
+{
+    double closestSquaredDistance = std::numeric_limits< double >::infinity( );
+    closestVertex = -1;
+
+    std::vector< int > nodesToVisit;
+    nodesToVisit.push_back( 0 );
+    while( !nodesToVisit.empty( ) )
+    {
+        const int nodeIndex = nodesToVisit.back( );
+        nodesToVisit.pop_back( );
+        if( calculateSquaredDistanceToNode( bodyFixedPosition, nodeIndex ) >= closestSquaredDistance )
+        {
+            continue;
+        }
+
+        const PolyhedronFacetTreeNode& node = nodes_[ nodeIndex ];
+        if( node.firstChild_ < 0 )
+        {
+            for( int facet = node.firstFacet_; facet < node.firstFacet_ + node.numberOfFacets_; ++facet )
+            {
+                for( int i = 0; i < 3; ++i )
+                {
+                    const double squaredDistance =
+                            ( bodyFixedPosition - vertices_[ facetVertices_[ facet ][ i ] ] ).squaredNorm( );
+                    if( squaredDistance < closestSquaredDistance )
+                    {
+                        closestSquaredDistance = squaredDistance;
+                        closestVertex = facetVertices_[ facet ][ i ];
+                    }
+                }
+            }
+        }
+        else
+        {
+            const double firstChildDistance = calculateSquaredDistanceToNode( bodyFixedPosition, node.firstChild_ );
+            const double secondChildDistance = calculateSquaredDistanceToNode( bodyFixedPosition, node.secondChild_ );
+            if( firstChildDistance < secondChildDistance )
+            {
+                nodesToVisit.push_back( node.secondChild_ );
+                nodesToVisit.push_back( node.firstChild_ );
+            }
+            else
+            {
+                nodesToVisit.push_back( node.firstChild_ );
+                nodesToVisit.push_back( node.secondChild_ );
+            }
+        }
+    }
+
+    return std::sqrt( closestSquaredDistance );
+}
+
+int PolyhedronFacetTree::createNode(
+        const int firstFacet, const int numberOfFacets, const std::vector< Eigen::Vector3d >& facetCentroids )
+{
+    const int nodeIndex = nodes_.size( );
+    nodes_.push_back( PolyhedronFacetTreeNode( ) );
+
+    // Compute bounding boxes of facets and of facet centroids
+    Eigen::Vector3d minimumCorner = Eigen::Vector3d::Constant( std::numeric_limits< double >::infinity( ) );
+    Eigen::Vector3d maximumCorner = -minimumCorner;
+    Eigen::Vector3d minimumCentroid = minimumCorner;
+    Eigen::Vector3d maximumCentroid = maximumCorner;
+    for( int i = firstFacet; i < firstFacet + numberOfFacets; ++i )
+    {
+        const int facet = facetOrder_[ i ];
+        for( int j = 0; j < 3; ++j )
+        {
+            minimumCorner = minimumCorner.cwiseMin( vertices_[ facetVertices_[ facet ][ j ] ] );
+            maximumCorner = maximumCorner.cwiseMax( vertices_[ facetVertices_[ facet ][ j ] ] );
+        }
+        minimumCentroid = minimumCentroid.cwiseMin( facetCentroids[ facet ] );
+        maximumCentroid = maximumCentroid.cwiseMax( facetCentroids[ facet ] );
+    }
+
+    const Eigen::Vector3d center = 0.5 * ( minimumCorner + maximumCorner );
+    double radius = 0.0;
+    for( int i = firstFacet; i < firstFacet + numberOfFacets; ++i )
+    {
+        for( int j = 0; j < 3; ++j )
+        {
+            radius = std::max( radius, ( vertices_[ facetVertices_[ facetOrder_[ i ] ][ j ] ] - center ).norm( ) );
+        }
+    }
+
+    nodes_[ nodeIndex ].minimumCorner_ = minimumCorner;
+    nodes_[ nodeIndex ].maximumCorner_ = maximumCorner;
+    nodes_[ nodeIndex ].center_ = center;
+    nodes_[ nodeIndex ].radius_ = radius;
+    nodes_[ nodeIndex ].firstFacet_ = firstFacet;
+    nodes_[ nodeIndex ].numberOfFacets_ = numberOfFacets;
+    nodes_[ nodeIndex ].firstChild_ = -1;
+    nodes_[ nodeIndex ].secondChild_ = -1;
+
+    // Split facets at median centroid along axis of largest centroid extent
+    if( numberOfFacets > maximumNumberOfFacetsPerLeaf_ )
+    {
+        int splitAxis;
+        ( maximumCentroid - minimumCentroid ).maxCoeff( &splitAxis );
+
+        const int numberOfFacetsInFirstChild = numberOfFacets / 2;
+        std::nth_element( facetOrder_.begin( ) + firstFacet,
+                          facetOrder_.begin( ) + firstFacet + numberOfFacetsInFirstChild,
+                          facetOrder_.begin( ) + firstFacet + numberOfFacets,
+                          [ & ]( const int facet1, const int facet2 )
+        {
+            return facetCentroids[ facet1 ]( splitAxis ) < facetCentroids[ facet2 ]( splitAxis );
+        } );
+
+        const int firstChild = createNode( firstFacet, numberOfFacetsInFirstChild, facetCentroids );
+        const int secondChild = createNode( firstFacet + numberOfFacetsInFirstChild,
+                                            numberOfFacets - numberOfFacetsInFirstChild, facetCentroids );
+        nodes_[ nodeIndex ].firstChild_ = firstChild;
+        nodes_[ nodeIndex ].secondChild_ = secondChild;
+    }
+
+    return nodeIndex;
+}
+
+void PolyhedronFacetTree::computeClusterMoments( const int nodeIndex )
+{
+    const PolyhedronFacetTreeNode& node = nodes_[ nodeIndex ];
+    PolyhedronFacetClusterMoments& moments = clusterMoments_[ nodeIndex ];
+
+    moments.normalZerothMoment_.setZero( );
+    moments.normalFirstMoment_.setZero( );
+    for( int k = 0; k < 3; ++k )
+    {
+        moments.normalSecondMoment_[ k ].setZero( );
+    }
+    moments.heightZerothMoment_ = 0.0;
+    moments.heightFirstMoment_.setZero( );
+    moments.heightSecondMoment_.setZero( );
+
+    for( int facet = node.firstFacet_; facet < node.firstFacet_ + node.numberOfFacets_; ++facet )
+    {
+        // Vertices w.r.t. node center
+        const Eigen::Vector3d relativeVertex0 = vertices_[ facetVertices_[ facet ][ 0 ] ] - node.center_;
+        const Eigen::Vector3d relativeVertex1 = vertices_[ facetVertices_[ facet ][ 1 ] ] - node.center_;
+        const Eigen::Vector3d relativeVertex2 = vertices_[ facetVertices_[ facet ][ 2 ] ] - node.center_;
+        const Eigen::Vector3d vertexSum = relativeVertex0 + relativeVertex1 + relativeVertex2;
+
+        // Compute area, and first and second moments of area of the facet
+        const double area = 0.5 * ( ( relativeVertex1 - relativeVertex0 ).cross( relativeVertex2 - relativeVertex0 ) ).norm( );
+        const Eigen::Vector3d firstMoment = area * vertexSum / 3.0;
+        const Eigen::Matrix3d secondMoment = area / 12.0 * (
+                    relativeVertex0 * relativeVertex0.transpose( ) + relativeVertex1 * relativeVertex1.transpose( ) +
+                    relativeVertex2 * relativeVertex2.transpose( ) + vertexSum * vertexSum.transpose( ) );
+
+        const Eigen::Vector3d& normal = facetNormals_[ facet ];
+        const double height = normal.dot( relativeVertex0 );
+
+        moments.normalZerothMoment_ += area * normal;
+        moments.normalFirstMoment_ += normal * firstMoment.transpose( );
+        for( int k = 0; k < 3; ++k )
+        {
+            moments.normalSecondMoment_[ k ] += normal( k ) * secondMoment;
+        }
+        moments.heightZerothMoment_ += height * area;
+        moments.heightFirstMoment_ += height * firstMoment;
+        moments.heightSecondMoment_ += height * secondMoment;
+    }
+}
+
+void PolyhedronFacetTree::computePseudoNormals( )
+{
+    const int numberOfFacets = facetVertices_.size( );
+
+    vertexPseudoNormals_.assign( vertices_.size( ), Eigen::Vector3d::Zero( ) );
+    facetEdgePseudoNormals_.resize( numberOfFacets );
+
+    // Sum normals of facets adjacent to each edge, and angle-weighted normals of facets adjacent to each vertex
+    std::map< std::pair< int, int >, Eigen::Vector3d > edgeNormalSums;
+    for( int facet = 0; facet < numberOfFacets; ++facet )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            const int vertex = facetVertices_[ facet ][ i ];
+            const int nextVertex = facetVertices_[ facet ][ ( i + 1 ) % 3 ];
+            const int previousVertex = facetVertices_[ facet ][ ( i + 2 ) % 3 ];
+
+            const Eigen::Vector3d toNextVertex = ( vertices_[ nextVertex ] - vertices_[ vertex ] ).normalized( );
+            const Eigen::Vector3d toPreviousVertex = ( vertices_[ previousVertex ] - vertices_[ vertex ] ).normalized( );
+            const double angle = std::acos( std::max( -1.0, std::min( 1.0, toNextVertex.dot( toPreviousVertex ) ) ) );
+            vertexPseudoNormals_[ vertex ] += angle * facetNormals_[ facet ];
+
+            const std::pair< int, int > edge = std::make_pair( std::min( vertex, nextVertex ), std::max( vertex, nextVertex ) );
+            if( edgeNormalSums.count( edge ) == 0 )
+            {
+                edgeNormalSums[ edge ] = Eigen::Vector3d::Zero( );
+            }
+            edgeNormalSums[ edge ] += facetNormals_[ facet ];
+        }
+    }
+
+    for( int facet = 0; facet < numberOfFacets; ++facet )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            const int vertex = facetVertices_[ facet ][ i ];
+            const int nextVertex = facetVertices_[ facet ][ ( i + 1 ) % 3 ];
+            facetEdgePseudoNormals_[ facet ][ i ] = edgeNormalSums.at(
+                        std::make_pair( std::min( vertex, nextVertex ), std::max( vertex, nextVertex ) ) );
+        }
+    }
+}
+
+void PolyhedronFacetTree::calculateSurfaceIntegralSums(
+        const Eigen::Vector3d& bodyFixedPosition,
+        const double maximumRelativeTruncationError,
+        const bool computeScalarSum,
+        double& scalarSum,
+        Eigen::Vector3d& vectorSum ) const
+{
+    std::vector< int > nodesToVisit;
+    nodesToVisit.push_back( 0 );
+    while( !nodesToVisit.empty( ) )
+    {
+        const int nodeIndex = nodesToVisit.back( );
+        nodesToVisit.pop_back( );
+        const PolyhedronFacetTreeNode& node = nodes_[ nodeIndex ];
+
+        // Approximate surface integrals of cluster by multipole expansion, if truncation error bound is sufficiently small:
+        // the remainder of the expansion of 1/|R+s| to second order is bounded by ( a / D )^3 / ( D - a ), for |s| <= a.
+        const Eigen::Vector3d centerFromFieldPoint = node.center_ - bodyFixedPosition;
+        const double squaredDistance = centerFromFieldPoint.squaredNorm( );
+        if( maximumRelativeTruncationError > 0.0 && node.radius_ * node.radius_ < squaredDistance )
+        {
+            const double distance = std::sqrt( squaredDistance );
+            const double radiusRatio = node.radius_ / distance;
+            if( radiusRatio * radiusRatio * radiusRatio <= maximumRelativeTruncationError * ( 1.0 - radiusRatio ) )
+            {
+                const PolyhedronFacetClusterMoments& moments = clusterMoments_[ nodeIndex ];
+                const double inverseDistance = 1.0 / distance;
+                const double inverseDistanceCubed = inverseDistance * inverseDistance * inverseDistance;
+                const double halfInverseDistanceFifth = 0.5 * inverseDistanceCubed * inverseDistance * inverseDistance;
+
+                Eigen::Vector3d clusterVectorSum = moments.normalZerothMoment_ * inverseDistance -
+                        moments.normalFirstMoment_ * centerFromFieldPoint * inverseDistanceCubed;
+                for( int k = 0; k < 3; ++k )
+                {
+                    clusterVectorSum( k ) += halfInverseDistanceFifth * (
+                                3.0 * centerFromFieldPoint.dot( moments.normalSecondMoment_[ k ] * centerFromFieldPoint ) -
+                                squaredDistance * moments.normalSecondMoment_[ k ].trace( ) );
+                }
+                vectorSum += clusterVectorSum;
+
+                if( computeScalarSum )
+                {
+                    scalarSum += moments.heightZerothMoment_ * inverseDistance -
+                            moments.heightFirstMoment_.dot( centerFromFieldPoint ) * inverseDistanceCubed +
+                            halfInverseDistanceFifth * (
+                                3.0 * centerFromFieldPoint.dot( moments.heightSecondMoment_ * centerFromFieldPoint ) -
+                                squaredDistance * moments.heightSecondMoment_.trace( ) ) +
+                            centerFromFieldPoint.dot( clusterVectorSum );
+                }
+                continue;
+            }
+        }
+
+        if( node.firstChild_ >= 0 )
+        {
+            nodesToVisit.push_back( node.firstChild_ );
+            nodesToVisit.push_back( node.secondChild_ );
+            continue;
+        }
+
+        // Compute surface integrals of facets in leaf exactly (Werner and Scheeres, 1997)
+        for( int facet = node.firstFacet_; facet < node.firstFacet_ + node.numberOfFacets_; ++facet )
+        {
+            const std::array< Eigen::Vector3d, 3 > relativePositions = {
+                vertices_[ facetVertices_[ facet ][ 0 ] ] - bodyFixedPosition,
+                vertices_[ facetVertices_[ facet ][ 1 ] ] - bodyFixedPosition,
+                vertices_[ facetVertices_[ facet ][ 2 ] ] - bodyFixedPosition };
+            const std::array< double, 3 > relativeDistances = {
+                relativePositions[ 0 ].norm( ), relativePositions[ 1 ].norm( ), relativePositions[ 2 ].norm( ) };
+
+            // Compute per-facet factor (solid angle)
+            double perFacetFactor = 0.0;
+            const double numerator = relativePositions[ 0 ].dot( relativePositions[ 1 ].cross( relativePositions[ 2 ] ) );
+            if( numerator != 0.0 )
+            {
+                perFacetFactor = 2.0 * std::atan2(
+                            numerator,
+                            relativeDistances[ 0 ] * relativeDistances[ 1 ] * relativeDistances[ 2 ] +
+                            relativeDistances[ 0 ] * relativePositions[ 1 ].dot( relativePositions[ 2 ] ) +
+                            relativeDistances[ 1 ] * relativePositions[ 2 ].dot( relativePositions[ 0 ] ) +
+                            relativeDistances[ 2 ] * relativePositions[ 0 ].dot( relativePositions[ 1 ] ) );
+            }
+
+            // Compute facet surface integral from per-edge factors and per-facet factor
+            const double facetHeight = facetNormals_[ facet ].dot( relativePositions[ 0 ] );
+            double surfaceIntegral = - facetHeight * perFacetFactor;
+            for( int i = 0; i < 3; ++i )
+            {
+                const int j = ( i + 1 ) % 3;
+                const double edgeLength = ( relativePositions[ i ] - relativePositions[ j ] ).norm( );
+                const double denominator = relativeDistances[ i ] + relativeDistances[ j ] - edgeLength;
+                if( std::abs( denominator ) >= 1e-18 )
+                {
+                    surfaceIntegral += facetEdgeNormals_[ facet ][ i ].dot( relativePositions[ i ] ) *
+                            std::log( ( relativeDistances[ i ] + relativeDistances[ j ] + edgeLength ) / denominator );
+                }
+            }
+
+            vectorSum += facetNormals_[ facet ] * surfaceIntegral;
+            if( computeScalarSum )
+            {
+                scalarSum += facetHeight * surfaceIntegral;
+            }
+        }
+    }
+}
+
+Eigen::Vector3d PolyhedronFacetTree::calculateClosestPointOnFacet(
+        const Eigen::Vector3d& bodyFixedPosition, const int facet, int& closestFeature ) const
+{
+    // Closest point on triangle, from Voronoi regions of its features (Ericson, 2004, Section 5.1.5)
+    const Eigen::Vector3d& vertex0 = vertices_[ facetVertices_[ facet ][ 0 ] ];
+    const Eigen::Vector3d& vertex1 = vertices_[ facetVertices_[ facet ][ 1 ] ];
+    const Eigen::Vector3d& vertex2 = vertices_[ facetVertices_[ facet ][ 2 ] ];
+
+    const Eigen::Vector3d edge01 = vertex1 - vertex0;
+    const Eigen::Vector3d edge02 = vertex2 - vertex0;
+
+    const Eigen::Vector3d fromVertex0 = bodyFixedPosition - vertex0;
+    const double d1 = edge01.dot( fromVertex0 );
+    const double d2 = edge02.dot( fromVertex0 );
+    if( d1 <= 0.0 && d2 <= 0.0 )
+    {
+        closestFeature = 0;
+        return vertex0;
+    }
+
+    const Eigen::Vector3d fromVertex1 = bodyFixedPosition - vertex1;
+    const double d3 = edge01.dot( fromVertex1 );
+    const double d4 = edge02.dot( fromVertex1 );
+    if( d3 >= 0.0 && d4 <= d3 )
+    {
+        closestFeature = 1;
+        return vertex1;
+    }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 )
+    {
+        closestFeature = 3;
+        return vertex0 + d1 / ( d1 - d3 ) * edge01;
+    }
+
+    const Eigen::Vector3d fromVertex2 = bodyFixedPosition - vertex2;
+    const double d5 = edge01.dot( fromVertex2 );
+    const double d6 = edge02.dot( fromVertex2 );
+    if( d6 >= 0.0 && d5 <= d6 )
+    {
+        closestFeature = 2;
+        return vertex2;
+    }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 )
+    {
+        closestFeature = 5;
+        return vertex0 + d2 / ( d2 - d6 ) * edge02;
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if( va <= 0.0 && ( d4 - d3 ) >= 0.0 && ( d5 - d6 ) >= 0.0 )
+    {
+        closestFeature = 4;
+        return vertex1 + ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) ) * ( vertex2 - vertex1 );
+    }
+
+    closestFeature = 6;
+    const double inverseDenominator = 1.0 / ( va + vb + vc );
+    return vertex0 + vb * inverseDenominator * edge01 + vc * inverseDenominator * edge02;
+}
+
+double PolyhedronFacetTree::calculateSquaredDistanceToNode(
+        const Eigen::Vector3d& bodyFixedPosition, const int nodeIndex ) const
+{
+    const Eigen::Vector3d outsideDistance =
+            ( nodes_[ nodeIndex ].minimumCorner_ - bodyFixedPosition ).cwiseMax(
+                bodyFixedPosition - nodes_[ nodeIndex ].maximumCorner_ ).cwiseMax( 0.0 );
+    return outsideDistance.squaredNorm( );
+}
+
+} // namespace basic_mathematics
+} // namespace tudat
@@ -0,0 +1,300 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I: Nonstiff Problems,
+ *          2nd edition, Springer, 1993 (Sections II.2 and II.6).
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <Eigen/Dense>
+
+#include "tudat/math/integrators/rungeKuttaDenseOutput.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Rooted tree, as used in the order conditions of Runge-Kutta methods.
+struct RootedTree
+{
+    //! Indices (in list of all trees) of the subtrees attached to the root, in non-decreasing order.
+    std::vector< int > subtreeIndices;
+
+    //! Order (number of nodes) of the tree.
+    int order;
+
+    //! Density of the tree.
+    double density;
+};
+
+//! Function to recursively add all trees with a root of given order, attaching subtrees with a given total order.
+void addRootedTrees( std::vector< RootedTree >& rootedTrees,
+                     std::vector< int >& currentSubtreeIndices,
+                     const int treeOrder,
+                     const int minimumSubtreeIndex,
+                     const int maximumSubtreeIndex,
+                     const int remainingOrder )
+{
+    if( remainingOrder == 0 )
+    {
+        RootedTree tree;
+        tree.subtreeIndices = currentSubtreeIndices;
+        tree.order = treeOrder;
+        tree.density = static_cast< double >( treeOrder );
+        for( unsigned int i = 0; i < currentSubtreeIndices.size( ); i++ )
+        {
+            tree.density *= rootedTrees.at( currentSubtreeIndices.at( i ) ).density;
+        }
+        rootedTrees.push_back( tree );
+    }
+    else
+    {
+        for( int i = minimumSubtreeIndex; i < maximumSubtreeIndex; i++ )
+        {
+            if( rootedTrees.at( i ).order <= remainingOrder )
+            {
+                currentSubtreeIndices.push_back( i );
+                addRootedTrees( rootedTrees, currentSubtreeIndices, treeOrder, i, maximumSubtreeIndex,
+                                remainingOrder - rootedTrees.at( i ).order );
+                currentSubtreeIndices.pop_back( );
+            }
+        }
+    }
+}
+
+//! Function to generate all rooted trees up to a given order, sorted by order.
+std::vector< RootedTree > generateRootedTrees( const int maximumOrder )
+{
+    std::vector< RootedTree > rootedTrees;
+    rootedTrees.push_back( RootedTree{ std::vector< int >( ), 1, 1.0 } );
+
+    std::vector< int > currentSubtreeIndices;
+    for( int order = 2; order <= maximumOrder; order++ )
+    {
+        // Subtrees are taken from trees of lower order only
+        addRootedTrees( rootedTrees, currentSubtreeIndices, order, 0, rootedTrees.size( ), order - 1 );
+    }
+    return rootedTrees;
+}
+
+//! Function to compute the coefficients of a continuous extension, from the full (square) Butcher tableau of the stages.
+Eigen::MatrixXd computeContinuousExtensionCoefficientsFromTableau(
+        const Eigen::MatrixXd& aCoefficients,
+        const Eigen::VectorXd& integratedWeights,
+        const int maximumOrderToAttempt,
+        const std::string& methodName,
+        int& continuousExtensionOrder )
+{
+    const int numberOfStages = aCoefficients.rows( );
+
+    // Compute elementary weights of each tree, for each stage
+    std::vector< RootedTree > rootedTrees = generateRootedTrees( maximumOrderToAttempt );
+    std::vector< Eigen::VectorXd > elementaryWeights;
+    for( unsigned int i = 0; i < rootedTrees.size( ); i++ )
+    {
+        Eigen::VectorXd currentWeights = Eigen::VectorXd::Ones( numberOfStages );
+        for( unsigned int j = 0; j < rootedTrees.at( i ).subtreeIndices.size( ); j++ )
+        {
+            currentWeights = currentWeights.cwiseProduct(
+                        aCoefficients * elementaryWeights.at( rootedTrees.at( i ).subtreeIndices.at( j ) ) );
+        }
+        elementaryWeights.push_back( currentWeights );
+    }
+
+    // Increase order until order conditions can no longer be satisfied
+    Eigen::MatrixXd continuousExtensionCoefficients;
+    continuousExtensionOrder = 0;
+    int numberOfTrees = 0;
+    for( int order = 1; order <= maximumOrderToAttempt; order++ )
+    {
+        while( numberOfTrees < static_cast< int >( rootedTrees.size( ) ) &&
+               rootedTrees.at( numberOfTrees ).order <= order )
+        {
+            numberOfTrees++;
+        }
+
+        // Attempt solution with polynomial degree of up to two higher than the order
+        bool solutionFound = false;
+        for( int degree = order; degree <= order + 2 && !solutionFound; degree++ )
+        {
+            // Set up order conditions (per tree and power of theta), and continuity conditions (per stage). Unknown i * degree + j
+            // is the coefficient of theta^( j + 1 ) in b_i( theta ).
+            Eigen::MatrixXd conditionMatrix = Eigen::MatrixXd::Zero(
+                        numberOfTrees * degree + numberOfStages, numberOfStages * degree );
+            Eigen::VectorXd conditionValues = Eigen::VectorXd::Zero( numberOfTrees * degree + numberOfStages );
+            for( int i = 0; i < numberOfTrees; i++ )
+            {
+                for( int j = 0; j < degree; j++ )
+                {
+                    for( int k = 0; k < numberOfStages; k++ )
+                    {
+                        conditionMatrix( i * degree + j, k * degree + j ) = elementaryWeights.at( i )( k );
+                    }
+                    if( j + 1 == rootedTrees.at( i ).order )
+                    {
+                        conditionValues( i * degree + j ) = 1.0 / rootedTrees.at( i ).density;
+                    }
+                }
+            }
+            for( int k = 0; k < numberOfStages; k++ )
+            {
+                conditionMatrix.block( numberOfTrees * degree + k, k * degree, 1, degree ).setOnes( );
+                conditionValues( numberOfTrees * degree + k ) = integratedWeights( k );
+            }
+
+            // Compute minimum-norm solution, and check whether conditions are satisfied
+            Eigen::VectorXd solution = conditionMatrix.completeOrthogonalDecomposition( ).solve( conditionValues );
+            if( ( conditionMatrix * solution - conditionValues ).norm( ) < 1.0E-10 )
+            {
+                solutionFound = true;
+                continuousExtensionOrder = order;
+                continuousExtensionCoefficients = Eigen::MatrixXd::Zero( numberOfStages, degree );
+                for( int k = 0; k < numberOfStages; k++ )
+                {
+                    continuousExtensionCoefficients.row( k ) = solution.segment( k * degree, degree ).transpose( );
+                }
+
+                // Remove round-off error in continuity conditions, so that the extension is continuous to machine precision
+                continuousExtensionCoefficients.col( degree - 1 ) +=
+                        integratedWeights - continuousExtensionCoefficients.rowwise( ).sum( );
+            }
+        }
+
+        if( !solutionFound )
+        {
+            break;
+        }
+    }
+
+    if( continuousExtensionOrder == 0 )
+    {
+        throw std::runtime_error( "Error when computing Runge-Kutta continuous extension for " + methodName +
+                                  ", no consistent solution found" );
+    }
+
+    return continuousExtensionCoefficients;
+}
+
+//! Function to retrieve the full (square) Butcher tableau, weights of the integrated estimate, and its order.
+void getIntegratedRungeKuttaTableau(
+        const RungeKuttaCoefficients& coefficients,
+        Eigen::MatrixXd& aCoefficients,
+        Eigen::VectorXd& integratedWeights,
+        int& integratedOrder )
+{
+    const int numberOfStages = coefficients.cCoefficients.rows( );
+    if( numberOfStages == 0 )
+    {
+        throw std::runtime_error( "Error when computing Runge-Kutta continuous extension, no stages defined" );
+    }
+
+    aCoefficients = Eigen::MatrixXd::Zero( numberOfStages, numberOfStages );
+    aCoefficients.block( 0, 0, coefficients.aCoefficients.rows( ), coefficients.aCoefficients.cols( ) ) =
+            coefficients.aCoefficients;
+    integratedWeights = coefficients.bCoefficients.row(
+                std::min( static_cast< int >( coefficients.orderEstimateToIntegrate ),
+                          static_cast< int >( coefficients.bCoefficients.rows( ) ) - 1 ) ).transpose( );
+    integratedOrder = ( coefficients.orderEstimateToIntegrate == RungeKuttaCoefficients::lower ) ?
+                coefficients.lowerOrder : coefficients.higherOrder;
+}
+
+//! Function to compute the coefficients of a continuous extension of an explicit Runge-Kutta method.
+Eigen::MatrixXd computeRungeKuttaContinuousExtensionCoefficients(
+        const RungeKuttaCoefficients& coefficients,
+        int& continuousExtensionOrder,
+        const int maximumOrder )
+{
+    Eigen::MatrixXd additionalStageCoefficients;
+    return computeRungeKuttaContinuousExtensionCoefficients(
+                coefficients, Eigen::VectorXd::Zero( 0 ), additionalStageCoefficients, continuousExtensionOrder,
+                maximumOrder );
+}
+
+//! Function to compute the coefficients of a continuous extension of an explicit Runge-Kutta method, with additional stages.
+Eigen::MatrixXd computeRungeKuttaContinuousExtensionCoefficients(
+        const RungeKuttaCoefficients& coefficients,
+        const Eigen::VectorXd& additionalStageNodes,
+        Eigen::MatrixXd& additionalStageCoefficients,
+        int& continuousExtensionOrder,
+        const int maximumOrder )
+{
+    Eigen::MatrixXd aCoefficients;
+    Eigen::VectorXd integratedWeights;
+    int integratedOrder;
+    getIntegratedRungeKuttaTableau( coefficients, aCoefficients, integratedWeights, integratedOrder );
+    const int maximumOrderToAttempt = ( integratedOrder > 0 ) ? std::min( integratedOrder, maximumOrder ) : maximumOrder;
+
+    // Compute continuous extension from stages of method
+    Eigen::MatrixXd continuousExtensionCoefficients = computeContinuousExtensionCoefficientsFromTableau(
+                aCoefficients, integratedWeights, maximumOrderToAttempt, coefficients.name, continuousExtensionOrder );
+
+    // Add stages one at a time, evaluated at the state given by the current continuous extension, and recompute extension
+    const int numberOfStages = aCoefficients.rows( );
+    const int numberOfAdditionalStages = additionalStageNodes.rows( );
+    additionalStageCoefficients = Eigen::MatrixXd::Zero( numberOfAdditionalStages, numberOfStages + numberOfAdditionalStages );
+    for( int i = 0; i < numberOfAdditionalStages; i++ )
+    {
+        const int currentNumberOfStages = numberOfStages + i;
+        if( additionalStageNodes( i ) == 1.0 )
+        {
+            additionalStageCoefficients.block( i, 0, 1, currentNumberOfStages ) = integratedWeights.transpose( );
+        }
+        else
+        {
+            for( int j = 0; j < continuousExtensionCoefficients.cols( ); j++ )
+            {
+                additionalStageCoefficients.block( i, 0, 1, currentNumberOfStages ) +=
+                        std::pow( additionalStageNodes( i ), j + 1 ) * continuousExtensionCoefficients.col( j ).transpose( );
+            }
+        }
+
+        Eigen::MatrixXd extendedACoefficients = Eigen::MatrixXd::Zero( currentNumberOfStages + 1, currentNumberOfStages + 1 );
+        extendedACoefficients.block( 0, 0, currentNumberOfStages, currentNumberOfStages ) = aCoefficients;
+        extendedACoefficients.block( currentNumberOfStages, 0, 1, currentNumberOfStages ) =
+                additionalStageCoefficients.block( i, 0, 1, currentNumberOfStages );
+        aCoefficients = extendedACoefficients;
+        integratedWeights.conservativeResize( currentNumberOfStages + 1 );
+        integratedWeights( currentNumberOfStages ) = 0.0;
+
+        continuousExtensionCoefficients = computeContinuousExtensionCoefficientsFromTableau(
+                    aCoefficients, integratedWeights, maximumOrderToAttempt, coefficients.name, continuousExtensionOrder );
+    }
+
+    return continuousExtensionCoefficients;
+}
+
+//! Function to retrieve the nodes of the additional stages used for the continuous extension of a Runge-Kutta method.
+Eigen::VectorXd getRungeKuttaContinuousExtensionAdditionalStageNodes( const RungeKuttaCoefficients& coefficients )
+{
+    // For RKDP8(7), use the nodes of the additional stages of DOP853, preceded by the integrated state at the end of the
+    // step. As the tableau of RKDP8(7) differs from that of DOP853, an additional stage at the mid-point is required to
+    // obtain a continuous extension of order 7.
+    if( coefficients.name == RungeKuttaCoefficients::get( rungeKutta87DormandPrince ).name )
+    {
+        return ( Eigen::VectorXd( 5 ) << 1.0, 0.1, 0.2, 7.0 / 9.0, 0.5 ).finished( );
+    }
+    else
+    {
+        return Eigen::VectorXd::Zero( 0 );
+    }
+}
+
+template class RungeKuttaDenseOutput< double, Eigen::VectorXd, double >;
+template class RungeKuttaDenseOutput< double, Eigen::Vector6d, double >;
+template class RungeKuttaDenseOutput< double, Eigen::MatrixXd, double >;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
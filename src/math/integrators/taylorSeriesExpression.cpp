@@ -0,0 +1,416 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "tudat/math/integrators/taylorSeriesExpression.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Function to retrieve the expression in which two variables are recorded, checking consistency.
+TaylorSeriesExpression* getCommonExpression( const TaylorSeriesVariable& firstVariable,
+                                             const TaylorSeriesVariable& secondVariable )
+{
+    if( !firstVariable.isConstant( ) && !secondVariable.isConstant( ) &&
+            firstVariable.getExpression( ) != secondVariable.getExpression( ) )
+    {
+        throw std::runtime_error( "Error in Taylor series expression, variables are recorded in different expressions" );
+    }
+    return firstVariable.isConstant( ) ? secondVariable.getExpression( ) : firstVariable.getExpression( );
+}
+
+TaylorSeriesVariable operator+( const TaylorSeriesVariable& firstVariable, const TaylorSeriesVariable& secondVariable )
+{
+    TaylorSeriesExpression* expression = getCommonExpression( firstVariable, secondVariable );
+    if( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( ) + secondVariable.getConstantValue( ) );
+    }
+    else if( firstVariable.isConstant( ) )
+    {
+        return ( firstVariable.getConstantValue( ) == 0.0 ) ? secondVariable :
+                    expression->addOperation( taylor_series_scalar_addition, secondVariable.getOperationIndex( ), -1,
+                                              firstVariable.getConstantValue( ) );
+    }
+    else if( secondVariable.isConstant( ) )
+    {
+        return ( secondVariable.getConstantValue( ) == 0.0 ) ? firstVariable :
+                    expression->addOperation( taylor_series_scalar_addition, firstVariable.getOperationIndex( ), -1,
+                                              secondVariable.getConstantValue( ) );
+    }
+    return expression->addOperation( taylor_series_addition, firstVariable.getOperationIndex( ),
+                                     secondVariable.getOperationIndex( ) );
+}
+
+TaylorSeriesVariable operator-( const TaylorSeriesVariable& firstVariable, const TaylorSeriesVariable& secondVariable )
+{
+    TaylorSeriesExpression* expression = getCommonExpression( firstVariable, secondVariable );
+    if( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( ) - secondVariable.getConstantValue( ) );
+    }
+    else if( firstVariable.isConstant( ) )
+    {
+        return firstVariable + ( -secondVariable );
+    }
+    else if( secondVariable.isConstant( ) )
+    {
+        return ( secondVariable.getConstantValue( ) == 0.0 ) ? firstVariable :
+                    expression->addOperation( taylor_series_scalar_addition, firstVariable.getOperationIndex( ), -1,
+                                              -secondVariable.getConstantValue( ) );
+    }
+    return expression->addOperation( taylor_series_subtraction, firstVariable.getOperationIndex( ),
+                                     secondVariable.getOperationIndex( ) );
+}
+
+TaylorSeriesVariable operator*( const TaylorSeriesVariable& firstVariable, const TaylorSeriesVariable& secondVariable )
+{
+    TaylorSeriesExpression* expression = getCommonExpression( firstVariable, secondVariable );
+    if( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( ) * secondVariable.getConstantValue( ) );
+    }
+    else if( firstVariable.isConstant( ) || secondVariable.isConstant( ) )
+    {
+        // Fold multiplication by zero or one
+        const TaylorSeriesVariable& constantVariable = firstVariable.isConstant( ) ? firstVariable : secondVariable;
+        const TaylorSeriesVariable& variable = firstVariable.isConstant( ) ? secondVariable : firstVariable;
+        if( constantVariable.getConstantValue( ) == 0.0 )
+        {
+            return TaylorSeriesVariable( 0.0 );
+        }
+        else if( constantVariable.getConstantValue( ) == 1.0 )
+        {
+            return variable;
+        }
+        return expression->addOperation( taylor_series_scalar_multiplication, variable.getOperationIndex( ), -1,
+                                         constantVariable.getConstantValue( ) );
+    }
+    return expression->addOperation( taylor_series_multiplication, firstVariable.getOperationIndex( ),
+                                     secondVariable.getOperationIndex( ) );
+}
+
+TaylorSeriesVariable operator/( const TaylorSeriesVariable& firstVariable, const TaylorSeriesVariable& secondVariable )
+{
+    TaylorSeriesExpression* expression = getCommonExpression( firstVariable, secondVariable );
+    if( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( ) / secondVariable.getConstantValue( ) );
+    }
+    else if( firstVariable.isConstant( ) )
+    {
+        return firstVariable * pow( secondVariable, -1.0 );
+    }
+    else if( secondVariable.isConstant( ) )
+    {
+        return expression->addOperation( taylor_series_scalar_multiplication, firstVariable.getOperationIndex( ), -1,
+                                         1.0 / secondVariable.getConstantValue( ) );
+    }
+    return expression->addOperation( taylor_series_division, firstVariable.getOperationIndex( ),
+                                     secondVariable.getOperationIndex( ) );
+}
+
+TaylorSeriesVariable operator-( const TaylorSeriesVariable& variable )
+{
+    if( variable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( -variable.getConstantValue( ) );
+    }
+    return variable.getExpression( )->addOperation( taylor_series_negation, variable.getOperationIndex( ) );
+}
+
+TaylorSeriesVariable sqrt( const TaylorSeriesVariable& variable )
+{
+    if( variable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( std::sqrt( variable.getConstantValue( ) ) );
+    }
+    return variable.getExpression( )->addOperation( taylor_series_square_root, variable.getOperationIndex( ) );
+}
+
+TaylorSeriesVariable pow( const TaylorSeriesVariable& variable, const double exponent )
+{
+    if( variable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( std::pow( variable.getConstantValue( ), exponent ) );
+    }
+    return variable.getExpression( )->addOperation( taylor_series_power, variable.getOperationIndex( ), -1, exponent );
+}
+
+TaylorSeriesVariable& TaylorSeriesVariable::operator+=( const TaylorSeriesVariable& variable )
+{
+    *this = *this + variable;
+    return *this;
+}
+
+TaylorSeriesVariable& TaylorSeriesVariable::operator-=( const TaylorSeriesVariable& variable )
+{
+    *this = *this - variable;
+    return *this;
+}
+
+TaylorSeriesVariable& TaylorSeriesVariable::operator*=( const TaylorSeriesVariable& variable )
+{
+    *this = *this * variable;
+    return *this;
+}
+
+TaylorSeriesVariable& TaylorSeriesVariable::operator/=( const TaylorSeriesVariable& variable )
+{
+    *this = *this / variable;
+    return *this;
+}
+
+//! Constructor.
+TaylorSeriesExpression::TaylorSeriesExpression( const int numberOfStateEntries ):
+    numberOfStateEntries_( numberOfStateEntries )
+{
+    if( numberOfStateEntries < 1 )
+    {
+        throw std::runtime_error( "Error when creating Taylor series expression, state must have at least one entry" );
+    }
+
+    operations_.push_back( TaylorSeriesOperation{ taylor_series_independent_variable, -1, -1, 0.0 } );
+    for( int i = 0; i < numberOfStateEntries_; i++ )
+    {
+        operations_.push_back( TaylorSeriesOperation{ taylor_series_state_variable, -1, -1, 0.0 } );
+    }
+}
+
+//! Function to retrieve the variables representing the entries of the state.
+std::vector< TaylorSeriesVariable > TaylorSeriesExpression::getStateVariables( )
+{
+    std::vector< TaylorSeriesVariable > stateVariables;
+    for( int i = 0; i < numberOfStateEntries_; i++ )
+    {
+        stateVariables.push_back( TaylorSeriesVariable( this, i + 1 ) );
+    }
+    return stateVariables;
+}
+
+//! Function to record an operation.
+TaylorSeriesVariable TaylorSeriesExpression::addOperation( const TaylorSeriesOperationTypes operationType,
+                                                           const int firstArgument,
+                                                           const int secondArgument,
+                                                           const double scalar )
+{
+    operations_.push_back( TaylorSeriesOperation{ operationType, firstArgument, secondArgument, scalar } );
+    return TaylorSeriesVariable( this, static_cast< int >( operations_.size( ) ) - 1 );
+}
+
+//! Function to set the variables representing the entries of the state derivative.
+void TaylorSeriesExpression::setStateDerivative( const std::vector< TaylorSeriesVariable >& stateDerivative )
+{
+    if( static_cast< int >( stateDerivative.size( ) ) != numberOfStateEntries_ )
+    {
+        throw std::runtime_error( "Error in Taylor series expression, state derivative size (" +
+                                  std::to_string( stateDerivative.size( ) ) + ") is inconsistent with state size (" +
+                                  std::to_string( numberOfStateEntries_ ) + ")" );
+    }
+
+    stateDerivativeIndices_.clear( );
+    for( int i = 0; i < numberOfStateEntries_; i++ )
+    {
+        if( stateDerivative.at( i ).isConstant( ) )
+        {
+            stateDerivativeIndices_.push_back(
+                        addOperation( taylor_series_constant, -1, -1, stateDerivative.at( i ).getConstantValue( ) ).
+                        getOperationIndex( ) );
+        }
+        else if( stateDerivative.at( i ).getExpression( ) != this )
+        {
+            throw std::runtime_error( "Error in Taylor series expression, state derivative is recorded in different expression" );
+        }
+        else
+        {
+            stateDerivativeIndices_.push_back( stateDerivative.at( i ).getOperationIndex( ) );
+        }
+    }
+}
+
+//! Function to compute the Taylor coefficient of given order of all operations (other than state entries).
+void TaylorSeriesExpression::computeOperationCoefficients( const int k )
+{
+    double* coefficients = operationCoefficients_.data( );
+    const int stride = static_cast< int >( operationCoefficients_.rows( ) );
+
+    for( unsigned int i = numberOfStateEntries_ + 1; i < operations_.size( ); i++ )
+    {
+        const TaylorSeriesOperation& operation = operations_[ i ];
+        double* result = coefficients + i * stride;
+        const double* first = ( operation.firstArgument >= 0 ) ? coefficients + operation.firstArgument * stride : nullptr;
+        const double* second = ( operation.secondArgument >= 0 ) ? coefficients + operation.secondArgument * stride : nullptr;
+
+        switch( operation.operationType )
+        {
+        case taylor_series_constant:
+            result[ k ] = ( k == 0 ) ? operation.scalar : 0.0;
+            break;
+        case taylor_series_addition:
+            result[ k ] = first[ k ] + second[ k ];
+            break;
+        case taylor_series_subtraction:
+            result[ k ] = first[ k ] - second[ k ];
+            break;
+        case taylor_series_negation:
+            result[ k ] = -first[ k ];
+            break;
+        case taylor_series_scalar_addition:
+            result[ k ] = ( k == 0 ) ? first[ k ] + operation.scalar : first[ k ];
+            break;
+        case taylor_series_scalar_multiplication:
+            result[ k ] = operation.scalar * first[ k ];
+            break;
+        case taylor_series_multiplication:
+        {
+            // c_k = sum_{j=0}^{k} a_j b_{k-j}
+            double sum = 0.0;
+            for( int j = 0; j <= k; j++ )
+            {
+                sum += first[ j ] * second[ k - j ];
+            }
+            result[ k ] = sum;
+            break;
+        }
+        case taylor_series_division:
+        {
+            // c_k = ( a_k - sum_{j=1}^{k} b_j c_{k-j} ) / b_0
+            double sum = first[ k ];
+            for( int j = 1; j <= k; j++ )
+            {
+                sum -= second[ j ] * result[ k - j ];
+            }
+            result[ k ] = sum / second[ 0 ];
+            break;
+        }
+        case taylor_series_square_root:
+        {
+            // c_k = ( a_k - sum_{j=1}^{k-1} c_j c_{k-j} ) / ( 2 c_0 )
+            if( k == 0 )
+            {
+                result[ 0 ] = std::sqrt( first[ 0 ] );
+            }
+            else
+            {
+                double sum = first[ k ];
+                for( int j = 1; j < k; j++ )
+                {
+                    sum -= result[ j ] * result[ k - j ];
+                }
+                result[ k ] = sum / ( 2.0 * result[ 0 ] );
+            }
+            break;
+        }
+        case taylor_series_power:
+        {
+            // c_k = sum_{j=0}^{k-1} ( p ( k - j ) - j ) a_{k-j} c_j / ( k a_0 )
+            if( k == 0 )
+            {
+                result[ 0 ] = std::pow( first[ 0 ], operation.scalar );
+            }
+            else
+            {
+                double sum = 0.0;
+                for( int j = 0; j < k; j++ )
+                {
+                    sum += ( operation.scalar * static_cast< double >( k - j ) - static_cast< double >( j ) ) *
+                            first[ k - j ] * result[ j ];
+                }
+                result[ k ] = sum / ( static_cast< double >( k ) * first[ 0 ] );
+            }
+            break;
+        }
+        default:
+            throw std::runtime_error( "Error in Taylor series expression, operation type " +
+                                      std::to_string( operation.operationType ) + " not supported at index " +
+                                      std::to_string( i ) );
+        }
+    }
+}
+
+//! Function to compute the Taylor coefficients of the solution through a given state, up to a given order.
+void TaylorSeriesExpression::computeTaylorCoefficients( const double independentVariable,
+                                                        const Eigen::VectorXd& state,
+                                                        const int order,
+                                                        Eigen::MatrixXd& taylorCoefficients )
+{
+    if( static_cast< int >( stateDerivativeIndices_.size( ) ) != numberOfStateEntries_ )
+    {
+        throw std::runtime_error( "Error in Taylor series expression, state derivative has not been set" );
+    }
+    else if( state.rows( ) != numberOfStateEntries_ )
+    {
+        throw std::runtime_error( "Error in Taylor series expression, state size (" + std::to_string( state.rows( ) ) +
+                                  ") is inconsistent with expression (" + std::to_string( numberOfStateEntries_ ) + ")" );
+    }
+
+    if( operationCoefficients_.rows( ) < order + 1 || operationCoefficients_.cols( ) != getNumberOfOperations( ) )
+    {
+        operationCoefficients_.resize( order + 1, getNumberOfOperations( ) );
+    }
+    taylorCoefficients.resize( numberOfStateEntries_, order + 1 );
+
+    // Set independent variable and state
+    operationCoefficients_.col( 0 ).setZero( );
+    operationCoefficients_( 0, 0 ) = independentVariable;
+    if( order > 0 )
+    {
+        operationCoefficients_( 1, 0 ) = 1.0;
+    }
+    for( int i = 0; i < numberOfStateEntries_; i++ )
+    {
+        operationCoefficients_( 0, i + 1 ) = state( i );
+    }
+
+    // Compute coefficient of each order of the state derivative, and the next-order coefficient of the state from it
+    for( int k = 0; k < order; k++ )
+    {
+        computeOperationCoefficients( k );
+        for( int i = 0; i < numberOfStateEntries_; i++ )
+        {
+            operationCoefficients_( k + 1, i + 1 ) =
+                    operationCoefficients_( k, stateDerivativeIndices_[ i ] ) / static_cast< double >( k + 1 );
+        }
+    }
+
+    taylorCoefficients = operationCoefficients_.block( 0, 1, order + 1, numberOfStateEntries_ ).transpose( );
+}
+
+//! Function to compute the state derivative from the recorded function.
+Eigen::VectorXd TaylorSeriesExpression::computeStateDerivative( const double independentVariable,
+                                                                const Eigen::VectorXd& state )
+{
+    Eigen::MatrixXd taylorCoefficients;
+    computeTaylorCoefficients( independentVariable, state, 1, taylorCoefficients );
+    return taylorCoefficients.col( 1 );
+}
+
+//! Function to record a state derivative function as an expression for Taylor series generation.
+std::shared_ptr< TaylorSeriesExpression > createTaylorSeriesExpression(
+        const int numberOfStateEntries,
+        const std::function< std::vector< TaylorSeriesVariable >(
+            const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& ) >& stateDerivativeFunction )
+{
+    std::shared_ptr< TaylorSeriesExpression > expression = std::make_shared< TaylorSeriesExpression >( numberOfStateEntries );
+    expression->setStateDerivative(
+                stateDerivativeFunction( expression->getIndependentVariable( ), expression->getStateVariables( ) ) );
+    return expression;
+}
+
+} // namespace numerical_integrators
+
+} // namespace tudat
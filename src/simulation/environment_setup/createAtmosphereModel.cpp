@@ -202,8 +202,14 @@ std::shared_ptr< aerodynamics::AtmosphereModel > createAtmosphereModel(
                 tudat::input_output::solar_activity::readSolarActivityData( spaceWeatherFilePath ) ;
 
         // Create atmosphere model using NRLMISE00 input function
-        atmosphereModel = std::make_shared< aerodynamics::NRLMSISE00Atmosphere >(
-                    solarActivityData, true );
+        std::shared_ptr< aerodynamics::NRLMSISE00Atmosphere > nrlmsise00Atmosphere =
+                std::make_shared< aerodynamics::NRLMSISE00Atmosphere >( solarActivityData, true );
+        if( nrlmsise00AtmosphereSettings != nullptr )
+        {
+            nrlmsise00Atmosphere->setDensityInterpolation(
+                        nrlmsise00AtmosphereSettings->getDensityInterpolationTolerance( ) );
+        }
+        atmosphereModel = nrlmsise00Atmosphere;
         break;
     }
 #endif
@@ -98,11 +98,16 @@ std::shared_ptr< basic_astrodynamics::BodyShapeModel > createBodyShapeModel(
         else
         {
             // Creat polyhedron shape model
-            shapeModel = std::make_shared< PolyhedronBodyShapeModel >(
+            std::shared_ptr< PolyhedronBodyShapeModel > polyhedronShapeModel = std::make_shared< PolyhedronBodyShapeModel >(
                         polyhedronShapeSettings->getVerticesCoordinates(),
                         polyhedronShapeSettings->getVerticesDefiningEachFacet(),
                         polyhedronShapeSettings->getComputeAltitudeWithSign(),
                         polyhedronShapeSettings->getJustComputeDistanceToVertices() );
+            if( polyhedronShapeSettings->getUseFacetTree( ) )
+            {
+                polyhedronShapeModel->setFacetTree( );
+            }
+            shapeModel = polyhedronShapeModel;
         }
         break;
     }
@@ -456,6 +456,17 @@ std::shared_ptr< gravitation::GravityFieldModel > createGravityFieldModel(
                     polyhedronFieldSettings->getVerticesDefiningEachFacet(),
                     associatedReferenceFrame,
                     inertiaTensorUpdateFunction );
+
+            if( polyhedronFieldSettings->getUseFacetTree( ) )
+            {
+                std::dynamic_pointer_cast< PolyhedronGravityField >( gravityFieldModel )->setFacetTreeEvaluation(
+                            polyhedronFieldSettings->getMaximumRelativeTruncationError( ) );
+            }
+            if( polyhedronFieldSettings->getNumberOfThreads( ) > 1 )
+            {
+                std::dynamic_pointer_cast< PolyhedronGravityField >( gravityFieldModel )->setNumberOfThreads(
+                            polyhedronFieldSettings->getNumberOfThreads( ) );
+            }
         }
         break;
     }
@@ -283,8 +283,7 @@ std::vector< double > ProcessedOdfFileContents::computeObservationTimesTdbFromJ2
             std::string groundStation,
             std::vector< double > observationTimesUtcFromEME1950 )
     {
-        earth_orientation::TerrestrialTimeScaleConverter timeScaleConverter =
-                earth_orientation::TerrestrialTimeScaleConverter( );
+        earth_orientation::TerrestrialTimeScaleConverter timeScaleConverter;
 
         std::vector< double > observationTimesUtcFromJ2000 = computeObservationTimesUtcFromJ2000( observationTimesUtcFromEME1950 );
 
@@ -116,7 +116,7 @@ void ProcessedTrackingTxtFileContents::updateObservationTimes()
 std::vector<double> ProcessedTrackingTxtFileContents::computeObservationTimesTdbFromJ2000(std::vector<double> observationTimesUtc)
 {
   // Get the time scale converter
-  earth_orientation::TerrestrialTimeScaleConverter timeScaleConverter = earth_orientation::TerrestrialTimeScaleConverter();
+  earth_orientation::TerrestrialTimeScaleConverter timeScaleConverter;
 
   // Check if there is one LinkEnds per observation time
   if (linkEndsVector_.size() != observationTimesUtc.size()) {
@@ -669,6 +669,18 @@ createPolyhedronGravityAcceleration(
                         std::bind( &Body::getCurrentRotationToGlobalFrame, bodyExertingAcceleration ),
                         useCentralBodyFixedFrame );
 
+        // Use the facet tree of the gravity field, if it has been created
+        if( polyhedronGravityField->getFacetTree( ) != nullptr )
+        {
+            accelerationModel->setFacetTree( polyhedronGravityField->getFacetTree( ),
+                                             polyhedronGravityField->getMaximumRelativeTruncationError( ) );
+        }
+
+        // Distribute the exact facet and edge sums over the threads of the gravity field, if any. The pool is shared by all
+        // polyhedron accelerations exerted by this body; if these are updated concurrently, the pool is used by one of them
+        // at a time, while the others compute their sums serially.
+        accelerationModel->getPolyhedronCache( )->setThreadPool( polyhedronGravityField->getThreadPool( ) );
+
     }
     return accelerationModel;
 }
@@ -16,6 +16,24 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to create a Lagrange interpolator (order 6) for a state history given as separate vectors of epochs and states.
+template< typename TimeType, typename StateType, typename TimeScalarType >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< TimeType, StateType > > createStateHistoryInterpolator(
+        const std::vector< TimeType >& times,
+        const std::vector< StateType >& states )
+{
+    if( times.size( ) < 6 )
+    {
+        throw std::runtime_error( "Error when creating Lagrange interpolator, input is of size " +
+                                  std::to_string( times.size( ) ) +
+                                  ". This is smaller than the number of points needed for interpolator, which is 6" );
+    }
+
+    return std::make_shared< interpolators::LagrangeInterpolator< TimeType, StateType, TimeScalarType > >(
+                times, states, 6, interpolators::huntingAlgorithm, interpolators::lagrange_cubic_spline_boundary_interpolation,
+                interpolators::throw_exception_at_boundary );
+}
+
 
 //! Function to create an interpolator for the new translational state of a body.
 template< >
@@ -65,6 +83,38 @@ createStateInterpolator( const std::map< Time, Eigen::Matrix< double, 6, 1 > >&
 }
 
 
+//! Function to create an interpolator for the new translational state of a body.
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Matrix< double, 6, 1 > > >
+createStateInterpolator( const std::vector< double >& times, const std::vector< Eigen::Matrix< double, 6, 1 > >& states )
+{
+    return createStateHistoryInterpolator< double, Eigen::Matrix< double, 6, 1 >, double >( times, states );
+}
+
+//! Function to create an interpolator for the new translational state of a body.
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Matrix< long double, 6, 1 > > >
+createStateInterpolator( const std::vector< double >& times, const std::vector< Eigen::Matrix< long double, 6, 1 > >& states )
+{
+    return createStateHistoryInterpolator< double, Eigen::Matrix< long double, 6, 1 >, double >( times, states );
+}
+
+//! Function to create an interpolator for the new translational state of a body.
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< Time, Eigen::Matrix< long double, 6, 1 > > >
+createStateInterpolator( const std::vector< Time >& times, const std::vector< Eigen::Matrix< long double, 6, 1 > >& states )
+{
+    return createStateHistoryInterpolator< Time, Eigen::Matrix< long double, 6, 1 >, long double >( times, states );
+}
+
+//! Function to create an interpolator for the new translational state of a body.
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< Time, Eigen::Matrix< double, 6, 1 > > >
+createStateInterpolator( const std::vector< Time >& times, const std::vector< Eigen::Matrix< double, 6, 1 > >& states )
+{
+    return createStateHistoryInterpolator< Time, Eigen::Matrix< double, 6, 1 >, long double >( times, states );
+}
+
 template< >
 std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Matrix< double, 7, 1 > > >
 createRotationalStateInterpolator( const std::map< double, Eigen::Matrix< double, 7, 1 > >& stateMap )
@@ -101,6 +151,34 @@ createRotationalStateInterpolator( const std::map< Time, Eigen::Matrix< long dou
                 interpolators::throw_exception_at_boundary );
 }
 
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Matrix< double, 7, 1 > > >
+createRotationalStateInterpolator( const std::vector< double >& times, const std::vector< Eigen::Matrix< double, 7, 1 > >& states )
+{
+    return createStateHistoryInterpolator< double, Eigen::Matrix< double, 7, 1 >, double >( times, states );
+}
+
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Matrix< long double, 7, 1 > > >
+createRotationalStateInterpolator( const std::vector< double >& times, const std::vector< Eigen::Matrix< long double, 7, 1 > >& states )
+{
+    return createStateHistoryInterpolator< double, Eigen::Matrix< long double, 7, 1 >, double >( times, states );
+}
+
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< Time, Eigen::Matrix< double, 7, 1 > > >
+createRotationalStateInterpolator( const std::vector< Time >& times, const std::vector< Eigen::Matrix< double, 7, 1 > >& states )
+{
+    return createStateHistoryInterpolator< Time, Eigen::Matrix< double, 7, 1 >, long double >( times, states );
+}
+
+template< >
+std::shared_ptr< interpolators::OneDimensionalInterpolator< Time, Eigen::Matrix< long double, 7, 1 > > >
+createRotationalStateInterpolator( const std::vector< Time >& times, const std::vector< Eigen::Matrix< long double, 7, 1 > >& states )
+{
+    return createStateHistoryInterpolator< Time, Eigen::Matrix< long double, 7, 1 >, long double >( times, states );
+}
+
 } // namespace propagators
 
 } // namespace tudat
@@ -0,0 +1,64 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *     This file replaces the C allocation functions (through which both operator new and Eigen allocate) by versions
+ *     that count the number of heap allocations. It defines these functions, and may therefore only be included in a
+ *     single source file of a test executable. Counting is only supported for the GNU C library, for which the macro
+ *     TUDAT_COUNT_HEAP_ALLOCATIONS is defined; checks on the number of allocations should be guarded by this macro.
+ *
+ */
+
+#ifndef TUDAT_HEAP_ALLOCATION_COUNTER_H
+#define TUDAT_HEAP_ALLOCATION_COUNTER_H
+
+#include <cstdlib>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Number of heap allocations since start of program (only counted if TUDAT_COUNT_HEAP_ALLOCATIONS is defined).
+static unsigned long long numberOfHeapAllocations = 0;
+
+} // namespace unit_tests
+} // namespace tudat
+
+#if defined( __GLIBC__ )
+#define TUDAT_COUNT_HEAP_ALLOCATIONS
+extern "C"
+{
+
+void* __libc_malloc( std::size_t size );
+void* __libc_calloc( std::size_t numberOfElements, std::size_t size );
+void* __libc_realloc( void* pointer, std::size_t size );
+
+void* malloc( std::size_t size )
+{
+    tudat::unit_tests::numberOfHeapAllocations++;
+    return __libc_malloc( size );
+}
+
+void* calloc( std::size_t numberOfElements, std::size_t size )
+{
+    tudat::unit_tests::numberOfHeapAllocations++;
+    return __libc_calloc( numberOfElements, size );
+}
+
+void* realloc( void* pointer, std::size_t size )
+{
+    tudat::unit_tests::numberOfHeapAllocations++;
+    return __libc_realloc( pointer, size );
+}
+
+}
+#endif
+
+#endif // TUDAT_HEAP_ALLOCATION_COUNTER_H
@@ -17,6 +17,7 @@
 #define BOOST_TEST_MAIN
 
 #include <limits>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -36,6 +37,7 @@ BOOST_AUTO_TEST_SUITE( test_exponential_atmosphere )
 // Test 2: Test exponential atmosphere at sea level.
 // Test 3: Test exponential atmosphere at 10 km altitude.
 // Test 4: Test if the position-independent functions work.
+// Test 5: Test if the density at a list of points is computed correctly.
 
 //! Test set- and get-functions of constants.
 BOOST_AUTO_TEST_CASE( testExponentialAtmosphereGetSet )
@@ -163,6 +165,34 @@ BOOST_AUTO_TEST_CASE( testExponentialAtmospherePositionIndependentFunctions )
     BOOST_CHECK_EQUAL( temperature1, temperature2 );
 }
 
+//! Test if the density at a list of points is equal to that computed point by point, also with multiple threads.
+BOOST_AUTO_TEST_CASE( testExponentialAtmosphereDensityAtListOfPoints )
+{
+    aerodynamics::ExponentialAtmosphere exponentialAtmosphere( aerodynamics::earth );
+
+    // Define altitudes between -10 and 990 km (other independent variables are not used)
+    const int numberOfPoints = 10001;
+    std::vector< double > altitudes( numberOfPoints ), otherIndependentVariables( numberOfPoints, 0.0 );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        altitudes[ i ] = -10.0E3 + 100.0 * static_cast< double >( i );
+    }
+
+    for( unsigned int numberOfThreads : { 1, 4 } )
+    {
+        exponentialAtmosphere.setNumberOfThreads( numberOfThreads );
+        std::vector< double > densities( numberOfPoints );
+        exponentialAtmosphere.getDensities( altitudes.data( ), otherIndependentVariables.data( ),
+                                            otherIndependentVariables.data( ), otherIndependentVariables.data( ),
+                                            densities.data( ), numberOfPoints );
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( exponentialAtmosphere.getDensity( altitudes[ i ] ), densities[ i ],
+                                        4.0 * std::numeric_limits< double >::epsilon( ) );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
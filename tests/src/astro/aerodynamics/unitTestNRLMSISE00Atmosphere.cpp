@@ -18,6 +18,7 @@
 #define BOOST_TEST_MAIN
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include <utility>
 
@@ -1137,6 +1138,191 @@ BOOST_AUTO_TEST_CASE( test_nrlmise_FullFileLoad )
 
 }
 
+//! Test whether NRLMSISE00 input from the preprocessed solar activity table is identical to that from the data map.
+BOOST_AUTO_TEST_CASE( test_nrlmise_SolarActivityTable )
+{
+    std::string spaceWeatherFilePath = tudat::paths::getTudatTestDataPath( ) + "/sw19571001.txt";
+    tudat::input_output::solar_activity::SolarActivityDataMap solarActivityData =
+            tudat::input_output::solar_activity::readSolarActivityData( spaceWeatherFilePath );
+
+    // Create atmosphere models with input from data map (through input function), and from table
+    NRLMSISE00Atmosphere mapAtmosphereModel(
+                std::bind( &tudat::aerodynamics::nrlmsiseInputFunction, std::placeholders::_1, std::placeholders::_2,
+                           std::placeholders::_3, std::placeholders::_4, solarActivityData, false, 0.0 ) );
+    NRLMSISE00Atmosphere tableAtmosphereModel( solarActivityData );
+    BOOST_CHECK( tableAtmosphereModel.getSolarActivityTable( ) != nullptr );
+
+    // Compare models over a range of days (including day boundaries), and at different positions
+    double initialJulianDay = tudat::basic_astrodynamics::convertCalendarDateToJulianDay< double >(
+                2003, 10, 27, 0, 0, 0.0 );
+    for( int i = 0; i < 200; i++ )
+    {
+        double time = tudat::basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                    initialJulianDay ) + static_cast< double >( i ) * 4000.0 + ( ( i % 10 == 0 ) ? -1.0E-3 : 0.0 );
+        double altitude = 200.0E3 + static_cast< double >( i % 7 ) * 100.0E3;
+        double longitude = -PI + 0.1 * static_cast< double >( i % 63 );
+        double latitude = -PI / 2.0 + 0.1 * static_cast< double >( i % 31 );
+
+        BOOST_CHECK_EQUAL( mapAtmosphereModel.getDensity( altitude, longitude, latitude, time ),
+                           tableAtmosphereModel.getDensity( altitude, longitude, latitude, time ) );
+        BOOST_CHECK_EQUAL( mapAtmosphereModel.getTemperature( altitude, longitude, latitude, time ),
+                           tableAtmosphereModel.getTemperature( altitude, longitude, latitude, time ) );
+
+        NRLMSISE00Input mapInput = mapAtmosphereModel.getNRLMSISE00Input( );
+        NRLMSISE00Input tableInput = tableAtmosphereModel.getNRLMSISE00Input( );
+        BOOST_CHECK_EQUAL( mapInput.year, tableInput.year );
+        BOOST_CHECK_EQUAL( mapInput.dayOfTheYear, tableInput.dayOfTheYear );
+        BOOST_CHECK_EQUAL( mapInput.secondOfTheDay, tableInput.secondOfTheDay );
+        BOOST_CHECK_EQUAL( mapInput.localSolarTime, tableInput.localSolarTime );
+        BOOST_CHECK_EQUAL( mapInput.f107, tableInput.f107 );
+        BOOST_CHECK_EQUAL( mapInput.f107a, tableInput.f107a );
+        BOOST_CHECK_EQUAL( mapInput.apDaily, tableInput.apDaily );
+        BOOST_CHECK_EQUAL_COLLECTIONS( mapInput.apVector.begin( ), mapInput.apVector.end( ),
+                                       tableInput.apVector.begin( ), tableInput.apVector.end( ) );
+    }
+
+    // Check that requesting data beyond final day throws an exception
+    bool isExceptionCaught = false;
+    try
+    {
+        tableAtmosphereModel.getDensity(
+                    400.0E3, 0.0, 0.0, tudat::basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                        solarActivityData.rbegin( )->first + 2.0 ) );
+    }
+    catch( std::runtime_error const& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+}
+
+//! Test whether NRLMSISE00 density at a list of points is identical to that computed point by point.
+BOOST_AUTO_TEST_CASE( test_nrlmise_DensityAtListOfPoints )
+{
+    std::string spaceWeatherFilePath = tudat::paths::getTudatTestDataPath( ) + "/sw19571001.txt";
+    tudat::input_output::solar_activity::SolarActivityDataMap solarActivityData =
+            tudat::input_output::solar_activity::readSolarActivityData( spaceWeatherFilePath );
+
+    // Create atmosphere models with input from data map (through input function), and from table
+    NRLMSISE00Atmosphere mapAtmosphereModel(
+                std::bind( &tudat::aerodynamics::nrlmsiseInputFunction, std::placeholders::_1, std::placeholders::_2,
+                           std::placeholders::_3, std::placeholders::_4, solarActivityData, false, 0.0 ) );
+    NRLMSISE00Atmosphere tableAtmosphereModel( solarActivityData );
+
+    // Define points over two days
+    double initialTime = tudat::basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                tudat::basic_astrodynamics::convertCalendarDateToJulianDay< double >( 2003, 10, 28, 0, 0, 0.0 ) );
+    const int numberOfPoints = 500;
+    std::vector< double > altitudes( numberOfPoints ), longitudes( numberOfPoints ), latitudes( numberOfPoints ),
+            times( numberOfPoints );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        altitudes[ i ] = 150.0E3 + 1.5E3 * static_cast< double >( i );
+        longitudes[ i ] = std::remainder( 0.1 * static_cast< double >( i ), 2.0 * PI );
+        latitudes[ i ] = 1.2 * std::sin( 0.05 * static_cast< double >( i ) );
+        times[ i ] = initialTime + 350.0 * static_cast< double >( i );
+    }
+
+    // Compare densities at list of points to those computed point by point
+    for( NRLMSISE00Atmosphere* atmosphereModel : { &mapAtmosphereModel, &tableAtmosphereModel } )
+    {
+        double currentDensity = atmosphereModel->getDensity( 400.0E3, 0.1, 0.2, initialTime );
+
+        std::vector< double > densities( numberOfPoints );
+        atmosphereModel->getDensities( altitudes.data( ), longitudes.data( ), latitudes.data( ), times.data( ),
+                                       densities.data( ), numberOfPoints );
+
+        // Check that current properties are not modified
+        BOOST_CHECK_EQUAL( atmosphereModel->getNRLMSISE00Input( ).secondOfTheDay,
+                           tableAtmosphereModel.getSolarActivityTable( )->getSecondOfTheDay(
+                               initialTime, tableAtmosphereModel.getSolarActivityTable( )->getDayNumber( initialTime ) ) );
+        BOOST_CHECK_EQUAL( atmosphereModel->getDensity( 400.0E3, 0.1, 0.2, initialTime ), currentDensity );
+
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            BOOST_CHECK_EQUAL( densities[ i ], atmosphereModel->getDensity(
+                                   altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] ) );
+        }
+    }
+}
+
+//! Test interpolated NRLMSISE00 density along a low Earth orbit.
+BOOST_AUTO_TEST_CASE( test_nrlmise_DensityInterpolation )
+{
+    std::string spaceWeatherFilePath = tudat::paths::getTudatTestDataPath( ) + "/sw19571001.txt";
+    tudat::input_output::solar_activity::SolarActivityDataMap solarActivityData =
+            tudat::input_output::solar_activity::readSolarActivityData( spaceWeatherFilePath );
+
+    NRLMSISE00Atmosphere atmosphereModel( solarActivityData );
+    NRLMSISE00Atmosphere interpolatedAtmosphereModel( solarActivityData );
+
+    // Check that interpolation settings are correctly set and reset
+    BOOST_CHECK( std::isnan( interpolatedAtmosphereModel.getDensityInterpolationTolerance( ) ) );
+    interpolatedAtmosphereModel.setDensityInterpolation( 1.0E-2 );
+    BOOST_CHECK_EQUAL( interpolatedAtmosphereModel.getDensityInterpolationTolerance( ), 1.0E-2 );
+    BOOST_CHECK_EQUAL( interpolatedAtmosphereModel.getDensityInterpolationStepSizes( )[ 3 ], 5400.0 );
+
+    // Evaluate density along (approximate) circular orbit with 51.6 degree inclination, crossing a day boundary
+    double initialTime = tudat::basic_astrodynamics::convertJulianDayToSecondsSinceEpoch(
+                tudat::basic_astrodynamics::convertCalendarDateToJulianDay< double >( 2010, 3, 14, 20, 0, 0.0 ) );
+    double inclination = 51.6 * PI / 180.0;
+    double orbitalPeriod = 5550.0;
+    int numberOfEvaluations = 0;
+    for( double time = 0.0; time < 4.0 * orbitalPeriod; time += 5.0 )
+    {
+        double argumentOfLatitude = 2.0 * PI * time / orbitalPeriod;
+        double altitude = 400.0E3 + 20.0E3 * std::sin( argumentOfLatitude );
+        double longitude = std::remainder(
+                    std::atan2( std::cos( inclination ) * std::sin( argumentOfLatitude ),
+                                std::cos( argumentOfLatitude ) ) - 7.292115E-5 * time, 2.0 * PI );
+        double latitude = std::asin( std::sin( inclination ) * std::sin( argumentOfLatitude ) );
+
+        BOOST_CHECK_CLOSE_FRACTION(
+                    atmosphereModel.getDensity( altitude, longitude, latitude, initialTime + time ),
+                    interpolatedAtmosphereModel.getDensity( altitude, longitude, latitude, initialTime + time ),
+                    2.0E-2 );
+        numberOfEvaluations++;
+    }
+
+    // Check that the interpolation requires fewer model evaluations than density evaluations
+    BOOST_CHECK( interpolatedAtmosphereModel.getNumberOfDensityInterpolationModelEvaluations( ) > 0 );
+    BOOST_CHECK( interpolatedAtmosphereModel.getNumberOfDensityInterpolationModelEvaluations( ) <
+                 numberOfEvaluations );
+
+    // Check that refinement of grid cells does not modify the unrefined grid
+    BOOST_CHECK_EQUAL( interpolatedAtmosphereModel.getDensityInterpolationStepSizes( )[ 0 ], 20.0E3 );
+    BOOST_CHECK_EQUAL( interpolatedAtmosphereModel.getDensityInterpolationStepSizes( )[ 3 ], 5400.0 );
+
+    // Check interpolation at high altitude with a tolerance that cannot be met, so that the cells are refined up to the
+    // maximum number of bisections (for which the altitude index may exceed the range of a 32-bit integer)
+    NRLMSISE00Atmosphere highAltitudeInterpolatedAtmosphereModel( solarActivityData );
+    highAltitudeInterpolatedAtmosphereModel.setDensityInterpolation( 1.0E-30 );
+    for( double altitude = 1.0E6; altitude < 3.0E6; altitude += 2.5E5 )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    atmosphereModel.getDensity( altitude, 0.3, 0.2, initialTime ),
+                    highAltitudeInterpolatedAtmosphereModel.getDensity( altitude, 0.3, 0.2, initialTime ),
+                    1.0E-6 );
+    }
+
+    // Check that the full model is used after disabling interpolation
+    interpolatedAtmosphereModel.setDensityInterpolation( TUDAT_NAN );
+    BOOST_CHECK_EQUAL( atmosphereModel.getDensity( 350.0E3, 0.1, 0.2, initialTime ),
+                       interpolatedAtmosphereModel.getDensity( 350.0E3, 0.1, 0.2, initialTime ) );
+
+    // Check that invalid settings throw an exception
+    bool isExceptionCaught = false;
+    try
+    {
+        interpolatedAtmosphereModel.setDensityInterpolation( -1.0E-3 );
+    }
+    catch( std::runtime_error const& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+}
+
 }
 
 } // namespace unit_tests
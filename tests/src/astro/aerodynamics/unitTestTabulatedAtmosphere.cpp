@@ -19,13 +19,16 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <cmath>
 #include <limits>
+#include <memory>
 
 #include <boost/test/unit_test.hpp>
 
 #include "tudat/astro/basic_astro/unitConversions.h"
 #include "tudat/astro/aerodynamics/tabulatedAtmosphere.h"
 #include "tudat/io/basicInputOutput.h"
+#include "tudat/math/basic/mathematicalConstants.h"
 
 namespace tudat
 {
@@ -408,6 +411,68 @@ BOOST_AUTO_TEST_CASE( testTabulatedAtmosphereExtraVariables )
     BOOST_CHECK_CLOSE_FRACTION( 1.7, tabulatedAtmosphere.getRatioOfSpecificHeats( altitude ), 1.0e-4 );
 }
 
+//! Check if the density at a list of points is equal to that computed point by point, for one and three independent
+//! variables, including points outside of the tables, and with multiple threads.
+BOOST_AUTO_TEST_CASE( testTabulatedAtmosphereDensityAtListOfPoints )
+{
+    // Create tabulated atmospheres with one (altitude) and three (longitude, latitude, altitude) independent variables
+    std::vector< std::shared_ptr< aerodynamics::TabulatedAtmosphere > > tabulatedAtmospheres;
+    tabulatedAtmospheres.push_back( std::make_shared< aerodynamics::TabulatedAtmosphere >(
+                                        paths::getAtmosphereTablesPath( ) +
+                                        "/USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" ) );
+
+    std::map< int, std::string > tabulatedAtmosphereFiles;
+    tabulatedAtmosphereFiles[ 0 ] = paths::getAtmosphereTablesPath( ) + "/MCDMeanAtmosphereTimeAverage/density.dat";
+    tabulatedAtmosphereFiles[ 1 ] = paths::getAtmosphereTablesPath( ) + "/MCDMeanAtmosphereTimeAverage/pressure.dat";
+    tabulatedAtmosphereFiles[ 2 ] = paths::getAtmosphereTablesPath( ) + "/MCDMeanAtmosphereTimeAverage/temperature.dat";
+    tabulatedAtmospheres.push_back( std::make_shared< aerodynamics::TabulatedAtmosphere >(
+                                        tabulatedAtmosphereFiles,
+                                        std::vector< aerodynamics::AtmosphereIndependentVariables >{
+                                            aerodynamics::longitude_dependent_atmosphere,
+                                            aerodynamics::latitude_dependent_atmosphere,
+                                            aerodynamics::altitude_dependent_atmosphere },
+                                        std::vector< aerodynamics::AtmosphereDependentVariables >{
+                                            aerodynamics::density_dependent_atmosphere,
+                                            aerodynamics::pressure_dependent_atmosphere,
+                                            aerodynamics::temperature_dependent_atmosphere } ) );
+
+    // Define points along a descending arc, with altitudes below and above the tables, and on table nodes
+    const int numberOfPoints = 5000;
+    std::vector< double > altitudes( numberOfPoints ), longitudes( numberOfPoints ), latitudes( numberOfPoints ),
+            times( numberOfPoints );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        altitudes[ i ] = ( i % 100 == 0 ) ? 1.0E3 * static_cast< double >( i / 100 ) :
+                                            1.2E6 - 1.25E6 * static_cast< double >( i ) / numberOfPoints;
+        longitudes[ i ] = std::remainder( 0.01 * static_cast< double >( i ), 2.0 * mathematical_constants::PI );
+        latitudes[ i ] = 1.5 * std::sin( 0.003 * static_cast< double >( i ) );
+        times[ i ] = 10.0 * static_cast< double >( i );
+    }
+
+    for ( unsigned int j = 0; j < tabulatedAtmospheres.size( ); j++ )
+    {
+        std::vector< double > expectedDensities( numberOfPoints );
+        for ( int i = 0; i < numberOfPoints; i++ )
+        {
+            expectedDensities[ i ] = tabulatedAtmospheres.at( j )->getDensity(
+                        altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+        }
+
+        for ( unsigned int numberOfThreads : { 1, 4 } )
+        {
+            tabulatedAtmospheres.at( j )->setNumberOfThreads( numberOfThreads );
+            std::vector< double > densities( numberOfPoints );
+            tabulatedAtmospheres.at( j )->getDensities( altitudes.data( ), longitudes.data( ), latitudes.data( ),
+                                                        times.data( ), densities.data( ), numberOfPoints );
+            for ( int i = 0; i < numberOfPoints; i++ )
+            {
+                BOOST_CHECK_CLOSE_FRACTION( expectedDensities[ i ], densities[ i ],
+                                            10.0 * std::numeric_limits< double >::epsilon( ) );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -289,6 +289,76 @@ BOOST_AUTO_TEST_CASE( testPolyhedronShapeModel )
 
 }
 
+//! Test computation of the polyhedron altitude using the facet tree, by comparison with the brute-force computation.
+BOOST_AUTO_TEST_CASE( testPolyhedronShapeModelWithFacetTree )
+{
+    using namespace tudat::basic_astrodynamics;
+
+    // Define tolerance
+    const double tolerance = 1e-12;
+
+    // Define cuboid polyhedron
+    const double w = 10.0; // width
+    const double h = 10.0; // height
+    const double l = 20.0; // length
+
+    Eigen::MatrixXd verticesCoordinates(8,3);
+    Eigen::MatrixXi verticesDefiningEachFacet(12,3);
+    verticesCoordinates <<
+        0.0, 0.0, 0.0,
+        l, 0.0, 0.0,
+        0.0, w, 0.0,
+        l, w, 0.0,
+        0.0, 0.0, h,
+        l, 0.0, h,
+        0.0, w, h,
+        l, w, h;
+    verticesDefiningEachFacet <<
+        2, 1, 0,
+        1, 2, 3,
+        4, 2, 0,
+        2, 4, 6,
+        1, 4, 0,
+        4, 1, 5,
+        6, 5, 7,
+        5, 6, 4,
+        3, 6, 7,
+        6, 3, 2,
+        5, 3, 7,
+        3, 5, 1;
+
+    std::vector< Eigen::Vector3d > testCartesianPositions = {
+        ( Eigen::Vector3d( ) << 10.0, 5.0, 10.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, 5.0, 10.5 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, 5.0, 9.5 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, 5.0, 10.0 - 1e-5 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, 5.0, 5.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, 5.0, 20.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, 0.0, 5.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 0.0, -1.0, 11.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 10.0, -1.0, 11.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 2.0, 3.0, 1.0 ).finished( ),
+        ( Eigen::Vector3d( ) << -30.0, 25.0, -12.0 ).finished( ) };
+
+    for( bool computeAltitudeWithSign : { false, true } )
+    {
+        for( bool justComputeDistanceToVertices : { false, true } )
+        {
+            PolyhedronBodyShapeModel bruteForceShapeModel = PolyhedronBodyShapeModel (
+                verticesCoordinates, verticesDefiningEachFacet, computeAltitudeWithSign, justComputeDistanceToVertices );
+            PolyhedronBodyShapeModel treeShapeModel = PolyhedronBodyShapeModel (
+                verticesCoordinates, verticesDefiningEachFacet, computeAltitudeWithSign, justComputeDistanceToVertices );
+            treeShapeModel.setFacetTree( );
+
+            for( unsigned int i = 0; i < testCartesianPositions.size( ); ++i )
+            {
+                BOOST_CHECK_SMALL( treeShapeModel.getAltitude( testCartesianPositions.at( i ) ) -
+                                   bruteForceShapeModel.getAltitude( testCartesianPositions.at( i ) ), tolerance );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE( testHybridShapeModel )
 {
     using namespace tudat::basic_astrodynamics;
@@ -16,7 +16,9 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -237,6 +239,129 @@ BOOST_AUTO_TEST_CASE( testRadiationPressureTargetModel_EquivalentSphere )
     }
 }
 
+//! Reflection law delegating to a specular-diffuse law, used to check evaluation of panels with generic reflection laws
+class DelegatingReflectionLaw : public ReflectionLaw
+{
+public:
+    DelegatingReflectionLaw( const std::shared_ptr< ReflectionLaw > reflectionLaw ): reflectionLaw_( reflectionLaw ){ }
+
+    double evaluateReflectedFraction(
+        const Eigen::Vector3d& surfaceNormal,
+        const Eigen::Vector3d& incomingDirection,
+        const Eigen::Vector3d& observerDirection) const override
+    {
+        return reflectionLaw_->evaluateReflectedFraction( surfaceNormal, incomingDirection, observerDirection );
+    }
+
+    Eigen::Vector3d evaluateReactionVector(
+        const Eigen::Vector3d& surfaceNormal,
+        const Eigen::Vector3d& incomingDirection) const override
+    {
+        return reflectionLaw_->evaluateReactionVector( surfaceNormal, incomingDirection );
+    }
+
+    Eigen::Matrix3d evaluateReactionVectorDerivativeWrtTargetPosition(
+        const Eigen::Vector3d& surfaceNormal,
+        const Eigen::Vector3d& incomingDirection,
+        const double cosineOfAngleBetweenVectors,
+        const Eigen::Vector3d& currentReactionVector,
+        const Eigen::Matrix3d& sourceUnitVectorPartial,
+        const Eigen::Matrix< double, 1, 3 >& cosineAnglePartial ) override
+    {
+        return reflectionLaw_->evaluateReactionVectorDerivativeWrtTargetPosition(
+            surfaceNormal, incomingDirection, cosineOfAngleBetweenVectors, currentReactionVector,
+            sourceUnitVectorPartial, cosineAnglePartial );
+    }
+
+private:
+    std::shared_ptr< ReflectionLaw > reflectionLaw_;
+};
+
+//! Check if force from list of source panels agrees with sum of forces from individual source panels
+BOOST_AUTO_TEST_CASE( testPaneledRadiationPressureTargetModel_SourcePanels )
+{
+    const int numberOfPanels = 120;
+    const int numberOfSourcePanels = 200;
+
+    // Create panels with random orientation, position and optical properties, using the specular-diffuse reflection
+    // law directly, and through a generic reflection law
+    std::srand( 42 );
+    std::vector< std::shared_ptr< system_models::VehicleExteriorPanel > > panels, genericPanels;
+    for( int i = 0; i < numberOfPanels; i++ )
+    {
+        const Eigen::Vector3d surfaceNormal = Eigen::Vector3d::Random( ).normalized( );
+        const Eigen::Vector3d panelPosition = Eigen::Vector3d::Random( );
+        const double panelArea = 1.0 + Eigen::Vector2d::Random( )( 0 );
+        const Eigen::Vector2d reflectivities = 0.25 * ( Eigen::Vector2d::Random( ) + Eigen::Vector2d::Ones( ) );
+        const std::shared_ptr< SpecularDiffuseMixReflectionLaw > reflectionLaw =
+                reflectionLawFromSpecularAndDiffuseReflectivity( reflectivities( 0 ), reflectivities( 1 ), ( i % 3 == 0 ) );
+
+        panels.push_back( std::make_shared< system_models::VehicleExteriorPanel >(
+                              surfaceNormal, panelArea, "", reflectionLaw, panelPosition ) );
+        genericPanels.push_back( std::make_shared< system_models::VehicleExteriorPanel >(
+                                     surfaceNormal, panelArea, "", std::make_shared< DelegatingReflectionLaw >( reflectionLaw ),
+                                     panelPosition ) );
+    }
+
+    std::vector< double > sourceIrradiances;
+    std::vector< Eigen::Vector3d > sourceToTargetDirections;
+    for( int i = 0; i < numberOfSourcePanels; i++ )
+    {
+        sourceIrradiances.push_back( 1000.0 * ( 1.0 + Eigen::Vector2d::Random( )( 0 ) ) );
+        sourceToTargetDirections.push_back( Eigen::Vector3d::Random( ).normalized( ) );
+    }
+
+    const Eigen::Vector3d centerOfMass = Eigen::Vector3d( 0.1, -0.2, 0.3 );
+    PaneledRadiationPressureTargetModel paneledModel( panels );
+    PaneledRadiationPressureTargetModel genericPaneledModel( genericPanels );
+    paneledModel.enableTorqueComputation( [=](){ return centerOfMass; } );
+    genericPaneledModel.enableTorqueComputation( [=](){ return centerOfMass; } );
+    paneledModel.updateMembers( TUDAT_NAN );
+    genericPaneledModel.updateMembers( TUDAT_NAN );
+
+    // Register additional source for generic model, so that source indices of models differ
+    const int sourceIndex = paneledModel.getSourceIndex( "Source" );
+    BOOST_CHECK_EQUAL( genericPaneledModel.getSourceIndex( "Other" ), 0 );
+    BOOST_CHECK_EQUAL( genericPaneledModel.getSourceIndex( "Source" ), 1 );
+    BOOST_CHECK_EQUAL( genericPaneledModel.getSourceIndex( "Source" ), 1 );
+
+    // Compute force from individual source panels
+    paneledModel.resetComputations( sourceIndex );
+    for( int i = 0; i < numberOfSourcePanels; i++ )
+    {
+        paneledModel.updateRadiationPressureForcing( sourceIrradiances.at( i ), sourceToTargetDirections.at( i ), false, sourceIndex );
+    }
+    const Eigen::Vector3d expectedForce = paneledModel.getCurrentRadiationPressureForce( sourceIndex );
+    const Eigen::Vector3d expectedTorque = paneledModel.getCurrentRadiationPressureTorque( sourceIndex );
+    const Eigen::Matrix< double, Eigen::Dynamic, 3 > expectedPanelForces = paneledModel.getPanelForces( sourceIndex );
+
+    // Compute force from all source panels at once, with both models
+    for( PaneledRadiationPressureTargetModel* targetModel : { &paneledModel, &genericPaneledModel } )
+    {
+        const int currentSourceIndex = targetModel->getSourceIndex( "Source" );
+        targetModel->resetComputations( currentSourceIndex );
+        targetModel->updateRadiationPressureForcingFromSourcePanels(
+                    sourceIrradiances, sourceToTargetDirections, currentSourceIndex );
+
+        const Eigen::Vector3d force = targetModel->getCurrentRadiationPressureForce( currentSourceIndex );
+        const Eigen::Vector3d torque = targetModel->getCurrentRadiationPressureTorque( currentSourceIndex );
+        for( int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_SMALL( std::fabs( force( i ) - expectedForce( i ) ), 1.0E-13 * expectedForce.norm( ) );
+            BOOST_CHECK_SMALL( std::fabs( torque( i ) - expectedTorque( i ) ), 1.0E-13 * expectedForce.norm( ) );
+        }
+
+        // Check retrieval by source name
+        BOOST_CHECK_EQUAL( ( targetModel->getCurrentRadiationPressureForce( "Source" ) - force ).norm( ), 0.0 );
+        BOOST_CHECK_EQUAL( ( targetModel->getCurrentRadiationPressureTorque( "Source" ) - torque ).norm( ), 0.0 );
+        BOOST_CHECK_THROW( targetModel->getCurrentRadiationPressureForce( "Sun" ), std::runtime_error );
+
+        const Eigen::Matrix< double, Eigen::Dynamic, 3 >& panelForces = targetModel->getPanelForces( "Source" );
+        BOOST_CHECK_SMALL( ( panelForces - expectedPanelForces ).cwiseAbs( ).maxCoeff( ), 1.0E-13 * expectedForce.norm( ) );
+        BOOST_CHECK_SMALL( ( panelForces.colwise( ).sum( ).transpose( ) - force ).norm( ), 1.0E-13 * force.norm( ) );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace unit_tests
@@ -0,0 +1,164 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/chebyshevEphemeris.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Analytical reference state: circular heliocentric orbit with a small short-period perturbation.
+Eigen::Vector6d getReferenceState( const double time )
+{
+    const double orbitRadius = 1.5E11;
+    const double meanMotion = 2.0 * mathematical_constants::PI / ( 365.25 * 86400.0 );
+    const double perturbationAmplitude = 1.0E4;
+    const double perturbationFrequency = 2.0 * mathematical_constants::PI / ( 27.3 * 86400.0 );
+
+    Eigen::Vector6d state;
+    state( 0 ) = orbitRadius * std::cos( meanMotion * time ) + perturbationAmplitude * std::sin( perturbationFrequency * time );
+    state( 1 ) = orbitRadius * std::sin( meanMotion * time );
+    state( 2 ) = perturbationAmplitude * std::cos( perturbationFrequency * time );
+    state( 3 ) = -orbitRadius * meanMotion * std::sin( meanMotion * time ) +
+            perturbationAmplitude * perturbationFrequency * std::cos( perturbationFrequency * time );
+    state( 4 ) = orbitRadius * meanMotion * std::cos( meanMotion * time );
+    state( 5 ) = -perturbationAmplitude * perturbationFrequency * std::sin( perturbationFrequency * time );
+    return state;
+}
+
+BOOST_AUTO_TEST_SUITE( test_chebyshev_ephemeris )
+
+//! Test whether the Chebyshev ephemeris reproduces the reference state within the reported error bound
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisAccuracy )
+{
+    const double initialTime = 1.0E7;
+    const double finalTime = initialTime + 30.0 * 86400.0;
+
+    ephemerides::ChebyshevEphemeris ephemeris(
+                &getReferenceState, initialTime, finalTime, 4.0 * 86400.0, 12 );
+
+    // Check segment setup (8 segments of equal duration)
+    BOOST_CHECK_EQUAL( ephemeris.getNumberOfSegments( ), 8 );
+    BOOST_CHECK_CLOSE_FRACTION( ephemeris.getSegmentDuration( ), 30.0 * 86400.0 / 8.0, 1.0E-15 );
+
+    // Check reported error bound
+    BOOST_CHECK( ephemeris.getMaximumPositionError( ) < 1.0E-3 );
+    BOOST_CHECK( ephemeris.getMaximumVelocityError( ) < 1.0E-9 );
+
+    // Check error over full interval, including segment boundaries and interval end points
+    double maximumPositionError = 0.0;
+    double maximumVelocityError = 0.0;
+    const int numberOfTestTimes = 2401;
+    for( int i = 0; i < numberOfTestTimes; i++ )
+    {
+        double currentTime = initialTime + ( finalTime - initialTime ) * static_cast< double >( i ) /
+                static_cast< double >( numberOfTestTimes - 1 );
+        Eigen::Vector6d stateError = ephemeris.getCartesianState( currentTime ) - getReferenceState( currentTime );
+        maximumPositionError = std::max( maximumPositionError, stateError.segment( 0, 3 ).norm( ) );
+        maximumVelocityError = std::max( maximumVelocityError, stateError.segment( 3, 3 ).norm( ) );
+    }
+
+    // Reported error (evaluated between nodes) should be representative of the actual error, up to rounding errors
+    BOOST_CHECK( maximumPositionError < 2.0 * ephemeris.getMaximumPositionError( ) + 1.0E-4 );
+    BOOST_CHECK( maximumVelocityError < 2.0 * ephemeris.getMaximumVelocityError( ) + 1.0E-10 );
+
+    // Check that times outside of interval are rejected
+    BOOST_CHECK_THROW( ephemeris.getCartesianState( initialTime - 1.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( ephemeris.getCartesianState( finalTime + 1.0 ), std::runtime_error );
+}
+
+//! Test whether the segment duration is refined until the position tolerance is met
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisRefinement )
+{
+    const double initialTime = 0.0;
+    const double finalTime = 60.0 * 86400.0;
+    const double positionTolerance = 1.0E-2;
+
+    ephemerides::ChebyshevEphemeris unrefinedEphemeris(
+                &getReferenceState, initialTime, finalTime, finalTime - initialTime, 6 );
+    BOOST_CHECK_EQUAL( unrefinedEphemeris.getNumberOfSegments( ), 1 );
+    BOOST_CHECK( unrefinedEphemeris.getMaximumPositionError( ) > positionTolerance );
+
+    ephemerides::ChebyshevEphemeris refinedEphemeris(
+                &getReferenceState, initialTime, finalTime, finalTime - initialTime, 6,
+                "SSB", "ECLIPJ2000", positionTolerance );
+    BOOST_CHECK( refinedEphemeris.getNumberOfSegments( ) > 1 );
+    BOOST_CHECK( refinedEphemeris.getMaximumPositionError( ) <= positionTolerance );
+
+    // Check that unattainable tolerance results in an exception
+    BOOST_CHECK_THROW( ephemerides::ChebyshevEphemeris(
+                           &getReferenceState, initialTime, finalTime, finalTime - initialTime, 6,
+                           "SSB", "ECLIPJ2000", positionTolerance, 1 ), std::runtime_error );
+}
+
+//! Test whether concurrent state retrieval gives results identical to serial retrieval
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisConcurrentAccess )
+{
+    const double initialTime = 0.0;
+    const double finalTime = 10.0 * 86400.0;
+
+    ephemerides::ChebyshevEphemeris ephemeris(
+                &getReferenceState, initialTime, finalTime, 86400.0, 10 );
+
+    const int numberOfThreads = 4;
+    const int numberOfTestTimes = 5000;
+    std::vector< double > testTimes( numberOfTestTimes );
+    std::vector< Eigen::Vector6d > serialStates( numberOfTestTimes );
+    for( int i = 0; i < numberOfTestTimes; i++ )
+    {
+        testTimes[ i ] = initialTime + ( finalTime - initialTime ) *
+                std::fmod( 0.618033988749895 * static_cast< double >( i ), 1.0 );
+        serialStates[ i ] = ephemeris.getCartesianState( testTimes[ i ] );
+    }
+
+    std::vector< std::vector< Eigen::Vector6d > > concurrentStates(
+                numberOfThreads, std::vector< Eigen::Vector6d >( numberOfTestTimes ) );
+    std::vector< std::thread > threads;
+    for( int j = 0; j < numberOfThreads; j++ )
+    {
+        threads.push_back( std::thread( [ &, j ]( )
+        {
+            for( int i = 0; i < numberOfTestTimes; i++ )
+            {
+                concurrentStates[ j ][ i ] = ephemeris.getCartesianState( testTimes[ i ] );
+            }
+        } ) );
+    }
+    for( unsigned int j = 0; j < threads.size( ); j++ )
+    {
+        threads.at( j ).join( );
+    }
+
+    for( int j = 0; j < numberOfThreads; j++ )
+    {
+        for( int i = 0; i < numberOfTestTimes; i++ )
+        {
+            BOOST_CHECK( concurrentStates[ j ][ i ] == serialStates[ i ] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -15,7 +15,10 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <array>
+#include <cstdlib>
 #include <limits>
+#include <map>
 
 #include <boost/test/tools/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
@@ -28,6 +31,65 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Function to create an (irregular) polyhedron by subdividing the facets of an octahedron and projecting the new
+//! vertices on an ellipsoid, with random perturbations of the radius.
+void createTestPolyhedron( const int numberOfSubdivisions,
+                           Eigen::MatrixXd& verticesCoordinates,
+                           Eigen::MatrixXi& verticesDefiningEachFacet )
+{
+    std::vector< Eigen::Vector3d > vertices = {
+        Eigen::Vector3d::UnitX( ), -Eigen::Vector3d::UnitX( ), Eigen::Vector3d::UnitY( ),
+        -Eigen::Vector3d::UnitY( ), Eigen::Vector3d::UnitZ( ), -Eigen::Vector3d::UnitZ( ) };
+    std::vector< std::array< int, 3 > > facets = {
+        { 0, 2, 4 }, { 2, 1, 4 }, { 1, 3, 4 }, { 3, 0, 4 }, { 2, 0, 5 }, { 1, 2, 5 }, { 3, 1, 5 }, { 0, 3, 5 } };
+
+    for( int subdivision = 0; subdivision < numberOfSubdivisions; ++subdivision )
+    {
+        std::map< std::pair< int, int >, int > edgeMidpoints;
+        auto getMidpoint = [ & ]( const int vertex1, const int vertex2 )
+        {
+            const std::pair< int, int > edge = std::make_pair( std::min( vertex1, vertex2 ), std::max( vertex1, vertex2 ) );
+            if( edgeMidpoints.count( edge ) == 0 )
+            {
+                edgeMidpoints[ edge ] = vertices.size( );
+                vertices.push_back( ( vertices.at( vertex1 ) + vertices.at( vertex2 ) ).normalized( ) );
+            }
+            return edgeMidpoints.at( edge );
+        };
+
+        std::vector< std::array< int, 3 > > newFacets;
+        for( const std::array< int, 3 >& facet : facets )
+        {
+            const int midpoint01 = getMidpoint( facet[ 0 ], facet[ 1 ] );
+            const int midpoint12 = getMidpoint( facet[ 1 ], facet[ 2 ] );
+            const int midpoint20 = getMidpoint( facet[ 2 ], facet[ 0 ] );
+            newFacets.push_back( { facet[ 0 ], midpoint01, midpoint20 } );
+            newFacets.push_back( { facet[ 1 ], midpoint12, midpoint01 } );
+            newFacets.push_back( { facet[ 2 ], midpoint20, midpoint12 } );
+            newFacets.push_back( { midpoint01, midpoint12, midpoint20 } );
+        }
+        facets = newFacets;
+    }
+
+    std::srand( 0 );
+    verticesCoordinates.resize( vertices.size( ), 3 );
+    for( unsigned int vertex = 0; vertex < vertices.size( ); ++vertex )
+    {
+        const double radiusScaling = 1.0 + 0.05 * static_cast< double >( std::rand( ) ) / RAND_MAX;
+        verticesCoordinates.row( vertex ) = radiusScaling * ( Eigen::Vector3d( ) <<
+                    1000.0 * vertices.at( vertex )( 0 ), 700.0 * vertices.at( vertex )( 1 ),
+                    500.0 * vertices.at( vertex )( 2 ) ).finished( ).transpose( );
+    }
+    verticesDefiningEachFacet.resize( facets.size( ), 3 );
+    for( unsigned int facet = 0; facet < facets.size( ); ++facet )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            verticesDefiningEachFacet( facet, i ) = facets.at( facet )[ i ];
+        }
+    }
+}
+
 //! Test the functionality of the polyhedron gravity field class.
 BOOST_AUTO_TEST_SUITE( test_polyhedron_gravity_field )
 
@@ -249,6 +311,137 @@ BOOST_AUTO_TEST_CASE( testGravityComputation )
     }
 }
 
+//! Test computation of potential and gradient from the polyhedron cache, serially and distributed over threads, by
+//! comparison with the facet-by-facet and edge-by-edge computation.
+BOOST_AUTO_TEST_CASE( testCacheGravityComputation )
+{
+    // Define polyhedron with 8192 facets (i.e. multiple blocks of facets and edges)
+    Eigen::MatrixXd verticesCoordinates;
+    Eigen::MatrixXi verticesDefiningEachFacet;
+    createTestPolyhedron( 5, verticesCoordinates, verticesDefiningEachFacet );
+
+    const double gravitationalParameter = 6.67259e-11 * 2000.0 * basic_astrodynamics::computePolyhedronVolume(
+                verticesCoordinates, verticesDefiningEachFacet );
+
+    gravitation::PolyhedronGravityField gravityField = gravitation::PolyhedronGravityField(
+            gravitationalParameter, verticesCoordinates, verticesDefiningEachFacet );
+    const double gravitationalConstantTimesDensity = gravitationalParameter / gravityField.getVolume( );
+
+    std::vector< Eigen::Vector3d > bodyFixedPositions = {
+        ( Eigen::Vector3d( ) << 0.0, 0.0, 0.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 200.0, -100.0, 50.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 1100.0, 0.0, 0.0 ).finished( ),
+        ( Eigen::Vector3d( ) << -600.0, 500.0, 600.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 20000.0, 10000.0, 5000.0 ).finished( ) };
+
+    std::vector< Eigen::Vector3d > serialGradients;
+    for( unsigned int numberOfThreads : { 1, 4 } )
+    {
+        gravityField.setNumberOfThreads( numberOfThreads );
+        for( unsigned int i = 0; i < bodyFixedPositions.size( ); ++i )
+        {
+            // Compute factors and results facet-by-facet and edge-by-edge
+            Eigen::MatrixXd verticesCoordinatesRelativeToFieldPoint;
+            Eigen::VectorXd perFacetFactor, perEdgeFactor;
+            basic_mathematics::calculatePolyhedronVerticesCoordinatesRelativeToFieldPoint(
+                        verticesCoordinatesRelativeToFieldPoint, bodyFixedPositions.at( i ), verticesCoordinates );
+            basic_mathematics::calculatePolyhedronPerFacetFactor(
+                        perFacetFactor, verticesCoordinatesRelativeToFieldPoint, verticesDefiningEachFacet );
+            basic_mathematics::calculatePolyhedronPerEdgeFactor(
+                        perEdgeFactor, verticesCoordinatesRelativeToFieldPoint, gravityField.getVerticesDefiningEachEdge( ) );
+
+            const double expectedPotential = basic_mathematics::calculatePolyhedronGravitationalPotential(
+                        gravitationalConstantTimesDensity, verticesCoordinatesRelativeToFieldPoint,
+                        verticesDefiningEachFacet, gravityField.getVerticesDefiningEachEdge( ),
+                        gravityField.getFacetDyads( ), gravityField.getEdgeDyads( ), perFacetFactor, perEdgeFactor );
+            const Eigen::Vector3d expectedGradient = basic_mathematics::calculatePolyhedronGradientOfGravitationalPotential(
+                        gravitationalConstantTimesDensity, verticesCoordinatesRelativeToFieldPoint,
+                        verticesDefiningEachFacet, gravityField.getVerticesDefiningEachEdge( ),
+                        gravityField.getFacetDyads( ), gravityField.getEdgeDyads( ), perFacetFactor, perEdgeFactor );
+
+            // Compare with results from cache
+            const double computedPotential = gravityField.getGravitationalPotential( bodyFixedPositions.at( i ) );
+            const Eigen::Vector3d computedGradient = gravityField.getGradientOfPotential( bodyFixedPositions.at( i ) );
+
+            BOOST_CHECK_SMALL( std::fabs( computedPotential - expectedPotential ) / std::fabs( expectedPotential ), 1.0E-12 );
+            BOOST_CHECK_SMALL( ( computedGradient - expectedGradient ).norm( ) / expectedGradient.norm( ), 1.0E-10 );
+
+            // Check that result is independent of number of threads (fixed-order block reduction)
+            if( numberOfThreads == 1 )
+            {
+                serialGradients.push_back( computedGradient );
+            }
+            else
+            {
+                for( int j = 0; j < 3; j++ )
+                {
+                    BOOST_CHECK_EQUAL( computedGradient( j ), serialGradients.at( i )( j ) );
+                }
+            }
+            BOOST_CHECK_SMALL( std::fabs( gravityField.getLaplacianOfPotential( bodyFixedPositions.at( i ) ) -
+                                          basic_mathematics::calculatePolyhedronLaplacianOfGravitationalPotential(
+                                              gravitationalConstantTimesDensity, perFacetFactor ) ),
+                               1.0E-12 * gravitationalConstantTimesDensity );
+        }
+    }
+}
+
+//! Test computation of potential and gradient using the facet tree, by comparison with the exact computation.
+BOOST_AUTO_TEST_CASE( testFacetTreeGravityComputation )
+{
+    // Define polyhedron with 2048 facets
+    Eigen::MatrixXd verticesCoordinates;
+    Eigen::MatrixXi verticesDefiningEachFacet;
+    createTestPolyhedron( 4, verticesCoordinates, verticesDefiningEachFacet );
+
+    const double gravitationalParameter = 6.67259e-11 * 2000.0 * basic_astrodynamics::computePolyhedronVolume(
+                verticesCoordinates, verticesDefiningEachFacet );
+
+    gravitation::PolyhedronGravityField exactGravityField = gravitation::PolyhedronGravityField(
+            gravitationalParameter, verticesCoordinates, verticesDefiningEachFacet );
+
+    // Define field points, from close to the surface to far away, including some inside the polyhedron
+    std::vector< Eigen::Vector3d > bodyFixedPositions = {
+        ( Eigen::Vector3d( ) << 0.0, 0.0, 0.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 200.0, -100.0, 50.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 1100.0, 0.0, 0.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 0.0, 800.0, 300.0 ).finished( ),
+        ( Eigen::Vector3d( ) << -600.0, 500.0, 600.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 1500.0, -1500.0, 1000.0 ).finished( ),
+        ( Eigen::Vector3d( ) << -5000.0, 2000.0, -3000.0 ).finished( ),
+        ( Eigen::Vector3d( ) << 20000.0, 10000.0, 5000.0 ).finished( ) };
+
+    // Compute exact values
+    std::vector< double > exactPotentials;
+    std::vector< Eigen::Vector3d > exactGradients;
+    for( unsigned int i = 0; i < bodyFixedPositions.size( ); ++i )
+    {
+        exactPotentials.push_back( exactGravityField.getGravitationalPotential( bodyFixedPositions.at( i ) ) );
+        exactGradients.push_back( exactGravityField.getGradientOfPotential( bodyFixedPositions.at( i ) ) );
+    }
+
+    for( double maximumRelativeTruncationError : { 0.0, 1.0E-4, 1.0E-6, 1.0E-8 } )
+    {
+        gravitation::PolyhedronGravityField treeGravityField = gravitation::PolyhedronGravityField(
+                gravitationalParameter, verticesCoordinates, verticesDefiningEachFacet );
+        treeGravityField.setFacetTreeEvaluation( maximumRelativeTruncationError );
+
+        // Results without approximation should be equal to exact ones up to round-off; with approximation the
+        // error should be of the order of the truncation error (relative to the magnitude of the result)
+        const double tolerance = ( maximumRelativeTruncationError == 0.0 ) ? 1.0E-10 : 10.0 * maximumRelativeTruncationError;
+        for( unsigned int i = 0; i < bodyFixedPositions.size( ); ++i )
+        {
+            const double potential = treeGravityField.getGravitationalPotential( bodyFixedPositions.at( i ) );
+            const Eigen::Vector3d gradient = treeGravityField.getGradientOfPotential( bodyFixedPositions.at( i ) );
+
+            BOOST_CHECK_SMALL( std::fabs( potential - exactPotentials.at( i ) ) / std::fabs( exactPotentials.at( i ) ),
+                               tolerance );
+            BOOST_CHECK_SMALL( ( gradient - exactGradients.at( i ) ).norm( ) / exactGradients.at( i ).norm( ),
+                               tolerance );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace tudat
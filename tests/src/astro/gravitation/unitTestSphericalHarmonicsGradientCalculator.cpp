@@ -0,0 +1,217 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/gravitation/sphericalHarmonicsGradientCalculator.h"
+#include "tudat/astro/gravitation/sphericalHarmonicsGravityField.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_spherical_harmonics_gradient_calculator )
+
+//! Function to create (pseudo-random) geodesy-normalized coefficients, with magnitude decaying with degree.
+void getTestCoefficients( const int maximumDegree, const int maximumOrder, const int seed,
+                          Eigen::MatrixXd& cosineCoefficients, Eigen::MatrixXd& sineCoefficients )
+{
+    std::srand( seed );
+    cosineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumOrder + 1 );
+    sineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumOrder + 1 );
+    for( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        double degreeScaling = 1.0E-5 / static_cast< double >( ( degree + 1 ) * ( degree + 1 ) );
+        cosineCoefficients.row( degree ) *= degreeScaling;
+        sineCoefficients.row( degree ) *= degreeScaling;
+        sineCoefficients( degree, 0 ) = 0.0;
+    }
+    cosineCoefficients( 0, 0 ) = 1.0;
+}
+
+//! Function to compute the gradient with the term-by-term spherical harmonic summation
+Eigen::Vector3d computeReferenceGradient( const Eigen::Vector3d& position, const double gravitationalParameter,
+                                          const double referenceRadius, const Eigen::MatrixXd& cosineCoefficients,
+                                          const Eigen::MatrixXd& sineCoefficients )
+{
+    std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache =
+            std::make_shared< basic_mathematics::SphericalHarmonicsCache >(
+                cosineCoefficients.rows( ) + 1, cosineCoefficients.cols( ) + 1 );
+    std::map< std::pair< int, int >, Eigen::Vector3d > dummyAccelerationPerTerm;
+    return gravitation::computeGeodesyNormalizedGravitationalAccelerationSum(
+                position, gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                sphericalHarmonicsCache, dummyAccelerationPerTerm );
+}
+
+//! Test whether the gradient calculator reproduces the term-by-term summation, for various degrees and orders
+BOOST_AUTO_TEST_CASE( testSphericalHarmonicsGradientCalculator )
+{
+    const double gravitationalParameter = 3.986004418E14;
+    const double referenceRadius = 6378137.0;
+
+    std::vector< std::pair< int, int > > degreesAndOrders =
+    { { 0, 0 }, { 1, 1 }, { 2, 0 }, { 4, 4 }, { 20, 20 }, { 50, 10 }, { 100, 100 }, { 360, 360 } };
+    std::vector< Eigen::Vector3d > testPositions =
+    { Eigen::Vector3d( 7.0E6, 0.0, 0.0 ),
+      Eigen::Vector3d( -2.0E6, 5.0E6, 4.0E6 ),
+      Eigen::Vector3d( 3.0E6, -3.0E6, -6.0E6 ),
+      Eigen::Vector3d( 1.0E5, 2.0E5, 6.9E6 ),
+      Eigen::Vector3d( -4.0E7, -1.0E7, 2.0E7 ) };
+
+    for( unsigned int i = 0; i < degreesAndOrders.size( ); i++ )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        getTestCoefficients( degreesAndOrders.at( i ).first, degreesAndOrders.at( i ).second, i + 1,
+                             cosineCoefficients, sineCoefficients );
+
+        gravitation::SphericalHarmonicsGradientCalculator gradientCalculator( cosineCoefficients, sineCoefficients );
+        BOOST_CHECK_EQUAL( gradientCalculator.getMaximumDegree( ), degreesAndOrders.at( i ).first );
+        BOOST_CHECK_EQUAL( gradientCalculator.getMaximumOrder( ), degreesAndOrders.at( i ).second );
+
+        // Check non-central part of gradient separately, to test correctness of higher-order terms
+        Eigen::MatrixXd nonCentralCosineCoefficients = cosineCoefficients;
+        nonCentralCosineCoefficients( 0, 0 ) = 0.0;
+        gravitation::SphericalHarmonicsGradientCalculator nonCentralGradientCalculator(
+                    nonCentralCosineCoefficients, sineCoefficients );
+
+        for( unsigned int j = 0; j < testPositions.size( ); j++ )
+        {
+            Eigen::Vector3d expectedGradient = computeReferenceGradient(
+                        testPositions.at( j ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients );
+            Eigen::Vector3d computedGradient = gradientCalculator.computeGradient(
+                        testPositions.at( j ), gravitationalParameter, referenceRadius );
+            BOOST_CHECK_SMALL( ( computedGradient - expectedGradient ).norm( ) / expectedGradient.norm( ), 1.0E-13 );
+
+            if( degreesAndOrders.at( i ).first > 1 )
+            {
+                Eigen::Vector3d expectedNonCentralGradient = computeReferenceGradient(
+                            testPositions.at( j ), gravitationalParameter, referenceRadius,
+                            nonCentralCosineCoefficients, sineCoefficients );
+                Eigen::Vector3d computedNonCentralGradient = nonCentralGradientCalculator.computeGradient(
+                            testPositions.at( j ), gravitationalParameter, referenceRadius );
+                BOOST_CHECK_SMALL( ( computedNonCentralGradient - expectedNonCentralGradient ).norm( ) /
+                                   expectedNonCentralGradient.norm( ), 1.0E-11 );
+            }
+        }
+    }
+}
+
+//! Test whether resetting the coefficients (of same and different size) is correctly handled
+BOOST_AUTO_TEST_CASE( testSphericalHarmonicsGradientCalculatorCoefficientReset )
+{
+    const double gravitationalParameter = 3.986004418E14;
+    const double referenceRadius = 6378137.0;
+    const Eigen::Vector3d testPosition( -2.0E6, 5.0E6, 4.0E6 );
+
+    Eigen::MatrixXd firstCosineCoefficients, firstSineCoefficients;
+    getTestCoefficients( 10, 10, 42, firstCosineCoefficients, firstSineCoefficients );
+    Eigen::MatrixXd secondCosineCoefficients, secondSineCoefficients;
+    getTestCoefficients( 10, 10, 43, secondCosineCoefficients, secondSineCoefficients );
+    Eigen::MatrixXd thirdCosineCoefficients, thirdSineCoefficients;
+    getTestCoefficients( 30, 15, 44, thirdCosineCoefficients, thirdSineCoefficients );
+
+    gravitation::SphericalHarmonicsGradientCalculator gradientCalculator(
+                firstCosineCoefficients, firstSineCoefficients );
+
+    std::vector< std::pair< Eigen::MatrixXd, Eigen::MatrixXd > > coefficientList =
+    { { secondCosineCoefficients, secondSineCoefficients },
+      { secondCosineCoefficients, secondSineCoefficients },
+      { thirdCosineCoefficients, thirdSineCoefficients },
+      { firstCosineCoefficients, firstSineCoefficients } };
+    for( unsigned int i = 0; i < coefficientList.size( ); i++ )
+    {
+        gradientCalculator.setCoefficients( coefficientList.at( i ).first, coefficientList.at( i ).second );
+        Eigen::Vector3d expectedGradient = computeReferenceGradient(
+                    testPosition, gravitationalParameter, referenceRadius,
+                    coefficientList.at( i ).first, coefficientList.at( i ).second );
+        Eigen::Vector3d computedGradient = gradientCalculator.computeGradient(
+                    testPosition, gravitationalParameter, referenceRadius );
+        BOOST_CHECK_SMALL( ( computedGradient - expectedGradient ).norm( ) / expectedGradient.norm( ), 1.0E-14 );
+    }
+
+    // Check input errors
+    BOOST_CHECK_THROW( gradientCalculator.setCoefficients( firstCosineCoefficients, thirdSineCoefficients ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( gradientCalculator.computeGradient(
+                           Eigen::Vector3d( 0.0, 0.0, 7.0E6 ), gravitationalParameter, referenceRadius ),
+                       std::runtime_error );
+}
+
+//! Test whether the batched (multi-position) computation reproduces single-position computations, serial and threaded
+BOOST_AUTO_TEST_CASE( testSphericalHarmonicsBatchedGradients )
+{
+    const double gravitationalParameter = 3.986004418E14;
+    const double referenceRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 40, 30, 7, cosineCoefficients, sineCoefficients );
+    gravitation::SphericalHarmonicsGravityField gravityField(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients );
+
+    // Create list of positions, with number of positions not a multiple of block size
+    const int numberOfPositions = 3 * gravitation::SphericalHarmonicsGradientCalculator::POSITION_BLOCK_SIZE + 5;
+    std::srand( 11 );
+    Eigen::MatrixXd positions = Eigen::MatrixXd::Random( numberOfPositions, 3 );
+    for( int i = 0; i < numberOfPositions; i++ )
+    {
+        positions.row( i ) *= 1.2 * referenceRadius / positions.row( i ).norm( );
+    }
+
+    Eigen::MatrixXd serialGradients = gravityField.getGradientsOfPotential( positions );
+    BOOST_CHECK_EQUAL( serialGradients.rows( ), numberOfPositions );
+    BOOST_CHECK_EQUAL( serialGradients.cols( ), 3 );
+
+    gravitation::SphericalHarmonicsGradientCalculator gradientCalculator( cosineCoefficients, sineCoefficients );
+    for( int i = 0; i < numberOfPositions; i++ )
+    {
+        // Check against single-position calculator (identical operations) and term-by-term summation
+        Eigen::Vector3d singleGradient = gradientCalculator.computeGradient(
+                    positions.row( i ).transpose( ), gravitationalParameter, referenceRadius );
+        BOOST_CHECK( Eigen::Vector3d( serialGradients.row( i ).transpose( ) ) == singleGradient );
+
+        Eigen::Vector3d expectedGradient = computeReferenceGradient(
+                    positions.row( i ).transpose( ), gravitationalParameter, referenceRadius,
+                    cosineCoefficients, sineCoefficients );
+        BOOST_CHECK_SMALL( ( singleGradient - expectedGradient ).norm( ) / expectedGradient.norm( ), 1.0E-14 );
+    }
+
+    // Check that threaded computation gives identical results
+    std::shared_ptr< utilities::ThreadPool > threadPool = std::make_shared< utilities::ThreadPool >( 3 );
+    Eigen::MatrixXd threadedGradients = gravityField.getGradientsOfPotential( positions, threadPool );
+    BOOST_CHECK( threadedGradients == serialGradients );
+
+    // Check that modified coefficients are used
+    Eigen::MatrixXd modifiedCosineCoefficients = 2.0 * cosineCoefficients;
+    gravityField.setCosineCoefficients( modifiedCosineCoefficients );
+    gradientCalculator.setCoefficients( modifiedCosineCoefficients, sineCoefficients );
+    Eigen::MatrixXd modifiedGradients = gravityField.getGradientsOfPotential( positions, threadPool );
+    BOOST_CHECK( Eigen::Vector3d( modifiedGradients.row( 0 ).transpose( ) ) == gradientCalculator.computeGradient(
+                     positions.row( 0 ).transpose( ), gravitationalParameter, referenceRadius ) );
+
+    // Check input errors
+    BOOST_CHECK_THROW( gravityField.getGradientsOfPotential( positions.transpose( ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
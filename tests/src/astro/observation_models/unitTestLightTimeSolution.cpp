@@ -233,6 +233,83 @@ BOOST_AUTO_TEST_CASE( testLightWithSpice )
                                 1E-14 );
 }
 
+//! Function to compute a test state on a circular orbit in the xy-plane (with radius and angular velocity as input)
+Eigen::Vector6d getCircularOrbitTestState( const double time, const double radius, const double angularVelocity )
+{
+    Eigen::Vector6d state;
+    state << radius * std::cos( angularVelocity * time ), radius * std::sin( angularVelocity * time ), 0.0,
+            -radius * angularVelocity * std::sin( angularVelocity * time ),
+            radius * angularVelocity * std::cos( angularVelocity * time ), 0.0;
+    return state;
+}
+
+//! Test batch computation of light times, by comparing to computation for a single time.
+BOOST_AUTO_TEST_CASE( testBatchedLightTimeSolution )
+{
+    // Define link ends on circular orbits
+    std::function< Eigen::Vector6d( const double ) > transmitterStateFunction =
+            std::bind( &getCircularOrbitTestState, std::placeholders::_1, 1.5E11, 2.0E-7 );
+    std::function< Eigen::Vector6d( const double ) > receiverStateFunction =
+            std::bind( &getCircularOrbitTestState, std::placeholders::_1, 2.2E11, 1.1E-7 );
+
+    // Define observation times, with a single large gap
+    std::vector< double > observationTimes;
+    for( int i = 0; i < 200; i++ )
+    {
+        observationTimes.push_back( 1.0E6 + 60.0 * static_cast< double >( i ) + ( ( i < 100 ) ? 0.0 : 86400.0 ) );
+    }
+
+    std::vector< LightTimeCorrectionFunctionSingleLeg > lightTimeCorrections;
+    lightTimeCorrections.push_back( &getTimeDifferenceLightTimeCorrection );
+    lightTimeCorrections.push_back( &getPositionDifferenceLightTimeCorrection );
+
+    for( int useCorrections = 0; useCorrections < 2; useCorrections++ )
+    {
+        for( int timeAtReception = 0; timeAtReception < 2; timeAtReception++ )
+        {
+            std::vector< LightTimeCorrectionFunctionSingleLeg > currentLightTimeCorrections =
+                    ( useCorrections == 1 ) ? lightTimeCorrections : std::vector< LightTimeCorrectionFunctionSingleLeg >( );
+            std::shared_ptr< LightTimeCalculator< > > lightTimeCalculator = std::make_shared< LightTimeCalculator< > >(
+                        transmitterStateFunction, receiverStateFunction, currentLightTimeCorrections );
+
+            // Create light-time calculator with stringent convergence criteria, to compute reference solution
+            std::shared_ptr< LightTimeCalculator< > > referenceLightTimeCalculator = std::make_shared< LightTimeCalculator< > >(
+                        transmitterStateFunction, receiverStateFunction, currentLightTimeCorrections,
+                        std::make_shared< LightTimeConvergenceCriteria >( true, 50, 1.0E-15 ) );
+
+            // Compute light times as batch
+            std::vector< Eigen::Vector6d > receiverStates, transmitterStates;
+            std::vector< double > lightTimes = lightTimeCalculator->calculateLightTimesWithLinkEndsStates(
+                        receiverStates, transmitterStates, observationTimes, timeAtReception == 1 );
+            BOOST_CHECK_EQUAL( lightTimes.size( ), observationTimes.size( ) );
+            unsigned int lastBatchedNumberOfIterations = lightTimeCalculator->getNumberOfIterations( );
+
+            // Compare against light times computed for each time separately (with default and stringent convergence criteria)
+            Eigen::Vector6d receiverState, transmitterState;
+            for( unsigned int i = 0; i < observationTimes.size( ); i++ )
+            {
+                double lightTime = lightTimeCalculator->calculateLightTimeWithLinkEndsStates(
+                            receiverState, transmitterState, observationTimes.at( i ), timeAtReception == 1 );
+                BOOST_CHECK_CLOSE_FRACTION( lightTime, lightTimes.at( i ), 1.0E-11 );
+
+                // Solution at first time uses same initial guess as single-time computation, and is equally accurate
+                lightTime = referenceLightTimeCalculator->calculateLightTimeWithLinkEndsStates(
+                            receiverState, transmitterState, observationTimes.at( i ), timeAtReception == 1 );
+                BOOST_CHECK_CLOSE_FRACTION( lightTime, lightTimes.at( i ), ( i == 0 ) ? 1.0E-11 : 1.0E-13 );
+                for( int j = 0; j < 6; j++ )
+                {
+                    BOOST_CHECK_CLOSE_FRACTION( receiverState( j ), receiverStates.at( i )( j ), 1.0E-14 );
+                    BOOST_CHECK_CLOSE_FRACTION( transmitterState( j ), transmitterStates.at( i )( j ), 1.0E-14 );
+                }
+            }
+
+            // Check that initial guess from preceding times reduces number of iterations
+            lightTimeCalculator->calculateLightTime( observationTimes.back( ), timeAtReception == 1 );
+            BOOST_CHECK( lastBatchedNumberOfIterations < lightTimeCalculator->getNumberOfIterations( ) );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -258,6 +258,28 @@ BOOST_AUTO_TEST_CASE( testConsiderParameters )
     // Retrieve covariance matrix when estimating all parameters
     Eigen::MatrixXd covarianceAll = covarianceOutputAll->getUnnormalizedCovarianceMatrix( );
 
+    // Check that multi-threaded computation of observations and partials reproduces serial results
+    for( unsigned int numberOfThreads = 2; numberOfThreads <= 4; numberOfThreads++ )
+    {
+        std::shared_ptr< CovarianceAnalysisInput< double, double  > > parallelCovarianceInputAll =
+                std::make_shared< CovarianceAnalysisInput< double, double > >( observationsAndTimesAll, Eigen::MatrixXd::Zero( 0, 0 ) );
+        parallelCovarianceInputAll->setNumberOfThreads( numberOfThreads );
+        std::shared_ptr< CovarianceAnalysisOutput< double, double > > parallelCovarianceOutputAll =
+                orbitDeterminationManagerAll.computeCovariance( parallelCovarianceInputAll );
+
+        Eigen::MatrixXd serialDesignMatrix = covarianceOutputAll->getUnnormalizedDesignMatrix( );
+        Eigen::MatrixXd parallelDesignMatrix = parallelCovarianceOutputAll->getUnnormalizedDesignMatrix( );
+        BOOST_CHECK_EQUAL( serialDesignMatrix.rows( ), parallelDesignMatrix.rows( ) );
+        BOOST_CHECK_EQUAL( serialDesignMatrix.cols( ), parallelDesignMatrix.cols( ) );
+        for( int i = 0; i < serialDesignMatrix.rows( ); i++ )
+        {
+            for( int j = 0; j < serialDesignMatrix.cols( ); j++ )
+            {
+                BOOST_CHECK_EQUAL( serialDesignMatrix( i, j ), parallelDesignMatrix( i, j ) );
+            }
+        }
+    }
+
     // Define estimation input with consider parameters
     Eigen::VectorXd considerParametersDeviations = 0.1 * considerParametersValues;
     std::shared_ptr< EstimationInput< double, double  > > estimationInput = std::make_shared< EstimationInput< double, double > >(
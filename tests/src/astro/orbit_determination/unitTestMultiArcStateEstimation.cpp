@@ -52,7 +52,9 @@ using namespace tudat::basic_astrodynamics;
 
 template< typename ObservationScalarType = double , typename TimeType = double , typename StateScalarType  = double >
 Eigen::VectorXd  executeParameterEstimation(
-        const int linkArcs )
+        const int linkArcs,
+        const bool useBlockSparseNormalEquations = false,
+        const unsigned int numberOfThreads = 1 )
 {
     //Load spice kernels.f
     std::string kernelsPath = paths::getSpiceKernelPath( );
@@ -263,6 +265,8 @@ Eigen::VectorXd  executeParameterEstimation(
     std::shared_ptr< EstimationInput< ObservationScalarType, TimeType > > estimationInput =
             std::make_shared< EstimationInput< ObservationScalarType, TimeType > >(
                 observationsAndTimes );
+    estimationInput->setUseBlockSparseNormalEquations( useBlockSparseNormalEquations );
+    estimationInput->setNumberOfThreads( numberOfThreads );
     std::shared_ptr< CovarianceAnalysisInput< ObservationScalarType, TimeType > > covarianceInput =
             std::make_shared< CovarianceAnalysisInput< ObservationScalarType, TimeType > >(
                 observationsAndTimes );
@@ -271,11 +275,15 @@ Eigen::VectorXd  executeParameterEstimation(
                 estimationInput );
     Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > finalParameters = parametersToEstimate->template getFullParameterValues< StateScalarType >( );
 
-    parametersToEstimate->resetParameterValues( estimationOutput->parameterHistory_.at( estimationOutput->bestIteration_ ) );
-    std::shared_ptr< CovarianceAnalysisOutput< StateScalarType, TimeType > > covarianceOutput = orbitDeterminationManager.computeCovariance(
-                covarianceInput );
+    // Covariance analysis uses the full design matrix, so only compare it to the dense estimation
+    if( !useBlockSparseNormalEquations )
+    {
+        parametersToEstimate->resetParameterValues( estimationOutput->parameterHistory_.at( estimationOutput->bestIteration_ ) );
+        std::shared_ptr< CovarianceAnalysisOutput< StateScalarType, TimeType > > covarianceOutput = orbitDeterminationManager.computeCovariance(
+                    covarianceInput );
 
-    compareEstimationAndCovarianceResults( estimationOutput, covarianceOutput );
+        compareEstimationAndCovarianceResults( estimationOutput, covarianceOutput );
+    }
 
     return ( finalParameters - truthParameters ).template cast< double >( );
 }
@@ -327,6 +335,42 @@ BOOST_AUTO_TEST_CASE( test_MultiArcStateEstimation )
 
 }
 
+BOOST_AUTO_TEST_CASE( test_MultiArcStateEstimationBlockSparse )
+{
+    // Estimate separate arcs with dense normal equations, and with block-sparse (Schur complement) normal equations
+    Eigen::VectorXd denseParameterError = executeParameterEstimation< double, double, double >( 0 );
+    Eigen::VectorXd blockSparseParameterError = executeParameterEstimation< double, double, double >( 0, true, 1 );
+    Eigen::VectorXd parallelBlockSparseParameterError = executeParameterEstimation< double, double, double >( 0, true, 4 );
+
+    BOOST_CHECK_EQUAL( denseParameterError.rows( ), blockSparseParameterError.rows( ) );
+    int numberOfEstimatedArcs = ( denseParameterError.rows( ) - 3 ) / 6;
+
+    // Check that both solutions are consistent
+    for( int i = 0; i < numberOfEstimatedArcs; i++ )
+    {
+        for( unsigned int j = 0; j < 3; j++ )
+        {
+            BOOST_CHECK_SMALL( std::fabs( blockSparseParameterError( i * 6 + j ) -
+                                          denseParameterError( i * 6 + j ) ), 5.0E-2 );
+            BOOST_CHECK_SMALL( std::fabs( blockSparseParameterError( i * 6 + j + 3 ) -
+                                          denseParameterError( i * 6 + j + 3 ) ), 5.0E-8 );
+        }
+    }
+    int numberOfParameters = denseParameterError.rows( );
+    BOOST_CHECK_SMALL( std::fabs( blockSparseParameterError( numberOfParameters - 3 ) -
+                                  denseParameterError( numberOfParameters - 3 ) ), 5.0E-18 );
+    BOOST_CHECK_SMALL( std::fabs( blockSparseParameterError( numberOfParameters - 2 ) -
+                                  denseParameterError( numberOfParameters - 2 ) ), 5.0E-10 );
+    BOOST_CHECK_SMALL( std::fabs( blockSparseParameterError( numberOfParameters - 1 ) -
+                                  denseParameterError( numberOfParameters - 1 ) ), 5.0E-10 );
+
+    // Check that block-sparse normal equations are independent of the number of threads
+    for( int i = 0; i < numberOfParameters; i++ )
+    {
+        BOOST_CHECK_EQUAL( blockSparseParameterError( i ), parallelBlockSparseParameterError( i ) );
+    }
+}
+
 template< typename ObservationScalarType = double , typename TimeType = double , typename StateScalarType  = double >
 Eigen::VectorXd  executeMultiBodyMultiArcParameterEstimation( )
 {
@@ -0,0 +1,233 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <string>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/simulation/simulation.h"
+#include "tudat/astro/observation_models/linkTypeDefs.h"
+#include "tudat/simulation/estimation_setup/simulateObservations.h"
+#include "tudat/simulation/estimation_setup/orbitDeterminationManager.h"
+#include "tudat/simulation/environment_setup/createGroundStations.h"
+#include "tudat/simulation/environment_setup/createBodyDeformationModel.h"
+#include "tudat/simulation/estimation_setup/podProcessing.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+BOOST_AUTO_TEST_SUITE( test_parallel_estimation )
+
+//Using declarations.
+using namespace tudat;
+using namespace tudat::observation_models;
+using namespace tudat::orbit_determination;
+using namespace tudat::estimatable_parameters;
+using namespace tudat::numerical_integrators;
+using namespace tudat::simulation_setup;
+using namespace tudat::orbital_element_conversions;
+using namespace tudat::ephemerides;
+using namespace tudat::propagators;
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::coordinate_conversions;
+
+//! Run an estimation of an Earth orbiter from ground station data, computing the observations and partials with given number of
+//! threads, and return the estimation output.
+std::shared_ptr< EstimationOutput< double, double > > executeGroundStationEstimation( const unsigned int numberOfThreads )
+{
+    //Load spice kernels.
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Define bodies in simulation
+    std::vector< std::string > bodyNames = { "Earth", "Sun", "Moon" };
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 86400.0;
+
+    // Create bodies, using full GCRS-ITRS Earth rotation (with time scale conversions) and tidal deformation of the stations
+    BodyListSettings bodySettings = getDefaultBodySettings( bodyNames, "Earth", "J2000" );
+    bodySettings.at( "Earth" )->rotationModelSettings = gcrsToItrsRotationModelSettings(
+                basic_astrodynamics::iau_2006, "J2000" );
+    bodySettings.at( "Earth" )->bodyDeformationSettings.push_back(
+                degreeTwoBasicTidalBodyShapeDeformation( { "Sun", "Moon" }, 0.6, 0.08 ) );
+    SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Vehicle" )->setEphemeris( std::make_shared< TabulatedCartesianEphemeris< > >(
+                                            std::shared_ptr< interpolators::OneDimensionalInterpolator
+                                            < double, Eigen::Vector6d > >( ), "Earth", "J2000" ) );
+
+    // Create ground stations
+    std::vector< std::string > groundStationNames = { "Station1", "Station2", "Station3" };
+    createGroundStation( bodies.at( "Earth" ), "Station1", ( Eigen::Vector3d( ) << 0.0, 0.35, 0.0 ).finished( ), geodetic_position );
+    createGroundStation( bodies.at( "Earth" ), "Station2", ( Eigen::Vector3d( ) << 0.0, -0.55, 2.0 ).finished( ), geodetic_position );
+    createGroundStation( bodies.at( "Earth" ), "Station3", ( Eigen::Vector3d( ) << 0.0, 0.05, 4.0 ).finished( ), geodetic_position );
+
+    // Set accelerations on Vehicle that are to be taken into account.
+    SelectedAccelerationMap accelerationMap;
+    std::map< std::string, std::vector< std::shared_ptr< AccelerationSettings > > > accelerationsOfVehicle;
+    accelerationsOfVehicle[ "Earth" ].push_back( sphericalHarmonicAcceleration( 4, 4 ) );
+    accelerationsOfVehicle[ "Sun" ].push_back( pointMassGravityAcceleration( ) );
+    accelerationsOfVehicle[ "Moon" ].push_back( pointMassGravityAcceleration( ) );
+    accelerationMap[ "Vehicle" ] = accelerationsOfVehicle;
+
+    std::vector< std::string > bodiesToIntegrate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodies, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    // Set initial state
+    Eigen::Vector6d initialStateInKeplerianElements;
+    initialStateInKeplerianElements( semiMajorAxisIndex ) = 7200.0E3;
+    initialStateInKeplerianElements( eccentricityIndex ) = 0.05;
+    initialStateInKeplerianElements( inclinationIndex ) = unit_conversions::convertDegreesToRadians( 85.3 );
+    initialStateInKeplerianElements( argumentOfPeriapsisIndex ) = unit_conversions::convertDegreesToRadians( 235.7 );
+    initialStateInKeplerianElements( longitudeOfAscendingNodeIndex ) = unit_conversions::convertDegreesToRadians( 23.4 );
+    initialStateInKeplerianElements( trueAnomalyIndex ) = unit_conversions::convertDegreesToRadians( 139.87 );
+    Eigen::Vector6d systemInitialState = convertKeplerianToCartesianElements(
+                initialStateInKeplerianElements, bodies.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( ) );
+
+    // Create propagator settings
+    std::shared_ptr< TranslationalStatePropagatorSettings< double, double > > propagatorSettings =
+            translationalStatePropagatorSettings< double, double >(
+                centralBodies, accelerationModelMap, bodiesToIntegrate, systemInitialState, initialEphemerisTime,
+                rungeKuttaFixedStepSettings< double >( 40.0, rungeKuttaFehlberg78 ),
+                propagationTimeTerminationSettings( finalEphemerisTime ) );
+
+    // Define link ends
+    std::map< ObservableType, std::vector< LinkEnds > > linkEndsPerObservable;
+    for( unsigned int i = 0; i < groundStationNames.size( ); i++ )
+    {
+        LinkEnds uplinkLinkEnds;
+        uplinkLinkEnds[ transmitter ] = LinkEndId( "Earth", groundStationNames.at( i ) );
+        uplinkLinkEnds[ receiver ] = LinkEndId( "Vehicle", "" );
+
+        LinkEnds downlinkLinkEnds;
+        downlinkLinkEnds[ receiver ] = LinkEndId( "Earth", groundStationNames.at( i ) );
+        downlinkLinkEnds[ transmitter ] = LinkEndId( "Vehicle", "" );
+
+        linkEndsPerObservable[ one_way_range ].push_back( downlinkLinkEnds );
+        linkEndsPerObservable[ one_way_range ].push_back( uplinkLinkEnds );
+        linkEndsPerObservable[ one_way_doppler ].push_back( downlinkLinkEnds );
+        linkEndsPerObservable[ angular_position ].push_back( downlinkLinkEnds );
+    }
+
+    std::vector< std::shared_ptr< ObservationModelSettings > > observationSettingsList;
+    for( auto linkEndIterator : linkEndsPerObservable )
+    {
+        for( unsigned int i = 0; i < linkEndIterator.second.size( ); i++ )
+        {
+            observationSettingsList.push_back( std::make_shared< ObservationModelSettings >(
+                                                   linkEndIterator.first, linkEndIterator.second.at( i ) ) );
+        }
+    }
+
+    // Define parameters
+    std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    parameterNames.push_back(
+                std::make_shared< InitialTranslationalStateEstimatableParameterSettings< double > >(
+                    "Vehicle", systemInitialState, "Earth", "J2000" ) );
+    parameterNames.push_back( std::make_shared< EstimatableParameterSettings >(
+                                  "Earth", ground_station_position, "Station1" ) );
+    parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+    std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate =
+            createParametersToEstimate< double, double >( parameterNames, bodies );
+
+    // Create orbit determination object.
+    OrbitDeterminationManager< double, double > orbitDeterminationManager =
+            OrbitDeterminationManager< double, double >(
+                bodies, parametersToEstimate, observationSettingsList, propagatorSettings );
+
+    // Simulate observations
+    std::vector< double > baseTimeList;
+    for( unsigned int i = 0; i < 1000; i++ )
+    {
+        baseTimeList.push_back( initialEphemerisTime + 1000.0 + static_cast< double >( i ) * 60.0 );
+    }
+    std::vector< std::shared_ptr< ObservationSimulationSettings< double > > > measurementSimulationInput =
+            getObservationSimulationSettings< double >( linkEndsPerObservable, baseTimeList, receiver );
+    std::shared_ptr< ObservationCollection< double, double > > simulatedObservations =
+            simulateObservations< double, double >(
+                measurementSimulationInput, orbitDeterminationManager.getObservationSimulators( ), bodies );
+
+    // Perturb parameter estimate
+    Eigen::VectorXd initialParameterEstimate = parametersToEstimate->template getFullParameterValues< double >( );
+    initialParameterEstimate.segment( 0, 3 ) += Eigen::Vector3d::Constant( 1.0 );
+    initialParameterEstimate.segment( 3, 3 ) += Eigen::Vector3d::Constant( 1.0E-3 );
+    initialParameterEstimate.segment( 6, 3 ) += Eigen::Vector3d::Constant( 0.1 );
+    parametersToEstimate->resetParameterValues( initialParameterEstimate );
+
+    // Define estimation input
+    std::shared_ptr< EstimationInput< double, double > > estimationInput =
+            std::make_shared< EstimationInput< double, double > >(
+                simulatedObservations, Eigen::MatrixXd::Zero( 0, 0 ),
+                std::make_shared< EstimationConvergenceChecker >( 3 ) );
+
+    std::map< observation_models::ObservableType, double > weightPerObservable;
+    weightPerObservable[ one_way_range ] = 1.0;
+    weightPerObservable[ angular_position ] = 1.0 / ( 1.0E-5 * 1.0E-5 );
+    weightPerObservable[ one_way_doppler ] = 1.0 / ( 1.0E-11 * 1.0E-11 * physical_constants::SPEED_OF_LIGHT *
+                                                     physical_constants::SPEED_OF_LIGHT );
+    estimationInput->setConstantPerObservableWeightsMatrix( weightPerObservable );
+    estimationInput->setNumberOfThreads( numberOfThreads );
+
+    // Perform estimation
+    return orbitDeterminationManager.estimateParameters( estimationInput );
+}
+
+//! Test whether an estimation from ground station data, with observations and partials computed in parallel, reproduces the
+//! serial results (which requires all environment models used in the observation models to be thread-safe)
+BOOST_AUTO_TEST_CASE( test_ParallelGroundStationEstimation )
+{
+    std::shared_ptr< EstimationOutput< double, double > > serialEstimationOutput = executeGroundStationEstimation( 1 );
+    std::shared_ptr< EstimationOutput< double, double > > parallelEstimationOutput = executeGroundStationEstimation( 4 );
+
+    // Check that residuals are identical for all iterations
+    Eigen::MatrixXd serialResiduals = serialEstimationOutput->getResidualHistoryMatrix( );
+    Eigen::MatrixXd parallelResiduals = parallelEstimationOutput->getResidualHistoryMatrix( );
+    BOOST_CHECK_EQUAL( serialResiduals.rows( ), parallelResiduals.rows( ) );
+    BOOST_CHECK_EQUAL( serialResiduals.cols( ), parallelResiduals.cols( ) );
+    for( int i = 0; i < serialResiduals.rows( ); i++ )
+    {
+        for( int j = 0; j < serialResiduals.cols( ); j++ )
+        {
+            BOOST_CHECK_EQUAL( serialResiduals( i, j ), parallelResiduals( i, j ) );
+        }
+    }
+
+    // Check that design matrices and parameter estimates are identical
+    Eigen::MatrixXd serialDesignMatrix = serialEstimationOutput->getUnnormalizedDesignMatrix( );
+    Eigen::MatrixXd parallelDesignMatrix = parallelEstimationOutput->getUnnormalizedDesignMatrix( );
+    for( int i = 0; i < serialDesignMatrix.rows( ); i++ )
+    {
+        for( int j = 0; j < serialDesignMatrix.cols( ); j++ )
+        {
+            BOOST_CHECK_EQUAL( serialDesignMatrix( i, j ), parallelDesignMatrix( i, j ) );
+        }
+    }
+
+    for( int i = 0; i < serialEstimationOutput->parameterEstimate_.rows( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( serialEstimationOutput->parameterEstimate_( i ),
+                           parallelEstimationOutput->parameterEstimate_( i ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+}
+
+}
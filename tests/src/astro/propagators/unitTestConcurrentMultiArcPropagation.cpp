@@ -0,0 +1,217 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/simulation/simulation.h"
+#include "tudat/simulation/estimation_setup/variationalEquationsSolver.h"
+#include "tudat/simulation/estimation_setup/createEstimatableParameters.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+using namespace tudat::estimatable_parameters;
+
+BOOST_AUTO_TEST_SUITE( test_concurrent_multi_arc_propagation )
+
+//! Function to create the bodies for the test (point-mass Earth and empty vehicle), without any use of Spice
+SystemOfBodies createConcurrentMultiArcTestBodies( )
+{
+    SystemOfBodies bodies( "Earth", "ECLIPJ2000" );
+    bodies.createEmptyBody( "Earth" );
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Earth" )->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                            [ ]( ){ return Eigen::Vector6d::Zero( ); }, "Earth" ) );
+    bodies.at( "Earth" )->setGravityFieldModel( std::make_shared< gravitation::GravityFieldModel >( 3.986004418E14 ) );
+    return bodies;
+}
+
+//! Function to create the multi-arc propagator settings for the test, with the acceleration models of arc i created from
+//! arcWiseBodies.at( i )
+std::shared_ptr< MultiArcPropagatorSettings< double, double > > createConcurrentMultiArcTestPropagatorSettings(
+        const std::vector< SystemOfBodies >& arcWiseBodies,
+        const std::vector< double >& arcStartTimes )
+{
+    SelectedAccelerationMap accelerationSettings;
+    accelerationSettings[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >(
+                                                                basic_astrodynamics::point_mass_gravity ) );
+
+    std::vector< std::shared_ptr< SingleArcPropagatorSettings< double, double > > > arcPropagatorSettings;
+    for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+    {
+        basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    arcWiseBodies.at( i ), accelerationSettings, { "Vehicle" }, { "Earth" } );
+
+        Eigen::Vector6d initialKeplerElements;
+        initialKeplerElements << 7.0E6 + 1.0E4 * static_cast< double >( i ), 0.01, 1.0, 0.2, 0.3,
+                0.5 * static_cast< double >( i );
+        Eigen::VectorXd initialState = convertKeplerianToCartesianElements( initialKeplerElements, 3.986004418E14 );
+
+        arcPropagatorSettings.push_back(
+                    std::make_shared< TranslationalStatePropagatorSettings< double, double > >(
+                        std::vector< std::string >{ "Earth" }, accelerationModelMap, std::vector< std::string >{ "Vehicle" },
+                        initialState, arcStartTimes.at( i ), rungeKutta4Settings( 10.0 ),
+                        std::make_shared< PropagationTimeTerminationSettings >( arcStartTimes.at( i ) + 7200.0 ), cowell ) );
+    }
+
+    std::shared_ptr< MultiArcPropagatorSettings< double, double > > multiArcSettings =
+            std::make_shared< MultiArcPropagatorSettings< double, double > >( arcPropagatorSettings );
+    multiArcSettings->getOutputSettings( )->setClearNumericalSolutions( false );
+    return multiArcSettings;
+}
+
+//! Test whether concurrent multi-arc propagation reproduces serial multi-arc propagation
+BOOST_AUTO_TEST_CASE( testConcurrentMultiArcDynamics )
+{
+    const std::vector< double > arcStartTimes = { 0.0, 1.0E4, 2.0E4, 3.0E4, 4.0E4, 5.0E4, 6.0E4 };
+    const int numberOfArcs = arcStartTimes.size( );
+
+    // Propagate arcs serially, using a single environment
+    SystemOfBodies serialBodies = createConcurrentMultiArcTestBodies( );
+    MultiArcDynamicsSimulator< double, double > serialSimulator(
+                serialBodies, createConcurrentMultiArcTestPropagatorSettings(
+                    std::vector< SystemOfBodies >( numberOfArcs, serialBodies ), arcStartTimes ) );
+    std::vector< std::map< double, Eigen::VectorXd > > serialStateHistories =
+            serialSimulator.getMultiArcPropagationResults( )->getConcatenatedEquationsOfMotionResults( );
+
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads += 3 )
+    {
+        // Propagate arcs concurrently, using an environment per arc
+        SystemOfBodies bodies = createConcurrentMultiArcTestBodies( );
+        std::vector< SystemOfBodies > arcWiseBodies;
+        for( int i = 0; i < numberOfArcs; i++ )
+        {
+            arcWiseBodies.push_back( createConcurrentMultiArcTestBodies( ) );
+        }
+        std::shared_ptr< MultiArcPropagatorSettings< double, double > > propagatorSettings =
+                createConcurrentMultiArcTestPropagatorSettings( arcWiseBodies, arcStartTimes );
+        propagatorSettings->setConcurrentArcPropagation( arcWiseBodies, numberOfThreads );
+
+        MultiArcDynamicsSimulator< double, double > concurrentSimulator( bodies, propagatorSettings );
+        std::vector< std::map< double, Eigen::VectorXd > > concurrentStateHistories =
+                concurrentSimulator.getMultiArcPropagationResults( )->getConcatenatedEquationsOfMotionResults( );
+
+        // Check that results are identical, and stored in order of arcs
+        BOOST_CHECK_EQUAL( concurrentStateHistories.size( ), serialStateHistories.size( ) );
+        for( int i = 0; i < numberOfArcs; i++ )
+        {
+            BOOST_CHECK_EQUAL( concurrentStateHistories.at( i ).begin( )->first, arcStartTimes.at( i ) );
+            BOOST_CHECK_EQUAL( concurrentStateHistories.at( i ).size( ), serialStateHistories.at( i ).size( ) );
+            for( auto stateIterator : serialStateHistories.at( i ) )
+            {
+                BOOST_CHECK_EQUAL( ( concurrentStateHistories.at( i ).at( stateIterator.first ) -
+                                     stateIterator.second ).cwiseAbs( ).maxCoeff( ), 0.0 );
+            }
+        }
+
+        // Check that results are set in the environment provided to the simulator
+        for( int i = 0; i < numberOfArcs; i++ )
+        {
+            double testTime = arcStartTimes.at( i ) + 3600.0;
+            BOOST_CHECK_EQUAL( ( bodies.at( "Vehicle" )->getEphemeris( )->getCartesianState( testTime ) -
+                                 serialBodies.at( "Vehicle" )->getEphemeris( )->getCartesianState( testTime ) ).
+                               cwiseAbs( ).maxCoeff( ), 0.0 );
+        }
+    }
+
+    // Check that concurrent propagation is rejected when initial states are transferred between arcs, or when the number
+    // of environments is inconsistent
+    {
+        SystemOfBodies bodies = createConcurrentMultiArcTestBodies( );
+        std::vector< SystemOfBodies > arcWiseBodies( numberOfArcs, bodies );
+        std::shared_ptr< MultiArcPropagatorSettings< double, double > > propagatorSettings =
+                createConcurrentMultiArcTestPropagatorSettings( arcWiseBodies, arcStartTimes );
+        std::shared_ptr< MultiArcPropagatorSettings< double, double > > transferringPropagatorSettings =
+                std::make_shared< MultiArcPropagatorSettings< double, double > >(
+                    propagatorSettings->getSingleArcSettings( ), true );
+
+        BOOST_CHECK_THROW( transferringPropagatorSettings->setConcurrentArcPropagation( arcWiseBodies ),
+                           std::runtime_error );
+        BOOST_CHECK_THROW( propagatorSettings->setConcurrentArcPropagation(
+                               std::vector< SystemOfBodies >( numberOfArcs - 1, bodies ) ), std::runtime_error );
+    }
+}
+
+//! Test whether concurrent multi-arc propagation of variational equations reproduces serial propagation
+BOOST_AUTO_TEST_CASE( testConcurrentMultiArcVariationalEquations )
+{
+    const std::vector< double > arcStartTimes = { 0.0, 1.0E4, 2.0E4, 3.0E4, 4.0E4 };
+    const int numberOfArcs = arcStartTimes.size( );
+
+    // Propagate arcs serially, using a single environment
+    SystemOfBodies serialBodies = createConcurrentMultiArcTestBodies( );
+    std::shared_ptr< MultiArcPropagatorSettings< double, double > > serialPropagatorSettings =
+            createConcurrentMultiArcTestPropagatorSettings(
+                std::vector< SystemOfBodies >( numberOfArcs, serialBodies ), arcStartTimes );
+    MultiArcVariationalEquationsSolver< double, double > serialSolver(
+                serialBodies, serialPropagatorSettings,
+                createParametersToEstimate< double, double >(
+                    getInitialStateParameterSettings< double, double >(
+                        serialPropagatorSettings, serialBodies, arcStartTimes ), serialBodies ), true );
+
+    // Propagate arcs concurrently, using an environment per arc
+    SystemOfBodies bodies = createConcurrentMultiArcTestBodies( );
+    std::vector< SystemOfBodies > arcWiseBodies;
+    for( int i = 0; i < numberOfArcs; i++ )
+    {
+        arcWiseBodies.push_back( createConcurrentMultiArcTestBodies( ) );
+    }
+    std::shared_ptr< MultiArcPropagatorSettings< double, double > > propagatorSettings =
+            createConcurrentMultiArcTestPropagatorSettings( arcWiseBodies, arcStartTimes );
+    propagatorSettings->setConcurrentArcPropagation( arcWiseBodies, 3 );
+    MultiArcVariationalEquationsSolver< double, double > concurrentSolver(
+                bodies, propagatorSettings,
+                createParametersToEstimate< double, double >(
+                    getInitialStateParameterSettings< double, double >(
+                        propagatorSettings, bodies, arcStartTimes ), bodies ), true );
+
+    // Check that state transition matrices are identical
+    for( int i = 0; i < numberOfArcs; i++ )
+    {
+        std::map< double, Eigen::MatrixXd >& serialStateTransitionMatrices =
+                serialSolver.getMultiArcVariationalPropagationResults( )->getSingleArcResults( ).at( i )->
+                getStateTransitionSolution( );
+        std::map< double, Eigen::MatrixXd >& concurrentStateTransitionMatrices =
+                concurrentSolver.getMultiArcVariationalPropagationResults( )->getSingleArcResults( ).at( i )->
+                getStateTransitionSolution( );
+
+        BOOST_CHECK_EQUAL( concurrentStateTransitionMatrices.size( ), serialStateTransitionMatrices.size( ) );
+        for( auto matrixIterator : serialStateTransitionMatrices )
+        {
+            BOOST_CHECK_EQUAL( ( concurrentStateTransitionMatrices.at( matrixIterator.first ) -
+                                 matrixIterator.second ).cwiseAbs( ).maxCoeff( ), 0.0 );
+        }
+    }
+
+    // Check that estimation of environment-dependent parameters is rejected for concurrent propagation
+    std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterSettings =
+            getInitialStateParameterSettings< double, double >( propagatorSettings, bodies, arcStartTimes );
+    parameterSettings.push_back( std::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+    BOOST_CHECK_THROW( MultiArcVariationalEquationsSolver< double >(
+                           bodies, propagatorSettings, createParametersToEstimate< double, double >(
+                               parameterSettings, bodies ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,140 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/astro/basic_astro/keplerPropagator.h"
+#include "tudat/simulation/simulation.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_dense_output_ephemeris )
+
+//! Function to create the bodies for the test (point-mass Earth and empty vehicle), without any use of Spice
+SystemOfBodies createDenseOutputTestBodies( )
+{
+    SystemOfBodies bodies( "Earth", "ECLIPJ2000" );
+    bodies.createEmptyBody( "Earth" );
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Earth" )->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                            [ ]( ){ return Eigen::Vector6d::Zero( ); }, "Earth" ) );
+    bodies.at( "Earth" )->setGravityFieldModel( std::make_shared< gravitation::GravityFieldModel >( 3.986004418E14 ) );
+    return bodies;
+}
+
+//! Test whether the integrated ephemeris is reset from the dense output of the integrator, if requested
+BOOST_AUTO_TEST_CASE( testDenseOutputEphemeris )
+{
+    const double earthGravitationalParameter = 3.986004418E14;
+    Eigen::Vector6d initialKeplerElements;
+    initialKeplerElements << 7.5E6, 0.1, 1.0, 0.2, 0.3, 0.4;
+
+    for( unsigned int test = 0; test < 2; test++ )
+    {
+        const bool storeDenseOutput = ( test == 0 );
+
+        SystemOfBodies bodies = createDenseOutputTestBodies( );
+        SelectedAccelerationMap accelerationSettings;
+        accelerationSettings[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >(
+                                                                    basic_astrodynamics::point_mass_gravity ) );
+        basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodies, accelerationSettings, { "Vehicle" }, { "Earth" } );
+
+        std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+                rungeKuttaVariableStepSettingsScalarTolerances< double >(
+                    10.0, rungeKutta87DormandPrince, 1.0E-3, 1.0E4, 1.0E-12, 1.0E-12 );
+        integratorSettings->storeDenseOutput_ = storeDenseOutput;
+
+        std::shared_ptr< TranslationalStatePropagatorSettings< double, double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double, double > >(
+                    std::vector< std::string >{ "Earth" }, accelerationModelMap, std::vector< std::string >{ "Vehicle" },
+                    convertKeplerianToCartesianElements( initialKeplerElements, earthGravitationalParameter ),
+                    0.0, integratorSettings, std::make_shared< PropagationTimeTerminationSettings >( 86400.0 ), cowell );
+        propagatorSettings->getOutputSettings( )->setIntegratedResult( true );
+        propagatorSettings->getOutputSettings( )->setClearNumericalSolutions( false );
+
+        SingleArcDynamicsSimulator< double, double > dynamicsSimulator( bodies, propagatorSettings );
+        std::map< double, Eigen::VectorXd > stateHistory =
+                dynamicsSimulator.getSingleArcPropagationResults( )->getEquationsOfMotionNumericalSolution( );
+
+        // Check that the dense output is used for the ephemeris only if requested
+        std::shared_ptr< ephemerides::TabulatedCartesianEphemeris< double, double > > vehicleEphemeris =
+                std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< double, double > >(
+                    bodies.at( "Vehicle" )->getEphemeris( ) );
+        BOOST_CHECK( vehicleEphemeris != nullptr );
+        BOOST_CHECK_EQUAL( vehicleEphemeris->getInterpolator( )->getInterpolatorType( ) ==
+                           interpolators::runge_kutta_dense_output_interpolator, storeDenseOutput );
+        if( !storeDenseOutput )
+        {
+            continue;
+        }
+
+        // Check that the ephemeris reproduces the integrated states, and determine the error w.r.t. Kepler orbit
+        double maximumPositionErrorAtSteps = 0.0;
+        double maximumVelocityErrorAtSteps = 0.0;
+        for( auto stateIterator : stateHistory )
+        {
+            Eigen::Vector6d ephemerisState = bodies.at( "Vehicle" )->getEphemeris( )->getCartesianState(
+                        stateIterator.first );
+            BOOST_CHECK_SMALL( ( ephemerisState - stateIterator.second ).segment( 0, 3 ).norm( ), 1.0E-6 );
+            BOOST_CHECK_SMALL( ( ephemerisState - stateIterator.second ).segment( 3, 3 ).norm( ), 1.0E-8 );
+
+            Eigen::Vector6d keplerState = convertKeplerianToCartesianElements(
+                        propagateKeplerOrbit( initialKeplerElements, stateIterator.first, earthGravitationalParameter ),
+                        earthGravitationalParameter );
+            maximumPositionErrorAtSteps = std::max(
+                        maximumPositionErrorAtSteps, ( stateIterator.second - keplerState ).segment( 0, 3 ).norm( ) );
+            maximumVelocityErrorAtSteps = std::max(
+                        maximumVelocityErrorAtSteps, ( stateIterator.second - keplerState ).segment( 3, 3 ).norm( ) );
+        }
+
+        // Check that the ephemeris in between the integrator steps is as accurate as the integrated states
+        for( auto stateIterator = stateHistory.begin( ); std::next( stateIterator ) != stateHistory.end( ); stateIterator++ )
+        {
+            double testTime = ( stateIterator->first + std::next( stateIterator )->first ) / 2.0;
+            Eigen::Vector6d ephemerisState = bodies.at( "Vehicle" )->getEphemeris( )->getCartesianState( testTime );
+            Eigen::Vector6d keplerState = convertKeplerianToCartesianElements(
+                        propagateKeplerOrbit( initialKeplerElements, testTime, earthGravitationalParameter ),
+                        earthGravitationalParameter );
+            BOOST_CHECK_SMALL( ( ephemerisState - keplerState ).segment( 0, 3 ).norm( ),
+                               maximumPositionErrorAtSteps + 1.0E-3 );
+            BOOST_CHECK_SMALL( ( ephemerisState - keplerState ).segment( 3, 3 ).norm( ),
+                               maximumVelocityErrorAtSteps + 1.0E-6 );
+        }
+    }
+
+    // Check that storage of dense output is rejected for integrators that do not provide it
+    std::shared_ptr< IntegratorSettings< double > > fixedStepSettings = rungeKutta4Settings< double >( 10.0 );
+    fixedStepSettings->storeDenseOutput_ = true;
+    BOOST_CHECK_THROW( ( createIntegrator< double, Eigen::Vector6d, double >(
+                             [ ]( const double, const Eigen::Vector6d& state ){ return state; },
+                             Eigen::Vector6d::Zero( ), 0.0, fixedStepSettings ) ), std::runtime_error );
+
+    // Check that the flag is retained when cloning the settings
+    BOOST_CHECK( fixedStepSettings->clone( )->storeDenseOutput_ );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
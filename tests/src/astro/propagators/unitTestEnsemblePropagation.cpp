@@ -0,0 +1,122 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/simulation/simulation.h"
+#include "tudat/simulation/propagation_setup/ensemblePropagation.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_ensemble_propagation )
+
+//! Function to create the bodies for the test ensemble (point-mass Earth and empty vehicle)
+SystemOfBodies createEnsembleTestBodies( )
+{
+    SystemOfBodies bodies( "Earth", "ECLIPJ2000" );
+    bodies.createEmptyBody( "Earth" );
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Earth" )->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                            [ ]( ){ return Eigen::Vector6d::Zero( ); }, "Earth" ) );
+    bodies.at( "Earth" )->setGravityFieldModel( std::make_shared< gravitation::GravityFieldModel >( 3.986004418E14 ) );
+    return bodies;
+}
+
+//! Function to create the propagation settings of a single run of the test ensemble, with dispersed initial state and
+//! Earth gravitational parameter
+std::shared_ptr< SingleArcPropagatorSettings< double, double > > createEnsembleTestPropagatorSettings(
+        const int runIndex, const SystemOfBodies& bodies )
+{
+    const double earthGravitationalParameter = 3.986004418E14 * ( 1.0 + 1.0E-6 * static_cast< double >( runIndex ) );
+    bodies.at( "Earth" )->getGravityFieldModel( )->resetGravitationalParameter( earthGravitationalParameter );
+
+    SelectedAccelerationMap accelerationSettings;
+    accelerationSettings[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >(
+                                                                basic_astrodynamics::point_mass_gravity ) );
+    basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodies, accelerationSettings, { "Vehicle" }, { "Earth" } );
+
+    Eigen::Vector6d initialKeplerElements;
+    initialKeplerElements << 7.0E6 + 1.0E3 * static_cast< double >( runIndex ), 0.01, 1.0, 0.2, 0.3,
+            0.01 * static_cast< double >( runIndex );
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, 3.986004418E14 );
+
+    return std::make_shared< TranslationalStatePropagatorSettings< double, double > >(
+                std::vector< std::string >{ "Earth" }, accelerationModelMap, std::vector< std::string >{ "Vehicle" },
+                initialState, 0.0, rungeKutta4Settings( 10.0 ),
+                std::make_shared< PropagationTimeTerminationSettings >( 3600.0 ), cowell,
+                std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > >{
+                    relativeDistanceDependentVariable( "Vehicle", "Earth" ) } );
+}
+
+//! Test whether ensemble propagation (serial and multi-threaded) reproduces individual propagations
+BOOST_AUTO_TEST_CASE( testSingleArcEnsemblePropagation )
+{
+    const int numberOfRuns = 13;
+
+    // Propagate each run individually, with its own bodies
+    std::vector< Eigen::VectorXd > expectedFinalStates;
+    for( int i = 0; i < numberOfRuns; i++ )
+    {
+        SystemOfBodies bodies = createEnsembleTestBodies( );
+        SingleArcDynamicsSimulator< double, double > dynamicsSimulator(
+                    bodies, createEnsembleTestPropagatorSettings( i, bodies ) );
+        expectedFinalStates.push_back(
+                    dynamicsSimulator.getSingleArcPropagationResults( )->getContiguousEquationsOfMotionNumericalSolution( ).getEntry(
+                        dynamicsSimulator.getSingleArcPropagationResults( )->getContiguousEquationsOfMotionNumericalSolution( ).size( ) - 1 ) );
+    }
+
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads++ )
+    {
+        std::vector< int > numberOfEntries( numberOfRuns, 0 );
+        std::shared_ptr< SingleArcEnsembleResults< double, double > > ensembleResults =
+                propagateSingleArcEnsemble< double, double >(
+                    &createEnsembleTestBodies, &createEnsembleTestPropagatorSettings, numberOfRuns, numberOfThreads,
+                    [ & ]( const int runIndex, const std::shared_ptr< SingleArcSimulationResults< double, double > > results )
+        {
+            numberOfEntries[ runIndex ] = results->getContiguousEquationsOfMotionNumericalSolution( ).size( );
+        } );
+
+        BOOST_CHECK_EQUAL( ensembleResults->getNumberOfRuns( ), numberOfRuns );
+        BOOST_CHECK_EQUAL( ensembleResults->getFinalStates( ).rows( ), 6 );
+        BOOST_CHECK_EQUAL( ensembleResults->getFinalDependentVariables( ).rows( ), 1 );
+
+        for( int i = 0; i < numberOfRuns; i++ )
+        {
+            BOOST_CHECK( ensembleResults->integrationCompletedSuccessfully( i ) );
+            BOOST_CHECK_EQUAL( numberOfEntries.at( i ), 361 );
+            BOOST_CHECK_EQUAL( ensembleResults->getFinalTimes( ).at( i ), 3600.0 );
+
+            // Results must be identical to those of individual propagation, irrespective of thread on which run is done
+            BOOST_CHECK( Eigen::VectorXd( ensembleResults->getFinalStates( ).col( i ) ) == expectedFinalStates.at( i ) );
+            BOOST_CHECK_CLOSE_FRACTION( ensembleResults->getFinalDependentVariables( )( 0, i ),
+                                        expectedFinalStates.at( i ).segment( 0, 3 ).norm( ), 1.0E-15 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,175 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/massRateModel.h"
+#include "tudat/astro/gravitation/centralGravityModel.h"
+#include "tudat/astro/propagators/bodyMassStateDerivative.h"
+#include "tudat/astro/propagators/dynamicsStateDerivativeModel.h"
+#include "tudat/astro/propagators/nBodyCowellStateDerivative.h"
+#include "tudat/math/integrators/createNumericalIntegrator.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+
+#include "tudat/support/heapAllocationCounter.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::numerical_integrators;
+using namespace tudat::propagators;
+
+BOOST_AUTO_TEST_SUITE( test_fixed_size_state_propagation )
+
+//! Object containing the state derivative model of a point-mass orbit about the Earth, optionally with mass propagation.
+struct SingleBodyStateDerivativeModel
+{
+    SingleBodyStateDerivativeModel( const bool propagateMass )
+    {
+        std::shared_ptr< Eigen::Vector6d > vehicleState = currentVehicleState;
+
+        basic_astrodynamics::AccelerationMap accelerationMap;
+        accelerationMap[ "Vehicle" ][ "Earth" ].push_back(
+                    std::make_shared< gravitation::CentralGravitationalAccelerationModel3d >(
+                        [ = ]( Eigen::Vector3d& position ){ position = vehicleState->segment( 0, 3 ); },
+                        3.986004418E14,
+                        [ ]( Eigen::Vector3d& position ){ position.setZero( ); } ) );
+
+        std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > stateDerivativeModels;
+        stateDerivativeModels.push_back(
+                    std::make_shared< NBodyCowellStateDerivative< double, double > >(
+                        accelerationMap, std::make_shared< CentralBodyData< double, double > >(
+                            std::vector< std::string >( { "Earth" } ), std::vector< std::string >( { "Vehicle" } ),
+                            std::map< std::string, std::function< Eigen::Vector6d( const double ) > >( ),
+                            [ ]( const double ){ return Eigen::Vector6d::Zero( ).eval( ); }, "Earth" ),
+                        std::vector< std::string >( { "Vehicle" } ) ) );
+        if( propagateMass )
+        {
+            std::map< std::string, std::shared_ptr< basic_astrodynamics::MassRateModel > > massRateModels;
+            massRateModels[ "Vehicle" ] = std::make_shared< basic_astrodynamics::CustomMassRateModel >(
+                        [ ]( const double ){ return -1.0E-3; } );
+            stateDerivativeModels.push_back(
+                        std::make_shared< BodyMassStateDerivative< double, double > >(
+                            massRateModels, std::vector< std::string >( { "Vehicle" } ) ) );
+        }
+
+        model = std::make_shared< DynamicsStateDerivativeModel< double, double > >(
+                    stateDerivativeModels,
+                    [ = ]( const double, const std::unordered_map< IntegratedStateType, Eigen::VectorXd >& currentStates,
+                    const std::vector< IntegratedStateType >& )
+        {
+            *vehicleState = currentStates.at( translational_state );
+        } );
+        model->setPropagationSettings( std::vector< IntegratedStateType >( ), true, false );
+    }
+
+    std::shared_ptr< Eigen::Vector6d > currentVehicleState = std::make_shared< Eigen::Vector6d >( );
+
+    std::shared_ptr< DynamicsStateDerivativeModel< double, double > > model;
+};
+
+//! Function to perform a given number of steps, and return the number of heap allocations during these steps.
+template< typename StateType >
+unsigned long long getNumberOfHeapAllocationsDuringSteps(
+        const std::shared_ptr< NumericalIntegrator< double, StateType, StateType, double > > integrator,
+        const int numberOfSteps )
+{
+    unsigned long long initialNumberOfHeapAllocations = numberOfHeapAllocations;
+    for( int i = 0; i < numberOfSteps; i++ )
+    {
+        integrator->performIntegrationStep( integrator->getNextStepSize( ) );
+    }
+    return numberOfHeapAllocations - initialNumberOfHeapAllocations;
+}
+
+//! Test whether dynamics with a fixed-size state is integrated identically, and without heap allocation per step.
+template< int NumberOfRows >
+void testFixedSizeStateIntegration( const std::shared_ptr< IntegratorSettings< double > > integratorSettings )
+{
+    typedef Eigen::Matrix< double, NumberOfRows, 1 > FixedSizeStateType;
+
+    SingleBodyStateDerivativeModel stateDerivativeModel( NumberOfRows == 7 );
+    BOOST_CHECK_EQUAL( getFixedPropagatedStateSize( stateDerivativeModel.model ), NumberOfRows );
+
+    FixedSizeStateType initialState;
+    initialState.template segment< 6 >( 0 ) << 7.0E6, 1.0E5, -2.0E5, 100.0, 7.4E3, 1.2E3;
+    if( NumberOfRows == 7 )
+    {
+        initialState( NumberOfRows - 1 ) = 500.0;
+    }
+
+    // Create integrators with fixed and dynamic size state
+    std::shared_ptr< NumericalIntegrator< double, FixedSizeStateType, FixedSizeStateType, double > > fixedSizeIntegrator =
+            createIntegrator< double, FixedSizeStateType, double >(
+                std::bind( &DynamicsStateDerivativeModel< double, double >::computeFixedSizeStateDerivative< NumberOfRows >,
+                           stateDerivativeModel.model, std::placeholders::_1, std::placeholders::_2 ),
+                initialState, 0.0, integratorSettings );
+    std::shared_ptr< NumericalIntegrator< double, Eigen::MatrixXd, Eigen::MatrixXd, double > > dynamicSizeIntegrator =
+            createIntegrator< double, Eigen::MatrixXd, double >(
+                std::bind( &DynamicsStateDerivativeModel< double, double >::computeStateDerivative,
+                           stateDerivativeModel.model, std::placeholders::_1, std::placeholders::_2 ),
+                Eigen::MatrixXd( initialState ), 0.0, integratorSettings );
+
+    // Perform initial steps, after which all pre-allocated memory has been allocated
+    int numberOfInitialSteps = 200;
+    getNumberOfHeapAllocationsDuringSteps( fixedSizeIntegrator, numberOfInitialSteps );
+    getNumberOfHeapAllocationsDuringSteps( dynamicSizeIntegrator, numberOfInitialSteps );
+    stateDerivativeModel.model->resetCumulativeFunctionEvaluationCounter( );
+
+    // Check that no heap allocation takes place for the fixed-size state, in contrast to the dynamic-size state
+    int numberOfTestSteps = 100;
+    unsigned long long fixedSizeAllocations = getNumberOfHeapAllocationsDuringSteps( fixedSizeIntegrator, numberOfTestSteps );
+    unsigned long long dynamicSizeAllocations = getNumberOfHeapAllocationsDuringSteps( dynamicSizeIntegrator, numberOfTestSteps );
+#ifdef TUDAT_COUNT_HEAP_ALLOCATIONS
+    BOOST_CHECK_EQUAL( fixedSizeAllocations, 0 );
+    BOOST_CHECK_GT( dynamicSizeAllocations, 0 );
+#endif
+
+    // Check that results are identical
+    BOOST_CHECK_EQUAL( fixedSizeIntegrator->getCurrentIndependentVariable( ),
+                       dynamicSizeIntegrator->getCurrentIndependentVariable( ) );
+    for( int i = 0; i < NumberOfRows; i++ )
+    {
+        BOOST_CHECK_LE( std::fabs( fixedSizeIntegrator->getCurrentState( )( i ) -
+                                   dynamicSizeIntegrator->getCurrentState( )( i ) ),
+                        10.0 * std::numeric_limits< double >::epsilon( ) *
+                        std::fabs( dynamicSizeIntegrator->getCurrentState( )( i ) ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testFixedSizeStatePropagationAllocations )
+{
+    std::vector< std::shared_ptr< IntegratorSettings< double > > > integratorSettings;
+    integratorSettings.push_back( rungeKutta4Settings< double >( 10.0 ) );
+    integratorSettings.push_back( rungeKuttaVariableStepSettingsScalarTolerances< double >(
+                                      10.0, rungeKuttaFehlberg78, 1.0E-3, 1.0E3, 1.0E-12, 1.0E-12 ) );
+
+    for( unsigned int i = 0; i < integratorSettings.size( ); i++ )
+    {
+        testFixedSizeStateIntegration< 6 >( integratorSettings.at( i ) );
+        testFixedSizeStateIntegration< 7 >( integratorSettings.at( i ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
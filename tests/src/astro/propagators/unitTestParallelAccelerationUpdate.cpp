@@ -0,0 +1,246 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/customAccelerationModel.h"
+#include "tudat/astro/gravitation/centralGravityModel.h"
+#include "tudat/astro/gravitation/thirdBodyPerturbation.h"
+#include "tudat/astro/propagators/dynamicsStateDerivativeModel.h"
+#include "tudat/astro/propagators/nBodyCowellStateDerivative.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::gravitation;
+using namespace tudat::propagators;
+
+BOOST_AUTO_TEST_SUITE( test_parallel_acceleration_update )
+
+//! Function to create a point-mass gravity acceleration model, exerted by a body at a fixed position.
+std::shared_ptr< CentralGravitationalAccelerationModel3d > getPointMassGravityAcceleration(
+        const std::shared_ptr< Eigen::Vector6d > bodyUndergoingAccelerationState,
+        const double gravitationalParameter, const Eigen::Vector3d& bodyExertingAccelerationPosition )
+{
+    return std::make_shared< CentralGravitationalAccelerationModel3d >(
+                [ = ]( Eigen::Vector3d& position ){ position = bodyUndergoingAccelerationState->segment( 0, 3 ); },
+                gravitationalParameter,
+                [ = ]( Eigen::Vector3d& position ){ position = bodyExertingAccelerationPosition; } );
+}
+
+//! Function to create a third-body point-mass gravity acceleration model, exerted by a body at a fixed position.
+std::shared_ptr< ThirdBodyCentralGravityAcceleration > getThirdBodyPointMassGravityAcceleration(
+        const std::shared_ptr< Eigen::Vector6d > bodyUndergoingAccelerationState,
+        const std::shared_ptr< CentralGravitationalAccelerationModel3d > accelerationModelForCentralBody,
+        const double gravitationalParameter, const Eigen::Vector3d& bodyExertingAccelerationPosition )
+{
+    return std::make_shared< ThirdBodyCentralGravityAcceleration >(
+                getPointMassGravityAcceleration(
+                    bodyUndergoingAccelerationState, gravitationalParameter, bodyExertingAccelerationPosition ),
+                accelerationModelForCentralBody, "Earth" );
+}
+
+//! Object containing the state derivative model of two vehicles orbiting the Earth, perturbed by the Moon and Sun.
+struct TwoVehicleStateDerivativeModel
+{
+    TwoVehicleStateDerivativeModel( const std::function< Eigen::Vector3d( const double ) > customAccelerationFunction )
+    {
+        std::shared_ptr< Eigen::Vector6d > firstVehicleState = firstVehicleState_;
+        std::shared_ptr< Eigen::Vector6d > secondVehicleState = secondVehicleState_;
+        std::shared_ptr< Eigen::Vector6d > earthState = std::make_shared< Eigen::Vector6d >( Eigen::Vector6d::Zero( ) );
+
+        Eigen::Vector3d moonPosition = ( Eigen::Vector3d( ) << 3.8E8, 1.0E7, -2.0E7 ).finished( );
+        Eigen::Vector3d sunPosition = ( Eigen::Vector3d( ) << -1.0E11, 1.0E11, 1.0E10 ).finished( );
+
+        // Acceleration of the Earth due to the Moon is shared by third-body accelerations of both vehicles
+        std::shared_ptr< CentralGravitationalAccelerationModel3d > moonAccelerationOnEarth =
+                getPointMassGravityAcceleration( earthState, 4.9028E12, moonPosition );
+
+        AccelerationMap accelerationMap;
+        accelerationMap[ "Vehicle1" ][ "Earth" ].push_back(
+                    getPointMassGravityAcceleration( firstVehicleState, 3.986004418E14, Eigen::Vector3d::Zero( ) ) );
+        accelerationMap[ "Vehicle1" ][ "Moon" ].push_back(
+                    getThirdBodyPointMassGravityAcceleration(
+                        firstVehicleState, moonAccelerationOnEarth, 4.9028E12, moonPosition ) );
+        accelerationMap[ "Vehicle1" ][ "Sun" ].push_back(
+                    getThirdBodyPointMassGravityAcceleration(
+                        firstVehicleState, getPointMassGravityAcceleration( earthState, 1.32712440018E20, sunPosition ),
+                        1.32712440018E20, sunPosition ) );
+        accelerationMap[ "Vehicle1" ][ "Vehicle1" ].push_back(
+                    std::make_shared< CustomAccelerationModel >( customAccelerationFunction ) );
+        accelerationMap[ "Vehicle2" ][ "Earth" ].push_back(
+                    getPointMassGravityAcceleration( secondVehicleState, 3.986004418E14, Eigen::Vector3d::Zero( ) ) );
+        accelerationMap[ "Vehicle2" ][ "Moon" ].push_back(
+                    getThirdBodyPointMassGravityAcceleration(
+                        secondVehicleState, moonAccelerationOnEarth, 4.9028E12, moonPosition ) );
+
+        std::vector< std::string > bodiesToIntegrate = { "Vehicle1", "Vehicle2" };
+        std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > stateDerivativeModels;
+        stateDerivativeModels.push_back(
+                    std::make_shared< NBodyCowellStateDerivative< double, double > >(
+                        accelerationMap, std::make_shared< CentralBodyData< double, double > >(
+                            std::vector< std::string >( { "Earth", "Earth" } ), bodiesToIntegrate,
+                            std::map< std::string, std::function< Eigen::Vector6d( const double ) > >( ),
+                            [ ]( const double ){ return Eigen::Vector6d::Zero( ).eval( ); }, "Earth" ),
+                        bodiesToIntegrate ) );
+
+        model = std::make_shared< DynamicsStateDerivativeModel< double, double > >(
+                    stateDerivativeModels,
+                    [ = ]( const double, const std::unordered_map< IntegratedStateType, Eigen::VectorXd >& currentStates,
+                    const std::vector< IntegratedStateType >& )
+        {
+            *firstVehicleState = currentStates.at( translational_state ).segment( 0, 6 );
+            *secondVehicleState = currentStates.at( translational_state ).segment( 6, 6 );
+        } );
+        model->setPropagationSettings( std::vector< IntegratedStateType >( ), true, false );
+    }
+
+    std::shared_ptr< Eigen::Vector6d > firstVehicleState_ = std::make_shared< Eigen::Vector6d >( );
+
+    std::shared_ptr< Eigen::Vector6d > secondVehicleState_ = std::make_shared< Eigen::Vector6d >( );
+
+    std::shared_ptr< DynamicsStateDerivativeModel< double, double > > model;
+};
+
+//! Test whether acceleration models sharing modified objects are assigned to the same update group.
+BOOST_AUTO_TEST_CASE( testAccelerationUpdateGroups )
+{
+    std::shared_ptr< Eigen::Vector6d > vehicleState = std::make_shared< Eigen::Vector6d >( Eigen::Vector6d::Zero( ) );
+    std::shared_ptr< CentralGravitationalAccelerationModel3d > sharedAccelerationOnCentralBody =
+            getPointMassGravityAcceleration( vehicleState, 1.0, Eigen::Vector3d::UnitX( ) );
+
+    std::vector< std::shared_ptr< AccelerationModel< Eigen::Vector3d > > > accelerationModelList;
+    accelerationModelList.push_back( getPointMassGravityAcceleration( vehicleState, 1.0, Eigen::Vector3d::Zero( ) ) );
+    accelerationModelList.push_back( std::make_shared< CustomAccelerationModel >(
+                                         [ ]( const double ){ return Eigen::Vector3d::Zero( ).eval( ); } ) );
+    accelerationModelList.push_back( getThirdBodyPointMassGravityAcceleration(
+                                         vehicleState, sharedAccelerationOnCentralBody, 1.0, Eigen::Vector3d::UnitX( ) ) );
+    accelerationModelList.push_back( getThirdBodyPointMassGravityAcceleration(
+                                         vehicleState, getPointMassGravityAcceleration(
+                                             vehicleState, 1.0, Eigen::Vector3d::UnitY( ) ),
+                                         1.0, Eigen::Vector3d::UnitY( ) ) );
+    accelerationModelList.push_back( std::make_shared< CustomAccelerationModel >(
+                                         [ ]( const double ){ return Eigen::Vector3d::Zero( ).eval( ); } ) );
+    accelerationModelList.push_back( getThirdBodyPointMassGravityAcceleration(
+                                         vehicleState, sharedAccelerationOnCentralBody, 1.0, Eigen::Vector3d::UnitX( ) ) );
+    accelerationModelList.push_back( accelerationModelList.at( 0 ) );
+
+    // Custom accelerations, third-body accelerations with common constituent model, and identical models are grouped
+    std::vector< std::vector< int > > accelerationUpdateGroups =
+            getIndependentAccelerationUpdateGroups( accelerationModelList );
+    std::vector< std::vector< int > > expectedAccelerationUpdateGroups = { { 0, 6 }, { 1, 4 }, { 2, 5 }, { 3 } };
+    BOOST_CHECK_EQUAL( accelerationUpdateGroups.size( ), expectedAccelerationUpdateGroups.size( ) );
+    for( unsigned int i = 0; i < expectedAccelerationUpdateGroups.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS( accelerationUpdateGroups.at( i ).begin( ), accelerationUpdateGroups.at( i ).end( ),
+                                       expectedAccelerationUpdateGroups.at( i ).begin( ),
+                                       expectedAccelerationUpdateGroups.at( i ).end( ) );
+    }
+}
+
+//! Test whether the state derivative with concurrently updated acceleration models is identical to a sequential update.
+BOOST_AUTO_TEST_CASE( testParallelAccelerationUpdate )
+{
+    TwoVehicleStateDerivativeModel stateDerivativeModel(
+                [ ]( const double time ){ return ( Eigen::Vector3d( ) << 1.0E-6, -2.0E-6, time * 1.0E-9 ).finished( ); } );
+
+    Eigen::MatrixXd state = Eigen::MatrixXd::Zero( 12, 1 );
+    state.block( 0, 0, 6, 1 ) << 7.0E6, 1.0E5, -2.0E5, 100.0, 7.4E3, 1.2E3;
+    state.block( 6, 0, 6, 1 ) << -4.0E6, 5.0E6, 1.0E6, -5.0E3, -4.0E3, 2.0E3;
+
+    std::vector< Eigen::MatrixXd > sequentialStateDerivatives;
+    for( unsigned int i = 0; i < 10; i++ )
+    {
+        sequentialStateDerivatives.push_back(
+                    stateDerivativeModel.model->computeStateDerivative( 60.0 * i, state + 10.0 * i * state ) );
+    }
+
+    std::shared_ptr< NBodyStateDerivative< double, double > > translationalStateDerivative =
+            std::dynamic_pointer_cast< NBodyStateDerivative< double, double > >(
+                stateDerivativeModel.model->getStateDerivativeModels( ).at( translational_state ).at( 0 ) );
+    for( unsigned int numberOfThreads = 0; numberOfThreads <= 4; numberOfThreads++ )
+    {
+        stateDerivativeModel.model->setNumberOfThreadsForAccelerationUpdates( numberOfThreads );
+
+        // Central gravity, custom and Sun third-body accelerations are independent; Moon third-body accelerations are not
+        if( numberOfThreads != 1 )
+        {
+            BOOST_CHECK_EQUAL( translationalStateDerivative->getAccelerationUpdateGroups( ).size( ), 5 );
+        }
+
+        for( unsigned int i = 0; i < 10; i++ )
+        {
+            Eigen::MatrixXd stateDerivative =
+                    stateDerivativeModel.model->computeStateDerivative( 60.0 * i, state + 10.0 * i * state );
+            for( int j = 0; j < 12; j++ )
+            {
+                BOOST_CHECK_EQUAL( stateDerivative( j, 0 ), sequentialStateDerivatives.at( i )( j, 0 ) );
+            }
+        }
+    }
+}
+
+//! Test whether an exception thrown when updating an acceleration model concurrently is propagated to the caller.
+BOOST_AUTO_TEST_CASE( testParallelAccelerationUpdateException )
+{
+    TwoVehicleStateDerivativeModel stateDerivativeModel( [ ]( const double time )
+    {
+        if( time > 0.0 )
+        {
+            throw std::runtime_error( "Error in custom acceleration" );
+        }
+        return Eigen::Vector3d::Zero( ).eval( );
+    } );
+    stateDerivativeModel.model->setNumberOfThreadsForAccelerationUpdates( 4 );
+
+    Eigen::MatrixXd state = Eigen::MatrixXd::Zero( 12, 1 );
+    state.block( 0, 0, 6, 1 ) << 7.0E6, 1.0E5, -2.0E5, 100.0, 7.4E3, 1.2E3;
+    state.block( 6, 0, 6, 1 ) << -4.0E6, 5.0E6, 1.0E6, -5.0E3, -4.0E3, 2.0E3;
+
+    BOOST_CHECK_NO_THROW( stateDerivativeModel.model->computeStateDerivative( 0.0, state ) );
+    BOOST_CHECK_THROW( stateDerivativeModel.model->computeStateDerivative( 60.0, state ), std::runtime_error );
+    BOOST_CHECK_NO_THROW( stateDerivativeModel.model->computeStateDerivative( 0.0, state ) );
+}
+
+//! Test whether setting the same profiler repeatedly does not register duplicate acceleration model entries.
+BOOST_AUTO_TEST_CASE( testAccelerationModelProfilerEntries )
+{
+    TwoVehicleStateDerivativeModel stateDerivativeModel( [ ]( const double ){ return Eigen::Vector3d::Zero( ).eval( ); } );
+    std::shared_ptr< NBodyStateDerivative< double, double > > translationalStateDerivative =
+            std::dynamic_pointer_cast< NBodyStateDerivative< double, double > >(
+                stateDerivativeModel.model->getStateDerivativeModels( ).at( translational_state ).at( 0 ) );
+
+    std::shared_ptr< utilities::TimingProfiler > profiler = std::make_shared< utilities::TimingProfiler >( );
+    translationalStateDerivative->setProfiler( profiler );
+    BOOST_CHECK_EQUAL( profiler->getEntries( ).size( ), 6 );
+    translationalStateDerivative->setProfiler( profiler );
+    BOOST_CHECK_EQUAL( profiler->getEntries( ).size( ), 6 );
+
+    // A new profiler receives its own entries
+    std::shared_ptr< utilities::TimingProfiler > newProfiler = std::make_shared< utilities::TimingProfiler >( );
+    translationalStateDerivative->setProfiler( newProfiler );
+    BOOST_CHECK_EQUAL( newProfiler->getEntries( ).size( ), 6 );
+    BOOST_CHECK_EQUAL( profiler->getEntries( ).size( ), 6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
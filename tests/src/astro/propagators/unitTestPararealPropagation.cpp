@@ -0,0 +1,209 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/math/integrators/rungeKutta4Integrator.h"
+#include "tudat/simulation/simulation.h"
+#include "tudat/simulation/propagation_setup/pararealPropagation.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_parareal_propagation )
+
+//! Function to compute the state derivative of a Keplerian orbit (gravitational parameter of 1).
+Eigen::VectorXd computeKeplerStateDerivative( const double, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative( 6 );
+    const double distance = state.segment( 0, 3 ).norm( );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -state.segment( 0, 3 ) / ( distance * distance * distance );
+    return stateDerivative;
+}
+
+//! Function to propagate a Keplerian orbit with an RK4 integrator, with given step size.
+Eigen::VectorXd propagateKeplerOrbit( const double initialTime, const Eigen::VectorXd& initialState,
+                                      const double finalTime, const double stepSize )
+{
+    RungeKutta4IntegratorXd integrator( &computeKeplerStateDerivative, initialTime, initialState, stepSize );
+    return integrator.integrateTo( finalTime, stepSize );
+}
+
+//! Test Parareal algorithm on a Keplerian orbit, using RK4 integrators with small (fine) and large (coarse) step size
+BOOST_AUTO_TEST_CASE( testPararealIterations )
+{
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 );
+    initialState( 0 ) = 1.0;
+    initialState( 4 ) = std::sqrt( 1.3 );
+
+    const double finalTime = 20.0;
+    const int numberOfSlices = 10;
+
+    auto finePropagationFunction = [ ]( const int, const unsigned int, const double sliceInitialTime,
+            const Eigen::VectorXd& sliceInitialState, const double sliceFinalTime )
+    {
+        return propagateKeplerOrbit( sliceInitialTime, sliceInitialState, sliceFinalTime, 1.0E-3 );
+    };
+    int numberOfCoarsePropagations = 0;
+    auto coarsePropagationFunction = [ & ]( const int, const double sliceInitialTime,
+            const Eigen::VectorXd& sliceInitialState, const double sliceFinalTime )
+    {
+        numberOfCoarsePropagations++;
+        return propagateKeplerOrbit( sliceInitialTime, sliceInitialState, sliceFinalTime, 0.1 );
+    };
+
+    // Propagate with tolerance on boundary defect, serially and multi-threaded
+    std::vector< std::shared_ptr< PararealPropagationResults< double, double > > > pararealResults;
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads++ )
+    {
+        pararealResults.push_back(
+                    performPararealIterations< double, double >(
+                        finePropagationFunction, coarsePropagationFunction, initialState, 0.0, finalTime, numberOfSlices,
+                        1.0E-9, numberOfSlices, ( numberOfThreads == 1 ) ? nullptr :
+                                                std::make_shared< utilities::ThreadPool >( numberOfThreads ),
+                        true ) );
+    }
+
+    for( unsigned int i = 0; i < pararealResults.size( ); i++ )
+    {
+        std::shared_ptr< PararealPropagationResults< double, double > > results = pararealResults.at( i );
+        BOOST_CHECK( results->isConverged( ) );
+        BOOST_CHECK_LT( results->getNumberOfIterations( ), numberOfSlices / 2 );
+        BOOST_CHECK_LE( results->getIterationBoundaryDefects( ).back( ), 1.0E-9 );
+        BOOST_CHECK_EQUAL( results->getNumberOfSlices( ), numberOfSlices );
+        BOOST_CHECK_EQUAL( results->getSliceBoundaryTimes( ).front( ), 0.0 );
+        BOOST_CHECK_EQUAL( results->getSliceBoundaryTimes( ).back( ), finalTime );
+        BOOST_CHECK( results->getSliceInitialStates( ).col( 0 ) == initialState );
+
+        // Results must be independent of number of threads, and close to serial propagation
+        BOOST_CHECK( results->getFinalState( ) == pararealResults.at( 0 )->getFinalState( ) );
+        BOOST_CHECK( results->isSerialReferenceAvailable( ) );
+        BOOST_CHECK_SMALL( ( results->getFinalState( ) - results->getSerialReferenceFinalState( ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-7 );
+        BOOST_CHECK_GT( results->getSpeedup( ), 0.0 );
+    }
+
+    // Check that, without tolerance, Parareal iterations terminate on serial fine propagation after one iteration per slice
+    numberOfCoarsePropagations = 0;
+    std::shared_ptr< PararealPropagationResults< double, double > > exactResults =
+            performPararealIterations< double, double >(
+                finePropagationFunction, coarsePropagationFunction, initialState, 0.0, finalTime, numberOfSlices,
+                0.0, numberOfSlices, nullptr, true );
+    BOOST_CHECK( exactResults->isConverged( ) );
+    BOOST_CHECK_EQUAL( exactResults->getNumberOfIterations( ), numberOfSlices );
+    BOOST_CHECK_EQUAL( numberOfCoarsePropagations, numberOfSlices * ( numberOfSlices + 1 ) / 2 );
+    BOOST_CHECK_SMALL( ( exactResults->getFinalState( ) - exactResults->getSerialReferenceFinalState( ) ).cwiseAbs( ).maxCoeff( ),
+                       1.0E-11 );
+
+    // Check that non-converged iterations are reported as such
+    std::shared_ptr< PararealPropagationResults< double, double > > nonConvergedResults =
+            performPararealIterations< double, double >(
+                finePropagationFunction, coarsePropagationFunction, initialState, 0.0, finalTime, numberOfSlices,
+                1.0E-9, 1, nullptr );
+    BOOST_CHECK( !nonConvergedResults->isConverged( ) );
+    BOOST_CHECK_EQUAL( nonConvergedResults->getNumberOfIterations( ), 1 );
+    BOOST_CHECK( !nonConvergedResults->isSerialReferenceAvailable( ) );
+
+    BOOST_CHECK_THROW( ( performPararealIterations< double, double >(
+                             finePropagationFunction, coarsePropagationFunction, initialState, 0.0, finalTime, 0,
+                             1.0E-9, numberOfSlices, nullptr ) ), std::runtime_error );
+}
+
+//! Function to create the bodies for the test propagation (point-mass Earth and empty vehicle)
+SystemOfBodies createPararealTestBodies( )
+{
+    SystemOfBodies bodies( "Earth", "ECLIPJ2000" );
+    bodies.createEmptyBody( "Earth" );
+    bodies.createEmptyBody( "Vehicle" );
+    bodies.at( "Earth" )->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                            [ ]( ){ return Eigen::Vector6d::Zero( ); }, "Earth" ) );
+    bodies.at( "Earth" )->setGravityFieldModel( std::make_shared< gravitation::GravityFieldModel >( 3.986004418E14 ) );
+    return bodies;
+}
+
+//! Function to create the propagation settings of the test propagation, with given (fixed) step size
+std::shared_ptr< SingleArcPropagatorSettings< double, double > > createPararealTestPropagatorSettings(
+        const SystemOfBodies& bodies, const double stepSize )
+{
+    SelectedAccelerationMap accelerationSettings;
+    accelerationSettings[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >(
+                                                                basic_astrodynamics::point_mass_gravity ) );
+    basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodies, accelerationSettings, { "Vehicle" }, { "Earth" } );
+
+    return std::make_shared< TranslationalStatePropagatorSettings< double, double > >(
+                std::vector< std::string >{ "Earth" }, accelerationModelMap, std::vector< std::string >{ "Vehicle" },
+                Eigen::VectorXd::Zero( 6 ), 0.0, rungeKutta4Settings( stepSize ),
+                std::make_shared< PropagationTimeTerminationSettings >( 0.0 ), cowell );
+}
+
+//! Test whether Parareal propagation of single-arc dynamics reproduces serial propagation
+BOOST_AUTO_TEST_CASE( testSingleArcPararealPropagation )
+{
+    Eigen::Vector6d initialKeplerElements;
+    initialKeplerElements << 7.0E6, 0.05, 1.0, 0.2, 0.3, 0.0;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements( initialKeplerElements, 3.986004418E14 );
+
+    const double finalTime = 6.0 * 3600.0;
+    const int numberOfSlices = 8;
+
+    std::vector< std::shared_ptr< PararealPropagationResults< double, double > > > pararealResults;
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads += 2 )
+    {
+        pararealResults.push_back(
+                    propagateSingleArcParareal< double, double >(
+                        &createPararealTestBodies,
+                        [ ]( const SystemOfBodies& bodies ){ return createPararealTestPropagatorSettings( bodies, 10.0 ); },
+                        [ ]( const SystemOfBodies& bodies ){ return createPararealTestPropagatorSettings( bodies, 150.0 ); },
+                        initialState, 0.0, finalTime, numberOfSlices, 1.0E-3, numberOfSlices, numberOfThreads, true ) );
+    }
+
+    for( unsigned int i = 0; i < pararealResults.size( ); i++ )
+    {
+        std::shared_ptr< PararealPropagationResults< double, double > > results = pararealResults.at( i );
+        BOOST_CHECK( results->isConverged( ) );
+        BOOST_CHECK_LT( results->getNumberOfIterations( ), numberOfSlices );
+        BOOST_CHECK( results->getFinalState( ) == pararealResults.at( 0 )->getFinalState( ) );
+        BOOST_CHECK_SMALL( ( results->getFinalState( ) - results->getSerialReferenceFinalState( ) ).segment( 0, 3 ).norm( ),
+                           1.0E-1 );
+
+        // Check consistency of full results of slices
+        BOOST_CHECK_EQUAL( results->getFineSliceResults( ).size( ), numberOfSlices );
+        for( int k = 0; k < numberOfSlices; k++ )
+        {
+            const SingleArcSimulationResults< double, double >::StateHistoryType& sliceHistory =
+                    results->getFineSliceResults( ).at( k )->getContiguousEquationsOfMotionNumericalSolution( );
+            BOOST_CHECK_EQUAL( sliceHistory.getTime( 0 ), results->getSliceBoundaryTimes( ).at( k ) );
+            BOOST_CHECK( Eigen::VectorXd( sliceHistory.getEntry( 0 ) ) ==
+                         Eigen::VectorXd( results->getSliceInitialStates( ).col( k ) ) );
+            BOOST_CHECK_CLOSE_FRACTION( sliceHistory.getTime( sliceHistory.size( ) - 1 ),
+                                        results->getSliceBoundaryTimes( ).at( k + 1 ), 1.0E-12 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
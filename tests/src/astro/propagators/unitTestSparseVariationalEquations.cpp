@@ -0,0 +1,334 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "tudat/basics/testMacros.h"
+#include "tudat/astro/basic_astro/physicalConstants.h"
+#include "tudat/astro/ephemerides/keplerEphemeris.h"
+#include "tudat/interface/spice/spiceInterface.h"
+#include "tudat/math/integrators/rungeKuttaCoefficients.h"
+
+#include "tudat/simulation/environment_setup/body.h"
+#include "tudat/simulation/estimation_setup/variationalEquationsSolver.h"
+#include "tudat/simulation/environment_setup/defaultBodies.h"
+#include "tudat/simulation/environment_setup/createBodies.h"
+#include "tudat/simulation/estimation_setup/createNumericalSimulator.h"
+#include "tudat/simulation/estimation_setup/createEstimatableParameters.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//Using declarations.
+using namespace tudat;
+using namespace tudat::estimatable_parameters;
+using namespace tudat::numerical_integrators;
+using namespace tudat::simulation_setup;
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::ephemerides;
+using namespace tudat::propagators;
+
+BOOST_AUTO_TEST_SUITE( test_sparse_variational_equations )
+
+//! Function to compare the derivative of the state transition and sensitivity matrices to the dense matrix product
+/*!
+ *  Function to compare the derivative of the state transition and sensitivity matrices, as computed from the non-zero
+ *  blocks of the state partial matrix only, to the product of the full (dense) state partial matrix and the state
+ *  transition and sensitivity matrices. The derivative is evaluated for a random state transition and sensitivity matrix,
+ *  using the partials at the final state of the preceding propagation. The parameter partials are obtained from an
+ *  evaluation with a zero state transition and sensitivity matrix.
+ *  \param variationalEquations Object used to evaluate the variational equations.
+ *  \param numberOfParameterValues Number of columns of the state transition and sensitivity matrices.
+ */
+void checkSparseVariationalEquations(
+        const std::shared_ptr< VariationalEquations > variationalEquations,
+        const int numberOfParameterValues )
+{
+    int numberOfStates = variationalEquations->getStatePartialMatrix( ).rows( );
+
+    std::srand( 42 );
+    Eigen::MatrixXd stateTransitionAndSensitivityMatrices =
+            Eigen::MatrixXd::Random( numberOfStates, numberOfParameterValues );
+
+    // Evaluate variational equations for zero and random state transition and sensitivity matrices
+    Eigen::MatrixXd parameterPartialDerivative = Eigen::MatrixXd::Constant(
+                numberOfStates, numberOfParameterValues, TUDAT_NAN );
+    variationalEquations->evaluateVariationalEquations< double >(
+                0.0, Eigen::MatrixXd::Zero( numberOfStates, numberOfParameterValues ),
+                parameterPartialDerivative.block( 0, 0, numberOfStates, numberOfParameterValues ) );
+
+    Eigen::MatrixXd matrixDerivative = Eigen::MatrixXd::Constant(
+                numberOfStates, numberOfParameterValues, TUDAT_NAN );
+    variationalEquations->evaluateVariationalEquations< double >(
+                0.0, stateTransitionAndSensitivityMatrices,
+                matrixDerivative.block( 0, 0, numberOfStates, numberOfParameterValues ) );
+
+    // Compute derivative from dense matrix product
+    Eigen::MatrixXd statePartialMatrix = variationalEquations->getStatePartialMatrix( );
+    Eigen::MatrixXd expectedMatrixDerivative =
+            statePartialMatrix * stateTransitionAndSensitivityMatrices + parameterPartialDerivative;
+    Eigen::MatrixXd matrixDerivativeScale =
+            statePartialMatrix.cwiseAbs( ) * stateTransitionAndSensitivityMatrices.cwiseAbs( ) +
+            parameterPartialDerivative.cwiseAbs( );
+
+    // Check that the parameter partials are not affected by the state transition matrix product
+    BOOST_CHECK_EQUAL(
+                parameterPartialDerivative.block( 0, 0, numberOfStates, numberOfStates ).cwiseAbs( ).maxCoeff( ), 0.0 );
+
+    for( int i = 0; i < numberOfStates; i++ )
+    {
+        for( int j = 0; j < numberOfParameterValues; j++ )
+        {
+            BOOST_CHECK_SMALL( std::fabs( matrixDerivative( i, j ) - expectedMatrixDerivative( i, j ) ),
+                               1.0E-14 * matrixDerivativeScale( i, j ) + std::numeric_limits< double >::min( ) );
+        }
+    }
+}
+
+//! Test the sparse evaluation of the variational equations for mutually attracting bodies
+/*!
+ *  Test the sparse evaluation of the variational equations for mutually attracting bodies, propagated with a Cowell
+ *  propagator, with the initial states and gravitational parameters estimated. The test is run for a barycentric origin of
+ *  all bodies, and for a hierarchical origin (Moon w.r.t. Earth, Earth and Mars w.r.t. Sun), for which columns of the
+ *  state partial matrix are added to those of the central body.
+ */
+BOOST_AUTO_TEST_CASE( testSparseMultiBodyVariationalEquations )
+{
+    //Load spice kernels.
+    spice_interface::loadStandardSpiceKernels( );
+
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        std::vector< std::string > bodyNames = { "Earth", "Sun", "Moon", "Mars" };
+
+        double initialEphemerisTime = 1.0E7;
+        double finalEphemerisTime = initialEphemerisTime + 86400.0;
+        double buffer = 5.0 * 3600.0;
+
+        // Create bodies needed in simulation
+        BodyListSettings bodySettings =
+                getDefaultBodySettings( bodyNames, initialEphemerisTime - buffer, finalEphemerisTime + buffer );
+        SystemOfBodies bodies = createSystemOfBodies( bodySettings );
+
+        // Set accelerations between bodies that are to be taken into account.
+        SelectedAccelerationMap accelerationMap;
+        accelerationMap[ "Earth" ][ "Sun" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Earth" ][ "Moon" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Earth" ][ "Mars" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Moon" ][ "Sun" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Moon" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Mars" ][ "Sun" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Mars" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+
+        // Set bodies for which initial state is to be estimated and integrated.
+        std::vector< std::string > bodiesToIntegrate = { "Moon", "Earth", "Mars" };
+        std::vector< std::string > centralBodies;
+        if( testCase == 0 )
+        {
+            centralBodies = { "SSB", "SSB", "SSB" };
+        }
+        else
+        {
+            centralBodies = { "Earth", "Sun", "Sun" };
+        }
+
+        // Create acceleration models
+        AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodies, accelerationMap, bodiesToIntegrate, centralBodies );
+
+        // Create integrator settings
+        std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+                std::make_shared< IntegratorSettings< double > >( rungeKutta4, initialEphemerisTime, 3600.0 );
+
+        // Create propagator settings
+        Eigen::VectorXd initialTranslationalState = getInitialStatesOfBodies(
+                    bodiesToIntegrate, centralBodies, bodies, initialEphemerisTime );
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialTranslationalState,
+                  finalEphemerisTime, cowell );
+
+        // Define parameters.
+        std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterNames =
+                getInitialStateParameterSettings< double >( propagatorSettings, bodies );
+        parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Moon", gravitational_parameter ) );
+        parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+        parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Sun", gravitational_parameter ) );
+        std::shared_ptr< EstimatableParameterSet< double > > parametersToEstimate =
+                createParametersToEstimate( parameterNames, bodies );
+
+        // Propagate variational equations, and compare sparse and dense evaluation at final state
+        SingleArcVariationalEquationsSolver< double, double > dynamicsSimulator(
+                    bodies, integratorSettings, propagatorSettings, parametersToEstimate,
+                    1, std::shared_ptr< IntegratorSettings< double > >( ), 0, 0 );
+        dynamicsSimulator.integrateVariationalAndDynamicalEquations( propagatorSettings->getInitialStates( ), 1 );
+
+        if( testCase == 1 )
+        {
+            BOOST_CHECK_EQUAL( dynamicsSimulator.getVariationalEquationsObject( )->
+                               getStatePartialAdditionIndices( ).size( ), 1 );
+        }
+        checkSparseVariationalEquations(
+                    dynamicsSimulator.getVariationalEquationsObject( ), parametersToEstimate->getParameterSetSize( ) );
+    }
+}
+
+//! Test the sparse evaluation of the variational equations for coupled translational-rotational dynamics
+/*!
+ *  Test the sparse evaluation of the variational equations for the coupled translational and rotational dynamics of
+ *  Phobos, with the mean moment of inertia and degree two gravity field coefficients of Phobos estimated. The rows of the
+ *  quaternion derivative depend on both the quaternion and the angular velocity, so that (unlike the position rows of the
+ *  translational state) they cannot be copied from the state transition matrix.
+ */
+BOOST_AUTO_TEST_CASE( testSparseCoupledVariationalEquations )
+{
+    //Load spice kernels.
+    spice_interface::loadStandardSpiceKernels( );
+
+    double initialEphemerisTime = 0.0;
+    double finalEphemerisTime = 3600.0;
+
+    // Create Mars
+    SystemOfBodies bodies = SystemOfBodies( "Mars", "ECLIPJ2000" );
+    bodies.createEmptyBody( "Mars", false );
+    bodies.at( "Mars" )->setEphemeris( std::make_shared< ConstantEphemeris >(
+                                           [ = ]( ){ return Eigen::Vector6d::Zero( ); } ) );
+    bodies.at( "Mars" )->setRotationalEphemeris(
+                createRotationModel( getDefaultRotationModelSettings(
+                                         "Mars", initialEphemerisTime, finalEphemerisTime ), "Mars" ) );
+    bodies.at( "Mars" )->setGravityFieldModel(
+                createGravityFieldModel( getDefaultGravityFieldSettings(
+                                             "Mars", initialEphemerisTime, finalEphemerisTime ), "Mars", bodies ) );
+    double marsGravitationalParameter = bodies.at( "Mars" )->getGravityFieldModel( )->getGravitationalParameter( );
+
+    // Create Phobos, with gravity field from inertia tensor
+    bodies.createEmptyBody( "Phobos" );
+    Eigen::Matrix3d phobosInertiaTensor = Eigen::Matrix3d::Zero( );
+    phobosInertiaTensor( 0, 0 ) = 0.3615;
+    phobosInertiaTensor( 1, 1 ) = 0.4265;
+    phobosInertiaTensor( 2, 2 ) = 0.5024;
+    phobosInertiaTensor *= ( 11.27E3 * 11.27E3 * 1.0659E16 );
+
+    double phobosGravitationalParameter = 1.0659E16 * physical_constants::GRAVITATIONAL_CONSTANT;
+    double phobosReferenceRadius = 11.27E3;
+    Eigen::MatrixXd phobosCosineGravityFieldCoefficients = Eigen::MatrixXd::Zero( 6, 6 ),
+            phobosSineGravityFieldCoefficients = Eigen::MatrixXd::Zero( 6, 6 );
+    double phobosScaledMeanMomentOfInertia;
+    gravitation::getDegreeTwoSphericalHarmonicCoefficients(
+                phobosInertiaTensor, phobosGravitationalParameter, phobosReferenceRadius, true,
+                phobosCosineGravityFieldCoefficients, phobosSineGravityFieldCoefficients, phobosScaledMeanMomentOfInertia );
+    bodies.at( "Phobos" )->setGravityFieldModel(
+                std::make_shared< gravitation::SphericalHarmonicsGravityField >(
+                    phobosGravitationalParameter, phobosReferenceRadius, phobosCosineGravityFieldCoefficients,
+                    phobosSineGravityFieldCoefficients, "Phobos_Fixed", phobosScaledMeanMomentOfInertia ) );
+
+    Eigen::Vector6d phobosKeplerElements = Eigen::Vector6d::Zero( );
+    double phobosSemiMajorAxis = 9376.0E3;
+    phobosKeplerElements( 0 ) = phobosSemiMajorAxis;
+    phobosKeplerElements( 2 ) = 0.1;
+    bodies.at( "Phobos" )->setEphemeris(
+                getTabulatedEphemeris( std::make_shared< KeplerEphemeris >(
+                                           phobosKeplerElements, 0.0, marsGravitationalParameter ),
+                                       initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0, 60.0 ) );
+
+    // Define initial rotational state of Phobos
+    Eigen::Quaterniond initialRotation = Eigen::Quaterniond( Eigen::AngleAxisd( 1.0, Eigen::Vector3d::UnitZ( ) ) *
+                                                             Eigen::AngleAxisd( 2.0, Eigen::Vector3d::UnitX( ) ) *
+                                                             Eigen::AngleAxisd( -0.5, Eigen::Vector3d::UnitZ( ) ) );
+    Eigen::Matrix< double, 7, 1 > initialRotationalState = Eigen::Matrix< double, 7, 1 >::Zero( );
+    initialRotationalState( 0 ) = initialRotation.w( );
+    initialRotationalState( 1 ) = initialRotation.x( );
+    initialRotationalState( 2 ) = initialRotation.y( );
+    initialRotationalState( 3 ) = initialRotation.z( );
+    initialRotationalState( 4 ) = 1.0E-4;
+    initialRotationalState( 5 ) = -1.0E-4;
+    initialRotationalState( 6 ) = std::sqrt( marsGravitationalParameter / std::pow( phobosSemiMajorAxis, 3.0 ) ) + 1.0E-4;
+
+    std::map< double, Eigen::Matrix< double, 7, 1 > > dummyRotationMap;
+    dummyRotationMap[ -1.0E100 ] = initialRotationalState;
+    dummyRotationMap[ 1.0E100 ] = initialRotationalState;
+    bodies.at( "Phobos" )->setRotationalEphemeris(
+                std::make_shared< TabulatedRotationalEphemeris< double, double > >(
+                    std::make_shared< interpolators::LinearInterpolator< double, Eigen::Matrix< double, 7, 1 > > >(
+                        dummyRotationMap ), "ECLIPJ2000", "Phobos_Fixed" ) );
+
+    // Create acceleration and torque models
+    std::vector< std::string > bodiesToIntegrate = { "Phobos" };
+    std::vector< std::string > centralBodies = { "Mars" };
+
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Phobos" ][ "Mars" ].push_back(
+                std::make_shared< MutualSphericalHarmonicAccelerationSettings >( 2, 2, 2, 2 ) );
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodies, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    SelectedTorqueMap torqueMap;
+    torqueMap[ "Phobos" ][ "Mars" ].push_back( std::make_shared< TorqueSettings >( second_order_gravitational_torque ) );
+    TorqueModelMap torqueModelMap = createTorqueModelsMap( bodies, torqueMap, bodiesToIntegrate );
+
+    // Create propagator settings
+    Eigen::VectorXd initialTranslationalState = getInitialStatesOfBodies(
+                bodiesToIntegrate, centralBodies, bodies, initialEphemerisTime );
+
+    std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > propagatorSettingsList;
+    propagatorSettingsList.push_back(
+                std::make_shared< RotationalStatePropagatorSettings< double > >
+                ( torqueModelMap, bodiesToIntegrate, initialRotationalState,
+                  std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) ) );
+    propagatorSettingsList.push_back(
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialTranslationalState,
+                  finalEphemerisTime, cowell ) );
+    std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+            std::make_shared< MultiTypePropagatorSettings< double > >(
+                propagatorSettingsList, std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) );
+
+    std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+            std::make_shared< IntegratorSettings< double > >( rungeKutta4, initialEphemerisTime, 15.0 );
+
+    // Define parameters.
+    std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    parameterNames.push_back( std::make_shared< InitialRotationalStateEstimatableParameterSettings< double > >(
+                                  "Phobos", initialRotationalState, "ECLIPJ2000" ) );
+    parameterNames.push_back( std::make_shared< InitialTranslationalStateEstimatableParameterSettings< double > >(
+                                  "Phobos", initialTranslationalState, "Mars" ) );
+    parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Phobos", mean_moment_of_inertia ) );
+    parameterNames.push_back( std::make_shared< SphericalHarmonicEstimatableParameterSettings >(
+                                  2, 0, 2, 2, "Phobos", spherical_harmonics_cosine_coefficient_block ) );
+    parameterNames.push_back( std::make_shared< SphericalHarmonicEstimatableParameterSettings >(
+                                  2, 1, 2, 2, "Phobos", spherical_harmonics_sine_coefficient_block ) );
+    std::shared_ptr< EstimatableParameterSet< double > > parametersToEstimate =
+            createParametersToEstimate( parameterNames, bodies );
+
+    // Propagate variational equations, and compare sparse and dense evaluation at final state
+    SingleArcVariationalEquationsSolver< double, double > dynamicsSimulator(
+                bodies, integratorSettings, propagatorSettings, parametersToEstimate,
+                1, std::shared_ptr< IntegratorSettings< double > >( ), 0, 0 );
+    dynamicsSimulator.integrateVariationalAndDynamicalEquations( propagatorSettings->getInitialStates( ), 1 );
+
+    checkSparseVariationalEquations(
+                dynamicsSimulator.getVariationalEquationsObject( ), parametersToEstimate->getParameterSetSize( ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
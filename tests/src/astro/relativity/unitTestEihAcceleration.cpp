@@ -14,6 +14,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "tudat/astro/propagators/nBodyTaylorSeriesExpressions.h"
+#include "tudat/astro/relativity/einsteinInfeldHoffmannEquations.h"
 #include "tudat/interface/spice/spiceInterface.h"
 #include "tudat/simulation/simulation.h"
 
@@ -155,6 +157,119 @@ BOOST_AUTO_TEST_CASE( testEihPropagation )
 
 }
 
+//! Test the (optionally multi-threaded) EIH pair computations against a direct implementation of the EIH equations
+BOOST_AUTO_TEST_CASE( testEihPairComputations )
+{
+    // Define bodies on eccentric, inclined orbits around a central body
+    const int numberOfBodies = 7;
+    std::vector< std::string > bodyNames;
+    std::vector< double > gravitationalParameters;
+    std::vector< std::function< double( ) > > gravitationalParameterFunctions;
+    std::vector< std::function< Eigen::Matrix< double, 6, 1 >( ) > > stateFunctions;
+    std::vector< double > fullState( 6 * numberOfBodies, 0.0 );
+    for( int i = 0; i < numberOfBodies; i++ )
+    {
+        bodyNames.push_back( "Body" + std::to_string( i ) );
+        gravitationalParameters.push_back( ( i == 0 ) ? 1.32712440018E20 : 1.0E17 * static_cast< double >( i ) );
+        const double gravitationalParameter = gravitationalParameters.at( i );
+        gravitationalParameterFunctions.push_back( [ = ]( ){ return gravitationalParameter; } );
+
+        Eigen::Matrix< double, 6, 1 > bodyState = Eigen::Matrix< double, 6, 1 >::Zero( );
+        if( i > 0 )
+        {
+            double radius = 4.0E10 * static_cast< double >( i );
+            double angle = 1.3 * static_cast< double >( i );
+            double velocity = 1.1 * std::sqrt( gravitationalParameters.at( 0 ) / radius );
+            bodyState << radius * std::cos( angle ), radius * std::sin( angle ), 0.1 * radius * std::sin( 2.0 * angle ),
+                    -velocity * std::sin( angle ), velocity * std::cos( angle ), 0.05 * velocity;
+        }
+        for( int k = 0; k < 6; k++ )
+        {
+            fullState.at( 6 * i + k ) = bodyState( k );
+        }
+        stateFunctions.push_back( [ = ]( ){ return bodyState; } );
+    }
+
+    const double ppnGamma = 1.1, ppnBeta = 0.8;
+    std::vector< double > expectedStateDerivative = computeNBodyEinsteinInfeldHoffmannStateDerivative(
+                fullState, gravitationalParameters, ppnGamma, ppnBeta );
+
+    // Compute EIH accelerations with all bodies, and with subset of bodies, undergoing acceleration, single- and multi-threaded
+    for( unsigned int numberOfAcceleratedBodies = numberOfBodies - 2; numberOfAcceleratedBodies <= numberOfBodies;
+         numberOfAcceleratedBodies += 2 )
+    {
+        std::vector< Eigen::Vector3d > singleThreadAccelerations;
+        for( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads += 2 )
+        {
+            relativity::EinsteinInfeldHoffmannEquations eihEquations(
+                        std::vector< std::string >( bodyNames.begin( ), bodyNames.begin( ) + numberOfAcceleratedBodies ),
+                        bodyNames, gravitationalParameterFunctions, stateFunctions,
+                        [ = ]( ){ return ppnGamma; }, [ = ]( ){ return ppnBeta; } );
+            eihEquations.setNumberOfThreads( numberOfThreads );
+            BOOST_CHECK_EQUAL( ( eihEquations.getThreadPool( ) != nullptr ), ( numberOfThreads > 1 ) );
+            eihEquations.update( 0.0 );
+
+            for( unsigned int i = 0; i < numberOfAcceleratedBodies; i++ )
+            {
+                Eigen::Vector3d acceleration = eihEquations.getAccelerationOfBody( i );
+                for( int k = 0; k < 3; k++ )
+                {
+                    BOOST_CHECK_CLOSE_FRACTION( acceleration( k ), expectedStateDerivative.at( 6 * i + 3 + k ), 1.0E-14 );
+                }
+
+                // Distribution over threads must not influence results
+                if( numberOfThreads == 1 )
+                {
+                    singleThreadAccelerations.push_back( acceleration );
+                }
+                else
+                {
+                    BOOST_CHECK( acceleration == singleThreadAccelerations.at( i ) );
+                }
+
+                // Check consistency of pair quantities, and of corrections with their sums
+                for( int j = 0; j < numberOfBodies; j++ )
+                {
+                    Eigen::Vector3d expectedRelativePosition =
+                            stateFunctions.at( j )( ).segment( 0, 3 ) - stateFunctions.at( i )( ).segment( 0, 3 );
+                    BOOST_CHECK( eihEquations.getRelativePositions( i, j ) == expectedRelativePosition );
+                    BOOST_CHECK( eihEquations.getRelativePositions( j, i ) == -expectedRelativePosition );
+                    BOOST_CHECK_EQUAL( eihEquations.getRelativeDistance( i, j ), eihEquations.getRelativeDistance( j, i ) );
+
+                    if( static_cast< int >( i ) != j )
+                    {
+                        BOOST_CHECK_CLOSE_FRACTION( eihEquations.getRelativeDistance( i, j ),
+                                                    expectedRelativePosition.norm( ), 1.0E-15 );
+                        double summedScalarCorrection = 0.0;
+                        for( int k = 0; k < 7; k++ )
+                        {
+                            summedScalarCorrection += eihEquations.getScalarEihCorrection( k, i, j );
+                        }
+                        BOOST_CHECK_CLOSE_FRACTION( summedScalarCorrection,
+                                                    eihEquations.getTotalScalarTermCorrection( i, j ), 1.0E-14 );
+
+                        Eigen::Vector3d summedVectorCorrection = Eigen::Vector3d::Zero( );
+                        for( int k = 0; k < 3; k++ )
+                        {
+                            summedVectorCorrection += eihEquations.getVectorEihCorrection( k, i, j );
+                        }
+                        for( int k = 0; k < 3; k++ )
+                        {
+                            BOOST_CHECK_CLOSE_FRACTION( summedVectorCorrection( k ),
+                                                        eihEquations.getTotalVectorTermCorrection( i, j )( k ), 1.0E-13 );
+                        }
+                    }
+                    else
+                    {
+                        BOOST_CHECK_EQUAL( eihEquations.getTotalScalarTermCorrection( i, j ), 0.0 );
+                        BOOST_CHECK_EQUAL( eihEquations.getSingleSourceLocalPotential( i, j ), 0.0 );
+                    }
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
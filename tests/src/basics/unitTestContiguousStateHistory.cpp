@@ -0,0 +1,126 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tudat/basics/contiguousStateHistory.h>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_contiguous_state_history )
+
+//! Test whether contiguous history reproduces the behaviour of a std::map, for forward and backward histories
+BOOST_AUTO_TEST_CASE( testContiguousStateHistoryAgainstMap )
+{
+    for( int direction = -1; direction <= 1; direction += 2 )
+    {
+        utilities::ContiguousStateHistory< double, double > history;
+        std::map< double, Eigen::VectorXd > historyMap;
+
+        for( int i = 0; i < 100; i++ )
+        {
+            double currentTime = direction * 10.0 * i;
+            Eigen::VectorXd currentState = Eigen::VectorXd::LinSpaced( 6, i, 2.0 * i + 1.0 );
+            history.addEntry( currentTime, currentState );
+            historyMap[ currentTime ] = currentState;
+        }
+
+        // Overwrite last entry, remove and replace it, and insert an entry in the middle of the history
+        history.addEntry( direction * 990.0, Eigen::VectorXd::Constant( 6, -1.0 ) );
+        historyMap[ direction * 990.0 ] = Eigen::VectorXd::Constant( 6, -1.0 );
+
+        history.removeLastEntry( );
+        historyMap.erase( direction * 990.0 );
+        history.addEntry( direction * 985.0, Eigen::VectorXd::Constant( 6, -2.0 ) );
+        historyMap[ direction * 985.0 ] = Eigen::VectorXd::Constant( 6, -2.0 );
+
+        history.addEntry( direction * 15.0, Eigen::VectorXd::Constant( 6, -3.0 ) );
+        historyMap[ direction * 15.0 ] = Eigen::VectorXd::Constant( 6, -3.0 );
+
+        BOOST_CHECK_EQUAL( history.size( ), historyMap.size( ) );
+
+        // Compare map view
+        std::map< double, Eigen::VectorXd > retrievedMap = history.getMap( );
+        BOOST_CHECK_EQUAL( retrievedMap.size( ), historyMap.size( ) );
+        for( auto it : historyMap )
+        {
+            BOOST_CHECK_EQUAL( retrievedMap.count( it.first ), 1 );
+            BOOST_CHECK( retrievedMap.at( it.first ) == it.second );
+        }
+
+        // Compare sorted contiguous history
+        history.sortByTime( );
+        unsigned int index = 0;
+        for( auto it : historyMap )
+        {
+            BOOST_CHECK_EQUAL( history.getTime( index ), it.first );
+            BOOST_CHECK( history.getEntry( index ) == it.second );
+            BOOST_CHECK( history.getValuesMatrix( ).col( index ) == it.second );
+            index++;
+        }
+    }
+}
+
+//! Test merging of histories (as done for non-sequential propagation) and matrix-valued entries
+BOOST_AUTO_TEST_CASE( testContiguousStateHistoryMerge )
+{
+    utilities::ContiguousStateHistory< double, double, Eigen::Dynamic > forwardHistory;
+    utilities::ContiguousStateHistory< double, double, Eigen::Dynamic > backwardHistory;
+    std::map< double, Eigen::MatrixXd > historyMap;
+
+    for( int i = 0; i < 50; i++ )
+    {
+        Eigen::MatrixXd forwardEntry = Eigen::MatrixXd::Constant( 3, 4, i );
+        forwardEntry( 2, 3 ) = 1.0;
+        Eigen::MatrixXd backwardEntry = Eigen::MatrixXd::Constant( 3, 4, -i );
+        backwardEntry( 2, 3 ) = -1.0;
+
+        forwardHistory.addEntry( 3.0 * i, forwardEntry );
+        backwardHistory.addEntry( -2.0 * i, backwardEntry );
+
+        historyMap.insert( std::make_pair( 3.0 * i, forwardEntry ) );
+    }
+    for( int i = 0; i < 50; i++ )
+    {
+        Eigen::MatrixXd backwardEntry = Eigen::MatrixXd::Constant( 3, 4, -i );
+        backwardEntry( 2, 3 ) = -1.0;
+        historyMap.insert( std::make_pair( -2.0 * i, backwardEntry ) );
+    }
+
+    forwardHistory.merge( backwardHistory );
+    BOOST_CHECK_EQUAL( forwardHistory.size( ), historyMap.size( ) );
+
+    unsigned int index = 0;
+    for( auto it : historyMap )
+    {
+        BOOST_CHECK_EQUAL( forwardHistory.getTime( index ), it.first );
+        BOOST_CHECK( forwardHistory.getEntry( index ) == it.second );
+        index++;
+    }
+
+    // Check that clearing retains entry size checks, and that inconsistent entries are rejected
+    forwardHistory.clear( );
+    BOOST_CHECK_EQUAL( forwardHistory.size( ), 0 );
+    forwardHistory.addEntry( 0.0, Eigen::MatrixXd::Zero( 2, 2 ) );
+    BOOST_CHECK_THROW( forwardHistory.addEntry( 1.0, Eigen::MatrixXd::Zero( 3, 2 ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
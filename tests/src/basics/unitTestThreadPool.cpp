@@ -0,0 +1,191 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tudat/basics/threadPool.h>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_thread_pool )
+
+//! Test whether all tasks are executed exactly once, on a valid thread, for repeated task lists.
+BOOST_AUTO_TEST_CASE( testThreadPoolTaskExecution )
+{
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads++ )
+    {
+        utilities::ThreadPool threadPool( numberOfThreads );
+        BOOST_CHECK_EQUAL( threadPool.getNumberOfThreads( ), numberOfThreads );
+
+        // Run several task lists on the same pool, to check reuse of worker threads
+        for( int numberOfTasks = 0; numberOfTasks < 200; numberOfTasks += 7 )
+        {
+            std::vector< int > taskExecutionCount( numberOfTasks, 0 );
+            std::vector< unsigned int > taskThreadIndex( numberOfTasks, 0 );
+            threadPool.runParallelTasks(
+                        numberOfTasks, [ & ]( const int taskIndex, const unsigned int threadIndex )
+            {
+                taskExecutionCount[ taskIndex ]++;
+                taskThreadIndex[ taskIndex ] = threadIndex;
+            } );
+
+            for( int i = 0; i < numberOfTasks; i++ )
+            {
+                BOOST_CHECK_EQUAL( taskExecutionCount[ i ], 1 );
+                BOOST_CHECK( taskThreadIndex[ i ] < numberOfThreads );
+            }
+        }
+    }
+}
+
+//! Test whether per-thread work objects produce the same result as a serial computation.
+BOOST_AUTO_TEST_CASE( testThreadPoolPerThreadData )
+{
+    int numberOfTasks = 1000;
+    std::shared_ptr< utilities::ThreadPool > threadPool = std::make_shared< utilities::ThreadPool >( 4 );
+
+    std::vector< double > serialResults( numberOfTasks );
+    std::vector< double > parallelResults( numberOfTasks );
+    std::vector< std::vector< double > > perThreadBuffers( threadPool->getNumberOfThreads( ), std::vector< double >( 10 ) );
+
+    auto computeTask = [ & ]( const int taskIndex, const unsigned int threadIndex, std::vector< double >& results )
+    {
+        std::vector< double >& buffer = perThreadBuffers.at( threadIndex );
+        for( unsigned int j = 0; j < buffer.size( ); j++ )
+        {
+            buffer[ j ] = static_cast< double >( taskIndex ) / static_cast< double >( j + 1 );
+        }
+        double sum = 0.0;
+        for( unsigned int j = 0; j < buffer.size( ); j++ )
+        {
+            sum += buffer[ j ];
+        }
+        results[ taskIndex ] = sum;
+    };
+
+    utilities::runTasks( nullptr, numberOfTasks, [ & ]( const int taskIndex, const unsigned int threadIndex )
+    {
+        computeTask( taskIndex, threadIndex, serialResults );
+    } );
+    utilities::runTasks( threadPool, numberOfTasks, [ & ]( const int taskIndex, const unsigned int threadIndex )
+    {
+        computeTask( taskIndex, threadIndex, parallelResults );
+    } );
+
+    for( int i = 0; i < numberOfTasks; i++ )
+    {
+        BOOST_CHECK_EQUAL( serialResults[ i ], parallelResults[ i ] );
+    }
+}
+
+//! Test whether exceptions thrown by a task are propagated to the calling thread, and pool remains usable.
+BOOST_AUTO_TEST_CASE( testThreadPoolExceptionHandling )
+{
+    utilities::ThreadPool threadPool( 3 );
+
+    bool isExceptionCaught = false;
+    try
+    {
+        threadPool.runParallelTasks( 100, [ ]( const int taskIndex, const unsigned int )
+        {
+            if( taskIndex == 42 )
+            {
+                throw std::runtime_error( "Test exception" );
+            }
+        } );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+
+    std::vector< int > taskExecutionCount( 50, 0 );
+    threadPool.runParallelTasks( 50, [ & ]( const int taskIndex, const unsigned int )
+    {
+        taskExecutionCount[ taskIndex ]++;
+    } );
+    for( int i = 0; i < 50; i++ )
+    {
+        BOOST_CHECK_EQUAL( taskExecutionCount[ i ], 1 );
+    }
+}
+
+//! Test whether task lists provided concurrently from different threads, or from within a task, are all executed.
+BOOST_AUTO_TEST_CASE( testThreadPoolConcurrentTaskLists )
+{
+    utilities::ThreadPool threadPool( 4 );
+
+    // Nested task lists are executed serially on the thread of the calling task
+    std::vector< std::vector< int > > nestedTaskExecutionCount( 20, std::vector< int >( 30, 0 ) );
+    std::vector< std::vector< unsigned int > > nestedTaskThreadIndex( 20, std::vector< unsigned int >( 30, 0 ) );
+    threadPool.runParallelTasks( 20, [ & ]( const int taskIndex, const unsigned int )
+    {
+        threadPool.runParallelTasks( 30, [ & ]( const int nestedTaskIndex, const unsigned int nestedThreadIndex )
+        {
+            nestedTaskExecutionCount[ taskIndex ][ nestedTaskIndex ]++;
+            nestedTaskThreadIndex[ taskIndex ][ nestedTaskIndex ] = nestedThreadIndex;
+        } );
+    } );
+    for( unsigned int i = 0; i < nestedTaskExecutionCount.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < nestedTaskExecutionCount[ i ].size( ); j++ )
+        {
+            BOOST_CHECK_EQUAL( nestedTaskExecutionCount[ i ][ j ], 1 );
+            BOOST_CHECK_EQUAL( nestedTaskThreadIndex[ i ][ j ], 0 );
+        }
+    }
+
+    // Task lists provided by different threads at the same time
+    int numberOfCallingThreads = 4;
+    int numberOfTasks = 500;
+    std::vector< std::vector< int > > taskExecutionCount(
+                numberOfCallingThreads, std::vector< int >( numberOfTasks, 0 ) );
+    std::vector< std::thread > callingThreads;
+    for( int i = 0; i < numberOfCallingThreads; i++ )
+    {
+        callingThreads.push_back( std::thread( [ &, i ]( )
+        {
+            for( int j = 0; j < 20; j++ )
+            {
+                threadPool.runParallelTasks( numberOfTasks, [ & ]( const int taskIndex, const unsigned int )
+                {
+                    taskExecutionCount[ i ][ taskIndex ]++;
+                } );
+            }
+        } ) );
+    }
+    for( int i = 0; i < numberOfCallingThreads; i++ )
+    {
+        callingThreads.at( i ).join( );
+    }
+    for( int i = 0; i < numberOfCallingThreads; i++ )
+    {
+        for( int j = 0; j < numberOfTasks; j++ )
+        {
+            BOOST_CHECK_EQUAL( taskExecutionCount[ i ][ j ], 20 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
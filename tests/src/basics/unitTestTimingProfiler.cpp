@@ -0,0 +1,125 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tudat/basics/timingProfiler.h>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_timing_profiler )
+
+//! Test whether the number of calls and accumulated times are correctly registered, and reset.
+BOOST_AUTO_TEST_CASE( testTimingProfilerMeasurements )
+{
+    utilities::TimingProfiler profiler;
+    int firstEntry = profiler.addEntry( "acceleration", "point mass gravity exerted by Earth on Vehicle" );
+    int secondEntry = profiler.addEntry( "acceleration", "aerodynamic exerted by Earth on Vehicle" );
+    int thirdEntry = profiler.addEntry( "dependent_variable", "altitude" );
+    BOOST_CHECK_EQUAL( firstEntry, 0 );
+    BOOST_CHECK_EQUAL( secondEntry, 1 );
+    BOOST_CHECK_EQUAL( thirdEntry, 2 );
+
+    for( int i = 0; i < 3; i++ )
+    {
+        utilities::ScopedTimingMeasurement timingMeasurement( &profiler, firstEntry );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+    }
+    {
+        utilities::ScopedTimingMeasurement timingMeasurement( &profiler, secondEntry );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    profiler.setTime( thirdEntry, 4, std::chrono::milliseconds( 8 ) );
+
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).at( firstEntry ).numberOfCalls_, 3 );
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).at( secondEntry ).numberOfCalls_, 1 );
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).at( thirdEntry ).numberOfCalls_, 4 );
+    BOOST_CHECK( profiler.getTotalTime( firstEntry ) >= 6.0E-3 );
+    BOOST_CHECK( profiler.getTotalTime( secondEntry ) >= 1.0E-3 );
+    BOOST_CHECK_CLOSE_FRACTION( profiler.getTotalTime( thirdEntry ), 8.0E-3, 1.0E-12 );
+
+    // Check sum and breakdown per category
+    BOOST_CHECK_CLOSE_FRACTION( profiler.getTotalTimeOfCategory( "acceleration" ),
+                                profiler.getTotalTime( firstEntry ) + profiler.getTotalTime( secondEntry ), 1.0E-12 );
+    BOOST_CHECK_EQUAL( profiler.getTotalTimeOfCategory( "torque" ), 0.0 );
+    std::map< std::string, double > accelerationBreakdown = profiler.getTimeBreakdownOfCategory( "acceleration" );
+    BOOST_CHECK_EQUAL( accelerationBreakdown.size( ), 2 );
+    BOOST_CHECK_EQUAL( accelerationBreakdown.at( "aerodynamic exerted by Earth on Vehicle" ),
+                       profiler.getTotalTime( secondEntry ) );
+
+    // Check reset
+    profiler.resetTimes( );
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).size( ), 3 );
+    for( unsigned int i = 0; i < profiler.getEntries( ).size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( profiler.getEntries( ).at( i ).numberOfCalls_, 0 );
+        BOOST_CHECK_EQUAL( profiler.getTotalTime( i ), 0.0 );
+    }
+}
+
+//! Test whether no measurements are performed for a disabled or absent profiler.
+BOOST_AUTO_TEST_CASE( testDisabledTimingProfiler )
+{
+    utilities::TimingProfiler profiler( false );
+    int entry = profiler.addEntry( "environment_update", "body translational state of Earth" );
+    {
+        utilities::ScopedTimingMeasurement timingMeasurement( &profiler, entry );
+    }
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).at( entry ).numberOfCalls_, 0 );
+
+    profiler.setIsEnabled( true );
+    {
+        utilities::ScopedTimingMeasurement timingMeasurement( &profiler, entry );
+    }
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).at( entry ).numberOfCalls_, 1 );
+
+    // Measurement without profiler should have no effect
+    {
+        utilities::ScopedTimingMeasurement timingMeasurement( nullptr, entry );
+    }
+    BOOST_CHECK_EQUAL( profiler.getEntries( ).at( entry ).numberOfCalls_, 1 );
+}
+
+//! Test the comma-separated output of the timing breakdown.
+BOOST_AUTO_TEST_CASE( testTimingProfilerOutput )
+{
+    utilities::TimingProfiler profiler;
+    profiler.addEntry( "propagation", "total" );
+    profiler.addEntry( "dependent_variable", "name with \"quotes\", and comma" );
+    profiler.setTime( 0, 2, std::chrono::milliseconds( 10 ) );
+
+    std::stringstream outputStream;
+    profiler.writeTimingBreakdown( outputStream );
+
+    std::string line;
+    std::getline( outputStream, line );
+    BOOST_CHECK_EQUAL( line, "category,name,number_of_calls,total_time,mean_time" );
+    std::getline( outputStream, line );
+    BOOST_CHECK_EQUAL( line, "\"propagation\",\"total\",2,0.01,0.005" );
+    std::getline( outputStream, line );
+    BOOST_CHECK_EQUAL( line, "\"dependent_variable\",\"name with \"\"quotes\"\", and comma\",0,0,0" );
+    BOOST_CHECK( !std::getline( outputStream, line ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,159 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/math/basic/blockArrowheadNormalEquations.h"
+#include "tudat/math/basic/leastSquaresEstimation.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_block_arrowhead_normal_equations )
+
+//! Test whether block-arrowhead normal equations reproduce the dense least-squares solution
+BOOST_AUTO_TEST_CASE( testBlockArrowheadNormalEquations )
+{
+    // Define parameters: 2 global parameters, 5 arcs of 6 parameters, and 3 further global parameters
+    const int numberOfArcs = 5;
+    const int numberOfParameters = 2 + 6 * numberOfArcs + 3;
+    std::vector< std::vector< int > > arcParameterIndices( numberOfArcs );
+    for( int i = 0; i < numberOfArcs; i++ )
+    {
+        for( int j = 0; j < 6; j++ )
+        {
+            arcParameterIndices[ i ].push_back( 2 + 6 * i + j );
+        }
+    }
+
+    // Create design matrix, with 30 observations per arc, followed by 10 observations depending only on global parameters
+    std::srand( 1 );
+    const int numberOfObservationsPerArc = 30;
+    const int numberOfObservations = numberOfArcs * numberOfObservationsPerArc + 10;
+    Eigen::MatrixXd designMatrix = Eigen::MatrixXd::Zero( numberOfObservations, numberOfParameters );
+    for( int i = 0; i < numberOfArcs; i++ )
+    {
+        designMatrix.block( i * numberOfObservationsPerArc, 2 + 6 * i, numberOfObservationsPerArc, 6 ) =
+                1.0E3 * Eigen::MatrixXd::Random( numberOfObservationsPerArc, 6 );
+    }
+    designMatrix.leftCols( 2 ) = Eigen::MatrixXd::Random( numberOfObservations, 2 );
+    designMatrix.rightCols( 3 ) = -1.0E-4 * Eigen::MatrixXd::Random( numberOfObservations, 3 ).cwiseAbs( );
+    Eigen::VectorXd residuals = Eigen::VectorXd::Random( numberOfObservations );
+    Eigen::VectorXd weights = Eigen::VectorXd::Random( numberOfObservations ).cwiseAbs( ) +
+            Eigen::VectorXd::Constant( numberOfObservations, 0.5 );
+
+    // Add observations in blocks of various sizes (some spanning multiple arcs), distributed over two objects
+    linear_algebra::BlockArrowheadNormalEquations normalEquations( numberOfParameters, arcParameterIndices );
+    linear_algebra::BlockArrowheadNormalEquations secondNormalEquations( numberOfParameters, arcParameterIndices );
+    int currentRow = 0, currentBlock = 0;
+    while( currentRow < numberOfObservations )
+    {
+        int blockSize = std::min( 7 + 11 * ( currentBlock % 3 ), numberOfObservations - currentRow );
+        ( ( currentBlock % 2 == 0 ) ? normalEquations : secondNormalEquations ).addObservations(
+                    designMatrix.block( currentRow, 0, blockSize, numberOfParameters ),
+                    residuals.segment( currentRow, blockSize ), weights.segment( currentRow, blockSize ) );
+        currentRow += blockSize;
+        currentBlock++;
+    }
+    normalEquations.add( secondNormalEquations );
+    BOOST_CHECK_EQUAL( normalEquations.getNumberOfArcs( ), numberOfArcs );
+
+    // Check accumulated normal equations
+    Eigen::MatrixXd expectedNormalMatrix = designMatrix.transpose( ) * weights.asDiagonal( ) * designMatrix;
+    Eigen::VectorXd expectedRightHandSide = designMatrix.transpose( ) * weights.cwiseProduct( residuals );
+    BOOST_CHECK_SMALL( ( normalEquations.getFullNormalMatrix( ) - expectedNormalMatrix ).cwiseAbs( ).maxCoeff( ) /
+                       expectedNormalMatrix.cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+    BOOST_CHECK_SMALL( ( normalEquations.getFullRightHandSide( ) - expectedRightHandSide ).cwiseAbs( ).maxCoeff( ) /
+                       expectedRightHandSide.cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+
+    // Check normalization terms (entry with largest absolute value per column)
+    Eigen::VectorXd normalizationTerms = normalEquations.getDesignMatrixNormalizationTerms( );
+    for( int i = 0; i < numberOfParameters; i++ )
+    {
+        double expectedTerm = designMatrix.col( i ).maxCoeff( );
+        if( std::fabs( designMatrix.col( i ).minCoeff( ) ) > expectedTerm )
+        {
+            expectedTerm = designMatrix.col( i ).minCoeff( );
+        }
+        BOOST_CHECK_EQUAL( normalizationTerms( i ), expectedTerm );
+    }
+
+    // Normalize, add a priori information (without inter-arc coupling), and compare solution to dense solution
+    Eigen::MatrixXd normalizedDesignMatrix = designMatrix * normalizationTerms.cwiseInverse( ).asDiagonal( );
+    Eigen::MatrixXd inverseAprioriCovariance = 1.0E-2 * Eigen::MatrixXd::Identity(
+                numberOfParameters, numberOfParameters );
+    inverseAprioriCovariance( 0, 4 ) = inverseAprioriCovariance( 4, 0 ) = 1.0E-3;
+    inverseAprioriCovariance( 8, 9 ) = inverseAprioriCovariance( 9, 8 ) = 2.0E-3;
+
+    normalEquations.normalize( normalizationTerms );
+    normalEquations.addToNormalMatrix( inverseAprioriCovariance );
+
+    std::pair< Eigen::VectorXd, Eigen::MatrixXd > denseSolution =
+            linear_algebra::performLeastSquaresAdjustmentFromDesignMatrix(
+                normalizedDesignMatrix, residuals, weights, inverseAprioriCovariance );
+    Eigen::VectorXd blockSolution = normalEquations.solve( );
+
+    BOOST_CHECK_SMALL( ( normalEquations.getFullNormalMatrix( ) - denseSolution.second ).cwiseAbs( ).maxCoeff( ) /
+                       denseSolution.second.cwiseAbs( ).maxCoeff( ), 1.0E-13 );
+    BOOST_CHECK_SMALL( ( blockSolution - denseSolution.first ).cwiseAbs( ).maxCoeff( ) /
+                       denseSolution.first.cwiseAbs( ).maxCoeff( ), 1.0E-10 );
+
+    // Check that reset clears accumulated normal equations
+    normalEquations.reset( );
+    BOOST_CHECK_EQUAL( normalEquations.getFullNormalMatrix( ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    BOOST_CHECK_EQUAL( normalEquations.getDesignMatrixNormalizationTerms( ).minCoeff( ), 1.0 );
+}
+
+//! Test whether inconsistent input is rejected
+BOOST_AUTO_TEST_CASE( testBlockArrowheadNormalEquationsErrors )
+{
+    std::vector< std::vector< int > > arcParameterIndices = { { 1, 2 }, { 3, 4 } };
+    linear_algebra::BlockArrowheadNormalEquations normalEquations( 6, arcParameterIndices );
+
+    // Observation coupling two arcs
+    Eigen::MatrixXd partials = Eigen::MatrixXd::Zero( 2, 6 );
+    partials( 0, 0 ) = partials( 0, 1 ) = 1.0;
+    partials( 1, 2 ) = partials( 1, 4 ) = 1.0;
+    BOOST_CHECK_THROW( normalEquations.addObservations( partials, Eigen::VectorXd::Ones( 2 ), Eigen::VectorXd::Ones( 2 ) ),
+                       std::runtime_error );
+
+    // Inconsistent sizes
+    BOOST_CHECK_THROW( normalEquations.addObservations(
+                           partials.leftCols( 5 ), Eigen::VectorXd::Ones( 2 ), Eigen::VectorXd::Ones( 2 ) ),
+                       std::runtime_error );
+
+    // A priori covariance coupling two arcs
+    Eigen::MatrixXd inverseAprioriCovariance = Eigen::MatrixXd::Identity( 6, 6 );
+    inverseAprioriCovariance( 1, 3 ) = inverseAprioriCovariance( 3, 1 ) = 0.1;
+    BOOST_CHECK_THROW( normalEquations.addToNormalMatrix( inverseAprioriCovariance ), std::runtime_error );
+
+    // Parameter assigned to multiple arcs
+    BOOST_CHECK_THROW( linear_algebra::BlockArrowheadNormalEquations( 6, { { 1, 2 }, { 2, 3 } } ), std::runtime_error );
+    BOOST_CHECK_THROW( linear_algebra::BlockArrowheadNormalEquations( 6, { { 1, 6 } } ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
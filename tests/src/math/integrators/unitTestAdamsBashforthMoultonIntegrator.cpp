@@ -32,6 +32,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "tudat/math/integrators/adamsBashforthMoultonIntegrator.h"
+#include "tudat/math/integrators/createNumericalIntegrator.h"
 #include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
 #include "tudat/math/integrators/rungeKuttaCoefficients.h"
 #include "tudat/math/integrators/numericalIntegratorTestFunctions.h"
@@ -165,6 +166,211 @@ BOOST_AUTO_TEST_CASE( test_AdamsBashforthMoulton_Integrator_Compare78_VanDerPol
     BOOST_CHECK_SMALL( std::fabs( difference( 1 ) ), 5E-12 );
 }
 
+//! Test interpolation of the state within the last integration step
+BOOST_AUTO_TEST_CASE( test_AdamsBashforthMoulton_Integrator_Interpolation )
+{
+    // Initial conditions (analytical solution known)
+    double initialTime = 0.0;
+    Eigen::VectorXd initialState = computeAnalyticalStateFehlbergODE( initialTime, Eigen::VectorXd::Zero( 2 ) );
+
+    AdamsBashforthMoultonIntegratorXd integrator_abam(
+                computeFehlbergLogirithmicTestODEStateDerivative, initialTime, initialState,
+                std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ), 1.0E-3,
+                1.0E-13, 1.0E-13 );
+
+    for( unsigned int i = 0; i < 300; i++ )
+    {
+        Eigen::VectorXd previousState = integrator_abam.getCurrentState( );
+        double previousTime = integrator_abam.getCurrentIndependentVariable( );
+        integrator_abam.performIntegrationStep( integrator_abam.getNextStepSize( ) );
+        double currentTime = integrator_abam.getCurrentIndependentVariable( );
+        BOOST_CHECK_EQUAL( integrator_abam.getPreviousIndependentVariable( ), previousTime );
+
+        // Interpolated state must be equal to the current state at the end of the step, and close to the state at start
+        Eigen::VectorXd difference = integrator_abam.getInterpolatedState( currentTime ) - integrator_abam.getCurrentState( );
+        BOOST_CHECK_EQUAL( difference.norm( ), 0.0 );
+        difference = integrator_abam.getInterpolatedState( previousTime ) - previousState;
+        BOOST_CHECK_SMALL( difference.norm( ), 1.0E-10 );
+
+        // Check interpolated state against analytical solution, after startup of the integrator
+        if( i > 30 )
+        {
+            for( double fraction: { 0.25, 0.5, 0.75 } )
+            {
+                double interpolationTime = previousTime + fraction * ( currentTime - previousTime );
+                difference = integrator_abam.getInterpolatedState( interpolationTime ) -
+                        computeAnalyticalStateFehlbergODE( interpolationTime, initialState );
+                BOOST_CHECK_SMALL( difference.norm( ), 1.0E-10 );
+            }
+        }
+    }
+    BOOST_CHECK_GT( integrator_abam.getCurrentIndependentVariable( ), 1.0 );
+
+    // Check that interpolation outside of the last step is rejected
+    BOOST_CHECK_THROW( integrator_abam.getInterpolatedState( integrator_abam.getCurrentIndependentVariable( ) + 1.0E-3 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( integrator_abam.getInterpolatedState( integrator_abam.getPreviousIndependentVariable( ) - 1.0E-3 ),
+                       std::runtime_error );
+}
+
+//! Test integration up to order 12
+BOOST_AUTO_TEST_CASE( test_AdamsBashforthMoulton_Integrator_MaximumOrder )
+{
+    double initialTime = 0.0;
+    Eigen::VectorXd initialState = computeAnalyticalStateFehlbergODE( initialTime, Eigen::VectorXd::Zero( 2 ) );
+
+    AdamsBashforthMoultonIntegratorXd integrator_abam(
+                computeFehlbergLogirithmicTestODEStateDerivative, initialTime, initialState,
+                std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ), 1.0E-3,
+                1.0E-12, 1.0E-12 );
+    integrator_abam.setMaximumOrder( 12 );
+
+    unsigned int maximumOrderUsed = 0;
+    for( unsigned int i = 0; i < 2000 && integrator_abam.getCurrentIndependentVariable( ) < 1.5; i++ )
+    {
+        integrator_abam.performIntegrationStep( integrator_abam.getNextStepSize( ) );
+        maximumOrderUsed = std::max( maximumOrderUsed, integrator_abam.getOrder( ) );
+    }
+    BOOST_CHECK_EQUAL( maximumOrderUsed, 12 );
+
+    Eigen::VectorXd difference = integrator_abam.getCurrentState( ) - computeAnalyticalStateFehlbergODE(
+                integrator_abam.getCurrentIndependentVariable( ), initialState );
+    BOOST_CHECK_SMALL( difference.norm( ), 1.0E-11 );
+
+    // Check that unsupported orders are rejected
+    BOOST_CHECK_THROW( integrator_abam.setMaximumOrder( 13 ), std::runtime_error );
+    BOOST_CHECK_THROW( integrator_abam.setMinimumOrder( 0 ), std::runtime_error );
+}
+
+//! Test continuation of integration from the history of a previous integrator
+BOOST_AUTO_TEST_CASE( test_AdamsBashforthMoulton_Integrator_History )
+{
+    double initialTime = 0.0;
+    Eigen::VectorXd initialState = computeAnalyticalStateFehlbergODE( initialTime, Eigen::VectorXd::Zero( 2 ) );
+
+    int numberOfEvaluations = 0;
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            [ & ]( const double time, const Eigen::VectorXd& state )
+    {
+        numberOfEvaluations++;
+        return computeFehlbergLogirithmicTestODEStateDerivative( time, state );
+    };
+
+    // Integrate for a number of steps, and continue with new integrator from the current state
+    AdamsBashforthMoultonIntegratorXd integrator_abam(
+                stateDerivativeFunction, initialTime, initialState,
+                std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ), 1.0E-3,
+                1.0E-12, 1.0E-12 );
+    for( unsigned int i = 0; i < 100; i++ )
+    {
+        integrator_abam.performIntegrationStep( integrator_abam.getNextStepSize( ) );
+    }
+    AdamsBashforthMoultonIntegratorXd restartedIntegrator_abam(
+                stateDerivativeFunction, integrator_abam.getCurrentIndependentVariable( ),
+                integrator_abam.getCurrentState( ),
+                std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ), 1.0E-3,
+                1.0E-12, 1.0E-12 );
+
+    // History with different dynamics is rejected
+    AdamsBashforthMoultonIntegratorXd modifiedIntegrator_abam(
+                [ ]( const double time, const Eigen::VectorXd& state )
+    {
+        return ( 1.0 + 1.0E-12 ) * computeFehlbergLogirithmicTestODEStateDerivative( time, state );
+    }, integrator_abam.getCurrentIndependentVariable( ), integrator_abam.getCurrentState( ),
+    std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ), 1.0E-3, 1.0E-12, 1.0E-12 );
+    BOOST_CHECK( !modifiedIntegrator_abam.setIntegrationHistory( integrator_abam.getIntegrationHistory( ) ) );
+
+    // History at different state is rejected
+    AdamsBashforthMoultonIntegratorXd shiftedIntegrator_abam(
+                stateDerivativeFunction, integrator_abam.getCurrentIndependentVariable( ),
+                integrator_abam.getCurrentState( ) * ( 1.0 + 1.0E-15 ),
+                std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ), 1.0E-3,
+                1.0E-12, 1.0E-12 );
+    BOOST_CHECK( !shiftedIntegrator_abam.setIntegrationHistory( integrator_abam.getIntegrationHistory( ) ) );
+
+    BOOST_CHECK( restartedIntegrator_abam.setIntegrationHistory( integrator_abam.getIntegrationHistory( ) ) );
+    BOOST_CHECK_EQUAL( restartedIntegrator_abam.getNextStepSize( ), integrator_abam.getNextStepSize( ) );
+    BOOST_CHECK_EQUAL( restartedIntegrator_abam.getOrder( ), integrator_abam.getOrder( ) );
+
+    // Check that restarted integrator continues identically, without single-step startup
+    int numberOfEvaluationsBeforeSteps = numberOfEvaluations;
+    for( unsigned int i = 0; i < 100; i++ )
+    {
+        integrator_abam.performIntegrationStep( integrator_abam.getNextStepSize( ) );
+    }
+    int numberOfContinuedEvaluations = numberOfEvaluations - numberOfEvaluationsBeforeSteps;
+
+    numberOfEvaluationsBeforeSteps = numberOfEvaluations;
+    for( unsigned int i = 0; i < 100; i++ )
+    {
+        restartedIntegrator_abam.performIntegrationStep( restartedIntegrator_abam.getNextStepSize( ) );
+    }
+    BOOST_CHECK_EQUAL( numberOfEvaluations - numberOfEvaluationsBeforeSteps, numberOfContinuedEvaluations );
+
+    BOOST_CHECK_EQUAL( restartedIntegrator_abam.getCurrentIndependentVariable( ),
+                       integrator_abam.getCurrentIndependentVariable( ) );
+    for( int i = 0; i < 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( restartedIntegrator_abam.getCurrentState( )( i ), integrator_abam.getCurrentState( )( i ) );
+    }
+}
+
+//! Test continuation of integration from the history stored in the integrator settings
+BOOST_AUTO_TEST_CASE( test_AdamsBashforthMoulton_Integrator_HistoryFromSettings )
+{
+    double initialTime = 0.0;
+    Eigen::VectorXd initialState = computeAnalyticalStateFehlbergODE( initialTime, Eigen::VectorXd::Zero( 2 ) );
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeFehlbergLogirithmicTestODEStateDerivative;
+
+    std::shared_ptr< IntegratorSettings< double > > integratorSettings = adamsBashforthMoultonSettings< double >(
+                1.0E-3, std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ),
+                1.0E-12, 1.0E-12 );
+    std::shared_ptr< AdamsBashforthMoultonSettings< double > > adamsBashforthMoultonIntegratorSettings =
+            std::dynamic_pointer_cast< AdamsBashforthMoultonSettings< double > >( integratorSettings );
+
+    // History is only stored if requested
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator =
+            createIntegrator< double, Eigen::VectorXd, double >(
+                stateDerivativeFunction, initialState, initialTime, integratorSettings );
+    for( unsigned int i = 0; i < 100; i++ )
+    {
+        integrator->performIntegrationStep( integrator->getNextStepSize( ) );
+    }
+    saveIntegrationHistoryToSettings( integrator, integratorSettings );
+    BOOST_CHECK( adamsBashforthMoultonIntegratorSettings->integrationHistory_ == nullptr );
+
+    adamsBashforthMoultonIntegratorSettings->reuseIntegrationHistory_ = true;
+    saveIntegrationHistoryToSettings( integrator, integratorSettings );
+    BOOST_CHECK( adamsBashforthMoultonIntegratorSettings->integrationHistory_ != nullptr );
+    BOOST_CHECK( std::dynamic_pointer_cast< AdamsBashforthMoultonSettings< double > >(
+                     integratorSettings->clone( ) )->integrationHistory_ ==
+                 adamsBashforthMoultonIntegratorSettings->integrationHistory_ );
+
+    // Integrator restarted at current state continues from stored history, and is identical to the original integrator
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > restartedIntegrator =
+            createIntegrator< double, Eigen::VectorXd, double >(
+                stateDerivativeFunction, integrator->getCurrentState( ), integrator->getCurrentIndependentVariable( ),
+                integratorSettings );
+    BOOST_CHECK_EQUAL( restartedIntegrator->getNextStepSize( ), integrator->getNextStepSize( ) );
+    for( unsigned int i = 0; i < 100; i++ )
+    {
+        integrator->performIntegrationStep( integrator->getNextStepSize( ) );
+        restartedIntegrator->performIntegrationStep( restartedIntegrator->getNextStepSize( ) );
+    }
+    BOOST_CHECK_EQUAL( restartedIntegrator->getCurrentIndependentVariable( ), integrator->getCurrentIndependentVariable( ) );
+    for( int i = 0; i < 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( restartedIntegrator->getCurrentState( )( i ), integrator->getCurrentState( )( i ) );
+    }
+
+    // Integrator started at other state ignores stored history
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > newIntegrator =
+            createIntegrator< double, Eigen::VectorXd, double >(
+                stateDerivativeFunction, initialState, initialTime, integratorSettings );
+    BOOST_CHECK_EQUAL( newIntegrator->getNextStepSize( ), 1.0E-3 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
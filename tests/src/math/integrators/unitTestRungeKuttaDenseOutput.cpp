@@ -0,0 +1,217 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/tabulatedEphemeris.h"
+#include "tudat/math/integrators/rungeKuttaDenseOutput.h"
+#include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "tudat/math/integrators/numericalIntegratorTestFunctions.h"
+#include "tudat/math/interpolators/rungeKuttaDenseOutputInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+using namespace numerical_integrator_test_functions;
+
+BOOST_AUTO_TEST_SUITE( test_runge_kutta_dense_output )
+
+//! Function to compute the state derivative of two independent Keplerian orbits (gravitational parameter of 1)
+Eigen::VectorXd computeTwoKeplerOrbitsStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative( 12 );
+    for( int i = 0; i < 2; i++ )
+    {
+        stateDerivative.segment( 6 * i, 3 ) = state.segment( 6 * i + 3, 3 );
+        stateDerivative.segment( 6 * i + 3, 3 ) = -state.segment( 6 * i, 3 ) / std::pow( state.segment( 6 * i, 3 ).norm( ), 3 );
+    }
+    return stateDerivative;
+}
+
+//! Test order and continuity of the continuous extensions of the embedded Runge-Kutta methods
+BOOST_AUTO_TEST_CASE( testRungeKuttaContinuousExtensionOrder )
+{
+    // Expected orders of the continuous extension without, and with, additional stages
+    std::map< CoefficientSets, std::pair< int, int > > expectedOrders;
+    expectedOrders[ rungeKuttaFehlberg45 ] = std::make_pair( 3, 3 );
+    expectedOrders[ rungeKuttaFehlberg56 ] = std::make_pair( 4, 4 );
+    expectedOrders[ rungeKuttaFehlberg78 ] = std::make_pair( 5, 5 );
+    expectedOrders[ rungeKutta87DormandPrince ] = std::make_pair( 5, 7 );
+    expectedOrders[ rungeKuttaFehlberg89 ] = std::make_pair( 6, 6 );
+    expectedOrders[ rungeKuttaVerner89 ] = std::make_pair( 6, 6 );
+
+    Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+    for( auto orderIterator : expectedOrders )
+    {
+        const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get( orderIterator.first );
+        const Eigen::VectorXd integratedWeights =
+                coefficients.bCoefficients.row( coefficients.orderEstimateToIntegrate ).transpose( );
+
+        // Check order of continuous extension, and continuity with integrated estimate
+        int continuousExtensionOrder;
+        Eigen::MatrixXd continuousExtensionCoefficients =
+                computeRungeKuttaContinuousExtensionCoefficients( coefficients, continuousExtensionOrder );
+        BOOST_CHECK_EQUAL( continuousExtensionOrder, orderIterator.second.first );
+        BOOST_CHECK_SMALL( ( continuousExtensionCoefficients.rowwise( ).sum( ) - integratedWeights ).
+                           cwiseAbs( ).maxCoeff( ), 1.0E-12 );
+
+        // Check order of continuous extension with additional stages (which do not contribute at the end of the step)
+        Eigen::VectorXd additionalStageNodes = getRungeKuttaContinuousExtensionAdditionalStageNodes( coefficients );
+        BOOST_CHECK_EQUAL( additionalStageNodes.rows( ) > 0, orderIterator.first == rungeKutta87DormandPrince );
+        Eigen::MatrixXd additionalStageCoefficients;
+        continuousExtensionCoefficients = computeRungeKuttaContinuousExtensionCoefficients(
+                    coefficients, additionalStageNodes, additionalStageCoefficients, continuousExtensionOrder );
+        BOOST_CHECK_EQUAL( continuousExtensionOrder, orderIterator.second.second );
+        BOOST_CHECK_SMALL( ( continuousExtensionCoefficients.rowwise( ).sum( ).segment( 0, integratedWeights.rows( ) ) -
+                             integratedWeights ).cwiseAbs( ).maxCoeff( ), 1.0E-12 );
+        if( additionalStageNodes.rows( ) > 0 )
+        {
+            BOOST_CHECK_SMALL( continuousExtensionCoefficients.rowwise( ).sum( ).segment(
+                                   integratedWeights.rows( ), additionalStageNodes.rows( ) ).cwiseAbs( ).maxCoeff( ), 1.0E-12 );
+        }
+
+        // Check convergence of local error of dense output at mid-step (should scale as h^(p+1) for order p), with and
+        // without additional stages
+        for( bool useAdditionalStages : { false, true } )
+        {
+            const int expectedOrder = useAdditionalStages ? orderIterator.second.second : orderIterator.second.first;
+            std::vector< double > midStepErrors;
+            for( double stepSize = 0.2; stepSize > 0.04; stepSize /= 2.0 )
+            {
+                RungeKuttaVariableStepSizeIntegratorXd integrator(
+                            coefficients, computeFehlbergLogirithmicTestODEStateDerivative, 0.0, initialState,
+                            std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ),
+                            stepSize, 1.0, 1.0 );
+                integrator.setStepSizeControl( false );
+                integrator.setDenseOutputStorage( true, useAdditionalStages );
+                integrator.performIntegrationStep( stepSize );
+                BOOST_CHECK_EQUAL( integrator.getDenseOutput( )->getContinuousExtensionOrder( ), expectedOrder );
+
+                midStepErrors.push_back(
+                            ( integrator.getDenseOutput( )->getState( 0.5 * stepSize ) -
+                              computeAnalyticalStateFehlbergODE( 0.5 * stepSize, initialState ) ).cwiseAbs( ).maxCoeff( ) );
+            }
+            for( unsigned int i = 1; i < midStepErrors.size( ); i++ )
+            {
+                BOOST_CHECK_GT( std::log2( midStepErrors.at( i - 1 ) / midStepErrors.at( i ) ),
+                                static_cast< double >( expectedOrder ) + 0.5 );
+            }
+        }
+    }
+}
+
+//! Test dense output of variable step-size integration, and its use as an ephemeris
+BOOST_AUTO_TEST_CASE( testRungeKuttaDenseOutputEphemeris )
+{
+    // Define initial state of two eccentric orbits
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 12 );
+    initialState( 0 ) = 1.0;
+    initialState( 4 ) = std::sqrt( 1.6 );
+    initialState( 6 ) = 1.5;
+    initialState( 10 ) = 0.5;
+    initialState( 11 ) = 0.3;
+    const double finalTime = 20.0;
+
+    for( int testCase = 0; testCase < 4; testCase++ )
+    {
+        // Integrate with RKF7(8) (continuous extension of order 5) and RKDP8(7) (order 7, using additional stages)
+        const int direction = testCase % 2;
+        const CoefficientSets coefficientSet = ( testCase < 2 ) ? rungeKuttaFehlberg78 : rungeKutta87DormandPrince;
+
+        // Integrate forward/backward, storing dense output
+        const double startTime = 0.0;
+        const double endTime = ( direction == 0 ) ? finalTime : -finalTime;
+        const double initialStepSize = ( direction == 0 ) ? 1.0E-2 : -1.0E-2;
+
+        RungeKuttaVariableStepSizeIntegratorXd integrator(
+                    RungeKuttaCoefficients::get( coefficientSet ), computeTwoKeplerOrbitsStateDerivative,
+                    startTime, initialState, std::numeric_limits< double >::epsilon( ),
+                    std::numeric_limits< double >::infinity( ), initialStepSize, 1.0E-12, 1.0E-12 );
+        integrator.setDenseOutputStorage( true );
+
+        std::map< double, Eigen::VectorXd > stateHistory;
+        stateHistory[ startTime ] = initialState;
+        double stepSize = initialStepSize;
+        while( ( direction == 0 ) ? ( integrator.getCurrentIndependentVariable( ) < endTime ) :
+               ( integrator.getCurrentIndependentVariable( ) > endTime ) )
+        {
+            integrator.performIntegrationStep( stepSize );
+            stepSize = integrator.getNextStepSize( );
+            stateHistory[ integrator.getCurrentIndependentVariable( ) ] = integrator.getCurrentState( );
+        }
+
+        // Check that (only) accepted steps are stored, and that state history is reproduced at step boundaries (up to
+        // round-off in the polynomial, which has larger coefficients for the extension with additional stages)
+        std::shared_ptr< RungeKuttaDenseOutput< > > denseOutput = integrator.getDenseOutput( );
+        BOOST_CHECK_EQUAL( denseOutput->getNumberOfSteps( ) + 1, static_cast< int >( stateHistory.size( ) ) );
+        for( auto stateIterator : stateHistory )
+        {
+            BOOST_CHECK_SMALL( ( denseOutput->getState( stateIterator.first ) - stateIterator.second ).
+                               cwiseAbs( ).maxCoeff( ), ( testCase < 2 ) ? 1.0E-14 : 1.0E-12 );
+        }
+
+        // Create ephemeris of second orbit from dense output
+        std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > > stateInterpolator =
+                std::make_shared< interpolators::RungeKuttaDenseOutputInterpolator< double, Eigen::Vector6d > >(
+                    denseOutput, 6 );
+        ephemerides::TabulatedCartesianEphemeris< > ephemeris( stateInterpolator );
+        BOOST_CHECK_EQUAL( stateInterpolator->getIndependentValues( ).size( ), stateHistory.size( ) );
+        BOOST_CHECK_EQUAL( stateInterpolator->getInterpolatorType( ),
+                           interpolators::runge_kutta_dense_output_interpolator );
+
+        // Integrate reference solution to intermediate times, and compare to dense output
+        RungeKuttaVariableStepSizeIntegratorXd referenceIntegrator(
+                    RungeKuttaCoefficients::get( rungeKuttaFehlberg78 ), computeTwoKeplerOrbitsStateDerivative,
+                    startTime, initialState, std::numeric_limits< double >::epsilon( ),
+                    std::numeric_limits< double >::infinity( ), initialStepSize, 1.0E-15, 1.0E-15 );
+        double maximumDenseOutputError = 0.0;
+        for( int i = 1; i < 200; i++ )
+        {
+            double testTime = startTime + ( endTime - startTime ) * ( static_cast< double >( i ) + 0.37 ) / 200.0;
+            Eigen::VectorXd referenceState = referenceIntegrator.integrateTo( testTime, initialStepSize );
+            Eigen::Vector6d ephemerisState = ephemeris.getCartesianState( testTime );
+
+            BOOST_CHECK_SMALL( ( ephemerisState - denseOutput->getState( testTime ).segment( 6, 6 ) ).
+                               cwiseAbs( ).maxCoeff( ), 1.0E-15 );
+            maximumDenseOutputError = std::max(
+                        maximumDenseOutputError, ( denseOutput->getState( testTime ) - referenceState ).cwiseAbs( ).maxCoeff( ) );
+        }
+        // Error of dense output is larger than that of integrated states, due to lower order of continuous extension (5 for
+        // RKF7(8), 7 for RKDP8(7))
+        BOOST_CHECK_SMALL( maximumDenseOutputError, ( testCase < 2 ) ? 1.0E-8 : 1.0E-10 );
+
+        // Check that rolled back step is removed from dense output
+        int numberOfSteps = denseOutput->getNumberOfSteps( );
+        BOOST_CHECK( integrator.rollbackToPreviousState( ) );
+        BOOST_CHECK_EQUAL( denseOutput->getNumberOfSteps( ), numberOfSteps - 1 );
+        BOOST_CHECK_SMALL( std::fabs( denseOutput->getEndIndependentVariable( ) -
+                                      integrator.getCurrentIndependentVariable( ) ), 1.0E-15 );
+
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,155 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/math/integrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+#include "tudat/support/heapAllocationCounter.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+
+BOOST_AUTO_TEST_SUITE( test_runge_kutta_integrator_allocations )
+
+//! Function to compute the state derivative of a Keplerian orbit (gravitational parameter of 1), with variational equations.
+/*!
+ * Function to compute the state derivative of a Keplerian orbit (gravitational parameter of 1). The first column of
+ * the state is the Cartesian state, any further columns are propagated using the variational equations. Only the
+ * returned state derivative is allocated on the heap (for dynamic-size states).
+ */
+template< typename StateType >
+StateType computeKeplerVariationalStateDerivative( const double time, const StateType& state )
+{
+    StateType stateDerivative( state.rows( ), state.cols( ) );
+
+    const Eigen::Vector3d position = state.template block< 3, 1 >( 0, 0 );
+    const double distance = position.norm( );
+    stateDerivative.template block< 3, 1 >( 0, 0 ) = state.template block< 3, 1 >( 3, 0 );
+    stateDerivative.template block< 3, 1 >( 3, 0 ) = -position / ( distance * distance * distance );
+
+    const int numberOfVariationalColumns = state.cols( ) - 1;
+    if( numberOfVariationalColumns > 0 )
+    {
+        const Eigen::Matrix3d gravityGradient =
+                ( 3.0 * position * position.transpose( ) / ( distance * distance ) - Eigen::Matrix3d::Identity( ) ) /
+                ( distance * distance * distance );
+        stateDerivative.block( 0, 1, 3, numberOfVariationalColumns ) = state.block( 3, 1, 3, numberOfVariationalColumns );
+        stateDerivative.block( 3, 1, 3, numberOfVariationalColumns ).noalias( ) =
+                gravityGradient * state.block( 0, 1, 3, numberOfVariationalColumns );
+    }
+    return stateDerivative;
+}
+
+//! Function to create an eccentric Keplerian initial state, with identity matrix as initial variational state.
+template< typename StateType >
+StateType getKeplerVariationalInitialState( const int numberOfColumns )
+{
+    StateType initialState = StateType::Zero( 6, numberOfColumns );
+    initialState( 0, 0 ) = 1.0;
+    initialState( 4, 0 ) = std::sqrt( 1.95 );
+    if( numberOfColumns > 1 )
+    {
+        initialState.block( 0, 1, 6, 6 ).setIdentity( );
+    }
+    return initialState;
+}
+
+//! Function to perform integration steps, and retrieve the number of heap allocations and state derivative evaluations.
+template< typename StateType >
+void getNumberOfHeapAllocationsDuringSteps(
+        RungeKuttaVariableStepSizeIntegrator< double, StateType, StateType >& integrator,
+        const int numberOfSteps, const int& numberOfEvaluations,
+        unsigned long long& numberOfAllocationsDuringSteps, int& numberOfEvaluationsDuringSteps )
+{
+    unsigned long long initialNumberOfHeapAllocations = numberOfHeapAllocations;
+    int initialNumberOfEvaluations = numberOfEvaluations;
+    for( int i = 0; i < numberOfSteps; i++ )
+    {
+        integrator.performIntegrationStep( integrator.getNextStepSize( ) );
+    }
+    numberOfAllocationsDuringSteps = numberOfHeapAllocations - initialNumberOfHeapAllocations;
+    numberOfEvaluationsDuringSteps = numberOfEvaluations - initialNumberOfEvaluations;
+}
+
+//! Test the number of heap allocations of variable step-size Runge-Kutta integration steps, for a given state type.
+/*!
+ * Test the number of heap allocations of variable step-size Runge-Kutta integration steps, for a given state type. The
+ * integrator itself should not allocate any memory, so that the number of allocations is equal to the number of
+ * allocations in the state derivative function (one per evaluation for dynamic-size states, none for fixed-size states),
+ * plus the copy of the new state returned by each (accepted) step for dynamic-size states.
+ * No safety factor is used for the step size control, so that steps are regularly rejected, to test that rejected steps
+ * do not allocate memory either.
+ */
+template< typename StateType >
+void testRungeKuttaIntegratorAllocations( const int numberOfColumns, const bool isDynamicSize )
+{
+    std::vector< CoefficientSets > coefficientSets =
+    { rungeKuttaFehlberg45, rungeKuttaFehlberg78, rungeKutta87DormandPrince };
+    for( unsigned int i = 0; i < coefficientSets.size( ); i++ )
+    {
+        const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get( coefficientSets.at( i ) );
+
+        int numberOfEvaluations = 0;
+        RungeKuttaVariableStepSizeIntegrator< double, StateType, StateType > integrator(
+                    coefficients, [ & ]( const double time, const StateType& state )
+        {
+            numberOfEvaluations++;
+            return computeKeplerVariationalStateDerivative< StateType >( time, state );
+        }, 0.0, getKeplerVariationalInitialState< StateType >( numberOfColumns ),
+                    std::numeric_limits< double >::epsilon( ), std::numeric_limits< double >::infinity( ),
+                    1.0E-2, 1.0E-10, 1.0E-10, 1.0 );
+
+        // Perform initial steps, and check number of allocations and evaluations (including those of rejected steps)
+        unsigned long long numberOfAllocations;
+        int numberOfEvaluationsDuringSteps;
+        getNumberOfHeapAllocationsDuringSteps(
+                    integrator, 10, numberOfEvaluations, numberOfAllocations, numberOfEvaluationsDuringSteps );
+        getNumberOfHeapAllocationsDuringSteps(
+                    integrator, 500, numberOfEvaluations, numberOfAllocations, numberOfEvaluationsDuringSteps );
+
+        BOOST_CHECK_GT( numberOfEvaluationsDuringSteps, 500 * coefficients.cCoefficients.rows( ) );
+#ifdef TUDAT_COUNT_HEAP_ALLOCATIONS
+        BOOST_CHECK_EQUAL( numberOfAllocations, isDynamicSize ? numberOfEvaluationsDuringSteps + 500 : 0 );
+#endif
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testRungeKuttaIntegratorAllocationsFixedSize )
+{
+    testRungeKuttaIntegratorAllocations< Eigen::Vector6d >( 1, false );
+    testRungeKuttaIntegratorAllocations< Eigen::Matrix< double, 6, 10 > >( 10, false );
+}
+
+BOOST_AUTO_TEST_CASE( testRungeKuttaIntegratorAllocationsDynamicSize )
+{
+    testRungeKuttaIntegratorAllocations< Eigen::VectorXd >( 1, true );
+    testRungeKuttaIntegratorAllocations< Eigen::MatrixXd >( 10, true );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,464 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/basic_astro/customAccelerationModel.h"
+#include "tudat/astro/gravitation/centralGravityModel.h"
+#include "tudat/astro/propagators/nBodyTaylorSeriesExpressions.h"
+#include "tudat/astro/relativity/einsteinInfeldHoffmannAcceleration.h"
+#include "tudat/astro/relativity/einsteinInfeldHoffmannEquations.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+#include "tudat/math/integrators/createNumericalIntegrator.h"
+#include "tudat/math/integrators/taylorSeriesIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::numerical_integrators;
+using namespace tudat::propagators;
+
+BOOST_AUTO_TEST_SUITE( test_taylor_series_integrator )
+
+//! Function to convert an Eigen vector to a std::vector.
+std::vector< double > convertToStdVector( const Eigen::VectorXd& vector )
+{
+    return std::vector< double >( vector.data( ), vector.data( ) + vector.rows( ) );
+}
+
+//! Function to compute the state derivative of N bodies under point-mass attraction, as Eigen vector.
+Eigen::VectorXd computePointMassStateDerivative( const std::vector< double >& gravitationalParameters,
+                                                 const Eigen::VectorXd& state )
+{
+    std::vector< double > stateDerivative = computeNBodyPointMassStateDerivative(
+                convertToStdVector( state ), gravitationalParameters );
+    return Eigen::Map< Eigen::VectorXd >( stateDerivative.data( ), stateDerivative.size( ) );
+}
+
+//! Test the Taylor coefficients of the elementary operations, against the series of the analytical solutions.
+BOOST_AUTO_TEST_CASE( testTaylorSeriesCoefficients )
+{
+    const int order = 12;
+    Eigen::MatrixXd taylorCoefficients;
+    Eigen::VectorXd initialState = Eigen::VectorXd::Ones( 1 );
+
+    // y' = y^1.5, y( 0 ) = 1: y = ( 1 - t / 2 )^-2, y_k = ( k + 1 ) / 2^k
+    std::shared_ptr< TaylorSeriesExpression > powerExpression = createTaylorSeriesExpression(
+                1, [ ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return std::vector< TaylorSeriesVariable >{ pow( state.at( 0 ), 1.5 ) };
+    } );
+    powerExpression->computeTaylorCoefficients( 0.0, initialState, order, taylorCoefficients );
+    for( int k = 0; k <= order; k++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( taylorCoefficients( 0, k ), ( k + 1.0 ) / std::pow( 2.0, k ), 1.0E-14 );
+    }
+
+    // y' = y * y, y( 0 ) = 1: y = 1 / ( 1 - t ), y_k = 1
+    std::shared_ptr< TaylorSeriesExpression > productExpression = createTaylorSeriesExpression(
+                1, [ ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return std::vector< TaylorSeriesVariable >{ state.at( 0 ) * state.at( 0 ) };
+    } );
+    productExpression->computeTaylorCoefficients( 0.0, initialState, order, taylorCoefficients );
+    for( int k = 0; k <= order; k++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( taylorCoefficients( 0, k ), 1.0, 1.0E-14 );
+    }
+
+    // y' = sqrt( y ), y( 0 ) = 1: y = ( 1 + t / 2 )^2
+    std::shared_ptr< TaylorSeriesExpression > squareRootExpression = createTaylorSeriesExpression(
+                1, [ ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return std::vector< TaylorSeriesVariable >{ sqrt( state.at( 0 ) ) };
+    } );
+    squareRootExpression->computeTaylorCoefficients( 0.0, initialState, order, taylorCoefficients );
+    BOOST_CHECK_CLOSE_FRACTION( taylorCoefficients( 0, 0 ), 1.0, 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( taylorCoefficients( 0, 1 ), 1.0, 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( taylorCoefficients( 0, 2 ), 0.25, 1.0E-15 );
+    for( int k = 3; k <= order; k++ )
+    {
+        BOOST_CHECK_SMALL( taylorCoefficients( 0, k ), 1.0E-15 );
+    }
+
+    // y' = 2 t / ( y + y ), y( 0 ) = 1: y = sqrt( 1 + t^2 ) = 1 + t^2 / 2 - t^4 / 8 + t^6 / 16 - 5 t^8 / 128 + ...
+    std::shared_ptr< TaylorSeriesExpression > divisionExpression = createTaylorSeriesExpression(
+                1, [ ]( const TaylorSeriesVariable& time, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return std::vector< TaylorSeriesVariable >{ ( 2.0 * time ) / ( state.at( 0 ) + state.at( 0 ) ) };
+    } );
+    divisionExpression->computeTaylorCoefficients( 0.0, initialState, order, taylorCoefficients );
+    const std::vector< double > expectedCoefficients =
+    { 1.0, 0.0, 0.5, 0.0, -1.0 / 8.0, 0.0, 1.0 / 16.0, 0.0, -5.0 / 128.0 };
+    for( unsigned int k = 0; k < expectedCoefficients.size( ); k++ )
+    {
+        BOOST_CHECK_SMALL( taylorCoefficients( 0, k ) - expectedCoefficients.at( k ), 1.0E-15 );
+    }
+
+    // Check constant state derivative entries and input checks
+    std::shared_ptr< TaylorSeriesExpression > constantExpression = createTaylorSeriesExpression(
+                2, [ ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return std::vector< TaylorSeriesVariable >{ state.at( 1 ), TaylorSeriesVariable( 2.0 ) };
+    } );
+    constantExpression->computeTaylorCoefficients( 0.0, Eigen::Vector2d( 3.0, 4.0 ), 4, taylorCoefficients );
+    BOOST_CHECK_EQUAL( taylorCoefficients( 0, 1 ), 4.0 );
+    BOOST_CHECK_EQUAL( taylorCoefficients( 0, 2 ), 1.0 );
+    BOOST_CHECK_EQUAL( taylorCoefficients( 0, 3 ), 0.0 );
+    BOOST_CHECK_EQUAL( taylorCoefficients( 1, 1 ), 2.0 );
+    BOOST_CHECK_THROW( constantExpression->computeTaylorCoefficients( 0.0, initialState, 4, taylorCoefficients ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( createTaylorSeriesExpression(
+                           2, [ ]( const TaylorSeriesVariable&, const std::vector< TaylorSeriesVariable >& state )
+    {
+        return std::vector< TaylorSeriesVariable >{ state.at( 1 ) };
+    } ), std::runtime_error );
+
+    // Check that a circular Keplerian orbit reproduces the series of the cosine and sine
+    std::shared_ptr< TaylorSeriesExpression > keplerExpression = createNBodyPointMassTaylorSeriesExpression( { 1.0, 0.0 } );
+    Eigen::VectorXd keplerState = Eigen::VectorXd::Zero( 12 );
+    keplerState( 6 ) = 1.0;
+    keplerState( 10 ) = 1.0;
+    keplerExpression->computeTaylorCoefficients( 0.0, keplerState, order, taylorCoefficients );
+    double factorial = 1.0;
+    for( int k = 0; k <= order; k++ )
+    {
+        factorial *= ( k > 0 ) ? k : 1.0;
+        BOOST_CHECK_SMALL( taylorCoefficients( 6, k ) - ( ( k % 2 == 0 ) ? ( ( k % 4 == 0 ) ? 1.0 : -1.0 ) / factorial : 0.0 ),
+                           1.0E-15 );
+        BOOST_CHECK_SMALL( taylorCoefficients( 7, k ) - ( ( k % 2 == 1 ) ? ( ( k % 4 == 1 ) ? 1.0 : -1.0 ) / factorial : 0.0 ),
+                           1.0E-15 );
+        BOOST_CHECK_EQUAL( taylorCoefficients.block( 0, k, 6, 1 ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    }
+}
+
+//! Test the recorded N-body point-mass and EIH state derivatives against direct evaluation.
+BOOST_AUTO_TEST_CASE( testNBodyTaylorSeriesExpressions )
+{
+    // Sun, Earth and Moon-like system (in units of AU and days)
+    const std::vector< double > gravitationalParameters = { 2.959122E-4, 8.887692E-10, 1.093189E-11 };
+    Eigen::VectorXd state = Eigen::VectorXd::Zero( 18 );
+    state << -2.0E-6, 1.0E-6, 0.0, 1.0E-8, -3.0E-8, 1.0E-9,
+            0.98, 0.2, 1.0E-4, -3.5E-3, 1.69E-2, 2.0E-7,
+            0.9825, 0.2015, 3.0E-4, -3.8E-3, 1.72E-2, 3.0E-6;
+
+    std::shared_ptr< TaylorSeriesExpression > pointMassExpression =
+            createNBodyPointMassTaylorSeriesExpression( gravitationalParameters );
+    Eigen::VectorXd pointMassStateDerivative = computePointMassStateDerivative( gravitationalParameters, state );
+    Eigen::VectorXd recordedPointMassStateDerivative = pointMassExpression->computeStateDerivative( 0.0, state );
+    for( int i = 0; i < 18; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( recordedPointMassStateDerivative( i ), pointMassStateDerivative( i ), 1.0E-14 );
+    }
+
+    // Check EIH equations against direct implementation, in SI units (to use the actual speed of light)
+    const std::vector< double > siGravitationalParameters = { 1.32712440018E20, 3.986004418E14, 4.9048695E12 };
+    Eigen::VectorXd siState = state * 1.495978707E11;
+    siState.segment( 3, 3 ) /= 86400.0;
+    siState.segment( 9, 3 ) /= 86400.0;
+    siState.segment( 15, 3 ) /= 86400.0;
+
+    const double ppnGamma = 0.9, ppnBeta = 1.2;
+    std::vector< std::function< double( ) > > gravitationalParameterFunctions;
+    std::vector< std::function< Eigen::Matrix< double, 6, 1 >( ) > > stateFunctions;
+    for( int i = 0; i < 3; i++ )
+    {
+        gravitationalParameterFunctions.push_back( [ = ]( ){ return siGravitationalParameters.at( i ); } );
+        stateFunctions.push_back( [ = ]( ){ return Eigen::Matrix< double, 6, 1 >( siState.segment( 6 * i, 6 ) ); } );
+    }
+    relativity::EinsteinInfeldHoffmannEquations eihEquations(
+                { "Sun", "Earth", "Moon" }, { "Sun", "Earth", "Moon" }, gravitationalParameterFunctions, stateFunctions,
+                [ = ]( ){ return ppnGamma; }, [ = ]( ){ return ppnBeta; } );
+    eihEquations.update( 0.0 );
+
+    std::vector< double > eihStateDerivative = computeNBodyEinsteinInfeldHoffmannStateDerivative(
+                convertToStdVector( siState ), siGravitationalParameters, ppnGamma, ppnBeta );
+    std::vector< double > siPointMassStateDerivative = computeNBodyPointMassStateDerivative(
+                convertToStdVector( siState ), siGravitationalParameters );
+    Eigen::VectorXd recordedEihStateDerivative =
+            createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression( siGravitationalParameters, ppnGamma, ppnBeta )->
+            computeStateDerivative( 0.0, siState );
+    for( int i = 0; i < 3; i++ )
+    {
+        Eigen::Vector3d eihAcceleration = eihEquations.getAccelerationOfBody( i );
+        for( int k = 0; k < 3; k++ )
+        {
+            // Compare relativistic corrections
+            BOOST_CHECK_CLOSE_FRACTION( eihStateDerivative.at( 6 * i + 3 + k ) - siPointMassStateDerivative.at( 6 * i + 3 + k ),
+                                        eihAcceleration( k ) - siPointMassStateDerivative.at( 6 * i + 3 + k ), 1.0E-6 );
+            BOOST_CHECK_CLOSE_FRACTION( eihStateDerivative.at( 6 * i + 3 + k ), eihAcceleration( k ), 1.0E-14 );
+            BOOST_CHECK_CLOSE_FRACTION( recordedEihStateDerivative( 6 * i + 3 + k ), eihAcceleration( k ), 1.0E-14 );
+            BOOST_CHECK_EQUAL( eihStateDerivative.at( 6 * i + k ), siState( 6 * i + 3 + k ) );
+        }
+    }
+}
+
+//! Test the creation of the recorded N-body state derivative from acceleration models, and its input checks.
+BOOST_AUTO_TEST_CASE( testNBodyTaylorSeriesExpressionFromAccelerationModels )
+{
+    using namespace tudat::basic_astrodynamics;
+
+    const std::vector< std::string > bodies = { "Sun", "Earth", "Moon" };
+    const std::vector< std::string > centralBodies = { "SSB", "SSB", "SSB" };
+    const std::vector< double > gravitationalParameters = { 1.32712440018E20, 3.986004418E14, 4.9048695E12 };
+    Eigen::VectorXd state = Eigen::VectorXd::Zero( 18 );
+    state << -3.0E5, 1.5E5, 0.0, 1.0E-2, -3.0E-2, 1.0E-3,
+            1.466E11, 2.99E10, 1.5E7, -6.06E3, 2.926E4, 0.35,
+            1.4698E11, 3.01E10, 4.5E7, -6.58E3, 2.98E4, 5.2;
+    auto positionFunction = [ & ]( const int bodyIndex )
+    {
+        return [ &state, bodyIndex ]( Eigen::Vector3d& position ){ position = state.segment( 6 * bodyIndex, 3 ); };
+    };
+
+    // Create point-mass accelerations between all bodies, and compare expression with the acceleration models
+    auto createPointMassAccelerations = [ & ]( const bool useMutualAttraction )
+    {
+        AccelerationMap accelerationModelMap;
+        for( int i = 0; i < 3; i++ )
+        {
+            for( int j = 0; j < 3; j++ )
+            {
+                if( i != j )
+                {
+                    accelerationModelMap[ bodies.at( i ) ][ bodies.at( j ) ].push_back(
+                                std::make_shared< gravitation::CentralGravitationalAccelerationModel3d >(
+                                    positionFunction( i ), gravitationalParameters.at( j ), positionFunction( j ),
+                                    useMutualAttraction && ( j == 0 ) ) );
+                }
+            }
+        }
+        return accelerationModelMap;
+    };
+    AccelerationMap accelerationModelMap = createPointMassAccelerations( false );
+    Eigen::VectorXd recordedStateDerivative =
+            createNBodyTaylorSeriesExpression( accelerationModelMap, bodies, centralBodies )->
+            computeStateDerivative( 0.0, state );
+    for( int i = 0; i < 3; i++ )
+    {
+        Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+        for( auto accelerationIterator : accelerationModelMap.at( bodies.at( i ) ) )
+        {
+            acceleration += updateAndGetAcceleration( accelerationIterator.second.at( 0 ), 0.0 );
+        }
+        BOOST_CHECK_SMALL( ( recordedStateDerivative.segment( 6 * i + 3, 3 ) - acceleration ).norm( ),
+                           1.0E-14 * acceleration.norm( ) );
+        BOOST_CHECK( recordedStateDerivative.segment( 6 * i, 3 ) == state.segment( 6 * i + 3, 3 ) );
+    }
+
+    // Check that a body that exerts no acceleration is allowed (zero gravitational parameter)
+    AccelerationMap masslessMoonAccelerationModelMap = accelerationModelMap;
+    masslessMoonAccelerationModelMap[ "Sun" ].erase( "Moon" );
+    masslessMoonAccelerationModelMap[ "Earth" ].erase( "Moon" );
+    recordedStateDerivative =
+            createNBodyTaylorSeriesExpression( masslessMoonAccelerationModelMap, bodies, centralBodies )->
+            computeStateDerivative( 0.0, state );
+    Eigen::VectorXd pointMassStateDerivative = computePointMassStateDerivative(
+                { gravitationalParameters.at( 0 ), gravitationalParameters.at( 1 ), 0.0 }, state );
+    BOOST_CHECK_SMALL( ( recordedStateDerivative - pointMassStateDerivative ).cwiseAbs( ).maxCoeff( ), 1.0E-15 );
+
+    // Check unsupported accelerations and configurations
+    AccelerationMap incompleteAccelerationModelMap = accelerationModelMap;
+    incompleteAccelerationModelMap[ "Sun" ].erase( "Moon" );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( incompleteAccelerationModelMap, bodies, centralBodies ),
+                       std::runtime_error );
+
+    AccelerationMap customAccelerationModelMap = accelerationModelMap;
+    customAccelerationModelMap[ "Moon" ][ "Moon" ].push_back(
+                std::make_shared< CustomAccelerationModel >( [ ]( const double ){ return Eigen::Vector3d::Zero( ); } ) );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( customAccelerationModelMap, bodies, centralBodies ),
+                       std::runtime_error );
+
+    AccelerationMap externalBodyAccelerationModelMap = accelerationModelMap;
+    externalBodyAccelerationModelMap[ "Moon" ][ "Jupiter" ].push_back(
+                std::make_shared< gravitation::CentralGravitationalAccelerationModel3d >(
+                    positionFunction( 2 ), 1.26686534E17 ) );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( externalBodyAccelerationModelMap, bodies, centralBodies ),
+                       std::runtime_error );
+
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( createPointMassAccelerations( true ), bodies, centralBodies ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( accelerationModelMap, bodies, { "SSB", "SSB", "Earth" } ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( accelerationModelMap, { "Earth", "Moon" }, { "Sun", "Sun" } ),
+                       std::runtime_error );
+
+    // Create EIH accelerations, and compare expression with direct evaluation
+    std::vector< std::function< double( ) > > gravitationalParameterFunctions;
+    std::vector< std::function< Eigen::Matrix< double, 6, 1 >( ) > > stateFunctions;
+    for( int i = 0; i < 3; i++ )
+    {
+        gravitationalParameterFunctions.push_back( [ = ]( ){ return gravitationalParameters.at( i ); } );
+        stateFunctions.push_back( [ &state, i ]( ){ return Eigen::Matrix< double, 6, 1 >( state.segment( 6 * i, 6 ) ); } );
+    }
+    std::shared_ptr< relativity::EinsteinInfeldHoffmannEquations > eihEquations =
+            std::make_shared< relativity::EinsteinInfeldHoffmannEquations >(
+                bodies, bodies, gravitationalParameterFunctions, stateFunctions,
+                [ ]( ){ return 0.9; }, [ ]( ){ return 1.2; } );
+    AccelerationMap eihAccelerationModelMap;
+    for( int i = 0; i < 3; i++ )
+    {
+        std::vector< std::string > bodiesExertingAcceleration = bodies;
+        bodiesExertingAcceleration.erase( bodiesExertingAcceleration.begin( ) + i );
+        eihAccelerationModelMap[ bodies.at( i ) ][ "" ].push_back(
+                    std::make_shared< relativity::EinsteinInfeldHoffmannAcceleration >(
+                        eihEquations, bodies.at( i ), bodiesExertingAcceleration ) );
+    }
+    std::vector< double > eihStateDerivative = computeNBodyEinsteinInfeldHoffmannStateDerivative(
+                convertToStdVector( state ), gravitationalParameters, 0.9, 1.2 );
+    recordedStateDerivative = createNBodyTaylorSeriesExpression( eihAccelerationModelMap, bodies, centralBodies )->
+            computeStateDerivative( 0.0, state );
+    for( int i = 0; i < 18; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( recordedStateDerivative( i ), eihStateDerivative.at( i ), 1.0E-14 );
+    }
+
+    // EIH accelerations may not be combined with point-mass accelerations, and must act on all bodies
+    AccelerationMap mixedAccelerationModelMap = eihAccelerationModelMap;
+    mixedAccelerationModelMap[ "Moon" ][ "Earth" ] = accelerationModelMap.at( "Moon" ).at( "Earth" );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( mixedAccelerationModelMap, bodies, centralBodies ),
+                       std::runtime_error );
+    AccelerationMap incompleteEihAccelerationModelMap = eihAccelerationModelMap;
+    incompleteEihAccelerationModelMap.erase( "Moon" );
+    BOOST_CHECK_THROW( createNBodyTaylorSeriesExpression( incompleteEihAccelerationModelMap, bodies, centralBodies ),
+                       std::runtime_error );
+}
+
+//! Test the accuracy of the Taylor series integrator for an eccentric Keplerian orbit, and rollback/interpolation.
+BOOST_AUTO_TEST_CASE( testTaylorSeriesIntegrator )
+{
+    // Keplerian orbit with a = 1, e = 0.5 (gravitational parameter of 1), starting at periapsis
+    const std::vector< double > gravitationalParameters = { 1.0, 0.0 };
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 12 );
+    initialState( 6 ) = 0.5;
+    initialState( 10 ) = std::sqrt( 3.0 );
+
+    std::shared_ptr< TaylorSeriesExpression > expression =
+            createNBodyPointMassTaylorSeriesExpression( gravitationalParameters );
+    int numberOfStateDerivativeEvaluations = 0;
+    auto stateDerivativeFunction = [ & ]( const double, const Eigen::VectorXd& state )
+    {
+        numberOfStateDerivativeEvaluations++;
+        return computePointMassStateDerivative( gravitationalParameters, state );
+    };
+
+    // Integrate over ten orbits, which must return the initial state
+    const double orbitalPeriod = 2.0 * mathematical_constants::PI;
+    TaylorSeriesIntegratorXd integrator(
+                stateDerivativeFunction, expression, 0.0, initialState, 1.0, 1.0E-8, 10.0, 1.0E-15, 1.0E-15 );
+    BOOST_CHECK_EQUAL( integrator.getCurrentOrder( ), 19 );
+    Eigen::VectorXd finalState = integrator.integrateTo( 10.0 * orbitalPeriod, 1.0 );
+    BOOST_CHECK_SMALL( ( finalState - initialState ).cwiseAbs( ).maxCoeff( ), 1.0E-12 );
+    BOOST_CHECK_CLOSE_FRACTION( integrator.getCurrentIndependentVariable( ), 10.0 * orbitalPeriod, 1.0E-15 );
+
+    // Compare to RKF7(8) at same tolerance (Taylor series integrator evaluates state derivative once per step, and once
+    // at creation to check the expression)
+    int numberOfTaylorSteps = numberOfStateDerivativeEvaluations - 1;
+    numberOfStateDerivativeEvaluations = 0;
+    RungeKuttaVariableStepSizeIntegratorXd rungeKuttaIntegrator(
+                RungeKuttaCoefficients::get( rungeKuttaFehlberg78 ), stateDerivativeFunction, 0.0, initialState,
+                1.0E-8, 10.0, 1.0E-3, 1.0E-15, 1.0E-15 );
+    Eigen::VectorXd rungeKuttaFinalState = rungeKuttaIntegrator.integrateTo( 10.0 * orbitalPeriod, 1.0E-3 );
+    BOOST_CHECK_SMALL( ( finalState - initialState ).cwiseAbs( ).maxCoeff( ),
+                       ( rungeKuttaFinalState - initialState ).cwiseAbs( ).maxCoeff( ) + 1.0E-14 );
+    BOOST_CHECK_LT( 13 * numberOfTaylorSteps, numberOfStateDerivativeEvaluations );
+
+    // Check rollback, interpolation and step-size control
+    TaylorSeriesIntegratorXd stepIntegrator(
+                stateDerivativeFunction, expression, 0.0, initialState, 1.0, 1.0E-8, 10.0, 1.0E-15, 1.0E-15 );
+    BOOST_CHECK( !stepIntegrator.rollbackToPreviousState( ) );
+    const double firstStepSize = stepIntegrator.getNextStepSize( );
+    BOOST_CHECK_GT( firstStepSize, 0.0 );
+    BOOST_CHECK_LT( firstStepSize, 1.0 );
+
+    Eigen::VectorXd firstState = stepIntegrator.performIntegrationStep( 1.0 );
+    BOOST_CHECK_EQUAL( stepIntegrator.getCurrentIndependentVariable( ), firstStepSize );
+    BOOST_CHECK( stepIntegrator.getInterpolatedState( firstStepSize ) == firstState );
+    BOOST_CHECK( stepIntegrator.getInterpolatedState( 0.0 ) == initialState );
+    BOOST_CHECK_THROW( stepIntegrator.getInterpolatedState( 2.0 * firstStepSize ), std::runtime_error );
+
+    // Interpolated state must match state from integration step to that time
+    TaylorSeriesIntegratorXd halfStepIntegrator(
+                stateDerivativeFunction, expression, 0.0, initialState, 1.0, 1.0E-8, 10.0, 1.0E-15, 1.0E-15 );
+    Eigen::VectorXd halfStepState = halfStepIntegrator.performIntegrationStep( 0.5 * firstStepSize );
+    BOOST_CHECK( stepIntegrator.getInterpolatedState( 0.5 * firstStepSize ) == halfStepState );
+
+    BOOST_CHECK( stepIntegrator.rollbackToPreviousState( ) );
+    BOOST_CHECK_EQUAL( stepIntegrator.getCurrentIndependentVariable( ), 0.0 );
+    BOOST_CHECK( stepIntegrator.getCurrentState( ) == initialState );
+    BOOST_CHECK_EQUAL( stepIntegrator.getNextStepSize( ), firstStepSize );
+    BOOST_CHECK( !stepIntegrator.rollbackToPreviousState( ) );
+
+    stepIntegrator.setStepSizeControl( false );
+    stepIntegrator.performIntegrationStep( 2.0 * firstStepSize );
+    BOOST_CHECK_EQUAL( stepIntegrator.getCurrentIndependentVariable( ), 2.0 * firstStepSize );
+
+    // Check backwards integration
+    TaylorSeriesIntegratorXd backwardIntegrator(
+                stateDerivativeFunction, expression, 10.0 * orbitalPeriod, finalState, -1.0, 1.0E-8, 10.0,
+                1.0E-15, 1.0E-15 );
+    BOOST_CHECK_LT( backwardIntegrator.getNextStepSize( ), 0.0 );
+    Eigen::VectorXd backwardState = backwardIntegrator.integrateTo( 0.0, -1.0 );
+    BOOST_CHECK_SMALL( ( backwardState - initialState ).cwiseAbs( ).maxCoeff( ), 1.0E-12 );
+
+    // Check creation from settings, and input checks
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > > createdIntegrator =
+            createIntegrator< double, Eigen::VectorXd >(
+                stateDerivativeFunction, initialState, 0.0,
+                taylorSeriesSettings< double >( 1.0, expression, 1.0E-8, 10.0 ) );
+    BOOST_CHECK( std::dynamic_pointer_cast< TaylorSeriesIntegratorXd >( createdIntegrator ) != nullptr );
+    BOOST_CHECK_EQUAL( createdIntegrator->getNextStepSize( ), firstStepSize );
+
+    BOOST_CHECK_THROW( TaylorSeriesIntegratorXd(
+                           stateDerivativeFunction, expression, 0.0, Eigen::VectorXd::Zero( 6 ), 1.0, 1.0E-8, 10.0,
+                           1.0E-15, 1.0E-15 ), std::runtime_error );
+    BOOST_CHECK_THROW( TaylorSeriesIntegratorXd(
+                           stateDerivativeFunction, expression, 0.0, initialState, 1.0, 1.0, 10.0,
+                           1.0E-15, 1.0E-15 ), std::runtime_error );
+
+    // Check that an expression that is inconsistent with the state derivative function is rejected (point-mass
+    // expression with a different gravitational parameter, and with EIH state derivative)
+    BOOST_CHECK_THROW( TaylorSeriesIntegratorXd(
+                           stateDerivativeFunction, createNBodyPointMassTaylorSeriesExpression( { 1.0 + 1.0E-10, 0.0 } ),
+                           0.0, initialState, 1.0, 1.0E-8, 10.0, 1.0E-15, 1.0E-15 ), std::runtime_error );
+
+    const std::vector< double > siGravitationalParameters = { 1.32712440018E20, 0.0 };
+    Eigen::VectorXd siInitialState = Eigen::VectorXd::Zero( 12 );
+    siInitialState( 6 ) = 1.0E10;
+    siInitialState( 10 ) = std::sqrt( siGravitationalParameters.at( 0 ) / 1.0E10 );
+    auto eihStateDerivativeFunction = [ & ]( const double, const Eigen::VectorXd& state )
+    {
+        std::vector< double > stateDerivative = computeNBodyEinsteinInfeldHoffmannStateDerivative(
+                    convertToStdVector( state ), siGravitationalParameters );
+        return Eigen::VectorXd( Eigen::Map< Eigen::VectorXd >( stateDerivative.data( ), stateDerivative.size( ) ) );
+    };
+    BOOST_CHECK_THROW( TaylorSeriesIntegratorXd(
+                           eihStateDerivativeFunction, createNBodyPointMassTaylorSeriesExpression( siGravitationalParameters ),
+                           0.0, siInitialState, 1.0, 1.0E-8, 1.0E5, 1.0E-15, 1.0E-15 ), std::runtime_error );
+    BOOST_CHECK_NO_THROW( TaylorSeriesIntegratorXd(
+                              eihStateDerivativeFunction,
+                              createNBodyEinsteinInfeldHoffmannTaylorSeriesExpression( siGravitationalParameters ),
+                              0.0, siInitialState, 1.0, 1.0E-8, 1.0E5, 1.0E-15, 1.0E-15 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat